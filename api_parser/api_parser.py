@@ -113,11 +113,11 @@ class ApiParser:
 
                 entry['members'].append(member_info)
 
-                # Flip a flag if this structure has at least one variable-length array member, which
-                # means that the encoded size can only be computed at runtime
+                # Flip a flag if this structure has at least one variable-length array or string
+                # member, which means that the encoded size can only be computed at runtime
                 if not entry['has_vla_member']:
                     for annotation in self.annotations[type_name][member_name]:
-                        if annotation['annotation'] == 'var_len_array':
+                        if annotation['annotation'] in ['var_len_array', 'string']:
                             entry['has_vla_member'] = True
 
             self.structs_and_unions[type_name] = entry
@@ -16,12 +16,14 @@
 #
 
 import os
+import re
 import subprocess
 
 from datetime import datetime
 
 from utils import CHPP_PARSER_INCLUDE_PATH
 from utils import CHPP_PARSER_SOURCE_PATH
+from utils import CHPP_PARSER_TEST_PATH
 from utils import LICENSE_HEADER
 from utils import android_build_top_abs_path
 from utils import system_chre_abs_path
@@ -224,6 +226,61 @@ class CodeGenerator:
         out.append('CHPP_PACKED_END\n\n')
         return out
 
+    def _gen_layout_macro(self, chre_type):
+        """Generates a macro evaluating at compile time whether the CHPP type has the same layout as
+        the CHRE type.
+
+        The CHPP type has the same fields as the CHRE type, in the same order and with the same
+        types (see _is_bulk_copy_candidate()), and it is packed. So the layouts match if and only if
+        the CHRE type has no padding either, i.e. if both types have the same size.
+        """
+
+        out = []
+        chpp_type = self._get_chpp_type_from_chre(chre_type)
+        chre_type_with_prefix = self._get_chre_type_with_prefix(chre_type)
+        out.append('//! Whether {} has the same layout as\n//! {}\n'.format(
+            chpp_type, chre_type_with_prefix))
+        out.append('#define {} \\\n  (sizeof({}) == sizeof({}))\n\n'.format(
+            self._get_layout_macro_name(chre_type), chpp_type, chre_type_with_prefix))
+        return out
+
+    def _gen_layout_macros(self):
+        """Generates the layout macros of all the types which can be converted with a bulk copy."""
+
+        out = []
+        for chre_type in self._sorted_structs(self.json['root_structs']):
+            if self._is_bulk_copy_candidate(chre_type):
+                out.extend(self._gen_layout_macro(chre_type))
+        return out
+
+    def _get_layout_macro_name(self, chre_type):
+        """Returns 'CHPP_WIFI_SCAN_RESULT_MATCHES_CHRE_LAYOUT', etc. given 'chreWifiScanResult'"""
+
+        words = re.findall('[A-Z][a-z0-9]*', chre_type[4:])
+        return 'CHPP_{}_MATCHES_CHRE_LAYOUT'.format('_'.join(words).upper())
+
+    def _is_bulk_copy_candidate(self, chre_type):
+        """Returns True if the CHPP type may have the same layout as the CHRE type, in which case it
+        can be converted with a bulk copy.
+
+        This requires that none of its members are rewritten by the conversion (fixed values are
+        applied after the copy), and that all its nested types are candidates as well. Whether the
+        layouts actually match depends on the target, so it's evaluated at compile time.
+        """
+
+        struct_info = self.api.structs_and_unions[chre_type]
+        if struct_info['is_union'] or struct_info['has_vla_member']:
+            return False
+
+        for member_info in struct_info['members']:
+            for annotation in member_info['annotations']:
+                if annotation['annotation'] in ['rewrite_type', 'string', 'union_variant']:
+                    return False
+            if member_info['is_nested_type'] and \
+                    not self._is_bulk_copy_candidate(member_info['nested_type_name']):
+                return False
+        return True
+
     def _sorted_structs(self, root_nodes):
         """Implements a topological sort on self.api.structs_and_unions.
 
@@ -419,11 +476,13 @@ class CodeGenerator:
                        member_info['name'], member_info['name']))
 
         if member_info['is_nested_type']:
-            out.append('    for (size_t i = 0; i < in->{}; i++) {{\n'.format(
-                annotation['length_field']))
-            out.append('      {}'.format(
-                self._get_assignment_statement_for_field(member_info, in_vla_loop=True)))
-            out.append('    }\n')
+            loop = ['for (size_t i = 0; i < in->{}; i++) {{\n'.format(annotation['length_field']),
+                    '  {}'.format(self._get_assignment_statement_for_field(
+                        member_info, in_vla_loop=True)),
+                    '}\n']
+            out.extend(self._gen_vla_bulk_copy(
+                member_info, annotation, variable_name, 'in->' + variable_name,
+                'out->{}.length'.format(variable_name), loop))
         else:
             out.append('memcpy(&payload[*vlaOffset], in->{}, in->{} * sizeof({}));\n'.format(
                 member_info['name'], annotation['length_field'], chpp_type))
@@ -443,6 +502,93 @@ class CodeGenerator:
     # Encoder / decoder function generation methods (CHRE <--> CHPP)
     # ----------------------------------------------------------------------------------------------
 
+    def _gen_fixed_value_assignments(self, chre_type, output_prefix):
+        """Returns the statements assigning the fixed_value fields of the type and of its nested
+        types, e.g. after a bulk copy.
+
+        :param chre_type: CHRE type name
+        :param output_prefix: Prefix to access the fields of the output, e.g. 'out->'
+        :return: list of statements, without indentation
+        """
+
+        out = []
+        for member_info in self.api.structs_and_unions[chre_type]['members']:
+            field = output_prefix + member_info['name']
+            fixed_value = None
+            for annotation in member_info['annotations']:
+                if annotation['annotation'] == 'fixed_value':
+                    fixed_value = annotation['value']
+                    break
+
+            if fixed_value is not None:
+                if self._is_array_type(member_info['type']):
+                    out.append('memset(&{}, {}, sizeof({}));\n'.format(
+                        field, fixed_value, field))
+                else:
+                    out.append('{} = {};\n'.format(field, fixed_value))
+            elif member_info['is_nested_type']:
+                out.extend(self._gen_fixed_value_assignments(
+                    member_info['nested_type_name'], field + '.'))
+        return out
+
+    def _gen_bulk_copy(self, chre_type, decode_mode):
+        """Generates the fast path of a conversion function, used when the CHPP and CHRE types have
+        the same layout: copies the whole structure, then applies the fixed values.
+        """
+
+        out = []
+        if not self._is_bulk_copy_candidate(chre_type):
+            return out
+
+        out.append('  if ({}) {{\n'.format(
+            self._get_layout_macro_name(chre_type)))
+        out.append('    memcpy(out, in, sizeof(*out));\n')
+        for statement in self._gen_fixed_value_assignments(chre_type, 'out->'):
+            out.append('    ' + statement)
+        out.append('    return{};\n'.format(' true' if decode_mode else ''))
+        out.append('  }\n\n')
+        return out
+
+    def _gen_vla_bulk_copy(self, member_info, annotation, output_variable, input_variable,
+                           length, loop):
+        """Generates the conversion of a variable-length array of structures.
+
+        If the element type may have the same layout as its CHRE counterpart, the whole array is
+        copied at once when the layouts match, and the element-wise conversion loop is only used
+        otherwise.
+
+        :param output_variable: Pointer to the output array
+        :param input_variable: Pointer to the input array
+        :param length: Expression giving the length of the array in bytes
+        :param loop: The element-wise conversion loop, as a list of lines without indentation
+        :return: list of strings
+        """
+
+        out = []
+        chre_type = member_info['nested_type_name']
+        if not self._is_bulk_copy_candidate(chre_type):
+            for line in loop:
+                out.append('    ' + line)
+            return out
+
+        out.append('    if ({}) {{\n'.format(
+            self._get_layout_macro_name(chre_type)))
+        out.append('      memcpy({}, {}, {});\n'.format(
+            output_variable, input_variable, length))
+        fixed_values = self._gen_fixed_value_assignments(
+            chre_type, '{}[i].'.format(output_variable))
+        if len(fixed_values) > 0:
+            out.append('      for (size_t i = 0; i < in->{}; i++) {{\n'.format(
+                annotation['length_field']))
+            for statement in fixed_values:
+                out.append('        ' + statement)
+            out.append('      }\n')
+        out.append('    } else {\n')
+        for line in loop:
+            out.append('      ' + line)
+        out.append('    }\n')
+        return out
+
     def _get_assignment_statement_for_field(self, member_info,
                                             in_vla_loop=False,
                                             containing_field_name=None,
@@ -579,7 +725,10 @@ class CodeGenerator:
         else:
             out.extend(self._gen_encoding_function_signature(chre_type))
         out.append(' {\n')
+        out.extend(self._gen_bulk_copy(chre_type, decode_mode))
 
+        # Members allocated by the decoding function so far, to be freed if it fails
+        allocated_members = []
         for member_info in self.api.structs_and_unions[chre_type]['members']:
             generated_by_annotation = False
             for annotation in member_info['annotations']:
@@ -599,7 +748,8 @@ class CodeGenerator:
                 elif annotation['annotation'] == 'var_len_array':
                     if decode_mode:
                         out.extend(self._gen_vla_decoding(
-                            member_info, annotation))
+                            member_info, annotation, allocated_members))
+                        allocated_members.append(member_info['name'])
                     else:
                         out.extend(self._gen_vla_encoding(
                             member_info, annotation))
@@ -608,7 +758,8 @@ class CodeGenerator:
                 elif annotation['annotation'] == 'string':
                     if decode_mode:
                         out.extend(self._gen_string_decoding(
-                            member_info, annotation))
+                            member_info, annotation, allocated_members))
+                        allocated_members.append(member_info['name'])
                     else:
                         out.extend(self._gen_string_encoding(
                             member_info, annotation))
@@ -768,17 +919,39 @@ class CodeGenerator:
         out.append(')')
         return out
 
-    def _gen_string_decoding(self, member_info, annotation):
+    def _gen_decoding_failure(self, allocated_members, indent):
+        """Returns the statements freeing the members allocated so far, then returning false, for
+        when decoding fails.
+
+        :param allocated_members: Names of the members allocated so far
+        :param indent: Number of spaces to indent the statements with
+        :return: list of strings
+        """
+
+        out = []
+        for member_name in allocated_members:
+            out.append('{}chppFree(CHPP_CONST_CAST_POINTER(out->{}));\n'.format(
+                ' ' * indent, member_name))
+        out.append('{}return false;\n'.format(' ' * indent))
+        return out
+
+    def _gen_string_decoding(self, member_info, annotation, allocated_members):
         out = []
         variable_name = member_info['name']
         out.append('\n')
         out.append('  if (in->{}.length == 0) {{\n'.format(variable_name))
         out.append('    out->{} = NULL;\n'.format(variable_name))
         out.append('  } else {\n')
+        out.append('    if (in->{}.offset + in->{}.length > inSize ||\n'.format(
+            variable_name, variable_name))
+        out.append('        ((const char *)in)[in->{}.offset + in->{}.length - 1] != \'\\0\') {{\n'
+                   .format(variable_name, variable_name))
+        out.extend(self._gen_decoding_failure(allocated_members, 6))
+        out.append('    }\n\n')
         out.append('    char *{}Out = chppMalloc(in->{}.length);\n'.format(
             variable_name, variable_name))
         out.append('    if ({}Out == NULL) {{\n'.format(variable_name))
-        out.append('      return false;\n')
+        out.extend(self._gen_decoding_failure(allocated_members, 6))
         out.append('    }\n\n')
         out.append('    memcpy({}Out, &((const uint8_t *)in)[in->{}.offset],\n'.format(
             variable_name, variable_name))
@@ -788,7 +961,7 @@ class CodeGenerator:
 
         return out
 
-    def _gen_vla_decoding(self, member_info, annotation):
+    def _gen_vla_decoding(self, member_info, annotation, allocated_members):
         out = []
 
         variable_name = member_info['name']
@@ -809,7 +982,7 @@ class CodeGenerator:
         out.append('        in->{}.length != in->{} * sizeof({})) {{\n'.format(
             variable_name, annotation['length_field'], chpp_type))
 
-        out.append('      return false;\n')
+        out.extend(self._gen_decoding_failure(allocated_members, 6))
         out.append('    }\n\n')
 
         if member_info['is_nested_type']:
@@ -821,15 +994,17 @@ class CodeGenerator:
         out.append('    {} *{}Out = chppMalloc(in->{} * sizeof({}));\n'.format(
             chre_type, variable_name, annotation['length_field'], chre_type))
         out.append('    if ({}Out == NULL) {{\n'.format(variable_name))
-        out.append('      return false;\n')
+        out.extend(self._gen_decoding_failure(allocated_members, 6))
         out.append('    }\n\n')
 
         if member_info['is_nested_type']:
-            out.append('    for (size_t i = 0; i < in->{}; i++) {{\n'.format(
-                annotation['length_field'], variable_name))
-            out.append('      {}'.format(self._get_assignment_statement_for_field(
-                member_info, in_vla_loop=True, decode_mode=True)))
-            out.append('    }\n')
+            loop = ['for (size_t i = 0; i < in->{}; i++) {{\n'.format(annotation['length_field']),
+                    '  {}'.format(self._get_assignment_statement_for_field(
+                        member_info, in_vla_loop=True, decode_mode=True)),
+                    '}\n']
+            out.extend(self._gen_vla_bulk_copy(
+                member_info, annotation, variable_name + 'Out', variable_name + 'In',
+                'in->{}.length'.format(variable_name), loop))
         else:
             out.append('    memcpy({}Out, &((const uint8_t *)in)[in->{}.offset],\n'.format(
                 variable_name, variable_name))
@@ -915,6 +1090,451 @@ class CodeGenerator:
             out.append(';\n\n')
         return out
 
+    # ----------------------------------------------------------------------------------------------
+    # Test generation methods
+    # ----------------------------------------------------------------------------------------------
+
+    def _get_cpp_type_name(self, chre_type):
+        """Returns the name of the CHRE type in C++, where the types defined within a structure are
+        scoped to it, e.g. 'chreWifiRangingResult::chreWifiLci' given 'chreWifiLci'."""
+
+        if not hasattr(self, '_cpp_type_names'):
+            self._cpp_type_names = {}
+            with open(os.path.join(system_chre_abs_path(), self.json['filename'])) as f:
+                source = f.read()
+            source = re.sub(r'/\*.*?\*/|//[^\n]*', '', source, flags=re.S)
+
+            # Track the enclosing structures and unions through the braces
+            enclosing = []
+            for match in re.finditer(r'\b(?:struct|union|enum)\s+(\w+)\s*\{|\{|\}', source):
+                if match.group(0) == '}':
+                    enclosing.pop()
+                    continue
+                name = match.group(1)
+                if name is not None:
+                    scopes = [scope for scope in enclosing if scope is not None]
+                    self._cpp_type_names[name] = '::'.join(scopes + [name])
+                enclosing.append(name)
+
+        return self._cpp_type_names.get(chre_type, chre_type)
+
+    def _get_test_type_name(self, chre_type):
+        """Returns 'ScanResult', etc. given 'chreWifiScanResult', used to name the test helpers"""
+
+        return self._strip_prefix_and_service_from_chre_struct_name(chre_type)
+
+    def _gen_test_includes(self):
+        """Generates #include directives for the round-trip test source file."""
+
+        out = ['#include <gtest/gtest.h>\n\n']
+        out.append('#include <stddef.h>\n#include <stdint.h>\n#include <chrono>\n'
+                   '#include <cstdio>\n#include <cstring>\n#include <random>\n\n')
+        out.append('#include "chpp/app.h"\n'
+                   '#include "chpp/common/{}_types.h"\n'
+                   '#include "chpp/macros.h"\n'
+                   '#include "chpp/memory.h"\n\n'.format(self.service_name))
+        return out
+
+    def _gen_test_constants(self):
+        """Generates the constants and generic helpers shared by the generated tests."""
+
+        return ['//! Seed of the random generator, fixed to make failures reproducible\n'
+                'constexpr std::mt19937::result_type kSeed = 0x5eed;\n\n'
+                '//! Number of random structures converted back and forth per root structure\n'
+                'constexpr size_t kNumRoundTrips = 200;\n\n'
+                '//! Maximum number of elements of the random variable-length arrays and strings\n'
+                'constexpr size_t kMaxRandomLength = 8;\n\n'
+                '//! Number of conversions timed per root structure by the benchmarks\n'
+                'constexpr size_t kNumBenchmarkIterations = 10000;\n\n'
+                '//! Expects a field to be bitwise identical in both structures, which also holds\n'
+                '//! for floating-point NaNs\n'
+                '#define EXPECT_SAME_FIELD(expected, actual, field)          \\\n'
+                '  EXPECT_EQ(std::memcmp(&(expected).field, &(actual).field, \\\n'
+                '                        sizeof((expected).field)),          \\\n'
+                '            0)                                              \\\n'
+                '      << #field\n\n'
+                'void fillRandomBytes(std::mt19937 &rng, void *data, size_t size) {\n'
+                '  auto *bytes = static_cast<uint8_t *>(data);\n'
+                '  for (size_t i = 0; i < size; i++) {\n'
+                '    bytes[i] = static_cast<uint8_t>(rng());\n'
+                '  }\n'
+                '}\n\n'
+                '//! Fills a field of a primitive type, overloaded below for the structures\n'
+                'template <typename T>\n'
+                'void fillRandom(std::mt19937 &rng, T *value) {\n'
+                '  fillRandomBytes(rng, value, sizeof(*value));\n'
+                '}\n\n'
+                '//! @return The number of elements of a random variable-length array\n'
+                'size_t randomLength(std::mt19937 &rng) {\n'
+                '  return rng() % (kMaxRandomLength + 1);\n'
+                '}\n\n'
+                '//! @return One of the given values, e.g. of a union discriminator\n'
+                'template <typename T, size_t N>\n'
+                'T randomElement(std::mt19937 &rng, const T (&values)[N]) {\n'
+                '  return values[rng() % N];\n'
+                '}\n\n'
+                '//! Expects the first count elements of both arrays to be bitwise identical\n'
+                'template <typename T>\n'
+                'void expectSameArray(const T *expected, const T *actual, size_t count) {\n'
+                '  if (count > 0) {\n'
+                '    EXPECT_EQ(std::memcmp(expected, actual, count * sizeof(T)), 0);\n'
+                '  }\n'
+                '}\n\n'
+                'long long nsPerIteration(std::chrono::steady_clock::duration time) {\n'
+                '  return static_cast<long long>(\n'
+                '      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() /\n'
+                '      kNumBenchmarkIterations);\n'
+                '}\n\n']
+
+    def _get_member_annotations(self, member_info):
+        """Returns a dict mapping the annotations of the member to their JSON data."""
+
+        return {annotation['annotation']: annotation for annotation in member_info['annotations']}
+
+    def _get_member_type_spec(self, chre_type, member_name):
+        for member_info in self.api.structs_and_unions[chre_type]['members']:
+            if member_info['name'] == member_name:
+                return member_info['type'].type_spec
+        raise RuntimeError("Couldn't find member {} in {}".format(member_name, chre_type))
+
+    def _get_union_variant_member(self, member_info, field_name):
+        union_info = self.api.structs_and_unions[member_info['nested_type_name']]
+        for variant_info in union_info['members']:
+            if variant_info['name'] == field_name:
+                return variant_info
+        raise RuntimeError("Invalid mapping - couldn't find target field {} in union {}"
+                           .format(field_name, member_info['nested_type_name']))
+
+    def _wrap_call(self, prefix, function, arguments, suffix):
+        """Returns a statement calling the function, wrapped as clang-format would if it doesn't fit
+        on a single line.
+
+        :param prefix: Text preceding the function name, including the indentation, e.g.
+            '  bool result = '
+        :param suffix: Text following the closing parenthesis, e.g. ';'
+        :return: list of lines
+        """
+
+        call = '{}({}){}\n'.format(function, ', '.join(arguments), suffix)
+        if len(prefix) + len(call) <= 81:
+            return [prefix + call]
+
+        indent = ' ' * (len(prefix) - len(prefix.lstrip()))
+        if prefix.endswith('= '):
+            # Break after the assignment operator
+            return [prefix.rstrip() + '\n'] + self._wrap_call(
+                indent + '    ', function, arguments, suffix)
+
+        # Otherwise, bin-pack the arguments aligned after the opening parenthesis
+        out = []
+        line = '{}{}('.format(prefix, function)
+        alignment = ' ' * len(line)
+        for i, argument in enumerate(arguments):
+            text = argument + (',' if i < len(arguments) - 1 else '){}'.format(suffix))
+            if line.endswith('('):
+                line += text
+            elif len(line) + 1 + len(text) <= 80:
+                line += ' ' + text
+            else:
+                out.append(line + '\n')
+                line = alignment + text
+        out.append(line + '\n')
+        return out
+
+    def _gen_test_function_signature(self, name, parameters):
+        """Returns the signature of a test helper, with its opening brace, wrapping the parameters
+        as clang-format would."""
+
+        signature = 'void {}({}) {{\n'.format(name, ', '.join(parameters))
+        if len(signature) <= 81:
+            return [signature]
+        separator = ',\n' + ' ' * len('void {}('.format(name))
+        return ['void {}({}) {{\n'.format(name, separator.join(parameters))]
+
+    def _gen_test_fill_function(self, chre_type):
+        """Generates a function filling the CHRE type with random values, which can be converted.
+
+        Fixed values are applied, union discriminators are valid, and variable-length arrays and
+        strings are allocated with chppMalloc().
+        """
+
+        out = []
+        struct_info = self.api.structs_and_unions[chre_type]
+        cpp_type = self._get_cpp_type_name(chre_type)
+        out.extend(self._gen_test_function_signature(
+            'fillRandom', ['std::mt19937 &rng', '{} *value'.format(cpp_type)]))
+
+        length_fields = set()
+        for member_info in struct_info['members']:
+            annotations = self._get_member_annotations(member_info)
+            if 'var_len_array' in annotations:
+                length_fields.add(annotations['var_len_array']['length_field'])
+
+        discriminators = {}
+        for member_info in struct_info['members']:
+            annotations = self._get_member_annotations(member_info)
+            if 'union_variant' in annotations:
+                discriminators[annotations['union_variant']['discriminator']] = \
+                    annotations['union_variant']
+
+        filled = set()
+        for member_info in struct_info['members']:
+            name = member_info['name']
+            annotations = self._get_member_annotations(member_info)
+            if name in length_fields:
+                # Set along with the array
+                continue
+            elif 'fixed_value' in annotations:
+                value = annotations['fixed_value']['value']
+                if self._is_array_type(member_info['type']):
+                    out.append('  memset(&value->{}, {}, sizeof(value->{}));\n'.format(
+                        name, value, name))
+                else:
+                    out.append('  value->{} = {};\n'.format(name, value))
+            elif name in discriminators:
+                values_name = 'k{}{}Values'.format(name[0].upper(), name[1:])
+                out.append('  const {} {}[] = {{\n'.format(
+                    member_info['type'].type_spec, values_name))
+                for value, _ in discriminators[name]['mapping']:
+                    out.append('      {},\n'.format(value))
+                out.append('  };\n')
+                out.append('  value->{} = randomElement(rng, {});\n'.format(name, values_name))
+            elif 'union_variant' in annotations:
+                discriminator = annotations['union_variant']['discriminator']
+                if discriminator not in filled:
+                    raise RuntimeError('Discriminator {} must precede union {} in {}'.format(
+                        discriminator, name, chre_type))
+                out.append('  memset(&value->{}, 0, sizeof(value->{}));\n'.format(name, name))
+                out.append('  switch (value->{}) {{\n'.format(discriminator))
+                for value, field_name in annotations['union_variant']['mapping']:
+                    variant_info = self._get_union_variant_member(member_info, field_name)
+                    out.append('    case {}:\n'.format(value))
+                    out.extend(self._gen_test_fill_member(
+                        variant_info, '{}.{}'.format(name, field_name), '      '))
+                    out.append('      break;\n')
+                out.append('  }\n')
+            elif 'var_len_array' in annotations:
+                out.extend(self._gen_test_fill_vla(chre_type, member_info, annotations))
+            elif 'string' in annotations:
+                out.append('  size_t {}Length = rng() % kMaxRandomLength;\n'.format(name))
+                out.append('  auto *{} = static_cast<char *>(chppMalloc({}Length + 1));\n'.format(
+                    name, name))
+                out.append('  ASSERT_NE({}, nullptr);\n'.format(name))
+                out.append('  for (size_t i = 0; i < {}Length; i++) {{\n'.format(name))
+                out.append('    {}[i] = static_cast<char>(\'a\' + rng() % 26);\n'.format(name))
+                out.append('  }\n')
+                out.append('  {}[{}Length] = \'\\0\';\n'.format(name, name))
+                out.append('  value->{} = {};\n'.format(name, name))
+            else:
+                out.extend(self._gen_test_fill_member(member_info, name, '  '))
+            filled.add(name)
+
+        out.append('}\n\n')
+        return out
+
+    def _gen_test_fill_member(self, member_info, field, indent):
+        return ['{}fillRandom(rng, &value->{});\n'.format(indent, field)]
+
+    def _gen_test_fill_vla(self, chre_type, member_info, annotations):
+        out = []
+        name = member_info['name']
+        length_field = annotations['var_len_array']['length_field']
+        if member_info['is_nested_type']:
+            element_type = self._get_cpp_type_name(member_info['nested_type_name'])
+        else:
+            element_type = member_info['type'].type_spec
+        out.append('  value->{} = static_cast<{}>(randomLength(rng));\n'.format(
+            length_field, self._get_member_type_spec(chre_type, length_field)))
+        out.append('  if (value->{} == 0) {{\n'.format(length_field))
+        out.append('    value->{} = nullptr;\n'.format(name))
+        out.append('  } else {\n')
+        out.append('    size_t size = value->{} * sizeof({});\n'.format(length_field, element_type))
+        out.append('    auto *{} = static_cast<{} *>(chppMalloc(size));\n'.format(
+            name, element_type))
+        out.append('    ASSERT_NE({}, nullptr);\n'.format(name))
+        if member_info['is_nested_type']:
+            out.append('    for (size_t i = 0; i < value->{}; i++) {{\n'.format(length_field))
+            out.append('      fillRandom(rng, &{}[i]);\n'.format(name))
+            out.append('    }\n')
+        else:
+            out.append('    fillRandomBytes(rng, {}, size);\n'.format(name))
+        out.append('    value->{} = {};\n'.format(name, name))
+        out.append('  }\n')
+        return out
+
+    def _gen_test_compare_function(self, chre_type):
+        """Generates a function expecting two instances of the CHRE type to hold the same values."""
+
+        out = []
+        struct_info = self.api.structs_and_unions[chre_type]
+        cpp_type = self._get_cpp_type_name(chre_type)
+        out.extend(self._gen_test_function_signature(
+            'expectEqual', ['const {} &expected'.format(cpp_type),
+                            'const {} &actual'.format(cpp_type)]))
+
+        length_fields = set()
+        for member_info in struct_info['members']:
+            annotations = self._get_member_annotations(member_info)
+            if 'var_len_array' in annotations:
+                length_fields.add(annotations['var_len_array']['length_field'])
+
+        for member_info in struct_info['members']:
+            name = member_info['name']
+            annotations = self._get_member_annotations(member_info)
+            if name in length_fields:
+                # Compared along with the array
+                continue
+            elif 'union_variant' in annotations:
+                out.append('  switch (expected.{}) {{\n'.format(
+                    annotations['union_variant']['discriminator']))
+                for value, field_name in annotations['union_variant']['mapping']:
+                    variant_info = self._get_union_variant_member(member_info, field_name)
+                    out.append('    case {}:\n'.format(value))
+                    out.extend(self._gen_test_compare_member(
+                        variant_info, '{}.{}'.format(name, field_name), '      '))
+                    out.append('      break;\n')
+                out.append('  }\n')
+            elif 'var_len_array' in annotations:
+                length_field = annotations['var_len_array']['length_field']
+                out.append('  ASSERT_EQ(expected.{}, actual.{});\n'.format(
+                    length_field, length_field))
+                if member_info['is_nested_type']:
+                    out.append('  for (size_t i = 0; i < expected.{}; i++) {{\n'.format(
+                        length_field))
+                    out.append('    expectEqual(expected.{}[i], actual.{}[i]);\n'.format(
+                        name, name))
+                    out.append('  }\n')
+                else:
+                    out.extend(self._wrap_call('  ', 'expectSameArray', [
+                        'expected.' + name, 'actual.' + name, 'expected.' + length_field], ';'))
+            elif 'string' in annotations:
+                out.append('  EXPECT_STREQ(expected.{}, actual.{});\n'.format(name, name))
+            else:
+                out.extend(self._gen_test_compare_member(member_info, name, '  '))
+
+        out.append('}\n\n')
+        return out
+
+    def _gen_test_compare_member(self, member_info, field, indent):
+        if member_info['is_nested_type']:
+            return ['{}expectEqual(expected.{}, actual.{});\n'.format(indent, field, field)]
+        return ['{}EXPECT_SAME_FIELD(expected, actual, {});\n'.format(indent, field)]
+
+    def _gen_test_free_function(self, chre_type):
+        """Generates a function freeing the variable-length arrays and strings of the CHRE type,
+        e.g. once it has been decoded.
+        """
+
+        out = []
+        out.append('void freeMembers(const {} &value) {{\n'.format(chre_type))
+        for member_info in self.api.structs_and_unions[chre_type]['members']:
+            annotations = self._get_member_annotations(member_info)
+            if 'var_len_array' in annotations or 'string' in annotations:
+                out.append('  chppFree(CHPP_CONST_CAST_POINTER(value.{}));\n'.format(
+                    member_info['name']))
+        out.append('}\n\n')
+        return out
+
+    def _gen_test_helpers(self):
+        out = []
+        for chre_type in self._sorted_structs(self.json['root_structs']):
+            if not self.api.structs_and_unions[chre_type]['is_union']:
+                out.extend(self._gen_test_fill_function(chre_type))
+                out.extend(self._gen_test_compare_function(chre_type))
+        for chre_type in self.json['root_structs']:
+            if self.api.structs_and_unions[chre_type]['has_vla_member']:
+                out.extend(self._gen_test_free_function(chre_type))
+        return out
+
+    def _gen_test_free_statements(self, chre_type, variable, indent):
+        """Returns the statements freeing the members of the given CHRE type variable, if any."""
+
+        if self.api.structs_and_unions[chre_type]['has_vla_member']:
+            return ['{}freeMembers({});\n'.format(indent, variable)]
+        return []
+
+    def _gen_round_trip_test(self, chre_type):
+        """Generates a test encoding random values of the root CHRE type, then decoding them back.
+
+        The decoded values must be the original ones, and the truncated payloads must be rejected.
+        """
+
+        out = []
+        type_name = self._get_test_type_name(chre_type)
+        chpp_type = self._get_chpp_header_type_from_chre(chre_type)[len('struct '):]
+        encode_function = self._get_encode_allocation_function_name(chre_type)
+        decode_function = self._get_decode_allocation_function_name(chre_type)
+
+        out.append('TEST({}ConvertRoundTripTest, {}) {{\n'.format(
+            self.capitalized_service_name, type_name))
+        out.append('  std::mt19937 rng(kSeed);\n')
+        out.append('  for (size_t i = 0; i < kNumRoundTrips; i++) {\n')
+        out.append('    SCOPED_TRACE(i);\n')
+        out.append('    {} original;\n'.format(chre_type))
+        out.append('    fillRandom(rng, &original);\n\n')
+        out.append('    {} *encoded = nullptr;\n'.format(chpp_type))
+        out.append('    size_t encodedSize = 0;\n')
+        out.extend(self._wrap_call('    bool result = ', encode_function,
+                                   ['&original', '&encoded', '&encodedSize'], ';'))
+        out.append('    ASSERT_TRUE(result);\n')
+        out.append('    ASSERT_NE(encoded, nullptr);\n')
+        out.append('    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);\n\n')
+        out.extend(self._wrap_call('    {} *decoded = '.format(chre_type), decode_function,
+                                   ['&encoded->payload', 'payloadSize'], ';'))
+        out.append('    ASSERT_NE(decoded, nullptr);\n')
+        out.append('    expectEqual(original, *decoded);\n\n')
+        out.append('    // Truncated payloads must be rejected rather than read out of bounds\n')
+        out.extend(self._wrap_call('    {} *truncated = '.format(chre_type), decode_function,
+                                   ['&encoded->payload', 'payloadSize - 1'], ';'))
+        out.append('    EXPECT_EQ(truncated, nullptr);\n\n')
+        out.extend(self._gen_test_free_statements(chre_type, '*decoded', '    '))
+        out.append('    chppFree(decoded);\n')
+        out.append('    chppFree(encoded);\n')
+        out.extend(self._gen_test_free_statements(chre_type, 'original', '    '))
+        out.append('  }\n')
+        out.append('}\n\n')
+        return out
+
+    def _gen_benchmark_test(self, chre_type):
+        """Generates a test timing the conversions of random values of the root CHRE type."""
+
+        out = []
+        type_name = self._get_test_type_name(chre_type)
+        chpp_type = self._get_chpp_header_type_from_chre(chre_type)[len('struct '):]
+        encode_function = self._get_encode_allocation_function_name(chre_type)
+        decode_function = self._get_decode_allocation_function_name(chre_type)
+
+        out.append('TEST({}ConvertBenchmark, DISABLED_{}) {{\n'.format(
+            self.capitalized_service_name, type_name))
+        out.append('  std::mt19937 rng(kSeed);\n')
+        out.append('  {} original;\n'.format(chre_type))
+        out.append('  fillRandom(rng, &original);\n\n')
+        out.append('  {} *encoded = nullptr;\n'.format(chpp_type))
+        out.append('  size_t encodedSize = 0;\n')
+        out.append('  auto start = std::chrono::steady_clock::now();\n')
+        out.append('  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {\n')
+        out.append('    chppFree(encoded);\n')
+        out.extend(self._wrap_call('    ASSERT_TRUE(', encode_function,
+                                   ['&original', '&encoded', '&encodedSize'], ');'))
+        out.append('  }\n')
+        out.append('  auto encodeTime = std::chrono::steady_clock::now() - start;\n\n')
+        out.append('  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);\n')
+        out.append('  start = std::chrono::steady_clock::now();\n')
+        out.append('  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {\n')
+        out.extend(self._wrap_call('    {} *decoded = '.format(chre_type), decode_function,
+                                   ['&encoded->payload', 'payloadSize'], ';'))
+        out.append('    ASSERT_NE(decoded, nullptr);\n')
+        out.extend(self._gen_test_free_statements(chre_type, '*decoded', '    '))
+        out.append('    chppFree(decoded);\n')
+        out.append('  }\n')
+        out.append('  auto decodeTime = std::chrono::steady_clock::now() - start;\n\n')
+        out.append('  printf("{}: encode %lld ns, decode %lld ns\\n",\n'.format(chre_type))
+        out.append('         nsPerIteration(encodeTime), nsPerIteration(decodeTime));\n')
+        out.append('  chppFree(encoded);\n')
+        out.extend(self._gen_test_free_statements(chre_type, 'original', '  '))
+        out.append('}\n\n')
+        return out
+
     # ----------------------------------------------------------------------------------------------
     # Public methods
     # ----------------------------------------------------------------------------------------------
@@ -948,6 +1568,10 @@ class CodeGenerator:
         out.append('#ifdef __cplusplus\nextern "C" {\n#endif\n\n')
         out.extend(self._gen_structs_and_unions())
 
+        out.append('\n// Layout compatibility with the CHRE types, evaluated at compile time. Types\n'
+                   '// with the same layout are converted with bulk copies.\n\n')
+        out.extend(self._gen_layout_macros())
+
         out.append('\n// Encoding functions (CHRE --> CHPP)\n\n')
         out.extend(self._gen_encode_allocation_function_signatures())
 
@@ -992,3 +1616,42 @@ class CodeGenerator:
         out.extend(self._gen_decode_allocation_functions())
 
         return ''.join(out)
+
+    def generate_test_file(self, dry_run=False, skip_clang_format=False):
+        """Generates a C++ test file with round-trip tests and benchmarks of the conversions."""
+
+        filename = self.service_name + '_convert_round_trip_test.cpp'
+        if not dry_run:
+            print('Generating {} ... '.format(filename), end='', flush=True)
+        contents = self.generate_test_string()
+        output_file = os.path.join(
+            system_chre_abs_path(), CHPP_PARSER_TEST_PATH, filename)
+        self._dump_to_file(output_file, contents, dry_run, skip_clang_format)
+        if not dry_run:
+            print('done')
+
+    def generate_test_string(self):
+        """Returns C++ code testing that random CHRE structs are converted to CHPP and back
+        losslessly, and benchmarking the conversions."""
+
+        out = [LICENSE_HEADER, '\n']
+
+        out.extend(self._autogen_notice())
+        out.extend(self._gen_test_includes())
+
+        out.append('namespace {\n\n')
+        out.extend(self._gen_test_constants())
+        out.extend(self._gen_test_helpers())
+        out.append('}  // namespace\n\n')
+
+        out.append('// Round-trip tests, converting random structures from CHRE to CHPP and back\n\n')
+        for chre_type in self.json['root_structs']:
+            out.extend(self._gen_round_trip_test(chre_type))
+
+        out.append('// Benchmarks of the conversions, to compare the bulk copies with the\n'
+                   '// field-by-field conversions across targets. Run with\n'
+                   '// --gtest_also_run_disabled_tests.\n\n')
+        for chre_type in self.json['root_structs']:
+            out.extend(self._gen_benchmark_test(chre_type))
+
+        return ''.join(out).rstrip('\n') + '\n'
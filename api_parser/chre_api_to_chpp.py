@@ -48,6 +48,7 @@ def run(args):
         print('done')
         code_gen.generate_header_file(args.dry_run, args.skip_clang_format)
         code_gen.generate_conversion_file(args.dry_run, args.skip_clang_format)
+        code_gen.generate_test_file(args.dry_run, args.skip_clang_format)
 
 
 def main():
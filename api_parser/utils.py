@@ -21,6 +21,7 @@ import os
 # Paths for output, relative to system/chre
 CHPP_PARSER_INCLUDE_PATH = 'chpp/include/chpp/common'
 CHPP_PARSER_SOURCE_PATH = 'chpp/common'
+CHPP_PARSER_TEST_PATH = 'chpp/test'
 
 LICENSE_HEADER = """/*
  * Copyright (C) 2020 The Android Open Source Project
@@ -28,6 +28,10 @@ ifeq ($(CHRE_WWAN_SUPPORT_ENABLED), true)
 include apps/wwan_world/wwan_world.mk
 endif
 
+ifeq ($(USE_TFLM), true)
+include apps/tflm_demo/tflm_demo.mk
+endif
+
 include apps/debug_dump_world/debug_dump_world.mk
 include apps/hello_world/hello_world.mk
 include apps/host_awake_world/host_awake_world.mk
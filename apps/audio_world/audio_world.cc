@@ -15,14 +15,14 @@
  */
 
 #include <cinttypes>
-#include <cmath>
 
 #include "chre/util/macros.h"
 #include "chre/util/nanoapp/audio.h"
+#include "chre/util/nanoapp/dsp.h"
+#include "chre/util/nanoapp/fft.h"
 #include "chre/util/nanoapp/log.h"
 #include "chre/util/time.h"
 #include "chre_api/chre.h"
-#include "kiss_fftr.h"
 
 #define LOG_TAG "[AudioWorld]"
 
@@ -31,8 +31,10 @@ namespace chre {
 namespace {
 #endif  // CHRE_NANOAPP_INTERNAL
 
+using chre::ComplexQ15;
 using chre::Milliseconds;
 using chre::Nanoseconds;
+using chre::RealFftQ15;
 
 //! The number of frequencies to generate an FFT over.
 constexpr size_t kNumFrequencies = 128;
@@ -43,10 +45,10 @@ bool gAudioRequested = false;
 //! The requested audio handle.
 uint32_t gAudioHandle;
 
-//! State for Kiss FFT and logging.
-uint8_t gKissFftBuffer[4096];
-kiss_fftr_cfg gKissFftConfig;
-kiss_fft_cpx gKissFftOutput[(kNumFrequencies / 2) + 1];
+//! State for the FFT and logging.
+RealFftQ15<kNumFrequencies> gFft;
+ComplexQ15 gFftOutput[RealFftQ15<kNumFrequencies>::kNumBins];
+uint16_t gFftMagnitudes[RealFftQ15<kNumFrequencies>::kNumBins];
 Milliseconds gFirstAudioEventTimestamp = Milliseconds(0);
 
 /**
@@ -74,22 +76,6 @@ char getFftCharForValue(uint16_t value) {
   }
 }
 
-/**
- * Initializes Kiss FFT.
- */
-void initKissFft() {
-  size_t kissFftBufferSize = sizeof(gKissFftBuffer);
-  gKissFftConfig = kiss_fftr_alloc(kNumFrequencies, false, gKissFftBuffer,
-                                   &kissFftBufferSize);
-  if (gKissFftConfig == NULL) {
-    LOGE("Failed to init Kiss FFT, needs minimum %zu buffer size",
-         kissFftBufferSize);
-  } else {
-    LOGI("Initialized Kiss FFT, using %zu/%zu of the buffer", kissFftBufferSize,
-         sizeof(gKissFftBuffer));
-  }
-}
-
 /**
  * Logs an audio data event with an FFT visualization of the received audio
  * data.
@@ -97,15 +83,15 @@ void initKissFft() {
  * @param event the audio data event to log.
  */
 void handleAudioDataEvent(const struct chreAudioDataEvent *event) {
-  kiss_fftr(gKissFftConfig, event->samplesS16, gKissFftOutput);
+  gFft.forward(event->samplesS16, gFftOutput);
+  chre::computeMagnitudesQ15(gFftOutput, gFftMagnitudes,
+                             ARRAY_SIZE(gFftMagnitudes));
 
-  char fftStr[ARRAY_SIZE(gKissFftOutput) + 1];
-  fftStr[ARRAY_SIZE(gKissFftOutput)] = '\0';
+  char fftStr[ARRAY_SIZE(gFftMagnitudes) + 1];
+  fftStr[ARRAY_SIZE(gFftMagnitudes)] = '\0';
 
-  for (size_t i = 0; i < ARRAY_SIZE(gKissFftOutput); i++) {
-    float value =
-        sqrtf(powf(gKissFftOutput[i].r, 2) + powf(gKissFftOutput[i].i, 2));
-    fftStr[i] = getFftCharForValue(static_cast<uint16_t>(value));
+  for (size_t i = 0; i < ARRAY_SIZE(gFftMagnitudes); i++) {
+    fftStr[i] = getFftCharForValue(gFftMagnitudes[i]);
   }
 
   Milliseconds timestamp = Milliseconds(Nanoseconds(event->timestamp));
@@ -167,8 +153,6 @@ bool nanoappStart() {
     }
   }
 
-  initKissFft();
-
   int8_t settingState = chreUserSettingGetState(CHRE_USER_SETTING_MICROPHONE);
   LOGD("Microphone setting status: %d", settingState);
 
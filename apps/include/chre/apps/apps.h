@@ -33,6 +33,7 @@ UniquePtr<Nanoapp> initializeStaticNanoappMessageWorld();
 UniquePtr<Nanoapp> initializeStaticNanoappPowerTest();
 UniquePtr<Nanoapp> initializeStaticNanoappSensorWorld();
 UniquePtr<Nanoapp> initializeStaticNanoappSpammer();
+UniquePtr<Nanoapp> initializeStaticNanoappTflmDemo();
 UniquePtr<Nanoapp> initializeStaticNanoappTimerWorld();
 UniquePtr<Nanoapp> initializeStaticNanoappUnloadTester();
 UniquePtr<Nanoapp> initializeStaticNanoappWifiWorld();
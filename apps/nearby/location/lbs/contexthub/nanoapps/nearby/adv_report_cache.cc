@@ -16,6 +16,7 @@
 
 #include "location/lbs/contexthub/nanoapps/nearby/adv_report_cache.h"
 
+#include <cstring>
 #include <utility>
 
 #include "chre_api/chre.h"
@@ -24,16 +25,31 @@
 #define LOG_TAG "[NEARBY][ADV_CACHE]"
 
 namespace nearby {
+namespace {
+
+// 32-bit FNV-1a parameters.
+constexpr uint32_t kFnvOffsetBasis = 2166136261u;
+constexpr uint32_t kFnvPrime = 16777619u;
+
+uint32_t FnvHash(uint32_t hash, const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ data[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+}  // namespace
 
 void AdvReportCache::Clear() {
   // Release all resources.
   for (const auto &report : cache_reports_) {
-    if (report.dataLength == 0) {
-      continue;
-    }
-    chreHeapFree(const_cast<uint8_t *>(report.data));
+    FreePayload(report);
   }
   cache_reports_.clear();
+  if (index_ != nullptr) {
+    chreHeapFree(index_);
+    index_ = nullptr;
+  }
 }
 
 void AdvReportCache::Refresh() {
@@ -46,13 +62,9 @@ void AdvReportCache::Refresh() {
   while (index < cache_reports_.size()) {
     if (current_time - cache_reports_[index].timestamp >
         cache_expire_nanosec_) {
-      // TODO(b/285043291): Refactor cache element by wrapper struct/class
-      // which deallocates data in its destructor.
-      chreHeapFree(const_cast<uint8_t *>(cache_reports_[index].data));
       // The index does not need to increase because the current element is
       // replaced by the end of the element and the list is resized.
-      cache_reports_.swap(index, cache_reports_.size() - 1);
-      cache_reports_.resize(cache_reports_.size() - 1);
+      RemoveAt(static_cast<uint8_t>(index));
     } else {
       ++index;
     }
@@ -69,59 +81,216 @@ void AdvReportCache::Push(const chreBleAdvertisingReport &event_report) {
 #ifdef NEARBY_PROFILE
   ashProfileBegin(&profile_data_);
 #endif
-  bool is_duplicate = false;
-  for (auto &cache_report : cache_reports_) {
-    if (cache_report.addressType == event_report.addressType &&
-        memcmp(cache_report.address, event_report.address,
-               CHRE_BLE_ADDRESS_LEN) == 0 &&
-        cache_report.dataLength == event_report.dataLength &&
-        memcmp(cache_report.data, event_report.data, cache_report.dataLength) ==
-            0) {
-      // Updates RSSI by max value in the duplicated report.
-      if (cache_report.rssi == CHRE_BLE_RSSI_NONE ||
-          (event_report.rssi != CHRE_BLE_RSSI_NONE &&
-           event_report.rssi > cache_report.rssi)) {
-        cache_report.rssi = event_report.rssi;
-      }
-      // Updates timestamp to latest in the duplicated report.
-      if (event_report.timestamp > cache_report.timestamp) {
-        cache_report.timestamp = event_report.timestamp;
-      }
-      is_duplicate = true;
-      break;
-    }
+  if (!EnsureIndex()) {
+    LOGE("Memory allocation failed!");
+    return;
   }
-  if (!is_duplicate) {
+
+  uint32_t hash = HashReport(event_report);
+  uint8_t index = Find(event_report, hash);
+  if (index != kInvalidIndex) {
+    LOGD("Duplicated report in advertising reports cache");
+    chreBleAdvertisingReport &cache_report = cache_reports_[index];
+    // Updates RSSI by max value in the duplicated report.
+    if (cache_report.rssi == CHRE_BLE_RSSI_NONE ||
+        (event_report.rssi != CHRE_BLE_RSSI_NONE &&
+         event_report.rssi > cache_report.rssi)) {
+      cache_report.rssi = event_report.rssi;
+    }
+    // Updates timestamp to latest in the duplicated report.
+    if (event_report.timestamp > cache_report.timestamp) {
+      cache_report.timestamp = event_report.timestamp;
+    }
+    LruRemove(index);
+    LruAppend(index);
+  } else {
     LOGD("Adds to advertising reports cache");
+    if (cache_reports_.size() >= kMaxCacheSize) {
+      Refresh();
+    }
+    if (cache_reports_.size() >= kMaxCacheSize) {
+      EvictOldest();
+    }
     // Copies advertise report by value.
     chreBleAdvertisingReport new_report = event_report;
     // Allocates advertise data and copy it.
-    uint16_t dataLength = event_report.dataLength;
-    uint8_t *data = nullptr;
-    if (dataLength > 0) {
-      data =
-          static_cast<uint8_t *>(chreHeapAlloc(sizeof(uint8_t) * dataLength));
+    if (event_report.dataLength > 0) {
+      uint8_t *data =
+          AllocatePayload(event_report.data, event_report.dataLength);
       if (data == nullptr) {
         LOGE("Memory allocation failed!");
         // Clean up expired cache elements for which heap memory is allocated.
         Refresh();
         return;
       }
-      memcpy(data, event_report.data, dataLength);
       new_report.data = data;
     }
-    if (!cache_reports_.push_back(std::move(new_report))) {
+    if (!cache_reports_.push_back(new_report)) {
       LOGE("Pushes advertise report failed!");
-      if (data != nullptr) {
-        chreHeapFree(const_cast<uint8_t *>(data));
-      }
+      FreePayload(new_report);
+    } else {
+      index = static_cast<uint8_t>(cache_reports_.size() - 1);
+      uint8_t bucket = hash % kNumBuckets;
+      index_->hashes[index] = hash;
+      index_->next[index] = index_->bucket_heads[bucket];
+      index_->bucket_heads[bucket] = index;
+      LruAppend(index);
     }
-  } else {
-    LOGD("Duplicated report in advertising reports cache");
   }
 #ifdef NEARBY_PROFILE
   ashProfileEnd(&profile_data_, nullptr /* output */);
 #endif
 }
 
+uint32_t AdvReportCache::HashReport(const chreBleAdvertisingReport &report) {
+  // Only hashes the address, which is enough to tell advertisers apart, so
+  // that the data is only compared against reports of the same advertiser.
+  uint32_t hash = FnvHash(kFnvOffsetBasis, &report.addressType, 1);
+  return FnvHash(hash, report.address, CHRE_BLE_ADDRESS_LEN);
+}
+
+bool AdvReportCache::IsSameReport(const chreBleAdvertisingReport &a,
+                                  const chreBleAdvertisingReport &b) {
+  return a.addressType == b.addressType &&
+         memcmp(a.address, b.address, CHRE_BLE_ADDRESS_LEN) == 0 &&
+         a.dataLength == b.dataLength &&
+         (a.dataLength == 0 || memcmp(a.data, b.data, a.dataLength) == 0);
+}
+
+bool AdvReportCache::EnsureIndex() {
+  if (index_ != nullptr) {
+    return true;
+  }
+  index_ = static_cast<Index *>(chreHeapAlloc(sizeof(Index)));
+  if (index_ == nullptr) {
+    return false;
+  }
+  memset(index_->bucket_heads, kInvalidIndex, sizeof(index_->bucket_heads));
+  index_->lru_head = kInvalidIndex;
+  index_->lru_tail = kInvalidIndex;
+  for (uint8_t i = 0; i < kMaxCacheSize; ++i) {
+    index_->free_slots[i] = i;
+  }
+  index_->free_slot_count = kMaxCacheSize;
+  // Avoids reallocating the reports while the cache fills up.
+  cache_reports_.reserve(kMaxCacheSize);
+  return true;
+}
+
+uint8_t AdvReportCache::Find(const chreBleAdvertisingReport &report,
+                             uint32_t hash) const {
+  for (uint8_t i = index_->bucket_heads[hash % kNumBuckets]; i != kInvalidIndex;
+       i = index_->next[i]) {
+    if (index_->hashes[i] == hash && IsSameReport(cache_reports_[i], report)) {
+      return i;
+    }
+  }
+  return kInvalidIndex;
+}
+
+uint8_t *AdvReportCache::AllocatePayload(const uint8_t *data,
+                                         uint16_t length) {
+  uint8_t *payload;
+  if (length <= kPayloadSlotSize && index_->free_slot_count > 0) {
+    uint8_t slot = index_->free_slots[--index_->free_slot_count];
+    payload = index_->payload_slots[slot];
+  } else {
+    payload = static_cast<uint8_t *>(chreHeapAlloc(length));
+    if (payload == nullptr) {
+      return nullptr;
+    }
+  }
+  memcpy(payload, data, length);
+  return payload;
+}
+
+void AdvReportCache::FreePayload(const chreBleAdvertisingReport &report) {
+  if (report.dataLength == 0 || report.data == nullptr) {
+    return;
+  }
+  auto address = reinterpret_cast<uintptr_t>(report.data);
+  auto slots_begin = reinterpret_cast<uintptr_t>(index_->payload_slots);
+  auto slots_end = slots_begin + sizeof(index_->payload_slots);
+  if (address >= slots_begin && address < slots_end) {
+    index_->free_slots[index_->free_slot_count++] =
+        static_cast<uint8_t>((address - slots_begin) / kPayloadSlotSize);
+  } else {
+    chreHeapFree(const_cast<uint8_t *>(report.data));
+  }
+}
+
+void AdvReportCache::Unlink(uint8_t index) {
+  uint8_t *link = &index_->bucket_heads[index_->hashes[index] % kNumBuckets];
+  while (*link != index) {
+    link = &index_->next[*link];
+  }
+  *link = index_->next[index];
+}
+
+void AdvReportCache::RemoveAt(uint8_t index) {
+  FreePayload(cache_reports_[index]);
+  Unlink(index);
+  LruRemove(index);
+
+  auto last = static_cast<uint8_t>(cache_reports_.size() - 1);
+  if (index != last) {
+    // Moves the last report to the removed index.
+    uint8_t *link = &index_->bucket_heads[index_->hashes[last] % kNumBuckets];
+    while (*link != last) {
+      link = &index_->next[*link];
+    }
+    *link = index;
+    index_->next[index] = index_->next[last];
+    index_->hashes[index] = index_->hashes[last];
+
+    uint8_t prev = index_->lru_prev[last];
+    uint8_t next = index_->lru_next[last];
+    index_->lru_prev[index] = prev;
+    index_->lru_next[index] = next;
+    if (prev == kInvalidIndex) {
+      index_->lru_head = index;
+    } else {
+      index_->lru_next[prev] = index;
+    }
+    if (next == kInvalidIndex) {
+      index_->lru_tail = index;
+    } else {
+      index_->lru_prev[next] = index;
+    }
+    cache_reports_.swap(index, last);
+  }
+  cache_reports_.resize(last);
+}
+
+void AdvReportCache::LruAppend(uint8_t index) {
+  index_->lru_prev[index] = index_->lru_tail;
+  index_->lru_next[index] = kInvalidIndex;
+  if (index_->lru_tail == kInvalidIndex) {
+    index_->lru_head = index;
+  } else {
+    index_->lru_next[index_->lru_tail] = index;
+  }
+  index_->lru_tail = index;
+}
+
+void AdvReportCache::LruRemove(uint8_t index) {
+  uint8_t prev = index_->lru_prev[index];
+  uint8_t next = index_->lru_next[index];
+  if (prev == kInvalidIndex) {
+    index_->lru_head = next;
+  } else {
+    index_->lru_next[prev] = next;
+  }
+  if (next == kInvalidIndex) {
+    index_->lru_tail = prev;
+  } else {
+    index_->lru_prev[next] = prev;
+  }
+}
+
+void AdvReportCache::EvictOldest() {
+  LOGD("Evicts least recently updated report from advertising reports cache");
+  RemoveAt(index_->lru_head);
+}
+
 }  // namespace nearby
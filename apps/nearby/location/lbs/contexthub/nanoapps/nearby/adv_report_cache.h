@@ -22,11 +22,20 @@
 #include <ash/profile.h>
 #endif
 
+#include <cstdint>
 #include <limits>
 #include <utility>
 
 #include "third_party/contexthub/chre/util/include/chre/util/dynamic_vector.h"
 
+// Maximum number of advertising reports held by the cache. Each report takes
+// about 40 bytes of index and payload storage, and the count must be less than
+// 255 as reports are indexed by uint8_t. Can be overridden to trade memory for
+// fewer evictions.
+#ifndef NEARBY_ADV_REPORT_CACHE_SIZE
+#define NEARBY_ADV_REPORT_CACHE_SIZE 64
+#endif
+
 namespace nearby {
 
 class AdvReportCache {
@@ -55,6 +64,8 @@ class AdvReportCache {
     Clear();
     cache_reports_ = std::move(other.cache_reports_);
     cache_expire_nanosec_ = other.cache_expire_nanosec_;
+    index_ = other.index_;
+    other.index_ = nullptr;
     return *this;
   }
 
@@ -65,9 +76,12 @@ class AdvReportCache {
   // unique key which is {advertiser address and data}.
   // Among advertise report with the same key, latest one will be placed at the
   // same index of existing report in advertise reports cache.
+  // If the cache is full, expired reports are removed first, then the least
+  // recently updated report is evicted.
   void Push(const chreBleAdvertisingReport &report);
 
   // Return advertise reports in cache after refreshing the cache elements.
+  // The address and data of the returned reports must not be modified.
   chre::DynamicVector<chreBleAdvertisingReport> &GetAdvReports() {
     Refresh();
     return cache_reports_;
@@ -107,7 +121,84 @@ class AdvReportCache {
   // cache elements exired.
   static constexpr size_t kRefreshCacheCountThreshold = 8;
 
+  // Maximum number of reports in cache.
+  static constexpr uint8_t kMaxCacheSize = NEARBY_ADV_REPORT_CACHE_SIZE;
+
+  // Number of hash buckets of the cache index.
+  static constexpr uint8_t kNumBuckets = kMaxCacheSize;
+
+  // Size of a payload slot of the cache index. Legacy advertisements fit in a
+  // slot, while larger payloads are allocated from the heap.
+  static constexpr uint16_t kPayloadSlotSize = 32;
+
+  // Marks the end of a bucket chain.
+  static constexpr uint8_t kInvalidIndex = 0xff;
+
+  static_assert(NEARBY_ADV_REPORT_CACHE_SIZE > 0 &&
+                    NEARBY_ADV_REPORT_CACHE_SIZE < kInvalidIndex,
+                "NEARBY_ADV_REPORT_CACHE_SIZE must be in [1, 254]");
+
+  // Hash index over cache_reports_ and payload storage. Allocated on the first
+  // push, so that empty caches only cost a pointer.
+  struct Index {
+    // Index in cache_reports_ of the first report of each bucket.
+    uint8_t bucket_heads[kNumBuckets];
+    // Index in cache_reports_ of the next report in the same bucket.
+    uint8_t next[kMaxCacheSize];
+    // Hash of the key of each report in cache_reports_.
+    uint32_t hashes[kMaxCacheSize];
+    // Doubly linked list of the reports in cache_reports_, from the least to
+    // the most recently updated one.
+    uint8_t lru_prev[kMaxCacheSize];
+    uint8_t lru_next[kMaxCacheSize];
+    uint8_t lru_head;
+    uint8_t lru_tail;
+    // Indices of the unused payload slots.
+    uint8_t free_slots[kMaxCacheSize];
+    uint8_t free_slot_count;
+    // Payload storage for reports of at most kPayloadSlotSize bytes.
+    uint8_t payload_slots[kMaxCacheSize][kPayloadSlotSize];
+  };
+
+  // Computes the hash of the advertiser address of a report.
+  static uint32_t HashReport(const chreBleAdvertisingReport &report);
+
+  // Returns whether two reports have the same deduplication key.
+  static bool IsSameReport(const chreBleAdvertisingReport &a,
+                           const chreBleAdvertisingReport &b);
+
+  // Allocates the index if needed. Returns false if the allocation failed.
+  bool EnsureIndex();
+
+  // Returns the index in cache_reports_ of the report with the same key, or
+  // kInvalidIndex if none.
+  uint8_t Find(const chreBleAdvertisingReport &report, uint32_t hash) const;
+
+  // Copies report data to a payload slot, or to the heap if it doesn't fit.
+  // Returns nullptr if the allocation failed.
+  uint8_t *AllocatePayload(const uint8_t *data, uint16_t length);
+
+  // Releases the payload of a report.
+  void FreePayload(const chreBleAdvertisingReport &report);
+
+  // Unlinks the report at the given index from its bucket chain.
+  void Unlink(uint8_t index);
+
+  // Removes the report at the given index, moving the last report to it.
+  void RemoveAt(uint8_t index);
+
+  // Appends the report at the given index to the LRU list.
+  void LruAppend(uint8_t index);
+
+  // Removes the report at the given index from the LRU list.
+  void LruRemove(uint8_t index);
+
+  // Removes the least recently updated report.
+  void EvictOldest();
+
   chre::DynamicVector<chreBleAdvertisingReport> cache_reports_;
+  // Hash index, nullptr until the first push.
+  Index *index_ = nullptr;
   // Current cache timeout value.
   uint64_t cache_expire_nanosec_ = kMaxExpireTimeNanoSec;
 #ifdef NEARBY_PROFILE
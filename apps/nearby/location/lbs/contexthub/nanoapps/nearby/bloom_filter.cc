@@ -18,8 +18,6 @@
 
 #include <cstring>
 
-#include "location/lbs/contexthub/nanoapps/nearby/crypto/sha2.h"
-
 namespace nearby {
 
 inline static uint32_t BSWAP32(uint32_t value) {
@@ -49,7 +47,18 @@ size_t BloomFilter::Init(const uint8_t filter[], size_t size) {
 bool BloomFilter::MayContain(const uint8_t key[], size_t size) {
   uint32_t hash[SHA2_HASH_WORDS];
   sha256(key, static_cast<uint32_t>(size), hash, sizeof(hash));
+  return MayContainHash(hash);
+}
+
+bool BloomFilter::MayContain(const Sha2Prefix &prefix, const uint8_t suffix[],
+                             size_t size) {
+  uint32_t hash[SHA2_HASH_WORDS];
+  sha256WithPrefix(&prefix, suffix, static_cast<uint32_t>(size), hash,
+                   sizeof(hash));
+  return MayContainHash(hash);
+}
 
+bool BloomFilter::MayContainHash(uint32_t hash[SHA2_HASH_WORDS]) {
   for (size_t i = 0; i < SHA2_HASH_WORDS; i++) {
     hash[i] = BSWAP32(hash[i]);
     uint32_t bitPos = hash[i] % (filter_bit_size_);
@@ -22,6 +22,8 @@
 
 #include <cstddef>
 
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/sha2.h"
+
 namespace nearby {
 
 // Bloom filter to test if an account key is included.
@@ -37,6 +39,11 @@ class BloomFilter {
   // Returns true if the key is set in the Bloom filter.
   bool MayContain(const uint8_t key[], size_t size);
 
+  // Returns true if the key made of the precomputed prefix followed by suffix
+  // is set in the Bloom filter.
+  bool MayContain(const Sha2Prefix &prefix, const uint8_t suffix[],
+                  size_t size);
+
  private:
   uint8_t filter_[kMaxBloomFilterByteSize] = {0};
   size_t filter_bit_size_;
@@ -44,6 +51,9 @@ class BloomFilter {
   // Initializes filter uint8_t array
   // Returns byte size of filter as min(kMaxBloomFilterByteSize, size)
   size_t Init(const uint8_t filter[], size_t size);
+
+  // Returns true if all the bits selected by the SHA256 hash of a key are set.
+  bool MayContainHash(uint32_t hash[SHA2_HASH_WORDS]);
 };
 
 }  // namespace nearby
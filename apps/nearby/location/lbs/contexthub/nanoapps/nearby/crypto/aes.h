@@ -28,6 +28,11 @@ extern "C" {
  * External APIs:
  *  - aesCtrInit() for AES/CTR initialization
  *  - aesCtr() for AES/CTR encryption and decryption
+ *
+ * Build options:
+ *  - AES_FOUR_TABLES uses four 1KB round tables instead of one table and
+ *    rotations. Faster on cores that can't rotate an operand for free, at the
+ *    cost of 3KB of read-only data.
  */
 
 #include <stddef.h>
@@ -97,3 +97,15 @@ void hkdf(const void *inSalt, size_t saltLen, const void *inKm, size_t ikmLen,
    */
   hkdfExpand(prk_hmac, sizeof(prk_hmac), info, infoLen, outKm, okmLen);
 }
+
+void hkdfWithSaltKey(const struct HmacKey *saltKey, const void *inKm,
+                     size_t ikmLen, const void *info, size_t infoLen,
+                     void *outKm, size_t okmLen) {
+  if (outKm == NULL || okmLen == 0) return;
+
+  // pseudorandom key, extracted with the precomputed salt state
+  uint8_t prk_hmac[SHA2_HASH_SIZE];
+  hmacSha256WithKey(saltKey, inKm, ikmLen, prk_hmac, sizeof(prk_hmac));
+
+  hkdfExpand(prk_hmac, sizeof(prk_hmac), info, infoLen, outKm, okmLen);
+}
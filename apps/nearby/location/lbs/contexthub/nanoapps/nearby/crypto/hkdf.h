@@ -27,10 +27,13 @@ extern "C" {
  *
  * External a single API:
  *  - hkdf() for extracting and expanding keys derivation function
+ *  - hkdfWithSaltKey() for the same with a precomputed HMAC state of the salt
  */
 
 #include <stddef.h>
 
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/hmac.h"
+
 /**
  * hkdf:
  * @inSalt: input salt byte array
@@ -54,6 +57,25 @@ extern "C" {
 void hkdf(const void *inSalt, size_t saltLen, const void *inKm, size_t ikmLen,
           const void *info, size_t infoLen, void *outKm, size_t okmLen);
 
+/**
+ * hkdfWithSaltKey:
+ * @saltKey: HMAC key state of the salt, initialized by hmacKeyInit()
+ * @inKm: input key material byte array
+ * @ikmLen: number of bytes of the input key material byte array
+ * @info: arbitrary string used to bind a derived key to an intended context
+ * @infoLen number of bytes of the info byte array
+ * @outKm: output key material byte array
+ * @okmLen: number of bytes of the output key material byte array
+ *
+ * Generates the same output as hkdf() with the salt of the HMAC key state,
+ * without hashing the padded salt again
+ *
+ * Returns:
+ */
+void hkdfWithSaltKey(const struct HmacKey *saltKey, const void *inKm,
+                     size_t ikmLen, const void *info, size_t infoLen,
+                     void *outKm, size_t okmLen);
+
 #ifdef __cplusplus
 }
 #endif
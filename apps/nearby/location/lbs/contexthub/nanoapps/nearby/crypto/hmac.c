@@ -24,7 +24,8 @@ static void sha2InitHmacKeyUpdate(struct HmacContext *ctx) {
   sha2processBytes(&ctx->sha2ctx, ctx->k_ipad, sizeof(ctx->k_ipad));
 }
 
-void hmacInit(struct HmacContext *ctx, const void *inKey, const size_t keyLen) {
+static void hmacInitKeys(struct HmacContext *ctx, const void *inKey,
+                         const size_t keyLen) {
   // initialize hmac keys
   memset(ctx->k, 0, sizeof(ctx->k));
   memset(ctx->k_ipad, 0x36, sizeof(ctx->k_ipad));
@@ -37,6 +38,10 @@ void hmacInit(struct HmacContext *ctx, const void *inKey, const size_t keyLen) {
     ctx->k_ipad[i] ^= ctx->k[i];
     ctx->k_opad[i] ^= ctx->k[i];
   }
+}
+
+void hmacInit(struct HmacContext *ctx, const void *inKey, const size_t keyLen) {
+  hmacInitKeys(ctx, inKey, keyLen);
   // initialize sha2 context and update hmac keys to the sha2 context
   sha2InitHmacKeyUpdate(ctx);
 }
@@ -79,3 +84,21 @@ void hmacSha256(const void *inKey, const size_t keyLen, const void *inData,
   hmacUpdate(&ctx, inData, dataLen);
   hmacFinish(&ctx, outHash, hashLen);
 }
+
+void hmacKeyInit(struct HmacKey *key, const void *inKey, const size_t keyLen) {
+  struct HmacContext ctx;
+  hmacInitKeys(&ctx, inKey, keyLen);
+  // the padded keys are one block each, so their hash states are complete
+  sha2prefixInit(&key->inner, ctx.k_ipad, sizeof(ctx.k_ipad));
+  sha2prefixInit(&key->outer, ctx.k_opad, sizeof(ctx.k_opad));
+}
+
+void hmacSha256WithKey(const struct HmacKey *key, const void *inData,
+                       const size_t dataLen, void *outHash,
+                       const size_t hashLen) {
+  uint8_t ihash[SHA2_HASH_SIZE];
+  sha256WithPrefix(&key->inner, inData, (uint32_t)dataLen, ihash,
+                   sizeof(ihash));
+  sha256WithPrefix(&key->outer, ihash, sizeof(ihash), outHash,
+                   (uint32_t)hashLen);
+}
@@ -34,6 +34,10 @@ extern "C" {
  * External a single API:
  *  - hmacSha256() for performing the separated three APIs at a time:
  *    hmacInit(), hmacUpdate(), and hmacFinish()
+ *
+ * External APIs for computing several HMACs with the same key:
+ *  - hmacKeyInit() for precomputing the hash state of the HMAC key
+ *  - hmacSha256WithKey() for generating HMAC-SHA256 keyed-hash output
  */
 #include <stdbool.h>
 
@@ -48,6 +52,11 @@ struct HmacContext {
   bool is_hmac_updated;
 };
 
+struct HmacKey {
+  struct Sha2Prefix inner;
+  struct Sha2Prefix outer;
+};
+
 /**
  * hmacSha256:
  * @inKey: input key byte array
@@ -117,6 +126,34 @@ void hmacUpdateHashInit(struct HmacContext *ctx, const void *inData,
  * Returns:
  */
 void hmacFinish(struct HmacContext *ctx, void *outHash, size_t hashLen);
+
+/**
+ * hmacKeyInit:
+ * @key: HMAC key state
+ * @inKey: input key byte array
+ * @keyLen: number of bytes of the input key array
+ *
+ * Precomputes the inner and outer hash states of the padded HMAC key
+ *
+ * Returns:
+ */
+void hmacKeyInit(struct HmacKey *key, const void *inKey, size_t keyLen);
+
+/**
+ * hmacSha256WithKey:
+ * @key: HMAC key state initialized
+ * @inData: input data byte array to hash
+ * @dataLen: number of bytes of the input byte array
+ * @outHash: output keyed-hash byte array
+ * @hashLen: number of bytes of the output byte array
+ *
+ * Generates the same keyed-hash as hmacSha256() with the key of the HMAC key
+ * state, without hashing the padded key again
+ *
+ * Returns:
+ */
+void hmacSha256WithKey(const struct HmacKey *key, const void *inData,
+                       size_t dataLen, void *outHash, size_t hashLen);
 #ifdef __cplusplus
 }
 #endif
@@ -43,6 +43,8 @@ void sha2init(struct Sha2Context *ctx) {
   ctx->h[7] = 0x5be0cd19;
   ctx->msgLen = 0;
   ctx->bufBytesUsed = 0;
+  ctx->roundState = NULL;
+  ctx->firstRound = 0;
 }
 
 #ifdef ARM
@@ -71,8 +73,7 @@ inline static uint32_t ror(uint32_t val, uint32_t by) {
 
 #endif
 
-static void sha2processBlock(struct Sha2Context *ctx) {
-  static const uint32_t k[] = {
+static const uint32_t k[] = {
       0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
       0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
       0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
@@ -84,8 +85,52 @@ static void sha2processBlock(struct Sha2Context *ctx) {
       0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
       0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
       0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
-  };
-  uint32_t i, a, b, c, d, e, f, g, h;
+};
+
+// runs rounds [first, last) over the working variables in vars
+static void sha2rounds(uint32_t *vars, const uint32_t *w, uint32_t first,
+                       uint32_t last) {
+  uint32_t i;
+  uint32_t a = vars[0];
+  uint32_t b = vars[1];
+  uint32_t c = vars[2];
+  uint32_t d = vars[3];
+  uint32_t e = vars[4];
+  uint32_t f = vars[5];
+  uint32_t g = vars[6];
+  uint32_t h = vars[7];
+
+  for (i = first; i < last; i++) {
+    uint32_t s1 = ror(e, 6) ^ ror(e, 11) ^ ror(e, 25);
+    uint32_t ch = (e & f) ^ ((~e) & g);
+    uint32_t temp1 = h + s1 + ch + k[i] + w[i];
+    uint32_t s0 = ror(a, 2) ^ ror(a, 13) ^ ror(a, 22);
+    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t temp2 = s0 + maj;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  vars[0] = a;
+  vars[1] = b;
+  vars[2] = c;
+  vars[3] = d;
+  vars[4] = e;
+  vars[5] = f;
+  vars[6] = g;
+  vars[7] = h;
+}
+
+static void sha2processBlock(struct Sha2Context *ctx) {
+  uint32_t i;
+  uint32_t vars[SHA2_HASH_WORDS];
 
   // input and output streams are little-endian
   // SHA specification uses big-endian
@@ -102,44 +147,19 @@ static void sha2processBlock(struct Sha2Context *ctx) {
     ctx->w[i] = ctx->w[i - 16] + s0 + ctx->w[i - 7] + s1;
   }
 
-  // init working variables
-  a = ctx->h[0];
-  b = ctx->h[1];
-  c = ctx->h[2];
-  d = ctx->h[3];
-  e = ctx->h[4];
-  f = ctx->h[5];
-  g = ctx->h[6];
-  h = ctx->h[7];
+  // init working variables, skipping the precomputed rounds if any
+  if (ctx->firstRound) {
+    memcpy(vars, ctx->roundState, sizeof(vars));
+  } else {
+    memcpy(vars, ctx->h, sizeof(vars));
+  }
 
   // 64 rounds
-  for (i = 0; i < 64; i++) {
-    uint32_t s1 = ror(e, 6) ^ ror(e, 11) ^ ror(e, 25);
-    uint32_t ch = (e & f) ^ ((~e) & g);
-    uint32_t temp1 = h + s1 + ch + k[i] + ctx->w[i];
-    uint32_t s0 = ror(a, 2) ^ ror(a, 13) ^ ror(a, 22);
-    uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
-    uint32_t temp2 = s0 + maj;
-
-    h = g;
-    g = f;
-    f = e;
-    e = d + temp1;
-    d = c;
-    c = b;
-    b = a;
-    a = temp1 + temp2;
-  }
+  sha2rounds(vars, ctx->w, ctx->firstRound, 64);
+  ctx->firstRound = 0;
 
   // put result back into context
-  ctx->h[0] += a;
-  ctx->h[1] += b;
-  ctx->h[2] += c;
-  ctx->h[3] += d;
-  ctx->h[4] += e;
-  ctx->h[5] += f;
-  ctx->h[6] += g;
-  ctx->h[7] += h;
+  for (i = 0; i < SHA2_HASH_WORDS; i++) ctx->h[i] += vars[i];
 }
 
 void sha2processBytes(struct Sha2Context *ctx, const void *inData,
@@ -175,9 +195,16 @@ void sha2finish(struct Sha2Context *ctx, void *outHash, uint32_t hashLen) {
   // append the one
   sha2processBytes(ctx, &appendend, 1);
 
-  // append the zeroes
-  appendend = 0;
-  while (ctx->bufBytesUsed != 56) sha2processBytes(ctx, &appendend, 1);
+  // append the zeroes, filling the current block first if the length doesn't
+  // fit in it
+  if (ctx->bufBytesUsed > 56) {
+    memset(ctx->b + ctx->bufBytesUsed, 0,
+           SHA2_BLOCK_SIZE - ctx->bufBytesUsed);
+    sha2processBlock(ctx);
+    ctx->bufBytesUsed = 0;
+  }
+  memset(ctx->b + ctx->bufBytesUsed, 0, 56 - ctx->bufBytesUsed);
+  ctx->bufBytesUsed = 56;
 
   // append the length in bits (we can safely write into context since we're
   // sure where to write to (we're definitely 56-bytes into a block)
@@ -204,3 +231,39 @@ void sha256(const void *inData, const uint32_t dataLen, void *outHash,
   sha2processBytes(&ctx, inData, dataLen);
   sha2finish(&ctx, outHash, hashLen);
 }
+
+void sha2prefixInit(struct Sha2Prefix *prefix, const void *inData,
+                    size_t dataLen) {
+  struct Sha2Context ctx;
+  uint32_t w[SHA2_BLOCK_SIZE / sizeof(uint32_t)];
+  uint32_t i;
+
+  // compress the blocks fully covered by the prefix
+  sha2init(&ctx);
+  sha2processBytes(&ctx, inData, dataLen);
+  memcpy(prefix->h, ctx.h, sizeof(prefix->h));
+  prefix->msgLen = ctx.msgLen;
+  memcpy(prefix->b, ctx.b, ctx.bufBytesUsed);
+  prefix->bufBytesUsed = ctx.bufBytesUsed;
+
+  // round i of the next block only depends on the words [0, i] of the block,
+  // so run the rounds of the complete words of the prefix
+  prefix->numRounds = ctx.bufBytesUsed / sizeof(uint32_t);
+  memcpy(w, ctx.b, prefix->numRounds * sizeof(uint32_t));
+  for (i = 0; i < prefix->numRounds; i++) w[i] = BSWAP32(w[i]);
+  memcpy(prefix->state, ctx.h, sizeof(prefix->state));
+  sha2rounds(prefix->state, w, 0, prefix->numRounds);
+}
+
+void sha256WithPrefix(const struct Sha2Prefix *prefix, const void *inData,
+                      uint32_t dataLen, void *outHash, uint32_t hashLen) {
+  struct Sha2Context ctx;
+  memcpy(ctx.h, prefix->h, sizeof(ctx.h));
+  ctx.msgLen = prefix->msgLen;
+  memcpy(ctx.b, prefix->b, prefix->bufBytesUsed);
+  ctx.bufBytesUsed = prefix->bufBytesUsed;
+  ctx.roundState = prefix->state;
+  ctx.firstRound = prefix->numRounds;
+  sha2processBytes(&ctx, inData, dataLen);
+  sha2finish(&ctx, outHash, hashLen);
+}
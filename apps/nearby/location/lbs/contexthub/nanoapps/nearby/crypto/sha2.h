@@ -32,6 +32,10 @@ extern "C" {
  *
  * External a single API:
  *  - sha256() for performing the separated three APIs at a time
+ *
+ * External APIs for hashing several messages sharing a prefix:
+ *  - sha2prefixInit() for precomputing the state of the prefix
+ *  - sha256WithPrefix() for hashing the prefix followed by input data
  */
 
 #include <stddef.h>
@@ -51,6 +55,24 @@ struct Sha2Context {
     uint8_t b[SHA2_BLOCK_SIZE];
   };
   uint8_t bufBytesUsed;
+  // Working variables of the next block after its first firstRound rounds,
+  // when they were precomputed by sha2prefixInit().
+  const uint32_t *roundState;
+  uint8_t firstRound;
+};
+
+/**
+ * State of a message prefix, as computed by sha2prefixInit(). The blocks fully
+ * covered by the prefix are compressed, and so are the rounds of the following
+ * block that only depend on the complete words of the prefix.
+ */
+struct Sha2Prefix {
+  uint32_t h[SHA2_HASH_WORDS];
+  uint32_t state[SHA2_HASH_WORDS];
+  size_t msgLen;
+  uint8_t b[SHA2_BLOCK_SIZE];
+  uint8_t bufBytesUsed;
+  uint8_t numRounds;
 };
 
 /**
@@ -105,6 +127,35 @@ void sha2processBytes(struct Sha2Context *ctx, const void *inData,
  * Returns:
  */
 void sha2finish(struct Sha2Context *ctx, void *outHash, uint32_t hashLen);
+
+/**
+ * sha2prefixInit:
+ * @prefix: prefix state to initialize
+ * @inData: prefix byte array
+ * @dataLen: number of bytes of the prefix byte array
+ *
+ * Precomputes the SHA256 state of a message prefix
+ *
+ * Returns:
+ */
+void sha2prefixInit(struct Sha2Prefix *prefix, const void *inData,
+                    size_t dataLen);
+
+/**
+ * sha256WithPrefix:
+ * @prefix: prefix state initialized
+ * @inData: input data byte array to hash after the prefix
+ * @dataLen: number of bytes of the input byte array
+ * @outHash: output hash byte array
+ * @hashLen: number of bytes of the output byte array
+ *
+ * Generates the same hash as sha256() over the concatenation of the prefix
+ * and the input data, without hashing the prefix again
+ *
+ * Returns:
+ */
+void sha256WithPrefix(const struct Sha2Prefix *prefix, const void *inData,
+                      uint32_t dataLen, void *outHash, uint32_t hashLen);
 #ifdef __cplusplus
 }
 #endif
@@ -30,13 +30,15 @@ namespace nearby {
 constexpr uint16_t kFastPairUuid = 0xFE2C;
 constexpr uint16_t kFastPairUuidFirstByte = 0xFE;
 constexpr uint16_t kFastPairUuidSecondByte = 0x2C;
-constexpr size_t kFpAccountKeyLength = 16;
+constexpr size_t kFpAccountKeyLength = FastPairAccountKeys::kAccountKeyLength;
 constexpr size_t kFastPairModelIdLength = 3;
 constexpr uint8_t kAccountKeyFirstByte[] = {
     0b00000100,  // Default.
     0b00000101,  // Recent.
     0b00000110   // In use.
 };
+static_assert(std::size(kAccountKeyFirstByte) + 1 ==
+              FastPairAccountKeys::kNumKeyVariants);
 // The key fed into Bloom Filter is the concatenation of account key, SALT, and
 // RRD, and the max length is kFpAccountKeyLength + 3 x 2^4. SALT,Battery, or
 // RRD length is less than 2^4 according to the spec.
@@ -51,11 +53,8 @@ bool IsAccountDataElement(const nearby_DataElement &data_element) {
           data_element.value_length == kFpAccountKeyLength);
 }
 
-// Returns true if filter include Fast Pair initial pair.
-// Otherwise, returns false and saves account keys in account_keys.
-bool CheckFastPairFilter(const nearby_BleFilter &filter,
-                         chre::DynamicVector<const uint8_t *> *account_keys) {
-  bool has_initial_pair = false;
+bool FastPairAccountKeys::Update(const nearby_BleFilter &filter) {
+  Clear();
   for (int i = 0; i < filter.data_element_count; i++) {
     if (IsAccountDataElement(filter.data_element[i])) {
       uint8_t account_value = 0;
@@ -65,14 +64,34 @@ bool CheckFastPairFilter(const nearby_BleFilter &filter,
       if (account_value == 0) {
         // Account value for initial pair are all zeros.
         LOGD("Find Fast Pair initial pair filter.");
-        has_initial_pair = true;
+        has_initial_pair_ = true;
       } else {
-        account_keys->push_back(
-            static_cast<const uint8_t *>(filter.data_element[i].value));
+        if (!keys_.emplace_back()) {
+          LOGE("Failed to allocate Fast Pair account key.");
+          Clear();
+          return false;
+        }
+        AccountKey &account_key = keys_.back();
+        memcpy(account_key.value, filter.data_element[i].value,
+               kFpAccountKeyLength);
+        sha2prefixInit(&account_key.prefixes[0], account_key.value,
+                       kFpAccountKeyLength);
+        uint8_t key[kFpAccountKeyLength];
+        memcpy(key, account_key.value, kFpAccountKeyLength);
+        for (size_t j = 0; j < std::size(kAccountKeyFirstByte); j++) {
+          key[0] = kAccountKeyFirstByte[j];
+          sha2prefixInit(&account_key.prefixes[j + 1], key,
+                         kFpAccountKeyLength);
+        }
       }
     }
   }
-  return has_initial_pair;
+  return true;
+}
+
+void FastPairAccountKeys::Clear() {
+  keys_.clear();
+  has_initial_pair_ = false;
 }
 
 // Fills a Fast Pair filtered result with service_data and account_key.
@@ -145,7 +164,7 @@ bool MatchInitialFastPair(const BleServiceData &ble_service_data,
   return FillResult(ble_service_data, nullptr, result);
 }
 
-bool MatchSubsequentPair(const uint8_t *account_key,
+bool MatchSubsequentPair(const FastPairAccountKeys &account_keys,
                          const BleServiceData &service_data,
                          nearby_BleFilterResult *result) {
   LOGD("MatchSubsequentPair");
@@ -181,23 +200,26 @@ bool MatchSubsequentPair(const uint8_t *account_key,
   CHRE_ASSERT((kFpAccountKeyLength + account_data.salt.length +
                account_data.battery.length + account_data.rrd.length) <=
               kMaxBloomFilterKeyLength);
-  uint8_t key[kMaxBloomFilterKeyLength];
+  // The hash state of the account key, which comes first, is precomputed, so
+  // only the rest of the key is built and hashed here.
+  uint8_t key[kMaxBloomFilterKeyLength - kFpAccountKeyLength];
   size_t pos = 0;
-  memcpy(&key[pos], account_key, kFpAccountKeyLength);
-  pos += kFpAccountKeyLength;
   memcpy(&key[pos], account_data.salt.data, account_data.salt.length);
   pos += account_data.salt.length;
   LOGD_SENSITIVE_INFO("Fast Pair subsequent pair SALT");
   for (size_t i = 0; i < account_data.salt.length; i++) {
     LOGD_SENSITIVE_INFO("%x", account_data.salt.data[i]);
   }
-  memcpy(&key[pos], account_data.battery.data, account_data.battery.length);
-  pos += account_data.battery.length;
+  // Battery and RRD are optional, in which case their data is null.
+  if (account_data.battery.length > 0) {
+    memcpy(&key[pos], account_data.battery.data, account_data.battery.length);
+    pos += account_data.battery.length;
+  }
   LOGD_SENSITIVE_INFO("Fast Pair subsequent pair battery:");
   for (size_t i = 0; i < account_data.battery.length; i++) {
     LOGD_SENSITIVE_INFO("%x", account_data.battery.data[i]);
   }
-  if (account_data.version == 1) {
+  if (account_data.version == 1 && account_data.rrd.length > 0) {
     memcpy(&key[pos], account_data.rrd.data, account_data.rrd.length);
     pos += account_data.rrd.length;
     LOGD_SENSITIVE_INFO("Fast Pair subsequent pair RRD");
@@ -206,45 +228,39 @@ bool MatchSubsequentPair(const uint8_t *account_key,
     }
   }
 
-  LOGD_SENSITIVE_INFO("Fast Pair subsequent pair combined key:");
-  for (size_t i = 0; i < pos; i++) {
-    LOGD_SENSITIVE_INFO("%x", key[i]);
-  }
-  bool matched = bloom_filter.MayContain(key, pos);
-  if (!matched && account_data.rrd.length > 0) {
-    // Flip the first byte to 4, 5, 6 when RRD is presented.
-    for (uint8_t firstByte : kAccountKeyFirstByte) {
-      key[0] = firstByte;
-      matched = bloom_filter.MayContain(key, pos);
-      if (matched) break;
+  for (const auto &account_key : account_keys.keys()) {
+    bool matched =
+        bloom_filter.MayContain(account_key.prefixes[0], key, pos);
+    if (!matched && account_data.rrd.length > 0) {
+      // Flip the first byte to 4, 5, 6 when RRD is presented.
+      for (size_t i = 1; i < FastPairAccountKeys::kNumKeyVariants; i++) {
+        matched = bloom_filter.MayContain(account_key.prefixes[i], key, pos);
+        if (matched) break;
+      }
+    }
+    if (matched) {
+      LOGD("Subsequent Pair match succeeds.");
+      return FillResult(service_data, account_key.value, result);
     }
   }
-  if (matched) {
-    LOGD("Subsequent Pair match succeeds.");
-    return FillResult(service_data, account_key, result);
-  } else {
-    return false;
-  }
+  return false;
 }
 
-bool MatchFastPair(const nearby_BleFilter &filter,
+bool MatchFastPair(const FastPairAccountKeys &account_keys,
                    const BleScanRecord &scan_record,
                    nearby_BleFilterResult *result) {
   LOGD("MatchFastPair");
-  chre::DynamicVector<const uint8_t *> account_keys;
-  if (CheckFastPairFilter(filter, &account_keys)) {
+  if (account_keys.has_initial_pair()) {
     LOGD("Fast Pair initial pair filter found.");
     for (const auto &ble_service_data : scan_record.service_data) {
       if (MatchInitialFastPair(ble_service_data, result)) {
         return true;
       }
     }
-  } else {
-    for (const auto account_key : account_keys) {
-      for (const auto &ble_service_data : scan_record.service_data) {
-        if (MatchSubsequentPair(account_key, ble_service_data, result)) {
-          return true;
-        }
+  } else if (!account_keys.keys().empty()) {
+    for (const auto &ble_service_data : scan_record.service_data) {
+      if (MatchSubsequentPair(account_keys, ble_service_data, result)) {
+        return true;
       }
     }
   }
@@ -17,12 +17,55 @@
 #ifndef LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_FAST_PAIR_FILTER_H_
 #define LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_FAST_PAIR_FILTER_H_
 
+#include <cstddef>
+#include <cstdint>
+
 #include "location/lbs/contexthub/nanoapps/nearby/ble_scan_record.h"
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/sha2.h"
 #include "location/lbs/contexthub/nanoapps/nearby/proto/ble_filter.nanopb.h"
+#include "third_party/contexthub/chre/util/include/chre/util/dynamic_vector.h"
 
 namespace nearby {
 
-bool MatchFastPair(const nearby_BleFilter &filter,
+// Fast Pair account keys of a BLE filter. The SHA256 state of each account key
+// is precomputed when the filter is updated, so that matching an advertisement
+// against the Bloom filter only hashes the SALT, battery and RRD that follow
+// the account key.
+class FastPairAccountKeys {
+ public:
+  static constexpr size_t kAccountKeyLength = 16;
+  // The account key as is, and with its first byte replaced by each of the
+  // values used when RRD is presented.
+  static constexpr size_t kNumKeyVariants = 4;
+
+  struct AccountKey {
+    uint8_t value[kAccountKeyLength];
+    Sha2Prefix prefixes[kNumKeyVariants];
+  };
+
+  // Extracts the account keys of filter and precomputes their hash state.
+  // Returns false if memory allocation failed.
+  bool Update(const nearby_BleFilter &filter);
+
+  // Removes all the account keys.
+  void Clear();
+
+  // Returns true if the filter includes Fast Pair initial pair, in which case
+  // account keys are ignored.
+  bool has_initial_pair() const {
+    return has_initial_pair_;
+  }
+
+  const chre::DynamicVector<AccountKey> &keys() const {
+    return keys_;
+  }
+
+ private:
+  chre::DynamicVector<AccountKey> keys_;
+  bool has_initial_pair_ = false;
+};
+
+bool MatchFastPair(const FastPairAccountKeys &account_keys,
                    const BleScanRecord &scan_record,
                    nearby_BleFilterResult *result);
 
@@ -27,7 +27,6 @@
 #include "location/lbs/contexthub/nanoapps/nearby/ble_scan_record.h"
 #include "location/lbs/contexthub/nanoapps/nearby/fast_pair_filter.h"
 #ifdef ENABLE_PRESENCE
-#include "location/lbs/contexthub/nanoapps/nearby/presence_crypto_mic.h"
 #include "location/lbs/contexthub/nanoapps/nearby/presence_filter.h"
 #endif
 #include "third_party/contexthub/chre/util/include/chre/util/nanoapp/log.h"
@@ -41,6 +40,12 @@ constexpr nearby_BleFilters kDefaultBleFilters = nearby_BleFilters_init_zero;
 bool Filter::Update(const uint8_t *message, uint32_t message_size) {
   LOGD("Decode a Filters message with size %" PRIu32, message_size);
   ble_filters_ = kDefaultBleFilters;
+  for (auto &keys : fast_pair_keys_) {
+    keys.Clear();
+  }
+#ifdef ENABLE_PRESENCE
+  presence_crypto_.ClearCache();
+#endif
   pb_istream_t stream = pb_istream_from_buffer(message, message_size);
   if (!pb_decode(&stream, nearby_BleFilters_fields, &ble_filters_)) {
     LOGE("Failed to decode a Filters message.");
@@ -71,6 +76,9 @@ bool Filter::Update(const uint8_t *message, uint32_t message_size) {
     if (filter->has_latency_ms && filter->latency_ms < scan_interval_ms_) {
       scan_interval_ms_ = filter->latency_ms;
     }
+    if (!fast_pair_keys_[i].Update(*filter)) {
+      return false;
+    }
   }
   return true;
 }
@@ -116,7 +124,7 @@ void Filter::MatchBle(
     result.timestamp_ns =
         report.timestamp +
         static_cast<uint64_t>(chreGetEstimatedHostTimeOffset());
-    if (MatchFastPair(ble_filters_.filter[filter_index], record, &result)) {
+    if (MatchFastPair(fast_pair_keys_[filter_index], record, &result)) {
       LOGD("Add a matched Fast Pair filter result");
       fp_filter_results->push_back(result);
       return;
@@ -124,7 +132,7 @@ void Filter::MatchBle(
 #ifdef ENABLE_PRESENCE
     if (MatchPresenceV0(ble_filters_.filter[filter_index], record, &result) ||
         MatchPresenceV1(ble_filters_.filter[filter_index], record,
-                        PresenceCryptoMicImpl(), &result)) {
+                        presence_crypto_, &result)) {
       LOGD("Filter result TX power %" PRId32 ", RSSI %" PRId32, result.tx_power,
            result.rssi);
 
@@ -17,6 +17,10 @@
 #ifndef LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_FILTER_H_
 #define LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_FILTER_H_
 
+#include "location/lbs/contexthub/nanoapps/nearby/fast_pair_filter.h"
+#ifdef ENABLE_PRESENCE
+#include "location/lbs/contexthub/nanoapps/nearby/presence_crypto_mic.h"
+#endif
 #include "location/lbs/contexthub/nanoapps/nearby/proto/ble_filter.nanopb.h"
 #include "third_party/contexthub/chre/util/include/chre/util/dynamic_vector.h"
 
@@ -45,7 +49,16 @@ class Filter {
                 chre::DynamicVector<nearby_BleFilterResult> *fp_filter_results);
 
  private:
+  static constexpr size_t kMaxNumFilters =
+      sizeof(nearby_BleFilters::filter) / sizeof(nearby_BleFilter);
+
   nearby_BleFilters ble_filters_ = nearby_BleFilters_init_zero;
+  // Fast Pair account keys of each filter in ble_filters_.
+  FastPairAccountKeys fast_pair_keys_[kMaxNumFilters];
+#ifdef ENABLE_PRESENCE
+  // Caches the keys derived from the credentials of ble_filters_.
+  PresenceCryptoMicImpl presence_crypto_;
+#endif
   // BLE Scan interval. Default to 1 minute.
   uint64_t scan_interval_ms_ = 60 * 1000;
 };
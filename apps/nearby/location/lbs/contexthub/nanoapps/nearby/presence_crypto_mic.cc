@@ -30,6 +30,55 @@
 #define STR_LEN_NO_TERM(str) (ARRAY_SIZE(str) - 1)
 #define LOG_TAG "[NEARBY][PRESENCE_CRYPTO_V1]"
 namespace nearby {
+PresenceCryptoMicImpl::PresenceCryptoMicImpl() {
+  hmacKeyInit(&hkdf_salt_key_, kHkdfSalt, STR_LEN_NO_TERM(kHkdfSalt));
+}
+
+void PresenceCryptoMicImpl::ClearCache() {
+  key_cache_.Clear();
+  last_salt_length_ = 0;
+}
+
+const PresenceKeyCache::DerivedKeys *PresenceCryptoMicImpl::GetDerivedKeys(
+    const ByteArray &authenticity_key) const {
+  const PresenceKeyCache::DerivedKeys *cached_keys =
+      key_cache_.Find(authenticity_key);
+  if (cached_keys != nullptr) {
+    return cached_keys;
+  }
+  PresenceKeyCache::DerivedKeys keys;
+
+  // Generate a 16 bytes decryption key from authenticity_key
+  uint8_t decryption_key[kAesKeySize] = {0};
+  hkdfWithSaltKey(&hkdf_salt_key_, authenticity_key.data,
+                  authenticity_key.length,
+                  reinterpret_cast<const uint8_t *>(kAesKeyInfo),
+                  STR_LEN_NO_TERM(kAesKeyInfo), decryption_key,
+                  ARRAY_SIZE(decryption_key));
+  // Expand the AES key schedule, the IV is set for each decryption
+  struct AesCtrContext ctx;
+  uint8_t iv[AES_BLOCK_SIZE] = {0};
+  if (aesCtrInit(&ctx, decryption_key, iv, AES_128_KEY_TYPE) < 0) {
+    LOGE("aesCtrInit() is failed");
+    return nullptr;
+  }
+  keys.aes = ctx.aes;
+
+  // Generate a 32 bytes HMAC key from authenticity_key
+  uint8_t hmac_key[kHmacKeySize] = {0};
+  hkdfWithSaltKey(&hkdf_salt_key_, authenticity_key.data,
+                  authenticity_key.length, kMetadataKeyHmacKeyInfo,
+                  STR_LEN_NO_TERM(kMetadataKeyHmacKeyInfo), hmac_key,
+                  ARRAY_SIZE(hmac_key));
+  hmacKeyInit(&keys.hmac, hmac_key, ARRAY_SIZE(hmac_key));
+
+  cached_keys = key_cache_.Insert(authenticity_key, keys);
+  if (cached_keys == nullptr) {
+    LOGE("Invalid authenticity key size");
+  }
+  return cached_keys;
+}
+
 bool PresenceCryptoMicImpl::decrypt(const ByteArray &input,
                                     const ByteArray &salt, const ByteArray &key,
                                     ByteArray &output) const {
@@ -42,26 +91,26 @@ bool PresenceCryptoMicImpl::decrypt(const ByteArray &input,
     return false;
   }
 
-  // Generate a 32 bytes decryption key from authenticity_key
-  uint8_t decryption_key[kAesKeySize] = {0};
-  hkdf(reinterpret_cast<const uint8_t *>(kHkdfSalt), STR_LEN_NO_TERM(kHkdfSalt),
-       key.data, key.length, reinterpret_cast<const uint8_t *>(kAesKeyInfo),
-       STR_LEN_NO_TERM(kAesKeyInfo), decryption_key,
-       ARRAY_SIZE(decryption_key));
+  const PresenceKeyCache::DerivedKeys *keys = GetDerivedKeys(key);
+  if (keys == nullptr) {
+    return false;
+  }
 
-  // Generate nonce
-  uint8_t nonce[kAdvNonceSizeSaltDe] = {0};
-  hkdf(reinterpret_cast<const uint8_t *>(kHkdfSalt), STR_LEN_NO_TERM(kHkdfSalt),
-       salt.data, salt.length,
-       reinterpret_cast<const uint8_t *>(kAdvNonceInfoSaltDe),
-       STR_LEN_NO_TERM(kAdvNonceInfoSaltDe), nonce, ARRAY_SIZE(nonce));
+  // Generate nonce, unless it was generated for the same salt
+  if (salt.length != last_salt_length_ ||
+      memcmp(salt.data, last_salt_, salt.length) != 0) {
+    hkdfWithSaltKey(&hkdf_salt_key_, salt.data, salt.length,
+                    reinterpret_cast<const uint8_t *>(kAdvNonceInfoSaltDe),
+                    STR_LEN_NO_TERM(kAdvNonceInfoSaltDe), last_nonce_,
+                    ARRAY_SIZE(last_nonce_));
+    memcpy(last_salt_, salt.data, salt.length);
+    last_salt_length_ = salt.length;
+  }
 
-  // Decrypt the input cipher text using the decryption key
+  // Decrypt the input cipher text using the cached decryption key schedule
   struct AesCtrContext ctx;
-  if (aesCtrInit(&ctx, decryption_key, nonce, AES_128_KEY_TYPE) < 0) {
-    LOGE("aesCtrInit() is failed");
-    return false;
-  }
+  ctx.aes = keys->aes;
+  memcpy(ctx.iv, last_nonce_, sizeof(ctx.iv));
   aesCtr(&ctx, input.data, output.data, output.length);
   return true;
 }
@@ -71,7 +120,6 @@ bool PresenceCryptoMicImpl::decrypt(const ByteArray &input,
 bool PresenceCryptoMicImpl::verify(const ByteArray &metadataKey,
                                    const ByteArray &authenticityKey,
                                    const ByteArray &tag) const {
-  UNUSED_VAR(authenticityKey);
   if (metadataKey.data == nullptr || tag.data == nullptr) {
     LOGE("Null pointer was found in input parameter");
     return false;
@@ -80,16 +128,14 @@ bool PresenceCryptoMicImpl::verify(const ByteArray &metadataKey,
     LOGE("Invalid signature size");
     return false;
   }
+  const PresenceKeyCache::DerivedKeys *keys = GetDerivedKeys(authenticityKey);
+  if (keys == nullptr) {
+    return false;
+  }
   // Generates a 32 bytes HMAC tag from the data
-  uint8_t hmac_key[kHmacKeySize] = {0};
-  hkdf(reinterpret_cast<const uint8_t *>(kHkdfSalt), STR_LEN_NO_TERM(kHkdfSalt),
-       authenticityKey.data, authenticityKey.length, kMetadataKeyHmacKeyInfo,
-       STR_LEN_NO_TERM(kMetadataKeyHmacKeyInfo), hmac_key,
-       ARRAY_SIZE(hmac_key));
-
   uint8_t hmac_tag[SHA2_HASH_SIZE];
-  hmacSha256(hmac_key, ARRAY_SIZE(hmac_key), metadataKey.data,
-             metadataKey.length, hmac_tag, sizeof(hmac_tag));
+  hmacSha256WithKey(&keys->hmac, metadataKey.data, metadataKey.length,
+                    hmac_tag, sizeof(hmac_tag));
 
   // Verifies the generated HMAC tag matching the signature
   volatile uint8_t diff = 0;
@@ -16,13 +16,19 @@
 #ifndef LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_PRESENCE_CRYPTO_MIC_H_
 #define LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_PRESENCE_CRYPTO_MIC_H_
 #include "location/lbs/contexthub/nanoapps/nearby/crypto.h"
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/hmac.h"
+#include "location/lbs/contexthub/nanoapps/nearby/presence_key_cache.h"
 
 namespace nearby {
 static constexpr size_t kSaltSize = 2;
 // Implements Crypto interface using MIC authentication type for Presence v1
 // specification. Crypto algorithms: AES/CTR, HMAC, HKDF, SHA256.
+// The keys derived from the authenticity keys are cached across calls, see
+// ClearCache().
 class PresenceCryptoMicImpl : public Crypto {
  public:
+  PresenceCryptoMicImpl();
+
   // Decrypts input with salt and key. Places the decrypted result in output.
   bool decrypt(const ByteArray &input, const ByteArray &salt,
                const ByteArray &key, ByteArray &output) const override;
@@ -31,6 +37,8 @@ class PresenceCryptoMicImpl : public Crypto {
   // at the end of the advertisement.
   bool verify(const ByteArray &input, const ByteArray &key,
               const ByteArray &signature) const override;
+  // Drops the cached keys. Must be called when the credentials change.
+  void ClearCache();
 
  private:
   static constexpr char kAesKeyInfo[] = "Unsigned Section AES key";
@@ -44,6 +52,21 @@ class PresenceCryptoMicImpl : public Crypto {
   // are merged.
   static constexpr char kMetadataKeyHmacKeyInfo[] =
       "Unsigned Section metadata key HMAC key";
+  static constexpr size_t kMaxSaltSize = kEncryptionInfoSize - 1;
+
+  // Returns the keys derived from the authenticity key, deriving and caching
+  // them if needed. Returns nullptr if the keys cannot be derived.
+  const PresenceKeyCache::DerivedKeys *GetDerivedKeys(
+      const ByteArray &authenticity_key) const;
+
+  // HMAC state of kHkdfSalt, shared by all the key derivations.
+  HmacKey hkdf_salt_key_;
+  mutable PresenceKeyCache key_cache_;
+  // The nonce derived from the last salt. An advertisement is decrypted with
+  // each credential in turn, so consecutive calls usually share the salt.
+  mutable uint8_t last_salt_[kMaxSaltSize];
+  mutable size_t last_salt_length_ = 0;
+  mutable uint8_t last_nonce_[kAdvNonceSizeSaltDe];
 };
 }  // namespace nearby
 #endif  // LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_PRESENCE_CRYPTO_MIC_H_
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/presence_key_cache.h"
+
+#include <cstring>
+
+namespace nearby {
+
+const PresenceKeyCache::DerivedKeys *PresenceKeyCache::Find(
+    const ByteArray &authenticity_key) {
+  for (auto &entry : entries_) {
+    if (entry.last_use != 0 && entry.key_length == authenticity_key.length &&
+        memcmp(entry.key, authenticity_key.data, entry.key_length) == 0) {
+      entry.last_use = ++use_count_;
+      return &entry.keys;
+    }
+  }
+  return nullptr;
+}
+
+const PresenceKeyCache::DerivedKeys *PresenceKeyCache::Insert(
+    const ByteArray &authenticity_key, const DerivedKeys &keys) {
+  if (authenticity_key.length > kMaxAuthenticityKeySize) {
+    return nullptr;
+  }
+  // Empty entries have the lowest last_use, so they are picked first.
+  Entry *victim = &entries_[0];
+  for (auto &entry : entries_) {
+    if (entry.last_use < victim->last_use) {
+      victim = &entry;
+    }
+  }
+  memcpy(victim->key, authenticity_key.data, authenticity_key.length);
+  victim->key_length = authenticity_key.length;
+  victim->last_use = ++use_count_;
+  victim->keys = keys;
+  return &victim->keys;
+}
+
+void PresenceKeyCache::Clear() {
+  for (auto &entry : entries_) {
+    // Wipes the derived keys, which are as sensitive as the credentials.
+    memset(&entry, 0, sizeof(entry));
+  }
+  use_count_ = 0;
+}
+
+}  // namespace nearby
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_PRESENCE_KEY_CACHE_H_
+#define LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_PRESENCE_KEY_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "location/lbs/contexthub/nanoapps/nearby/byte_array.h"
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/aes.h"
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/hmac.h"
+
+// Number of credentials whose derived keys are cached. Each entry takes about
+// 600 bytes. Can be overridden to trade memory for decoding time.
+#ifndef NEARBY_PRESENCE_KEY_CACHE_SIZE
+#define NEARBY_PRESENCE_KEY_CACHE_SIZE 4
+#endif
+
+namespace nearby {
+
+// Caches the keys derived from the authenticity key of Presence credentials,
+// so that decoding an advertisement against a credential only decrypts and
+// authenticates it, without deriving the keys and expanding the AES key
+// schedule again. The least recently used entry is evicted when the cache is
+// full. The cache must be cleared when the credentials are updated.
+class PresenceKeyCache {
+ public:
+  static constexpr size_t kNumEntries = NEARBY_PRESENCE_KEY_CACHE_SIZE;
+  static constexpr size_t kMaxAuthenticityKeySize = 32;
+
+  static_assert(kNumEntries > 0, "NEARBY_PRESENCE_KEY_CACHE_SIZE must be > 0");
+
+  struct DerivedKeys {
+    // Expanded key schedule of the AES key decrypting the advertisement.
+    AesContext aes;
+    // HMAC state of the key authenticating the metadata key.
+    HmacKey hmac;
+  };
+
+  // Returns the keys derived from authenticity_key, or nullptr if they are not
+  // cached.
+  const DerivedKeys *Find(const ByteArray &authenticity_key);
+
+  // Caches the keys derived from authenticity_key, evicting the least recently
+  // used entry if the cache is full. Returns the cached keys, or nullptr if
+  // authenticity_key is larger than kMaxAuthenticityKeySize.
+  const DerivedKeys *Insert(const ByteArray &authenticity_key,
+                            const DerivedKeys &keys);
+
+  // Removes all the entries.
+  void Clear();
+
+ private:
+  struct Entry {
+    uint8_t key[kMaxAuthenticityKeySize];
+    size_t key_length;
+    // Value of use_count_ when the entry was last used, or 0 if the entry is
+    // empty.
+    uint64_t last_use;
+    DerivedKeys keys;
+  };
+
+  Entry entries_[kNumEntries] = {};
+  uint64_t use_count_ = 0;
+};
+
+}  // namespace nearby
+
+#endif  // LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_PRESENCE_KEY_CACHE_H_
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/adv_report_cache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "chre_api/chre.h"
+#include "gtest/gtest.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/benchmark.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/fake_chre_api.h"
+
+namespace nearby {
+namespace {
+
+constexpr size_t kCacheSize = NEARBY_ADV_REPORT_CACHE_SIZE;
+constexpr uint64_t kOneSecondNs = 1000000000;
+
+class AdvReportCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    test::SetFakeTime(0);
+  }
+
+  // Returns a report of the given advertiser, with data_length bytes of data
+  // starting from data_seed. The data is owned by the test fixture.
+  chreBleAdvertisingReport MakeReport(uint32_t advertiser, uint8_t data_seed,
+                                      uint16_t data_length = 8,
+                                      int8_t rssi = -50,
+                                      uint64_t timestamp = 0) {
+    chreBleAdvertisingReport report = {};
+    report.timestamp = timestamp;
+    report.addressType = CHRE_BLE_ADDRESS_TYPE_PUBLIC;
+    memcpy(report.address, &advertiser, sizeof(advertiser));
+    report.rssi = rssi;
+    for (uint16_t i = 0; i < data_length; ++i) {
+      data_[i] = static_cast<uint8_t>(data_seed + i);
+    }
+    report.data = data_;
+    report.dataLength = data_length;
+    return report;
+  }
+
+  // Returns whether the cache holds a report of the advertiser.
+  bool Contains(uint32_t advertiser) {
+    for (const auto &report : cache_.GetAdvReports()) {
+      if (memcmp(report.address, &advertiser, sizeof(advertiser)) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  AdvReportCache cache_;
+  uint8_t data_[255];
+};
+
+TEST_F(AdvReportCacheTest, CopiesReports) {
+  cache_.Push(MakeReport(1, 10));
+  // Overwrites the data passed to Push().
+  MakeReport(2, 20);
+
+  auto &reports = cache_.GetAdvReports();
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_NE(reports[0].data, data_);
+  EXPECT_EQ(reports[0].dataLength, 8);
+  EXPECT_EQ(reports[0].data[0], 10);
+}
+
+TEST_F(AdvReportCacheTest, DeduplicatesByAddressAndData) {
+  cache_.Push(MakeReport(1, 10, 8, -60, 100));
+  cache_.Push(MakeReport(1, 10, 8, -40, 200));
+  cache_.Push(MakeReport(1, 10, 8, -70, 150));
+
+  auto &reports = cache_.GetAdvReports();
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_EQ(reports[0].rssi, -40);
+  EXPECT_EQ(reports[0].timestamp, 200);
+
+  // Same advertiser with other data, and other advertiser with the same data.
+  cache_.Push(MakeReport(1, 11));
+  cache_.Push(MakeReport(2, 10));
+  EXPECT_EQ(cache_.GetAdvReports().size(), 3);
+}
+
+TEST_F(AdvReportCacheTest, HoldsLongPayloads) {
+  cache_.Push(MakeReport(1, 10, 200));
+  cache_.Push(MakeReport(1, 10, 200));
+  cache_.Push(MakeReport(2, 10, 0));
+
+  auto &reports = cache_.GetAdvReports();
+  ASSERT_EQ(reports.size(), 2);
+  EXPECT_EQ(reports[0].dataLength, 200);
+  EXPECT_EQ(reports[0].data[199], static_cast<uint8_t>(10 + 199));
+  EXPECT_EQ(reports[1].dataLength, 0);
+}
+
+TEST_F(AdvReportCacheTest, EvictsLeastRecentlyUpdatedReportWhenFull) {
+  for (uint32_t i = 0; i < kCacheSize; ++i) {
+    cache_.Push(MakeReport(i, 0));
+  }
+  // Updates the oldest report, so that the second one is evicted instead.
+  cache_.Push(MakeReport(0, 0));
+  cache_.Push(MakeReport(kCacheSize, 0));
+
+  EXPECT_EQ(cache_.GetAdvReports().size(), kCacheSize);
+  EXPECT_TRUE(Contains(0));
+  EXPECT_FALSE(Contains(1));
+  EXPECT_TRUE(Contains(2));
+  EXPECT_TRUE(Contains(kCacheSize));
+}
+
+TEST_F(AdvReportCacheTest, RemovesExpiredReportsBeforeEvicting) {
+  cache_.SetCacheTimeout(1000 /* cache_expire_millisec */);
+  // The first half of the reports expires, the second half is still recent.
+  for (uint32_t i = 0; i < kCacheSize; ++i) {
+    uint64_t timestamp = (i < kCacheSize / 2) ? 0 : 2 * kOneSecondNs;
+    cache_.Push(MakeReport(i, 0, 8, -50, timestamp));
+  }
+  test::SetFakeTime(2 * kOneSecondNs);
+  cache_.Push(MakeReport(kCacheSize, 0, 8, -50, 2 * kOneSecondNs));
+
+  EXPECT_EQ(cache_.GetAdvReports().size(), kCacheSize / 2 + 1);
+  EXPECT_FALSE(Contains(0));
+  EXPECT_TRUE(Contains(kCacheSize / 2));
+  EXPECT_TRUE(Contains(kCacheSize));
+}
+
+TEST_F(AdvReportCacheTest, RefreshRemovesExpiredReports) {
+  cache_.SetCacheTimeout(1000 /* cache_expire_millisec */);
+  cache_.Push(MakeReport(1, 0, 8, -50, 0));
+  cache_.Push(MakeReport(2, 0, 8, -50, kOneSecondNs));
+
+  test::SetFakeTime(kOneSecondNs + 1);
+  cache_.Refresh();
+  auto &reports = cache_.GetAdvReports();
+  ASSERT_EQ(reports.size(), 1);
+  EXPECT_TRUE(Contains(2));
+}
+
+TEST_F(AdvReportCacheTest, ClearRemovesAllReports) {
+  for (uint32_t i = 0; i < 10; ++i) {
+    cache_.Push(MakeReport(i, 0, static_cast<uint16_t>(i * 10)));
+  }
+  cache_.Clear();
+  EXPECT_EQ(cache_.GetAdvReports().size(), 0);
+
+  cache_.Push(MakeReport(1, 0));
+  EXPECT_EQ(cache_.GetAdvReports().size(), 1);
+}
+
+TEST_F(AdvReportCacheTest, DISABLED_PushBenchmark) {
+  // Batches alternating between a few advertisers and a dense environment.
+  constexpr uint32_t kNumBatches = 20;
+  for (uint32_t num_advertisers : {40u, 200u, 1000u}) {
+    uint64_t cycles = test::MeasureBestOf(5, [&] {
+      AdvReportCache cache;
+      for (uint32_t batch = 0; batch < kNumBatches; ++batch) {
+        uint32_t count = (batch % 2) ? num_advertisers : 40;
+        for (uint32_t i = 0; i < count; ++i) {
+          cache.Push(MakeReport(i, 0, 24));
+        }
+      }
+    });
+    uint32_t num_pushes = kNumBatches / 2 * (num_advertisers + 40);
+    printf("%u advertisers: %.1f cycles/push\n", num_advertisers,
+           static_cast<double>(cycles) / num_pushes);
+  }
+}
+
+}  // namespace
+}  // namespace nearby
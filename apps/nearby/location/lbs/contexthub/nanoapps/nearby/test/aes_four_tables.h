@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_TEST_AES_FOUR_TABLES_H_
+#define LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_TEST_AES_FOUR_TABLES_H_
+
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/aes.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The AES API built with AES_FOUR_TABLES, see aes_four_tables.c.
+int aesFourTablesInitForEncr(struct AesContext *ctx, const uint32_t *k);
+void aesFourTablesEncr(struct AesContext *ctx, const uint32_t *src,
+                       uint32_t *dst);
+int aesFourTablesCtrInit(struct AesCtrContext *ctx, const void *k,
+                         const void *iv, enum AesKeyType key_type);
+void aesFourTablesCtr(struct AesCtrContext *ctx, const void *src, void *dst,
+                      size_t data_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_TEST_AES_FOUR_TABLES_H_
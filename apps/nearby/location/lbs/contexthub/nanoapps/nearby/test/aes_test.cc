@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/aes.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/aes_four_tables.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/benchmark.h"
+
+namespace nearby {
+namespace {
+
+// FIPS-197 appendix C plaintext, and the ciphertexts under the keys made of
+// consecutive bytes from 0.
+constexpr uint8_t kPlaintext[AES_BLOCK_SIZE] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+constexpr uint8_t kAes128Ciphertext[AES_BLOCK_SIZE] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+    0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+constexpr uint8_t kAes256Ciphertext[AES_BLOCK_SIZE] = {
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+    0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89};
+
+using CtrInit = int (*)(struct AesCtrContext *, const void *, const void *,
+                        enum AesKeyType);
+using Ctr = void (*)(struct AesCtrContext *, const void *, void *, size_t);
+
+struct AesImpl {
+  const char *name;
+  CtrInit ctr_init;
+  Ctr ctr;
+};
+
+constexpr AesImpl kImpls[] = {
+    {"one table", aesCtrInit, aesCtr},
+    {"four tables", aesFourTablesCtrInit, aesFourTablesCtr},
+};
+
+// Encrypts a single block by running AES-CTR over zeros from the block.
+void EncryptBlock(const AesImpl &impl, const uint32_t *key,
+                  enum AesKeyType key_type, uint8_t *out) {
+  AesCtrContext ctx;
+  uint8_t zeros[AES_BLOCK_SIZE] = {};
+  ASSERT_EQ(impl.ctr_init(&ctx, key, kPlaintext, key_type), 0);
+  impl.ctr(&ctx, zeros, out, AES_BLOCK_SIZE);
+}
+
+void MakeSequentialKey(uint32_t *key, size_t num_words) {
+  auto bytes = reinterpret_cast<uint8_t *>(key);
+  for (size_t i = 0; i < num_words * sizeof(uint32_t); ++i) {
+    bytes[i] = static_cast<uint8_t>(i);
+  }
+}
+
+TEST(AesTest, MatchesFips197Vectors) {
+  for (const AesImpl &impl : kImpls) {
+    SCOPED_TRACE(impl.name);
+    uint32_t key[AES_256_KEY_WORDS];
+    uint8_t out[AES_BLOCK_SIZE];
+
+    MakeSequentialKey(key, AES_128_KEY_WORDS);
+    EncryptBlock(impl, key, AES_128_KEY_TYPE, out);
+    EXPECT_EQ(memcmp(out, kAes128Ciphertext, AES_BLOCK_SIZE), 0);
+
+    MakeSequentialKey(key, AES_256_KEY_WORDS);
+    EncryptBlock(impl, key, AES_256_KEY_TYPE, out);
+    EXPECT_EQ(memcmp(out, kAes256Ciphertext, AES_BLOCK_SIZE), 0);
+  }
+}
+
+TEST(AesTest, FourTablesMatchOneTable) {
+  std::mt19937 random(0);
+  std::uniform_int_distribution<uint32_t> word;
+  std::uniform_int_distribution<size_t> length(0, 100);
+
+  for (int i = 0; i < 1000; ++i) {
+    enum AesKeyType key_type = (i % 2) ? AES_256_KEY_TYPE : AES_128_KEY_TYPE;
+    uint32_t key[AES_256_KEY_WORDS];
+    uint32_t iv[AES_BLOCK_WORDS];
+    for (uint32_t &w : key) w = word(random);
+    for (uint32_t &w : iv) w = word(random);
+
+    // Covers partial blocks and unaligned buffers.
+    size_t data_len = length(random);
+    size_t offset = i % sizeof(uint32_t);
+    std::vector<uint8_t> src(data_len + offset);
+    for (uint8_t &b : src) b = static_cast<uint8_t>(word(random));
+    std::vector<uint8_t> expected(data_len + offset);
+    std::vector<uint8_t> actual(data_len + offset);
+
+    AesCtrContext ctx;
+    ASSERT_EQ(aesCtrInit(&ctx, key, iv, key_type), 0);
+    aesCtr(&ctx, src.data() + offset, expected.data() + offset, data_len);
+    ASSERT_EQ(aesFourTablesCtrInit(&ctx, key, iv, key_type), 0);
+    aesFourTablesCtr(&ctx, src.data() + offset, actual.data() + offset,
+                     data_len);
+    ASSERT_EQ(expected, actual) << "iteration " << i;
+  }
+}
+
+TEST(AesTest, DISABLED_CtrBenchmark) {
+  constexpr size_t kDataLen = 4096;
+  static uint8_t data[kDataLen];
+  uint32_t key[AES_256_KEY_WORDS] = {};
+  uint32_t iv[AES_BLOCK_WORDS] = {};
+
+  for (const AesImpl &impl : kImpls) {
+    for (enum AesKeyType key_type : {AES_128_KEY_TYPE, AES_256_KEY_TYPE}) {
+      AesCtrContext ctx;
+      ASSERT_EQ(impl.ctr_init(&ctx, key, iv, key_type), 0);
+      uint64_t cycles = test::MeasureBestOf(
+          200, [&] { impl.ctr(&ctx, data, data, kDataLen); });
+      printf("AES-%d CTR, %s: %.2f cycles/byte\n",
+             key_type == AES_128_KEY_TYPE ? 128 : 256, impl.name,
+             static_cast<double>(cycles) / kDataLen);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace nearby
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_TEST_BENCHMARK_H_
+#define LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_TEST_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Helpers of the benchmarks, which are disabled by default and can be run with
+// --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*.
+
+namespace nearby {
+namespace test {
+
+// Returns the CPU cycle counter on x86, or nanoseconds elsewhere.
+inline uint64_t ReadCycleCounter() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#endif
+}
+
+// Returns the fewest cycles (or nanoseconds, see ReadCycleCounter()) taken by
+// a run of function over num_runs runs.
+template <typename Function>
+uint64_t MeasureBestOf(int num_runs, Function function) {
+  uint64_t best = UINT64_MAX;
+  for (int i = 0; i < num_runs; ++i) {
+    uint64_t start = ReadCycleCounter();
+    function();
+    uint64_t elapsed = ReadCycleCounter() - start;
+    if (elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+}  // namespace test
+}  // namespace nearby
+
+#endif  // LOCATION_LBS_CONTEXTHUB_NANOAPPS_NEARBY_TEST_BENCHMARK_H_
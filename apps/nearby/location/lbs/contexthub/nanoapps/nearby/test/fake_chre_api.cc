@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Implements the CHRE API functions used by the code under test, so that it
+// runs on the host without the CHRE framework.
+
+#include "location/lbs/contexthub/nanoapps/nearby/test/fake_chre_api.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+#include "chre_api/chre.h"
+
+namespace {
+
+uint64_t gFakeTimeNs = 0;
+
+}  // namespace
+
+namespace nearby {
+namespace test {
+
+void SetFakeTime(uint64_t time_ns) {
+  gFakeTimeNs = time_ns;
+}
+
+}  // namespace test
+}  // namespace nearby
+
+uint64_t chreGetTime() {
+  return gFakeTimeNs;
+}
+
+void *chreHeapAlloc(uint32_t bytes) {
+  return malloc(bytes);
+}
+
+void chreHeapFree(void *ptr) {
+  free(ptr);
+}
+
+void chreAbort(uint32_t /* abortCode */) {
+  abort();
+}
+
+void chreLog(enum chreLogLevel /* level */, const char *formatStr, ...) {
+  va_list args;
+  va_start(args, formatStr);
+  vprintf(formatStr, args);
+  printf("\n");
+  va_end(args);
+}
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/fast_pair_filter.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/benchmark.h"
+
+namespace nearby {
+namespace {
+
+constexpr size_t kKeyLength = FastPairAccountKeys::kAccountKeyLength;
+constexpr uint16_t kFastPairUuid = 0xFE2C;
+constexpr size_t kBloomFilterLength = 8;
+constexpr uint8_t kSalt[] = {0x11, 0x22};
+constexpr uint8_t kRrd[] = {0x01, 0x02, 0x03};
+// The first byte of an account key advertised as recently used with RRD.
+constexpr uint8_t kRecentKeyFirstByte = 0b00000101;
+
+// Returns an account key of kKeyLength bytes identified by id.
+void MakeAccountKey(uint8_t id, uint8_t key[kKeyLength]) {
+  for (size_t i = 0; i < kKeyLength; ++i) {
+    key[i] = static_cast<uint8_t>(id * 31 + i + 1);
+  }
+}
+
+// Adds a Fast Pair account key entry to filter.
+void AddAccountKey(const uint8_t key[kKeyLength], nearby_BleFilter *filter) {
+  nearby_DataElement &element =
+      filter->data_element[filter->data_element_count++];
+  element.has_key = true;
+  element.key = nearby_DataElement_ElementType_DE_FAST_PAIR_ACCOUNT_KEY;
+  element.has_value = true;
+  memcpy(element.value, key, kKeyLength);
+  element.has_value_length = true;
+  element.value_length = kKeyLength;
+}
+
+// Sets the bits of bloom_filter selected by the SHA256 hash of key, as the
+// Fast Pair provider does when it advertises its account keys.
+void AddToBloomFilter(const uint8_t *key, size_t key_length,
+                      uint8_t bloom_filter[kBloomFilterLength]) {
+  uint32_t hash[SHA2_HASH_WORDS];
+  sha256(key, static_cast<uint32_t>(key_length), hash, sizeof(hash));
+  for (size_t i = 0; i < SHA2_HASH_WORDS; ++i) {
+    uint32_t bit = __builtin_bswap32(hash[i]) % (kBloomFilterLength * 8);
+    bloom_filter[bit / 8] |= 1 << (bit % 8);
+  }
+}
+
+// Fast Pair subsequent pair service data advertising a Bloom filter of
+// account keys.
+class SubsequentPairAdvertisement {
+ public:
+  // Advertises version 1 service data with RRD if with_rrd, or version 0
+  // service data otherwise.
+  explicit SubsequentPairAdvertisement(bool with_rrd = false)
+      : with_rrd_(with_rrd) {}
+
+  // Advertises the account key, with its first byte replaced by first_byte
+  // if it is non-zero.
+  void AddAccountKey(const uint8_t key[kKeyLength], uint8_t first_byte = 0) {
+    uint8_t bloom_key[kKeyLength + sizeof(kSalt) + 1 + sizeof(kRrd)];
+    memcpy(bloom_key, key, kKeyLength);
+    if (first_byte != 0) {
+      bloom_key[0] = first_byte;
+    }
+    size_t length = kKeyLength;
+    memcpy(&bloom_key[length], kSalt, sizeof(kSalt));
+    length += sizeof(kSalt);
+    if (with_rrd_) {
+      bloom_key[length++] = RrdHeader();
+      memcpy(&bloom_key[length], kRrd, sizeof(kRrd));
+      length += sizeof(kRrd);
+    }
+    AddToBloomFilter(bloom_key, length, bloom_filter_);
+  }
+
+  // Returns a scan record including the service data, which must outlive it.
+  BleScanRecord MakeScanRecord() {
+    size_t length = 0;
+    // Version and flags.
+    data_[length++] = with_rrd_ ? 0x10 : 0x00;
+    // Account key filter shown in the UI.
+    data_[length++] = kBloomFilterLength << 4;
+    memcpy(&data_[length], bloom_filter_, kBloomFilterLength);
+    length += kBloomFilterLength;
+    data_[length++] = (sizeof(kSalt) << 4) | 0b0001;
+    memcpy(&data_[length], kSalt, sizeof(kSalt));
+    length += sizeof(kSalt);
+    if (with_rrd_) {
+      data_[length++] = RrdHeader();
+      memcpy(&data_[length], kRrd, sizeof(kRrd));
+      length += sizeof(kRrd);
+    }
+
+    BleScanRecord record;
+    EXPECT_TRUE(record.service_data.push_back(BleServiceData{
+        kFastPairUuid, static_cast<uint8_t>(length), data_}));
+    return record;
+  }
+
+ private:
+  static uint8_t RrdHeader() {
+    return (sizeof(kRrd) << 4) | 0b0110;
+  }
+
+  const bool with_rrd_;
+  uint8_t bloom_filter_[kBloomFilterLength] = {0};
+  uint8_t data_[32];
+};
+
+TEST(FastPairFilterTest, UpdateExtractsAccountKeys) {
+  uint8_t key1[kKeyLength];
+  uint8_t key2[kKeyLength];
+  MakeAccountKey(1, key1);
+  MakeAccountKey(2, key2);
+  nearby_BleFilter filter = nearby_BleFilter_init_zero;
+  AddAccountKey(key1, &filter);
+  // Data elements other than account keys are ignored.
+  nearby_DataElement &status = filter.data_element[filter.data_element_count++];
+  status.has_key = true;
+  status.key = nearby_DataElement_ElementType_DE_CONNECTION_STATUS;
+  AddAccountKey(key2, &filter);
+
+  FastPairAccountKeys account_keys;
+  ASSERT_TRUE(account_keys.Update(filter));
+  EXPECT_FALSE(account_keys.has_initial_pair());
+  ASSERT_EQ(account_keys.keys().size(), 2);
+  EXPECT_EQ(memcmp(account_keys.keys()[0].value, key1, kKeyLength), 0);
+  EXPECT_EQ(memcmp(account_keys.keys()[1].value, key2, kKeyLength), 0);
+
+  // Updating replaces the previous account keys.
+  filter.data_element_count = 1;
+  ASSERT_TRUE(account_keys.Update(filter));
+  EXPECT_EQ(account_keys.keys().size(), 1);
+}
+
+TEST(FastPairFilterTest, UpdateDetectsInitialPair) {
+  uint8_t zero_key[kKeyLength] = {0};
+  nearby_BleFilter filter = nearby_BleFilter_init_zero;
+  AddAccountKey(zero_key, &filter);
+
+  FastPairAccountKeys account_keys;
+  ASSERT_TRUE(account_keys.Update(filter));
+  EXPECT_TRUE(account_keys.has_initial_pair());
+  EXPECT_TRUE(account_keys.keys().empty());
+
+  account_keys.Clear();
+  EXPECT_FALSE(account_keys.has_initial_pair());
+}
+
+TEST(FastPairFilterTest, MatchesInitialPair) {
+  uint8_t zero_key[kKeyLength] = {0};
+  nearby_BleFilter filter = nearby_BleFilter_init_zero;
+  AddAccountKey(zero_key, &filter);
+  FastPairAccountKeys account_keys;
+  ASSERT_TRUE(account_keys.Update(filter));
+
+  const uint8_t model_id[] = {0x01, 0x02, 0x03};
+  BleScanRecord record;
+  ASSERT_TRUE(record.service_data.push_back(
+      BleServiceData{kFastPairUuid, sizeof(model_id), model_id}));
+  nearby_BleFilterResult result = nearby_BleFilterResult_init_zero;
+  ASSERT_TRUE(MatchFastPair(account_keys, record, &result));
+  EXPECT_EQ(result.result_type,
+            nearby_BleFilterResult_ResultType_RESULT_FAST_PAIR);
+  ASSERT_TRUE(result.has_ble_service_data);
+  EXPECT_EQ(result.ble_service_data[0], sizeof(model_id) + 2);
+  EXPECT_EQ(memcmp(&result.ble_service_data[3], model_id, sizeof(model_id)),
+            0);
+  EXPECT_EQ(result.data_element_count, 1);
+}
+
+TEST(FastPairFilterTest, MatchesAdvertisedAccountKey) {
+  uint8_t key1[kKeyLength];
+  uint8_t key2[kKeyLength];
+  MakeAccountKey(1, key1);
+  MakeAccountKey(2, key2);
+  nearby_BleFilter filter = nearby_BleFilter_init_zero;
+  AddAccountKey(key1, &filter);
+  AddAccountKey(key2, &filter);
+  FastPairAccountKeys account_keys;
+  ASSERT_TRUE(account_keys.Update(filter));
+
+  SubsequentPairAdvertisement advertisement;
+  advertisement.AddAccountKey(key2);
+  BleScanRecord record = advertisement.MakeScanRecord();
+  nearby_BleFilterResult result = nearby_BleFilterResult_init_zero;
+  ASSERT_TRUE(MatchFastPair(account_keys, record, &result));
+  EXPECT_EQ(result.result_type,
+            nearby_BleFilterResult_ResultType_RESULT_FAST_PAIR);
+  ASSERT_EQ(result.data_element_count, 1);
+  EXPECT_EQ(result.data_element[0].key,
+            nearby_DataElement_ElementType_DE_FAST_PAIR_ACCOUNT_KEY);
+  EXPECT_EQ(memcmp(result.data_element[0].value, key2, kKeyLength), 0);
+}
+
+TEST(FastPairFilterTest, DoesNotMatchOtherAccountKey) {
+  uint8_t key1[kKeyLength];
+  uint8_t key2[kKeyLength];
+  MakeAccountKey(1, key1);
+  MakeAccountKey(2, key2);
+  nearby_BleFilter filter = nearby_BleFilter_init_zero;
+  AddAccountKey(key1, &filter);
+  FastPairAccountKeys account_keys;
+  ASSERT_TRUE(account_keys.Update(filter));
+
+  SubsequentPairAdvertisement advertisement;
+  advertisement.AddAccountKey(key2);
+  BleScanRecord record = advertisement.MakeScanRecord();
+  nearby_BleFilterResult result = nearby_BleFilterResult_init_zero;
+  EXPECT_FALSE(MatchFastPair(account_keys, record, &result));
+  EXPECT_EQ(result.data_element_count, 0);
+}
+
+TEST(FastPairFilterTest, MatchesAccountKeyWithRrdFirstByte) {
+  uint8_t key[kKeyLength];
+  MakeAccountKey(1, key);
+  nearby_BleFilter filter = nearby_BleFilter_init_zero;
+  AddAccountKey(key, &filter);
+  FastPairAccountKeys account_keys;
+  ASSERT_TRUE(account_keys.Update(filter));
+
+  SubsequentPairAdvertisement advertisement(/* with_rrd= */ true);
+  advertisement.AddAccountKey(key, kRecentKeyFirstByte);
+  BleScanRecord record = advertisement.MakeScanRecord();
+  nearby_BleFilterResult result = nearby_BleFilterResult_init_zero;
+  ASSERT_TRUE(MatchFastPair(account_keys, record, &result));
+  ASSERT_EQ(result.data_element_count, 1);
+  // The account key of the filter is reported, not the advertised variant.
+  EXPECT_EQ(memcmp(result.data_element[0].value, key, kKeyLength), 0);
+}
+
+TEST(FastPairFilterTest, DISABLED_MatchBenchmark) {
+  // Matches advertisements that include none of the filter's account keys, so
+  // every key variant is hashed.
+  constexpr size_t kMaxNumKeys = 8;
+  constexpr int kNumAdvertisements = 100;
+  uint8_t other_key[kKeyLength];
+  MakeAccountKey(kMaxNumKeys, other_key);
+  SubsequentPairAdvertisement advertisement(/* with_rrd= */ true);
+  advertisement.AddAccountKey(other_key);
+  BleScanRecord record = advertisement.MakeScanRecord();
+
+  for (size_t num_keys = 1; num_keys <= kMaxNumKeys; num_keys *= 2) {
+    nearby_BleFilter filter = nearby_BleFilter_init_zero;
+    for (size_t i = 0; i < num_keys; ++i) {
+      uint8_t key[kKeyLength];
+      MakeAccountKey(static_cast<uint8_t>(i), key);
+      AddAccountKey(key, &filter);
+    }
+    FastPairAccountKeys account_keys;
+    ASSERT_TRUE(account_keys.Update(filter));
+
+    uint64_t cycles = test::MeasureBestOf(20, [&] {
+      for (int i = 0; i < kNumAdvertisements; ++i) {
+        nearby_BleFilterResult result = nearby_BleFilterResult_init_zero;
+        EXPECT_FALSE(MatchFastPair(account_keys, record, &result));
+      }
+    });
+    printf("%zu account keys x %d advertisements: %.1f cycles/key/adv\n",
+           num_keys, kNumAdvertisements,
+           static_cast<double>(cycles) / (num_keys * kNumAdvertisements));
+  }
+}
+
+}  // namespace
+}  // namespace nearby
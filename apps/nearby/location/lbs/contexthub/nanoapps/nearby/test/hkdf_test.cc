@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/hkdf.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/benchmark.h"
+
+namespace nearby {
+namespace {
+
+void FillBytes(uint8_t *bytes, size_t length, uint8_t seed) {
+  for (size_t i = 0; i < length; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 13 + seed);
+  }
+}
+
+TEST(HkdfTest, MatchesRfc5869Vector) {
+  // RFC 5869 test case 1.
+  uint8_t ikm[22];
+  memset(ikm, 0x0b, sizeof(ikm));
+  constexpr uint8_t kSalt[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+                               0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c};
+  constexpr uint8_t kInfo[] = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4,
+                               0xf5, 0xf6, 0xf7, 0xf8, 0xf9};
+  constexpr uint8_t kExpected[42] = {
+      0x3c, 0xb2, 0x5f, 0x25, 0xfa, 0xac, 0xd5, 0x7a, 0x90, 0x43, 0x4f,
+      0x64, 0xd0, 0x36, 0x2f, 0x2a, 0x2d, 0x2d, 0x0a, 0x90, 0xcf, 0x1a,
+      0x5a, 0x4c, 0x5d, 0xb0, 0x2d, 0x56, 0xec, 0xc4, 0xc5, 0xbf, 0x34,
+      0x00, 0x72, 0x08, 0xd5, 0xb8, 0x87, 0x18, 0x58, 0x65};
+  uint8_t okm[sizeof(kExpected)];
+
+  hkdf(kSalt, sizeof(kSalt), ikm, sizeof(ikm), kInfo, sizeof(kInfo), okm,
+       sizeof(okm));
+  EXPECT_EQ(memcmp(okm, kExpected, sizeof(okm)), 0);
+
+  HmacKey salt_key;
+  hmacKeyInit(&salt_key, kSalt, sizeof(kSalt));
+  hkdfWithSaltKey(&salt_key, ikm, sizeof(ikm), kInfo, sizeof(kInfo), okm,
+                  sizeof(okm));
+  EXPECT_EQ(memcmp(okm, kExpected, sizeof(okm)), 0);
+}
+
+TEST(HkdfTest, WithSaltKeyMatchesHkdf) {
+  constexpr char kSalt[] = "Google Nearby";
+  constexpr char kInfo[] = "Unsigned Section metadata key HMAC key";
+  uint8_t ikm[64];
+  FillBytes(ikm, sizeof(ikm), 3);
+
+  HmacKey salt_key;
+  hmacKeyInit(&salt_key, kSalt, strlen(kSalt));
+  for (size_t ikm_len : {16u, 32u, 64u}) {
+    // Covers outputs shorter than, equal to and longer than a hash.
+    for (size_t okm_len : {16u, 32u, 33u, 100u}) {
+      uint8_t expected[100];
+      uint8_t actual[100];
+      hkdf(kSalt, strlen(kSalt), ikm, ikm_len, kInfo, strlen(kInfo), expected,
+           okm_len);
+      hkdfWithSaltKey(&salt_key, ikm, ikm_len, kInfo, strlen(kInfo), actual,
+                      okm_len);
+      ASSERT_EQ(memcmp(actual, expected, okm_len), 0)
+          << "ikm length " << ikm_len << ", okm length " << okm_len;
+    }
+  }
+}
+
+TEST(HkdfTest, DISABLED_WithSaltKeyBenchmark) {
+  constexpr char kSalt[] = "Google Nearby";
+  constexpr char kInfo[] = "V1 derived AES-CTR key";
+  constexpr int kNumDerivations = 1000;
+  uint8_t ikm[32];
+  FillBytes(ikm, sizeof(ikm), 3);
+  uint8_t okm[32];
+
+  uint64_t full = test::MeasureBestOf(20, [&] {
+    for (int i = 0; i < kNumDerivations; ++i) {
+      hkdf(kSalt, strlen(kSalt), ikm, sizeof(ikm), kInfo, strlen(kInfo), okm,
+           sizeof(okm));
+    }
+  });
+  HmacKey salt_key;
+  hmacKeyInit(&salt_key, kSalt, strlen(kSalt));
+  uint64_t with_salt_key = test::MeasureBestOf(20, [&] {
+    for (int i = 0; i < kNumDerivations; ++i) {
+      hkdfWithSaltKey(&salt_key, ikm, sizeof(ikm), kInfo, strlen(kInfo), okm,
+                      sizeof(okm));
+    }
+  });
+  printf("hkdf: %.1f cycles/key, hkdfWithSaltKey: %.1f cycles/key\n",
+         static_cast<double>(full) / kNumDerivations,
+         static_cast<double>(with_salt_key) / kNumDerivations);
+}
+
+}  // namespace
+}  // namespace nearby
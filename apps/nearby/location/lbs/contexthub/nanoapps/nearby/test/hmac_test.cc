@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/hmac.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/benchmark.h"
+
+namespace nearby {
+namespace {
+
+constexpr size_t kMaxKeyLen = 2 * SHA2_BLOCK_SIZE + 1;
+constexpr size_t kMaxDataLen = 2 * SHA2_BLOCK_SIZE + 1;
+
+void FillBytes(uint8_t *bytes, size_t length, uint8_t seed) {
+  for (size_t i = 0; i < length; ++i) {
+    bytes[i] = static_cast<uint8_t>(i * 13 + seed);
+  }
+}
+
+TEST(HmacTest, MatchesRfc4231Vector) {
+  // RFC 4231 test case 2.
+  constexpr char kKey[] = "Jefe";
+  constexpr char kData[] = "what do ya want for nothing?";
+  constexpr uint8_t kExpected[SHA2_HASH_SIZE] = {
+      0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24,
+      0x26, 0x08, 0x95, 0x75, 0xc7, 0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27,
+      0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43};
+  uint8_t mac[SHA2_HASH_SIZE];
+
+  hmacSha256(kKey, strlen(kKey), kData, strlen(kData), mac, sizeof(mac));
+  EXPECT_EQ(memcmp(mac, kExpected, sizeof(mac)), 0);
+
+  HmacKey key;
+  hmacKeyInit(&key, kKey, strlen(kKey));
+  hmacSha256WithKey(&key, kData, strlen(kData), mac, sizeof(mac));
+  EXPECT_EQ(memcmp(mac, kExpected, sizeof(mac)), 0);
+}
+
+TEST(HmacTest, WithKeyMatchesHmacSha256) {
+  uint8_t key_bytes[kMaxKeyLen];
+  uint8_t data[kMaxDataLen];
+  FillBytes(key_bytes, sizeof(key_bytes), 1);
+  FillBytes(data, sizeof(data), 2);
+
+  // Covers keys shorter than, equal to and longer than a block.
+  for (size_t key_len = 0; key_len <= kMaxKeyLen; ++key_len) {
+    HmacKey key;
+    hmacKeyInit(&key, key_bytes, key_len);
+    for (size_t data_len = 0; data_len <= kMaxDataLen; data_len += 7) {
+      uint8_t expected[SHA2_HASH_SIZE];
+      uint8_t actual[SHA2_HASH_SIZE];
+      hmacSha256(key_bytes, key_len, data, data_len, expected,
+                 sizeof(expected));
+      hmacSha256WithKey(&key, data, data_len, actual, sizeof(actual));
+      ASSERT_EQ(memcmp(actual, expected, sizeof(actual)), 0)
+          << "key length " << key_len << ", data length " << data_len;
+    }
+  }
+}
+
+TEST(HmacTest, DISABLED_WithKeyBenchmark) {
+  // Presence metadata key authentication: a 32-byte key and a 16-byte input.
+  constexpr int kNumMacs = 1000;
+  uint8_t key_bytes[32];
+  uint8_t data[16];
+  FillBytes(key_bytes, sizeof(key_bytes), 1);
+  FillBytes(data, sizeof(data), 2);
+  uint8_t mac[SHA2_HASH_SIZE];
+
+  uint64_t full = test::MeasureBestOf(20, [&] {
+    for (int i = 0; i < kNumMacs; ++i) {
+      hmacSha256(key_bytes, sizeof(key_bytes), data, sizeof(data), mac,
+                 sizeof(mac));
+    }
+  });
+  HmacKey key;
+  hmacKeyInit(&key, key_bytes, sizeof(key_bytes));
+  uint64_t with_key = test::MeasureBestOf(20, [&] {
+    for (int i = 0; i < kNumMacs; ++i) {
+      hmacSha256WithKey(&key, data, sizeof(data), mac, sizeof(mac));
+    }
+  });
+  printf("hmacSha256: %.1f cycles/MAC, hmacSha256WithKey: %.1f cycles/MAC\n",
+         static_cast<double>(full) / kNumMacs,
+         static_cast<double>(with_key) / kNumMacs);
+}
+
+}  // namespace
+}  // namespace nearby
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/presence_key_cache.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+
+namespace nearby {
+namespace {
+
+constexpr size_t kNumEntries = PresenceKeyCache::kNumEntries;
+
+class PresenceKeyCacheTest : public testing::Test {
+ protected:
+  // Returns an authenticity key of 32 bytes identified by id.
+  ByteArray MakeKey(uint8_t id) {
+    memset(keys_[id], id, sizeof(keys_[id]));
+    return ByteArray(keys_[id], sizeof(keys_[id]));
+  }
+
+  // Returns derived keys identified by id.
+  PresenceKeyCache::DerivedKeys MakeDerivedKeys(uint8_t id) {
+    PresenceKeyCache::DerivedKeys keys;
+    memset(&keys, id, sizeof(keys));
+    return keys;
+  }
+
+  bool HasDerivedKeys(const PresenceKeyCache::DerivedKeys *keys, uint8_t id) {
+    PresenceKeyCache::DerivedKeys expected = MakeDerivedKeys(id);
+    return keys != nullptr && memcmp(keys, &expected, sizeof(expected)) == 0;
+  }
+
+  PresenceKeyCache cache_;
+  uint8_t keys_[kNumEntries + 2][32];
+};
+
+TEST_F(PresenceKeyCacheTest, FindsInsertedKeys) {
+  EXPECT_EQ(cache_.Find(MakeKey(0)), nullptr);
+
+  EXPECT_TRUE(HasDerivedKeys(cache_.Insert(MakeKey(0), MakeDerivedKeys(0)), 0));
+  EXPECT_TRUE(HasDerivedKeys(cache_.Find(MakeKey(0)), 0));
+  EXPECT_EQ(cache_.Find(MakeKey(1)), nullptr);
+
+  // Keys are matched by length as well as by content.
+  ByteArray prefix = MakeKey(0);
+  prefix.length = 16;
+  EXPECT_EQ(cache_.Find(prefix), nullptr);
+}
+
+TEST_F(PresenceKeyCacheTest, EvictsLeastRecentlyUsedEntry) {
+  for (uint8_t i = 0; i < kNumEntries; ++i) {
+    cache_.Insert(MakeKey(i), MakeDerivedKeys(i));
+  }
+  // Uses the oldest entry, so that the second one is evicted instead.
+  EXPECT_NE(cache_.Find(MakeKey(0)), nullptr);
+  cache_.Insert(MakeKey(kNumEntries), MakeDerivedKeys(kNumEntries));
+
+  // With a single entry, the entry just used is the only one to evict.
+  uint8_t evicted = (kNumEntries > 1) ? 1 : 0;
+  EXPECT_EQ(cache_.Find(MakeKey(evicted)), nullptr);
+  for (uint8_t i = 0; i <= kNumEntries; ++i) {
+    if (i != evicted) {
+      EXPECT_TRUE(HasDerivedKeys(cache_.Find(MakeKey(i)), i));
+    }
+  }
+}
+
+TEST_F(PresenceKeyCacheTest, RejectsOversizedKeys) {
+  uint8_t key[PresenceKeyCache::kMaxAuthenticityKeySize + 1] = {};
+  EXPECT_EQ(cache_.Insert(ByteArray(key, sizeof(key)), MakeDerivedKeys(0)),
+            nullptr);
+  EXPECT_EQ(cache_.Find(ByteArray(key, sizeof(key))), nullptr);
+}
+
+TEST_F(PresenceKeyCacheTest, ClearRemovesAllEntries) {
+  for (uint8_t i = 0; i < kNumEntries; ++i) {
+    cache_.Insert(MakeKey(i), MakeDerivedKeys(i));
+  }
+  cache_.Clear();
+  for (uint8_t i = 0; i < kNumEntries; ++i) {
+    EXPECT_EQ(cache_.Find(MakeKey(i)), nullptr);
+  }
+}
+
+}  // namespace
+}  // namespace nearby
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "location/lbs/contexthub/nanoapps/nearby/crypto/sha2.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "location/lbs/contexthub/nanoapps/nearby/test/benchmark.h"
+
+namespace nearby {
+namespace {
+
+constexpr size_t kMaxMessageLen = 200;
+
+void FillMessage(uint8_t *message, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    message[i] = static_cast<uint8_t>(i * 7 + 3);
+  }
+}
+
+TEST(Sha2Test, MatchesKnownVector) {
+  // FIPS 180-2 appendix B.1.
+  constexpr uint8_t kExpected[SHA2_HASH_SIZE] = {
+      0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+      0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+      0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+  uint8_t hash[SHA2_HASH_SIZE];
+  sha256("abc", 3, hash, sizeof(hash));
+  EXPECT_EQ(memcmp(hash, kExpected, sizeof(hash)), 0);
+}
+
+TEST(Sha2Test, WithPrefixMatchesSha256) {
+  uint8_t message[kMaxMessageLen];
+  FillMessage(message, sizeof(message));
+
+  for (size_t length = 0; length <= kMaxMessageLen; ++length) {
+    uint8_t expected[SHA2_HASH_SIZE];
+    sha256(message, static_cast<uint32_t>(length), expected, sizeof(expected));
+
+    for (size_t prefix_len = 0; prefix_len <= length; ++prefix_len) {
+      Sha2Prefix prefix;
+      uint8_t actual[SHA2_HASH_SIZE];
+      sha2prefixInit(&prefix, message, prefix_len);
+      sha256WithPrefix(&prefix, message + prefix_len,
+                       static_cast<uint32_t>(length - prefix_len), actual,
+                       sizeof(actual));
+      ASSERT_EQ(memcmp(actual, expected, sizeof(actual)), 0)
+          << "length " << length << ", prefix length " << prefix_len;
+    }
+  }
+}
+
+TEST(Sha2Test, PrefixCanBeReused) {
+  uint8_t message[64];
+  FillMessage(message, sizeof(message));
+  Sha2Prefix prefix;
+  sha2prefixInit(&prefix, message, 16);
+
+  for (size_t suffix_len = 0; suffix_len <= sizeof(message) - 16;
+       ++suffix_len) {
+    uint8_t expected[SHA2_HASH_SIZE];
+    uint8_t actual[SHA2_HASH_SIZE];
+    sha256(message, static_cast<uint32_t>(16 + suffix_len), expected,
+           sizeof(expected));
+    sha256WithPrefix(&prefix, message + 16, static_cast<uint32_t>(suffix_len),
+                     actual, sizeof(actual));
+    ASSERT_EQ(memcmp(actual, expected, sizeof(actual)), 0);
+  }
+}
+
+TEST(Sha2Test, DISABLED_WithPrefixBenchmark) {
+  // A Fast Pair account key followed by the salt, battery and RRD data.
+  constexpr size_t kKeyLen = 16;
+  constexpr size_t kSuffixLen = 20;
+  constexpr int kNumHashes = 1000;
+  uint8_t message[kKeyLen + kSuffixLen];
+  FillMessage(message, sizeof(message));
+  uint8_t hash[SHA2_HASH_SIZE];
+
+  uint64_t full = test::MeasureBestOf(20, [&] {
+    for (int i = 0; i < kNumHashes; ++i) {
+      sha256(message, sizeof(message), hash, sizeof(hash));
+    }
+  });
+  Sha2Prefix prefix;
+  sha2prefixInit(&prefix, message, kKeyLen);
+  uint64_t with_prefix = test::MeasureBestOf(20, [&] {
+    for (int i = 0; i < kNumHashes; ++i) {
+      sha256WithPrefix(&prefix, message + kKeyLen, kSuffixLen, hash,
+                       sizeof(hash));
+    }
+  });
+  printf("sha256: %.1f cycles/hash, sha256WithPrefix: %.1f cycles/hash\n",
+         static_cast<double>(full) / kNumHashes,
+         static_cast<double>(with_prefix) / kNumHashes);
+}
+
+}  // namespace
+}  // namespace nearby
@@ -14,19 +14,203 @@
  * limitations under the License.
  */
 
+#include <cinttypes>
+#include <cmath>
+
+#include "chre/util/macros.h"
 #include "chre/util/nanoapp/log.h"
+#include "chre/util/time.h"
 #include "chre_api/chre.h"
 #include "model.h"
 
 #define LOG_TAG "[TFLM demo]"
 
-bool nanoappStart(void) {
-  float y_val = ::demo::run(3.14);
-  LOGI("result = %f", y_val);
-  return true;
+/**
+ * Benchmarks the inference of the sine model. Every second, the model is run
+ * over a period of the sine function, and the latency of the inferences, the
+ * time spent in each operator and the accuracy of the model are logged. The
+ * results are also added to the debug dump.
+ */
+
+#ifdef CHRE_NANOAPP_INTERNAL
+namespace chre {
+namespace {
+#endif  // CHRE_NANOAPP_INTERNAL
+
+namespace {
+
+//! The name of the optimized kernels TFLM was built with, if any.
+#ifdef TFLM_OPTIMIZED_KERNEL_DIR
+constexpr char kKernels[] = STRINGIFY(TFLM_OPTIMIZED_KERNEL_DIR);
+#else
+constexpr char kKernels[] = "reference";
+#endif  // TFLM_OPTIMIZED_KERNEL_DIR
+
+constexpr uint32_t kInferencesPerRound = 100;
+constexpr uint32_t kNumRounds = 10;
+constexpr uint64_t kRoundIntervalNs = chre::kOneSecondInNanoseconds;
+
+constexpr float kTwoPi = 6.28318530718f;
+
+struct LatencyStats {
+  uint32_t count;
+  uint64_t totalNs;
+  uint64_t minNs;
+  uint64_t maxNs;
+};
+
+bool gModelLoaded = false;
+uint32_t gTimerHandle = CHRE_TIMER_INVALID;
+uint32_t gNumRounds = 0;
+uint32_t gNumFailures = 0;
+LatencyStats gLatency = {0, 0, UINT64_MAX, 0};
+
+//! The largest difference between the model output and sinf().
+float gMaxError = 0.0f;
+
+uint64_t getMeanUs(uint64_t totalNs, uint32_t count) {
+  return (count == 0) ? 0
+                      : totalNs / count / chre::kOneMicrosecondInNanoseconds;
+}
+
+void runRound() {
+  for (uint32_t i = 0; i < kInferencesPerRound; i++) {
+    float x = kTwoPi * static_cast<float>(i) / kInferencesPerRound;
+    float y;
+    uint64_t startNs = chreGetTime();
+    bool success = ::demo::run(x, &y);
+    uint64_t durationNs = chreGetTime() - startNs;
+
+    if (!success) {
+      gNumFailures++;
+      continue;
+    }
+    gLatency.count++;
+    gLatency.totalNs += durationNs;
+    gLatency.minNs = (durationNs < gLatency.minNs) ? durationNs
+                                                   : gLatency.minNs;
+    gLatency.maxNs = (durationNs > gLatency.maxNs) ? durationNs
+                                                   : gLatency.maxNs;
+    float error = fabsf(y - sinf(x));
+    gMaxError = (error > gMaxError) ? error : gMaxError;
+  }
+  gNumRounds++;
+}
+
+void logOpStats() {
+  const ::demo::OpProfiler &profiler = ::demo::getProfiler();
+  uint64_t totalNs = profiler.getTotalNs();
+  for (size_t i = 0; i < profiler.getNumOps(); i++) {
+    const ::demo::OpProfiler::OpStats &op = profiler.getOpStats(i);
+    LOGI("  %s: %" PRIu32 " runs, mean %" PRIu64 " us, max %" PRIu64
+         " us, %" PRIu64 "%% of the time",
+         op.tag, op.count, getMeanUs(op.totalNs, op.count),
+         op.maxNs / chre::kOneMicrosecondInNanoseconds,
+         (totalNs == 0) ? 0 : op.totalNs * 100 / totalNs);
+  }
 }
 
-void nanoappEnd(void) {}
+void logResults() {
+  LOGI("Round %" PRIu32 ": %" PRIu32 " inferences, latency min %" PRIu64
+       " us, mean %" PRIu64 " us, max %" PRIu64 " us, %" PRIu32 " failures",
+       gNumRounds, gLatency.count,
+       gLatency.minNs / chre::kOneMicrosecondInNanoseconds,
+       getMeanUs(gLatency.totalNs, gLatency.count),
+       gLatency.maxNs / chre::kOneMicrosecondInNanoseconds, gNumFailures);
+  LOGI("Max error %f", static_cast<double>(gMaxError));
+}
+
+void handleDebugDumpEvent() {
+  // CHRE adds the nanoapp name / ID to the debug dump automatically.
+  if (!gModelLoaded) {
+    chreDebugDumpLog("  Model not loaded\n");
+    return;
+  }
+
+  chreDebugDumpLog("  Model: %s, %s kernels, arena %zu/%zu bytes\n",
+                   ::demo::isQuantized() ? "int8" : "float", kKernels,
+                   ::demo::getArenaUsedBytes(), ::demo::getArenaSize());
+  chreDebugDumpLog("  Inferences: %" PRIu32 " in %" PRIu32
+                   " rounds, %" PRIu32 " failures\n",
+                   gLatency.count, gNumRounds, gNumFailures);
+  if (gLatency.count > 0) {
+    chreDebugDumpLog("  Latency (us): min %" PRIu64 ", mean %" PRIu64
+                     ", max %" PRIu64 "\n",
+                     gLatency.minNs / chre::kOneMicrosecondInNanoseconds,
+                     getMeanUs(gLatency.totalNs, gLatency.count),
+                     gLatency.maxNs / chre::kOneMicrosecondInNanoseconds);
+    CHRE_DEBUG_DUMP_LOG("  Max error: %f\n", gMaxError);
+  }
+
+  const ::demo::OpProfiler &profiler = ::demo::getProfiler();
+  for (size_t i = 0; i < profiler.getNumOps(); i++) {
+    const ::demo::OpProfiler::OpStats &op = profiler.getOpStats(i);
+    chreDebugDumpLog("  Op %s: runs %" PRIu32 ", mean %" PRIu64
+                     " us, max %" PRIu64 " us\n",
+                     op.tag, op.count, getMeanUs(op.totalNs, op.count),
+                     op.maxNs / chre::kOneMicrosecondInNanoseconds);
+  }
+}
+
+}  // namespace
+
+bool nanoappStart() {
+  gModelLoaded = ::demo::init();
+  if (!gModelLoaded) {
+    LOGE("Failed to load the model");
+    return false;
+  }
+
+  LOGI("Loaded %s model with %s kernels, using %zu/%zu bytes of the arena",
+       ::demo::isQuantized() ? "int8" : "float", kKernels,
+       ::demo::getArenaUsedBytes(), ::demo::getArenaSize());
+
+  chreConfigureDebugDumpEvent(true /* enable */);
+  gTimerHandle = chreTimerSet(kRoundIntervalNs, /*cookie=*/nullptr,
+                              false /* oneShot */);
+  if (gTimerHandle == CHRE_TIMER_INVALID) {
+    LOGE("Failed to set the timer");
+  }
+  return gTimerHandle != CHRE_TIMER_INVALID;
+}
+
+void nanoappEnd() {
+  ::demo::deinit();
+}
+
+void nanoappHandleEvent(uint32_t senderInstanceId, uint16_t eventType,
+                        const void *eventData) {
+  UNUSED_VAR(eventData);
+
+  switch (eventType) {
+    case CHRE_EVENT_TIMER:
+      runRound();
+      logResults();
+      if (gNumRounds == kNumRounds) {
+        LOGI("Benchmark done, time per operator:");
+        logOpStats();
+        chreTimerCancel(gTimerHandle);
+        gTimerHandle = CHRE_TIMER_INVALID;
+      }
+      break;
+    case CHRE_EVENT_DEBUG_DUMP:
+      handleDebugDumpEvent();
+      break;
+    default:
+      LOGW("Unknown event type %" PRIu16 " received from sender %" PRIu32,
+           eventType, senderInstanceId);
+      break;
+  }
+}
+
+#ifdef CHRE_NANOAPP_INTERNAL
+}  // anonymous namespace
+}  // namespace chre
+
+#include "chre/platform/static_nanoapp_init.h"
+#include "chre/util/nanoapp/app_id.h"
+#include "chre/util/system/napp_permissions.h"
 
-void nanoappHandleEvent(uint32_t sender_instance_id, uint16_t event_type,
-                        const void *event_data) {}
+CHRE_STATIC_NANOAPP_INIT(TflmDemo, chre::kTflmDemoAppId, 0,
+                         chre::NanoappPermissions::CHRE_PERMS_NONE);
+#endif  // CHRE_NANOAPP_INTERNAL
@@ -16,51 +16,137 @@
 
 #include "model.h"
 
+#include <cmath>
+#include <cstdint>
+#include <new>
+
 #include "sine_model_data.h"
-#include "tensorflow/lite/micro/kernels/micro_ops.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
-//  The following registration code is generated. Check the following commit for
-//  details.
-//  https://github.com/tensorflow/tensorflow/commit/098556c3a96e1d51f79606c0834547cb2aa20908
-
+namespace demo {
 namespace {
-void RegisterSelectedOps(::tflite::MicroMutableOpResolver *resolver) {
-  resolver->AddBuiltin(
-      ::tflite::BuiltinOperator_FULLY_CONNECTED,
-      // For now the op version is not supported in the generated code, so this
-      // version still needs to added manually.
-      ::tflite::ops::micro::Register_FULLY_CONNECTED(), 1, 4);
+
+//! Quantization adds QUANTIZE and DEQUANTIZE ops around the fully connected
+//! layers when the model keeps a float interface.
+constexpr unsigned int kNumOps = 3;
+
+using OpResolver = tflite::MicroMutableOpResolver<kNumOps>;
+
+constexpr size_t kTensorArenaSize = 2 * 1024;
+
+alignas(16) uint8_t gTensorArena[kTensorArenaSize];
+
+//! Constructed in place in init(), so that nothing is allocated from the heap.
+alignas(OpResolver) uint8_t gResolverStorage[sizeof(OpResolver)];
+alignas(tflite::MicroInterpreter) uint8_t
+    gInterpreterStorage[sizeof(tflite::MicroInterpreter)];
+
+OpResolver *gResolver = nullptr;
+tflite::MicroInterpreter *gInterpreter = nullptr;
+OpProfiler gProfiler;
+
+int8_t quantize(float value, const TfLiteTensor *tensor) {
+  int32_t quantized =
+      static_cast<int32_t>(roundf(value / tensor->params.scale)) +
+      tensor->params.zero_point;
+  if (quantized < INT8_MIN) {
+    quantized = INT8_MIN;
+  } else if (quantized > INT8_MAX) {
+    quantized = INT8_MAX;
+  }
+  return static_cast<int8_t>(quantized);
+}
+
+float dequantize(int8_t value, const TfLiteTensor *tensor) {
+  return static_cast<float>(value - tensor->params.zero_point) *
+         tensor->params.scale;
 }
+
 }  // namespace
 
-namespace demo {
-float run(float x_val) {
+bool init() {
   const tflite::Model *model = tflite::GetModel(g_sine_model_data);
-  // TODO(wangtz): Check for schema version.
-
-  tflite::MicroMutableOpResolver resolver;
-  RegisterSelectedOps(&resolver);
-  constexpr int kTensorAreanaSize = 2 * 1024;
-  uint8_t tensor_arena[kTensorAreanaSize];
-
-  tflite::MicroInterpreter interpreter(model, resolver, tensor_arena,
-                                       kTensorAreanaSize);
-  interpreter.AllocateTensors();
-
-  TfLiteTensor *input = interpreter.input(0);
-  TfLiteTensor *output = interpreter.output(0);
-  input->data.f[0] = x_val;
-  TfLiteStatus invoke_status = interpreter.Invoke();
-  if (invoke_status != kTfLiteOk) {
+  if (model->version() != TFLITE_SCHEMA_VERSION) {
+    MicroPrintf("Unsupported schema version %d", model->version());
+    return false;
+  }
+
+  // The kernels registered here are the reference ones, or the optimized ones
+  // if TFLM was built with TFLM_OPTIMIZED_KERNEL_DIR.
+  gResolver = new (gResolverStorage) OpResolver();
+  gResolver->AddFullyConnected();
+  gResolver->AddQuantize();
+  gResolver->AddDequantize();
+
+  gInterpreter = new (gInterpreterStorage) tflite::MicroInterpreter(
+      model, *gResolver, gTensorArena, kTensorArenaSize,
+      /*resource_variables=*/nullptr, &gProfiler);
+  if (gInterpreter->AllocateTensors() != kTfLiteOk) {
+    MicroPrintf("Failed to allocate tensors");
+    deinit();
+    return false;
+  }
+
+  const TfLiteType inputType = gInterpreter->input(0)->type;
+  if (inputType != kTfLiteFloat32 && inputType != kTfLiteInt8) {
+    MicroPrintf("Unsupported input type %d", inputType);
+    deinit();
+    return false;
+  }
+
+  // Only time the inferences.
+  gProfiler.reset();
+  return true;
+}
+
+void deinit() {
+  if (gInterpreter != nullptr) {
+    gInterpreter->~MicroInterpreter();
+    gInterpreter = nullptr;
+  }
+  if (gResolver != nullptr) {
+    gResolver->~OpResolver();
+    gResolver = nullptr;
+  }
+}
+
+bool run(float x_val, float *y_val) {
+  TfLiteTensor *input = gInterpreter->input(0);
+  TfLiteTensor *output = gInterpreter->output(0);
+  if (input->type == kTfLiteInt8) {
+    input->data.int8[0] = quantize(x_val, input);
+  } else {
+    input->data.f[0] = x_val;
+  }
+
+  if (gInterpreter->Invoke() != kTfLiteOk) {
     MicroPrintf("Internal error: invoke failed.");
-    return 0.0;
+    return false;
   }
-  float y_val = output->data.f[0];
-  return y_val;
+
+  *y_val = (output->type == kTfLiteInt8)
+               ? dequantize(output->data.int8[0], output)
+               : output->data.f[0];
+  return true;
+}
+
+bool isQuantized() {
+  return gInterpreter->input(0)->type == kTfLiteInt8;
+}
+
+size_t getArenaUsedBytes() {
+  return gInterpreter->arena_used_bytes();
+}
+
+size_t getArenaSize() {
+  return kTensorArenaSize;
+}
+
+OpProfiler &getProfiler() {
+  return gProfiler;
 }
 
 }  // namespace demo
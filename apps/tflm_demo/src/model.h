@@ -17,8 +17,47 @@
 #ifndef NANOAPPS_TFLM_DEMO_MODEL_H_
 #define NANOAPPS_TFLM_DEMO_MODEL_H_
 
+#include <cstddef>
+
+#include "op_profiler.h"
+
 namespace demo {
-float run(float x_val);
-}
+
+/**
+ * Loads the sine model and allocates its tensors. The model can either be a
+ * float model, or a fully int8-quantized one whose input and output are
+ * quantized and dequantized here.
+ *
+ * @return false if the model couldn't be loaded.
+ */
+bool init();
+
+/**
+ * Releases the interpreter.
+ */
+void deinit();
+
+/**
+ * Runs the model once.
+ *
+ * @param x_val The input of the model.
+ * @param y_val Where the output of the model is written.
+ * @return false if the inference failed.
+ */
+bool run(float x_val, float *y_val);
+
+//! @return true if the input of the model is int8-quantized.
+bool isQuantized();
+
+//! @return The number of bytes of the tensor arena used by the model.
+size_t getArenaUsedBytes();
+
+//! @return The size of the tensor arena.
+size_t getArenaSize();
+
+//! @return The profiler timing the operators of the model.
+OpProfiler &getProfiler();
+
+}  // namespace demo
 
 #endif  // NANOAPPS_TFLM_DEMO_MODEL_H_
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "op_profiler.h"
+
+#include <cstring>
+
+#include "chre_api/chre.h"
+
+namespace demo {
+
+uint32_t OpProfiler::BeginEvent(const char *tag) {
+  if (mNumEvents == kMaxEvents) {
+    return kInvalidHandle;
+  }
+
+  size_t opIndex = findOrAddOp(tag);
+  if (opIndex == kMaxOps) {
+    return kInvalidHandle;
+  }
+
+  mEvents[mNumEvents] = {opIndex, chreGetTime()};
+  return mNumEvents++;
+}
+
+void OpProfiler::EndEvent(uint32_t eventHandle) {
+  uint64_t endNs = chreGetTime();
+  if (eventHandle >= mNumEvents) {
+    return;
+  }
+
+  const Event &event = mEvents[eventHandle];
+  uint64_t durationNs = endNs - event.startNs;
+  OpStats &op = mOps[event.opIndex];
+  op.count++;
+  op.totalNs += durationNs;
+  if (durationNs > op.maxNs) {
+    op.maxNs = durationNs;
+  }
+
+  // Events end in the reverse order they began.
+  mNumEvents = eventHandle;
+}
+
+void OpProfiler::reset() {
+  mNumOps = 0;
+  mNumEvents = 0;
+}
+
+uint64_t OpProfiler::getTotalNs() const {
+  uint64_t totalNs = 0;
+  for (size_t i = 0; i < mNumOps; i++) {
+    totalNs += mOps[i].totalNs;
+  }
+  return totalNs;
+}
+
+size_t OpProfiler::findOrAddOp(const char *tag) {
+  for (size_t i = 0; i < mNumOps; i++) {
+    // The tags are usually the same static strings, so compare them first.
+    if (mOps[i].tag == tag || strcmp(mOps[i].tag, tag) == 0) {
+      return i;
+    }
+  }
+
+  if (mNumOps == kMaxOps) {
+    return kMaxOps;
+  }
+  mOps[mNumOps] = {tag, /*count=*/0, /*totalNs=*/0, /*maxNs=*/0};
+  return mNumOps++;
+}
+
+}  // namespace demo
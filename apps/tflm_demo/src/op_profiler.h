@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NANOAPPS_TFLM_DEMO_OP_PROFILER_H_
+#define NANOAPPS_TFLM_DEMO_OP_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+
+namespace demo {
+
+/**
+ * Accumulates the time spent in each type of operator, as reported by the
+ * interpreter around the evaluation of every op of the graph. Time is measured
+ * with chreGetTime().
+ */
+class OpProfiler : public tflite::MicroProfilerInterface {
+ public:
+  //! The maximum number of distinct operator types tracked.
+  static constexpr size_t kMaxOps = 16;
+
+  struct OpStats {
+    //! The operator name, as given by the interpreter.
+    const char *tag;
+    uint32_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+  };
+
+  uint32_t BeginEvent(const char *tag) override;
+  void EndEvent(uint32_t eventHandle) override;
+
+  //! Clears the accumulated statistics.
+  void reset();
+
+  size_t getNumOps() const {
+    return mNumOps;
+  }
+
+  const OpStats &getOpStats(size_t index) const {
+    return mOps[index];
+  }
+
+  //! @return The time spent in all the operators.
+  uint64_t getTotalNs() const;
+
+ private:
+  //! The maximum depth of nested events.
+  static constexpr uint32_t kMaxEvents = 4;
+
+  //! Returned for the events that can't be tracked.
+  static constexpr uint32_t kInvalidHandle = UINT32_MAX;
+
+  struct Event {
+    size_t opIndex;
+    uint64_t startNs;
+  };
+
+  OpStats mOps[kMaxOps];
+  size_t mNumOps = 0;
+
+  //! The events in progress, the last one being the innermost.
+  Event mEvents[kMaxEvents];
+  uint32_t mNumEvents = 0;
+
+  //! @return The index of the op with the given tag, adding it if needed, or
+  //!     kMaxOps if there is no room for it.
+  size_t findOrAddOp(const char *tag);
+};
+
+}  // namespace demo
+
+#endif  // NANOAPPS_TFLM_DEMO_OP_PROFILER_H_
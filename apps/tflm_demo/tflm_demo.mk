@@ -0,0 +1,18 @@
+#
+# TensorFlow Lite for Microcontroller demo app Makefile
+#
+
+# Common Compiler Flags ########################################################
+
+# Include paths.
+COMMON_CFLAGS += -Iapps/tflm_demo/src
+
+# Adds the demo to the static nanoapps of the variants that support it.
+COMMON_CFLAGS += -DCHRE_TFLM_DEMO_ENABLED
+
+# Common Source Files ##########################################################
+
+COMMON_SRCS += apps/tflm_demo/src/main.cc
+COMMON_SRCS += apps/tflm_demo/src/model.cc
+COMMON_SRCS += apps/tflm_demo/src/op_profiler.cc
+COMMON_SRCS += apps/tflm_demo/src/sine_model_data.cc
@@ -685,6 +685,8 @@ void chppAppProcessRxDatagram(struct ChppAppState *context, uint8_t *buf,
               rxHeader->error, rxHeader->command);
   }
 
+  context->isRxDatagramKept = false;
+
   if (!chppDatagramLenIsOk(context, rxHeader, len)) {
     chppEnqueueTxErrorDatagram(context->transportContext,
                                CHPP_TRANSPORT_ERROR_APPLAYER);
@@ -701,7 +703,15 @@ void chppAppProcessRxDatagram(struct ChppAppState *context, uint8_t *buf,
     }
   }
 
-  chppDatagramProcessDoneCb(context->transportContext, buf);
+  if (!context->isRxDatagramKept) {
+    chppDatagramProcessDoneCb(context->transportContext, buf);
+  }
+}
+
+void chppAppKeepRxDatagram(struct ChppAppState *context) {
+  CHPP_DEBUG_NOT_NULL(context);
+
+  context->isRxDatagramKept = true;
 }
 
 void chppAppProcessReset(struct ChppAppState *context) {
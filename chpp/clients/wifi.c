@@ -30,6 +30,7 @@
 #endif
 #include "chpp/common/standard_uuids.h"
 #include "chpp/common/wifi.h"
+#include "chpp/common/wifi_scan_stream.h"
 #include "chpp/common/wifi_types.h"
 #include "chpp/common/wifi_utils.h"
 #include "chpp/log.h"
@@ -624,14 +625,12 @@ static void chppWifiNanSubscriptionCanceledResult(uint8_t *buf, size_t len) {
  */
 static void chppWifiScanEventNotification(
     struct ChppWifiClientState *clientContext, uint8_t *buf, size_t len) {
-  UNUSED_VAR(clientContext);
   CHPP_LOGD("chppWifiScanEventNotification received data len=%" PRIuSIZE, len);
 
-  buf += sizeof(struct ChppAppHeader);
-  len -= sizeof(struct ChppAppHeader);
-
-  struct chreWifiScanEvent *chre =
-      chppWifiScanEventToChre((struct ChppWifiScanEvent *)buf, len);
+  // The scanned frequencies and results are decoded within the datagram, which
+  // is kept until the event is released.
+  struct chreWifiScanEvent *chre = chppWifiScanEventToChreInPlace(
+      clientContext->client.appContext, buf, len);
 
   if (chre == NULL) {
     CHPP_LOGE("Scan event conversion failed len=%" PRIuSIZE, len);
@@ -1003,17 +1002,7 @@ static bool chppWifiClientRequestScan(const struct chreWifiScanParams *params) {
  * @param event Location event to be released.
  */
 static void chppWifiClientReleaseScanEvent(struct chreWifiScanEvent *event) {
-  if (event->scannedFreqListLen > 0) {
-    void *scannedFreqList = CHPP_CONST_CAST_POINTER(event->scannedFreqList);
-    CHPP_FREE_AND_NULLIFY(scannedFreqList);
-  }
-
-  if (event->resultCount > 0) {
-    void *results = CHPP_CONST_CAST_POINTER(event->results);
-    CHPP_FREE_AND_NULLIFY(results);
-  }
-
-  CHPP_FREE_AND_NULLIFY(event);
+  chppWifiScanEventInPlaceRelease(event);
 }
 
 /**
@@ -46,6 +46,12 @@ static size_t chppGnssSizeOfDataEventFromChre(
 
 static void chppGnssConvertClockFromChre(const struct chreGnssClock *in,
                                          struct ChppGnssClock *out) {
+  if (CHPP_GNSS_CLOCK_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return;
+  }
+
   out->time_ns = in->time_ns;
   out->full_bias_ns = in->full_bias_ns;
   out->bias_ns = in->bias_ns;
@@ -59,6 +65,11 @@ static void chppGnssConvertClockFromChre(const struct chreGnssClock *in,
 
 static void chppGnssConvertMeasurementFromChre(
     const struct chreGnssMeasurement *in, struct ChppGnssMeasurement *out) {
+  if (CHPP_GNSS_MEASUREMENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->time_offset_ns = in->time_offset_ns;
   out->accumulated_delta_range_um = in->accumulated_delta_range_um;
   out->received_sv_time_in_ns = in->received_sv_time_in_ns;
@@ -95,9 +106,13 @@ static void chppGnssConvertDataEventFromChre(const struct chreGnssDataEvent *in,
   CHPP_ASSERT((size_t)(*vlaOffset + out->measurements.length) <= payloadSize);
   if (out->measurements.length > 0 &&
       *vlaOffset + out->measurements.length <= payloadSize) {
-    for (size_t i = 0; i < in->measurement_count; i++) {
-      chppGnssConvertMeasurementFromChre(&in->measurements[i],
-                                         &measurements[i]);
+    if (CHPP_GNSS_MEASUREMENT_MATCHES_CHRE_LAYOUT) {
+      memcpy(measurements, in->measurements, out->measurements.length);
+    } else {
+      for (size_t i = 0; i < in->measurement_count; i++) {
+        chppGnssConvertMeasurementFromChre(&in->measurements[i],
+                                           &measurements[i]);
+      }
     }
     out->measurements.offset = *vlaOffset;
     *vlaOffset += out->measurements.length;
@@ -108,6 +123,12 @@ static void chppGnssConvertDataEventFromChre(const struct chreGnssDataEvent *in,
 
 static void chppGnssConvertLocationEventFromChre(
     const struct chreGnssLocationEvent *in, struct ChppGnssLocationEvent *out) {
+  if (CHPP_GNSS_LOCATION_EVENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return;
+  }
+
   out->timestamp = in->timestamp;
   out->latitude_deg_e7 = in->latitude_deg_e7;
   out->longitude_deg_e7 = in->longitude_deg_e7;
@@ -163,6 +184,12 @@ bool chppGnssLocationEventFromChre(const struct chreGnssLocationEvent *in,
 
 static bool chppGnssConvertClockToChre(const struct ChppGnssClock *in,
                                        struct chreGnssClock *out) {
+  if (CHPP_GNSS_CLOCK_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return true;
+  }
+
   out->time_ns = in->time_ns;
   out->full_bias_ns = in->full_bias_ns;
   out->bias_ns = in->bias_ns;
@@ -178,6 +205,11 @@ static bool chppGnssConvertClockToChre(const struct ChppGnssClock *in,
 
 static bool chppGnssConvertMeasurementToChre(
     const struct ChppGnssMeasurement *in, struct chreGnssMeasurement *out) {
+  if (CHPP_GNSS_MEASUREMENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->time_offset_ns = in->time_offset_ns;
   out->accumulated_delta_range_um = in->accumulated_delta_range_um;
   out->received_sv_time_in_ns = in->received_sv_time_in_ns;
@@ -228,10 +260,14 @@ static bool chppGnssConvertDataEventToChre(const struct ChppGnssDataEvent *in,
       return false;
     }
 
-    for (size_t i = 0; i < in->measurement_count; i++) {
-      if (!chppGnssConvertMeasurementToChre(&measurementsIn[i],
-                                            &measurementsOut[i])) {
-        return false;
+    if (CHPP_GNSS_MEASUREMENT_MATCHES_CHRE_LAYOUT) {
+      memcpy(measurementsOut, measurementsIn, in->measurements.length);
+    } else {
+      for (size_t i = 0; i < in->measurement_count; i++) {
+        if (!chppGnssConvertMeasurementToChre(&measurementsIn[i],
+                                              &measurementsOut[i])) {
+          return false;
+        }
       }
     }
     out->measurements = measurementsOut;
@@ -242,6 +278,12 @@ static bool chppGnssConvertDataEventToChre(const struct ChppGnssDataEvent *in,
 
 static bool chppGnssConvertLocationEventToChre(
     const struct ChppGnssLocationEvent *in, struct chreGnssLocationEvent *out) {
+  if (CHPP_GNSS_LOCATION_EVENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return true;
+  }
+
   out->timestamp = in->timestamp;
   out->latitude_deg_e7 = in->latitude_deg_e7;
   out->longitude_deg_e7 = in->longitude_deg_e7;
@@ -103,6 +103,12 @@ static size_t chppWifiSizeOfNanDiscoveryEventFromChre(
 
 static void chppWifiConvertScanResultFromChre(
     const struct chreWifiScanResult *in, struct ChppWifiScanResult *out) {
+  if (CHPP_WIFI_SCAN_RESULT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return;
+  }
+
   out->ageMs = in->ageMs;
   out->capabilityInfo = in->capabilityInfo;
   out->ssidLen = in->ssidLen;
@@ -156,8 +162,15 @@ static void chppWifiConvertScanEventFromChre(const struct chreWifiScanEvent *in,
   CHPP_ASSERT((size_t)(*vlaOffset + out->results.length) <= payloadSize);
   if (out->results.length > 0 &&
       *vlaOffset + out->results.length <= payloadSize) {
-    for (size_t i = 0; i < in->resultCount; i++) {
-      chppWifiConvertScanResultFromChre(&in->results[i], &results[i]);
+    if (CHPP_WIFI_SCAN_RESULT_MATCHES_CHRE_LAYOUT) {
+      memcpy(results, in->results, out->results.length);
+      for (size_t i = 0; i < in->resultCount; i++) {
+        memset(&results[i].reserved, 0, sizeof(results[i].reserved));
+      }
+    } else {
+      for (size_t i = 0; i < in->resultCount; i++) {
+        chppWifiConvertScanResultFromChre(&in->results[i], &results[i]);
+      }
     }
     out->results.offset = *vlaOffset;
     *vlaOffset += out->results.length;
@@ -169,6 +182,11 @@ static void chppWifiConvertScanEventFromChre(const struct chreWifiScanEvent *in,
 
 static void chppWifiConvertSsidListItemFromChre(
     const struct chreWifiSsidListItem *in, struct ChppWifiSsidListItem *out) {
+  if (CHPP_WIFI_SSID_LIST_ITEM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->ssidLen = in->ssidLen;
   memcpy(out->ssid, in->ssid, sizeof(out->ssid));
 }
@@ -200,8 +218,12 @@ static void chppWifiConvertScanParamsFromChre(
   CHPP_ASSERT((size_t)(*vlaOffset + out->ssidList.length) <= payloadSize);
   if (out->ssidList.length > 0 &&
       *vlaOffset + out->ssidList.length <= payloadSize) {
-    for (size_t i = 0; i < in->ssidListLen; i++) {
-      chppWifiConvertSsidListItemFromChre(&in->ssidList[i], &ssidList[i]);
+    if (CHPP_WIFI_SSID_LIST_ITEM_MATCHES_CHRE_LAYOUT) {
+      memcpy(ssidList, in->ssidList, out->ssidList.length);
+    } else {
+      for (size_t i = 0; i < in->ssidListLen; i++) {
+        chppWifiConvertSsidListItemFromChre(&in->ssidList[i], &ssidList[i]);
+      }
     }
     out->ssidList.offset = *vlaOffset;
     *vlaOffset += out->ssidList.length;
@@ -214,6 +236,11 @@ static void chppWifiConvertScanParamsFromChre(
 
 static void chppWifiConvertLciFromChre(const struct chreWifiLci *in,
                                        struct ChppWifiLci *out) {
+  if (CHPP_WIFI_LCI_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->latitude = in->latitude;
   out->longitude = in->longitude;
   out->altitude = in->altitude;
@@ -225,6 +252,12 @@ static void chppWifiConvertLciFromChre(const struct chreWifiLci *in,
 
 static void chppWifiConvertRangingResultFromChre(
     const struct chreWifiRangingResult *in, struct ChppWifiRangingResult *out) {
+  if (CHPP_WIFI_RANGING_RESULT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return;
+  }
+
   out->timestamp = in->timestamp;
   memcpy(out->macAddress, in->macAddress, sizeof(out->macAddress));
   out->status = in->status;
@@ -250,8 +283,15 @@ static void chppWifiConvertRangingEventFromChre(
   CHPP_ASSERT((size_t)(*vlaOffset + out->results.length) <= payloadSize);
   if (out->results.length > 0 &&
       *vlaOffset + out->results.length <= payloadSize) {
-    for (size_t i = 0; i < in->resultCount; i++) {
-      chppWifiConvertRangingResultFromChre(&in->results[i], &results[i]);
+    if (CHPP_WIFI_RANGING_RESULT_MATCHES_CHRE_LAYOUT) {
+      memcpy(results, in->results, out->results.length);
+      for (size_t i = 0; i < in->resultCount; i++) {
+        memset(&results[i].reserved, 0, sizeof(results[i].reserved));
+      }
+    } else {
+      for (size_t i = 0; i < in->resultCount; i++) {
+        chppWifiConvertRangingResultFromChre(&in->results[i], &results[i]);
+      }
     }
     out->results.offset = *vlaOffset;
     *vlaOffset += out->results.length;
@@ -262,6 +302,12 @@ static void chppWifiConvertRangingEventFromChre(
 
 static void chppWifiConvertRangingTargetFromChre(
     const struct chreWifiRangingTarget *in, struct ChppWifiRangingTarget *out) {
+  if (CHPP_WIFI_RANGING_TARGET_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return;
+  }
+
   memcpy(out->macAddress, in->macAddress, sizeof(out->macAddress));
   out->primaryChannel = in->primaryChannel;
   out->centerFreqPrimary = in->centerFreqPrimary;
@@ -282,8 +328,16 @@ static void chppWifiConvertRangingParamsFromChre(
   CHPP_ASSERT((size_t)(*vlaOffset + out->targetList.length) <= payloadSize);
   if (out->targetList.length > 0 &&
       *vlaOffset + out->targetList.length <= payloadSize) {
-    for (size_t i = 0; i < in->targetListLen; i++) {
-      chppWifiConvertRangingTargetFromChre(&in->targetList[i], &targetList[i]);
+    if (CHPP_WIFI_RANGING_TARGET_MATCHES_CHRE_LAYOUT) {
+      memcpy(targetList, in->targetList, out->targetList.length);
+      for (size_t i = 0; i < in->targetListLen; i++) {
+        memset(&targetList[i].reserved, 0, sizeof(targetList[i].reserved));
+      }
+    } else {
+      for (size_t i = 0; i < in->targetListLen; i++) {
+        chppWifiConvertRangingTargetFromChre(&in->targetList[i],
+                                             &targetList[i]);
+      }
     }
     out->targetList.offset = *vlaOffset;
     *vlaOffset += out->targetList.length;
@@ -363,6 +417,11 @@ static void chppWifiConvertNanDiscoveryEventFromChre(
 static void chppWifiConvertNanSessionLostEventFromChre(
     const struct chreWifiNanSessionLostEvent *in,
     struct ChppWifiNanSessionLostEvent *out) {
+  if (CHPP_WIFI_NAN_SESSION_LOST_EVENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->id = in->id;
   out->peerId = in->peerId;
 }
@@ -370,6 +429,11 @@ static void chppWifiConvertNanSessionLostEventFromChre(
 static void chppWifiConvertNanSessionTerminatedEventFromChre(
     const struct chreWifiNanSessionTerminatedEvent *in,
     struct ChppWifiNanSessionTerminatedEvent *out) {
+  if (CHPP_WIFI_NAN_SESSION_TERMINATED_EVENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->id = in->id;
   out->reason = in->reason;
   memcpy(out->reserved, in->reserved, sizeof(out->reserved));
@@ -378,6 +442,11 @@ static void chppWifiConvertNanSessionTerminatedEventFromChre(
 static void chppWifiConvertNanRangingParamsFromChre(
     const struct chreWifiNanRangingParams *in,
     struct ChppWifiNanRangingParams *out) {
+  if (CHPP_WIFI_NAN_RANGING_PARAMS_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   memcpy(out->macAddress, in->macAddress, sizeof(out->macAddress));
 }
 
@@ -550,6 +619,12 @@ bool chppWifiNanRangingParamsFromChre(
 
 static bool chppWifiConvertScanResultToChre(const struct ChppWifiScanResult *in,
                                             struct chreWifiScanResult *out) {
+  if (CHPP_WIFI_SCAN_RESULT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return true;
+  }
+
   out->ageMs = in->ageMs;
   out->capabilityInfo = in->capabilityInfo;
   out->ssidLen = in->ssidLen;
@@ -610,6 +685,7 @@ static bool chppWifiConvertScanEventToChre(const struct ChppWifiScanEvent *in,
     if (in->results.offset + in->results.length > inSize ||
         in->results.length !=
             in->resultCount * sizeof(struct ChppWifiScanResult)) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->scannedFreqList));
       return false;
     }
 
@@ -620,12 +696,20 @@ static bool chppWifiConvertScanEventToChre(const struct ChppWifiScanEvent *in,
     struct chreWifiScanResult *resultsOut =
         chppMalloc(in->resultCount * sizeof(struct chreWifiScanResult));
     if (resultsOut == NULL) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->scannedFreqList));
       return false;
     }
 
-    for (size_t i = 0; i < in->resultCount; i++) {
-      if (!chppWifiConvertScanResultToChre(&resultsIn[i], &resultsOut[i])) {
-        return false;
+    if (CHPP_WIFI_SCAN_RESULT_MATCHES_CHRE_LAYOUT) {
+      memcpy(resultsOut, resultsIn, in->results.length);
+      for (size_t i = 0; i < in->resultCount; i++) {
+        memset(&resultsOut[i].reserved, 0, sizeof(resultsOut[i].reserved));
+      }
+    } else {
+      for (size_t i = 0; i < in->resultCount; i++) {
+        if (!chppWifiConvertScanResultToChre(&resultsIn[i], &resultsOut[i])) {
+          return false;
+        }
       }
     }
     out->results = resultsOut;
@@ -638,6 +722,11 @@ static bool chppWifiConvertScanEventToChre(const struct ChppWifiScanEvent *in,
 
 static bool chppWifiConvertSsidListItemToChre(
     const struct ChppWifiSsidListItem *in, struct chreWifiSsidListItem *out) {
+  if (CHPP_WIFI_SSID_LIST_ITEM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->ssidLen = in->ssidLen;
   memcpy(out->ssid, in->ssid, sizeof(out->ssid));
 
@@ -678,6 +767,7 @@ static bool chppWifiConvertScanParamsToChre(const struct ChppWifiScanParams *in,
     if (in->ssidList.offset + in->ssidList.length > inSize ||
         in->ssidList.length !=
             in->ssidListLen * sizeof(struct ChppWifiSsidListItem)) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->frequencyList));
       return false;
     }
 
@@ -688,12 +778,18 @@ static bool chppWifiConvertScanParamsToChre(const struct ChppWifiScanParams *in,
     struct chreWifiSsidListItem *ssidListOut =
         chppMalloc(in->ssidListLen * sizeof(struct chreWifiSsidListItem));
     if (ssidListOut == NULL) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->frequencyList));
       return false;
     }
 
-    for (size_t i = 0; i < in->ssidListLen; i++) {
-      if (!chppWifiConvertSsidListItemToChre(&ssidListIn[i], &ssidListOut[i])) {
-        return false;
+    if (CHPP_WIFI_SSID_LIST_ITEM_MATCHES_CHRE_LAYOUT) {
+      memcpy(ssidListOut, ssidListIn, in->ssidList.length);
+    } else {
+      for (size_t i = 0; i < in->ssidListLen; i++) {
+        if (!chppWifiConvertSsidListItemToChre(&ssidListIn[i],
+                                               &ssidListOut[i])) {
+          return false;
+        }
       }
     }
     out->ssidList = ssidListOut;
@@ -707,6 +803,11 @@ static bool chppWifiConvertScanParamsToChre(const struct ChppWifiScanParams *in,
 
 static bool chppWifiConvertLciToChre(const struct ChppWifiLci *in,
                                      struct chreWifiLci *out) {
+  if (CHPP_WIFI_LCI_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->latitude = in->latitude;
   out->longitude = in->longitude;
   out->altitude = in->altitude;
@@ -720,6 +821,12 @@ static bool chppWifiConvertLciToChre(const struct ChppWifiLci *in,
 
 static bool chppWifiConvertRangingResultToChre(
     const struct ChppWifiRangingResult *in, struct chreWifiRangingResult *out) {
+  if (CHPP_WIFI_RANGING_RESULT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return true;
+  }
+
   out->timestamp = in->timestamp;
   memcpy(out->macAddress, in->macAddress, sizeof(out->macAddress));
   out->status = in->status;
@@ -761,9 +868,17 @@ static bool chppWifiConvertRangingEventToChre(
       return false;
     }
 
-    for (size_t i = 0; i < in->resultCount; i++) {
-      if (!chppWifiConvertRangingResultToChre(&resultsIn[i], &resultsOut[i])) {
-        return false;
+    if (CHPP_WIFI_RANGING_RESULT_MATCHES_CHRE_LAYOUT) {
+      memcpy(resultsOut, resultsIn, in->results.length);
+      for (size_t i = 0; i < in->resultCount; i++) {
+        memset(&resultsOut[i].reserved, 0, sizeof(resultsOut[i].reserved));
+      }
+    } else {
+      for (size_t i = 0; i < in->resultCount; i++) {
+        if (!chppWifiConvertRangingResultToChre(&resultsIn[i],
+                                                &resultsOut[i])) {
+          return false;
+        }
       }
     }
     out->results = resultsOut;
@@ -774,6 +889,12 @@ static bool chppWifiConvertRangingEventToChre(
 
 static bool chppWifiConvertRangingTargetToChre(
     const struct ChppWifiRangingTarget *in, struct chreWifiRangingTarget *out) {
+  if (CHPP_WIFI_RANGING_TARGET_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return true;
+  }
+
   memcpy(out->macAddress, in->macAddress, sizeof(out->macAddress));
   out->primaryChannel = in->primaryChannel;
   out->centerFreqPrimary = in->centerFreqPrimary;
@@ -808,10 +929,18 @@ static bool chppWifiConvertRangingParamsToChre(
       return false;
     }
 
-    for (size_t i = 0; i < in->targetListLen; i++) {
-      if (!chppWifiConvertRangingTargetToChre(&targetListIn[i],
-                                              &targetListOut[i])) {
-        return false;
+    if (CHPP_WIFI_RANGING_TARGET_MATCHES_CHRE_LAYOUT) {
+      memcpy(targetListOut, targetListIn, in->targetList.length);
+      for (size_t i = 0; i < in->targetListLen; i++) {
+        memset(&targetListOut[i].reserved, 0,
+               sizeof(targetListOut[i].reserved));
+      }
+    } else {
+      for (size_t i = 0; i < in->targetListLen; i++) {
+        if (!chppWifiConvertRangingTargetToChre(&targetListIn[i],
+                                                &targetListOut[i])) {
+          return false;
+        }
       }
     }
     out->targetList = targetListOut;
@@ -828,6 +957,12 @@ static bool chppWifiConvertNanSubscribeConfigToChre(
   if (in->service.length == 0) {
     out->service = NULL;
   } else {
+    if (in->service.offset + in->service.length > inSize ||
+        ((const char *)in)[in->service.offset + in->service.length - 1] !=
+            '\0') {
+      return false;
+    }
+
     char *serviceOut = chppMalloc(in->service.length);
     if (serviceOut == NULL) {
       return false;
@@ -845,12 +980,14 @@ static bool chppWifiConvertNanSubscribeConfigToChre(
             inSize ||
         in->serviceSpecificInfo.length !=
             in->serviceSpecificInfoSize * sizeof(uint8_t)) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->service));
       return false;
     }
 
     uint8_t *serviceSpecificInfoOut =
         chppMalloc(in->serviceSpecificInfoSize * sizeof(uint8_t));
     if (serviceSpecificInfoOut == NULL) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->service));
       return false;
     }
 
@@ -867,12 +1004,16 @@ static bool chppWifiConvertNanSubscribeConfigToChre(
   } else {
     if (in->matchFilter.offset + in->matchFilter.length > inSize ||
         in->matchFilter.length != in->matchFilterLength * sizeof(uint8_t)) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->service));
+      chppFree(CHPP_CONST_CAST_POINTER(out->serviceSpecificInfo));
       return false;
     }
 
     uint8_t *matchFilterOut =
         chppMalloc(in->matchFilterLength * sizeof(uint8_t));
     if (matchFilterOut == NULL) {
+      chppFree(CHPP_CONST_CAST_POINTER(out->service));
+      chppFree(CHPP_CONST_CAST_POINTER(out->serviceSpecificInfo));
       return false;
     }
 
@@ -924,6 +1065,11 @@ static bool chppWifiConvertNanDiscoveryEventToChre(
 static bool chppWifiConvertNanSessionLostEventToChre(
     const struct ChppWifiNanSessionLostEvent *in,
     struct chreWifiNanSessionLostEvent *out) {
+  if (CHPP_WIFI_NAN_SESSION_LOST_EVENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->id = in->id;
   out->peerId = in->peerId;
 
@@ -933,6 +1079,11 @@ static bool chppWifiConvertNanSessionLostEventToChre(
 static bool chppWifiConvertNanSessionTerminatedEventToChre(
     const struct ChppWifiNanSessionTerminatedEvent *in,
     struct chreWifiNanSessionTerminatedEvent *out) {
+  if (CHPP_WIFI_NAN_SESSION_TERMINATED_EVENT_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->id = in->id;
   out->reason = in->reason;
   memcpy(out->reserved, in->reserved, sizeof(out->reserved));
@@ -943,6 +1094,11 @@ static bool chppWifiConvertNanSessionTerminatedEventToChre(
 static bool chppWifiConvertNanRangingParamsToChre(
     const struct ChppWifiNanRangingParams *in,
     struct chreWifiNanRangingParams *out) {
+  if (CHPP_WIFI_NAN_RANGING_PARAMS_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   memcpy(out->macAddress, in->macAddress, sizeof(out->macAddress));
 
   return true;
@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chpp/common/wifi_scan_stream.h"
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "chpp/common/wifi_types.h"
+#include "chpp/log.h"
+#include "chpp/macros.h"
+#include "chpp/memory.h"
+
+/************************************************
+ *  Prototypes
+ ***********************************************/
+
+static void chppCopyOverlappingRange(uint8_t *buf, size_t offset, size_t len,
+                                     const void *region, size_t regionOffset,
+                                     size_t regionLen);
+static void chppWifiScanEventEncode(void *encoderContext, size_t offset,
+                                    uint8_t *buf, size_t len);
+static void chppWifiScanEventEncoderRelease(void *encoderContext);
+
+/************************************************
+ *  Private Definitions
+ ***********************************************/
+
+#define CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(field)      \
+  (offsetof(struct ChppWifiScanResult, field) ==        \
+       offsetof(struct chreWifiScanResult, field) &&    \
+   sizeof(((struct ChppWifiScanResult *)NULL)->field) == \
+       sizeof(((struct chreWifiScanResult *)NULL)->field))
+
+// Scan results are copied as is between the CHRE and CHPP representations,
+// which is what allows them to be decoded in place.
+CHPP_STATIC_ASSERT(
+    sizeof(struct ChppWifiScanResult) == sizeof(struct chreWifiScanResult) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(ageMs) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(capabilityInfo) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(ssidLen) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(ssid) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(bssid) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(flags) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(rssi) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(band) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(primaryChannel) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(centerFreqPrimary) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(centerFreqSecondary) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(channelWidth) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(securityMode) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(radioChain) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(rssiChain0) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(rssiChain1) &&
+        CHPP_WIFI_SCAN_RESULT_FIELD_MATCHES(reserved),
+    "struct ChppWifiScanResult must match struct chreWifiScanResult");
+
+//! State of a scan event notification being sent.
+struct ChppWifiScanEventEncoderContext {
+  //! Fixed size part of the notification, followed on the wire by the scanned
+  //! frequencies and the results of the event.
+  struct ChppWifiScanEventWithHeader prefix;
+
+  struct chreWifiScanEvent *event;
+  ChppWifiScanEventReleaseFunction *releaseEvent;
+};
+
+//! A scan event decoded by chppWifiScanEventToChreInPlace().
+struct ChppWifiScanEventInPlace {
+  //! Must be the first member, see chppWifiScanEventInPlaceRelease().
+  struct chreWifiScanEvent event;
+
+  //! Backing storage of the scanned frequencies and results of the event.
+  void *data;
+
+  //! Set if data is a datagram kept from this transport layer instance.
+  struct ChppTransportState *transportContext;
+};
+
+static const struct ChppTxDatagramEncoder kWifiScanEventEncoder = {
+    .encode = chppWifiScanEventEncode,
+    .release = chppWifiScanEventEncoderRelease,
+};
+
+/************************************************
+ *  Private Functions
+ ***********************************************/
+
+/**
+ * Copies the part of a region of the datagram that is within the range of the
+ * datagram being encoded.
+ *
+ * @param buf Destination of the encoded range.
+ * @param offset Offset of the encoded range in the datagram.
+ * @param len Length of the encoded range in bytes.
+ * @param region Source data of the region.
+ * @param regionOffset Offset of the region in the datagram.
+ * @param regionLen Length of the region in bytes.
+ */
+static void chppCopyOverlappingRange(uint8_t *buf, size_t offset, size_t len,
+                                     const void *region, size_t regionOffset,
+                                     size_t regionLen) {
+  size_t start = MAX(offset, regionOffset);
+  size_t end = MIN(offset + len, regionOffset + regionLen);
+
+  if (start < end) {
+    const uint8_t *src = (const uint8_t *)region;
+    memcpy(&buf[start - offset], &src[start - regionOffset], end - start);
+  }
+}
+
+/**
+ * Encodes a range of a scan event notification, see struct
+ * ChppTxDatagramEncoder.
+ */
+static void chppWifiScanEventEncode(void *encoderContext, size_t offset,
+                                    uint8_t *buf, size_t len) {
+  const struct ChppWifiScanEventEncoderContext *context = encoderContext;
+  const struct chreWifiScanEvent *event = context->event;
+
+  size_t freqListOffset = sizeof(context->prefix);
+  size_t freqListLen = event->scannedFreqListLen * sizeof(uint32_t);
+  size_t resultsOffset = freqListOffset + freqListLen;
+
+  chppCopyOverlappingRange(buf, offset, len, &context->prefix, 0,
+                           sizeof(context->prefix));
+  chppCopyOverlappingRange(buf, offset, len, event->scannedFreqList,
+                           freqListOffset, freqListLen);
+
+  // Only the results overlapping the range are converted.
+  size_t end = offset + len;
+  size_t i = (offset > resultsOffset)
+                 ? (offset - resultsOffset) / sizeof(struct ChppWifiScanResult)
+                 : 0;
+  for (; i < event->resultCount; i++) {
+    size_t resultOffset = resultsOffset + i * sizeof(struct ChppWifiScanResult);
+    if (resultOffset >= end) {
+      break;
+    }
+
+    struct ChppWifiScanResult result;
+    memcpy(&result, &event->results[i], sizeof(result));
+    memset(&result.reserved, 0, sizeof(result.reserved));
+    chppCopyOverlappingRange(buf, offset, len, &result, resultOffset,
+                             sizeof(result));
+  }
+}
+
+/**
+ * Releases the scan event once its notification has been sent or discarded.
+ */
+static void chppWifiScanEventEncoderRelease(void *encoderContext) {
+  struct ChppWifiScanEventEncoderContext *context = encoderContext;
+
+  context->releaseEvent(context->event);
+  CHPP_FREE_AND_NULLIFY(context);
+}
+
+/************************************************
+ *  Public Functions
+ ***********************************************/
+
+bool chppWifiScanEventEnqueueOrFail(
+    struct ChppTransportState *transportContext,
+    const struct ChppAppHeader *header, struct chreWifiScanEvent *event,
+    ChppWifiScanEventReleaseFunction *releaseEvent) {
+  CHPP_NOT_NULL(event);
+  CHPP_NOT_NULL(releaseEvent);
+
+  struct ChppWifiScanEventEncoderContext *context =
+      chppMalloc(sizeof(struct ChppWifiScanEventEncoderContext));
+  if (context == NULL) {
+    CHPP_LOG_OOM();
+    releaseEvent(event);
+
+    // Still let the client know that a scan event was lost.
+    struct ChppAppHeader *notification = chppMalloc(sizeof(*notification));
+    if (notification == NULL) {
+      CHPP_LOG_OOM();
+    } else {
+      *notification = *header;
+      notification->error = CHPP_APP_ERROR_CONVERSION_FAILED;
+      chppEnqueueTxDatagramOrFail(transportContext, notification,
+                                  sizeof(*notification));
+    }
+    return false;
+  }
+
+  uint16_t freqListLen =
+      (uint16_t)(event->scannedFreqListLen * sizeof(uint32_t));
+  uint16_t resultsLen =
+      (uint16_t)(event->resultCount * sizeof(struct ChppWifiScanResult));
+
+  // Same layout as chppWifiScanEventFromChre(): offsets are relative to the
+  // ChppWifiScanEvent, and the variable length data follows it.
+  struct ChppWifiScanEvent *out = &context->prefix.payload;
+  context->prefix.header = *header;
+  out->version = CHRE_WIFI_SCAN_EVENT_VERSION;
+  out->resultCount = event->resultCount;
+  out->resultTotal = event->resultTotal;
+  out->eventIndex = event->eventIndex;
+  out->scanType = event->scanType;
+  out->ssidSetSize = event->ssidSetSize;
+  out->scannedFreqListLen = event->scannedFreqListLen;
+  out->referenceTime = event->referenceTime;
+  out->scannedFreqList.length = freqListLen;
+  out->scannedFreqList.offset =
+      (freqListLen > 0) ? (uint16_t)sizeof(struct ChppWifiScanEvent) : 0;
+  out->results.length = resultsLen;
+  out->results.offset =
+      (resultsLen > 0)
+          ? (uint16_t)(sizeof(struct ChppWifiScanEvent) + freqListLen)
+          : 0;
+  out->radioChainPref = event->radioChainPref;
+
+  context->event = event;
+  context->releaseEvent = releaseEvent;
+
+  return chppEnqueueTxEncodedDatagramOrFail(
+      transportContext, &kWifiScanEventEncoder, context,
+      sizeof(context->prefix) + freqListLen + resultsLen);
+}
+
+struct chreWifiScanEvent *chppWifiScanEventToChreInPlace(
+    struct ChppAppState *appContext, uint8_t *buf, size_t len) {
+  CHPP_NOT_NULL(appContext);
+  CHPP_NOT_NULL(buf);
+
+  if (len < sizeof(struct ChppWifiScanEventWithHeader)) {
+    return NULL;
+  }
+
+  const struct ChppWifiScanEvent *in =
+      (const struct ChppWifiScanEvent *)&buf[sizeof(struct ChppAppHeader)];
+  size_t inSize = len - sizeof(struct ChppAppHeader);
+  size_t freqListLen = in->scannedFreqList.length;
+  size_t resultsLen = in->results.length;
+
+  // Same checks as chppWifiScanEventToChre().
+  if (freqListLen > 0 &&
+      (in->scannedFreqList.offset + freqListLen > inSize ||
+       freqListLen != in->scannedFreqListLen * sizeof(uint32_t))) {
+    return NULL;
+  }
+  if (resultsLen > 0 &&
+      (in->results.offset + resultsLen > inSize ||
+       resultsLen != in->resultCount * sizeof(struct ChppWifiScanResult))) {
+    return NULL;
+  }
+
+  struct ChppWifiScanEventInPlace *inPlace =
+      chppMalloc(sizeof(struct ChppWifiScanEventInPlace));
+  if (inPlace == NULL) {
+    CHPP_LOG_OOM();
+    return NULL;
+  }
+
+  // The fixed size part is read before it can be overwritten below.
+  struct chreWifiScanEvent *out = &inPlace->event;
+  out->version = CHRE_WIFI_SCAN_EVENT_VERSION;
+  out->resultCount = in->resultCount;
+  out->resultTotal = in->resultTotal;
+  out->eventIndex = in->eventIndex;
+  out->scanType = in->scanType;
+  out->ssidSetSize = in->ssidSetSize;
+  out->scannedFreqListLen = in->scannedFreqListLen;
+  out->referenceTime = in->referenceTime;
+  out->radioChainPref = in->radioChainPref;
+  out->scannedFreqList = NULL;
+  out->results = NULL;
+  inPlace->data = NULL;
+  inPlace->transportContext = NULL;
+
+  const uint8_t *freqListIn =
+      &((const uint8_t *)in)[in->scannedFreqList.offset];
+  const uint8_t *resultsIn = &((const uint8_t *)in)[in->results.offset];
+
+  if (freqListLen + resultsLen > 0) {
+    // The scanned frequencies and results normally follow each other. They
+    // are then moved down to the beginning of the datagram, which is aligned,
+    // with the results right after the frequencies (4-byte aligned as well).
+    if (freqListLen == 0 || resultsLen == 0 ||
+        freqListIn + freqListLen <= resultsIn) {
+      inPlace->data = buf;
+      inPlace->transportContext = appContext->transportContext;
+      chppAppKeepRxDatagram(appContext);
+    } else {
+      inPlace->data = chppMalloc(freqListLen + resultsLen);
+      if (inPlace->data == NULL) {
+        CHPP_LOG_OOM();
+        CHPP_FREE_AND_NULLIFY(inPlace);
+        return NULL;
+      }
+    }
+
+    uint8_t *data = inPlace->data;
+    memmove(data, freqListIn, freqListLen);
+    memmove(&data[freqListLen], resultsIn, resultsLen);
+
+    if (freqListLen > 0) {
+      out->scannedFreqList = inPlace->data;
+    }
+    if (resultsLen > 0) {
+      void *resultsOut = &data[freqListLen];
+      struct chreWifiScanResult *results = resultsOut;
+      for (size_t i = 0; i < out->resultCount; i++) {
+        memset(&results[i].reserved, 0, sizeof(results[i].reserved));
+      }
+      out->results = results;
+    }
+  }
+
+  return out;
+}
+
+void chppWifiScanEventInPlaceRelease(struct chreWifiScanEvent *event) {
+  CHPP_NOT_NULL(event);
+
+  struct ChppWifiScanEventInPlace *inPlace =
+      (struct ChppWifiScanEventInPlace *)event;
+
+  if (inPlace->transportContext != NULL) {
+    chppDatagramProcessDoneCb(inPlace->transportContext, inPlace->data);
+  } else if (inPlace->data != NULL) {
+    CHPP_FREE_AND_NULLIFY(inPlace->data);
+  }
+  CHPP_FREE_AND_NULLIFY(inPlace);
+}
@@ -47,6 +47,11 @@ static size_t chppWwanSizeOfCellInfoResultFromChre(
 static void chppWwanConvertCellIdentityCdmaFromChre(
     const struct chreWwanCellIdentityCdma *in,
     struct ChppWwanCellIdentityCdma *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_CDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->networkId = in->networkId;
   out->systemId = in->systemId;
   out->basestationId = in->basestationId;
@@ -57,6 +62,11 @@ static void chppWwanConvertCellIdentityCdmaFromChre(
 static void chppWwanConvertSignalStrengthCdmaFromChre(
     const struct chreWwanSignalStrengthCdma *in,
     struct ChppWwanSignalStrengthCdma *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_CDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->dbm = in->dbm;
   out->ecio = in->ecio;
 }
@@ -64,6 +74,11 @@ static void chppWwanConvertSignalStrengthCdmaFromChre(
 static void chppWwanConvertSignalStrengthEvdoFromChre(
     const struct chreWwanSignalStrengthEvdo *in,
     struct ChppWwanSignalStrengthEvdo *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_EVDO_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->dbm = in->dbm;
   out->ecio = in->ecio;
   out->signalNoiseRatio = in->signalNoiseRatio;
@@ -71,6 +86,11 @@ static void chppWwanConvertSignalStrengthEvdoFromChre(
 
 static void chppWwanConvertCellInfoCdmaFromChre(
     const struct chreWwanCellInfoCdma *in, struct ChppWwanCellInfoCdma *out) {
+  if (CHPP_WWAN_CELL_INFO_CDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   chppWwanConvertCellIdentityCdmaFromChre(&in->cellIdentityCdma,
                                           &out->cellIdentityCdma);
   chppWwanConvertSignalStrengthCdmaFromChre(&in->signalStrengthCdma,
@@ -82,6 +102,12 @@ static void chppWwanConvertCellInfoCdmaFromChre(
 static void chppWwanConvertCellIdentityGsmFromChre(
     const struct chreWwanCellIdentityGsm *in,
     struct ChppWwanCellIdentityGsm *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_GSM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->lac = in->lac;
@@ -94,6 +120,11 @@ static void chppWwanConvertCellIdentityGsmFromChre(
 static void chppWwanConvertSignalStrengthGsmFromChre(
     const struct chreWwanSignalStrengthGsm *in,
     struct ChppWwanSignalStrengthGsm *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_GSM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->signalStrength = in->signalStrength;
   out->bitErrorRate = in->bitErrorRate;
   out->timingAdvance = in->timingAdvance;
@@ -101,6 +132,13 @@ static void chppWwanConvertSignalStrengthGsmFromChre(
 
 static void chppWwanConvertCellInfoGsmFromChre(
     const struct chreWwanCellInfoGsm *in, struct ChppWwanCellInfoGsm *out) {
+  if (CHPP_WWAN_CELL_INFO_GSM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->cellIdentityGsm.reserved, 0,
+           sizeof(out->cellIdentityGsm.reserved));
+    return;
+  }
+
   chppWwanConvertCellIdentityGsmFromChre(&in->cellIdentityGsm,
                                          &out->cellIdentityGsm);
   chppWwanConvertSignalStrengthGsmFromChre(&in->signalStrengthGsm,
@@ -110,6 +148,11 @@ static void chppWwanConvertCellInfoGsmFromChre(
 static void chppWwanConvertCellIdentityLteFromChre(
     const struct chreWwanCellIdentityLte *in,
     struct ChppWwanCellIdentityLte *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_LTE_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->ci = in->ci;
@@ -121,6 +164,11 @@ static void chppWwanConvertCellIdentityLteFromChre(
 static void chppWwanConvertSignalStrengthLteFromChre(
     const struct chreWwanSignalStrengthLte *in,
     struct ChppWwanSignalStrengthLte *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_LTE_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->signalStrength = in->signalStrength;
   out->rsrp = in->rsrp;
   out->rsrq = in->rsrq;
@@ -131,6 +179,11 @@ static void chppWwanConvertSignalStrengthLteFromChre(
 
 static void chppWwanConvertCellInfoLteFromChre(
     const struct chreWwanCellInfoLte *in, struct ChppWwanCellInfoLte *out) {
+  if (CHPP_WWAN_CELL_INFO_LTE_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   chppWwanConvertCellIdentityLteFromChre(&in->cellIdentityLte,
                                          &out->cellIdentityLte);
   chppWwanConvertSignalStrengthLteFromChre(&in->signalStrengthLte,
@@ -140,6 +193,11 @@ static void chppWwanConvertCellInfoLteFromChre(
 static void chppWwanConvertCellIdentityNrFromChre(
     const struct chreWwanCellIdentityNr *in,
     struct ChppWwanCellIdentityNr *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_NR_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->nci0 = in->nci0;
@@ -152,6 +210,11 @@ static void chppWwanConvertCellIdentityNrFromChre(
 static void chppWwanConvertSignalStrengthNrFromChre(
     const struct chreWwanSignalStrengthNr *in,
     struct ChppWwanSignalStrengthNr *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_NR_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->ssRsrp = in->ssRsrp;
   out->ssRsrq = in->ssRsrq;
   out->ssSinr = in->ssSinr;
@@ -162,6 +225,11 @@ static void chppWwanConvertSignalStrengthNrFromChre(
 
 static void chppWwanConvertCellInfoNrFromChre(
     const struct chreWwanCellInfoNr *in, struct ChppWwanCellInfoNr *out) {
+  if (CHPP_WWAN_CELL_INFO_NR_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   chppWwanConvertCellIdentityNrFromChre(&in->cellIdentityNr,
                                         &out->cellIdentityNr);
   chppWwanConvertSignalStrengthNrFromChre(&in->signalStrengthNr,
@@ -171,6 +239,11 @@ static void chppWwanConvertCellInfoNrFromChre(
 static void chppWwanConvertCellIdentityTdscdmaFromChre(
     const struct chreWwanCellIdentityTdscdma *in,
     struct ChppWwanCellIdentityTdscdma *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_TDSCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->lac = in->lac;
@@ -181,12 +254,22 @@ static void chppWwanConvertCellIdentityTdscdmaFromChre(
 static void chppWwanConvertSignalStrengthTdscdmaFromChre(
     const struct chreWwanSignalStrengthTdscdma *in,
     struct ChppWwanSignalStrengthTdscdma *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_TDSCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->rscp = in->rscp;
 }
 
 static void chppWwanConvertCellInfoTdscdmaFromChre(
     const struct chreWwanCellInfoTdscdma *in,
     struct ChppWwanCellInfoTdscdma *out) {
+  if (CHPP_WWAN_CELL_INFO_TDSCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   chppWwanConvertCellIdentityTdscdmaFromChre(&in->cellIdentityTdscdma,
                                              &out->cellIdentityTdscdma);
   chppWwanConvertSignalStrengthTdscdmaFromChre(&in->signalStrengthTdscdma,
@@ -196,6 +279,11 @@ static void chppWwanConvertCellInfoTdscdmaFromChre(
 static void chppWwanConvertCellIdentityWcdmaFromChre(
     const struct chreWwanCellIdentityWcdma *in,
     struct ChppWwanCellIdentityWcdma *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_WCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->lac = in->lac;
@@ -207,12 +295,22 @@ static void chppWwanConvertCellIdentityWcdmaFromChre(
 static void chppWwanConvertSignalStrengthWcdmaFromChre(
     const struct chreWwanSignalStrengthWcdma *in,
     struct ChppWwanSignalStrengthWcdma *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_WCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   out->signalStrength = in->signalStrength;
   out->bitErrorRate = in->bitErrorRate;
 }
 
 static void chppWwanConvertCellInfoWcdmaFromChre(
     const struct chreWwanCellInfoWcdma *in, struct ChppWwanCellInfoWcdma *out) {
+  if (CHPP_WWAN_CELL_INFO_WCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return;
+  }
+
   chppWwanConvertCellIdentityWcdmaFromChre(&in->cellIdentityWcdma,
                                            &out->cellIdentityWcdma);
   chppWwanConvertSignalStrengthWcdmaFromChre(&in->signalStrengthWcdma,
@@ -305,6 +403,11 @@ bool chppWwanCellInfoResultFromChre(
 static bool chppWwanConvertCellIdentityCdmaToChre(
     const struct ChppWwanCellIdentityCdma *in,
     struct chreWwanCellIdentityCdma *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_CDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->networkId = in->networkId;
   out->systemId = in->systemId;
   out->basestationId = in->basestationId;
@@ -317,6 +420,11 @@ static bool chppWwanConvertCellIdentityCdmaToChre(
 static bool chppWwanConvertSignalStrengthCdmaToChre(
     const struct ChppWwanSignalStrengthCdma *in,
     struct chreWwanSignalStrengthCdma *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_CDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->dbm = in->dbm;
   out->ecio = in->ecio;
 
@@ -326,6 +434,11 @@ static bool chppWwanConvertSignalStrengthCdmaToChre(
 static bool chppWwanConvertSignalStrengthEvdoToChre(
     const struct ChppWwanSignalStrengthEvdo *in,
     struct chreWwanSignalStrengthEvdo *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_EVDO_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->dbm = in->dbm;
   out->ecio = in->ecio;
   out->signalNoiseRatio = in->signalNoiseRatio;
@@ -335,6 +448,11 @@ static bool chppWwanConvertSignalStrengthEvdoToChre(
 
 static bool chppWwanConvertCellInfoCdmaToChre(
     const struct ChppWwanCellInfoCdma *in, struct chreWwanCellInfoCdma *out) {
+  if (CHPP_WWAN_CELL_INFO_CDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   if (!chppWwanConvertCellIdentityCdmaToChre(&in->cellIdentityCdma,
                                              &out->cellIdentityCdma)) {
     return false;
@@ -354,6 +472,12 @@ static bool chppWwanConvertCellInfoCdmaToChre(
 static bool chppWwanConvertCellIdentityGsmToChre(
     const struct ChppWwanCellIdentityGsm *in,
     struct chreWwanCellIdentityGsm *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_GSM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->reserved, 0, sizeof(out->reserved));
+    return true;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->lac = in->lac;
@@ -368,6 +492,11 @@ static bool chppWwanConvertCellIdentityGsmToChre(
 static bool chppWwanConvertSignalStrengthGsmToChre(
     const struct ChppWwanSignalStrengthGsm *in,
     struct chreWwanSignalStrengthGsm *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_GSM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->signalStrength = in->signalStrength;
   out->bitErrorRate = in->bitErrorRate;
   out->timingAdvance = in->timingAdvance;
@@ -377,6 +506,13 @@ static bool chppWwanConvertSignalStrengthGsmToChre(
 
 static bool chppWwanConvertCellInfoGsmToChre(
     const struct ChppWwanCellInfoGsm *in, struct chreWwanCellInfoGsm *out) {
+  if (CHPP_WWAN_CELL_INFO_GSM_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    memset(&out->cellIdentityGsm.reserved, 0,
+           sizeof(out->cellIdentityGsm.reserved));
+    return true;
+  }
+
   if (!chppWwanConvertCellIdentityGsmToChre(&in->cellIdentityGsm,
                                             &out->cellIdentityGsm)) {
     return false;
@@ -392,6 +528,11 @@ static bool chppWwanConvertCellInfoGsmToChre(
 static bool chppWwanConvertCellIdentityLteToChre(
     const struct ChppWwanCellIdentityLte *in,
     struct chreWwanCellIdentityLte *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_LTE_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->ci = in->ci;
@@ -405,6 +546,11 @@ static bool chppWwanConvertCellIdentityLteToChre(
 static bool chppWwanConvertSignalStrengthLteToChre(
     const struct ChppWwanSignalStrengthLte *in,
     struct chreWwanSignalStrengthLte *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_LTE_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->signalStrength = in->signalStrength;
   out->rsrp = in->rsrp;
   out->rsrq = in->rsrq;
@@ -417,6 +563,11 @@ static bool chppWwanConvertSignalStrengthLteToChre(
 
 static bool chppWwanConvertCellInfoLteToChre(
     const struct ChppWwanCellInfoLte *in, struct chreWwanCellInfoLte *out) {
+  if (CHPP_WWAN_CELL_INFO_LTE_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   if (!chppWwanConvertCellIdentityLteToChre(&in->cellIdentityLte,
                                             &out->cellIdentityLte)) {
     return false;
@@ -432,6 +583,11 @@ static bool chppWwanConvertCellInfoLteToChre(
 static bool chppWwanConvertCellIdentityNrToChre(
     const struct ChppWwanCellIdentityNr *in,
     struct chreWwanCellIdentityNr *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_NR_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->nci0 = in->nci0;
@@ -446,6 +602,11 @@ static bool chppWwanConvertCellIdentityNrToChre(
 static bool chppWwanConvertSignalStrengthNrToChre(
     const struct ChppWwanSignalStrengthNr *in,
     struct chreWwanSignalStrengthNr *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_NR_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->ssRsrp = in->ssRsrp;
   out->ssRsrq = in->ssRsrq;
   out->ssSinr = in->ssSinr;
@@ -458,6 +619,11 @@ static bool chppWwanConvertSignalStrengthNrToChre(
 
 static bool chppWwanConvertCellInfoNrToChre(const struct ChppWwanCellInfoNr *in,
                                             struct chreWwanCellInfoNr *out) {
+  if (CHPP_WWAN_CELL_INFO_NR_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   if (!chppWwanConvertCellIdentityNrToChre(&in->cellIdentityNr,
                                            &out->cellIdentityNr)) {
     return false;
@@ -473,6 +639,11 @@ static bool chppWwanConvertCellInfoNrToChre(const struct ChppWwanCellInfoNr *in,
 static bool chppWwanConvertCellIdentityTdscdmaToChre(
     const struct ChppWwanCellIdentityTdscdma *in,
     struct chreWwanCellIdentityTdscdma *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_TDSCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->lac = in->lac;
@@ -485,6 +656,11 @@ static bool chppWwanConvertCellIdentityTdscdmaToChre(
 static bool chppWwanConvertSignalStrengthTdscdmaToChre(
     const struct ChppWwanSignalStrengthTdscdma *in,
     struct chreWwanSignalStrengthTdscdma *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_TDSCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->rscp = in->rscp;
 
   return true;
@@ -493,6 +669,11 @@ static bool chppWwanConvertSignalStrengthTdscdmaToChre(
 static bool chppWwanConvertCellInfoTdscdmaToChre(
     const struct ChppWwanCellInfoTdscdma *in,
     struct chreWwanCellInfoTdscdma *out) {
+  if (CHPP_WWAN_CELL_INFO_TDSCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   if (!chppWwanConvertCellIdentityTdscdmaToChre(&in->cellIdentityTdscdma,
                                                 &out->cellIdentityTdscdma)) {
     return false;
@@ -508,6 +689,11 @@ static bool chppWwanConvertCellInfoTdscdmaToChre(
 static bool chppWwanConvertCellIdentityWcdmaToChre(
     const struct ChppWwanCellIdentityWcdma *in,
     struct chreWwanCellIdentityWcdma *out) {
+  if (CHPP_WWAN_CELL_IDENTITY_WCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->mcc = in->mcc;
   out->mnc = in->mnc;
   out->lac = in->lac;
@@ -521,6 +707,11 @@ static bool chppWwanConvertCellIdentityWcdmaToChre(
 static bool chppWwanConvertSignalStrengthWcdmaToChre(
     const struct ChppWwanSignalStrengthWcdma *in,
     struct chreWwanSignalStrengthWcdma *out) {
+  if (CHPP_WWAN_SIGNAL_STRENGTH_WCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   out->signalStrength = in->signalStrength;
   out->bitErrorRate = in->bitErrorRate;
 
@@ -529,6 +720,11 @@ static bool chppWwanConvertSignalStrengthWcdmaToChre(
 
 static bool chppWwanConvertCellInfoWcdmaToChre(
     const struct ChppWwanCellInfoWcdma *in, struct chreWwanCellInfoWcdma *out) {
+  if (CHPP_WWAN_CELL_INFO_WCDMA_MATCHES_CHRE_LAYOUT) {
+    memcpy(out, in, sizeof(*out));
+    return true;
+  }
+
   if (!chppWwanConvertCellIdentityWcdmaToChre(&in->cellIdentityWcdma,
                                               &out->cellIdentityWcdma)) {
     return false;
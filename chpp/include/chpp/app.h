@@ -559,6 +559,10 @@ struct ChppAppState {
 
   struct ChppMutex discoveryMutex;
   struct ChppConditionVariable discoveryCv;
+
+  // Set when the endpoint processing the current Rx datagram keeps it, see
+  // chppAppKeepRxDatagram().
+  bool isRxDatagramKept;
 };
 
 #define CHPP_SERVICE_INDEX_OF_HANDLE(handle) \
@@ -616,6 +620,18 @@ void chppAppDeinit(struct ChppAppState *appContext);
 void chppAppProcessRxDatagram(struct ChppAppState *context, uint8_t *buf,
                               size_t len);
 
+/**
+ * Keeps the Rx datagram currently being dispatched to an endpoint, so that the
+ * endpoint can use it (e.g. decode it in place) after its dispatch function
+ * returns. The datagram is otherwise released as soon as it is dispatched.
+ *
+ * Must only be called from a dispatch function. The endpoint must then pass the
+ * datagram to chppDatagramProcessDoneCb() once it is done with it.
+ *
+ * @param context Maintains status for each app layer instance.
+ */
+void chppAppKeepRxDatagram(struct ChppAppState *context);
+
 /**
  * Used by the transport layer to notify the app layer of a reset during
  * operation. This function is called after the transport layer has sent a reset
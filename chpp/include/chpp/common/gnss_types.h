@@ -111,6 +111,24 @@ struct ChppGnssLocationEventWithHeader {
 
 CHPP_PACKED_END
 
+// Layout compatibility with the CHRE types, evaluated at compile time. Types
+// with the same layout are converted with bulk copies.
+
+//! Whether struct ChppGnssClock has the same layout as
+//! struct chreGnssClock
+#define CHPP_GNSS_CLOCK_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppGnssClock) == sizeof(struct chreGnssClock))
+
+//! Whether struct ChppGnssMeasurement has the same layout as
+//! struct chreGnssMeasurement
+#define CHPP_GNSS_MEASUREMENT_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppGnssMeasurement) == sizeof(struct chreGnssMeasurement))
+
+//! Whether struct ChppGnssLocationEvent has the same layout as
+//! struct chreGnssLocationEvent
+#define CHPP_GNSS_LOCATION_EVENT_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppGnssLocationEvent) == sizeof(struct chreGnssLocationEvent))
+
 // Encoding functions (CHRE --> CHPP)
 
 /**
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHPP_WIFI_SCAN_STREAM_H_
+#define CHPP_WIFI_SCAN_STREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "chpp/app.h"
+#include "chpp/transport.h"
+#include "chre_api/chre/wifi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Releases a WiFi scan event once it has been sent, e.g. the releaseScanEvent()
+ * function of the WiFi PAL.
+ */
+typedef void(ChppWifiScanEventReleaseFunction)(struct chreWifiScanEvent *event);
+
+/**
+ * Enqueues a WiFi scan event notification without converting it to a
+ * ChppWifiScanEventWithHeader first: the notification is serialized packet by
+ * packet, straight into the transport layer Tx buffer. Its wire format is the
+ * one produced by chppWifiScanEventFromChre().
+ *
+ * Note that the ownership of event is taken from the caller when this method
+ * is invoked: it is passed to releaseEvent once the notification has been sent,
+ * or if it could not be enqueued.
+ *
+ * If the notification can't be allocated, a header-only notification with a
+ * CHPP_APP_ERROR_CONVERSION_FAILED error is sent instead, like when
+ * chppWifiScanEventFromChre() fails.
+ *
+ * @param transportContext Maintains state for each transport layer instance.
+ * @param header App layer header of the notification.
+ * @param event The scan event to be sent. Cannot be null.
+ * @param releaseEvent Releases the scan event. Cannot be null.
+ *
+ * @return True if the notification was enqueued.
+ */
+bool chppWifiScanEventEnqueueOrFail(
+    struct ChppTransportState *transportContext,
+    const struct ChppAppHeader *header, struct chreWifiScanEvent *event,
+    ChppWifiScanEventReleaseFunction *releaseEvent);
+
+/**
+ * Converts a WiFi scan event notification to a chreWifiScanEvent without
+ * copying its scanned frequencies and results: these are moved in place, to
+ * the beginning of the datagram, and the returned event points to them. The
+ * datagram is then kept (see chppAppKeepRxDatagram()) until the event is
+ * released through chppWifiScanEventInPlaceRelease().
+ *
+ * Must be called from the dispatch function the datagram was passed to.
+ *
+ * @param appContext Maintains status for each app layer instance.
+ * @param buf The notification, including its app layer header. Cannot be null.
+ * @param len Length of the notification in bytes.
+ *
+ * @return The scan event, or null if the notification is malformed or memory
+ * could not be allocated.
+ */
+struct chreWifiScanEvent *chppWifiScanEventToChreInPlace(
+    struct ChppAppState *appContext, uint8_t *buf, size_t len);
+
+/**
+ * Releases an event returned by chppWifiScanEventToChreInPlace(), along with
+ * the datagram it points into.
+ *
+ * @param event The event to be released. Cannot be null.
+ */
+void chppWifiScanEventInPlaceRelease(struct chreWifiScanEvent *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // CHPP_WIFI_SCAN_STREAM_H_
@@ -244,6 +244,52 @@ struct ChppWifiNanRangingParamsWithHeader {
 
 CHPP_PACKED_END
 
+// Layout compatibility with the CHRE types, evaluated at compile time. Types
+// with the same layout are converted with bulk copies.
+
+//! Whether struct ChppWifiNanRangingParams has the same layout as
+//! struct chreWifiNanRangingParams
+#define CHPP_WIFI_NAN_RANGING_PARAMS_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiNanRangingParams) ==            \
+   sizeof(struct chreWifiNanRangingParams))
+
+//! Whether struct ChppWifiNanSessionLostEvent has the same layout as
+//! struct chreWifiNanSessionLostEvent
+#define CHPP_WIFI_NAN_SESSION_LOST_EVENT_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiNanSessionLostEvent) ==             \
+   sizeof(struct chreWifiNanSessionLostEvent))
+
+//! Whether struct ChppWifiNanSessionTerminatedEvent has the same layout as
+//! struct chreWifiNanSessionTerminatedEvent
+#define CHPP_WIFI_NAN_SESSION_TERMINATED_EVENT_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiNanSessionTerminatedEvent) ==             \
+   sizeof(struct chreWifiNanSessionTerminatedEvent))
+
+//! Whether struct ChppWifiLci has the same layout as
+//! struct chreWifiLci
+#define CHPP_WIFI_LCI_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiLci) == sizeof(struct chreWifiLci))
+
+//! Whether struct ChppWifiRangingResult has the same layout as
+//! struct chreWifiRangingResult
+#define CHPP_WIFI_RANGING_RESULT_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiRangingResult) == sizeof(struct chreWifiRangingResult))
+
+//! Whether struct ChppWifiRangingTarget has the same layout as
+//! struct chreWifiRangingTarget
+#define CHPP_WIFI_RANGING_TARGET_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiRangingTarget) == sizeof(struct chreWifiRangingTarget))
+
+//! Whether struct ChppWifiScanResult has the same layout as
+//! struct chreWifiScanResult
+#define CHPP_WIFI_SCAN_RESULT_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiScanResult) == sizeof(struct chreWifiScanResult))
+
+//! Whether struct ChppWifiSsidListItem has the same layout as
+//! struct chreWifiSsidListItem
+#define CHPP_WIFI_SSID_LIST_ITEM_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWifiSsidListItem) == sizeof(struct chreWifiSsidListItem))
+
 // Encoding functions (CHRE --> CHPP)
 
 /**
@@ -227,6 +227,118 @@ struct ChppWwanCellInfoResultWithHeader {
 
 CHPP_PACKED_END
 
+// Layout compatibility with the CHRE types, evaluated at compile time. Types
+// with the same layout are converted with bulk copies.
+
+//! Whether struct ChppWwanCellIdentityCdma has the same layout as
+//! struct chreWwanCellIdentityCdma
+#define CHPP_WWAN_CELL_IDENTITY_CDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellIdentityCdma) ==            \
+   sizeof(struct chreWwanCellIdentityCdma))
+
+//! Whether struct ChppWwanSignalStrengthCdma has the same layout as
+//! struct chreWwanSignalStrengthCdma
+#define CHPP_WWAN_SIGNAL_STRENGTH_CDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanSignalStrengthCdma) ==            \
+   sizeof(struct chreWwanSignalStrengthCdma))
+
+//! Whether struct ChppWwanSignalStrengthEvdo has the same layout as
+//! struct chreWwanSignalStrengthEvdo
+#define CHPP_WWAN_SIGNAL_STRENGTH_EVDO_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanSignalStrengthEvdo) ==            \
+   sizeof(struct chreWwanSignalStrengthEvdo))
+
+//! Whether struct ChppWwanCellInfoCdma has the same layout as
+//! struct chreWwanCellInfoCdma
+#define CHPP_WWAN_CELL_INFO_CDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellInfoCdma) == sizeof(struct chreWwanCellInfoCdma))
+
+//! Whether struct ChppWwanCellIdentityGsm has the same layout as
+//! struct chreWwanCellIdentityGsm
+#define CHPP_WWAN_CELL_IDENTITY_GSM_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellIdentityGsm) ==            \
+   sizeof(struct chreWwanCellIdentityGsm))
+
+//! Whether struct ChppWwanSignalStrengthGsm has the same layout as
+//! struct chreWwanSignalStrengthGsm
+#define CHPP_WWAN_SIGNAL_STRENGTH_GSM_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanSignalStrengthGsm) ==            \
+   sizeof(struct chreWwanSignalStrengthGsm))
+
+//! Whether struct ChppWwanCellInfoGsm has the same layout as
+//! struct chreWwanCellInfoGsm
+#define CHPP_WWAN_CELL_INFO_GSM_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellInfoGsm) == sizeof(struct chreWwanCellInfoGsm))
+
+//! Whether struct ChppWwanCellIdentityLte has the same layout as
+//! struct chreWwanCellIdentityLte
+#define CHPP_WWAN_CELL_IDENTITY_LTE_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellIdentityLte) ==            \
+   sizeof(struct chreWwanCellIdentityLte))
+
+//! Whether struct ChppWwanSignalStrengthLte has the same layout as
+//! struct chreWwanSignalStrengthLte
+#define CHPP_WWAN_SIGNAL_STRENGTH_LTE_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanSignalStrengthLte) ==            \
+   sizeof(struct chreWwanSignalStrengthLte))
+
+//! Whether struct ChppWwanCellInfoLte has the same layout as
+//! struct chreWwanCellInfoLte
+#define CHPP_WWAN_CELL_INFO_LTE_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellInfoLte) == sizeof(struct chreWwanCellInfoLte))
+
+//! Whether struct ChppWwanCellIdentityNr has the same layout as
+//! struct chreWwanCellIdentityNr
+#define CHPP_WWAN_CELL_IDENTITY_NR_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellIdentityNr) ==            \
+   sizeof(struct chreWwanCellIdentityNr))
+
+//! Whether struct ChppWwanSignalStrengthNr has the same layout as
+//! struct chreWwanSignalStrengthNr
+#define CHPP_WWAN_SIGNAL_STRENGTH_NR_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanSignalStrengthNr) ==            \
+   sizeof(struct chreWwanSignalStrengthNr))
+
+//! Whether struct ChppWwanCellInfoNr has the same layout as
+//! struct chreWwanCellInfoNr
+#define CHPP_WWAN_CELL_INFO_NR_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellInfoNr) == sizeof(struct chreWwanCellInfoNr))
+
+//! Whether struct ChppWwanCellIdentityTdscdma has the same layout as
+//! struct chreWwanCellIdentityTdscdma
+#define CHPP_WWAN_CELL_IDENTITY_TDSCDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellIdentityTdscdma) ==            \
+   sizeof(struct chreWwanCellIdentityTdscdma))
+
+//! Whether struct ChppWwanSignalStrengthTdscdma has the same layout as
+//! struct chreWwanSignalStrengthTdscdma
+#define CHPP_WWAN_SIGNAL_STRENGTH_TDSCDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanSignalStrengthTdscdma) ==            \
+   sizeof(struct chreWwanSignalStrengthTdscdma))
+
+//! Whether struct ChppWwanCellInfoTdscdma has the same layout as
+//! struct chreWwanCellInfoTdscdma
+#define CHPP_WWAN_CELL_INFO_TDSCDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellInfoTdscdma) ==            \
+   sizeof(struct chreWwanCellInfoTdscdma))
+
+//! Whether struct ChppWwanCellIdentityWcdma has the same layout as
+//! struct chreWwanCellIdentityWcdma
+#define CHPP_WWAN_CELL_IDENTITY_WCDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellIdentityWcdma) ==            \
+   sizeof(struct chreWwanCellIdentityWcdma))
+
+//! Whether struct ChppWwanSignalStrengthWcdma has the same layout as
+//! struct chreWwanSignalStrengthWcdma
+#define CHPP_WWAN_SIGNAL_STRENGTH_WCDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanSignalStrengthWcdma) ==            \
+   sizeof(struct chreWwanSignalStrengthWcdma))
+
+//! Whether struct ChppWwanCellInfoWcdma has the same layout as
+//! struct chreWwanCellInfoWcdma
+#define CHPP_WWAN_CELL_INFO_WCDMA_MATCHES_CHRE_LAYOUT \
+  (sizeof(struct ChppWwanCellInfoWcdma) == sizeof(struct chreWwanCellInfoWcdma))
+
 // Encoding functions (CHRE --> CHPP)
 
 /**
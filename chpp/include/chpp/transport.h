@@ -368,6 +368,22 @@ struct ChppTxStatus {
   bool linkBusy;
 };
 
+/**
+ * Serializes the payload of an outgoing datagram on demand, directly into the
+ * link Tx buffer, so that the datagram never needs to be allocated as a whole.
+ * See chppEnqueueTxEncodedDatagramOrFail().
+ */
+struct ChppTxDatagramEncoder {
+  //! Writes len bytes of the datagram, starting at offset, to buf. The same
+  //! range may be encoded more than once, e.g. if a packet is retransmitted.
+  void (*encode)(void *encoderContext, size_t offset, uint8_t *buf, size_t len);
+
+  //! Releases encoderContext once the datagram has been sent or discarded.
+  //! May be called with the transport mutex held, so it must not call back
+  //! into the transport layer.
+  void (*release)(void *encoderContext);
+};
+
 struct ChppDatagram {
   //! Length of datagram payload in bytes (A datagram can be constituted from
   //! one or more packets)
@@ -375,6 +391,11 @@ struct ChppDatagram {
 
   // Datagram payload
   uint8_t *payload;
+
+  //! If not null, the payload of this (Tx) datagram is produced by the encoder
+  //! instead of being read from payload.
+  const struct ChppTxDatagramEncoder *encoder;
+  void *encoderContext;
 };
 
 struct ChppTxDatagramQueue {
@@ -526,6 +547,32 @@ void chppRxPacketCompleteCb(struct ChppTransportState *context);
 bool chppEnqueueTxDatagramOrFail(struct ChppTransportState *context, void *buf,
                                  size_t len);
 
+/**
+ * Same as chppEnqueueTxDatagramOrFail(), but the payload is serialized by an
+ * encoder as it is packetized rather than being provided as a buffer. This
+ * avoids allocating and filling a copy of large datagrams before they are
+ * sent.
+ *
+ * The first sizeof(struct ChppAppHeader) bytes produced by the encoder must be
+ * the app layer header.
+ *
+ * Note that the ownership of encoderContext is taken from the caller when this
+ * method is invoked: encoder->release() is called once the datagram has been
+ * sent, or if enqueueing it is unsuccessful.
+ *
+ * @param context Maintains state for each transport layer instance.
+ * @param encoder Encoder of the datagram payload. Cannot be null.
+ * @param encoderContext Passed to the encoder functions.
+ * @param len Datagram length in bytes.
+ *
+ * @return True informs the sender that the datagram was successfully enqueued.
+ * False informs the sender that the queue was full and the datagram discarded.
+ */
+bool chppEnqueueTxEncodedDatagramOrFail(
+    struct ChppTransportState *context,
+    const struct ChppTxDatagramEncoder *encoder, void *encoderContext,
+    size_t len);
+
 /**
  * Enables the App Layer to enqueue an outgoing error datagram, for example for
  * an OOM situation over the wire.
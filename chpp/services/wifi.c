@@ -22,6 +22,7 @@
 
 #include "chpp/common/standard_uuids.h"
 #include "chpp/common/wifi.h"
+#include "chpp/common/wifi_scan_stream.h"
 #include "chpp/common/wifi_types.h"
 #include "chpp/common/wifi_utils.h"
 #include "chpp/log.h"
@@ -736,41 +737,25 @@ static void chppWifiServiceScanResponseCallback(bool pending,
  * @param event Scan result data.
  */
 static void chppWifiServiceScanEventCallback(struct chreWifiScanEvent *event) {
-  // Craft response per parser script
-  struct ChppWifiScanEventWithHeader *notification = NULL;
-  size_t notificationLen = 0;
-
   CHPP_DEBUG_ASSERT(chppCheckWifiScanEventNotification(event));
 
-  if (!chppWifiScanEventFromChre(event, &notification, &notificationLen)) {
-    CHPP_LOGE("ScanEvent conversion failed (OOM?). ID=%" PRIu8,
-              gWifiServiceContext.requestScanAsync.transaction);
-
-    notification = chppMalloc(sizeof(struct ChppAppHeader));
-    if (notification == NULL) {
-      CHPP_LOG_OOM();
-    } else {
-      notificationLen = sizeof(struct ChppAppHeader);
-    }
-  }
-
-  if (notification != NULL) {
-    notification->header.handle = gWifiServiceContext.service.handle;
-    notification->header.type = CHPP_MESSAGE_TYPE_SERVICE_NOTIFICATION;
-    notification->header.transaction =
-        gWifiServiceContext.requestScanAsync.transaction;
-    notification->header.error =
-        (notificationLen > sizeof(struct ChppAppHeader))
-            ? CHPP_APP_ERROR_NONE
-            : CHPP_APP_ERROR_CONVERSION_FAILED;
-    notification->header.command = CHPP_WIFI_REQUEST_SCAN_ASYNC;
+  const struct ChppAppHeader header = {
+      .handle = gWifiServiceContext.service.handle,
+      .type = CHPP_MESSAGE_TYPE_SERVICE_NOTIFICATION,
+      .transaction = gWifiServiceContext.requestScanAsync.transaction,
+      .error = CHPP_APP_ERROR_NONE,
+      .command = CHPP_WIFI_REQUEST_SCAN_ASYNC,
+  };
 
-    chppEnqueueTxDatagramOrFail(
-        gWifiServiceContext.service.appContext->transportContext, notification,
-        notificationLen);
+  // The event is serialized as it is sent, rather than converted to a
+  // ChppWifiScanEventWithHeader up front, and released once it has been sent.
+  // If it can't be enqueued, the client gets a header-only notification with a
+  // CHPP_APP_ERROR_CONVERSION_FAILED error when memory allows.
+  if (!chppWifiScanEventEnqueueOrFail(
+          gWifiServiceContext.service.appContext->transportContext, &header,
+          event, gWifiServiceContext.api->releaseScanEvent)) {
+    CHPP_LOGE("ScanEvent enqueue failed. ID=%" PRIu8, header.transaction);
   }
-
-  gWifiServiceContext.api->releaseScanEvent(event);
 }
 
 /**
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file was automatically generated by chpp_code_generator.py
+// Date: 2026-10-18 15:20:03 UTC
+// Source: chre_api/include/chre_api/chre/gnss.h @ commit 9bc36aa9b
+
+// DO NOT modify this file directly, as those changes will be lost the next
+// time the script is executed
+
+#include <gtest/gtest.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "chpp/app.h"
+#include "chpp/common/gnss_types.h"
+#include "chpp/macros.h"
+#include "chpp/memory.h"
+
+namespace {
+
+//! Seed of the random generator, fixed to make failures reproducible
+constexpr std::mt19937::result_type kSeed = 0x5eed;
+
+//! Number of random structures converted back and forth per root structure
+constexpr size_t kNumRoundTrips = 200;
+
+//! Maximum number of elements of the random variable-length arrays and strings
+constexpr size_t kMaxRandomLength = 8;
+
+//! Number of conversions timed per root structure by the benchmarks
+constexpr size_t kNumBenchmarkIterations = 10000;
+
+//! Expects a field to be bitwise identical in both structures, which also holds
+//! for floating-point NaNs
+#define EXPECT_SAME_FIELD(expected, actual, field)          \
+  EXPECT_EQ(std::memcmp(&(expected).field, &(actual).field, \
+                        sizeof((expected).field)),          \
+            0)                                              \
+      << #field
+
+void fillRandomBytes(std::mt19937 &rng, void *data, size_t size) {
+  auto *bytes = static_cast<uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    bytes[i] = static_cast<uint8_t>(rng());
+  }
+}
+
+//! Fills a field of a primitive type, overloaded below for the structures
+template <typename T>
+void fillRandom(std::mt19937 &rng, T *value) {
+  fillRandomBytes(rng, value, sizeof(*value));
+}
+
+//! @return The number of elements of a random variable-length array
+size_t randomLength(std::mt19937 &rng) {
+  return rng() % (kMaxRandomLength + 1);
+}
+
+//! @return One of the given values, e.g. of a union discriminator
+template <typename T, size_t N>
+T randomElement(std::mt19937 &rng, const T (&values)[N]) {
+  return values[rng() % N];
+}
+
+//! Expects the first count elements of both arrays to be bitwise identical
+template <typename T>
+void expectSameArray(const T *expected, const T *actual, size_t count) {
+  if (count > 0) {
+    EXPECT_EQ(std::memcmp(expected, actual, count * sizeof(T)), 0);
+  }
+}
+
+long long nsPerIteration(std::chrono::steady_clock::duration time) {
+  return static_cast<long long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() /
+      kNumBenchmarkIterations);
+}
+
+void fillRandom(std::mt19937 &rng, chreGnssClock *value) {
+  fillRandom(rng, &value->time_ns);
+  fillRandom(rng, &value->full_bias_ns);
+  fillRandom(rng, &value->bias_ns);
+  fillRandom(rng, &value->drift_nsps);
+  fillRandom(rng, &value->bias_uncertainty_ns);
+  fillRandom(rng, &value->drift_uncertainty_nsps);
+  fillRandom(rng, &value->hw_clock_discontinuity_count);
+  fillRandom(rng, &value->flags);
+  memset(&value->reserved, 0, sizeof(value->reserved));
+}
+
+void expectEqual(const chreGnssClock &expected, const chreGnssClock &actual) {
+  EXPECT_SAME_FIELD(expected, actual, time_ns);
+  EXPECT_SAME_FIELD(expected, actual, full_bias_ns);
+  EXPECT_SAME_FIELD(expected, actual, bias_ns);
+  EXPECT_SAME_FIELD(expected, actual, drift_nsps);
+  EXPECT_SAME_FIELD(expected, actual, bias_uncertainty_ns);
+  EXPECT_SAME_FIELD(expected, actual, drift_uncertainty_nsps);
+  EXPECT_SAME_FIELD(expected, actual, hw_clock_discontinuity_count);
+  EXPECT_SAME_FIELD(expected, actual, flags);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+}
+
+void fillRandom(std::mt19937 &rng, chreGnssMeasurement *value) {
+  fillRandom(rng, &value->time_offset_ns);
+  fillRandom(rng, &value->accumulated_delta_range_um);
+  fillRandom(rng, &value->received_sv_time_in_ns);
+  fillRandom(rng, &value->received_sv_time_uncertainty_in_ns);
+  fillRandom(rng, &value->pseudorange_rate_mps);
+  fillRandom(rng, &value->pseudorange_rate_uncertainty_mps);
+  fillRandom(rng, &value->accumulated_delta_range_uncertainty_m);
+  fillRandom(rng, &value->c_n0_dbhz);
+  fillRandom(rng, &value->snr_db);
+  fillRandom(rng, &value->state);
+  fillRandom(rng, &value->accumulated_delta_range_state);
+  fillRandom(rng, &value->svid);
+  fillRandom(rng, &value->constellation);
+  fillRandom(rng, &value->multipath_indicator);
+  fillRandom(rng, &value->carrier_frequency_hz);
+}
+
+void expectEqual(const chreGnssMeasurement &expected,
+                 const chreGnssMeasurement &actual) {
+  EXPECT_SAME_FIELD(expected, actual, time_offset_ns);
+  EXPECT_SAME_FIELD(expected, actual, accumulated_delta_range_um);
+  EXPECT_SAME_FIELD(expected, actual, received_sv_time_in_ns);
+  EXPECT_SAME_FIELD(expected, actual, received_sv_time_uncertainty_in_ns);
+  EXPECT_SAME_FIELD(expected, actual, pseudorange_rate_mps);
+  EXPECT_SAME_FIELD(expected, actual, pseudorange_rate_uncertainty_mps);
+  EXPECT_SAME_FIELD(expected, actual, accumulated_delta_range_uncertainty_m);
+  EXPECT_SAME_FIELD(expected, actual, c_n0_dbhz);
+  EXPECT_SAME_FIELD(expected, actual, snr_db);
+  EXPECT_SAME_FIELD(expected, actual, state);
+  EXPECT_SAME_FIELD(expected, actual, accumulated_delta_range_state);
+  EXPECT_SAME_FIELD(expected, actual, svid);
+  EXPECT_SAME_FIELD(expected, actual, constellation);
+  EXPECT_SAME_FIELD(expected, actual, multipath_indicator);
+  EXPECT_SAME_FIELD(expected, actual, carrier_frequency_hz);
+}
+
+void fillRandom(std::mt19937 &rng, chreGnssDataEvent *value) {
+  value->version = CHRE_GNSS_DATA_EVENT_VERSION;
+  memset(&value->reserved, 0, sizeof(value->reserved));
+  fillRandom(rng, &value->clock);
+  value->measurement_count = static_cast<uint8_t>(randomLength(rng));
+  if (value->measurement_count == 0) {
+    value->measurements = nullptr;
+  } else {
+    size_t size = value->measurement_count * sizeof(chreGnssMeasurement);
+    auto *measurements = static_cast<chreGnssMeasurement *>(chppMalloc(size));
+    ASSERT_NE(measurements, nullptr);
+    for (size_t i = 0; i < value->measurement_count; i++) {
+      fillRandom(rng, &measurements[i]);
+    }
+    value->measurements = measurements;
+  }
+}
+
+void expectEqual(const chreGnssDataEvent &expected,
+                 const chreGnssDataEvent &actual) {
+  EXPECT_SAME_FIELD(expected, actual, version);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+  expectEqual(expected.clock, actual.clock);
+  ASSERT_EQ(expected.measurement_count, actual.measurement_count);
+  for (size_t i = 0; i < expected.measurement_count; i++) {
+    expectEqual(expected.measurements[i], actual.measurements[i]);
+  }
+}
+
+void fillRandom(std::mt19937 &rng, chreGnssLocationEvent *value) {
+  fillRandom(rng, &value->timestamp);
+  fillRandom(rng, &value->latitude_deg_e7);
+  fillRandom(rng, &value->longitude_deg_e7);
+  fillRandom(rng, &value->altitude);
+  fillRandom(rng, &value->speed);
+  fillRandom(rng, &value->bearing);
+  fillRandom(rng, &value->accuracy);
+  fillRandom(rng, &value->flags);
+  memset(&value->reserved, 0, sizeof(value->reserved));
+  fillRandom(rng, &value->altitude_accuracy);
+  fillRandom(rng, &value->speed_accuracy);
+  fillRandom(rng, &value->bearing_accuracy);
+}
+
+void expectEqual(const chreGnssLocationEvent &expected,
+                 const chreGnssLocationEvent &actual) {
+  EXPECT_SAME_FIELD(expected, actual, timestamp);
+  EXPECT_SAME_FIELD(expected, actual, latitude_deg_e7);
+  EXPECT_SAME_FIELD(expected, actual, longitude_deg_e7);
+  EXPECT_SAME_FIELD(expected, actual, altitude);
+  EXPECT_SAME_FIELD(expected, actual, speed);
+  EXPECT_SAME_FIELD(expected, actual, bearing);
+  EXPECT_SAME_FIELD(expected, actual, accuracy);
+  EXPECT_SAME_FIELD(expected, actual, flags);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+  EXPECT_SAME_FIELD(expected, actual, altitude_accuracy);
+  EXPECT_SAME_FIELD(expected, actual, speed_accuracy);
+  EXPECT_SAME_FIELD(expected, actual, bearing_accuracy);
+}
+
+void freeMembers(const chreGnssDataEvent &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.measurements));
+}
+
+}  // namespace
+
+// Round-trip tests, converting random structures from CHRE to CHPP and back
+
+TEST(GnssConvertRoundTripTest, DataEvent) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreGnssDataEvent original;
+    fillRandom(rng, &original);
+
+    ChppGnssDataEventWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result = chppGnssDataEventFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreGnssDataEvent *decoded =
+        chppGnssDataEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreGnssDataEvent *truncated =
+        chppGnssDataEventToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+TEST(GnssConvertRoundTripTest, LocationEvent) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreGnssLocationEvent original;
+    fillRandom(rng, &original);
+
+    ChppGnssLocationEventWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppGnssLocationEventFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreGnssLocationEvent *decoded =
+        chppGnssLocationEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreGnssLocationEvent *truncated =
+        chppGnssLocationEventToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    chppFree(decoded);
+    chppFree(encoded);
+  }
+}
+
+// Benchmarks of the conversions, to compare the bulk copies with the
+// field-by-field conversions across targets. Run with
+// --gtest_also_run_disabled_tests.
+
+TEST(GnssConvertBenchmark, DISABLED_DataEvent) {
+  std::mt19937 rng(kSeed);
+  chreGnssDataEvent original;
+  fillRandom(rng, &original);
+
+  ChppGnssDataEventWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppGnssDataEventFromChre(&original, &encoded, &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreGnssDataEvent *decoded =
+        chppGnssDataEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreGnssDataEvent: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
+TEST(GnssConvertBenchmark, DISABLED_LocationEvent) {
+  std::mt19937 rng(kSeed);
+  chreGnssLocationEvent original;
+  fillRandom(rng, &original);
+
+  ChppGnssLocationEventWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppGnssLocationEventFromChre(&original, &encoded,
+                                              &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreGnssLocationEvent *decoded =
+        chppGnssLocationEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreGnssLocationEvent: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+}
+
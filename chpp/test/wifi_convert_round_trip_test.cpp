@@ -0,0 +1,1059 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file was automatically generated by chpp_code_generator.py
+// Date: 2026-10-18 15:20:03 UTC
+// Source: chre_api/include/chre_api/chre/wifi.h @ commit 9bc36aa9b
+
+// DO NOT modify this file directly, as those changes will be lost the next
+// time the script is executed
+
+#include <gtest/gtest.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "chpp/app.h"
+#include "chpp/common/wifi_types.h"
+#include "chpp/macros.h"
+#include "chpp/memory.h"
+
+namespace {
+
+//! Seed of the random generator, fixed to make failures reproducible
+constexpr std::mt19937::result_type kSeed = 0x5eed;
+
+//! Number of random structures converted back and forth per root structure
+constexpr size_t kNumRoundTrips = 200;
+
+//! Maximum number of elements of the random variable-length arrays and strings
+constexpr size_t kMaxRandomLength = 8;
+
+//! Number of conversions timed per root structure by the benchmarks
+constexpr size_t kNumBenchmarkIterations = 10000;
+
+//! Expects a field to be bitwise identical in both structures, which also holds
+//! for floating-point NaNs
+#define EXPECT_SAME_FIELD(expected, actual, field)          \
+  EXPECT_EQ(std::memcmp(&(expected).field, &(actual).field, \
+                        sizeof((expected).field)),          \
+            0)                                              \
+      << #field
+
+void fillRandomBytes(std::mt19937 &rng, void *data, size_t size) {
+  auto *bytes = static_cast<uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    bytes[i] = static_cast<uint8_t>(rng());
+  }
+}
+
+//! Fills a field of a primitive type, overloaded below for the structures
+template <typename T>
+void fillRandom(std::mt19937 &rng, T *value) {
+  fillRandomBytes(rng, value, sizeof(*value));
+}
+
+//! @return The number of elements of a random variable-length array
+size_t randomLength(std::mt19937 &rng) {
+  return rng() % (kMaxRandomLength + 1);
+}
+
+//! @return One of the given values, e.g. of a union discriminator
+template <typename T, size_t N>
+T randomElement(std::mt19937 &rng, const T (&values)[N]) {
+  return values[rng() % N];
+}
+
+//! Expects the first count elements of both arrays to be bitwise identical
+template <typename T>
+void expectSameArray(const T *expected, const T *actual, size_t count) {
+  if (count > 0) {
+    EXPECT_EQ(std::memcmp(expected, actual, count * sizeof(T)), 0);
+  }
+}
+
+long long nsPerIteration(std::chrono::steady_clock::duration time) {
+  return static_cast<long long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() /
+      kNumBenchmarkIterations);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiNanDiscoveryEvent *value) {
+  fillRandom(rng, &value->subscribeId);
+  fillRandom(rng, &value->publishId);
+  fillRandom(rng, &value->publisherAddress);
+  value->serviceSpecificInfoSize = static_cast<uint32_t>(randomLength(rng));
+  if (value->serviceSpecificInfoSize == 0) {
+    value->serviceSpecificInfo = nullptr;
+  } else {
+    size_t size = value->serviceSpecificInfoSize * sizeof(uint8_t);
+    auto *serviceSpecificInfo = static_cast<uint8_t *>(chppMalloc(size));
+    ASSERT_NE(serviceSpecificInfo, nullptr);
+    fillRandomBytes(rng, serviceSpecificInfo, size);
+    value->serviceSpecificInfo = serviceSpecificInfo;
+  }
+}
+
+void expectEqual(const chreWifiNanDiscoveryEvent &expected,
+                 const chreWifiNanDiscoveryEvent &actual) {
+  EXPECT_SAME_FIELD(expected, actual, subscribeId);
+  EXPECT_SAME_FIELD(expected, actual, publishId);
+  EXPECT_SAME_FIELD(expected, actual, publisherAddress);
+  ASSERT_EQ(expected.serviceSpecificInfoSize, actual.serviceSpecificInfoSize);
+  expectSameArray(expected.serviceSpecificInfo, actual.serviceSpecificInfo,
+                  expected.serviceSpecificInfoSize);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiNanRangingParams *value) {
+  fillRandom(rng, &value->macAddress);
+}
+
+void expectEqual(const chreWifiNanRangingParams &expected,
+                 const chreWifiNanRangingParams &actual) {
+  EXPECT_SAME_FIELD(expected, actual, macAddress);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiNanSessionLostEvent *value) {
+  fillRandom(rng, &value->id);
+  fillRandom(rng, &value->peerId);
+}
+
+void expectEqual(const chreWifiNanSessionLostEvent &expected,
+                 const chreWifiNanSessionLostEvent &actual) {
+  EXPECT_SAME_FIELD(expected, actual, id);
+  EXPECT_SAME_FIELD(expected, actual, peerId);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiNanSessionTerminatedEvent *value) {
+  fillRandom(rng, &value->id);
+  fillRandom(rng, &value->reason);
+  fillRandom(rng, &value->reserved);
+}
+
+void expectEqual(const chreWifiNanSessionTerminatedEvent &expected,
+                 const chreWifiNanSessionTerminatedEvent &actual) {
+  EXPECT_SAME_FIELD(expected, actual, id);
+  EXPECT_SAME_FIELD(expected, actual, reason);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiNanSubscribeConfig *value) {
+  fillRandom(rng, &value->subscribeType);
+  size_t serviceLength = rng() % kMaxRandomLength;
+  auto *service = static_cast<char *>(chppMalloc(serviceLength + 1));
+  ASSERT_NE(service, nullptr);
+  for (size_t i = 0; i < serviceLength; i++) {
+    service[i] = static_cast<char>('a' + rng() % 26);
+  }
+  service[serviceLength] = '\0';
+  value->service = service;
+  value->serviceSpecificInfoSize = static_cast<uint32_t>(randomLength(rng));
+  if (value->serviceSpecificInfoSize == 0) {
+    value->serviceSpecificInfo = nullptr;
+  } else {
+    size_t size = value->serviceSpecificInfoSize * sizeof(uint8_t);
+    auto *serviceSpecificInfo = static_cast<uint8_t *>(chppMalloc(size));
+    ASSERT_NE(serviceSpecificInfo, nullptr);
+    fillRandomBytes(rng, serviceSpecificInfo, size);
+    value->serviceSpecificInfo = serviceSpecificInfo;
+  }
+  value->matchFilterLength = static_cast<uint32_t>(randomLength(rng));
+  if (value->matchFilterLength == 0) {
+    value->matchFilter = nullptr;
+  } else {
+    size_t size = value->matchFilterLength * sizeof(uint8_t);
+    auto *matchFilter = static_cast<uint8_t *>(chppMalloc(size));
+    ASSERT_NE(matchFilter, nullptr);
+    fillRandomBytes(rng, matchFilter, size);
+    value->matchFilter = matchFilter;
+  }
+}
+
+void expectEqual(const chreWifiNanSubscribeConfig &expected,
+                 const chreWifiNanSubscribeConfig &actual) {
+  EXPECT_SAME_FIELD(expected, actual, subscribeType);
+  EXPECT_STREQ(expected.service, actual.service);
+  ASSERT_EQ(expected.serviceSpecificInfoSize, actual.serviceSpecificInfoSize);
+  expectSameArray(expected.serviceSpecificInfo, actual.serviceSpecificInfo,
+                  expected.serviceSpecificInfoSize);
+  ASSERT_EQ(expected.matchFilterLength, actual.matchFilterLength);
+  expectSameArray(expected.matchFilter, actual.matchFilter,
+                  expected.matchFilterLength);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiRangingResult::chreWifiLci *value) {
+  fillRandom(rng, &value->latitude);
+  fillRandom(rng, &value->longitude);
+  fillRandom(rng, &value->altitude);
+  fillRandom(rng, &value->latitudeUncertainty);
+  fillRandom(rng, &value->longitudeUncertainty);
+  fillRandom(rng, &value->altitudeType);
+  fillRandom(rng, &value->altitudeUncertainty);
+}
+
+void expectEqual(const chreWifiRangingResult::chreWifiLci &expected,
+                 const chreWifiRangingResult::chreWifiLci &actual) {
+  EXPECT_SAME_FIELD(expected, actual, latitude);
+  EXPECT_SAME_FIELD(expected, actual, longitude);
+  EXPECT_SAME_FIELD(expected, actual, altitude);
+  EXPECT_SAME_FIELD(expected, actual, latitudeUncertainty);
+  EXPECT_SAME_FIELD(expected, actual, longitudeUncertainty);
+  EXPECT_SAME_FIELD(expected, actual, altitudeType);
+  EXPECT_SAME_FIELD(expected, actual, altitudeUncertainty);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiRangingResult *value) {
+  fillRandom(rng, &value->timestamp);
+  fillRandom(rng, &value->macAddress);
+  fillRandom(rng, &value->status);
+  fillRandom(rng, &value->rssi);
+  fillRandom(rng, &value->distance);
+  fillRandom(rng, &value->distanceStdDev);
+  fillRandom(rng, &value->lci);
+  fillRandom(rng, &value->flags);
+  memset(&value->reserved, 0, sizeof(value->reserved));
+}
+
+void expectEqual(const chreWifiRangingResult &expected,
+                 const chreWifiRangingResult &actual) {
+  EXPECT_SAME_FIELD(expected, actual, timestamp);
+  EXPECT_SAME_FIELD(expected, actual, macAddress);
+  EXPECT_SAME_FIELD(expected, actual, status);
+  EXPECT_SAME_FIELD(expected, actual, rssi);
+  EXPECT_SAME_FIELD(expected, actual, distance);
+  EXPECT_SAME_FIELD(expected, actual, distanceStdDev);
+  expectEqual(expected.lci, actual.lci);
+  EXPECT_SAME_FIELD(expected, actual, flags);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiRangingEvent *value) {
+  value->version = CHRE_WIFI_RANGING_EVENT_VERSION;
+  memset(&value->reserved, 0, sizeof(value->reserved));
+  value->resultCount = static_cast<uint8_t>(randomLength(rng));
+  if (value->resultCount == 0) {
+    value->results = nullptr;
+  } else {
+    size_t size = value->resultCount * sizeof(chreWifiRangingResult);
+    auto *results = static_cast<chreWifiRangingResult *>(chppMalloc(size));
+    ASSERT_NE(results, nullptr);
+    for (size_t i = 0; i < value->resultCount; i++) {
+      fillRandom(rng, &results[i]);
+    }
+    value->results = results;
+  }
+}
+
+void expectEqual(const chreWifiRangingEvent &expected,
+                 const chreWifiRangingEvent &actual) {
+  EXPECT_SAME_FIELD(expected, actual, version);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+  ASSERT_EQ(expected.resultCount, actual.resultCount);
+  for (size_t i = 0; i < expected.resultCount; i++) {
+    expectEqual(expected.results[i], actual.results[i]);
+  }
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiRangingTarget *value) {
+  fillRandom(rng, &value->macAddress);
+  fillRandom(rng, &value->primaryChannel);
+  fillRandom(rng, &value->centerFreqPrimary);
+  fillRandom(rng, &value->centerFreqSecondary);
+  fillRandom(rng, &value->channelWidth);
+  memset(&value->reserved, 0, sizeof(value->reserved));
+}
+
+void expectEqual(const chreWifiRangingTarget &expected,
+                 const chreWifiRangingTarget &actual) {
+  EXPECT_SAME_FIELD(expected, actual, macAddress);
+  EXPECT_SAME_FIELD(expected, actual, primaryChannel);
+  EXPECT_SAME_FIELD(expected, actual, centerFreqPrimary);
+  EXPECT_SAME_FIELD(expected, actual, centerFreqSecondary);
+  EXPECT_SAME_FIELD(expected, actual, channelWidth);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiRangingParams *value) {
+  value->targetListLen = static_cast<uint8_t>(randomLength(rng));
+  if (value->targetListLen == 0) {
+    value->targetList = nullptr;
+  } else {
+    size_t size = value->targetListLen * sizeof(chreWifiRangingTarget);
+    auto *targetList = static_cast<chreWifiRangingTarget *>(chppMalloc(size));
+    ASSERT_NE(targetList, nullptr);
+    for (size_t i = 0; i < value->targetListLen; i++) {
+      fillRandom(rng, &targetList[i]);
+    }
+    value->targetList = targetList;
+  }
+}
+
+void expectEqual(const chreWifiRangingParams &expected,
+                 const chreWifiRangingParams &actual) {
+  ASSERT_EQ(expected.targetListLen, actual.targetListLen);
+  for (size_t i = 0; i < expected.targetListLen; i++) {
+    expectEqual(expected.targetList[i], actual.targetList[i]);
+  }
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiScanResult *value) {
+  fillRandom(rng, &value->ageMs);
+  fillRandom(rng, &value->capabilityInfo);
+  fillRandom(rng, &value->ssidLen);
+  fillRandom(rng, &value->ssid);
+  fillRandom(rng, &value->bssid);
+  fillRandom(rng, &value->flags);
+  fillRandom(rng, &value->rssi);
+  fillRandom(rng, &value->band);
+  fillRandom(rng, &value->primaryChannel);
+  fillRandom(rng, &value->centerFreqPrimary);
+  fillRandom(rng, &value->centerFreqSecondary);
+  fillRandom(rng, &value->channelWidth);
+  fillRandom(rng, &value->securityMode);
+  fillRandom(rng, &value->radioChain);
+  fillRandom(rng, &value->rssiChain0);
+  fillRandom(rng, &value->rssiChain1);
+  memset(&value->reserved, 0, sizeof(value->reserved));
+}
+
+void expectEqual(const chreWifiScanResult &expected,
+                 const chreWifiScanResult &actual) {
+  EXPECT_SAME_FIELD(expected, actual, ageMs);
+  EXPECT_SAME_FIELD(expected, actual, capabilityInfo);
+  EXPECT_SAME_FIELD(expected, actual, ssidLen);
+  EXPECT_SAME_FIELD(expected, actual, ssid);
+  EXPECT_SAME_FIELD(expected, actual, bssid);
+  EXPECT_SAME_FIELD(expected, actual, flags);
+  EXPECT_SAME_FIELD(expected, actual, rssi);
+  EXPECT_SAME_FIELD(expected, actual, band);
+  EXPECT_SAME_FIELD(expected, actual, primaryChannel);
+  EXPECT_SAME_FIELD(expected, actual, centerFreqPrimary);
+  EXPECT_SAME_FIELD(expected, actual, centerFreqSecondary);
+  EXPECT_SAME_FIELD(expected, actual, channelWidth);
+  EXPECT_SAME_FIELD(expected, actual, securityMode);
+  EXPECT_SAME_FIELD(expected, actual, radioChain);
+  EXPECT_SAME_FIELD(expected, actual, rssiChain0);
+  EXPECT_SAME_FIELD(expected, actual, rssiChain1);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiScanEvent *value) {
+  value->version = CHRE_WIFI_SCAN_EVENT_VERSION;
+  fillRandom(rng, &value->resultTotal);
+  fillRandom(rng, &value->eventIndex);
+  fillRandom(rng, &value->scanType);
+  fillRandom(rng, &value->ssidSetSize);
+  fillRandom(rng, &value->referenceTime);
+  value->scannedFreqListLen = static_cast<uint16_t>(randomLength(rng));
+  if (value->scannedFreqListLen == 0) {
+    value->scannedFreqList = nullptr;
+  } else {
+    size_t size = value->scannedFreqListLen * sizeof(uint32_t);
+    auto *scannedFreqList = static_cast<uint32_t *>(chppMalloc(size));
+    ASSERT_NE(scannedFreqList, nullptr);
+    fillRandomBytes(rng, scannedFreqList, size);
+    value->scannedFreqList = scannedFreqList;
+  }
+  value->resultCount = static_cast<uint8_t>(randomLength(rng));
+  if (value->resultCount == 0) {
+    value->results = nullptr;
+  } else {
+    size_t size = value->resultCount * sizeof(chreWifiScanResult);
+    auto *results = static_cast<chreWifiScanResult *>(chppMalloc(size));
+    ASSERT_NE(results, nullptr);
+    for (size_t i = 0; i < value->resultCount; i++) {
+      fillRandom(rng, &results[i]);
+    }
+    value->results = results;
+  }
+  fillRandom(rng, &value->radioChainPref);
+}
+
+void expectEqual(const chreWifiScanEvent &expected,
+                 const chreWifiScanEvent &actual) {
+  EXPECT_SAME_FIELD(expected, actual, version);
+  EXPECT_SAME_FIELD(expected, actual, resultTotal);
+  EXPECT_SAME_FIELD(expected, actual, eventIndex);
+  EXPECT_SAME_FIELD(expected, actual, scanType);
+  EXPECT_SAME_FIELD(expected, actual, ssidSetSize);
+  EXPECT_SAME_FIELD(expected, actual, referenceTime);
+  ASSERT_EQ(expected.scannedFreqListLen, actual.scannedFreqListLen);
+  expectSameArray(expected.scannedFreqList, actual.scannedFreqList,
+                  expected.scannedFreqListLen);
+  ASSERT_EQ(expected.resultCount, actual.resultCount);
+  for (size_t i = 0; i < expected.resultCount; i++) {
+    expectEqual(expected.results[i], actual.results[i]);
+  }
+  EXPECT_SAME_FIELD(expected, actual, radioChainPref);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiSsidListItem *value) {
+  fillRandom(rng, &value->ssidLen);
+  fillRandom(rng, &value->ssid);
+}
+
+void expectEqual(const chreWifiSsidListItem &expected,
+                 const chreWifiSsidListItem &actual) {
+  EXPECT_SAME_FIELD(expected, actual, ssidLen);
+  EXPECT_SAME_FIELD(expected, actual, ssid);
+}
+
+void fillRandom(std::mt19937 &rng, chreWifiScanParams *value) {
+  fillRandom(rng, &value->scanType);
+  fillRandom(rng, &value->maxScanAgeMs);
+  value->frequencyListLen = static_cast<uint16_t>(randomLength(rng));
+  if (value->frequencyListLen == 0) {
+    value->frequencyList = nullptr;
+  } else {
+    size_t size = value->frequencyListLen * sizeof(uint32_t);
+    auto *frequencyList = static_cast<uint32_t *>(chppMalloc(size));
+    ASSERT_NE(frequencyList, nullptr);
+    fillRandomBytes(rng, frequencyList, size);
+    value->frequencyList = frequencyList;
+  }
+  value->ssidListLen = static_cast<uint8_t>(randomLength(rng));
+  if (value->ssidListLen == 0) {
+    value->ssidList = nullptr;
+  } else {
+    size_t size = value->ssidListLen * sizeof(chreWifiSsidListItem);
+    auto *ssidList = static_cast<chreWifiSsidListItem *>(chppMalloc(size));
+    ASSERT_NE(ssidList, nullptr);
+    for (size_t i = 0; i < value->ssidListLen; i++) {
+      fillRandom(rng, &ssidList[i]);
+    }
+    value->ssidList = ssidList;
+  }
+  fillRandom(rng, &value->radioChainPref);
+  fillRandom(rng, &value->channelSet);
+}
+
+void expectEqual(const chreWifiScanParams &expected,
+                 const chreWifiScanParams &actual) {
+  EXPECT_SAME_FIELD(expected, actual, scanType);
+  EXPECT_SAME_FIELD(expected, actual, maxScanAgeMs);
+  ASSERT_EQ(expected.frequencyListLen, actual.frequencyListLen);
+  expectSameArray(expected.frequencyList, actual.frequencyList,
+                  expected.frequencyListLen);
+  ASSERT_EQ(expected.ssidListLen, actual.ssidListLen);
+  for (size_t i = 0; i < expected.ssidListLen; i++) {
+    expectEqual(expected.ssidList[i], actual.ssidList[i]);
+  }
+  EXPECT_SAME_FIELD(expected, actual, radioChainPref);
+  EXPECT_SAME_FIELD(expected, actual, channelSet);
+}
+
+void freeMembers(const chreWifiScanEvent &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.scannedFreqList));
+  chppFree(CHPP_CONST_CAST_POINTER(value.results));
+}
+
+void freeMembers(const chreWifiScanParams &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.frequencyList));
+  chppFree(CHPP_CONST_CAST_POINTER(value.ssidList));
+}
+
+void freeMembers(const chreWifiRangingEvent &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.results));
+}
+
+void freeMembers(const chreWifiRangingParams &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.targetList));
+}
+
+void freeMembers(const chreWifiNanSubscribeConfig &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.service));
+  chppFree(CHPP_CONST_CAST_POINTER(value.serviceSpecificInfo));
+  chppFree(CHPP_CONST_CAST_POINTER(value.matchFilter));
+}
+
+void freeMembers(const chreWifiNanDiscoveryEvent &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.serviceSpecificInfo));
+}
+
+}  // namespace
+
+// Round-trip tests, converting random structures from CHRE to CHPP and back
+
+TEST(WifiConvertRoundTripTest, ScanEvent) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiScanEvent original;
+    fillRandom(rng, &original);
+
+    ChppWifiScanEventWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result = chppWifiScanEventFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiScanEvent *decoded =
+        chppWifiScanEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiScanEvent *truncated =
+        chppWifiScanEventToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, ScanParams) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiScanParams original;
+    fillRandom(rng, &original);
+
+    ChppWifiScanParamsWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result = chppWifiScanParamsFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiScanParams *decoded =
+        chppWifiScanParamsToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiScanParams *truncated =
+        chppWifiScanParamsToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, RangingEvent) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiRangingEvent original;
+    fillRandom(rng, &original);
+
+    ChppWifiRangingEventWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWifiRangingEventFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiRangingEvent *decoded =
+        chppWifiRangingEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiRangingEvent *truncated =
+        chppWifiRangingEventToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, RangingParams) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiRangingParams original;
+    fillRandom(rng, &original);
+
+    ChppWifiRangingParamsWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWifiRangingParamsFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiRangingParams *decoded =
+        chppWifiRangingParamsToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiRangingParams *truncated =
+        chppWifiRangingParamsToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, NanSubscribeConfig) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiNanSubscribeConfig original;
+    fillRandom(rng, &original);
+
+    ChppWifiNanSubscribeConfigWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWifiNanSubscribeConfigFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiNanSubscribeConfig *decoded =
+        chppWifiNanSubscribeConfigToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiNanSubscribeConfig *truncated =
+        chppWifiNanSubscribeConfigToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, NanDiscoveryEvent) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiNanDiscoveryEvent original;
+    fillRandom(rng, &original);
+
+    ChppWifiNanDiscoveryEventWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWifiNanDiscoveryEventFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiNanDiscoveryEvent *decoded =
+        chppWifiNanDiscoveryEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiNanDiscoveryEvent *truncated =
+        chppWifiNanDiscoveryEventToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, NanSessionLostEvent) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiNanSessionLostEvent original;
+    fillRandom(rng, &original);
+
+    ChppWifiNanSessionLostEventWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWifiNanSessionLostEventFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiNanSessionLostEvent *decoded =
+        chppWifiNanSessionLostEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiNanSessionLostEvent *truncated =
+        chppWifiNanSessionLostEventToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    chppFree(decoded);
+    chppFree(encoded);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, NanSessionTerminatedEvent) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiNanSessionTerminatedEvent original;
+    fillRandom(rng, &original);
+
+    ChppWifiNanSessionTerminatedEventWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWifiNanSessionTerminatedEventFromChre(&original, &encoded,
+                                                  &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiNanSessionTerminatedEvent *decoded =
+        chppWifiNanSessionTerminatedEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiNanSessionTerminatedEvent *truncated =
+        chppWifiNanSessionTerminatedEventToChre(&encoded->payload,
+                                                payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    chppFree(decoded);
+    chppFree(encoded);
+  }
+}
+
+TEST(WifiConvertRoundTripTest, NanRangingParams) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWifiNanRangingParams original;
+    fillRandom(rng, &original);
+
+    ChppWifiNanRangingParamsWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWifiNanRangingParamsFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWifiNanRangingParams *decoded =
+        chppWifiNanRangingParamsToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWifiNanRangingParams *truncated =
+        chppWifiNanRangingParamsToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    chppFree(decoded);
+    chppFree(encoded);
+  }
+}
+
+// Benchmarks of the conversions, to compare the bulk copies with the
+// field-by-field conversions across targets. Run with
+// --gtest_also_run_disabled_tests.
+
+TEST(WifiConvertBenchmark, DISABLED_ScanEvent) {
+  std::mt19937 rng(kSeed);
+  chreWifiScanEvent original;
+  fillRandom(rng, &original);
+
+  ChppWifiScanEventWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiScanEventFromChre(&original, &encoded, &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiScanEvent *decoded =
+        chppWifiScanEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiScanEvent: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_ScanParams) {
+  std::mt19937 rng(kSeed);
+  chreWifiScanParams original;
+  fillRandom(rng, &original);
+
+  ChppWifiScanParamsWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiScanParamsFromChre(&original, &encoded, &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiScanParams *decoded =
+        chppWifiScanParamsToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiScanParams: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_RangingEvent) {
+  std::mt19937 rng(kSeed);
+  chreWifiRangingEvent original;
+  fillRandom(rng, &original);
+
+  ChppWifiRangingEventWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiRangingEventFromChre(&original, &encoded,
+                                             &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiRangingEvent *decoded =
+        chppWifiRangingEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiRangingEvent: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_RangingParams) {
+  std::mt19937 rng(kSeed);
+  chreWifiRangingParams original;
+  fillRandom(rng, &original);
+
+  ChppWifiRangingParamsWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiRangingParamsFromChre(&original, &encoded,
+                                              &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiRangingParams *decoded =
+        chppWifiRangingParamsToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiRangingParams: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_NanSubscribeConfig) {
+  std::mt19937 rng(kSeed);
+  chreWifiNanSubscribeConfig original;
+  fillRandom(rng, &original);
+
+  ChppWifiNanSubscribeConfigWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiNanSubscribeConfigFromChre(&original, &encoded,
+                                                   &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiNanSubscribeConfig *decoded =
+        chppWifiNanSubscribeConfigToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiNanSubscribeConfig: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_NanDiscoveryEvent) {
+  std::mt19937 rng(kSeed);
+  chreWifiNanDiscoveryEvent original;
+  fillRandom(rng, &original);
+
+  ChppWifiNanDiscoveryEventWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiNanDiscoveryEventFromChre(&original, &encoded,
+                                                  &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiNanDiscoveryEvent *decoded =
+        chppWifiNanDiscoveryEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiNanDiscoveryEvent: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_NanSessionLostEvent) {
+  std::mt19937 rng(kSeed);
+  chreWifiNanSessionLostEvent original;
+  fillRandom(rng, &original);
+
+  ChppWifiNanSessionLostEventWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiNanSessionLostEventFromChre(&original, &encoded,
+                                                    &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiNanSessionLostEvent *decoded =
+        chppWifiNanSessionLostEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiNanSessionLostEvent: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_NanSessionTerminatedEvent) {
+  std::mt19937 rng(kSeed);
+  chreWifiNanSessionTerminatedEvent original;
+  fillRandom(rng, &original);
+
+  ChppWifiNanSessionTerminatedEventWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiNanSessionTerminatedEventFromChre(&original, &encoded,
+                                                          &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiNanSessionTerminatedEvent *decoded =
+        chppWifiNanSessionTerminatedEventToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiNanSessionTerminatedEvent: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+}
+
+TEST(WifiConvertBenchmark, DISABLED_NanRangingParams) {
+  std::mt19937 rng(kSeed);
+  chreWifiNanRangingParams original;
+  fillRandom(rng, &original);
+
+  ChppWifiNanRangingParamsWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWifiNanRangingParamsFromChre(&original, &encoded,
+                                                 &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWifiNanRangingParams *decoded =
+        chppWifiNanRangingParamsToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWifiNanRangingParams: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+}
+
@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "chpp/app.h"
+#include "chpp/common/wifi.h"
+#include "chpp/common/wifi_scan_stream.h"
+#include "chpp/common/wifi_types.h"
+#include "chpp/memory.h"
+#include "chpp/platform/platform_link.h"
+#include "chpp/platform/utils.h"
+#include "chpp/transport.h"
+
+namespace {
+
+// State of the link layer.
+struct ChppLinuxLinkState gChppLinuxLinkContext;
+
+// Number of scan events passed to releaseScanEvent().
+size_t gReleasedEventCount = 0;
+
+void releaseScanEvent(struct chreWifiScanEvent * /*event*/) {
+  gReleasedEventCount++;
+}
+
+// clang-format off
+const chreWifiScanResult kAps[] = {
+  {
+      .ageMs = 11,
+      .capabilityInfo = 22,
+      .ssidLen = 4,
+      .ssid = {'a', 'b', 'c', 'd',},
+      .bssid = {0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff},
+      .flags = CHRE_WIFI_SCAN_RESULT_FLAGS_IS_FTM_RESPONDER,
+      .rssi = -37,
+      .band = CHRE_WIFI_BAND_2_4_GHZ,
+      .primaryChannel = 2437,
+      .centerFreqPrimary = 2442,
+      .centerFreqSecondary = 2447,
+      .channelWidth = CHRE_WIFI_CHANNEL_WIDTH_80_MHZ,
+      .securityMode = CHRE_WIFI_SECURITY_MODE_PSK,
+      .radioChain = CHRE_WIFI_RADIO_CHAIN_0,
+      .rssiChain0 = -37,
+      .rssiChain1 = 0,
+      .reserved = {1, 2, 3, 4, 5, 6, 7},  // ignored
+  },
+  {
+      .ageMs = 33,
+      .capabilityInfo = 44,
+      .ssidLen = 3,
+      .ssid = {'x', 'y', 'z',},
+      .bssid = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66},
+      .flags = 0,
+      .rssi = -72,
+      .band = CHRE_WIFI_BAND_5_GHZ,
+      .primaryChannel = 5180,
+      .centerFreqPrimary = 5190,
+      .centerFreqSecondary = 0,
+      .channelWidth = CHRE_WIFI_CHANNEL_WIDTH_40_MHZ,
+      .securityMode = CHRE_WIFI_SECURITY_MODE_OPEN,
+      .radioChain = CHRE_WIFI_RADIO_CHAIN_1,
+      .rssiChain0 = 0,
+      .rssiChain1 = -72,
+  },
+};
+// clang-format on
+
+const uint32_t kFreqList[] = {2412, 2437, 2462, 5180, 5200};
+
+const chreWifiScanEvent kEvent = {
+    .version = CHRE_WIFI_SCAN_EVENT_VERSION,
+    .resultCount = ARRAY_SIZE(kAps),
+    .resultTotal = 4,
+    .eventIndex = 1,
+    .scanType = CHRE_WIFI_SCAN_TYPE_ACTIVE,
+    .ssidSetSize = 0,
+    .scannedFreqListLen = ARRAY_SIZE(kFreqList),
+    .referenceTime = 123456789,
+    .scannedFreqList = kFreqList,
+    .results = kAps,
+    .radioChainPref = CHRE_WIFI_RADIO_CHAIN_PREF_DEFAULT,
+};
+
+const ChppAppHeader kHeader = {
+    .handle = CHPP_HANDLE_NEGOTIATED_RANGE_START,
+    .type = CHPP_MESSAGE_TYPE_SERVICE_NOTIFICATION,
+    .transaction = 3,
+    .error = CHPP_APP_ERROR_NONE,
+    .command = CHPP_WIFI_REQUEST_SCAN_ASYNC,
+};
+
+void expectResultsEqual(const chreWifiScanResult &expected,
+                        const chreWifiScanResult &actual) {
+  // The reserved bytes are always decoded as 0.
+  chreWifiScanResult expectedDecoded = expected;
+  memset(expectedDecoded.reserved, 0, sizeof(expectedDecoded.reserved));
+  EXPECT_EQ(memcmp(&expectedDecoded, &actual, sizeof(actual)), 0);
+}
+
+void expectEventsEqual(const chreWifiScanEvent &expected,
+                       const chreWifiScanEvent &actual) {
+  EXPECT_EQ(actual.version, CHRE_WIFI_SCAN_EVENT_VERSION);
+  EXPECT_EQ(actual.resultCount, expected.resultCount);
+  EXPECT_EQ(actual.resultTotal, expected.resultTotal);
+  EXPECT_EQ(actual.eventIndex, expected.eventIndex);
+  EXPECT_EQ(actual.scanType, expected.scanType);
+  EXPECT_EQ(actual.ssidSetSize, expected.ssidSetSize);
+  EXPECT_EQ(actual.scannedFreqListLen, expected.scannedFreqListLen);
+  EXPECT_EQ(actual.referenceTime, expected.referenceTime);
+  EXPECT_EQ(actual.radioChainPref, expected.radioChainPref);
+
+  ASSERT_NE(actual.scannedFreqList, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(actual.scannedFreqList) %
+                alignof(uint32_t),
+            0);
+  EXPECT_EQ(memcmp(actual.scannedFreqList, expected.scannedFreqList,
+                   expected.scannedFreqListLen * sizeof(uint32_t)),
+            0);
+
+  ASSERT_NE(actual.results, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(actual.results) %
+                alignof(chreWifiScanResult),
+            0);
+  for (size_t i = 0; i < expected.resultCount; i++) {
+    SCOPED_TRACE(i);
+    expectResultsEqual(expected.results[i], actual.results[i]);
+  }
+}
+
+class WifiScanStreamTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    chppClearTotalAllocBytes();
+    gReleasedEventCount = 0;
+    memset(&gChppLinuxLinkContext, 0, sizeof(struct ChppLinuxLinkState));
+    gChppLinuxLinkContext.manualSendCycle = true;
+    gChppLinuxLinkContext.linkEstablished = true;
+    gChppLinuxLinkContext.isLinkActive = true;
+    const struct ChppLinkApi *linkApi = getLinuxLinkApi();
+    chppTransportInit(&mTransportContext, &mAppContext, &gChppLinuxLinkContext,
+                      linkApi);
+    chppAppInit(&mAppContext, &mTransportContext);
+
+    mTransportContext.resetState = CHPP_RESET_STATE_NONE;
+  }
+
+  void TearDown() override {
+    chppAppDeinit(&mAppContext);
+    chppTransportDeinit(&mTransportContext);
+
+    EXPECT_EQ(gReleasedEventCount, mEnqueuedEventCount);
+    EXPECT_EQ(chppGetTotalAllocBytes(), 0);
+  }
+
+  //! @return The datagram at the front of the Tx queue, encoded in chunks of
+  //! chunkLen bytes as it would be when packetized.
+  std::vector<uint8_t> encodeFrontDatagram(size_t chunkLen) {
+    const ChppDatagram &datagram =
+        mTransportContext.txDatagramQueue
+            .datagram[mTransportContext.txDatagramQueue.front];
+    std::vector<uint8_t> encoded(datagram.length);
+    for (size_t offset = 0; offset < datagram.length; offset += chunkLen) {
+      datagram.encoder->encode(datagram.encoderContext, offset,
+                               &encoded[offset],
+                               std::min(chunkLen, datagram.length - offset));
+    }
+    return encoded;
+  }
+
+  ChppTransportState mTransportContext = {};
+  ChppAppState mAppContext = {};
+  size_t mEnqueuedEventCount = 0;
+};
+
+TEST_F(WifiScanStreamTest, EncodesLikeConverter) {
+  chreWifiScanEvent event = kEvent;
+  ASSERT_TRUE(chppWifiScanEventEnqueueOrFail(&mTransportContext, &kHeader,
+                                             &event, releaseScanEvent));
+  mEnqueuedEventCount++;
+  ASSERT_EQ(mTransportContext.txDatagramQueue.pending, 1);
+
+  ChppWifiScanEventWithHeader *expected = nullptr;
+  size_t expectedLen = 0;
+  ASSERT_TRUE(chppWifiScanEventFromChre(&kEvent, &expected, &expectedLen));
+  expected->header = kHeader;
+
+  for (size_t chunkLen : {size_t{1}, size_t{7}, size_t{72}, expectedLen}) {
+    SCOPED_TRACE(chunkLen);
+    std::vector<uint8_t> encoded = encodeFrontDatagram(chunkLen);
+    ASSERT_EQ(encoded.size(), expectedLen);
+    EXPECT_EQ(memcmp(encoded.data(), expected, expectedLen), 0);
+  }
+
+  chppFree(expected);
+  // The event is only released with the datagram.
+  EXPECT_EQ(gReleasedEventCount, 0);
+}
+
+TEST_F(WifiScanStreamTest, ReleasesEventWhenNotEnqueued) {
+  mTransportContext.resetState = CHPP_RESET_STATE_RESETTING;
+
+  chreWifiScanEvent event = kEvent;
+  EXPECT_FALSE(chppWifiScanEventEnqueueOrFail(&mTransportContext, &kHeader,
+                                              &event, releaseScanEvent));
+  EXPECT_EQ(gReleasedEventCount, 1);
+  mEnqueuedEventCount++;
+}
+
+TEST_F(WifiScanStreamTest, DecodesInPlace) {
+  ChppWifiScanEventWithHeader *notification = nullptr;
+  size_t len = 0;
+  ASSERT_TRUE(chppWifiScanEventFromChre(&kEvent, &notification, &len));
+  notification->header = kHeader;
+  uint8_t *buf = reinterpret_cast<uint8_t *>(notification);
+
+  mAppContext.isRxDatagramKept = false;
+  chreWifiScanEvent *event =
+      chppWifiScanEventToChreInPlace(&mAppContext, buf, len);
+  ASSERT_NE(event, nullptr);
+
+  // The datagram is kept and holds the decoded data.
+  EXPECT_TRUE(mAppContext.isRxDatagramKept);
+  EXPECT_EQ(static_cast<const void *>(event->scannedFreqList),
+            static_cast<void *>(buf));
+  expectEventsEqual(kEvent, *event);
+
+  chppWifiScanEventInPlaceRelease(event);
+}
+
+TEST_F(WifiScanStreamTest, DecodesResultsBeforeFreqList) {
+  // Valid, but not the layout used by the encoders: the results come first.
+  size_t freqListLen = sizeof(kFreqList);
+  size_t resultsLen = ARRAY_SIZE(kAps) * sizeof(ChppWifiScanResult);
+  size_t len = sizeof(ChppWifiScanEventWithHeader) + resultsLen + freqListLen;
+  uint8_t *buf = static_cast<uint8_t *>(chppMalloc(len));
+  ASSERT_NE(buf, nullptr);
+
+  ChppWifiScanEventWithHeader *notification =
+      reinterpret_cast<ChppWifiScanEventWithHeader *>(buf);
+  notification->header = kHeader;
+  ChppWifiScanEvent &chpp = notification->payload;
+  chpp.version = CHRE_WIFI_SCAN_EVENT_VERSION;
+  chpp.resultCount = kEvent.resultCount;
+  chpp.resultTotal = kEvent.resultTotal;
+  chpp.eventIndex = kEvent.eventIndex;
+  chpp.scanType = kEvent.scanType;
+  chpp.ssidSetSize = kEvent.ssidSetSize;
+  chpp.scannedFreqListLen = kEvent.scannedFreqListLen;
+  chpp.referenceTime = kEvent.referenceTime;
+  chpp.results.offset = sizeof(ChppWifiScanEvent);
+  chpp.results.length = static_cast<uint16_t>(resultsLen);
+  chpp.scannedFreqList.offset =
+      static_cast<uint16_t>(sizeof(ChppWifiScanEvent) + resultsLen);
+  chpp.scannedFreqList.length = static_cast<uint16_t>(freqListLen);
+  chpp.radioChainPref = kEvent.radioChainPref;
+  uint8_t *vla = buf + sizeof(ChppWifiScanEventWithHeader);
+  memcpy(vla, kAps, resultsLen);
+  memcpy(vla + resultsLen, kFreqList, freqListLen);
+
+  mAppContext.isRxDatagramKept = false;
+  chreWifiScanEvent *event =
+      chppWifiScanEventToChreInPlace(&mAppContext, buf, len);
+  ASSERT_NE(event, nullptr);
+
+  // The data is copied out of the datagram instead.
+  EXPECT_FALSE(mAppContext.isRxDatagramKept);
+  chppFree(buf);
+  expectEventsEqual(kEvent, *event);
+
+  chppWifiScanEventInPlaceRelease(event);
+}
+
+TEST_F(WifiScanStreamTest, RejectsInvalidNotification) {
+  ChppWifiScanEventWithHeader *notification = nullptr;
+  size_t len = 0;
+  ASSERT_TRUE(chppWifiScanEventFromChre(&kEvent, &notification, &len));
+  notification->payload.results.length--;
+
+  mAppContext.isRxDatagramKept = false;
+  EXPECT_EQ(chppWifiScanEventToChreInPlace(
+                &mAppContext, reinterpret_cast<uint8_t *>(notification), len),
+            nullptr);
+  EXPECT_FALSE(mAppContext.isRxDatagramKept);
+
+  chppFree(notification);
+}
+
+}  // namespace
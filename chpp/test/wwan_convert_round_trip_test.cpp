@@ -0,0 +1,547 @@
+/*
+ * Copyright (C) 2020 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file was automatically generated by chpp_code_generator.py
+// Date: 2026-10-18 15:20:03 UTC
+// Source: chre_api/include/chre_api/chre/wwan.h @ commit 9bc36aa9b
+
+// DO NOT modify this file directly, as those changes will be lost the next
+// time the script is executed
+
+#include <gtest/gtest.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+#include "chpp/app.h"
+#include "chpp/common/wwan_types.h"
+#include "chpp/macros.h"
+#include "chpp/memory.h"
+
+namespace {
+
+//! Seed of the random generator, fixed to make failures reproducible
+constexpr std::mt19937::result_type kSeed = 0x5eed;
+
+//! Number of random structures converted back and forth per root structure
+constexpr size_t kNumRoundTrips = 200;
+
+//! Maximum number of elements of the random variable-length arrays and strings
+constexpr size_t kMaxRandomLength = 8;
+
+//! Number of conversions timed per root structure by the benchmarks
+constexpr size_t kNumBenchmarkIterations = 10000;
+
+//! Expects a field to be bitwise identical in both structures, which also holds
+//! for floating-point NaNs
+#define EXPECT_SAME_FIELD(expected, actual, field)          \
+  EXPECT_EQ(std::memcmp(&(expected).field, &(actual).field, \
+                        sizeof((expected).field)),          \
+            0)                                              \
+      << #field
+
+void fillRandomBytes(std::mt19937 &rng, void *data, size_t size) {
+  auto *bytes = static_cast<uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    bytes[i] = static_cast<uint8_t>(rng());
+  }
+}
+
+//! Fills a field of a primitive type, overloaded below for the structures
+template <typename T>
+void fillRandom(std::mt19937 &rng, T *value) {
+  fillRandomBytes(rng, value, sizeof(*value));
+}
+
+//! @return The number of elements of a random variable-length array
+size_t randomLength(std::mt19937 &rng) {
+  return rng() % (kMaxRandomLength + 1);
+}
+
+//! @return One of the given values, e.g. of a union discriminator
+template <typename T, size_t N>
+T randomElement(std::mt19937 &rng, const T (&values)[N]) {
+  return values[rng() % N];
+}
+
+//! Expects the first count elements of both arrays to be bitwise identical
+template <typename T>
+void expectSameArray(const T *expected, const T *actual, size_t count) {
+  if (count > 0) {
+    EXPECT_EQ(std::memcmp(expected, actual, count * sizeof(T)), 0);
+  }
+}
+
+long long nsPerIteration(std::chrono::steady_clock::duration time) {
+  return static_cast<long long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() /
+      kNumBenchmarkIterations);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellIdentityCdma *value) {
+  fillRandom(rng, &value->networkId);
+  fillRandom(rng, &value->systemId);
+  fillRandom(rng, &value->basestationId);
+  fillRandom(rng, &value->longitude);
+  fillRandom(rng, &value->latitude);
+}
+
+void expectEqual(const chreWwanCellIdentityCdma &expected,
+                 const chreWwanCellIdentityCdma &actual) {
+  EXPECT_SAME_FIELD(expected, actual, networkId);
+  EXPECT_SAME_FIELD(expected, actual, systemId);
+  EXPECT_SAME_FIELD(expected, actual, basestationId);
+  EXPECT_SAME_FIELD(expected, actual, longitude);
+  EXPECT_SAME_FIELD(expected, actual, latitude);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanSignalStrengthCdma *value) {
+  fillRandom(rng, &value->dbm);
+  fillRandom(rng, &value->ecio);
+}
+
+void expectEqual(const chreWwanSignalStrengthCdma &expected,
+                 const chreWwanSignalStrengthCdma &actual) {
+  EXPECT_SAME_FIELD(expected, actual, dbm);
+  EXPECT_SAME_FIELD(expected, actual, ecio);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanSignalStrengthEvdo *value) {
+  fillRandom(rng, &value->dbm);
+  fillRandom(rng, &value->ecio);
+  fillRandom(rng, &value->signalNoiseRatio);
+}
+
+void expectEqual(const chreWwanSignalStrengthEvdo &expected,
+                 const chreWwanSignalStrengthEvdo &actual) {
+  EXPECT_SAME_FIELD(expected, actual, dbm);
+  EXPECT_SAME_FIELD(expected, actual, ecio);
+  EXPECT_SAME_FIELD(expected, actual, signalNoiseRatio);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfoCdma *value) {
+  fillRandom(rng, &value->cellIdentityCdma);
+  fillRandom(rng, &value->signalStrengthCdma);
+  fillRandom(rng, &value->signalStrengthEvdo);
+}
+
+void expectEqual(const chreWwanCellInfoCdma &expected,
+                 const chreWwanCellInfoCdma &actual) {
+  expectEqual(expected.cellIdentityCdma, actual.cellIdentityCdma);
+  expectEqual(expected.signalStrengthCdma, actual.signalStrengthCdma);
+  expectEqual(expected.signalStrengthEvdo, actual.signalStrengthEvdo);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellIdentityGsm *value) {
+  fillRandom(rng, &value->mcc);
+  fillRandom(rng, &value->mnc);
+  fillRandom(rng, &value->lac);
+  fillRandom(rng, &value->cid);
+  fillRandom(rng, &value->arfcn);
+  fillRandom(rng, &value->bsic);
+  memset(&value->reserved, 0, sizeof(value->reserved));
+}
+
+void expectEqual(const chreWwanCellIdentityGsm &expected,
+                 const chreWwanCellIdentityGsm &actual) {
+  EXPECT_SAME_FIELD(expected, actual, mcc);
+  EXPECT_SAME_FIELD(expected, actual, mnc);
+  EXPECT_SAME_FIELD(expected, actual, lac);
+  EXPECT_SAME_FIELD(expected, actual, cid);
+  EXPECT_SAME_FIELD(expected, actual, arfcn);
+  EXPECT_SAME_FIELD(expected, actual, bsic);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanSignalStrengthGsm *value) {
+  fillRandom(rng, &value->signalStrength);
+  fillRandom(rng, &value->bitErrorRate);
+  fillRandom(rng, &value->timingAdvance);
+}
+
+void expectEqual(const chreWwanSignalStrengthGsm &expected,
+                 const chreWwanSignalStrengthGsm &actual) {
+  EXPECT_SAME_FIELD(expected, actual, signalStrength);
+  EXPECT_SAME_FIELD(expected, actual, bitErrorRate);
+  EXPECT_SAME_FIELD(expected, actual, timingAdvance);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfoGsm *value) {
+  fillRandom(rng, &value->cellIdentityGsm);
+  fillRandom(rng, &value->signalStrengthGsm);
+}
+
+void expectEqual(const chreWwanCellInfoGsm &expected,
+                 const chreWwanCellInfoGsm &actual) {
+  expectEqual(expected.cellIdentityGsm, actual.cellIdentityGsm);
+  expectEqual(expected.signalStrengthGsm, actual.signalStrengthGsm);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellIdentityLte *value) {
+  fillRandom(rng, &value->mcc);
+  fillRandom(rng, &value->mnc);
+  fillRandom(rng, &value->ci);
+  fillRandom(rng, &value->pci);
+  fillRandom(rng, &value->tac);
+  fillRandom(rng, &value->earfcn);
+}
+
+void expectEqual(const chreWwanCellIdentityLte &expected,
+                 const chreWwanCellIdentityLte &actual) {
+  EXPECT_SAME_FIELD(expected, actual, mcc);
+  EXPECT_SAME_FIELD(expected, actual, mnc);
+  EXPECT_SAME_FIELD(expected, actual, ci);
+  EXPECT_SAME_FIELD(expected, actual, pci);
+  EXPECT_SAME_FIELD(expected, actual, tac);
+  EXPECT_SAME_FIELD(expected, actual, earfcn);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanSignalStrengthLte *value) {
+  fillRandom(rng, &value->signalStrength);
+  fillRandom(rng, &value->rsrp);
+  fillRandom(rng, &value->rsrq);
+  fillRandom(rng, &value->rssnr);
+  fillRandom(rng, &value->cqi);
+  fillRandom(rng, &value->timingAdvance);
+}
+
+void expectEqual(const chreWwanSignalStrengthLte &expected,
+                 const chreWwanSignalStrengthLte &actual) {
+  EXPECT_SAME_FIELD(expected, actual, signalStrength);
+  EXPECT_SAME_FIELD(expected, actual, rsrp);
+  EXPECT_SAME_FIELD(expected, actual, rsrq);
+  EXPECT_SAME_FIELD(expected, actual, rssnr);
+  EXPECT_SAME_FIELD(expected, actual, cqi);
+  EXPECT_SAME_FIELD(expected, actual, timingAdvance);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfoLte *value) {
+  fillRandom(rng, &value->cellIdentityLte);
+  fillRandom(rng, &value->signalStrengthLte);
+}
+
+void expectEqual(const chreWwanCellInfoLte &expected,
+                 const chreWwanCellInfoLte &actual) {
+  expectEqual(expected.cellIdentityLte, actual.cellIdentityLte);
+  expectEqual(expected.signalStrengthLte, actual.signalStrengthLte);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellIdentityNr *value) {
+  fillRandom(rng, &value->mcc);
+  fillRandom(rng, &value->mnc);
+  fillRandom(rng, &value->nci0);
+  fillRandom(rng, &value->nci1);
+  fillRandom(rng, &value->pci);
+  fillRandom(rng, &value->tac);
+  fillRandom(rng, &value->nrarfcn);
+}
+
+void expectEqual(const chreWwanCellIdentityNr &expected,
+                 const chreWwanCellIdentityNr &actual) {
+  EXPECT_SAME_FIELD(expected, actual, mcc);
+  EXPECT_SAME_FIELD(expected, actual, mnc);
+  EXPECT_SAME_FIELD(expected, actual, nci0);
+  EXPECT_SAME_FIELD(expected, actual, nci1);
+  EXPECT_SAME_FIELD(expected, actual, pci);
+  EXPECT_SAME_FIELD(expected, actual, tac);
+  EXPECT_SAME_FIELD(expected, actual, nrarfcn);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanSignalStrengthNr *value) {
+  fillRandom(rng, &value->ssRsrp);
+  fillRandom(rng, &value->ssRsrq);
+  fillRandom(rng, &value->ssSinr);
+  fillRandom(rng, &value->csiRsrp);
+  fillRandom(rng, &value->csiRsrq);
+  fillRandom(rng, &value->csiSinr);
+}
+
+void expectEqual(const chreWwanSignalStrengthNr &expected,
+                 const chreWwanSignalStrengthNr &actual) {
+  EXPECT_SAME_FIELD(expected, actual, ssRsrp);
+  EXPECT_SAME_FIELD(expected, actual, ssRsrq);
+  EXPECT_SAME_FIELD(expected, actual, ssSinr);
+  EXPECT_SAME_FIELD(expected, actual, csiRsrp);
+  EXPECT_SAME_FIELD(expected, actual, csiRsrq);
+  EXPECT_SAME_FIELD(expected, actual, csiSinr);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfoNr *value) {
+  fillRandom(rng, &value->cellIdentityNr);
+  fillRandom(rng, &value->signalStrengthNr);
+}
+
+void expectEqual(const chreWwanCellInfoNr &expected,
+                 const chreWwanCellInfoNr &actual) {
+  expectEqual(expected.cellIdentityNr, actual.cellIdentityNr);
+  expectEqual(expected.signalStrengthNr, actual.signalStrengthNr);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellIdentityTdscdma *value) {
+  fillRandom(rng, &value->mcc);
+  fillRandom(rng, &value->mnc);
+  fillRandom(rng, &value->lac);
+  fillRandom(rng, &value->cid);
+  fillRandom(rng, &value->cpid);
+}
+
+void expectEqual(const chreWwanCellIdentityTdscdma &expected,
+                 const chreWwanCellIdentityTdscdma &actual) {
+  EXPECT_SAME_FIELD(expected, actual, mcc);
+  EXPECT_SAME_FIELD(expected, actual, mnc);
+  EXPECT_SAME_FIELD(expected, actual, lac);
+  EXPECT_SAME_FIELD(expected, actual, cid);
+  EXPECT_SAME_FIELD(expected, actual, cpid);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanSignalStrengthTdscdma *value) {
+  fillRandom(rng, &value->rscp);
+}
+
+void expectEqual(const chreWwanSignalStrengthTdscdma &expected,
+                 const chreWwanSignalStrengthTdscdma &actual) {
+  EXPECT_SAME_FIELD(expected, actual, rscp);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfoTdscdma *value) {
+  fillRandom(rng, &value->cellIdentityTdscdma);
+  fillRandom(rng, &value->signalStrengthTdscdma);
+}
+
+void expectEqual(const chreWwanCellInfoTdscdma &expected,
+                 const chreWwanCellInfoTdscdma &actual) {
+  expectEqual(expected.cellIdentityTdscdma, actual.cellIdentityTdscdma);
+  expectEqual(expected.signalStrengthTdscdma, actual.signalStrengthTdscdma);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellIdentityWcdma *value) {
+  fillRandom(rng, &value->mcc);
+  fillRandom(rng, &value->mnc);
+  fillRandom(rng, &value->lac);
+  fillRandom(rng, &value->cid);
+  fillRandom(rng, &value->psc);
+  fillRandom(rng, &value->uarfcn);
+}
+
+void expectEqual(const chreWwanCellIdentityWcdma &expected,
+                 const chreWwanCellIdentityWcdma &actual) {
+  EXPECT_SAME_FIELD(expected, actual, mcc);
+  EXPECT_SAME_FIELD(expected, actual, mnc);
+  EXPECT_SAME_FIELD(expected, actual, lac);
+  EXPECT_SAME_FIELD(expected, actual, cid);
+  EXPECT_SAME_FIELD(expected, actual, psc);
+  EXPECT_SAME_FIELD(expected, actual, uarfcn);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanSignalStrengthWcdma *value) {
+  fillRandom(rng, &value->signalStrength);
+  fillRandom(rng, &value->bitErrorRate);
+}
+
+void expectEqual(const chreWwanSignalStrengthWcdma &expected,
+                 const chreWwanSignalStrengthWcdma &actual) {
+  EXPECT_SAME_FIELD(expected, actual, signalStrength);
+  EXPECT_SAME_FIELD(expected, actual, bitErrorRate);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfoWcdma *value) {
+  fillRandom(rng, &value->cellIdentityWcdma);
+  fillRandom(rng, &value->signalStrengthWcdma);
+}
+
+void expectEqual(const chreWwanCellInfoWcdma &expected,
+                 const chreWwanCellInfoWcdma &actual) {
+  expectEqual(expected.cellIdentityWcdma, actual.cellIdentityWcdma);
+  expectEqual(expected.signalStrengthWcdma, actual.signalStrengthWcdma);
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfo *value) {
+  fillRandom(rng, &value->timeStamp);
+  const uint8_t kCellInfoTypeValues[] = {
+      CHRE_WWAN_CELL_INFO_TYPE_GSM,
+      CHRE_WWAN_CELL_INFO_TYPE_CDMA,
+      CHRE_WWAN_CELL_INFO_TYPE_LTE,
+      CHRE_WWAN_CELL_INFO_TYPE_WCDMA,
+      CHRE_WWAN_CELL_INFO_TYPE_TD_SCDMA,
+      CHRE_WWAN_CELL_INFO_TYPE_NR,
+  };
+  value->cellInfoType = randomElement(rng, kCellInfoTypeValues);
+  fillRandom(rng, &value->timeStampType);
+  fillRandom(rng, &value->registered);
+  value->reserved = 0;
+  memset(&value->CellInfo, 0, sizeof(value->CellInfo));
+  switch (value->cellInfoType) {
+    case CHRE_WWAN_CELL_INFO_TYPE_GSM:
+      fillRandom(rng, &value->CellInfo.gsm);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_CDMA:
+      fillRandom(rng, &value->CellInfo.cdma);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_LTE:
+      fillRandom(rng, &value->CellInfo.lte);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_WCDMA:
+      fillRandom(rng, &value->CellInfo.wcdma);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_TD_SCDMA:
+      fillRandom(rng, &value->CellInfo.tdscdma);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_NR:
+      fillRandom(rng, &value->CellInfo.nr);
+      break;
+  }
+}
+
+void expectEqual(const chreWwanCellInfo &expected,
+                 const chreWwanCellInfo &actual) {
+  EXPECT_SAME_FIELD(expected, actual, timeStamp);
+  EXPECT_SAME_FIELD(expected, actual, cellInfoType);
+  EXPECT_SAME_FIELD(expected, actual, timeStampType);
+  EXPECT_SAME_FIELD(expected, actual, registered);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+  switch (expected.cellInfoType) {
+    case CHRE_WWAN_CELL_INFO_TYPE_GSM:
+      expectEqual(expected.CellInfo.gsm, actual.CellInfo.gsm);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_CDMA:
+      expectEqual(expected.CellInfo.cdma, actual.CellInfo.cdma);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_LTE:
+      expectEqual(expected.CellInfo.lte, actual.CellInfo.lte);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_WCDMA:
+      expectEqual(expected.CellInfo.wcdma, actual.CellInfo.wcdma);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_TD_SCDMA:
+      expectEqual(expected.CellInfo.tdscdma, actual.CellInfo.tdscdma);
+      break;
+    case CHRE_WWAN_CELL_INFO_TYPE_NR:
+      expectEqual(expected.CellInfo.nr, actual.CellInfo.nr);
+      break;
+  }
+}
+
+void fillRandom(std::mt19937 &rng, chreWwanCellInfoResult *value) {
+  value->version = CHRE_WWAN_CELL_INFO_RESULT_VERSION;
+  fillRandom(rng, &value->errorCode);
+  value->reserved = 0;
+  value->cookie = 0;
+  value->cellInfoCount = static_cast<uint8_t>(randomLength(rng));
+  if (value->cellInfoCount == 0) {
+    value->cells = nullptr;
+  } else {
+    size_t size = value->cellInfoCount * sizeof(chreWwanCellInfo);
+    auto *cells = static_cast<chreWwanCellInfo *>(chppMalloc(size));
+    ASSERT_NE(cells, nullptr);
+    for (size_t i = 0; i < value->cellInfoCount; i++) {
+      fillRandom(rng, &cells[i]);
+    }
+    value->cells = cells;
+  }
+}
+
+void expectEqual(const chreWwanCellInfoResult &expected,
+                 const chreWwanCellInfoResult &actual) {
+  EXPECT_SAME_FIELD(expected, actual, version);
+  EXPECT_SAME_FIELD(expected, actual, errorCode);
+  EXPECT_SAME_FIELD(expected, actual, reserved);
+  EXPECT_SAME_FIELD(expected, actual, cookie);
+  ASSERT_EQ(expected.cellInfoCount, actual.cellInfoCount);
+  for (size_t i = 0; i < expected.cellInfoCount; i++) {
+    expectEqual(expected.cells[i], actual.cells[i]);
+  }
+}
+
+void freeMembers(const chreWwanCellInfoResult &value) {
+  chppFree(CHPP_CONST_CAST_POINTER(value.cells));
+}
+
+}  // namespace
+
+// Round-trip tests, converting random structures from CHRE to CHPP and back
+
+TEST(WwanConvertRoundTripTest, CellInfoResult) {
+  std::mt19937 rng(kSeed);
+  for (size_t i = 0; i < kNumRoundTrips; i++) {
+    SCOPED_TRACE(i);
+    chreWwanCellInfoResult original;
+    fillRandom(rng, &original);
+
+    ChppWwanCellInfoResultWithHeader *encoded = nullptr;
+    size_t encodedSize = 0;
+    bool result =
+        chppWwanCellInfoResultFromChre(&original, &encoded, &encodedSize);
+    ASSERT_TRUE(result);
+    ASSERT_NE(encoded, nullptr);
+    size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+
+    chreWwanCellInfoResult *decoded =
+        chppWwanCellInfoResultToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    expectEqual(original, *decoded);
+
+    // Truncated payloads must be rejected rather than read out of bounds
+    chreWwanCellInfoResult *truncated =
+        chppWwanCellInfoResultToChre(&encoded->payload, payloadSize - 1);
+    EXPECT_EQ(truncated, nullptr);
+
+    freeMembers(*decoded);
+    chppFree(decoded);
+    chppFree(encoded);
+    freeMembers(original);
+  }
+}
+
+// Benchmarks of the conversions, to compare the bulk copies with the
+// field-by-field conversions across targets. Run with
+// --gtest_also_run_disabled_tests.
+
+TEST(WwanConvertBenchmark, DISABLED_CellInfoResult) {
+  std::mt19937 rng(kSeed);
+  chreWwanCellInfoResult original;
+  fillRandom(rng, &original);
+
+  ChppWwanCellInfoResultWithHeader *encoded = nullptr;
+  size_t encodedSize = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chppFree(encoded);
+    ASSERT_TRUE(chppWwanCellInfoResultFromChre(&original, &encoded,
+                                               &encodedSize));
+  }
+  auto encodeTime = std::chrono::steady_clock::now() - start;
+
+  size_t payloadSize = encodedSize - sizeof(ChppAppHeader);
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kNumBenchmarkIterations; i++) {
+    chreWwanCellInfoResult *decoded =
+        chppWwanCellInfoResultToChre(&encoded->payload, payloadSize);
+    ASSERT_NE(decoded, nullptr);
+    freeMembers(*decoded);
+    chppFree(decoded);
+  }
+  auto decodeTime = std::chrono::steady_clock::now() - start;
+
+  printf("chreWwanCellInfoResult: encode %lld ns, decode %lld ns\n",
+         nsPerIteration(encodeTime), nsPerIteration(decodeTime));
+  chppFree(encoded);
+  freeMembers(original);
+}
+
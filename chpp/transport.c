@@ -83,6 +83,10 @@ static void chppAppendToPendingTxPacket(struct ChppTransportState *context,
 static const char *chppGetPacketAttrStr(uint8_t packetCode);
 static bool chppEnqueueTxDatagram(struct ChppTransportState *context,
                                   uint8_t packetCode, void *buf, size_t len);
+static bool chppEnqueueTxDatagramEntry(struct ChppTransportState *context,
+                                       uint8_t packetCode,
+                                       const struct ChppDatagram *datagram);
+static void chppReleaseTxDatagram(struct ChppDatagram *datagram);
 static enum ChppLinkErrorCode chppSendPendingPacket(
     struct ChppTransportState *context);
 
@@ -889,13 +893,24 @@ static void chppAddPayload(struct ChppTransportState *context) {
     txHeader->length = (uint16_t)remainingBytes;
   }
 
-  // Copy payload
-  chppAppendToPendingTxPacket(
-      context,
-      context->txDatagramQueue.datagram[context->txDatagramQueue.front]
-              .payload +
-          context->txStatus.ackedLocInDatagram,
-      txHeader->length);
+  const struct ChppDatagram *datagram =
+      &context->txDatagramQueue.datagram[context->txDatagramQueue.front];
+  if (datagram->encoder != NULL) {
+    // Serialize the payload straight into the link Tx buffer
+    size_t bufferSize = context->linkBufferSize;
+    CHPP_ASSERT(bufferSize + txHeader->length <=
+                context->linkApi->getConfig(context->linkContext).txBufferLen);
+    datagram->encoder->encode(datagram->encoderContext,
+                              context->txStatus.ackedLocInDatagram,
+                              &linkTxBuffer[bufferSize], txHeader->length);
+    context->linkBufferSize += txHeader->length;
+
+  } else {
+    // Copy payload
+    chppAppendToPendingTxPacket(
+        context, datagram->payload + context->txStatus.ackedLocInDatagram,
+        txHeader->length);
+  }
 
   context->txStatus.sentLocInDatagram =
       context->txStatus.ackedLocInDatagram + txHeader->length;
@@ -942,11 +957,8 @@ size_t chppDequeueTxDatagram(struct ChppTransportState *context) {
               context->txDatagramQueue.pending,
               context->txDatagramQueue.pending - 1);
 
-    CHPP_FREE_AND_NULLIFY(
-        context->txDatagramQueue.datagram[context->txDatagramQueue.front]
-            .payload);
-    context->txDatagramQueue.datagram[context->txDatagramQueue.front].length =
-        0;
+    chppReleaseTxDatagram(
+        &context->txDatagramQueue.datagram[context->txDatagramQueue.front]);
 
     context->txDatagramQueue.pending--;
     context->txDatagramQueue.front++;
@@ -956,6 +968,23 @@ size_t chppDequeueTxDatagram(struct ChppTransportState *context) {
   return context->txDatagramQueue.pending;
 }
 
+/**
+ * Frees the payload of a Tx datagram, or releases its encoder context, and
+ * marks it as empty.
+ *
+ * @param datagram Tx datagram to be released.
+ */
+static void chppReleaseTxDatagram(struct ChppDatagram *datagram) {
+  if (datagram->encoder != NULL) {
+    datagram->encoder->release(datagram->encoderContext);
+    datagram->encoder = NULL;
+    datagram->encoderContext = NULL;
+  } else {
+    CHPP_FREE_AND_NULLIFY(datagram->payload);
+  }
+  datagram->length = 0;
+}
+
 /**
  * Flushes the Tx datagram queue of any pending packets.
  *
@@ -1154,7 +1183,29 @@ static const char *chppGetPacketAttrStr(uint8_t packetCode) {
  */
 static bool chppEnqueueTxDatagram(struct ChppTransportState *context,
                                   uint8_t packetCode, void *buf, size_t len) {
+  const struct ChppDatagram datagram = {
+      .length = len,
+      .payload = buf,
+  };
+  return chppEnqueueTxDatagramEntry(context, packetCode, &datagram);
+}
+
+/**
+ * Enqueues an outgoing datagram, either backed by a payload buffer or by an
+ * encoder. See chppEnqueueTxDatagram().
+ *
+ * @param context State of the transport layer.
+ * @param packetCode Error code and packet attributes to be sent.
+ * @param datagram Datagram to be copied to the queue.
+ *
+ * @return True informs the sender that the datagram was successfully enqueued.
+ * False informs the sender that the queue was full.
+ */
+static bool chppEnqueueTxDatagramEntry(struct ChppTransportState *context,
+                                       uint8_t packetCode,
+                                       const struct ChppDatagram *datagram) {
   bool success = false;
+  size_t len = datagram->length;
 
   if (len == 0) {
     CHPP_DEBUG_ASSERT_LOG(false, "Enqueue TX len=0!");
@@ -1167,7 +1218,15 @@ static bool chppEnqueueTxDatagram(struct ChppTransportState *context,
                 packetCode, chppGetPacketAttrStr(packetCode), len,
                 (uint8_t)(context->txDatagramQueue.pending + 1));
     } else {
-      struct ChppAppHeader *header = buf;
+      struct ChppAppHeader encodedHeader;
+      const struct ChppAppHeader *header =
+          (const struct ChppAppHeader *)datagram->payload;
+      if (datagram->encoder != NULL) {
+        datagram->encoder->encode(datagram->encoderContext, 0,
+                                  (uint8_t *)&encodedHeader,
+                                  sizeof(encodedHeader));
+        header = &encodedHeader;
+      }
       CHPP_LOGD(
           "Enqueue TX: len=%" PRIuSIZE " H#%" PRIu8 " type=0x%" PRIx8
           " ID=%" PRIu8 " err=%" PRIu8 " cmd=0x%" PRIx16 " pending=%" PRIu8,
@@ -1184,8 +1243,7 @@ static bool chppEnqueueTxDatagram(struct ChppTransportState *context,
       uint16_t end =
           (context->txDatagramQueue.front + context->txDatagramQueue.pending) %
           CHPP_TX_DATAGRAM_QUEUE_LEN;
-      context->txDatagramQueue.datagram[end].length = len;
-      context->txDatagramQueue.datagram[end].payload = buf;
+      context->txDatagramQueue.datagram[end] = *datagram;
       context->txDatagramQueue.pending++;
 
       if (context->txDatagramQueue.pending == 1) {
@@ -1278,8 +1336,7 @@ static void chppReset(struct ChppTransportState *transportContext,
   // Free memory allocated for any ongoing tx datagrams
   for (size_t i = 0; i < CHPP_TX_DATAGRAM_QUEUE_LEN; i++) {
     if (transportContext->txDatagramQueue.datagram[i].length > 0) {
-      CHPP_FREE_AND_NULLIFY(
-          transportContext->txDatagramQueue.datagram[i].payload);
+      chppReleaseTxDatagram(&transportContext->txDatagramQueue.datagram[i]);
     }
   }
 
@@ -1557,6 +1614,38 @@ bool chppEnqueueTxDatagramOrFail(struct ChppTransportState *context, void *buf,
   return success;
 }
 
+bool chppEnqueueTxEncodedDatagramOrFail(
+    struct ChppTransportState *context,
+    const struct ChppTxDatagramEncoder *encoder, void *encoderContext,
+    size_t len) {
+  CHPP_NOT_NULL(encoder);
+
+  bool success = false;
+  bool resetting = (context->resetState == CHPP_RESET_STATE_RESETTING);
+  const struct ChppDatagram datagram = {
+      .length = len,
+      .encoder = encoder,
+      .encoderContext = encoderContext,
+  };
+
+  if (len == 0) {
+    CHPP_DEBUG_ASSERT_LOG(false, "Enqueue datagram len=0!");
+    encoder->release(encoderContext);
+
+  } else if (resetting ||
+             !chppEnqueueTxDatagramEntry(context, CHPP_TRANSPORT_ERROR_NONE,
+                                         &datagram)) {
+    CHPP_LOGE("Resetting=%d. Discarding %" PRIuSIZE " encoded bytes", resetting,
+              len);
+    encoder->release(encoderContext);
+
+  } else {
+    success = true;
+  }
+
+  return success;
+}
+
 // TODO(b/192359485): Consider removing this function, or making it more robust.
 void chppEnqueueTxErrorDatagram(struct ChppTransportState *context,
                                 enum ChppTransportErrorCode errorCode) {
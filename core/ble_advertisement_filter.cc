@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/core/ble_advertisement_filter.h"
+
+#include <cstring>
+
+namespace chre {
+
+BleAdvertisementFilter::BleAdvertisementFilter(const BleRequest &request)
+    : mRequest(request) {
+  for (const chreBleGenericFilter &filter : request.getGenericFilters()) {
+    mAdTypes[filter.type / 32] |= UINT32_C(1) << (filter.type % 32);
+  }
+  mMatchesAll = request.getRssiThreshold() == CHRE_BLE_RSSI_THRESHOLD_NONE &&
+                request.getGenericFilters().empty() &&
+                request.getBroadcasterFilters().empty();
+}
+
+bool BleAdvertisementFilter::matches(
+    const chreBleAdvertisingReport &report) const {
+  if (mMatchesAll) {
+    return true;
+  }
+
+  // Reports without an RSSI can't be filtered on it
+  if (report.rssi != CHRE_BLE_RSSI_NONE &&
+      report.rssi < mRequest.getRssiThreshold()) {
+    return false;
+  }
+
+  if (mRequest.getGenericFilters().empty() &&
+      mRequest.getBroadcasterFilters().empty()) {
+    return true;
+  }
+  return matchesBroadcasterFilters(report) || matchesGenericFilters(report);
+}
+
+bool BleAdvertisementFilter::matchesGenericFilters(
+    const chreBleAdvertisingReport &report) const {
+  if (report.data == nullptr) {
+    return false;
+  }
+
+  // Each AD structure is a length byte, covering the AD type byte and the AD
+  // data, followed by the AD type and the AD data
+  size_t offset = 0;
+  while (offset + 1 < report.dataLength) {
+    uint8_t length = report.data[offset];
+    if (length == 0 || offset + 1 + length > report.dataLength) {
+      // Zero padding or truncated AD structure
+      break;
+    }
+
+    uint8_t type = report.data[offset + 1];
+    if (hasAdType(type)) {
+      const uint8_t *adData = &report.data[offset + 2];
+      size_t adDataLength = length - 1;
+      for (const chreBleGenericFilter &filter : mRequest.getGenericFilters()) {
+        if (filter.type != type || filter.len > adDataLength ||
+            filter.len > CHRE_BLE_DATA_LEN_MAX) {
+          continue;
+        }
+
+        bool match = true;
+        for (uint8_t i = 0; i < filter.len && match; i++) {
+          match = ((adData[i] ^ filter.data[i]) & filter.dataMask[i]) == 0;
+        }
+        if (match) {
+          return true;
+        }
+      }
+    }
+    offset += 1 + length;
+  }
+  return false;
+}
+
+bool BleAdvertisementFilter::matchesBroadcasterFilters(
+    const chreBleAdvertisingReport &report) const {
+  for (const chreBleBroadcasterAddressFilter &filter :
+       mRequest.getBroadcasterFilters()) {
+    if (memcmp(filter.broadcasterAddress, report.address,
+               CHRE_BLE_ADDRESS_LEN) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace chre
@@ -123,8 +123,7 @@ bool BleRequest::mergeWith(const BleRequest &request) {
       attributesChanged = true;
     }
   }
-  const DynamicVector<chreBleGenericFilter> &otherFilters =
-      request.mGenericFilters;
+  const GenericFilterList &otherFilters = request.mGenericFilters;
   for (const chreBleGenericFilter &otherFilter : otherFilters) {
     bool addFilter = true;
     for (const chreBleGenericFilter &filter : mGenericFilters) {
@@ -140,8 +139,8 @@ bool BleRequest::mergeWith(const BleRequest &request) {
       }
     }
   }
-  const DynamicVector<chreBleBroadcasterAddressFilter>
-      &otherBroadcasterFilters = request.mBroadcasterFilters;
+  const BroadcasterFilterList &otherBroadcasterFilters =
+      request.mBroadcasterFilters;
   for (const chreBleBroadcasterAddressFilter &otherFilter :
        otherBroadcasterFilters) {
     bool addFilter = true;
@@ -162,10 +161,9 @@ bool BleRequest::mergeWith(const BleRequest &request) {
 }
 
 bool BleRequest::isEquivalentTo(const BleRequest &request) {
-  const DynamicVector<chreBleGenericFilter> &otherFilters =
-      request.mGenericFilters;
-  const DynamicVector<chreBleBroadcasterAddressFilter>
-      &otherBroadcasterFilters = request.mBroadcasterFilters;
+  const GenericFilterList &otherFilters = request.mGenericFilters;
+  const BroadcasterFilterList &otherBroadcasterFilters =
+      request.mBroadcasterFilters;
   bool isEquivalent =
       (mEnabled && request.mEnabled && mMode == request.mMode &&
        mReportDelayMs == request.mReportDelayMs &&
@@ -214,13 +212,12 @@ void BleRequest::setRequestStatus(RequestStatus status) {
   mStatus = status;
 }
 
-const DynamicVector<chreBleGenericFilter> &BleRequest::getGenericFilters()
-    const {
+const BleRequest::GenericFilterList &BleRequest::getGenericFilters() const {
   return mGenericFilters;
 }
 
-const DynamicVector<chreBleBroadcasterAddressFilter> &
-BleRequest::getBroadcasterFilters() const {
+const BleRequest::BroadcasterFilterList &BleRequest::getBroadcasterFilters()
+    const {
   return mBroadcasterFilters;
 }
 
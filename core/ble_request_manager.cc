@@ -264,12 +264,14 @@ void BleRequestManager::handleFreeAdvertisingEvent(
   mPlatformBle.releaseAdvertisingEvent(event);
 }
 
-void BleRequestManager::freeAdvertisingEventCallback(uint16_t /* eventType */,
-                                                     void *eventData) {
-  auto event = static_cast<chreBleAdvertisementEvent *>(eventData);
+void BleRequestManager::freeFilteredAdvertisementEventCallback(
+    uint16_t /* eventType */, void *eventData) {
+  auto *filteredEvent = static_cast<FilteredAdvertisementEvent *>(eventData);
+  SharedAdvertisementEvent *source = filteredEvent->source;
+  memoryFree(filteredEvent);
   EventLoopManagerSingleton::get()
       ->getBleRequestManager()
-      .handleFreeAdvertisingEvent(event);
+      .releaseSharedAdvertisementEvent(source);
 }
 
 void BleRequestManager::handleAdvertisementEvent(
@@ -278,8 +280,122 @@ void BleRequestManager::handleAdvertisementEvent(
     populateLegacyAdvertisingReportFields(
         const_cast<chreBleAdvertisingReport &>(event->reports[i]));
   }
+
+  // The requests can only be accessed from the event loop thread
+  auto callback = [](uint16_t /* type */, void *data, void * /* extraData */) {
+    EventLoopManagerSingleton::get()
+        ->getBleRequestManager()
+        .handleAdvertisementEventSync(
+            static_cast<chreBleAdvertisementEvent *>(data));
+  };
+  if (!EventLoopManagerSingleton::get()->deferCallback(
+          SystemCallbackType::BleAdvertisementEvent, event, callback)) {
+    FATAL_ERROR("Failed to defer BLE advertisement event");
+  }
+}
+
+void BleRequestManager::handleAdvertisementEventSync(
+    struct chreBleAdvertisementEvent *event) {
+  auto *source = memoryAlloc<SharedAdvertisementEvent>();
+  if (source == nullptr) {
+    LOG_OOM();
+    handleFreeAdvertisingEvent(event);
+    return;
+  }
+
+  source->event = event;
+  source->refCount = 1;
+  for (const BleRequest &request : mRequests.getRequests()) {
+    if (request.isEnabled()) {
+      BleAdvertisementFilter filter(request);
+      postFilteredAdvertisementEvent(source, request.getInstanceId(), &filter);
+    }
+  }
+
+  // Nanoapps registered for advertising events without an enabled request of
+  // their own receive every report, as they did when the event was broadcast.
+  struct UnfilteredRecipients {
+    BleRequestManager *manager;
+    SharedAdvertisementEvent *source;
+    Event broadcastEvent;
+  } recipients{this, source,
+               Event(CHRE_EVENT_BLE_ADVERTISEMENT, event,
+                     /* freeCallback= */ nullptr, /* isLowPriority= */ false)};
+  auto callback = [](const Nanoapp *nanoapp, void *data) {
+    auto *recipients = static_cast<UnfilteredRecipients *>(data);
+    if (nanoapp->isRegisteredForBroadcastEvent(&recipients->broadcastEvent)) {
+      const BleRequest *request = recipients->manager->mRequests.findRequest(
+          nanoapp->getInstanceId(), /* index= */ nullptr);
+      if (request == nullptr || !request->isEnabled()) {
+        recipients->manager->postFilteredAdvertisementEvent(
+            recipients->source, nanoapp->getInstanceId(),
+            /* filter= */ nullptr);
+      }
+    }
+  };
+  EventLoopManagerSingleton::get()->getEventLoop().forEachNanoapp(callback,
+                                                                 &recipients);
+  releaseSharedAdvertisementEvent(source);
+}
+
+void BleRequestManager::postFilteredAdvertisementEvent(
+    SharedAdvertisementEvent *source, uint16_t instanceId,
+    const BleAdvertisementFilter *filter) {
+  const chreBleAdvertisementEvent &event = *source->event;
+  uint16_t numMatchingReports = event.numReports;
+  if (filter != nullptr) {
+    numMatchingReports = 0;
+    for (uint16_t i = 0; i < event.numReports; i++) {
+      if (filter->matches(event.reports[i])) {
+        numMatchingReports++;
+      }
+    }
+  }
+  if (numMatchingReports == 0) {
+    return;
+  }
+
+  // Only copy the matching reports if some reports must be filtered out
+  bool copyReports = (numMatchingReports != event.numReports);
+  size_t size = sizeof(FilteredAdvertisementEvent);
+  if (copyReports) {
+    size += numMatchingReports * sizeof(chreBleAdvertisingReport);
+  }
+  auto *filteredEvent =
+      static_cast<FilteredAdvertisementEvent *>(memoryAlloc(size));
+  if (filteredEvent == nullptr) {
+    LOG_OOM();
+    return;
+  }
+
+  filteredEvent->event = event;
+  filteredEvent->source = source;
+  if (copyReports) {
+    auto *reports =
+        reinterpret_cast<chreBleAdvertisingReport *>(filteredEvent + 1);
+    uint16_t numCopiedReports = 0;
+    for (uint16_t i = 0; i < event.numReports; i++) {
+      if (filter->matches(event.reports[i])) {
+        reports[numCopiedReports++] = event.reports[i];
+      }
+    }
+    filteredEvent->event.reports = reports;
+    filteredEvent->event.numReports = numMatchingReports;
+  }
+
+  source->refCount++;
   EventLoopManagerSingleton::get()->getEventLoop().postEventOrDie(
-      CHRE_EVENT_BLE_ADVERTISEMENT, event, freeAdvertisingEventCallback);
+      CHRE_EVENT_BLE_ADVERTISEMENT, filteredEvent,
+      freeFilteredAdvertisementEventCallback, instanceId);
+}
+
+void BleRequestManager::releaseSharedAdvertisementEvent(
+    SharedAdvertisementEvent *source) {
+  CHRE_ASSERT(source->refCount > 0);
+  if (--source->refCount == 0) {
+    handleFreeAdvertisingEvent(source->event);
+    memoryFree(source);
+  }
 }
 
 void BleRequestManager::handlePlatformChange(bool enable, uint8_t errorCode) {
@@ -11,14 +11,17 @@ COMMON_CFLAGS += -I$(CHRE_PREFIX)/core/include
 
 COMMON_SRCS += $(CHRE_PREFIX)/core/debug_dump_manager.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/event.cc
+COMMON_SRCS += $(CHRE_PREFIX)/core/event_latency_stats.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/event_loop.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/event_loop_manager.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/event_ref_queue.cc
+COMMON_SRCS += $(CHRE_PREFIX)/core/heap_profiler.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/host_comms_manager.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/host_endpoint_manager.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/init.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/log.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/nanoapp.cc
+COMMON_SRCS += $(CHRE_PREFIX)/core/nanoapp_index.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/settings.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/static_nanoapps.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/system_health_monitor.cc
@@ -31,6 +34,7 @@ endif
 
 # Optional BLE support.
 ifeq ($(CHRE_BLE_SUPPORT_ENABLED), true)
+COMMON_SRCS += $(CHRE_PREFIX)/core/ble_advertisement_filter.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/ble_request.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/ble_request_manager.cc
 COMMON_SRCS += $(CHRE_PREFIX)/core/ble_request_multiplexer.cc
@@ -41,6 +45,15 @@ ifeq ($(CHRE_GNSS_SUPPORT_ENABLED), true)
 COMMON_SRCS += $(CHRE_PREFIX)/core/gnss_manager.cc
 endif
 
+# Optional inference support.
+ifeq ($(CHRE_INFERENCE_SUPPORT_ENABLED), true)
+COMMON_SRCS += $(CHRE_PREFIX)/core/inference_manager.cc
+ifeq ($(USE_TFLM), true)
+COMMON_SRCS += $(CHRE_PREFIX)/core/tflm_inference_backend.cc
+COMMON_CFLAGS += -DCHRE_INFERENCE_TFLM_BACKEND_ENABLED
+endif
+endif
+
 # Optional sensors support.
 ifeq ($(CHRE_SENSORS_SUPPORT_ENABLED), true)
 COMMON_SRCS += $(CHRE_PREFIX)/core/sensor.cc
@@ -80,8 +93,11 @@ endif
 # GoogleTest Source Files ######################################################
 
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/audio_util_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/ble_advertisement_filter_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/ble_request_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/heap_profiler_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/memory_manager_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/nanoapp_index_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/request_multiplexer_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/sensor_request_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/core/tests/wifi_scan_request_test.cc
@@ -92,6 +92,9 @@ void DebugDumpManager::collectFrameworkDebugDumps() {
 #ifdef CHRE_BLE_SUPPORT_ENABLED
   eventLoopManager->getBleRequestManager().logStateToBuffer(mDebugDump);
 #endif  // CHRE_BLE_SUPPORT_ENABLED
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+  eventLoopManager->getInferenceManager().logStateToBuffer(mDebugDump);
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
   eventLoopManager->getSettingManager().logStateToBuffer(mDebugDump);
   logStateToBuffer(mDebugDump);
 }
@@ -28,4 +28,10 @@ uint16_t Event::getTimeMillis() {
   return static_cast<uint16_t>(now.getMilliseconds());
 }
 
+uint16_t Event::getMillisSinceReceived(Nanoseconds now) const {
+  uint16_t nowMillis =
+      static_cast<uint16_t>(Milliseconds(now).getMilliseconds());
+  return static_cast<uint16_t>(nowMillis - receivedTimeMillis);
+}
+
 }  // namespace chre
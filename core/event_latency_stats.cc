@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/core/event_latency_stats.h"
+
+#include <cinttypes>
+
+namespace chre {
+
+constexpr size_t EventLatencyStats::kNumQueueDelayBuckets;
+constexpr size_t EventLatencyStats::kNumProcessTimeBuckets;
+
+void EventLatencyStats::logHeaderToBuffer(DebugDumpWrapper &debugDump,
+                                          const char *label) {
+  debugDump.print("\n%26s| Queue Delay (ms)%12s| Process Time (us)\n", label,
+                  "");
+  debugDump.print("%26s|     p50 |     p90 |     p99 |     p50 |     p90 |"
+                  "     p99 |   Count\n",
+                  "");
+}
+
+void EventLatencyStats::logEntryToBuffer(DebugDumpWrapper &debugDump,
+                                         const char *label) const {
+  debugDump.print("%25s |", label);
+  debugDump.print(" %7" PRIu64 " |", mQueueDelayMs.getPercentile(50));
+  debugDump.print(" %7" PRIu64 " |", mQueueDelayMs.getPercentile(90));
+  debugDump.print(" %7" PRIu64 " |", mQueueDelayMs.getPercentile(99));
+  debugDump.print(" %7" PRIu64 " |", mProcessTimeUs.getPercentile(50));
+  debugDump.print(" %7" PRIu64 " |", mProcessTimeUs.getPercentile(90));
+  debugDump.print(" %7" PRIu64 " |", mProcessTimeUs.getPercentile(99));
+  debugDump.print(" %7" PRIu32 "\n", mProcessTimeUs.getTotalCount());
+}
+
+}  // namespace chre
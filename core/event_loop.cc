@@ -17,6 +17,7 @@
 #include "chre/core/event_loop.h"
 #include <cinttypes>
 #include <cstdint>
+#include <cstdio>
 
 #include "chre/core/event.h"
 #include "chre/core/event_loop_manager.h"
@@ -27,6 +28,7 @@
 #include "chre/platform/system_time.h"
 #include "chre/util/conditional_lock_guard.h"
 #include "chre/util/lock_guard.h"
+#include "chre/util/non_copyable.h"
 #include "chre/util/system/debug_dump.h"
 #include "chre/util/system/event_callbacks.h"
 #include "chre/util/system/stats_container.h"
@@ -37,9 +39,37 @@ namespace chre {
 
 // Out of line declaration required for nonintegral static types
 constexpr Nanoseconds EventLoop::kIntervalWakeupBucket;
+constexpr size_t EventLoop::kMaxProfiledEventTypes;
+constexpr Nanoseconds EventLoop::kEventProcessBudget;
+constexpr uint8_t EventLoop::kRepeatOffenderOverrunCount;
+constexpr Nanoseconds EventLoop::kBudgetOverrunWindow;
+constexpr size_t EventLoop::kMaxBudgetOffenders;
 
 namespace {
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+//! The event loop run by the current thread, set when the thread starts
+//! running nanoapps in it.
+thread_local EventLoop *tCurrentEventLoop = nullptr;
+
+//! Makes an event loop the current one of the calling thread for the lifetime
+//! of this object, then restores the previous one.
+class ScopedCurrentEventLoop : public NonCopyable {
+ public:
+  explicit ScopedCurrentEventLoop(EventLoop *eventLoop)
+      : mPreviousEventLoop(tCurrentEventLoop) {
+    tCurrentEventLoop = eventLoop;
+  }
+
+  ~ScopedCurrentEventLoop() {
+    tCurrentEventLoop = mPreviousEventLoop;
+  }
+
+ private:
+  EventLoop *const mPreviousEventLoop;
+};
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 #ifndef CHRE_STATIC_EVENT_LOOP
 using DynamicMemoryPool =
     SynchronizedExpandableMemoryPool<Event, CHRE_EVENT_PER_BLOCK,
@@ -94,6 +124,32 @@ bool isLowPriorityEvent(Event *event, void * /* data */,
   return event->isLowPriority;
 }
 
+/**
+ * @return true if a event is a low priority event targeting a nanoapp that
+ * repeatedly exceeded its event process budget.
+ *
+ * @param data The list of budget offenders, of type
+ *     FixedSizeVector<EventLoop::BudgetOffender, N>.
+ * @param extraData The current time, of type Nanoseconds.
+ */
+template <typename OffenderList>
+bool isLowPriorityEventForRepeatOffender(Event *event, void *data,
+                                         void *extraData) {
+  CHRE_ASSERT_NOT_NULL(event);
+  if (!event->isLowPriority) {
+    return false;
+  }
+
+  const auto *offenders = static_cast<const OffenderList *>(data);
+  Nanoseconds now = *static_cast<Nanoseconds *>(extraData);
+  for (const auto &offender : *offenders) {
+    if (offender.instanceId == event->targetInstanceId) {
+      return offender.isRepeatOffender(now);
+    }
+  }
+  return false;
+}
+
 void deallocateFromMemoryPool(Event *event, void *memoryPool) {
   static_cast<DynamicMemoryPool *>(memoryPool)->deallocate(event);
 }
@@ -101,25 +157,43 @@ void deallocateFromMemoryPool(Event *event, void *memoryPool) {
 
 }  // anonymous namespace
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+EventLoop *EventLoop::getCurrentThreadEventLoop() {
+  return tCurrentEventLoop;
+}
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
+bool EventLoop::isCurrentThread() const {
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  return tCurrentEventLoop == this;
+#else
+  return inEventLoopThread();
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+}
+
 bool EventLoop::findNanoappInstanceIdByAppId(uint64_t appId,
                                              uint16_t *instanceId) const {
   CHRE_ASSERT(instanceId != nullptr);
-  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !inEventLoopThread());
 
-  bool found = false;
-  for (const UniquePtr<Nanoapp> &app : mNanoapps) {
-    if (app->getAppId() == appId) {
-      *instanceId = app->getInstanceId();
-      found = true;
-      break;
-    }
+  // Host messages look up their recipient from other threads, so try to do it
+  // without contending on mNanoappsLock first
+  NanoappIndex::LookupResult result =
+      mNanoappIndex.findInstanceIdByAppId(appId, instanceId);
+  if (result == NanoappIndex::LookupResult::Found ||
+      result == NanoappIndex::LookupResult::NotFound) {
+    return result == NanoappIndex::LookupResult::Found;
   }
 
-  return found;
+  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !isCurrentThread());
+  Nanoapp *nanoapp = lookupAppByAppId(appId);
+  if (nanoapp != nullptr) {
+    *instanceId = nanoapp->getInstanceId();
+  }
+  return nanoapp != nullptr;
 }
 
 void EventLoop::forEachNanoapp(NanoappCallbackFunction *callback, void *data) {
-  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !inEventLoopThread());
+  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !isCurrentThread());
 
   for (const UniquePtr<Nanoapp> &nanoapp : mNanoapps) {
     callback(nanoapp.get(), data);
@@ -142,6 +216,9 @@ void EventLoop::invokeMessageFreeFunction(uint64_t appId,
 
 void EventLoop::run() {
   LOGI("EventLoop start");
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  tCurrentEventLoop = this;
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
 
   while (mRunning) {
     // Events are delivered in a single stage: they arrive in the inbound event
@@ -178,9 +255,14 @@ bool EventLoop::startNanoapp(UniquePtr<Nanoapp> &nanoapp) {
   CHRE_ASSERT(!nanoapp.isNull());
   bool success = false;
   auto *eventLoopManager = EventLoopManagerSingleton::get();
-  EventLoop &eventLoop = eventLoopManager->getEventLoop();
   uint16_t existingInstanceId;
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  // Nanoapps may be started from another thread, e.g. before run() is called,
+  // so make this the current event loop while starting it.
+  ScopedCurrentEventLoop currentEventLoop(this);
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
   if (nanoapp.isNull()) {
     // no-op, invalid argument
   } else if (nanoapp->getTargetApiVersion() <
@@ -189,20 +271,38 @@ bool EventLoop::startNanoapp(UniquePtr<Nanoapp> &nanoapp) {
          ", first supported ver 0x%" PRIx32 ")",
          nanoapp->getTargetApiVersion(),
          static_cast<uint32_t>(CHRE_FIRST_SUPPORTED_API_VERSION));
-  } else if (eventLoop.findNanoappInstanceIdByAppId(nanoapp->getAppId(),
-                                                    &existingInstanceId)) {
+  } else if (eventLoopManager->findNanoappInstanceIdByAppId(
+                 nanoapp->getAppId(), &existingInstanceId)) {
     LOGE("App with ID 0x%016" PRIx64 " already exists as instance ID %" PRIu16,
          nanoapp->getAppId(), existingInstanceId);
   } else {
     Nanoapp *newNanoapp = nanoapp.get();
+    uint64_t appId = newNanoapp->getAppId();
+    uint16_t instanceId = newNanoapp->getInstanceId();
+    bool indexed = true;
     {
       LockGuard<Mutex> lock(mNanoappsLock);
       success = mNanoapps.push_back(std::move(nanoapp));
       // After this point, nanoapp is null as we've transferred ownership into
       // mNanoapps.back() - use newNanoapp to reference it
+      if (success) {
+        indexed = mNanoappIndex.add(appId, instanceId, newNanoapp);
+        if (!indexed) {
+          mNanoapps.pop_back();
+          success = false;
+        }
+      }
     }
+    // The app ID was checked above and instance IDs are unique, so a duplicate
+    // means the index is out of sync with the nanoapps
+    CHRE_ASSERT_LOG(indexed,
+                    "App ID 0x%016" PRIx64 " or instance ID %" PRIu16
+                    " already indexed",
+                    appId, instanceId);
     if (!success) {
-      LOG_OOM();
+      if (indexed) {
+        LOG_OOM();
+      }
     } else {
       mCurrentApp = newNanoapp;
       success = newNanoapp->start();
@@ -280,11 +380,32 @@ bool EventLoop::removeLowPriorityEventsFromBack([[maybe_unused]] size_t removeNu
     return true;
   }
 
-  size_t numRemovedEvent =
-      mEvents.removeMatchedFromBack(isLowPriorityEvent, /* data= */ nullptr,
-                                    /* extraData= */ nullptr, removeNum,
-                                    deallocateFromMemoryPool, &mEventPool);
-  if (numRemovedEvent == 0 || numRemovedEvent == SIZE_MAX) {
+  size_t numRemovedEvent = 0;
+  {
+    LockGuard<Mutex> lock(mBudgetOffendersLock);
+    if (!mBudgetOffenders.empty()) {
+      Nanoseconds now = SystemTime::getMonotonicTime();
+      numRemovedEvent = mEvents.removeMatchedFromBack(
+          isLowPriorityEventForRepeatOffender<decltype(mBudgetOffenders)>,
+          &mBudgetOffenders, &now, removeNum, deallocateFromMemoryPool,
+          &mEventPool);
+      if (numRemovedEvent == SIZE_MAX) {
+        numRemovedEvent = 0;
+      }
+    }
+  }
+
+  if (numRemovedEvent < removeNum) {
+    size_t numRemovedOtherEvent = mEvents.removeMatchedFromBack(
+        isLowPriorityEvent, /* data= */ nullptr,
+        /* extraData= */ nullptr, removeNum - numRemovedEvent,
+        deallocateFromMemoryPool, &mEventPool);
+    if (numRemovedOtherEvent != SIZE_MAX) {
+      numRemovedEvent += numRemovedOtherEvent;
+    }
+  }
+
+  if (numRemovedEvent == 0) {
     LOGW("Cannot remove any low priority event");
   } else {
     mNumDroppedLowPriEvents += numRemovedEvent;
@@ -307,11 +428,10 @@ bool EventLoop::deliverEventSync(uint16_t nanoappInstanceId,
               /* senderInstanceId= */ kSystemInstanceId,
               /* targetInstanceId= */ nanoappInstanceId,
               kDefaultTargetGroupMask);
-  for (const UniquePtr<Nanoapp> &app : mNanoapps) {
-    if (app->getInstanceId() == nanoappInstanceId) {
-      deliverNextEvent(app, &event);
-      return true;
-    }
+  Nanoapp *app = lookupAppByInstanceId(nanoappInstanceId);
+  if (app != nullptr) {
+    deliverNextEvent(*app, &event);
+    return true;
   }
 
   return false;
@@ -349,7 +469,7 @@ bool EventLoop::postSystemEvent(uint16_t eventType, void *eventData,
   }
 
   Event *event = mEventPool.allocate(eventType, eventData, callback, extraData);
-  if (event == nullptr || !mEvents.push(event)) {
+  if (event == nullptr || !pushEvent(event, EventPriority::System)) {
     FATAL_ERROR("Failed to post critical system event 0x%" PRIx16
                 ": out of memory",
                 eventType);
@@ -358,6 +478,51 @@ bool EventLoop::postSystemEvent(uint16_t eventType, void *eventData,
   return true;
 }
 
+bool EventLoop::setEventTypePriority(uint16_t eventType,
+                                     EventPriority priority) {
+  LockGuard<Mutex> lock(mEventPriorityOverridesLock);
+  for (EventPriorityOverride &entry : mEventPriorityOverrides) {
+    if (entry.eventType == eventType) {
+      entry.priority = priority;
+      return true;
+    }
+  }
+
+  if (mEventPriorityOverrides.full()) {
+    LOGE("Can't override the priority of event 0x%" PRIx16, eventType);
+    return false;
+  }
+  mEventPriorityOverrides.push_back({eventType, priority});
+  return true;
+}
+
+EventPriority EventLoop::getEventPriority(const Event &event) const {
+  if (event.targetInstanceId == kSystemInstanceId) {
+    return EventPriority::System;
+  }
+
+  {
+    LockGuard<Mutex> lock(mEventPriorityOverridesLock);
+    for (const EventPriorityOverride &entry : mEventPriorityOverrides) {
+      if (entry.eventType == event.eventType) {
+        return entry.priority;
+      }
+    }
+  }
+
+  switch (event.eventType) {
+    case CHRE_EVENT_MESSAGE_FROM_HOST:
+    case CHRE_EVENT_HOST_ENDPOINT_NOTIFICATION:
+    case CHRE_EVENT_HOST_AWAKE:
+    case CHRE_EVENT_HOST_ASLEEP:
+      return EventPriority::HostMessage;
+    default:
+      return (event.senderInstanceId == kSystemInstanceId)
+                 ? EventPriority::Data
+                 : EventPriority::Bulk;
+  }
+}
+
 bool EventLoop::postLowPriorityEventOrFree(
     uint16_t eventType, void *eventData,
     chreEventCompleteFunction *freeCallback, uint16_t senderInstanceId,
@@ -399,20 +564,20 @@ void EventLoop::onStopComplete() {
 }
 
 Nanoapp *EventLoop::findNanoappByInstanceId(uint16_t instanceId) const {
-  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !inEventLoopThread());
+  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !isCurrentThread());
   return lookupAppByInstanceId(instanceId);
 }
 
 bool EventLoop::populateNanoappInfoForAppId(
     uint64_t appId, struct chreNanoappInfo *info) const {
-  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !inEventLoopThread());
+  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !isCurrentThread());
   Nanoapp *app = lookupAppByAppId(appId);
   return populateNanoappInfo(app, info);
 }
 
 bool EventLoop::populateNanoappInfoForInstanceId(
     uint16_t instanceId, struct chreNanoappInfo *info) const {
-  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !inEventLoopThread());
+  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !isCurrentThread());
   Nanoapp *app = lookupAppByInstanceId(instanceId);
   return populateNanoappInfo(app, info);
 }
@@ -429,6 +594,9 @@ void EventLoop::logStateToBuffer(DebugDumpWrapper &debugDump) const {
                   mNumDroppedLowPriEvents);
   debugDump.print("  Mean event pool usage: %" PRIu32 "/%zu\n",
                   mEventPoolUsage.getMean(), kMaxEventCount);
+  debugDump.print("  Event queue delay: mean %" PRIu32 " ms, max %" PRIu32
+                  " ms\n",
+                  mEventQueueDelayMs.getMean(), mEventQueueDelayMs.getMax());
 
   Nanoseconds timeSince =
       SystemTime::getMonotonicTime() - mTimeLastWakeupBucketCycled;
@@ -456,6 +624,40 @@ void EventLoop::logStateToBuffer(DebugDumpWrapper &debugDump) const {
     for (const UniquePtr<Nanoapp> &app : mNanoapps) {
       app->logMessageHistoryEntry(debugDump);
     }
+
+    EventLatencyStats::logHeaderToBuffer(debugDump, " Nanoapp ");
+    for (const UniquePtr<Nanoapp> &app : mNanoapps) {
+      app->getEventLatencyStats().logEntryToBuffer(debugDump,
+                                                   app->getAppName());
+    }
+  }
+
+  {
+    LockGuard<Mutex> lock(mBudgetOffendersLock);
+    Nanoseconds now = SystemTime::getMonotonicTime();
+    debugDump.print("\nEvent process budget: %" PRIu64 " ms, %" PRIu32
+                    " overruns\n",
+                    Milliseconds(kEventProcessBudget).getMilliseconds(),
+                    mNumEventProcessBudgetOverruns);
+    for (const BudgetOffender &offender : mBudgetOffenders) {
+      debugDump.print(
+          "  instanceId %" PRIu16 ": overruns total=%" PRIu32
+          " recent=%" PRIu8 ", last %" PRIu64 " ms ago%s\n",
+          offender.instanceId, offender.totalOverrunCount,
+          offender.recentOverrunCount,
+          Milliseconds(now - offender.lastOverrunTime).getMilliseconds(),
+          offender.isRepeatOffender(now) ? " (repeat offender)" : "");
+    }
+  }
+
+  EventLatencyStats::logHeaderToBuffer(debugDump, " Event Type ");
+  char label[8];
+  for (const EventTypeLatencyStats &entry : mEventTypeLatencyStats) {
+    snprintf(label, sizeof(label), "0x%04" PRIx16, entry.eventType);
+    entry.stats.logEntryToBuffer(debugDump, label);
+  }
+  if (mOtherEventTypeLatencyStats.getProcessTimeUs().getTotalCount() > 0) {
+    mOtherEventTypeLatencyStats.logEntryToBuffer(debugDump, "other");
   }
 }
 
@@ -471,7 +673,7 @@ bool EventLoop::allocateAndPostEvent(uint16_t eventType, void *eventData,
       mEventPool.allocate(eventType, eventData, freeCallback, isLowPriority,
                           senderInstanceId, targetInstanceId, targetGroupMask);
   if (event != nullptr) {
-    success = mEvents.push(event);
+    success = pushEvent(event, getEventPriority(*event));
   }
   if (!success) {
     LOG_OOM();
@@ -480,23 +682,113 @@ bool EventLoop::allocateAndPostEvent(uint16_t eventType, void *eventData,
   return success;
 }
 
-void EventLoop::deliverNextEvent(const UniquePtr<Nanoapp> &app, Event *event) {
+void EventLoop::deliverNextEvent(Nanoapp &app, Event *event) {
   // TODO: cleaner way to set/clear this? RAII-style?
-  mCurrentApp = app.get();
-  app->processEvent(event);
+  mCurrentApp = &app;
+  Nanoseconds processTime = app.processEvent(event);
   mCurrentApp = nullptr;
+
+  if (processTime > kEventProcessBudget) {
+    handleEventProcessBudgetOverrun(app, event->eventType, processTime);
+  }
 }
 
-void EventLoop::distributeEvent(Event *event) {
-  bool eventDelivered = false;
-  for (const UniquePtr<Nanoapp> &app : mNanoapps) {
-    if ((event->targetInstanceId == chre::kBroadcastInstanceId &&
-         app->isRegisteredForBroadcastEvent(event)) ||
-        event->targetInstanceId == app->getInstanceId()) {
-      eventDelivered = true;
-      deliverNextEvent(app, event);
+void EventLoop::handleEventProcessBudgetOverrun(const Nanoapp &app,
+                                                uint16_t eventType,
+                                                Nanoseconds processTime) {
+  LOGW("Nanoapp 0x%016" PRIx64 " exceeded its %" PRIu64
+       " ms budget processing event 0x%" PRIx16 " (%" PRIu64 " ms)",
+       app.getAppId(), Milliseconds(kEventProcessBudget).getMilliseconds(),
+       eventType, Milliseconds(processTime).getMilliseconds());
+
+  Nanoseconds now = SystemTime::getMonotonicTime();
+  LockGuard<Mutex> lock(mBudgetOffendersLock);
+  mNumEventProcessBudgetOverruns++;
+  BudgetOffender *offender = nullptr;
+  for (BudgetOffender &entry : mBudgetOffenders) {
+    if (entry.instanceId == app.getInstanceId()) {
+      offender = &entry;
+      break;
+    }
+  }
+
+  if (offender != nullptr) {
+    if (now - offender->lastOverrunTime > kBudgetOverrunWindow) {
+      offender->recentOverrunCount = 0;
+    }
+    if (offender->recentOverrunCount < UINT8_MAX) {
+      offender->recentOverrunCount++;
+    }
+    if (offender->totalOverrunCount < UINT32_MAX) {
+      offender->totalOverrunCount++;
+    }
+    offender->lastOverrunTime = now;
+    if (offender->recentOverrunCount == kRepeatOffenderOverrunCount) {
+      LOGW("Nanoapp 0x%016" PRIx64 " low priority events will be dropped first",
+           app.getAppId());
+    }
+  } else {
+    if (mBudgetOffenders.full()) {
+      // Replace the nanoapp whose last overrun is the oldest
+      size_t oldestIndex = 0;
+      for (size_t i = 1; i < mBudgetOffenders.size(); i++) {
+        if (mBudgetOffenders[i].lastOverrunTime <
+            mBudgetOffenders[oldestIndex].lastOverrunTime) {
+          oldestIndex = i;
+        }
+      }
+      mBudgetOffenders.erase(oldestIndex);
     }
+    mBudgetOffenders.emplace_back(app.getInstanceId(), now);
   }
+}
+
+void EventLoop::removeBudgetOffender(uint16_t instanceId) {
+  LockGuard<Mutex> lock(mBudgetOffendersLock);
+  for (size_t i = 0; i < mBudgetOffenders.size(); i++) {
+    if (mBudgetOffenders[i].instanceId == instanceId) {
+      mBudgetOffenders.erase(i);
+      break;
+    }
+  }
+}
+
+void EventLoop::recordEventLatency(uint16_t eventType, uint16_t queueDelayMs,
+                                   Nanoseconds processTime) {
+  mEventQueueDelayMs.addValue(queueDelayMs);
+
+  EventLatencyStats *stats = nullptr;
+  for (EventTypeLatencyStats &entry : mEventTypeLatencyStats) {
+    if (entry.eventType == eventType) {
+      stats = &entry.stats;
+      break;
+    }
+  }
+  if (stats == nullptr) {
+    if (mEventTypeLatencyStats.full()) {
+      stats = &mOtherEventTypeLatencyStats;
+    } else {
+      mEventTypeLatencyStats.emplace_back(eventType);
+      stats = &mEventTypeLatencyStats.back().stats;
+    }
+  }
+
+  stats->addQueueDelay(queueDelayMs);
+  stats->addProcessTime(processTime);
+}
+
+void EventLoop::distributeEvent(Event *event) {
+  Nanoseconds distributeStartTime = SystemTime::getMonotonicTime();
+  uint16_t eventType = event->eventType;
+  uint16_t queueDelayMs = event->getMillisSinceReceived(distributeStartTime);
+
+  bool eventDelivered = deliverEventToNanoapps(event);
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  if (event->targetInstanceId != kSystemInstanceId && forwardEvent(event)) {
+    eventDelivered = true;
+  }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
   // Log if an event unicast to a nanoapp isn't delivered, as this is could be
   // a bug (e.g. something isn't properly keeping track of when nanoapps are
   // unloaded), though it could just be a harmless transient issue (e.g. race
@@ -507,10 +799,139 @@ void EventLoop::distributeEvent(Event *event) {
     LOGW("Dropping event 0x%" PRIx16 " from instanceId %" PRIu16 "->%" PRIu16,
          event->eventType, event->senderInstanceId, event->targetInstanceId);
   }
-  CHRE_ASSERT(event->isUnreferenced());
-  freeEvent(event);
+  // Forwarded events are freed once every event loop has delivered them
+  if (event->isUnreferenced()) {
+    freeEvent(event);
+  }
+
+  // The process time covers all recipients and the free callback, which is
+  // where system events are handled.
+  recordEventLatency(eventType, queueDelayMs,
+                     SystemTime::getMonotonicTime() - distributeStartTime);
 }
 
+bool EventLoop::deliverEventToNanoapps(Event *event) {
+  bool eventDelivered = false;
+  if (event->targetInstanceId == chre::kBroadcastInstanceId) {
+    for (const UniquePtr<Nanoapp> &app : mNanoapps) {
+      if (app->isRegisteredForBroadcastEvent(event)) {
+        eventDelivered = true;
+        deliverNextEvent(*app, event);
+      }
+    }
+  } else {
+    Nanoapp *app = lookupAppByInstanceId(event->targetInstanceId);
+    if (app != nullptr) {
+      eventDelivered = true;
+      deliverNextEvent(*app, event);
+    }
+  }
+  return eventDelivered;
+}
+
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+bool EventLoop::forwardEvent(Event *event) {
+  // Unicast events are only forwarded if the target isn't managed here
+  if (event->targetInstanceId != kBroadcastInstanceId &&
+      lookupAppByInstanceId(event->targetInstanceId) != nullptr) {
+    return false;
+  }
+
+  bool forwarded = false;
+  EventLoopManager *eventLoopManager = EventLoopManagerSingleton::get();
+  for (size_t i = 0; i < eventLoopManager->getEventLoopCount(); i++) {
+    EventLoop &eventLoop = eventLoopManager->getEventLoopByIndex(i);
+    if (&eventLoop != this && eventLoop.hasPotentialRecipient(*event)) {
+      event->incrementRefCount();
+      if (eventLoop.postForwardedEvent(event, this)) {
+        forwarded = true;
+      } else {
+        event->decrementRefCount();
+      }
+    }
+  }
+  return forwarded;
+}
+
+bool EventLoop::postForwardedEvent(Event *event, EventLoop *origin) {
+  bool eventPosted = false;
+  if (mRunning) {
+    // High priority events are held to the same guarantee as postEventOrDie,
+    // evicting low priority events to make room if needed.
+    bool hasSpace = event->isLowPriority || !hasNoSpaceForHighPriorityEvent();
+    Event *forwardedEvent =
+        hasSpace ? mEventPool.allocate(
+                       static_cast<uint16_t>(
+                           SystemCallbackType::ForwardedEventDelivery),
+                       event, deliverForwardedEventCallback, origin)
+                 : nullptr;
+    eventPosted = (forwardedEvent != nullptr &&
+                   pushEvent(forwardedEvent, getEventPriority(*event)));
+    if (!eventPosted) {
+      if (forwardedEvent != nullptr) {
+        mEventPool.deallocate(forwardedEvent);
+      }
+      if (!event->isLowPriority) {
+        FATAL_ERROR("Failed to forward critical event 0x%" PRIx16,
+                    event->eventType);
+      }
+      LOGE("Failed to forward event 0x%" PRIx16 " to instanceId %" PRIu16,
+           event->eventType, event->targetInstanceId);
+      ++mNumDroppedLowPriEvents;
+    }
+  }
+  return eventPosted;
+}
+
+bool EventLoop::hasPotentialRecipient(const Event &event) const {
+  if (event.targetInstanceId != kBroadcastInstanceId) {
+    NanoappIndex::LookupResult result =
+        mNanoappIndex.containsInstanceId(event.targetInstanceId);
+    if (result == NanoappIndex::LookupResult::Found ||
+        result == NanoappIndex::LookupResult::NotFound) {
+      return result == NanoappIndex::LookupResult::Found;
+    }
+  }
+
+  ConditionalLockGuard<Mutex> lock(mNanoappsLock, !isCurrentThread());
+
+  // Broadcast registrations are owned by the thread running this event loop,
+  // so any nanoapp is considered a potential recipient.
+  return (event.targetInstanceId == kBroadcastInstanceId)
+             ? !mNanoapps.empty()
+             : lookupAppByInstanceId(event.targetInstanceId) != nullptr;
+}
+
+void EventLoop::deliverForwardedEventCallback(uint16_t /* type */, void *data,
+                                              void *extraData) {
+  auto *event = static_cast<Event *>(data);
+  auto *origin = static_cast<EventLoop *>(extraData);
+
+  EventLoopManagerSingleton::get()->getCurrentEventLoop().deliverEventToNanoapps(
+      event);
+
+  // The origin event loop invokes the event's free callback, so that it is
+  // always called from the context of the event sender.
+  if (!origin->postSystemEvent(
+          static_cast<uint16_t>(SystemCallbackType::ForwardedEventRelease),
+          event, releaseForwardedEventCallback, origin)) {
+    LOGW("Origin event loop stopped, leaking event 0x%" PRIx16,
+         event->eventType);
+  }
+}
+
+void EventLoop::releaseForwardedEventCallback(uint16_t /* type */, void *data,
+                                              void *extraData) {
+  auto *event = static_cast<Event *>(data);
+  auto *origin = static_cast<EventLoop *>(extraData);
+
+  event->decrementRefCount();
+  if (event->isUnreferenced()) {
+    origin->freeEvent(event);
+  }
+}
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 void EventLoop::flushInboundEventQueue() {
   while (!mEvents.empty()) {
     distributeEvent(mEvents.pop());
@@ -529,27 +950,45 @@ void EventLoop::freeEvent(Event *event) {
 }
 
 Nanoapp *EventLoop::lookupAppByAppId(uint64_t appId) const {
-  for (const UniquePtr<Nanoapp> &app : mNanoapps) {
-    if (app->getAppId() == appId) {
-      return app.get();
+  Nanoapp *nanoapp = mNanoappIndex.findByAppId(appId);
+  if (nanoapp == nullptr && mNanoappIndex.getNumUnindexed() > 0) {
+    for (const UniquePtr<Nanoapp> &app : mNanoapps) {
+      if (app->getAppId() == appId) {
+        return app.get();
+      }
     }
   }
-
-  return nullptr;
+  return nanoapp;
 }
 
 Nanoapp *EventLoop::lookupAppByInstanceId(uint16_t instanceId) const {
-  // The system instance ID always has nullptr as its Nanoapp pointer, so can
-  // skip iterating through the nanoapp list for that case
-  if (instanceId != kSystemInstanceId) {
+  // The system instance ID always has nullptr as its Nanoapp pointer
+  if (instanceId == kSystemInstanceId) {
+    return nullptr;
+  }
+
+  Nanoapp *nanoapp = mNanoappIndex.findByInstanceId(instanceId);
+  if (nanoapp == nullptr && mNanoappIndex.getNumUnindexed() > 0) {
     for (const UniquePtr<Nanoapp> &app : mNanoapps) {
       if (app->getInstanceId() == instanceId) {
         return app.get();
       }
     }
   }
+  return nanoapp;
+}
 
-  return nullptr;
+void EventLoop::reindexNanoapps() {
+  for (const UniquePtr<Nanoapp> &nanoapp : mNanoapps) {
+    if (mNanoappIndex.getNumUnindexed() == 0 ||
+        mNanoappIndex.size() >= NanoappIndex::kMaxNumNanoapps) {
+      break;
+    }
+    if (mNanoappIndex.findByInstanceId(nanoapp->getInstanceId()) == nullptr) {
+      mNanoappIndex.reindex(nanoapp->getAppId(), nanoapp->getInstanceId(),
+                            nanoapp.get());
+    }
+  }
 }
 
 void EventLoop::notifyAppStatusChange(uint16_t eventType,
@@ -582,46 +1021,59 @@ void EventLoop::unloadNanoappAtIndex(size_t index, bool nanoappStarted) {
     nanoapp->end();
   }
 
-  // Cleanup resources.
+  // Cleanup resources. Nanoapps pinned to a worker event loop can't acquire
+  // resources owned by the system event loop, see
+  // EventLoopManager::validateSystemChreApiCall().
+  if (this == &EventLoopManagerSingleton::get()->getEventLoop()) {
 #ifdef CHRE_WIFI_SUPPORT_ENABLED
-  const uint32_t numDisabledWifiSubscriptions =
-      EventLoopManagerSingleton::get()
-          ->getWifiRequestManager()
-          .disableAllSubscriptions(nanoapp.get());
-  logDanglingResources("WIFI subscriptions", numDisabledWifiSubscriptions);
+    const uint32_t numDisabledWifiSubscriptions =
+        EventLoopManagerSingleton::get()
+            ->getWifiRequestManager()
+            .disableAllSubscriptions(nanoapp.get());
+    logDanglingResources("WIFI subscriptions", numDisabledWifiSubscriptions);
 #endif  // CHRE_WIFI_SUPPORT_ENABLED
 
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
-  const uint32_t numDisabledGnssSubscriptions =
-      EventLoopManagerSingleton::get()
-          ->getGnssManager()
-          .disableAllSubscriptions(nanoapp.get());
-  logDanglingResources("GNSS subscriptions", numDisabledGnssSubscriptions);
+    const uint32_t numDisabledGnssSubscriptions =
+        EventLoopManagerSingleton::get()
+            ->getGnssManager()
+            .disableAllSubscriptions(nanoapp.get());
+    logDanglingResources("GNSS subscriptions", numDisabledGnssSubscriptions);
 #endif  // CHRE_GNSS_SUPPORT_ENABLED
 
 #ifdef CHRE_SENSORS_SUPPORT_ENABLED
-  const uint32_t numDisabledSensorSubscriptions =
-      EventLoopManagerSingleton::get()
-          ->getSensorRequestManager()
-          .disableAllSubscriptions(nanoapp.get());
-  logDanglingResources("Sensor subscriptions", numDisabledSensorSubscriptions);
+    const uint32_t numDisabledSensorSubscriptions =
+        EventLoopManagerSingleton::get()
+            ->getSensorRequestManager()
+            .disableAllSubscriptions(nanoapp.get());
+    logDanglingResources("Sensor subscriptions",
+                         numDisabledSensorSubscriptions);
 #endif  // CHRE_SENSORS_SUPPORT_ENABLED
 
 #ifdef CHRE_AUDIO_SUPPORT_ENABLED
-  const uint32_t numDisabledAudioRequests =
-      EventLoopManagerSingleton::get()
-          ->getAudioRequestManager()
-          .disableAllAudioRequests(nanoapp.get());
-  logDanglingResources("Audio requests", numDisabledAudioRequests);
+    const uint32_t numDisabledAudioRequests =
+        EventLoopManagerSingleton::get()
+            ->getAudioRequestManager()
+            .disableAllAudioRequests(nanoapp.get());
+    logDanglingResources("Audio requests", numDisabledAudioRequests);
 #endif  // CHRE_AUDIO_SUPPORT_ENABLED
 
 #ifdef CHRE_BLE_SUPPORT_ENABLED
-  const uint32_t numDisabledBleScans = EventLoopManagerSingleton::get()
-                                           ->getBleRequestManager()
-                                           .disableActiveScan(nanoapp.get());
-  logDanglingResources("BLE scan", numDisabledBleScans);
+    const uint32_t numDisabledBleScans = EventLoopManagerSingleton::get()
+                                             ->getBleRequestManager()
+                                             .disableActiveScan(nanoapp.get());
+    logDanglingResources("BLE scan", numDisabledBleScans);
 #endif  // CHRE_BLE_SUPPORT_ENABLED
 
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+    const uint32_t numUnregisteredModels =
+        EventLoopManagerSingleton::get()
+            ->getInferenceManager()
+            .unregisterAllModels(nanoapp.get());
+    logDanglingResources("inference models", numUnregisteredModels);
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+  }
+
   const uint32_t numCancelledTimers =
       getTimerPool().cancelAllNanoappTimers(nanoapp.get());
   logDanglingResources("timers", numCancelledTimers);
@@ -631,8 +1083,12 @@ void EventLoop::unloadNanoappAtIndex(size_t index, bool nanoappStarted) {
           nanoapp.get());
   logDanglingResources("heap blocks", numFreedBlocks);
 
+  removeBudgetOffender(nanoapp->getInstanceId());
+
   // Destroy the Nanoapp instance
+  mNanoappIndex.remove(nanoapp->getAppId(), nanoapp->getInstanceId());
   mNanoapps.erase(index);
+  reindexNanoapps();
 
   mCurrentApp = nullptr;
 }
@@ -16,21 +16,196 @@
 
 #include "chre/core/event_loop_manager.h"
 
+#include <cinttypes>
+
 #include "chre/platform/atomic.h"
 #include "chre/platform/fatal_error.h"
+#include "chre/platform/log.h"
 #include "chre/platform/memory.h"
 #include "chre/util/lock_guard.h"
 
 namespace chre {
 
 Nanoapp *EventLoopManager::validateChreApiCall(const char *functionName) {
-  chre::Nanoapp *currentNanoapp =
-      EventLoopManagerSingleton::get()->getEventLoop().getCurrentNanoapp();
+  chre::Nanoapp *currentNanoapp = EventLoopManagerSingleton::get()
+                                      ->getCurrentEventLoop()
+                                      .getCurrentNanoapp();
   CHRE_ASSERT_LOG(currentNanoapp, "%s called with no CHRE app context",
                   functionName);
   return currentNanoapp;
 }
 
+Nanoapp *EventLoopManager::validateSystemChreApiCall(const char *functionName) {
+  Nanoapp *currentNanoapp = validateChreApiCall(functionName);
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  if (currentNanoapp != nullptr &&
+      !EventLoopManagerSingleton::get()->getEventLoop().isCurrentThread()) {
+    LOGE("%s can't be called by nanoapp 0x%016" PRIx64
+         " pinned to a worker event loop",
+         functionName, currentNanoapp->getAppId());
+    currentNanoapp = nullptr;
+  }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  return currentNanoapp;
+}
+
+EventLoop *EventLoopManager::findEventLoopByAppId(uint64_t appId) {
+  uint16_t instanceId;
+  for (size_t i = 0; i < getEventLoopCount(); i++) {
+    EventLoop &eventLoop = getEventLoopByIndex(i);
+    if (eventLoop.findNanoappInstanceIdByAppId(appId, &instanceId)) {
+      return &eventLoop;
+    }
+  }
+  return nullptr;
+}
+
+EventLoop *EventLoopManager::findEventLoopByInstanceId(uint16_t instanceId) {
+  for (size_t i = 0; i < getEventLoopCount(); i++) {
+    EventLoop &eventLoop = getEventLoopByIndex(i);
+    if (eventLoop.findNanoappByInstanceId(instanceId) != nullptr) {
+      return &eventLoop;
+    }
+  }
+  return nullptr;
+}
+
+Nanoapp *EventLoopManager::findNanoappByInstanceId(uint16_t instanceId) {
+  for (size_t i = 0; i < getEventLoopCount(); i++) {
+    Nanoapp *nanoapp =
+        getEventLoopByIndex(i).findNanoappByInstanceId(instanceId);
+    if (nanoapp != nullptr) {
+      return nanoapp;
+    }
+  }
+  return nullptr;
+}
+
+bool EventLoopManager::populateNanoappInfoForAppId(
+    uint64_t appId, struct chreNanoappInfo *info) {
+  for (size_t i = 0; i < getEventLoopCount(); i++) {
+    if (getEventLoopByIndex(i).populateNanoappInfoForAppId(appId, info)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EventLoopManager::populateNanoappInfoForInstanceId(
+    uint16_t instanceId, struct chreNanoappInfo *info) {
+  for (size_t i = 0; i < getEventLoopCount(); i++) {
+    if (getEventLoopByIndex(i).populateNanoappInfoForInstanceId(instanceId,
+                                                                info)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EventLoopManager::unloadNanoapp(uint64_t appId,
+                                     bool allowSystemNanoappUnload) {
+  CHRE_ASSERT(mEventLoop.isCurrentThread());
+  uint16_t instanceId;
+  if (mEventLoop.findNanoappInstanceIdByAppId(appId, &instanceId)) {
+    return mEventLoop.unloadNanoapp(instanceId, allowSystemNanoappUnload);
+  }
+
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  if (findEventLoopByAppId(appId) != nullptr) {
+    LOGE("Couldn't unload app ID 0x%016" PRIx64
+         ": pinned to a worker event loop",
+         appId);
+    return false;
+  }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
+  LOGE("Couldn't unload app ID 0x%016" PRIx64 ": not found", appId);
+  return false;
+}
+
+void EventLoopManager::unloadNanoapp(uint64_t appId,
+                                     bool allowSystemNanoappUnload,
+                                     NanoappUnloadCallback *callback,
+                                     void *cookie) {
+  CHRE_ASSERT(mEventLoop.isCurrentThread());
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  uint16_t instanceId;
+  for (EventLoop &eventLoop : mWorkerEventLoops) {
+    if (eventLoop.findNanoappInstanceIdByAppId(appId, &instanceId)) {
+      unloadWorkerNanoapp(eventLoop, instanceId, allowSystemNanoappUnload,
+                          callback, cookie);
+      return;
+    }
+  }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
+  callback(unloadNanoapp(appId, allowSystemNanoappUnload), cookie);
+}
+
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+void EventLoopManager::unloadWorkerNanoapp(EventLoop &eventLoop,
+                                           uint16_t instanceId,
+                                           bool allowSystemNanoappUnload,
+                                           NanoappUnloadCallback *callback,
+                                           void *cookie) {
+  struct UnloadRequest {
+    uint16_t instanceId;
+    bool allowSystemNanoappUnload;
+    bool success;
+    NanoappUnloadCallback *callback;
+    void *cookie;
+  };
+
+  auto *request = memoryAlloc<UnloadRequest>();
+  if (request == nullptr) {
+    LOG_OOM();
+    callback(/* success= */ false, cookie);
+    return;
+  }
+  request->instanceId = instanceId;
+  request->allowSystemNanoappUnload = allowSystemNanoappUnload;
+  request->success = false;
+  request->callback = callback;
+  request->cookie = cookie;
+
+  // Runs in the system event loop.
+  auto completeCallback = [](uint16_t /* type */, void *data,
+                             void * /* extraData */) {
+    auto *request = static_cast<UnloadRequest *>(data);
+    request->callback(request->success, request->cookie);
+    memoryFree(request);
+  };
+
+  // Runs in the worker event loop.
+  auto unloadCallback = [](uint16_t type, void *data, void *extraData) {
+    auto *request = static_cast<UnloadRequest *>(data);
+    request->success =
+        EventLoopManagerSingleton::get()->getCurrentEventLoop().unloadNanoapp(
+            request->instanceId, request->allowSystemNanoappUnload);
+    if (!EventLoopManagerSingleton::get()->getEventLoop().postSystemEvent(
+            type, request,
+            reinterpret_cast<SystemEventCallbackFunction *>(extraData),
+            /* extraData= */ nullptr)) {
+      LOGE("Couldn't report the unload of instance ID %" PRIu16
+           ": system event loop stopped",
+           request->instanceId);
+      memoryFree(request);
+    }
+  };
+
+  if (!eventLoop.postSystemEvent(
+          static_cast<uint16_t>(SystemCallbackType::HandleUnloadNanoapp),
+          request, unloadCallback,
+          reinterpret_cast<void *>(
+              static_cast<SystemEventCallbackFunction *>(completeCallback)))) {
+    LOGE("Couldn't unload instance ID %" PRIu16 ": event loop stopped",
+         instanceId);
+    memoryFree(request);
+    callback(/* success= */ false, cookie);
+  }
+}
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 uint16_t EventLoopManager::getNextInstanceId() {
   // Get the next available instance ID and mask off the upper 16 bit.
   uint16_t instanceId =
@@ -56,6 +231,10 @@ void EventLoopManager::lateInit() {
   mGnssManager.init();
 #endif  // CHRE_GNSS_SUPPORT_ENABLED
 
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+  mInferenceManager.init();
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+
 #ifdef CHRE_WIFI_SUPPORT_ENABLED
   mWifiRequestManager.init();
 #endif  // CHRE_WIFI_SUPPORT_ENABLED
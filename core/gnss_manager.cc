@@ -253,10 +253,6 @@ GnssSession::GnssSession(uint16_t reportEventType)
     default:
       CHRE_ASSERT_LOG(false, "Unsupported eventType %" PRIu16, reportEventType);
   }
-
-  if (!mRequests.reserve(1)) {
-    FATAL_ERROR_OOM();
-  }
 }
 
 bool GnssSession::addRequest(Nanoapp *nanoapp, Milliseconds minInterval,
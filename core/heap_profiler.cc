@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/core/heap_profiler.h"
+
+#include <cinttypes>
+
+namespace chre {
+
+constexpr uint16_t HeapProfiler::kInvalidSiteIndex;
+constexpr size_t HeapProfiler::kMaxSites;
+constexpr size_t HeapProfiler::kNumSizeBuckets;
+constexpr size_t HeapProfiler::kNumLifetimeBuckets;
+
+uint16_t HeapProfiler::recordAlloc(uint64_t appId, uintptr_t returnAddress,
+                                   uint32_t bytes) {
+  uint16_t siteIndex = findOrAddSite(appId, returnAddress);
+  if (siteIndex == kInvalidSiteIndex) {
+    mNumUntrackedAllocs++;
+  } else {
+    Site &site = mSites[siteIndex];
+    site.numAllocs++;
+    site.liveBytes += bytes;
+    if (site.liveBytes > site.peakLiveBytes) {
+      site.peakLiveBytes = site.liveBytes;
+    }
+    site.sizeBytes.addValue(bytes);
+  }
+  return siteIndex;
+}
+
+void HeapProfiler::recordFailedAlloc(uint64_t appId, uintptr_t returnAddress,
+                                     uint32_t bytes) {
+  uint16_t siteIndex = findOrAddSite(appId, returnAddress);
+  if (siteIndex == kInvalidSiteIndex) {
+    mNumUntrackedAllocs++;
+  } else {
+    Site &site = mSites[siteIndex];
+    site.numFailedAllocs++;
+    site.sizeBytes.addValue(bytes);
+  }
+}
+
+void HeapProfiler::recordFree(uint16_t siteIndex, uint32_t bytes,
+                              uint32_t lifetimeMs) {
+  if (siteIndex < mSites.size()) {
+    Site &site = mSites[siteIndex];
+    site.numFrees++;
+    site.liveBytes = (site.liveBytes >= bytes) ? site.liveBytes - bytes : 0;
+    site.lifetimeMs.addValue(lifetimeMs);
+  }
+}
+
+void HeapProfiler::logStateToBuffer(DebugDumpWrapper &debugDump) const {
+  debugDump.print(
+      "\nNanoapp heap profile: %zu site(s), %" PRIu32
+      " untracked allocation(s)\n"
+      "Histogram bucket i counts values in [2^(i-1), 2^i), the last bucket is "
+      "open-ended\n",
+      mSites.size(), mNumUntrackedAllocs);
+
+  for (size_t i = 0; i < mSites.size(); i++) {
+    uint64_t appId = mSites[i].appId;
+
+    // Sites are grouped by nanoapp, under the first site of each nanoapp.
+    bool isFirstSiteOfApp = true;
+    for (size_t j = 0; j < i; j++) {
+      if (mSites[j].appId == appId) {
+        isFirstSiteOfApp = false;
+        break;
+      }
+    }
+    if (!isFirstSiteOfApp) {
+      continue;
+    }
+
+    uint32_t liveBytes = 0;
+    uint32_t numFailedAllocs = 0;
+    for (size_t j = i; j < mSites.size(); j++) {
+      if (mSites[j].appId == appId) {
+        liveBytes += mSites[j].liveBytes;
+        numFailedAllocs += mSites[j].numFailedAllocs;
+      }
+    }
+    debugDump.print(" App 0x%016" PRIx64 ": %" PRIu32 " live bytes, %" PRIu32
+                    " failed allocation(s)\n",
+                    appId, liveBytes, numFailedAllocs);
+
+    for (size_t j = i; j < mSites.size(); j++) {
+      const Site &site = mSites[j];
+      if (site.appId != appId) {
+        continue;
+      }
+      debugDump.print("  Site 0x%" PRIxPTR ": allocs %" PRIu32 ", frees %" PRIu32
+                      ", failed %" PRIu32 ", live %" PRIu32 " B, peak %" PRIu32
+                      " B\n",
+                      site.returnAddress, site.numAllocs, site.numFrees,
+                      site.numFailedAllocs, site.liveBytes, site.peakLiveBytes);
+      logHistogramToBuffer(debugDump, "size (B)", site.sizeBytes);
+      logHistogramToBuffer(debugDump, "lifetime (ms)", site.lifetimeMs);
+    }
+  }
+}
+
+uint16_t HeapProfiler::findOrAddSite(uint64_t appId, uintptr_t returnAddress) {
+  for (size_t i = 0; i < mSites.size(); i++) {
+    if (mSites[i].appId == appId && mSites[i].returnAddress == returnAddress) {
+      return static_cast<uint16_t>(i);
+    }
+  }
+
+  if (mSites.full()) {
+    return kInvalidSiteIndex;
+  }
+  Site site = {};
+  site.appId = appId;
+  site.returnAddress = returnAddress;
+  mSites.push_back(site);
+  return static_cast<uint16_t>(mSites.size() - 1);
+}
+
+template <size_t kNumBuckets>
+void HeapProfiler::logHistogramToBuffer(
+    DebugDumpWrapper &debugDump, const char *label,
+    const LogScaleHistogram<kNumBuckets> &histogram) {
+  debugDump.print("   %-13s p50 %6" PRIu64 ", p90 %6" PRIu64 " |", label,
+                  histogram.getPercentile(50), histogram.getPercentile(90));
+  for (size_t i = 0; i < kNumBuckets; i++) {
+    debugDump.print(" %" PRIu32, histogram.getCount(i));
+  }
+  debugDump.print("\n");
+}
+
+}  // namespace chre
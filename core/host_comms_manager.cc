@@ -99,9 +99,8 @@ bool HostCommsManager::completeTransaction(uint32_t transactionId,
 void HostCommsManager::flushNanoappMessagesAndTransactions(uint64_t appId) {
   uint16_t nanoappInstanceId;
   bool nanoappFound =
-      EventLoopManagerSingleton::get()
-          ->getEventLoop()
-          .findNanoappInstanceIdByAppId(appId, &nanoappInstanceId);
+      EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+          appId, &nanoappInstanceId);
   if (nanoappFound) {
     flushNanoappTransactions(nanoappInstanceId);
   } else {
@@ -285,15 +284,16 @@ bool HostCommsManager::deferCallback(
 
 bool HostCommsManager::deliverNanoappMessageFromHost(
     MessageFromHost *craftedMessage) {
-  const EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
   uint16_t targetInstanceId;
   bool nanoappFound = false;
 
   CHRE_ASSERT_LOG(craftedMessage != nullptr,
                   "Cannot deliver NULL pointer nanoapp message from host");
 
-  if (eventLoop.findNanoappInstanceIdByAppId(craftedMessage->appId,
-                                             &targetInstanceId)) {
+  // The event is forwarded by the system event loop if the nanoapp is pinned
+  // to a worker event loop.
+  if (EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+          craftedMessage->appId, &targetInstanceId)) {
     nanoappFound = true;
     EventLoopManagerSingleton::get()->getEventLoop().postEventOrDie(
         CHRE_EVENT_MESSAGE_FROM_HOST, &craftedMessage->fromHostData,
@@ -371,9 +371,13 @@ size_t HostCommsManager::flushNanoappTransactions(uint16_t nanoappInstanceId) {
 
 void HostCommsManager::freeMessageToHost(MessageToHost *msgToHost) {
   if (msgToHost->toHostData.nanoappFreeFunction != nullptr) {
-    EventLoopManagerSingleton::get()->getEventLoop().invokeMessageFreeFunction(
-        msgToHost->appId, msgToHost->toHostData.nanoappFreeFunction,
-        msgToHost->message.data(), msgToHost->message.size());
+    // Only called from the event loop that owns the sending nanoapp
+    EventLoopManagerSingleton::get()
+        ->getCurrentEventLoop()
+        .invokeMessageFreeFunction(msgToHost->appId,
+                                   msgToHost->toHostData.nanoappFreeFunction,
+                                   msgToHost->message.data(),
+                                   msgToHost->message.size());
   }
   mMessagePool.deallocate(msgToHost);
 }
@@ -408,9 +412,8 @@ bool HostCommsManager::sendMessageWithTransactionData(
       EventLoopManagerSingleton::get()
           ->getHostCommsManager()
           .findMessageByMessageSequenceNumber(data.messageSequenceNumber);
-  Nanoapp *nanoapp =
-      EventLoopManagerSingleton::get()->getEventLoop().findNanoappByInstanceId(
-          data.nanoappInstanceId);
+  Nanoapp *nanoapp = EventLoopManagerSingleton::get()->findNanoappByInstanceId(
+      data.nanoappInstanceId);
   return nanoapp != nullptr && message != nullptr &&
          EventLoopManagerSingleton::get()
              ->getHostCommsManager()
@@ -456,14 +459,23 @@ void HostCommsManager::onMessageToHostCompleteInternal(
 
   // If there's no free callback, we can free the message right away as the
   // message pool is thread-safe; otherwise, we need to do it from within the
-  // EventLoop context.
+  // context of the EventLoop that owns the sending nanoapp.
   if (msgToHost->toHostData.nanoappFreeFunction == nullptr) {
     mMessagePool.deallocate(msgToHost);
-  } else if (inEventLoopThread()) {
+    return;
+  }
+
+  EventLoop *eventLoop =
+      EventLoopManagerSingleton::get()->findEventLoopByAppId(msgToHost->appId);
+  if (eventLoop == nullptr) {
+    // The nanoapp is gone, so invokeMessageFreeFunction will just log it
+    eventLoop = &EventLoopManagerSingleton::get()->getEventLoop();
+  }
+
+  if (inEventLoopThread() && eventLoop->isCurrentThread()) {
     // If we're already within the event loop context, it is safe to call the
     // free callback synchronously.
-    EventLoopManagerSingleton::get()->getHostCommsManager().freeMessageToHost(
-        msgToHost);
+    freeMessageToHost(msgToHost);
   } else {
     auto freeMsgCallback = [](uint16_t /*type*/, void *data,
                               void * /*extraData*/) {
@@ -471,11 +483,10 @@ void HostCommsManager::onMessageToHostCompleteInternal(
           static_cast<MessageToHost *>(data));
     };
 
-    if (!EventLoopManagerSingleton::get()->deferCallback(
-            SystemCallbackType::MessageToHostComplete, msgToHost,
-            freeMsgCallback)) {
-      EventLoopManagerSingleton::get()->getHostCommsManager().freeMessageToHost(
-          static_cast<MessageToHost *>(msgToHost));
+    if (!eventLoop->postSystemEvent(
+            static_cast<uint16_t>(SystemCallbackType::MessageToHostComplete),
+            msgToHost, freeMsgCallback, /* extraData= */ nullptr)) {
+      freeMessageToHost(msgToHost);
     }
   }
 }
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_CORE_BLE_ADVERTISEMENT_FILTER_H_
+#define CHRE_CORE_BLE_ADVERTISEMENT_FILTER_H_
+
+#include <cstdint>
+
+#include "chre/core/ble_request.h"
+#include "chre_api/chre/ble.h"
+
+namespace chre {
+
+/**
+ * Evaluates the scan filters of a nanoapp's BleRequest against advertising
+ * reports, following the semantics of struct chreBleScanFilterV1_9:
+ *   rssi >= rssiThreshold
+ *   AND (matchAny(genericFilters) OR matchAny(broadcasterAddressFilters))
+ *
+ * The set of AD types referenced by the generic filters is compiled once, so
+ * that each report's AD structures are parsed a single time and AD structures
+ * that no filter refers to are skipped without comparing any data.
+ *
+ * The filter references the request, which must outlive it.
+ */
+class BleAdvertisementFilter {
+ public:
+  /**
+   * @param request The enabled request whose filters are evaluated.
+   */
+  explicit BleAdvertisementFilter(const BleRequest &request);
+
+  /**
+   * @return true if the request has no filters, i.e. all reports match.
+   */
+  bool matchesAll() const {
+    return mMatchesAll;
+  }
+
+  /**
+   * @param report The advertising report to evaluate.
+   * @return true if the report matches the filters of the request.
+   */
+  bool matches(const chreBleAdvertisingReport &report) const;
+
+ private:
+  //! The request whose filters are evaluated.
+  const BleRequest &mRequest;
+
+  //! Bitmap of the AD types referenced by the generic filters of mRequest.
+  uint32_t mAdTypes[256 / 32] = {};
+
+  //! true if mRequest has no filters.
+  bool mMatchesAll;
+
+  /**
+   * @return true if the generic filters of mRequest include the given AD type.
+   */
+  bool hasAdType(uint8_t type) const {
+    return (mAdTypes[type / 32] & (UINT32_C(1) << (type % 32))) != 0;
+  }
+
+  /**
+   * @return true if a generic filter matches an AD structure of the report.
+   */
+  bool matchesGenericFilters(const chreBleAdvertisingReport &report) const;
+
+  /**
+   * @return true if a broadcaster address filter matches the report.
+   */
+  bool matchesBroadcasterFilters(const chreBleAdvertisingReport &report) const;
+};
+
+}  // namespace chre
+
+#endif  // CHRE_CORE_BLE_ADVERTISEMENT_FILTER_H_
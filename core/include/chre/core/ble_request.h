@@ -17,7 +17,7 @@
 #ifndef CHRE_CORE_BLE_REQUEST_H_
 #define CHRE_CORE_BLE_REQUEST_H_
 
-#include "chre/util/dynamic_vector.h"
+#include "chre/util/inlined_vector.h"
 #include "chre/util/non_copyable.h"
 #include "chre/util/system/debug_dump.h"
 #include "chre_api/chre/ble.h"
@@ -38,6 +38,12 @@ enum class RequestStatus : uint8_t {
 
 class BleRequest : public NonCopyable {
  public:
+  //! Requests rarely have more than a couple of filters of each kind, so these
+  //! are stored inline to avoid heap allocations.
+  typedef InlinedVector<chreBleGenericFilter, 2> GenericFilterList;
+  typedef InlinedVector<chreBleBroadcasterAddressFilter, 2>
+      BroadcasterFilterList;
+
   BleRequest();
 
   BleRequest(uint16_t instanceId, bool enable, const void *cookie);
@@ -101,13 +107,12 @@ class BleRequest : public NonCopyable {
   /**
    * @return Generic filters of this request.
    */
-  const DynamicVector<chreBleGenericFilter> &getGenericFilters() const;
+  const GenericFilterList &getGenericFilters() const;
 
   /**
    * @return Broadcaster address filters of this request.
    */
-  const DynamicVector<chreBleBroadcasterAddressFilter> &getBroadcasterFilters()
-      const;
+  const BroadcasterFilterList &getBroadcasterFilters() const;
 
   /**
    * @return The cookie this request.
@@ -160,10 +165,10 @@ class BleRequest : public NonCopyable {
   RequestStatus mStatus;
 
   // Generic scan filters.
-  DynamicVector<chreBleGenericFilter> mGenericFilters;
+  GenericFilterList mGenericFilters;
 
   // Broadcaster address filters.
-  DynamicVector<chreBleBroadcasterAddressFilter> mBroadcasterFilters;
+  BroadcasterFilterList mBroadcasterFilters;
 
   // Cookie value included in this request, supplied by the nanoapp.
   const void *mCookie;
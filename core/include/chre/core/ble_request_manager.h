@@ -17,6 +17,7 @@
 #ifndef CHRE_CORE_BLE_REQUEST_MANAGER_H_
 #define CHRE_CORE_BLE_REQUEST_MANAGER_H_
 
+#include "chre/core/ble_advertisement_filter.h"
 #include "chre/core/ble_request.h"
 #include "chre/core/ble_request_multiplexer.h"
 #include "chre/core/nanoapp.h"
@@ -146,15 +147,20 @@ class BleRequestManager : public NonCopyable {
   void handleFreeAdvertisingEvent(struct chreBleAdvertisementEvent *event);
 
   /**
-   * Releases BLE Advertising Event after nanoapps have processed it.
+   * Releases a BLE Advertising Event delivered to a nanoapp after it has
+   * processed it, and the advertising event it was filtered from once all the
+   * nanoapps have processed it.
    *
    * @param eventType the type of event being freed.
-   * @param eventData a pointer to the scan event to release.
+   * @param eventData a pointer to the FilteredAdvertisementEvent to release.
    */
-  static void freeAdvertisingEventCallback(uint16_t eventType, void *eventData);
+  static void freeFilteredAdvertisementEventCallback(uint16_t eventType,
+                                                     void *eventData);
 
   /**
-   * Handles a CHRE BLE advertisement event.
+   * Handles a CHRE BLE advertisement event. Each nanoapp with an enabled
+   * request receives its own event, holding only the reports that match the
+   * filters of its request.
    *
    * @param event The BLE advertisement event containing BLE advertising
    *              reports. This memory is guaranteed not to be modified until it
@@ -250,6 +256,26 @@ class BleRequestManager : public NonCopyable {
     bool isActive = false;
   };
 
+  //! An advertising event from the PAL, shared by the filtered events delivered
+  //! to each nanoapp and released once they have all been freed.
+  struct SharedAdvertisementEvent {
+    //! The event provided by the PAL.
+    chreBleAdvertisementEvent *event;
+    //! The number of filtered events referencing this event, plus one while
+    //! they are being posted.
+    uint16_t refCount;
+  };
+
+  //! The event delivered to a nanoapp. If only some of the reports of the
+  //! source event match the filters of the nanoapp, copies of the matching
+  //! reports, which still reference the data of the source event, follow this
+  //! struct in the same allocation. Otherwise event.reports points to the
+  //! reports of the source event.
+  struct alignas(chreBleAdvertisingReport) FilteredAdvertisementEvent {
+    chreBleAdvertisementEvent event;
+    SharedAdvertisementEvent *source;
+  };
+
   // Multiplexer used to keep track of BLE requests from nanoapps.
   BleRequestMultiplexer mRequests;
 
@@ -409,6 +435,37 @@ class BleRequestManager : public NonCopyable {
    */
   void handlePlatformChangeSync(bool enable, uint8_t errorCode);
 
+  /**
+   * Delivers the reports of an advertising event to the nanoapps with an
+   * enabled request whose filters they match, and all of them to the nanoapps
+   * registered for advertising events without an enabled request. Must be
+   * invoked on the CHRE event loop thread.
+   *
+   * @param event The advertising event provided by the PAL.
+   */
+  void handleAdvertisementEventSync(struct chreBleAdvertisementEvent *event);
+
+  /**
+   * Posts the reports of an advertising event matching a filter to a nanoapp.
+   *
+   * @param source The advertising event, whose reference count is incremented
+   *     if an event is posted.
+   * @param instanceId The instance ID of the recipient nanoapp.
+   * @param filter The filter of the enabled request of the nanoapp, or nullptr
+   *     to post all the reports.
+   */
+  void postFilteredAdvertisementEvent(SharedAdvertisementEvent *source,
+                                      uint16_t instanceId,
+                                      const BleAdvertisementFilter *filter);
+
+  /**
+   * Decrements the reference count of an advertising event, and releases it
+   * to the PAL when it reaches zero.
+   *
+   * @param source The advertising event.
+   */
+  void releaseSharedAdvertisementEvent(SharedAdvertisementEvent *source);
+
   /**
    * Dispatches pending BLE requests from nanoapps.
    */
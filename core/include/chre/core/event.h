@@ -20,6 +20,7 @@
 #include "chre/core/event_loop_common.h"
 #include "chre/platform/assert.h"
 #include "chre/util/non_copyable.h"
+#include "chre/util/time.h"
 #include "chre_api/chre/event.h"
 
 #include <cstdint>
@@ -115,6 +116,14 @@ class Event : public NonCopyable {
     }
   }
 
+  /**
+   * @param now The current monotonic time.
+   * @return The time in milliseconds elapsed since this event was received,
+   *     i.e. its residency time in the event queue. Like receivedTimeMillis,
+   *     this wraps around after ~65 seconds.
+   */
+  uint16_t getMillisSinceReceived(Nanoseconds now) const;
+
   const uint16_t eventType;
 
   //! This value can serve as a proxy for how fast CHRE is processing events
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_CORE_EVENT_LATENCY_STATS_H_
+#define CHRE_CORE_EVENT_LATENCY_STATS_H_
+
+#include <cstdint>
+
+#include "chre/util/system/debug_dump.h"
+#include "chre/util/system/log_scale_histogram.h"
+#include "chre/util/time.h"
+
+namespace chre {
+
+/**
+ * Tracks the distribution of the time events spend in the inbound event queue
+ * (from being posted to being dispatched) and the time spent processing them,
+ * using fixed-memory log-scale histograms.
+ */
+class EventLatencyStats {
+ public:
+  //! Number of queue delay buckets, tracked in milliseconds. The last bucket
+  //! collects delays of 1024 ms or more.
+  static constexpr size_t kNumQueueDelayBuckets = 12;
+
+  //! Number of process time buckets, tracked in microseconds. The last bucket
+  //! collects process times of 262144 us (~262 ms) or more.
+  static constexpr size_t kNumProcessTimeBuckets = 20;
+
+  /**
+   * Records the time an event spent in the queue before being dispatched.
+   *
+   * @param queueDelayMs The queue residency time in milliseconds.
+   */
+  void addQueueDelay(uint32_t queueDelayMs) {
+    mQueueDelayMs.addValue(queueDelayMs);
+  }
+
+  /**
+   * Records the time spent processing an event.
+   *
+   * @param processTime The time spent processing the event.
+   */
+  void addProcessTime(Nanoseconds processTime) {
+    mProcessTimeUs.addValue(Microseconds(processTime).getMicroseconds());
+  }
+
+  /**
+   * Prints the header of the table generated by logEntryToBuffer.
+   *
+   * @param debugDump The object that is printed into for debug dump logs.
+   * @param label The label of the first column, e.g. "Nanoapp".
+   */
+  static void logHeaderToBuffer(DebugDumpWrapper &debugDump,
+                                const char *label);
+
+  /**
+   * Prints the median, p90, p99 and count of each histogram as one table row.
+   *
+   * @param debugDump The object that is printed into for debug dump logs.
+   * @param label The label of the row, e.g. the nanoapp name.
+   */
+  void logEntryToBuffer(DebugDumpWrapper &debugDump, const char *label) const;
+
+  const LogScaleHistogram<kNumQueueDelayBuckets> &getQueueDelayMs() const {
+    return mQueueDelayMs;
+  }
+
+  const LogScaleHistogram<kNumProcessTimeBuckets> &getProcessTimeUs() const {
+    return mProcessTimeUs;
+  }
+
+ private:
+  //! Distribution of the time events spent in the inbound queue.
+  LogScaleHistogram<kNumQueueDelayBuckets> mQueueDelayMs;
+
+  //! Distribution of the time spent processing events.
+  LogScaleHistogram<kNumProcessTimeBuckets> mProcessTimeUs;
+};
+
+}  // namespace chre
+
+#endif  // CHRE_CORE_EVENT_LATENCY_STATS_H_
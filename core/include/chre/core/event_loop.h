@@ -18,13 +18,18 @@
 #define CHRE_CORE_EVENT_LOOP_H_
 
 #include "chre/core/event.h"
+#include "chre/core/event_latency_stats.h"
+#include "chre/core/event_loop_common.h"
 #include "chre/core/nanoapp.h"
+#include "chre/core/nanoapp_index.h"
 #include "chre/core/timer_pool.h"
 #include "chre/platform/atomic.h"
 #include "chre/platform/mutex.h"
 #include "chre/platform/power_control_manager.h"
 #include "chre/platform/system_time.h"
 #include "chre/util/dynamic_vector.h"
+#include "chre/util/fixed_size_vector.h"
+#include "chre/util/multi_level_blocking_queue.h"
 #include "chre/util/non_copyable.h"
 #include "chre/util/system/debug_dump.h"
 #include "chre/util/system/stats_container.h"
@@ -32,7 +37,7 @@
 #include "chre_api/chre/event.h"
 
 #ifdef CHRE_STATIC_EVENT_LOOP
-#include "chre/util/fixed_size_blocking_queue.h"
+#include "chre/util/array_queue.h"
 #include "chre/util/synchronized_memory_pool.h"
 
 // These default values can be overridden in the variant-specific makefile.
@@ -44,7 +49,7 @@
 #define CHRE_MAX_UNSCHEDULED_EVENT_COUNT 96
 #endif
 #else
-#include "chre/util/blocking_segmented_queue.h"
+#include "chre/util/segmented_queue.h"
 #include "chre/util/synchronized_expandable_memory_pool.h"
 
 // These default values can be overridden in the variant-specific makefile.
@@ -58,8 +63,50 @@
 
 #endif
 
+// The number of distinct event types for which latency stats are tracked
+// individually by the event loop. Events of any other type are aggregated into
+// a single entry. Can be overridden in the variant-specific makefile.
+#ifndef CHRE_MAX_PROFILED_EVENT_TYPES
+#define CHRE_MAX_PROFILED_EVENT_TYPES 8
+#endif
+
+// The time budget for a nanoapp to process a single event, in milliseconds.
+// Nanoapps that repeatedly exceed it have their low priority events dropped
+// first when the event queue is full. Can be overridden in the
+// variant-specific makefile.
+#ifndef CHRE_NANOAPP_EVENT_PROCESS_BUDGET_MS
+#define CHRE_NANOAPP_EVENT_PROCESS_BUDGET_MS 100
+#endif
+
+// The number of consecutive events dispatched from higher priority classes
+// after which a pending event of a lower priority class is dispatched, to avoid
+// starving it. Can be overridden in the variant-specific makefile.
+#ifndef CHRE_EVENT_PRIORITY_STARVATION_LIMIT
+#define CHRE_EVENT_PRIORITY_STARVATION_LIMIT 8
+#endif
+
+// The maximum number of event types whose priority class can be overridden
+// with EventLoop::setEventTypePriority(). Can be overridden in the
+// variant-specific makefile.
+#ifndef CHRE_MAX_EVENT_PRIORITY_OVERRIDES
+#define CHRE_MAX_EVENT_PRIORITY_OVERRIDES 8
+#endif
+
+// The number of worker event loops, each with their own thread and event
+// queue, that nanoapps can be pinned to in addition to the system event loop.
+// Events are forwarded between event loops as needed, but subsystem managers
+// and their callbacks always run in the system event loop. Requires
+// thread_local support from the toolchain. Can be overridden in the
+// variant-specific makefile.
+#ifndef CHRE_NUM_WORKER_EVENT_LOOPS
+#define CHRE_NUM_WORKER_EVENT_LOOPS 0
+#endif
+
 namespace chre {
 
+// Forward declaration needed to friend EventLoop.
+class TestEventProcessBudget;
+
 /**
  * The EventLoop represents a single thread of execution that is shared among
  * zero or more nanoapps. As the name implies, the EventLoop is built around a
@@ -69,10 +116,13 @@ class EventLoop : public NonCopyable {
  public:
   EventLoop()
       :
-#ifndef CHRE_STATIC_EVENT_LOOP
-        mEvents(kMaxEventBlock),
+#ifdef CHRE_STATIC_EVENT_LOOP
+        mEvents(kEventPriorityStarvationLimit),
+#else
+        mEvents(kEventPriorityStarvationLimit, kMaxEventBlock),
 #endif
         mTimeLastWakeupBucketCycled(SystemTime::getMonotonicTime()),
+        mTimerPool(*this),
         mRunning(true) {
   }
 
@@ -128,6 +178,19 @@ class EventLoop : public NonCopyable {
                                  chreMessageFreeFunction *freeFunction,
                                  void *message, size_t messageSize);
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  /**
+   * @return The event loop whose nanoapps are executed by the calling thread,
+   *     or nullptr if the calling thread is not running an event loop.
+   */
+  static EventLoop *getCurrentThreadEventLoop();
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
+  /**
+   * @return true if the calling thread is the one running this event loop.
+   */
+  bool isCurrentThread() const;
+
   /**
    * Invokes the Nanoapp's start callback, and if successful, adds it to the
    * set of Nanoapps managed by this EventLoop. This function must only be
@@ -272,6 +335,18 @@ class EventLoop : public NonCopyable {
   bool postSystemEvent(uint16_t eventType, void *eventData,
                        SystemEventCallbackFunction *callback, void *extraData);
 
+  /**
+   * Overrides the priority class that events of a given type are dispatched
+   * with, e.g. to let a latency-sensitive nanoapp-to-nanoapp event skip ahead
+   * of sensor data. Events targeting the system are always dispatched with
+   * EventPriority::System. Only applies to events posted after this call.
+   *
+   * @param eventType The event type.
+   * @param priority The priority class of events of this type.
+   * @return true if the override was set, false if there is no room for it.
+   */
+  bool setEventTypePriority(uint16_t eventType, EventPriority priority);
+
   /**
    * Returns a pointer to the currently executing Nanoapp, or nullptr if none is
    * currently executing. Must only be called from within the thread context
@@ -366,7 +441,24 @@ class EventLoop : public NonCopyable {
     return mNumDroppedLowPriEvents;
   }
 
+  inline uint32_t getNumEventProcessBudgetOverruns() const {
+    return mNumEventProcessBudgetOverruns;
+  }
+
+  inline uint64_t getMaxEventQueueDelayUs() const {
+    return static_cast<uint64_t>(mEventQueueDelayMs.getMax()) *
+           kOneMillisecondInMicroseconds;
+  }
+
+  inline uint64_t getMeanEventQueueDelayUs() const {
+    return static_cast<uint64_t>(mEventQueueDelayMs.getMean()) *
+           kOneMillisecondInMicroseconds;
+  }
+
  private:
+  // Allows TestEventProcessBudget to inspect mBudgetOffenders.
+  friend class TestEventProcessBudget;
+
 #ifdef CHRE_STATIC_EVENT_LOOP
   //! The maximum number of events that can be active in the system.
   static constexpr size_t kMaxEventCount = CHRE_MAX_EVENT_COUNT;
@@ -379,9 +471,11 @@ class EventLoop : public NonCopyable {
   //! The memory pool to allocate incoming events from.
   SynchronizedMemoryPool<Event, kMaxEventCount> mEventPool;
 
-  //! The blocking queue of incoming events from the system that have not been
-  //! distributed out to apps yet.
-  FixedSizeBlockingQueue<Event *, kMaxUnscheduledEventCount> mEvents;
+  //! The blocking queues of incoming events from the system that have not been
+  //! distributed out to apps yet, one per EventPriority.
+  MultiLevelBlockingQueue<Event *, ArrayQueue<Event *, kMaxUnscheduledEventCount>,
+                          kNumEventPriorities>
+      mEvents;
 
 #else
   //! The maximum number of event that can be stored in a block in mEventPool.
@@ -397,10 +491,35 @@ class EventLoop : public NonCopyable {
   SynchronizedExpandableMemoryPool<Event, kEventPerBlock, kMaxEventBlock>
       mEventPool;
 
-  //! The blocking queue of incoming events from the system that have not been
-  //! distributed out to apps yet.
-  BlockingSegmentedQueue<Event *, kEventPerBlock> mEvents;
+  //! The blocking queues of incoming events from the system that have not been
+  //! distributed out to apps yet, one per EventPriority.
+  MultiLevelBlockingQueue<Event *, SegmentedQueue<Event *, kEventPerBlock>,
+                          kNumEventPriorities>
+      mEvents;
 #endif
+
+  //! @see CHRE_EVENT_PRIORITY_STARVATION_LIMIT
+  static constexpr uint8_t kEventPriorityStarvationLimit =
+      CHRE_EVENT_PRIORITY_STARVATION_LIMIT;
+
+  //! The maximum number of entries in mEventPriorityOverrides
+  static constexpr size_t kMaxEventPriorityOverrides =
+      CHRE_MAX_EVENT_PRIORITY_OVERRIDES;
+
+  //! Overrides the default priority class of an event type
+  struct EventPriorityOverride {
+    uint16_t eventType;
+    EventPriority priority;
+  };
+
+  //! The priority class overrides set by setEventTypePriority()
+  FixedSizeVector<EventPriorityOverride, kMaxEventPriorityOverrides>
+      mEventPriorityOverrides;
+
+  //! Protects mEventPriorityOverrides, which is read from any thread posting
+  //! an event.
+  mutable Mutex mEventPriorityOverridesLock;
+
   //! The time interval of nanoapp wakeup buckets, adjust in conjunction with
   //! Nanoapp::kMaxSizeWakeupBuckets.
   static constexpr Nanoseconds kIntervalWakeupBucket =
@@ -423,6 +542,10 @@ class EventLoop : public NonCopyable {
   //! the thread context of this EventLoop.
   mutable Mutex mNanoappsLock;
 
+  //! Indexes mNanoapps by app ID and instance ID. Modified along with
+  //! mNanoapps, under mNanoappsLock.
+  NanoappIndex mNanoappIndex;
+
   //! Indicates whether the event loop is running.
   AtomicBool mRunning;
 
@@ -442,6 +565,77 @@ class EventLoop : public NonCopyable {
   //! The number of events dropped due to capacity limits
   uint32_t mNumDroppedLowPriEvents = 0;
 
+  //! The number of events a nanoapp took longer than kEventProcessBudget to
+  //! process
+  uint32_t mNumEventProcessBudgetOverruns = 0;
+
+  //! The stats collection used to collect the time events spend in the
+  //! inbound queue before being distributed, in milliseconds
+  StatsContainer<uint32_t> mEventQueueDelayMs;
+
+  //! Latency stats associated with a single event type
+  struct EventTypeLatencyStats {
+    explicit EventTypeLatencyStats(uint16_t eventType_)
+        : eventType(eventType_) {}
+
+    uint16_t eventType;
+    EventLatencyStats stats;
+  };
+
+  //! The maximum number of event types tracked in mEventTypeLatencyStats
+  static constexpr size_t kMaxProfiledEventTypes =
+      CHRE_MAX_PROFILED_EVENT_TYPES;
+
+  //! Latency stats of the first kMaxProfiledEventTypes event types
+  //! distributed by this event loop
+  FixedSizeVector<EventTypeLatencyStats, kMaxProfiledEventTypes>
+      mEventTypeLatencyStats;
+
+  //! Latency stats of the event types not tracked in mEventTypeLatencyStats
+  EventLatencyStats mOtherEventTypeLatencyStats;
+
+  //! The time budget for a nanoapp to process a single event
+  static constexpr Nanoseconds kEventProcessBudget =
+      Milliseconds(CHRE_NANOAPP_EVENT_PROCESS_BUDGET_MS);
+
+  //! The number of budget overruns within kBudgetOverrunWindow after which a
+  //! nanoapp is considered a repeat offender
+  static constexpr uint8_t kRepeatOffenderOverrunCount = 3;
+
+  //! The time after its last budget overrun for which a nanoapp remains
+  //! tracked as an offender
+  static constexpr Nanoseconds kBudgetOverrunWindow =
+      Nanoseconds(kOneMinuteInNanoseconds);
+
+  //! The maximum number of nanoapps tracked in mBudgetOffenders
+  static constexpr size_t kMaxBudgetOffenders = 4;
+
+  //! Tracks the recent event process budget overruns of a nanoapp
+  struct BudgetOffender {
+    BudgetOffender(uint16_t instanceId_, Nanoseconds lastOverrunTime_)
+        : instanceId(instanceId_), lastOverrunTime(lastOverrunTime_) {}
+
+    uint16_t instanceId;
+    uint8_t recentOverrunCount = 1;
+    uint32_t totalOverrunCount = 1;
+    Nanoseconds lastOverrunTime;
+
+    //! @return true if the nanoapp exceeded its budget often enough, recently
+    //!     enough, to have its low priority events dropped first
+    bool isRepeatOffender(Nanoseconds now) const {
+      return recentOverrunCount >= kRepeatOffenderOverrunCount &&
+             now - lastOverrunTime <= kBudgetOverrunWindow;
+    }
+  };
+
+  //! The nanoapps that most recently exceeded their event process budget
+  FixedSizeVector<BudgetOffender, kMaxBudgetOffenders> mBudgetOffenders;
+
+  //! Protects mBudgetOffenders, which is written from the event loop thread
+  //! but read from any thread posting an event when the queue is full. Must
+  //! not be acquired while holding the event queue or event pool locks.
+  mutable Mutex mBudgetOffendersLock;
+
   /**
    * Modifies the run loop state so it no longer iterates on new events. This
    * should only be invoked by the event loop when it is ready to stop
@@ -462,7 +656,9 @@ class EventLoop : public NonCopyable {
                             uint16_t targetInstanceId,
                             uint16_t targetGroupMask);
   /**
-   * Remove some low priority events from back of the queue.
+   * Remove some low priority events from back of the queue. Events targeting
+   * nanoapps that repeatedly exceed their event process budget are removed
+   * first.
    *
    * @param removeNum Number of low priority events to be removed.
    * @return False if cannot remove any low priority event.
@@ -481,7 +677,37 @@ class EventLoop : public NonCopyable {
   /**
    * Delivers the next event pending to the Nanoapp.
    */
-  void deliverNextEvent(const UniquePtr<Nanoapp> &app, Event *event);
+  void deliverNextEvent(Nanoapp &app, Event *event);
+
+  /**
+   * Records an event that took longer than kEventProcessBudget to be processed
+   * by a nanoapp, and updates the nanoapp's offender status.
+   *
+   * @param app The nanoapp that exceeded its budget.
+   * @param eventType The type of the event being processed.
+   * @param processTime The time spent by the nanoapp processing the event.
+   */
+  void handleEventProcessBudgetOverrun(const Nanoapp &app, uint16_t eventType,
+                                       Nanoseconds processTime);
+
+  /**
+   * Stops tracking the budget overruns of a nanoapp, e.g. when it is unloaded.
+   *
+   * @param instanceId The instance ID of the nanoapp.
+   */
+  void removeBudgetOffender(uint16_t instanceId);
+
+  /**
+   * Records the queue delay and total process time of an event in the latency
+   * stats associated with its event type.
+   *
+   * @param eventType The type of the distributed event.
+   * @param queueDelayMs The time the event spent in the inbound queue.
+   * @param processTime The time spent distributing the event to all of its
+   *     recipients and invoking its free callback.
+   */
+  void recordEventLatency(uint16_t eventType, uint16_t queueDelayMs,
+                          Nanoseconds processTime);
 
   /**
    * Given an event pulled from the main incoming event queue (mEvents), deliver
@@ -501,6 +727,78 @@ class EventLoop : public NonCopyable {
    */
   void flushInboundEventQueue();
 
+  /**
+   * @param event The event to classify.
+   * @return The priority class the event is dispatched with.
+   */
+  EventPriority getEventPriority(const Event &event) const;
+
+  /**
+   * Pushes an event into the inbound queue of its priority class.
+   *
+   * @param event The event to push.
+   * @param priority The priority class of the event.
+   * @return true if the event was pushed.
+   */
+  bool pushEvent(Event *event, EventPriority priority) {
+    return mEvents.push(event, static_cast<size_t>(priority));
+  }
+
+  /**
+   * Delivers an event to the nanoapps managed by this event loop that should
+   * receive it.
+   *
+   * @param event The Event to deliver
+   * @return true if at least one nanoapp received the event
+   */
+  bool deliverEventToNanoapps(Event *event);
+
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  /**
+   * Forwards an event posted to this event loop to the other event loops that
+   * manage one of its potential recipients. The event's reference count is
+   * incremented for each event loop it is forwarded to, and it must not be
+   * freed until the count drops back to zero.
+   *
+   * @param event The Event to forward
+   * @return true if the event was forwarded to at least one event loop
+   */
+  bool forwardEvent(Event *event);
+
+  /**
+   * Posts an event originally posted to another event loop for delivery to the
+   * nanoapps managed by this one. Like postLowPriorityEventOrFree, the event
+   * is dropped if it cannot be posted.
+   *
+   * @param event The Event to deliver, which remains owned by origin
+   * @param origin The event loop the event was posted to
+   * @return true if the event was posted. Only low priority events can fail to
+   *     be posted, as failing to post a high priority event is fatal.
+   */
+  bool postForwardedEvent(Event *event, EventLoop *origin);
+
+  /**
+   * @param event The Event to check
+   * @return true if a nanoapp managed by this event loop may receive the event.
+   *     Safe to call from any thread.
+   */
+  bool hasPotentialRecipient(const Event &event) const;
+
+  /**
+   * Invoked in the context of the event loop an event was forwarded to, to
+   * deliver it and hand it back to its origin event loop.
+   */
+  static void deliverForwardedEventCallback(uint16_t type, void *data,
+                                            void *extraData);
+
+  /**
+   * Invoked in the context of the origin event loop once a forwarded event was
+   * delivered, to free it after it was delivered by every event loop.
+   */
+  static void releaseForwardedEventCallback(uint16_t type, void *data,
+                                            void *extraData);
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
   /**
    * Call after when an Event has been delivered to all intended recipients.
    * Invokes the event's free callback (if given) and releases resources.
@@ -532,6 +830,12 @@ class EventLoop : public NonCopyable {
    */
   Nanoapp *lookupAppByInstanceId(uint16_t instanceId) const;
 
+  /**
+   * Moves nanoapps that were loaded while mNanoappIndex was full into the
+   * index, as long as it has room. Must be called with mNanoappsLock held.
+   */
+  void reindexNanoapps();
+
   /**
    * Sends an event with payload struct chreNanoappInfo populated from the given
    * Nanoapp instance to inform other nanoapps about it starting/stopping.
@@ -75,8 +75,27 @@ enum class SystemCallbackType : uint16_t {
   PulseResponse,
   ReliableMessageEvent,
   TimerPoolTimerExpired,
+  ForwardedEventDelivery,
+  ForwardedEventRelease,
+  InferenceRequest,
 };
 
+//! Dispatch priority classes of the inbound event queue, from highest to
+//! lowest priority. Events of the same class are dispatched in FIFO order.
+enum class EventPriority : uint8_t {
+  //! Deferred system callbacks
+  System = 0,
+  //! Messages and notifications from the host
+  HostMessage,
+  //! Other events sent by the system, e.g. sensor data or request results
+  Data,
+  //! Events sent by nanoapps
+  Bulk,
+};
+
+//! The number of EventPriority values
+constexpr size_t kNumEventPriorities = 4;
+
 //! Deferred/delayed callbacks use the event subsystem but are invariably sent
 //! by the system and received by the system, so they are able to make use of an
 //! extra parameter
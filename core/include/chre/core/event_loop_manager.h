@@ -24,6 +24,7 @@
 #include "chre/core/host_endpoint_manager.h"
 #include "chre/core/settings.h"
 #include "chre/core/system_health_monitor.h"
+#include "chre/platform/assert.h"
 #include "chre/platform/atomic.h"
 #include "chre/platform/memory_manager.h"
 #include "chre/platform/mutex.h"
@@ -46,6 +47,10 @@
 #include "chre/core/gnss_manager.h"
 #endif  // CHRE_GNSS_SUPPORT_ENABLED
 
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+#include "chre/core/inference_manager.h"
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+
 #ifdef CHRE_SENSORS_SUPPORT_ENABLED
 #include "chre/core/sensor_request_manager.h"
 #endif  // CHRE_SENSORS_SUPPORT_ENABLED
@@ -70,6 +75,15 @@ template <typename T>
 using TypedSystemEventCallbackFunction = void(SystemCallbackType type,
                                               UniquePtr<T> &&data);
 
+/**
+ * Called from the system event loop once a nanoapp unload requested with
+ * EventLoopManager::unloadNanoapp() completes.
+ *
+ * @param success true if the nanoapp was found and unloaded.
+ * @param cookie The cookie given to unloadNanoapp().
+ */
+using NanoappUnloadCallback = void(bool success, void *cookie);
+
 /**
  * A class that keeps track of all event loops in the system. This class
  * represents the top-level object in CHRE. It will own all resources that are
@@ -93,6 +107,18 @@ class EventLoopManager : public NonCopyable {
    */
   static Nanoapp *validateChreApiCall(const char *functionName);
 
+  /**
+   * Same as validateChreApiCall, for the CHRE APIs that interact with a
+   * subsystem manager. Subsystem managers run in the system event loop only,
+   * so these APIs are rejected when called by a nanoapp pinned to a worker
+   * event loop.
+   *
+   * @param functionName The name of the CHRE API. This should be __func__.
+   * @return A pointer to the currently executing nanoapp, or null if it is
+   *         pinned to a worker event loop.
+   */
+  static Nanoapp *validateSystemChreApiCall(const char *functionName);
+
   /**
    * Leverages the event queue mechanism to schedule a CHRE system callback to
    * be invoked at some point in the future from within the context of the
@@ -244,12 +270,150 @@ class EventLoopManager : public NonCopyable {
 #endif  // CHRE_BLE_SUPPORT_ENABLED
 
   /**
-   * @return The event loop managed by this event loop manager.
+   * @return The system event loop managed by this event loop manager, which
+   *     runs all subsystem managers and the nanoapps not pinned to a worker
+   *     event loop.
    */
   EventLoop &getEventLoop() {
     return mEventLoop;
   }
 
+  /**
+   * @return The number of event loops managed by this event loop manager,
+   *     including the system event loop.
+   */
+  static constexpr size_t getEventLoopCount() {
+    return 1 + CHRE_NUM_WORKER_EVENT_LOOPS;
+  }
+
+  /**
+   * @param index The index of the event loop, which must be less than
+   *     getEventLoopCount(). Index 0 is the system event loop, and the
+   *     following ones are the worker event loops.
+   * @return The event loop at the given index.
+   */
+  EventLoop &getEventLoopByIndex(size_t index) {
+    CHRE_ASSERT(index < getEventLoopCount());
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+    if (index > 0 && index < getEventLoopCount()) {
+      return mWorkerEventLoops[index - 1];
+    }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+    return mEventLoop;
+  }
+
+  /**
+   * @return The event loop running in the calling thread, or the system event
+   *     loop if the calling thread doesn't run an event loop.
+   */
+  EventLoop &getCurrentEventLoop() {
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+    EventLoop *eventLoop = EventLoop::getCurrentThreadEventLoop();
+    return (eventLoop != nullptr) ? *eventLoop : mEventLoop;
+#else
+    return mEventLoop;
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  }
+
+  /**
+   * Searches all event loops for a nanoapp with the given app ID.
+   *
+   * This function is safe to call from any thread.
+   *
+   * @see EventLoop::findNanoappInstanceIdByAppId
+   */
+  bool findNanoappInstanceIdByAppId(uint64_t appId, uint16_t *instanceId) {
+    for (size_t i = 0; i < getEventLoopCount(); i++) {
+      if (getEventLoopByIndex(i).findNanoappInstanceIdByAppId(appId,
+                                                              instanceId)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Searches all event loops for the one managing the nanoapp with the given
+   * app ID.
+   *
+   * This function is safe to call from any thread.
+   *
+   * @param appId The nanoapp identifier to search for.
+   * @return The event loop managing the nanoapp, or nullptr if not found.
+   */
+  EventLoop *findEventLoopByAppId(uint64_t appId);
+
+  /**
+   * Searches all event loops for the one managing the nanoapp with the given
+   * instance ID.
+   *
+   * This function is safe to call from any thread.
+   *
+   * @param instanceId The nanoapp instance ID to search for.
+   * @return The event loop managing the nanoapp, or nullptr if not found.
+   */
+  EventLoop *findEventLoopByInstanceId(uint16_t instanceId);
+
+  /**
+   * Searches all event loops for a nanoapp with the given instance ID.
+   *
+   * This function is safe to call from any thread.
+   *
+   * @see EventLoop::findNanoappByInstanceId
+   */
+  Nanoapp *findNanoappByInstanceId(uint16_t instanceId);
+
+  /**
+   * Looks for an app with the given ID in all event loops and if found,
+   * populates info with its metadata. Safe to call from any thread.
+   *
+   * @see chreGetNanoappInfoByAppId
+   */
+  bool populateNanoappInfoForAppId(uint64_t appId,
+                                   struct chreNanoappInfo *info);
+
+  /**
+   * Looks for an app with the given instance ID in all event loops and if
+   * found, populates info with its metadata. Safe to call from any thread.
+   *
+   * @see chreGetNanoappInfoByInstanceId
+   */
+  bool populateNanoappInfoForInstanceId(uint16_t instanceId,
+                                        struct chreNanoappInfo *info);
+
+  /**
+   * Stops and unloads the nanoapp with the given app ID from the system event
+   * loop. Must be called from the system event loop. Nanoapps pinned to a
+   * worker event loop can't be unloaded synchronously, use the overload taking
+   * a callback for them.
+   *
+   * @param appId The nanoapp identifier.
+   * @param allowSystemNanoappUnload If false, this function will reject
+   *        attempts to unload a system nanoapp.
+   * @return true if the nanoapp was found and unloaded.
+   *
+   * @see EventLoop::unloadNanoapp
+   */
+  bool unloadNanoapp(uint64_t appId, bool allowSystemNanoappUnload);
+
+  /**
+   * Stops and unloads the nanoapp with the given app ID from the context of
+   * the event loop that manages it. Must be called from the system event loop,
+   * which is not blocked while a worker event loop unloads the nanoapp.
+   *
+   * @param appId The nanoapp identifier.
+   * @param allowSystemNanoappUnload If false, this function will reject
+   *        attempts to unload a system nanoapp.
+   * @param callback Called from the system event loop once the unload
+   *        completes, possibly before this function returns. It isn't called
+   *        if the system event loop stops in the meantime.
+   * @param cookie Passed to the callback.
+   *
+   * @see EventLoop::unloadNanoapp
+   */
+  void unloadNanoapp(uint64_t appId, bool allowSystemNanoappUnload,
+                     NanoappUnloadCallback *callback, void *cookie);
+
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
   /**
    * @return A reference to the GNSS request manager. This allows interacting
@@ -261,6 +425,16 @@ class EventLoopManager : public NonCopyable {
   }
 #endif  // CHRE_GNSS_SUPPORT_ENABLED
 
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+  /**
+   * @return A reference to the inference manager, which runs the machine
+   *         learning models of nanoapps from a shared tensor arena.
+   */
+  InferenceManager &getInferenceManager() {
+    return mInferenceManager;
+  }
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+
   /**
    * @return A reference to the host communications manager that enables
    *         transferring arbitrary data between the host processor and CHRE.
@@ -368,12 +542,23 @@ class EventLoopManager : public NonCopyable {
   //! The event loop managed by this event loop manager.
   EventLoop mEventLoop;
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  //! The worker event loops that nanoapps can be pinned to, each run by their
+  //! own thread.
+  EventLoop mWorkerEventLoops[CHRE_NUM_WORKER_EVENT_LOOPS];
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
   //! The GnssManager that handles requests for all nanoapps. This manages the
   //! state of the GNSS subsystem that the runtime subscribes to.
   GnssManager mGnssManager;
 #endif  // CHRE_GNSS_SUPPORT_ENABLED
 
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+  //! The InferenceManager that runs the models of all nanoapps.
+  InferenceManager mInferenceManager;
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+
   //! Handles communications with the host processor.
   HostCommsManager mHostCommsManager;
 
@@ -413,6 +598,18 @@ class EventLoopManager : public NonCopyable {
 
   //! The SettingManager that manages setting states.
   SettingManager mSettingManager;
+
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  /**
+   * Unloads a nanoapp pinned to a worker event loop from the context of that
+   * event loop, then calls the callback from the system event loop.
+   *
+   * @see unloadNanoapp
+   */
+  void unloadWorkerNanoapp(EventLoop &eventLoop, uint16_t instanceId,
+                           bool allowSystemNanoappUnload,
+                           NanoappUnloadCallback *callback, void *cookie);
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
 };
 
 //! Provide an alias to the EventLoopManager singleton.
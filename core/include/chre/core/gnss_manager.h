@@ -23,6 +23,7 @@
 #include "chre/core/nanoapp.h"
 #include "chre/core/settings.h"
 #include "chre/platform/platform_gnss.h"
+#include "chre/util/inlined_vector.h"
 #include "chre/util/non_copyable.h"
 #include "chre/util/system/debug_dump.h"
 #include "chre/util/time.h"
@@ -205,8 +206,9 @@ class GnssSession {
   static constexpr size_t kNumSessionRequestLogs = 10;
   ArrayQueue<SessionRequestLog, kNumSessionRequestLogs> mSessionRequestLogs;
 
-  //! The request multiplexer for GNSS session requests.
-  DynamicVector<Request> mRequests;
+  //! The request multiplexer for GNSS session requests. Only a few nanoapps
+  //! use each session, so their requests are stored inline.
+  InlinedVector<Request, 4> mRequests;
 
   //! The current report interval being sent to the session. This is only valid
   //! if the mRequests is non-empty.
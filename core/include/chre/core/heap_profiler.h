@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_CORE_HEAP_PROFILER_H_
+#define CHRE_CORE_HEAP_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/util/fixed_size_vector.h"
+#include "chre/util/non_copyable.h"
+#include "chre/util/system/debug_dump.h"
+#include "chre/util/system/log_scale_histogram.h"
+
+// The number of distinct allocation sites that can be tracked. Allocations
+// from sites beyond this limit are only counted.
+#ifndef CHRE_HEAP_PROFILER_MAX_SITES
+#define CHRE_HEAP_PROFILER_MAX_SITES 64
+#endif
+
+namespace chre {
+
+/**
+ * Profiles the heap allocations of nanoapps by allocation site, i.e. by the
+ * nanoapp and the return address of its chreHeapAlloc() call.
+ *
+ * For each site, the distribution of the allocation sizes and lifetimes are
+ * tracked in fixed-memory log-scale histograms, along with the number of live
+ * bytes and failed allocations. This helps finding the code paths responsible
+ * for heap fragmentation and out-of-memory conditions.
+ *
+ * Sites are kept after the nanoapp is unloaded, so that the profile can be
+ * retrieved once a test is over. Used by the MemoryManager when
+ * CHRE_HEAP_PROFILER_ENABLED is defined.
+ */
+class HeapProfiler : public NonCopyable {
+ public:
+  //! Returned by recordAlloc() for allocations from untracked sites.
+  static constexpr uint16_t kInvalidSiteIndex = UINT16_MAX;
+
+  //! The number of allocation sites that can be tracked.
+  static constexpr size_t kMaxSites = CHRE_HEAP_PROFILER_MAX_SITES;
+  static_assert(kMaxSites < kInvalidSiteIndex, "Too many heap profiler sites");
+
+  //! Number of allocation size buckets, in bytes. The last bucket collects
+  //! allocations of 1024 bytes or more.
+  static constexpr size_t kNumSizeBuckets = 12;
+
+  //! Number of lifetime buckets, in milliseconds. The last bucket collects
+  //! lifetimes of 262144 ms (~4.4 min) or more.
+  static constexpr size_t kNumLifetimeBuckets = 20;
+
+  //! The allocations made from a single site.
+  struct Site {
+    //! The app ID of the nanoapp making the allocations.
+    uint64_t appId;
+
+    //! The return address of the allocation call.
+    uintptr_t returnAddress;
+
+    //! The number of successful allocations.
+    uint32_t numAllocs;
+
+    //! The number of allocations freed.
+    uint32_t numFrees;
+
+    //! The number of allocations that failed.
+    uint32_t numFailedAllocs;
+
+    //! The number of bytes currently allocated.
+    uint32_t liveBytes;
+
+    //! The maximum of liveBytes.
+    uint32_t peakLiveBytes;
+
+    //! Distribution of the size of the allocations, including failed ones.
+    LogScaleHistogram<kNumSizeBuckets> sizeBytes;
+
+    //! Distribution of the lifetime of the freed allocations.
+    LogScaleHistogram<kNumLifetimeBuckets> lifetimeMs;
+  };
+
+  /**
+   * Records a successful allocation.
+   *
+   * @param appId The app ID of the nanoapp making the allocation.
+   * @param returnAddress The return address of the allocation call.
+   * @param bytes The size of the allocation.
+   * @return The index of the site to pass to recordFree(), or
+   *     kInvalidSiteIndex if the site table is full.
+   */
+  uint16_t recordAlloc(uint64_t appId, uintptr_t returnAddress,
+                       uint32_t bytes);
+
+  /**
+   * Records an allocation that failed.
+   *
+   * @param appId The app ID of the nanoapp making the allocation.
+   * @param returnAddress The return address of the allocation call.
+   * @param bytes The size of the allocation.
+   */
+  void recordFailedAlloc(uint64_t appId, uintptr_t returnAddress,
+                         uint32_t bytes);
+
+  /**
+   * Records that an allocation was freed.
+   *
+   * @param siteIndex The index returned by recordAlloc().
+   * @param bytes The size of the allocation.
+   * @param lifetimeMs The time elapsed since the allocation.
+   */
+  void recordFree(uint16_t siteIndex, uint32_t bytes, uint32_t lifetimeMs);
+
+  /**
+   * @return The number of tracked allocation sites.
+   */
+  size_t getNumSites() const {
+    return mSites.size();
+  }
+
+  /**
+   * @param index The index of the site, must be less than getNumSites().
+   * @return The allocation site.
+   */
+  const Site &getSite(size_t index) const {
+    return mSites[index];
+  }
+
+  /**
+   * @return The number of allocations that couldn't be attributed to a site
+   *     because the site table was full.
+   */
+  uint32_t getNumUntrackedAllocs() const {
+    return mNumUntrackedAllocs;
+  }
+
+  /**
+   * Prints the profile, grouped by nanoapp, with one row per site.
+   *
+   * @param debugDump The object that is printed into for debug dump logs.
+   */
+  void logStateToBuffer(DebugDumpWrapper &debugDump) const;
+
+ private:
+  //! The tracked allocation sites, in the order they were first seen.
+  FixedSizeVector<Site, kMaxSites> mSites;
+
+  //! The number of allocations from sites that couldn't be tracked.
+  uint32_t mNumUntrackedAllocs = 0;
+
+  /**
+   * Looks up a site, adding it if it isn't tracked yet.
+   *
+   * @return The index of the site, or kInvalidSiteIndex if the site table is
+   *     full.
+   */
+  uint16_t findOrAddSite(uint64_t appId, uintptr_t returnAddress);
+
+  /**
+   * Prints the counts of each bucket of a histogram on a single line.
+   */
+  template <size_t kNumBuckets>
+  static void logHistogramToBuffer(
+      DebugDumpWrapper &debugDump, const char *label,
+      const LogScaleHistogram<kNumBuckets> &histogram);
+};
+
+}  // namespace chre
+
+#endif  // CHRE_CORE_HEAP_PROFILER_H_
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_CORE_INFERENCE_MANAGER_H_
+#define CHRE_CORE_INFERENCE_MANAGER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/core/nanoapp.h"
+#include "chre/util/array_queue.h"
+#include "chre/util/dynamic_vector.h"
+#include "chre/util/non_copyable.h"
+#include "chre/util/system/debug_dump.h"
+#include "chre/util/time.h"
+#include "chre/util/unique_ptr.h"
+
+struct chreInferenceResult;
+
+// The maximum number of inference requests queued across all nanoapps.
+#ifndef CHRE_INFERENCE_MAX_PENDING_REQUESTS
+#define CHRE_INFERENCE_MAX_PENDING_REQUESTS 8
+#endif
+
+// The largest tensor arena a model can request, in bytes.
+#ifndef CHRE_INFERENCE_MAX_ARENA_SIZE
+#define CHRE_INFERENCE_MAX_ARENA_SIZE (64 * 1024)
+#endif
+
+namespace chre {
+
+/**
+ * The operations of the engine running the models of the InferenceManager.
+ * All of them are invoked from the context of the main CHRE event loop, and at
+ * most one model is prepared at any time.
+ */
+struct InferenceBackend {
+  /**
+   * Prepares a model to run, placing all of its tensors in the arena.
+   *
+   * @return false if the model is invalid or doesn't fit in the arena.
+   */
+  bool (*prepare)(const void *model, size_t modelSize, uint8_t *arena,
+                  size_t arenaSize);
+
+  /**
+   * Runs the prepared model.
+   *
+   * @return false if the buffers don't match the tensors of the model, or if
+   *     the model failed to run.
+   */
+  bool (*invoke)(const void *input, size_t inputSize, void *output,
+                 size_t outputSize);
+
+  /**
+   * Releases the prepared model, after which the arena can be reused.
+   */
+  void (*release)();
+};
+
+#ifdef CHRE_INFERENCE_TFLM_BACKEND_ENABLED
+/**
+ * @return The backend running TensorFlow Lite Micro models.
+ */
+const InferenceBackend *getTflmInferenceBackend();
+#endif  // CHRE_INFERENCE_TFLM_BACKEND_ENABLED
+
+/**
+ * Runs the machine learning models of nanoapps from a single tensor arena.
+ *
+ * Nanoapps rarely run inferences at the same time, so rather than each of them
+ * reserving an arena sized for its own peak usage, the models are registered
+ * here and take turns using an arena sized for the largest of them. Requests
+ * are queued and run one per deferred callback so that other events are
+ * dispatched in between, and a model only needs to be prepared again when
+ * another model used the arena since its last inference.
+ */
+class InferenceManager : public NonCopyable {
+ public:
+  //! The maximum number of queued requests.
+  static constexpr size_t kMaxPendingRequests =
+      CHRE_INFERENCE_MAX_PENDING_REQUESTS;
+
+  //! The largest arena a model can request.
+  static constexpr size_t kMaxArenaSize = CHRE_INFERENCE_MAX_ARENA_SIZE;
+
+  //! Counters describing the usage of the service.
+  struct Stats {
+    //! The number of inferences run, successful or not.
+    uint32_t numInferences;
+
+    //! The number of times a model was prepared in the arena.
+    uint32_t numPrepares;
+
+    //! The current size of the shared arena.
+    size_t arenaSize;
+
+    //! The total size of the arenas of the registered models, i.e. the memory
+    //! that per-nanoapp arenas would reserve.
+    size_t totalModelArenaSize;
+
+    //! The sum and maximum of the times between a request and its result.
+    Nanoseconds totalLatency;
+    Nanoseconds maxLatency;
+  };
+
+  ~InferenceManager();
+
+  /**
+   * Selects the default backend, if CHRE is built with one.
+   */
+  void init();
+
+  /**
+   * Replaces the backend running the models, e.g. with a hardware accelerated
+   * one. Must only be called when no model is registered.
+   */
+  void setBackend(const InferenceBackend *backend);
+
+  /**
+   * @see chreInferenceRegisterModel
+   */
+  bool registerModel(const Nanoapp *nanoapp, const void *model,
+                     size_t modelSize, size_t arenaSize,
+                     uint32_t *modelHandle);
+
+  /**
+   * @see chreInferenceUnregisterModel
+   */
+  bool unregisterModel(const Nanoapp *nanoapp, uint32_t modelHandle);
+
+  /**
+   * @see chreInferenceRequest
+   */
+  bool requestInference(const Nanoapp *nanoapp, uint32_t modelHandle,
+                        const void *input, size_t inputSize, void *output,
+                        size_t outputSize, const void *cookie);
+
+  /**
+   * Unregisters all the models of a nanoapp, e.g. when it is unloaded.
+   *
+   * @return The number of models unregistered.
+   */
+  uint32_t unregisterAllModels(const Nanoapp *nanoapp);
+
+  Stats getStats() const;
+
+  /**
+   * Prints state in a string buffer. Must only be called from the context of
+   * the main CHRE thread.
+   *
+   * @param debugDump The debug dump wrapper where a string can be printed
+   *     into one of the buffers.
+   */
+  void logStateToBuffer(DebugDumpWrapper &debugDump) const;
+
+ private:
+  struct Model {
+    uint32_t handle;
+    uint16_t instanceId;
+    const void *data;
+    size_t size;
+    size_t arenaSize;
+  };
+
+  struct Request {
+    uint32_t modelHandle;
+    uint16_t instanceId;
+    const void *input;
+    size_t inputSize;
+    void *output;
+    size_t outputSize;
+    const void *cookie;
+    Nanoseconds requestTime;
+
+    //! Allocated with the request, so that its result can always be posted.
+    struct chreInferenceResult *result;
+  };
+
+  const InferenceBackend *mBackend = nullptr;
+
+  //! The registered models.
+  DynamicVector<Model> mModels;
+
+  //! The requests waiting to run, in order.
+  ArrayQueue<Request, kMaxPendingRequests> mRequests;
+
+  //! The shared tensor arena, reallocated when the largest model changes.
+  UniquePtr<uint8_t[]> mArena;
+  size_t mArenaSize = 0;
+
+  //! The model currently prepared in the arena.
+  uint32_t mPreparedModelHandle = 0;
+
+  uint32_t mNextModelHandle = 1;
+
+  //! Whether a callback to run the next request is pending.
+  bool mProcessingScheduled = false;
+
+  uint32_t mNumInferences = 0;
+  uint32_t mNumPrepares = 0;
+  Nanoseconds mTotalLatency;
+  Nanoseconds mMaxLatency;
+
+  size_t findModel(uint32_t modelHandle) const;
+
+  /**
+   * Removes the queued requests for a model, and releases the model if it is
+   * prepared in the arena.
+   */
+  void removeModelAtIndex(size_t index);
+
+  void releasePreparedModel();
+
+  /**
+   * Reallocates the arena if its size differs from the largest registered
+   * model's arena.
+   *
+   * @return false if the arena could not be allocated.
+   */
+  bool resizeArena();
+
+  void scheduleProcessing();
+  void processNextRequest();
+
+  /**
+   * Runs a request, preparing its model first if needed.
+   *
+   * @return A value from enum chreError.
+   */
+  uint8_t runRequest(const Request &request);
+
+  void postResult(const Request &request, uint8_t errorCode,
+                  Nanoseconds startTime);
+};
+
+}  // namespace chre
+
+#endif  // CHRE_CORE_INFERENCE_MANAGER_H_
@@ -22,12 +22,15 @@
 #include <limits>
 
 #include "chre/core/event.h"
+#include "chre/core/event_latency_stats.h"
 #include "chre/core/event_ref_queue.h"
 #include "chre/platform/heap_block_header.h"
 #include "chre/platform/platform_nanoapp.h"
 #include "chre/platform/system_time.h"
 #include "chre/util/dynamic_vector.h"
 #include "chre/util/fixed_size_vector.h"
+#include "chre/util/flat_hash_map.h"
+#include "chre/util/inlined_vector.h"
 #include "chre/util/system/debug_dump.h"
 #include "chre/util/system/napp_permissions.h"
 #include "chre/util/system/stats_container.h"
@@ -176,8 +179,17 @@ class Nanoapp : public PlatformNanoapp {
    * Sends an event to the nanoapp to be processed.
    *
    * @param event A pointer to the event to be processed
+   * @return The time spent by the nanoapp processing the event
    */
-  void processEvent(Event *event);
+  Nanoseconds processEvent(Event *event);
+
+  /**
+   * @return The queue delay and event processing time distributions of the
+   *     events delivered to this nanoapp.
+   */
+  const EventLatencyStats &getEventLatencyStats() const {
+    return mEventLatencyStats;
+  }
 
   /**
    * Log info about a single host wakeup that this nanoapp triggered by storing
@@ -355,24 +367,15 @@ class Nanoapp : public PlatformNanoapp {
   //! Collects process time in nanoseconds of each event
   StatsContainer<uint64_t> mEventProcessTime;
 
-  //! Metadata needed for keeping track of the registered events for this
-  //! nanoapp.
-  struct EventRegistration {
-    EventRegistration(uint16_t eventType_, uint16_t groupIdMask_)
-        : eventType(eventType_), groupIdMask(groupIdMask_) {}
+  //! Histograms of the queue delay and process time of each event
+  EventLatencyStats mEventLatencyStats;
 
-    uint16_t eventType;
-    uint16_t groupIdMask;
-  };
-
-  //! The set of broadcast events that this app is registered for.
-  // TODO: Implement a set container and replace DynamicVector here. There may
-  // also be a better way of handling this (perhaps we map event type to apps
-  // who care about them).
-  DynamicVector<EventRegistration> mRegisteredEvents;
+  //! The broadcast events that this app is registered for, mapped to the
+  //! group ID mask of the registration. Looked up for every broadcast event.
+  FlatHashMap<uint16_t, uint16_t> mRegisteredEvents;
 
   //! The registered host endpoints to receive notifications for.
-  DynamicVector<uint16_t> mRegisteredHostEndpoints;
+  InlinedVector<uint16_t, 4> mRegisteredHostEndpoints;
 
   //! The list of RPC services for this nanoapp.
   DynamicVector<struct chreNanoappRpcService> mRpcServices;
@@ -380,10 +383,6 @@ class Nanoapp : public PlatformNanoapp {
   //! Whether nanoappStart is being executed.
   bool mIsInNanoappStart = false;
 
-  //! @return index of event registration if found. mRegisteredEvents.size() if
-  //!     not.
-  size_t registrationIndex(uint16_t eventType) const;
-
   /**
    * A special function to deliver GNSS measurement events to nanoapps and
    * handles version compatibility.
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_CORE_NANOAPP_INDEX_H_
+#define CHRE_CORE_NANOAPP_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/platform/atomic.h"
+#include "chre/util/non_copyable.h"
+
+// The number of slots of each hash table of a NanoappIndex. Must be a power of
+// two. Up to 3/4 of this number of nanoapps of an event loop are indexed, the
+// others are looked up by walking the nanoapp list. Can be overridden in the
+// variant-specific makefile.
+#ifndef CHRE_NANOAPP_INDEX_SIZE
+#define CHRE_NANOAPP_INDEX_SIZE 64
+#endif
+
+namespace chre {
+
+class Nanoapp;
+
+/**
+ * Constant-time lookup of the nanoapps of an event loop by app ID and by
+ * instance ID, using two open-addressing hash tables with linear probing.
+ *
+ * The index must only be modified from a single thread (the event loop thread,
+ * with the nanoapp list lock held). Lookups that don't dereference the Nanoapp
+ * pointer, i.e. findInstanceIdByAppId() and containsInstanceId(), are safe to
+ * call from any thread without holding a lock: modifications are published
+ * through a sequence counter, and readers that raced with a writer retry a
+ * bounded number of times before reporting contention.
+ *
+ * Once kMaxNumNanoapps are indexed, further nanoapps are only counted as
+ * unindexed: lookups that miss then can't tell whether the nanoapp exists, and
+ * the caller has to fall back to its nanoapp list.
+ */
+class NanoappIndex : public NonCopyable {
+ public:
+  //! The number of slots of each hash table.
+  static constexpr size_t kNumSlots = CHRE_NANOAPP_INDEX_SIZE;
+
+  //! The maximum number of nanoapps that are indexed, keeping the load factor
+  //! low enough for probe sequences to stay short.
+  static constexpr size_t kMaxNumNanoapps = kNumSlots * 3 / 4;
+
+  static_assert(kNumSlots > 0 && (kNumSlots & (kNumSlots - 1)) == 0,
+                "CHRE_NANOAPP_INDEX_SIZE must be a power of two");
+
+  //! The result of a lookup that doesn't require synchronization with the
+  //! writer thread.
+  enum class LookupResult : uint8_t {
+    Found,
+    NotFound,
+    //! The nanoapp isn't indexed, but some nanoapps didn't fit in the index;
+    //! the caller should synchronize with the writer thread and search its
+    //! nanoapp list.
+    NotIndexed,
+    //! The index was being modified during all the read attempts; the caller
+    //! should synchronize with the writer thread and retry.
+    Contended,
+  };
+
+  NanoappIndex() : mSequence(0) {}
+
+  /**
+   * Adds a nanoapp to the index, or counts it as unindexed if the index is
+   * full. Must only be called by the writer thread.
+   *
+   * @param appId The app ID of the nanoapp.
+   * @param instanceId The instance ID of the nanoapp.
+   * @param nanoapp The nanoapp, must not be nullptr.
+   * @return false if either ID is already indexed.
+   */
+  bool add(uint64_t appId, uint16_t instanceId, Nanoapp *nanoapp);
+
+  /**
+   * Removes a nanoapp previously passed to add(). Must only be called by the
+   * writer thread.
+   *
+   * @param appId The app ID of the nanoapp.
+   * @param instanceId The instance ID of the nanoapp.
+   * @return true if the nanoapp was indexed, false if it was unindexed.
+   */
+  bool remove(uint64_t appId, uint16_t instanceId);
+
+  /**
+   * Moves a nanoapp counted as unindexed into the index. Must only be called
+   * by the writer thread.
+   *
+   * @param appId The app ID of the nanoapp.
+   * @param instanceId The instance ID of the nanoapp.
+   * @param nanoapp The nanoapp, must not be nullptr.
+   * @return false if the index is full or no nanoapp is unindexed.
+   */
+  bool reindex(uint64_t appId, uint16_t instanceId, Nanoapp *nanoapp);
+
+  /**
+   * Must only be called by the writer thread, or by a thread synchronized
+   * with it.
+   *
+   * @return The nanoapp with the given app ID, or nullptr if it isn't
+   *     indexed.
+   */
+  Nanoapp *findByAppId(uint64_t appId) const;
+
+  /**
+   * Must only be called by the writer thread, or by a thread synchronized
+   * with it.
+   *
+   * @return The nanoapp with the given instance ID, or nullptr if it isn't
+   *     indexed.
+   */
+  Nanoapp *findByInstanceId(uint16_t instanceId) const;
+
+  /**
+   * Looks up the instance ID of a nanoapp by app ID. Safe to call from any
+   * thread.
+   *
+   * @param appId The app ID to look up.
+   * @param instanceId Set to the instance ID of the nanoapp if found.
+   * @return The result of the lookup.
+   */
+  LookupResult findInstanceIdByAppId(uint64_t appId,
+                                     uint16_t *instanceId) const;
+
+  /**
+   * Looks up whether a nanoapp with the given instance ID is indexed. Safe to
+   * call from any thread.
+   *
+   * @param instanceId The instance ID to look up.
+   * @return The result of the lookup.
+   */
+  LookupResult containsInstanceId(uint16_t instanceId) const;
+
+  /**
+   * @return The number of indexed nanoapps.
+   */
+  size_t size() const {
+    return mSize;
+  }
+
+  /**
+   * @return The number of nanoapps that were added while the index was full
+   *     and haven't been removed or reindexed since.
+   */
+  size_t getNumUnindexed() const {
+    return mNumUnindexed;
+  }
+
+ private:
+  //! A slot of one of the hash tables. A slot is empty if nanoapp is nullptr.
+  struct Slot {
+    uint64_t appId;
+    uint16_t instanceId;
+    Nanoapp *nanoapp;
+  };
+
+  //! The number of times a lookup that doesn't synchronize with the writer
+  //! thread is attempted before giving up. Bounded so that a reader running
+  //! at a higher priority than a preempted writer can't spin forever.
+  static constexpr uint8_t kMaxReadAttempts = 4;
+
+  //! Slots keyed by app ID.
+  Slot mByAppId[kNumSlots] = {};
+
+  //! Slots keyed by instance ID.
+  Slot mByInstanceId[kNumSlots] = {};
+
+  //! The number of indexed nanoapps.
+  size_t mSize = 0;
+
+  //! The number of nanoapps that didn't fit in the index.
+  size_t mNumUnindexed = 0;
+
+  //! Incremented before and after each modification, so it is odd while a
+  //! modification is in progress.
+  AtomicUint32 mSequence;
+
+  //! @return The home slot of an app ID.
+  static size_t hashAppId(uint64_t appId);
+
+  //! @return The home slot of an instance ID. Instance IDs are allocated
+  //!     sequentially, so they are spread evenly without hashing.
+  static size_t hashInstanceId(uint16_t instanceId) {
+    return instanceId & (kNumSlots - 1);
+  }
+
+  /**
+   * @return The index of the slot of the table keyed by app ID that holds
+   *     appId, or kNumSlots if not found.
+   */
+  size_t findAppIdSlot(uint64_t appId) const;
+
+  /**
+   * @return The index of the slot of the table keyed by instance ID that holds
+   *     instanceId, or kNumSlots if not found.
+   */
+  size_t findInstanceIdSlot(uint16_t instanceId) const;
+
+  /**
+   * Empties a slot of a table, shifting back the following slots of the probe
+   * sequence so that lookups don't need tombstones.
+   *
+   * @param table The table to remove from.
+   * @param index The index of the slot to empty.
+   * @param hashFunction Returns the home slot of a slot's key.
+   */
+  template <typename HashFunction>
+  static void removeSlot(Slot *table, size_t index, HashFunction hashFunction);
+
+  /**
+   * Inserts a nanoapp in both tables. Must be called between beginWrite() and
+   * endWrite(), with room left in the index.
+   */
+  void insert(uint64_t appId, uint16_t instanceId, Nanoapp *nanoapp);
+
+  //! Marks the start of a modification.
+  void beginWrite() {
+    mSequence.fetch_increment();
+  }
+
+  //! Marks the end of a modification.
+  void endWrite() {
+    mSequence.fetch_increment();
+  }
+};
+
+}  // namespace chre
+
+#endif  // CHRE_CORE_NANOAPP_INDEX_H_
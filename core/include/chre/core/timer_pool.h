@@ -32,6 +32,8 @@ namespace chre {
 // Forward declaration needed to friend TimerPool.
 class TestTimer;
 
+class EventLoop;
+
 /**
  * The type to use when referring to a timer instance.
  *
@@ -47,8 +49,11 @@ class TimerPool : public NonCopyable {
  public:
   /**
    * Sets up the timer instance initial conditions.
+   *
+   * @param eventLoop The event loop that owns this timer pool. Expired timers
+   *        are handled and delivered within its thread context.
    */
-  TimerPool();
+  explicit TimerPool(EventLoop &eventLoop);
 
   /**
    * Requests a timer for a nanoapp given a cookie to pass to the nanoapp when
@@ -185,6 +190,9 @@ class TimerPool : public NonCopyable {
   //! search for a vacant timer handle.
   bool mGenerateTimerHandleMustCheckUniqueness = false;
 
+  //! The event loop that owns this timer pool.
+  EventLoop &mEventLoop;
+
   //! The mutex to lock when using this class.
   Mutex mMutex;
 
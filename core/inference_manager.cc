@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/core/inference_manager.h"
+
+#include <cinttypes>
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/platform/assert.h"
+#include "chre/platform/log.h"
+#include "chre/platform/shared/chre_inference.h"
+#include "chre/platform/system_time.h"
+#include "chre/util/system/event_callbacks.h"
+
+namespace chre {
+
+InferenceManager::~InferenceManager() {
+  while (!mRequests.empty()) {
+    memoryFree(mRequests.front().result);
+    mRequests.pop();
+  }
+  releasePreparedModel();
+}
+
+void InferenceManager::init() {
+#ifdef CHRE_INFERENCE_TFLM_BACKEND_ENABLED
+  mBackend = getTflmInferenceBackend();
+#endif  // CHRE_INFERENCE_TFLM_BACKEND_ENABLED
+}
+
+void InferenceManager::setBackend(const InferenceBackend *backend) {
+  CHRE_ASSERT(mModels.empty());
+  releasePreparedModel();
+  mBackend = backend;
+}
+
+bool InferenceManager::registerModel(const Nanoapp *nanoapp, const void *model,
+                                     size_t modelSize, size_t arenaSize,
+                                     uint32_t *modelHandle) {
+  CHRE_ASSERT(nanoapp);
+
+  bool success = false;
+  if (mBackend == nullptr) {
+    LOGE("No inference backend");
+  } else if (model == nullptr || modelSize == 0 || modelHandle == nullptr) {
+    LOGE("Invalid model");
+  } else if (arenaSize == 0 || arenaSize > kMaxArenaSize) {
+    LOGE("Invalid arena size %zu, max %zu", arenaSize, kMaxArenaSize);
+  } else if (!mModels.push_back(Model{mNextModelHandle,
+                                      nanoapp->getInstanceId(), model,
+                                      modelSize, arenaSize})) {
+    LOG_OOM();
+  } else {
+    *modelHandle = mNextModelHandle;
+    // Skip the invalid handle when wrapping around.
+    mNextModelHandle = (mNextModelHandle == UINT32_MAX) ? 1
+                                                        : mNextModelHandle + 1;
+    success = true;
+  }
+  return success;
+}
+
+bool InferenceManager::unregisterModel(const Nanoapp *nanoapp,
+                                       uint32_t modelHandle) {
+  CHRE_ASSERT(nanoapp);
+
+  size_t index = findModel(modelHandle);
+  bool success = index < mModels.size() &&
+                 mModels[index].instanceId == nanoapp->getInstanceId();
+  if (success) {
+    removeModelAtIndex(index);
+  }
+  return success;
+}
+
+bool InferenceManager::requestInference(const Nanoapp *nanoapp,
+                                        uint32_t modelHandle, const void *input,
+                                        size_t inputSize, void *output,
+                                        size_t outputSize, const void *cookie) {
+  CHRE_ASSERT(nanoapp);
+
+  size_t index = findModel(modelHandle);
+  bool success = false;
+  if (index == mModels.size() ||
+      mModels[index].instanceId != nanoapp->getInstanceId()) {
+    LOGE("Invalid model handle %" PRIu32, modelHandle);
+  } else if (input == nullptr || output == nullptr) {
+    LOGE("Invalid inference buffers");
+  } else if (mRequests.full()) {
+    LOGW("Too many pending inference requests");
+  } else {
+    // Allocate the result event up front, so that the request is rejected
+    // rather than its result lost if memory runs out.
+    auto *result = memoryAlloc<struct chreInferenceResult>();
+    if (result == nullptr) {
+      LOG_OOM();
+    } else {
+      mRequests.push(Request{modelHandle, nanoapp->getInstanceId(), input,
+                             inputSize, output, outputSize, cookie,
+                             SystemTime::getMonotonicTime(), result});
+      scheduleProcessing();
+      success = true;
+    }
+  }
+  return success;
+}
+
+uint32_t InferenceManager::unregisterAllModels(const Nanoapp *nanoapp) {
+  CHRE_ASSERT(nanoapp);
+
+  uint32_t numUnregistered = 0;
+  for (size_t i = mModels.size(); i > 0; i--) {
+    if (mModels[i - 1].instanceId == nanoapp->getInstanceId()) {
+      removeModelAtIndex(i - 1);
+      numUnregistered++;
+    }
+  }
+  return numUnregistered;
+}
+
+InferenceManager::Stats InferenceManager::getStats() const {
+  size_t totalModelArenaSize = 0;
+  for (const Model &model : mModels) {
+    totalModelArenaSize += model.arenaSize;
+  }
+  return Stats{mNumInferences, mNumPrepares, mArenaSize,
+               totalModelArenaSize, mTotalLatency, mMaxLatency};
+}
+
+void InferenceManager::logStateToBuffer(DebugDumpWrapper &debugDump) const {
+  Stats stats = getStats();
+  debugDump.print("\nInference: arena=%zu bytes (models total %zu bytes)"
+                  ", pending=%zu, inferences=%" PRIu32 ", prepares=%" PRIu32
+                  ", maxLatency(ms)=%" PRIu64 "\n",
+                  stats.arenaSize, stats.totalModelArenaSize, mRequests.size(),
+                  stats.numInferences, stats.numPrepares,
+                  Milliseconds(stats.maxLatency).getMilliseconds());
+  for (const Model &model : mModels) {
+    debugDump.print(" handle=%" PRIu32 ", instanceId=%" PRIu16
+                    ", size=%zu, arena=%zu%s\n",
+                    model.handle, model.instanceId, model.size,
+                    model.arenaSize,
+                    (model.handle == mPreparedModelHandle) ? " (prepared)"
+                                                           : "");
+  }
+}
+
+size_t InferenceManager::findModel(uint32_t modelHandle) const {
+  size_t index = 0;
+  while (index < mModels.size() && mModels[index].handle != modelHandle) {
+    index++;
+  }
+  return index;
+}
+
+void InferenceManager::removeModelAtIndex(size_t index) {
+  uint32_t modelHandle = mModels[index].handle;
+  for (size_t i = mRequests.size(); i > 0; i--) {
+    if (mRequests[i - 1].modelHandle == modelHandle) {
+      memoryFree(mRequests[i - 1].result);
+      mRequests.remove(i - 1);
+    }
+  }
+
+  if (mPreparedModelHandle == modelHandle) {
+    releasePreparedModel();
+  }
+  mModels.erase(index);
+
+  // Give the memory back as soon as no model needs it.
+  if (mModels.empty()) {
+    mArena.reset();
+    mArenaSize = 0;
+  }
+}
+
+void InferenceManager::releasePreparedModel() {
+  if (mPreparedModelHandle != CHRE_INFERENCE_INVALID_MODEL_HANDLE) {
+    mBackend->release();
+    mPreparedModelHandle = CHRE_INFERENCE_INVALID_MODEL_HANDLE;
+  }
+}
+
+bool InferenceManager::resizeArena() {
+  size_t arenaSize = 0;
+  for (const Model &model : mModels) {
+    arenaSize = (model.arenaSize > arenaSize) ? model.arenaSize : arenaSize;
+  }
+
+  if (arenaSize != mArenaSize || mArena.isNull()) {
+    releasePreparedModel();
+    // Free the current arena first, so that both never coexist in the heap.
+    mArena.reset();
+    mArena = MakeUniqueArray<uint8_t[]>(arenaSize);
+    mArenaSize = mArena.isNull() ? 0 : arenaSize;
+    if (mArena.isNull()) {
+      LOG_OOM();
+    }
+  }
+  return !mArena.isNull();
+}
+
+void InferenceManager::scheduleProcessing() {
+  if (!mProcessingScheduled) {
+    auto callback = [](uint16_t /*type*/, void * /*data*/,
+                       void * /*extraData*/) {
+      EventLoopManagerSingleton::get()
+          ->getInferenceManager()
+          .processNextRequest();
+    };
+    mProcessingScheduled = EventLoopManagerSingleton::get()->deferCallback(
+        SystemCallbackType::InferenceRequest, /*data=*/nullptr, callback);
+  }
+}
+
+void InferenceManager::processNextRequest() {
+  mProcessingScheduled = false;
+
+  // The queue is empty if the pending requests were removed with their model.
+  if (!mRequests.empty()) {
+    Request request = mRequests.front();
+    mRequests.pop();
+
+    Nanoseconds startTime = SystemTime::getMonotonicTime();
+    uint8_t errorCode = runRequest(request);
+    postResult(request, errorCode, startTime);
+
+    // Run one request per callback, letting other events be dispatched in
+    // between.
+    if (!mRequests.empty()) {
+      scheduleProcessing();
+    }
+  }
+}
+
+uint8_t InferenceManager::runRequest(const Request &request) {
+  mNumInferences++;
+
+  size_t index = findModel(request.modelHandle);
+  CHRE_ASSERT(index < mModels.size());
+  if (!resizeArena()) {
+    return CHRE_ERROR_NO_MEMORY;
+  }
+
+  if (mPreparedModelHandle != request.modelHandle) {
+    releasePreparedModel();
+    mNumPrepares++;
+    const Model &model = mModels[index];
+    if (!mBackend->prepare(model.data, model.size, mArena.get(),
+                           mArenaSize)) {
+      LOGE("Failed to prepare model %" PRIu32, model.handle);
+      return CHRE_ERROR;
+    }
+    mPreparedModelHandle = model.handle;
+  }
+
+  return mBackend->invoke(request.input, request.inputSize, request.output,
+                          request.outputSize)
+             ? CHRE_ERROR_NONE
+             : CHRE_ERROR;
+}
+
+void InferenceManager::postResult(const Request &request, uint8_t errorCode,
+                                  Nanoseconds startTime) {
+  Nanoseconds endTime = SystemTime::getMonotonicTime();
+  Nanoseconds latency = endTime - request.requestTime;
+  mTotalLatency = mTotalLatency + latency;
+  if (latency > mMaxLatency) {
+    mMaxLatency = latency;
+  }
+
+  struct chreInferenceResult *result = request.result;
+  *result = {};
+  result->modelHandle = request.modelHandle;
+  result->errorCode = errorCode;
+  result->output = request.output;
+  result->cookie = request.cookie;
+  result->queueTimeNs = (startTime - request.requestTime).toRawNanoseconds();
+  result->inferenceTimeNs = (endTime - startTime).toRawNanoseconds();
+  EventLoopManagerSingleton::get()->getEventLoop().postEventOrDie(
+      CHRE_EVENT_INFERENCE_RESULT, result, freeEventDataCallback,
+      request.instanceId);
+}
+
+}  // namespace chre
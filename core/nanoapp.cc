@@ -66,12 +66,9 @@ bool Nanoapp::isRegisteredForBroadcastEvent(const Event *event) const {
         static_cast<const chreHostEndpointNotification *>(event->eventData);
     registered = isRegisteredForHostEndpointNotifications(data->hostEndpointId);
   } else {
-    size_t foundIndex = registrationIndex(eventType);
-    if (foundIndex < mRegisteredEvents.size()) {
-      const EventRegistration &reg = mRegisteredEvents[foundIndex];
-      if (targetGroupIdMask & reg.groupIdMask) {
-        registered = true;
-      }
+    const uint16_t *groupIdMask = mRegisteredEvents.find(eventType);
+    if (groupIdMask != nullptr && (targetGroupIdMask & *groupIdMask)) {
+      registered = true;
     }
   }
   return registered;
@@ -79,23 +76,21 @@ bool Nanoapp::isRegisteredForBroadcastEvent(const Event *event) const {
 
 void Nanoapp::registerForBroadcastEvent(uint16_t eventType,
                                         uint16_t groupIdMask) {
-  size_t foundIndex = registrationIndex(eventType);
-  if (foundIndex < mRegisteredEvents.size()) {
-    mRegisteredEvents[foundIndex].groupIdMask |= groupIdMask;
-  } else if (!mRegisteredEvents.push_back(
-                 EventRegistration(eventType, groupIdMask))) {
+  uint16_t *registeredMask = mRegisteredEvents.try_emplace(eventType, 0);
+  if (registeredMask == nullptr) {
     FATAL_ERROR_OOM();
+  } else {
+    *registeredMask |= groupIdMask;
   }
 }
 
 void Nanoapp::unregisterForBroadcastEvent(uint16_t eventType,
                                           uint16_t groupIdMask) {
-  size_t foundIndex = registrationIndex(eventType);
-  if (foundIndex < mRegisteredEvents.size()) {
-    EventRegistration &reg = mRegisteredEvents[foundIndex];
-    reg.groupIdMask &= ~groupIdMask;
-    if (reg.groupIdMask == 0) {
-      mRegisteredEvents.erase(foundIndex);
+  uint16_t *registeredMask = mRegisteredEvents.find(eventType);
+  if (registeredMask != nullptr) {
+    *registeredMask &= ~groupIdMask;
+    if (*registeredMask == 0) {
+      mRegisteredEvents.erase(eventType);
     }
   }
 }
@@ -137,8 +132,10 @@ void Nanoapp::configureUserSettingEvent(uint8_t setting, bool enable) {
   }
 }
 
-void Nanoapp::processEvent(Event *event) {
+Nanoseconds Nanoapp::processEvent(Event *event) {
   Nanoseconds eventStartTime = SystemTime::getMonotonicTime();
+  mEventLatencyStats.addQueueDelay(
+      event->getMillisSinceReceived(eventStartTime));
   // TODO(b/294116163): update trace with event type and nanoapp name so it can
   //                    be differentiated from other events
   CHRE_TRACE_START("Handle event", "nanoapp", getInstanceId());
@@ -160,6 +157,8 @@ void Nanoapp::processEvent(Event *event) {
   mEventProcessTime.addValue(eventTimeMs);
   mEventProcessTimeSinceBoot += eventTimeMs;
   mWakeupBuckets.back().eventProcessTime += eventTimeMs;
+  mEventLatencyStats.addProcessTime(eventProcessTime);
+  return eventProcessTime;
 }
 
 void Nanoapp::blameHostWakeup() {
@@ -330,17 +329,6 @@ bool Nanoapp::permitPermissionUse(uint32_t permission) const {
          ((getAppPermissions() & permission) == permission);
 }
 
-size_t Nanoapp::registrationIndex(uint16_t eventType) const {
-  size_t foundIndex = 0;
-  for (; foundIndex < mRegisteredEvents.size(); ++foundIndex) {
-    const EventRegistration &reg = mRegisteredEvents[foundIndex];
-    if (reg.eventType == eventType) {
-      break;
-    }
-  }
-  return foundIndex;
-}
-
 void Nanoapp::handleGnssMeasurementDataEvent(const Event *event) {
 #ifdef CHRE_GNSS_MEASUREMENT_BACK_COMPAT_ENABLED
   const struct chreGnssDataEvent *data =
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/core/nanoapp_index.h"
+
+#include <atomic>
+
+#include "chre/platform/assert.h"
+
+namespace chre {
+
+constexpr size_t NanoappIndex::kNumSlots;
+constexpr size_t NanoappIndex::kMaxNumNanoapps;
+
+bool NanoappIndex::add(uint64_t appId, uint16_t instanceId, Nanoapp *nanoapp) {
+  CHRE_ASSERT(nanoapp != nullptr);
+  if (nanoapp == nullptr || findAppIdSlot(appId) != kNumSlots ||
+      findInstanceIdSlot(instanceId) != kNumSlots) {
+    return false;
+  }
+
+  beginWrite();
+  if (mSize < kMaxNumNanoapps) {
+    insert(appId, instanceId, nanoapp);
+  } else {
+    mNumUnindexed++;
+  }
+  endWrite();
+  return true;
+}
+
+bool NanoappIndex::remove(uint64_t appId, uint16_t instanceId) {
+  size_t appIdIndex = findAppIdSlot(appId);
+  size_t instanceIdIndex = findInstanceIdSlot(instanceId);
+  if (appIdIndex == kNumSlots || instanceIdIndex == kNumSlots) {
+    // Not indexed, so it must be one of the nanoapps added while full
+    if (mNumUnindexed > 0) {
+      beginWrite();
+      mNumUnindexed--;
+      endWrite();
+    }
+    return false;
+  }
+
+  beginWrite();
+  removeSlot(mByAppId, appIdIndex,
+             [](const Slot &slot) { return hashAppId(slot.appId); });
+  removeSlot(mByInstanceId, instanceIdIndex,
+             [](const Slot &slot) { return hashInstanceId(slot.instanceId); });
+  mSize--;
+  endWrite();
+  return true;
+}
+
+bool NanoappIndex::reindex(uint64_t appId, uint16_t instanceId,
+                           Nanoapp *nanoapp) {
+  CHRE_ASSERT(nanoapp != nullptr);
+  if (nanoapp == nullptr || mNumUnindexed == 0 || mSize >= kMaxNumNanoapps ||
+      findAppIdSlot(appId) != kNumSlots ||
+      findInstanceIdSlot(instanceId) != kNumSlots) {
+    return false;
+  }
+
+  // Done in a single modification so that readers never miss the nanoapp
+  beginWrite();
+  insert(appId, instanceId, nanoapp);
+  mNumUnindexed--;
+  endWrite();
+  return true;
+}
+
+Nanoapp *NanoappIndex::findByAppId(uint64_t appId) const {
+  size_t index = findAppIdSlot(appId);
+  return (index < kNumSlots) ? mByAppId[index].nanoapp : nullptr;
+}
+
+Nanoapp *NanoappIndex::findByInstanceId(uint16_t instanceId) const {
+  size_t index = findInstanceIdSlot(instanceId);
+  return (index < kNumSlots) ? mByInstanceId[index].nanoapp : nullptr;
+}
+
+NanoappIndex::LookupResult NanoappIndex::findInstanceIdByAppId(
+    uint64_t appId, uint16_t *instanceId) const {
+  CHRE_ASSERT(instanceId != nullptr);
+  for (uint8_t attempt = 0; attempt < kMaxReadAttempts; attempt++) {
+    uint32_t sequence = mSequence.load();
+    if ((sequence & 1) == 0) {
+      size_t index = findAppIdSlot(appId);
+      uint16_t foundInstanceId =
+          (index < kNumSlots) ? mByAppId[index].instanceId : 0;
+      bool complete = (mNumUnindexed == 0);
+
+      // Keeps the reads of the tables from being reordered after the check
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (mSequence.load() == sequence) {
+        if (index == kNumSlots) {
+          return complete ? LookupResult::NotFound : LookupResult::NotIndexed;
+        }
+        *instanceId = foundInstanceId;
+        return LookupResult::Found;
+      }
+    }
+  }
+  return LookupResult::Contended;
+}
+
+NanoappIndex::LookupResult NanoappIndex::containsInstanceId(
+    uint16_t instanceId) const {
+  for (uint8_t attempt = 0; attempt < kMaxReadAttempts; attempt++) {
+    uint32_t sequence = mSequence.load();
+    if ((sequence & 1) == 0) {
+      bool found = (findInstanceIdSlot(instanceId) != kNumSlots);
+      bool complete = (mNumUnindexed == 0);
+
+      // Keeps the reads of the tables from being reordered after the check
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (mSequence.load() == sequence) {
+        if (found) {
+          return LookupResult::Found;
+        }
+        return complete ? LookupResult::NotFound : LookupResult::NotIndexed;
+      }
+    }
+  }
+  return LookupResult::Contended;
+}
+
+void NanoappIndex::insert(uint64_t appId, uint16_t instanceId,
+                          Nanoapp *nanoapp) {
+  size_t index = hashAppId(appId);
+  while (mByAppId[index].nanoapp != nullptr) {
+    index = (index + 1) & (kNumSlots - 1);
+  }
+  mByAppId[index] = {appId, instanceId, nanoapp};
+
+  index = hashInstanceId(instanceId);
+  while (mByInstanceId[index].nanoapp != nullptr) {
+    index = (index + 1) & (kNumSlots - 1);
+  }
+  mByInstanceId[index] = {appId, instanceId, nanoapp};
+  mSize++;
+}
+
+size_t NanoappIndex::hashAppId(uint64_t appId) {
+  // App IDs share their vendor prefix in the upper bytes, so fold them before
+  // a multiplicative hash that mixes the low bits into the upper ones
+  uint32_t folded = static_cast<uint32_t>(appId ^ (appId >> 32));
+  return ((folded * UINT32_C(0x9E3779B1)) >> 16) & (kNumSlots - 1);
+}
+
+size_t NanoappIndex::findAppIdSlot(uint64_t appId) const {
+  size_t index = hashAppId(appId);
+  for (size_t i = 0; i < kNumSlots; i++) {
+    const Slot &slot = mByAppId[index];
+    if (slot.nanoapp == nullptr) {
+      break;
+    } else if (slot.appId == appId) {
+      return index;
+    }
+    index = (index + 1) & (kNumSlots - 1);
+  }
+  return kNumSlots;
+}
+
+size_t NanoappIndex::findInstanceIdSlot(uint16_t instanceId) const {
+  size_t index = hashInstanceId(instanceId);
+  for (size_t i = 0; i < kNumSlots; i++) {
+    const Slot &slot = mByInstanceId[index];
+    if (slot.nanoapp == nullptr) {
+      break;
+    } else if (slot.instanceId == instanceId) {
+      return index;
+    }
+    index = (index + 1) & (kNumSlots - 1);
+  }
+  return kNumSlots;
+}
+
+template <typename HashFunction>
+void NanoappIndex::removeSlot(Slot *table, size_t index,
+                              HashFunction hashFunction) {
+  size_t next = index;
+  while (true) {
+    next = (next + 1) & (kNumSlots - 1);
+    if (table[next].nanoapp == nullptr) {
+      break;
+    }
+
+    // The slot at next can be moved to index only if its home slot isn't
+    // cyclically in (index, next]
+    size_t home = hashFunction(table[next]);
+    bool homeInRange = (index <= next) ? (home > index && home <= next)
+                                       : (home > index || home <= next);
+    if (!homeInRange) {
+      table[index] = table[next];
+      index = next;
+    }
+  }
+  table[index] = {};
+}
+
+}  // namespace chre
@@ -527,10 +527,13 @@ void SensorRequestManager::handleSamplingStatusUpdate(
     };
 
     // Schedule a deferred callback to handle sensor status change in the main
-    // thread.
-    EventLoopManagerSingleton::get()->deferCallback(
-        SystemCallbackType::SensorStatusUpdate,
-        NestedDataPtr<uint32_t>(sensorHandle), callback, status);
+    // thread. The event loop rejects it once it is stopping, e.g. when the
+    // sensors are disabled as nanoapps are unloaded on shutdown.
+    if (!EventLoopManagerSingleton::get()->deferCallback(
+            SystemCallbackType::SensorStatusUpdate,
+            NestedDataPtr<uint32_t>(sensorHandle), callback, status)) {
+      releaseSamplingStatusUpdate(status);
+    }
   }
 }
 
@@ -88,7 +88,9 @@ void sendPalOpenFailedMetric(
 }
 
 void sendEventLoopStats(uint32_t maxQueueSize, uint32_t meanQueueSize,
-                        uint32_t numDroppedEvents) {
+                        uint32_t numDroppedEvents, uint64_t maxQueueDelayUs,
+                        uint64_t meanQueueDelayUs,
+                        uint32_t numBudgetOverruns) {
   _android_hardware_google_pixel_PixelAtoms_ChreEventQueueSnapshotReported
       result = PIXELATOMS_GET(ChreEventQueueSnapshotReported_init_default);
   result.has_snapshot_chre_get_time_ms = true;
@@ -101,6 +103,12 @@ void sendEventLoopStats(uint32_t maxQueueSize, uint32_t meanQueueSize,
   result.mean_event_queue_size = meanQueueSize;
   result.has_num_dropped_events = true;
   result.num_dropped_events = numDroppedEvents;
+  result.has_max_queue_delay_us = true;
+  result.max_queue_delay_us = maxQueueDelayUs;
+  result.has_mean_queue_delay_us = true;
+  result.mean_queue_delay_us = meanQueueDelayUs;
+  result.has_num_event_process_budget_overruns = true;
+  result.num_event_process_budget_overruns = numBudgetOverruns;
 
   sendMetricToHost(kEventQueueSnapshotReportedId,
                    CHREATOMS_GET(ChreEventQueueSnapshotReported_fields),
@@ -157,7 +165,10 @@ void TelemetryManager::collectSystemMetrics() {
   EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
   sendEventLoopStats(eventLoop.getMaxEventQueueSize(),
                      eventLoop.getMeanEventQueueSize(),
-                     eventLoop.getNumEventsDropped());
+                     eventLoop.getNumEventsDropped(),
+                     eventLoop.getMaxEventQueueDelayUs(),
+                     eventLoop.getMeanEventQueueDelayUs(),
+                     eventLoop.getNumEventProcessBudgetOverruns());
 
   scheduleMetricTimer();
 }
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "chre/core/ble_advertisement_filter.h"
+#include "chre/core/ble_request.h"
+
+using chre::BleAdvertisementFilter;
+using chre::BleRequest;
+
+namespace {
+
+//! A flags AD structure followed by service data for UUID 0xFE2C.
+const uint8_t kServiceData[] = {0x02, 0x01, 0x06, 0x05, 0x16,
+                                0x2C, 0xFE, 0x12, 0x34};
+
+chreBleAdvertisingReport makeReport(const uint8_t *data, uint16_t dataLength,
+                                    int8_t rssi) {
+  chreBleAdvertisingReport report = {};
+  report.data = data;
+  report.dataLength = dataLength;
+  report.rssi = rssi;
+  for (uint8_t i = 0; i < CHRE_BLE_ADDRESS_LEN; i++) {
+    report.address[i] = i + 1;
+  }
+  return report;
+}
+
+chreBleGenericFilter makeServiceDataFilter(uint8_t uuidLow, uint8_t uuidHigh) {
+  chreBleGenericFilter filter = {};
+  filter.type = CHRE_BLE_AD_TYPE_SERVICE_DATA_WITH_UUID_16_LE;
+  filter.len = 2;
+  filter.data[0] = uuidLow;
+  filter.data[1] = uuidHigh;
+  filter.dataMask[0] = 0xFF;
+  filter.dataMask[1] = 0xFF;
+  return filter;
+}
+
+BleRequest makeRequest(const chreBleScanFilterV1_9 *filter) {
+  return BleRequest(0 /* instanceId */, true /* enable */,
+                    CHRE_BLE_SCAN_MODE_AGGRESSIVE, 0 /* reportDelayMs */,
+                    filter, nullptr /* cookie */);
+}
+
+}  // namespace
+
+TEST(BleAdvertisementFilter, RequestWithoutFilterMatchesAll) {
+  BleRequest request = makeRequest(nullptr /* filter */);
+  BleAdvertisementFilter filter(request);
+
+  EXPECT_TRUE(filter.matchesAll());
+  EXPECT_TRUE(filter.matches(makeReport(nullptr, 0, -100)));
+}
+
+TEST(BleAdvertisementFilter, MatchesGenericFilter) {
+  chreBleGenericFilter genericFilters[] = {makeServiceDataFilter(0xAA, 0xFE),
+                                           makeServiceDataFilter(0x2C, 0xFE)};
+  chreBleScanFilterV1_9 scanFilter = {};
+  scanFilter.rssiThreshold = CHRE_BLE_RSSI_THRESHOLD_NONE;
+  scanFilter.genericFilterCount = 2;
+  scanFilter.genericFilters = genericFilters;
+  BleRequest request = makeRequest(&scanFilter);
+  BleAdvertisementFilter filter(request);
+
+  EXPECT_FALSE(filter.matchesAll());
+  EXPECT_TRUE(
+      filter.matches(makeReport(kServiceData, sizeof(kServiceData), -50)));
+  // Only the flags AD structure
+  EXPECT_FALSE(filter.matches(makeReport(kServiceData, 3, -50)));
+  // Truncated service data AD structure
+  EXPECT_FALSE(filter.matches(makeReport(kServiceData, 6, -50)));
+  EXPECT_FALSE(filter.matches(makeReport(nullptr, 0, -50)));
+}
+
+TEST(BleAdvertisementFilter, AppliesDataMask) {
+  chreBleGenericFilter genericFilter = makeServiceDataFilter(0x20, 0xFE);
+  genericFilter.dataMask[0] = 0xF0;
+  chreBleScanFilterV1_9 scanFilter = {};
+  scanFilter.rssiThreshold = CHRE_BLE_RSSI_THRESHOLD_NONE;
+  scanFilter.genericFilterCount = 1;
+  scanFilter.genericFilters = &genericFilter;
+  BleRequest request = makeRequest(&scanFilter);
+  BleAdvertisementFilter filter(request);
+
+  EXPECT_TRUE(
+      filter.matches(makeReport(kServiceData, sizeof(kServiceData), -50)));
+}
+
+TEST(BleAdvertisementFilter, RssiThresholdIsAndedWithOtherFilters) {
+  chreBleGenericFilter genericFilter = makeServiceDataFilter(0x2C, 0xFE);
+  chreBleScanFilterV1_9 scanFilter = {};
+  scanFilter.rssiThreshold = -60;
+  scanFilter.genericFilterCount = 1;
+  scanFilter.genericFilters = &genericFilter;
+  BleRequest request = makeRequest(&scanFilter);
+  BleAdvertisementFilter filter(request);
+
+  EXPECT_TRUE(
+      filter.matches(makeReport(kServiceData, sizeof(kServiceData), -50)));
+  EXPECT_FALSE(
+      filter.matches(makeReport(kServiceData, sizeof(kServiceData), -70)));
+  EXPECT_TRUE(filter.matches(
+      makeReport(kServiceData, sizeof(kServiceData), CHRE_BLE_RSSI_NONE)));
+}
+
+TEST(BleAdvertisementFilter, BroadcasterFilterIsOredWithGenericFilters) {
+  chreBleGenericFilter genericFilter = makeServiceDataFilter(0xAA, 0xFE);
+  chreBleBroadcasterAddressFilter broadcasterFilter = {{1, 2, 3, 4, 5, 6}};
+  chreBleScanFilterV1_9 scanFilter = {};
+  scanFilter.rssiThreshold = CHRE_BLE_RSSI_THRESHOLD_NONE;
+  scanFilter.genericFilterCount = 1;
+  scanFilter.genericFilters = &genericFilter;
+  scanFilter.broadcasterAddressFilterCount = 1;
+  scanFilter.broadcasterAddressFilters = &broadcasterFilter;
+  BleRequest request = makeRequest(&scanFilter);
+  BleAdvertisementFilter filter(request);
+
+  chreBleAdvertisingReport report =
+      makeReport(kServiceData, sizeof(kServiceData), -50);
+  EXPECT_TRUE(filter.matches(report));
+  report.address[0] = 0xFF;
+  EXPECT_FALSE(filter.matches(report));
+}
@@ -48,7 +48,7 @@ TEST(BleRequest, AggressiveModeIsHigherThanBackground) {
 }
 
 TEST(BleRequest, MergeWithReplacesParametersOfDisabledRequest) {
-  chreBleScanFilterV1_9 filter;
+  chreBleScanFilterV1_9 filter{};
   filter.rssiThreshold = -5;
   filter.genericFilterCount = 1;
   auto scanFilters = std::make_unique<chreBleGenericFilter>();
@@ -101,7 +101,7 @@ TEST(BleRequest, IsNotEquivalentWithCookie) {
 }
 
 TEST(BleRequest, IsEquivalentToAdvanced) {
-  chreBleScanFilterV1_9 filter;
+  chreBleScanFilterV1_9 filter{};
   filter.rssiThreshold = -5;
   filter.genericFilterCount = 1;
   auto scanFilters = std::make_unique<chreBleGenericFilter>();
@@ -116,7 +116,7 @@ TEST(BleRequest, IsEquivalentToAdvanced) {
 }
 
 TEST(BleRequest, IsNotEquivalentToAdvanced) {
-  chreBleScanFilterV1_9 filter;
+  chreBleScanFilterV1_9 filter{};
   filter.rssiThreshold = -5;
   filter.genericFilterCount = 1;
   auto scanFilters = std::make_unique<chreBleGenericFilter>();
@@ -135,7 +135,7 @@ TEST(BleRequest, IsNotEquivalentToAdvanced) {
 }
 
 TEST(BleRequest, GetScanFilter) {
-  chreBleScanFilterV1_9 filter;
+  chreBleScanFilterV1_9 filter{};
   filter.rssiThreshold = -5;
   filter.genericFilterCount = 1;
   auto scanFilters = std::make_unique<chreBleGenericFilter>();
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "chre/core/heap_profiler.h"
+
+using chre::HeapProfiler;
+
+namespace {
+constexpr uint64_t kAppId1 = 0x0123456789000001;
+constexpr uint64_t kAppId2 = 0x0123456789000002;
+constexpr uintptr_t kSite1 = 0x1000;
+constexpr uintptr_t kSite2 = 0x2000;
+}  // namespace
+
+TEST(HeapProfiler, AllocationsAreGroupedBySite) {
+  HeapProfiler profiler;
+  uint16_t index1 = profiler.recordAlloc(kAppId1, kSite1, 16);
+  uint16_t index2 = profiler.recordAlloc(kAppId1, kSite2, 100);
+  EXPECT_EQ(profiler.recordAlloc(kAppId1, kSite1, 32), index1);
+  // The same address in another nanoapp is a different site.
+  uint16_t index3 = profiler.recordAlloc(kAppId2, kSite1, 8);
+
+  EXPECT_NE(index1, index2);
+  EXPECT_NE(index1, index3);
+  ASSERT_EQ(profiler.getNumSites(), 3u);
+
+  const HeapProfiler::Site &site = profiler.getSite(index1);
+  EXPECT_EQ(site.appId, kAppId1);
+  EXPECT_EQ(site.returnAddress, kSite1);
+  EXPECT_EQ(site.numAllocs, 2u);
+  EXPECT_EQ(site.liveBytes, 48u);
+  EXPECT_EQ(site.peakLiveBytes, 48u);
+  // 16 is in [16, 32) and 32 is in [32, 64).
+  EXPECT_EQ(site.sizeBytes.getCount(5), 1u);
+  EXPECT_EQ(site.sizeBytes.getCount(6), 1u);
+}
+
+TEST(HeapProfiler, FreeRecordsLifetimeAndLiveBytes) {
+  HeapProfiler profiler;
+  uint16_t index = profiler.recordAlloc(kAppId1, kSite1, 64);
+  profiler.recordAlloc(kAppId1, kSite1, 64);
+  profiler.recordFree(index, 64, /* lifetimeMs= */ 5);
+
+  const HeapProfiler::Site &site = profiler.getSite(index);
+  EXPECT_EQ(site.numFrees, 1u);
+  EXPECT_EQ(site.liveBytes, 64u);
+  EXPECT_EQ(site.peakLiveBytes, 128u);
+  EXPECT_EQ(site.lifetimeMs.getTotalCount(), 1u);
+  // 5 is in [4, 8).
+  EXPECT_EQ(site.lifetimeMs.getCount(3), 1u);
+}
+
+TEST(HeapProfiler, FailedAllocationsAreCounted) {
+  HeapProfiler profiler;
+  profiler.recordFailedAlloc(kAppId1, kSite1, 4096);
+
+  ASSERT_EQ(profiler.getNumSites(), 1u);
+  const HeapProfiler::Site &site = profiler.getSite(0);
+  EXPECT_EQ(site.numAllocs, 0u);
+  EXPECT_EQ(site.numFailedAllocs, 1u);
+  EXPECT_EQ(site.liveBytes, 0u);
+  EXPECT_EQ(site.sizeBytes.getTotalCount(), 1u);
+}
+
+TEST(HeapProfiler, SitesBeyondCapacityAreUntracked) {
+  HeapProfiler profiler;
+  for (uintptr_t i = 0; i < HeapProfiler::kMaxSites; i++) {
+    EXPECT_NE(profiler.recordAlloc(kAppId1, kSite1 + i, 1),
+              HeapProfiler::kInvalidSiteIndex);
+  }
+
+  uint16_t index = profiler.recordAlloc(kAppId2, kSite1, 1);
+  EXPECT_EQ(index, HeapProfiler::kInvalidSiteIndex);
+  EXPECT_EQ(profiler.getNumUntrackedAllocs(), 1u);
+  EXPECT_EQ(profiler.getNumSites(), HeapProfiler::kMaxSites);
+
+  // Freeing an untracked allocation is ignored.
+  profiler.recordFree(index, 1, /* lifetimeMs= */ 0);
+}
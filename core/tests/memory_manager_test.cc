@@ -107,3 +107,29 @@ TEST(MemoryManager, NegativeAllocationFails) {
   EXPECT_EQ(manager.getTotalAllocatedBytes(), 0u);
   EXPECT_EQ(manager.getAllocationCount(), 0u);
 }
+
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+TEST(MemoryManager, AllocationsAreProfiledByCallSite) {
+  MemoryManager manager;
+  Nanoapp app(kInvalidInstanceId);
+  constexpr uintptr_t kCallSite = 0x1234;
+  void *ptr = manager.nanoappAlloc(&app, 10u, kCallSite);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(manager.nanoappAlloc(&app, manager.getMaxAllocationBytes() + 1,
+                                 kCallSite),
+            nullptr);
+
+  const chre::HeapProfiler &profiler = manager.getHeapProfiler();
+  ASSERT_EQ(profiler.getNumSites(), 1u);
+  const chre::HeapProfiler::Site &site = profiler.getSite(0);
+  EXPECT_EQ(site.returnAddress, kCallSite);
+  EXPECT_EQ(site.numAllocs, 1u);
+  EXPECT_EQ(site.numFailedAllocs, 1u);
+  EXPECT_EQ(site.liveBytes, 10u);
+
+  manager.nanoappFree(&app, ptr);
+  EXPECT_EQ(site.numFrees, 1u);
+  EXPECT_EQ(site.liveBytes, 0u);
+  EXPECT_EQ(site.lifetimeMs.getTotalCount(), 1u);
+}
+#endif  // CHRE_HEAP_PROFILER_ENABLED
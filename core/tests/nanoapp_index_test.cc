@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "chre/core/nanoapp_index.h"
+
+using chre::Nanoapp;
+using chre::NanoappIndex;
+using LookupResult = chre::NanoappIndex::LookupResult;
+
+namespace {
+
+//! The index never dereferences the nanoapps, so distinct addresses are enough.
+char gFakeNanoapps[NanoappIndex::kNumSlots];
+
+Nanoapp *getFakeNanoapp(size_t i) {
+  return reinterpret_cast<Nanoapp *>(&gFakeNanoapps[i]);
+}
+
+//! Returns app IDs sharing the same vendor prefix, like real nanoapps.
+uint64_t getAppId(size_t i) {
+  return UINT64_C(0x476f6f676c000000) + i;
+}
+
+}  // namespace
+
+TEST(NanoappIndex, IsEmptyByDefault) {
+  NanoappIndex index;
+  uint16_t instanceId;
+
+  EXPECT_EQ(index.size(), 0);
+  EXPECT_EQ(index.findByAppId(getAppId(0)), nullptr);
+  EXPECT_EQ(index.findByInstanceId(1), nullptr);
+  EXPECT_EQ(index.findInstanceIdByAppId(getAppId(0), &instanceId),
+            LookupResult::NotFound);
+  EXPECT_EQ(index.containsInstanceId(1), LookupResult::NotFound);
+}
+
+TEST(NanoappIndex, FindsAddedNanoapps) {
+  NanoappIndex index;
+
+  for (uint16_t i = 0; i < 10; i++) {
+    EXPECT_TRUE(index.add(getAppId(i), i + 1, getFakeNanoapp(i)));
+  }
+  EXPECT_EQ(index.size(), 10);
+
+  for (uint16_t i = 0; i < 10; i++) {
+    uint16_t instanceId = 0;
+    EXPECT_EQ(index.findByAppId(getAppId(i)), getFakeNanoapp(i));
+    EXPECT_EQ(index.findByInstanceId(i + 1), getFakeNanoapp(i));
+    EXPECT_EQ(index.findInstanceIdByAppId(getAppId(i), &instanceId),
+              LookupResult::Found);
+    EXPECT_EQ(instanceId, i + 1);
+    EXPECT_EQ(index.containsInstanceId(i + 1), LookupResult::Found);
+  }
+  EXPECT_EQ(index.findByAppId(getAppId(10)), nullptr);
+  EXPECT_EQ(index.findByInstanceId(11), nullptr);
+}
+
+TEST(NanoappIndex, RejectsDuplicateIds) {
+  NanoappIndex index;
+
+  EXPECT_TRUE(index.add(getAppId(0), 1, getFakeNanoapp(0)));
+  EXPECT_FALSE(index.add(getAppId(0), 2, getFakeNanoapp(1)));
+  EXPECT_FALSE(index.add(getAppId(1), 1, getFakeNanoapp(1)));
+  EXPECT_EQ(index.size(), 1);
+}
+
+TEST(NanoappIndex, CountsNanoappsBeyondCapacityAsUnindexed) {
+  NanoappIndex index;
+  constexpr uint16_t kMax = NanoappIndex::kMaxNumNanoapps;
+  uint16_t instanceId;
+
+  for (uint16_t i = 0; i < kMax; i++) {
+    EXPECT_TRUE(index.add(getAppId(i), i + 1, getFakeNanoapp(i)));
+  }
+  EXPECT_EQ(index.findInstanceIdByAppId(getAppId(kMax), &instanceId),
+            LookupResult::NotFound);
+
+  EXPECT_TRUE(index.add(getAppId(kMax), kMax + 1, getFakeNanoapp(kMax)));
+  EXPECT_EQ(index.size(), kMax);
+  EXPECT_EQ(index.getNumUnindexed(), 1);
+  EXPECT_EQ(index.findByAppId(getAppId(kMax)), nullptr);
+  EXPECT_EQ(index.findInstanceIdByAppId(getAppId(kMax), &instanceId),
+            LookupResult::NotIndexed);
+  EXPECT_EQ(index.containsInstanceId(kMax + 1), LookupResult::NotIndexed);
+  EXPECT_EQ(index.containsInstanceId(1), LookupResult::Found);
+
+  EXPECT_FALSE(index.remove(getAppId(kMax), kMax + 1));
+  EXPECT_EQ(index.getNumUnindexed(), 0);
+  EXPECT_EQ(index.containsInstanceId(kMax + 1), LookupResult::NotFound);
+}
+
+TEST(NanoappIndex, ReindexesNanoappsOnceThereIsRoom) {
+  NanoappIndex index;
+  constexpr uint16_t kMax = NanoappIndex::kMaxNumNanoapps;
+
+  for (uint16_t i = 0; i <= kMax; i++) {
+    EXPECT_TRUE(index.add(getAppId(i), i + 1, getFakeNanoapp(i)));
+  }
+  EXPECT_FALSE(index.reindex(getAppId(kMax), kMax + 1, getFakeNanoapp(kMax)));
+
+  EXPECT_TRUE(index.remove(getAppId(0), 1));
+  EXPECT_TRUE(index.reindex(getAppId(kMax), kMax + 1, getFakeNanoapp(kMax)));
+  EXPECT_EQ(index.size(), kMax);
+  EXPECT_EQ(index.getNumUnindexed(), 0);
+  EXPECT_EQ(index.findByInstanceId(kMax + 1), getFakeNanoapp(kMax));
+  EXPECT_EQ(index.containsInstanceId(1), LookupResult::NotFound);
+}
+
+TEST(NanoappIndex, RemoveKeepsCollidingNanoappsReachable) {
+  NanoappIndex index;
+
+  // These instance IDs all share the same home slot
+  constexpr uint16_t kStride = NanoappIndex::kNumSlots;
+  for (uint16_t i = 0; i < 4; i++) {
+    EXPECT_TRUE(index.add(getAppId(i), 1 + i * kStride, getFakeNanoapp(i)));
+  }
+
+  EXPECT_TRUE(index.remove(getAppId(1), 1 + kStride));
+  EXPECT_FALSE(index.remove(getAppId(1), 1 + kStride));
+  EXPECT_EQ(index.size(), 3);
+
+  EXPECT_EQ(index.findByInstanceId(1), getFakeNanoapp(0));
+  EXPECT_EQ(index.findByInstanceId(1 + kStride), nullptr);
+  EXPECT_EQ(index.findByInstanceId(1 + 2 * kStride), getFakeNanoapp(2));
+  EXPECT_EQ(index.findByInstanceId(1 + 3 * kStride), getFakeNanoapp(3));
+  EXPECT_EQ(index.findByAppId(getAppId(1)), nullptr);
+  EXPECT_EQ(index.findByAppId(getAppId(3)), getFakeNanoapp(3));
+}
+
+TEST(NanoappIndex, SlotsAreReusedAfterRemoval) {
+  NanoappIndex index;
+
+  // Repeatedly load and unload nanoapps like a stress test would
+  for (uint16_t i = 0; i < 10 * NanoappIndex::kNumSlots; i++) {
+    size_t slot = i % NanoappIndex::kMaxNumNanoapps;
+    if (i >= NanoappIndex::kMaxNumNanoapps) {
+      uint16_t previous = i - NanoappIndex::kMaxNumNanoapps;
+      EXPECT_TRUE(index.remove(getAppId(previous), previous + 1));
+    }
+    EXPECT_TRUE(index.add(getAppId(i), i + 1, getFakeNanoapp(slot)));
+  }
+
+  for (uint16_t i = 10 * NanoappIndex::kNumSlots - NanoappIndex::kMaxNumNanoapps;
+       i < 10 * NanoappIndex::kNumSlots; i++) {
+    EXPECT_EQ(index.findByInstanceId(i + 1),
+              getFakeNanoapp(i % NanoappIndex::kMaxNumNanoapps));
+    EXPECT_EQ(index.findByAppId(getAppId(i)),
+              getFakeNanoapp(i % NanoappIndex::kMaxNumNanoapps));
+  }
+}
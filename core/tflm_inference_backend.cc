@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cinttypes>
+#include <cstring>
+#include <new>
+
+#include "chre/core/inference_manager.h"
+#include "chre/platform/log.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace chre {
+namespace {
+
+//! The number of operators registered in the resolver below.
+constexpr unsigned int kNumOps = 14;
+
+using OpResolver = tflite::MicroMutableOpResolver<kNumOps>;
+
+//! The operators used by the models of typical sensor and audio nanoapps.
+//! Registering only these keeps the unused kernels out of the binary.
+OpResolver *getOpResolver() {
+  alignas(OpResolver) static uint8_t storage[sizeof(OpResolver)];
+  static OpResolver *resolver = nullptr;
+  if (resolver == nullptr) {
+    resolver = new (storage) OpResolver();
+    resolver->AddAdd();
+    resolver->AddAveragePool2D();
+    resolver->AddConv2D();
+    resolver->AddDepthwiseConv2D();
+    resolver->AddDequantize();
+    resolver->AddFullyConnected();
+    resolver->AddLogistic();
+    resolver->AddMaxPool2D();
+    resolver->AddMul();
+    resolver->AddQuantize();
+    resolver->AddRelu();
+    resolver->AddReshape();
+    resolver->AddSoftmax();
+    resolver->AddTanh();
+  }
+  return resolver;
+}
+
+//! The interpreter of the prepared model, constructed in place so that no
+//! heap allocation is needed beyond the shared arena.
+alignas(tflite::MicroInterpreter) uint8_t
+    gInterpreterStorage[sizeof(tflite::MicroInterpreter)];
+tflite::MicroInterpreter *gInterpreter = nullptr;
+
+void release() {
+  if (gInterpreter != nullptr) {
+    gInterpreter->~MicroInterpreter();
+    gInterpreter = nullptr;
+  }
+}
+
+bool prepare(const void *model, size_t /*modelSize*/, uint8_t *arena,
+             size_t arenaSize) {
+  const tflite::Model *tfliteModel = tflite::GetModel(model);
+  if (tfliteModel->version() != TFLITE_SCHEMA_VERSION) {
+    LOGE("Unsupported TFLite schema version %" PRIu32,
+         tfliteModel->version());
+    return false;
+  }
+
+  gInterpreter = new (gInterpreterStorage)
+      tflite::MicroInterpreter(tfliteModel, *getOpResolver(), arena, arenaSize);
+  if (gInterpreter->AllocateTensors() != kTfLiteOk) {
+    LOGE("Model doesn't fit in a %zu bytes arena", arenaSize);
+    release();
+    return false;
+  }
+  LOGD("Model uses %zu/%zu bytes of the arena", gInterpreter->arena_used_bytes(),
+       arenaSize);
+  return true;
+}
+
+bool invoke(const void *input, size_t inputSize, void *output,
+            size_t outputSize) {
+  TfLiteTensor *inputTensor = gInterpreter->input(0);
+  TfLiteTensor *outputTensor = gInterpreter->output(0);
+  if (inputTensor->bytes != inputSize || outputTensor->bytes > outputSize) {
+    LOGE("Tensor size mismatch: input %zu/%zu, output %zu/%zu",
+         inputSize, inputTensor->bytes, outputSize, outputTensor->bytes);
+    return false;
+  }
+
+  memcpy(inputTensor->data.raw, input, inputSize);
+  if (gInterpreter->Invoke() != kTfLiteOk) {
+    return false;
+  }
+  memcpy(output, outputTensor->data.raw, outputTensor->bytes);
+  return true;
+}
+
+constexpr InferenceBackend kTflmBackend = {prepare, invoke, release};
+
+}  // anonymous namespace
+
+const InferenceBackend *getTflmInferenceBackend() {
+  return &kTflmBackend;
+}
+
+}  // namespace chre
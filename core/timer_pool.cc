@@ -18,7 +18,6 @@
 #include "chre/core/event.h"
 #include "chre/core/event_loop.h"
 #include "chre/core/event_loop_common.h"
-#include "chre/core/event_loop_manager.h"
 #include "chre/platform/fatal_error.h"
 #include "chre/platform/system_time.h"
 #include "chre/target_platform/log.h"
@@ -27,7 +26,7 @@
 
 namespace chre {
 
-TimerPool::TimerPool() {
+TimerPool::TimerPool(EventLoop &eventLoop) : mEventLoop(eventLoop) {
   if (!mSystemTimer.init()) {
     FATAL_ERROR("Failed to initialize a system timer for the TimerPool");
   }
@@ -259,16 +258,15 @@ bool TimerPool::handleExpiredTimersAndScheduleNextLocked() {
       // submit a deferred callback if it's a system timer.
       bool success;
       if (currentTimerRequest.instanceId == kSystemInstanceId) {
-        success = EventLoopManagerSingleton::get()->deferCallback(
-            currentTimerRequest.callbackType,
+        success = mEventLoop.postSystemEvent(
+            static_cast<uint16_t>(currentTimerRequest.callbackType),
             const_cast<void *>(currentTimerRequest.cookie),
-            currentTimerRequest.systemCallback);
+            currentTimerRequest.systemCallback, /* extraData= */ nullptr);
       } else {
-        success = EventLoopManagerSingleton::get()->deferCallback(
-            SystemCallbackType::TimerPoolTimerExpired,
+        success = mEventLoop.postSystemEvent(
+            static_cast<uint16_t>(SystemCallbackType::TimerPoolTimerExpired),
             NestedDataPtr<TimerHandle>(currentTimerRequest.timerHandle),
-            TimerPool::handleTimerExpiredCallback,
-            this);
+            TimerPool::handleTimerExpiredCallback, this);
       }
       if (!success) {
         LOGW("Failed to defer timer callback");
@@ -327,8 +325,10 @@ void TimerPool::handleSystemTimerCallback(void *timerPoolPtr) {
     }
   };
 
-  EventLoopManagerSingleton::get()->deferCallback(
-      SystemCallbackType::TimerPoolTick, timerPoolPtr, callback);
+  static_cast<TimerPool *>(timerPoolPtr)
+      ->mEventLoop.postSystemEvent(
+          static_cast<uint16_t>(SystemCallbackType::TimerPoolTick),
+          timerPoolPtr, callback, /* extraData= */ nullptr);
 }
 
 void TimerPool::handleTimerExpiredCallback(uint16_t /* type */, void *data,
@@ -353,7 +353,7 @@ void TimerPool::handleTimerExpiredCallback(uint16_t /* type */, void *data,
     }
   }
 
-  if (!EventLoopManagerSingleton::get()->getEventLoop()
+  if (!timerPool->mEventLoop
         .deliverEventSync(
             currentTimerRequest.instanceId,
             CHRE_EVENT_TIMER,
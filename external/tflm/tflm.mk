@@ -3,6 +3,11 @@
 #
 # This file is automatically included by default.
 # Please add USE_TFLM=true and TFLM=path_to_tflm to enable TFLM.
+#
+# Optimized kernels are selected by setting TFLM_OPTIMIZED_KERNEL_DIR to the
+# name of one of the kernel directories of TFLM, e.g. cmsis_nn for the CMSIS-NN
+# kernels of Arm cores, or portable_optimized for the portable C ones. The
+# reference kernels are used otherwise.
 
 ifeq ($(USE_TFLM),true)
 
@@ -16,14 +21,43 @@ endif
 
 # TFLM Source Files ############################################################
 
-TFLM_SRCS = $(shell find $(TFLM_PATH) \( -name '*.cc' -o -name '*.c' \))
+TFLM_SRCS := $(shell find $(TFLM_PATH) \( -name '*.cc' -o -name '*.c' \))
 
 ifeq ($(TFLM_SRCS),)
 $(error "Your $$TFLM_PATH is empty. Please download the latest TFLM using \
          external/tflm/tflm_sync_srcs.sh")
 endif
 
-COMMON_SRCS += TFLM_SRCS
+# Kernel Selection #############################################################
+
+TFLM_KERNELS_PATH = $(TFLM_PATH)/tensorflow/lite/micro/kernels
+TFLM_OPTIMIZED_KERNEL_DIRS = cmsis_nn portable_optimized
+
+# Drop the kernel directories that are not selected.
+TFLM_SRCS := $(filter-out \
+    $(addsuffix /%, $(addprefix $(TFLM_KERNELS_PATH)/, \
+        $(filter-out $(TFLM_OPTIMIZED_KERNEL_DIR), \
+            $(TFLM_OPTIMIZED_KERNEL_DIRS)))), \
+    $(TFLM_SRCS))
+
+ifneq ($(TFLM_OPTIMIZED_KERNEL_DIR),)
+# The optimized kernels replace the reference kernels of the same name.
+TFLM_OPTIMIZED_KERNEL_SRCS = $(filter \
+    $(TFLM_KERNELS_PATH)/$(TFLM_OPTIMIZED_KERNEL_DIR)/%, $(TFLM_SRCS))
+TFLM_SRCS := $(filter-out \
+    $(addprefix $(TFLM_KERNELS_PATH)/, $(notdir $(TFLM_OPTIMIZED_KERNEL_SRCS))), \
+    $(TFLM_SRCS))
+
+COMMON_CFLAGS += -DTFLM_OPTIMIZED_KERNEL_DIR=$(TFLM_OPTIMIZED_KERNEL_DIR)
+endif
+
+ifeq ($(TFLM_OPTIMIZED_KERNEL_DIR),cmsis_nn)
+COMMON_CFLAGS += -DCMSIS_NN
+COMMON_CFLAGS += -I$(TFLM_PATH)/third_party/cmsis_nn
+COMMON_CFLAGS += -I$(TFLM_PATH)/third_party/cmsis_nn/Include
+endif
+
+COMMON_SRCS += $(TFLM_SRCS)
 
 # TFLM Required flags ##########################################################
 
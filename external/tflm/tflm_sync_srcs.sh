@@ -1,5 +1,9 @@
 #!/bin/bash
 # This script syncs latest TFLM code to the `latest` folder.
+#
+# Set OPTIMIZED_KERNEL_DIR (e.g. cmsis_nn) to sync optimized kernels in place of
+# the reference ones they replace, and build with the same
+# TFLM_OPTIMIZED_KERNEL_DIR.
 
 DEST_PATH=`dirname "${BASH_SOURCE[0]}"`/latest
 
@@ -26,7 +30,9 @@ git clone https://github.com/tensorflow/tensorflow.git --depth=1 tflm
 
 # Generate chre related files
 cd tflm
-make -f tensorflow/lite/micro/tools/make/Makefile TARGET=chre generate_hello_world_make_project
+make -f tensorflow/lite/micro/tools/make/Makefile TARGET=chre \
+  ${OPTIMIZED_KERNEL_DIR:+OPTIMIZED_KERNEL_DIR=$OPTIMIZED_KERNEL_DIR} \
+  generate_hello_world_make_project
 rm -rf gen/chre_x86_64/prj/hello_world/make/tensorflow/lite/micro/examples
 
 # Remove the destination folder
@@ -16,40 +16,22 @@
 
 #include "chre_host/fragmented_load_transaction.h"
 
-#include <algorithm>
-
 namespace android {
 namespace chre {
 
-namespace {
-
-/**
- * Returns a vector containing a specific subarray of the original vector.
- *
- * If the ending index of the subarray exceeds that of the source vector,
- * the size will be truncated to the last element of the source vector.
- *
- * @param source the source vector
- * @param start the starting index of the subarray
- * @param size the size of the subarray
- *
- * @return the vector containing the subarray
- */
-inline std::vector<uint8_t> getSubVector(const std::vector<uint8_t> &source,
-                                         size_t start, size_t size) {
-  size_t end = std::min(source.size(), start + size);
-  return (source.size() == 0)
-             ? std::vector<uint8_t>()
-             : std::vector<uint8_t>(source.begin() + start,
-                                    source.begin() + end);  // [start, end)
-}
-
-}  // anonymous namespace
+FragmentedLoadTransaction::FragmentedLoadTransaction(
+    uint32_t transactionId, uint64_t appId, uint32_t appVersion,
+    uint32_t appFlags, uint32_t targetApiVersion,
+    const std::vector<uint8_t> &appBinary, size_t fragmentSize)
+    : FragmentedLoadTransaction(transactionId, appId, appVersion, appFlags,
+                                targetApiVersion,
+                                SharedBinary::copyOf(appBinary),
+                                fragmentSize) {}
 
 FragmentedLoadTransaction::FragmentedLoadTransaction(
     uint32_t transactionId, uint64_t appId, uint32_t appVersion,
     uint32_t appFlags, uint32_t targetApiVersion,
-    const std::vector<uint8_t> &appBinary, size_t fragmentSize) {
+    const SharedBinary &appBinary, size_t fragmentSize) {
   // Start with fragmentId at 1 since 0 is used to indicate
   // legacy behavior at CHRE
   size_t fragmentId = 1;
@@ -62,11 +44,11 @@ FragmentedLoadTransaction::FragmentedLoadTransaction(
       mFragmentRequests.emplace_back(
           fragmentId++, transactionId, appId, appVersion, appFlags,
           targetApiVersion, appBinary.size(),
-          getSubVector(appBinary, byteIndex, fragmentSize));
+          appBinary.subspan(byteIndex, fragmentSize));
     } else {
       mFragmentRequests.emplace_back(
           fragmentId++, transactionId, appId,
-          getSubVector(appBinary, byteIndex, fragmentSize));
+          appBinary.subspan(byteIndex, fragmentSize));
     }
 
     byteIndex += fragmentSize;
@@ -116,7 +116,7 @@ void HostProtocolHost::encodeFragmentedLoadNanoappRequest(
     const FragmentedLoadRequest &request, bool respondBeforeStart) {
   encodeLoadNanoappRequestForBinary(
       builder, request.transactionId, request.appId, request.appVersion,
-      request.appFlags, request.targetApiVersion, request.binary,
+      request.appFlags, request.targetApiVersion, request.binary.span(),
       request.fragmentId, request.appTotalSizeBytes, respondBeforeStart);
 }
 
@@ -184,9 +184,10 @@ bool HostProtocolHost::mutateHostClientId(void *message, size_t messageLen,
 void HostProtocolHost::encodeLoadNanoappRequestForBinary(
     FlatBufferBuilder &builder, uint32_t transactionId, uint64_t appId,
     uint32_t appVersion, uint32_t appFlags, uint32_t targetApiVersion,
-    const std::vector<uint8_t> &nanoappBinary, uint32_t fragmentId,
+    std::span<const uint8_t> nanoappBinary, uint32_t fragmentId,
     size_t appTotalSizeBytes, bool respondBeforeStart) {
-  auto appBinary = builder.CreateVector(nanoappBinary);
+  auto appBinary =
+      builder.CreateVector(nanoappBinary.data(), nanoappBinary.size());
   auto request = fbs::CreateLoadNanoappRequest(
       builder, transactionId, appId, appVersion, targetApiVersion, appBinary,
       fragmentId, appTotalSizeBytes, 0 /* app_binary_file_name */, appFlags,
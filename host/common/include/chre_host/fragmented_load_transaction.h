@@ -18,8 +18,11 @@
 #define CHRE_HOST_FRAGMENTED_LOAD_TRANSACTION_H_
 
 #include <cinttypes>
+#include <utility>
 #include <vector>
 
+#include "chre_host/shared_binary.h"
+
 #ifndef CHRE_HOST_DEFAULT_FRAGMENT_SIZE
 // Use 30KB fragment size to fit within 32KB memory fragments at the kernel
 // for most devices.
@@ -38,6 +41,9 @@ static constexpr uint32_t kNoFragmentId = 0;
  * this class along with FragmentedLoadTransaction to get global attributes for
  * the transaction and encode the load request using
  * HostProtocolHost::encodeFragmentedLoadNanoappRequest.
+ *
+ * The binary of a fragment is a view into the binary of the whole nanoapp, so
+ * copying a request doesn't copy the fragment data.
  */
 struct FragmentedLoadRequest {
   size_t fragmentId;
@@ -47,17 +53,30 @@ struct FragmentedLoadRequest {
   uint32_t appFlags;
   uint32_t targetApiVersion;
   size_t appTotalSizeBytes;
-  std::vector<uint8_t> binary;
+  SharedBinary binary;
 
   FragmentedLoadRequest(size_t fragmentId, uint32_t transactionId,
                         uint64_t appId, const std::vector<uint8_t> &binary)
+      : FragmentedLoadRequest(fragmentId, transactionId, appId,
+                              SharedBinary::copyOf(binary)) {}
+
+  FragmentedLoadRequest(size_t fragmentId, uint32_t transactionId,
+                        uint64_t appId, SharedBinary binary)
       : FragmentedLoadRequest(fragmentId, transactionId, appId, 0, 0, 0, 0,
-                              binary) {}
+                              std::move(binary)) {}
 
   FragmentedLoadRequest(size_t fragmentId, uint32_t transactionId,
                         uint64_t appId, uint32_t appVersion, uint32_t appFlags,
                         uint32_t targetApiVersion, size_t appTotalSizeBytes,
                         const std::vector<uint8_t> &binary)
+      : FragmentedLoadRequest(fragmentId, transactionId, appId, appVersion,
+                              appFlags, targetApiVersion, appTotalSizeBytes,
+                              SharedBinary::copyOf(binary)) {}
+
+  FragmentedLoadRequest(size_t fragmentId, uint32_t transactionId,
+                        uint64_t appId, uint32_t appVersion, uint32_t appFlags,
+                        uint32_t targetApiVersion, size_t appTotalSizeBytes,
+                        SharedBinary binary)
       : fragmentId(fragmentId),
         transactionId(transactionId),
         appId(appId),
@@ -65,7 +84,7 @@ struct FragmentedLoadRequest {
         appFlags(appFlags),
         targetApiVersion(targetApiVersion),
         appTotalSizeBytes(appTotalSizeBytes),
-        binary(binary) {}
+        binary(std::move(binary)) {}
 };
 
 /**
@@ -93,6 +112,16 @@ class FragmentedLoadTransaction {
                             const std::vector<uint8_t> &appBinary,
                             size_t fragmentSize = kDefaultFragmentSize);
 
+  /**
+   * Same as above, but the fragments share the given binary instead of
+   * holding a copy of it.
+   */
+  FragmentedLoadTransaction(uint32_t transactionId, uint64_t appId,
+                            uint32_t appVersion, uint32_t appFlags,
+                            uint32_t targetApiVersion,
+                            const SharedBinary &appBinary,
+                            size_t fragmentSize = kDefaultFragmentSize);
+
   /**
    * Retrieves the FragmentedLoadRequest including the next fragment of the
    * binary. Invoking getNextRequest() will prepare the next fragment for a
@@ -25,6 +25,7 @@
 #include "chre_host/generated/host_messages_generated.h"
 #include "flatbuffers/flatbuffers.h"
 
+#include <span>
 #include <vector>
 
 namespace android {
@@ -218,7 +219,7 @@ class HostProtocolHost : public ::chre::HostProtocolCommon {
   static void encodeLoadNanoappRequestForBinary(
       flatbuffers::FlatBufferBuilder &builder, uint32_t transactionId,
       uint64_t appId, uint32_t appVersion, uint32_t appFlags,
-      uint32_t targetApiVersion, const std::vector<uint8_t> &nanoappBinary,
+      uint32_t targetApiVersion, std::span<const uint8_t> nanoappBinary,
       uint32_t fragmentId, size_t appTotalSizeBytes, bool respondBeforeStart);
 
   /**
@@ -102,9 +102,8 @@ class LogMessageParser : public INanoappLoadListener {
   void resetNanoappDetokenizerState();
 
   // Functions from INanoappLoadListener.
-  void onNanoappLoadStarted(
-      uint64_t appId,
-      std::shared_ptr<const std::vector<uint8_t>> nanoappBinary) override;
+  void onNanoappLoadStarted(uint64_t appId,
+                            SharedBinary nanoappBinary) override;
 
   void onNanoappLoadFailed(uint64_t appId) override;
 
@@ -181,9 +180,7 @@ class LogMessageParser : public INanoappLoadListener {
       mNanoappDetokenizers;
 
   //! This is used to find the binary associated with a nanoapp with its app ID.
-  std::unordered_map<uint64_t /*appId*/,
-                     std::shared_ptr<const std::vector<uint8_t>>>
-      mNanoappAppIdToBinary;
+  std::unordered_map<uint64_t /*appId*/, SharedBinary> mNanoappAppIdToBinary;
 
   static android_LogPriority chreLogLevelToAndroidLogPriority(uint8_t level);
 
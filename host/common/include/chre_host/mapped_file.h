@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_HOST_MAPPED_FILE_H_
+#define CHRE_HOST_MAPPED_FILE_H_
+
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+
+#include "chre_host/shared_binary.h"
+
+namespace android {
+namespace chre {
+
+/**
+ * A file mapped read-only into memory.
+ *
+ * Unlike reading a file into a buffer, the contents are served from the page
+ * cache, so they don't count twice towards the memory used by the process and
+ * can be reclaimed by the kernel under memory pressure.
+ */
+class MappedFile {
+ public:
+  /**
+   * Maps a file into memory.
+   *
+   * @param filename The name of the file.
+   * @return The mapped file, or nullptr if the file couldn't be opened or
+   *     mapped.
+   */
+  static std::shared_ptr<const MappedFile> open(const char *filename);
+
+  /**
+   * Maps a file into memory and returns a view of its whole contents.
+   *
+   * @param filename The name of the file.
+   * @param binary Set to the contents of the file.
+   * @return true if successfully mapped.
+   */
+  static bool openAsBinary(const char *filename, SharedBinary &binary);
+
+  ~MappedFile();
+
+  /** Disable copy constructor and copy assignment. */
+  MappedFile(const MappedFile &) = delete;
+  void operator=(const MappedFile &) = delete;
+
+  [[nodiscard]] const uint8_t *data() const {
+    return static_cast<const uint8_t *>(mAddress);
+  }
+
+  [[nodiscard]] size_t size() const {
+    return mSize;
+  }
+
+ private:
+  MappedFile(void *address, size_t size) : mAddress(address), mSize(size) {}
+
+  //! The start of the mapping, nullptr for an empty file.
+  void *mAddress;
+  size_t mSize;
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_MAPPED_FILE_H_
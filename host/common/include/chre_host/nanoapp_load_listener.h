@@ -17,6 +17,10 @@
 #ifndef CHRE_NANOAPP_LOAD_LISTENER_H_
 #define CHRE_NANOAPP_LOAD_LISTENER_H_
 
+#include <cinttypes>
+
+#include "chre_host/shared_binary.h"
+
 namespace android {
 namespace chre {
 
@@ -28,10 +32,11 @@ class INanoappLoadListener {
    * Called before we send any nanoapp data to CHRE.
    *
    * @param appId The app ID associated with the nanoapp binary.
+   * @param nanoappBinary The nanoapp binary, which stays valid as long as the
+   *        listener holds a copy of it.
    */
-  virtual void onNanoappLoadStarted(
-      uint64_t appId,
-      std::shared_ptr<const std::vector<uint8_t>> nanoappBinary) = 0;
+  virtual void onNanoappLoadStarted(uint64_t appId,
+                                    SharedBinary nanoappBinary) = 0;
 
   /**
    * Called after a nanoapp load failed.
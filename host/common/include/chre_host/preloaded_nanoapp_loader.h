@@ -19,7 +19,10 @@
 
 #include <android/binder_to_string.h>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -32,6 +35,7 @@
 #include "chre_host/metrics_reporter.h"
 #include "chre_host/nanoapp_load_listener.h"
 #include "chre_host/napp_header.h"
+#include "chre_host/shared_binary.h"
 #include "event_logger.h"
 #include "fragmented_load_transaction.h"
 #include "hal_client_id.h"
@@ -48,6 +52,13 @@ using ::aidl::android::hardware::contexthub::EventLogger;
  * image and are loaded when CHRE starts. These are known as preloaded nanoapps.
  * A HAL implementation should use this class to load preloaded nanoapps before
  * exposing API to HAL clients.
+ *
+ * Loading is pipelined: the header and binary of the next nanoapp are read and
+ * validated on a separate thread while the current one is being sent to CHRE.
+ * Binaries are memory-mapped rather than copied, and fragments are views into
+ * the mapping, so a nanoapp only takes up its pages in the page cache.
+ * The fragment size adapts to the latency of CHRE's responses, and a report of
+ * the time spent on each nanoapp is logged once all of them are processed.
  */
 class PreloadedNanoappLoader {
  public:
@@ -101,25 +112,75 @@ class PreloadedNanoappLoader {
     size_t fragmentId;
   };
 
+  /** A preloaded nanoapp read from the file system, ready to be sent. */
+  struct PreparedNanoapp {
+    std::string nanoappFileName;
+    /** Unset if the header file is missing or invalid. */
+    std::optional<NanoAppBinaryHeader> header;
+    /** True if the nanoapp is in the list of nanoapps to skip. */
+    bool isSkipped = false;
+    /** Unset if the binary couldn't be mapped. */
+    std::optional<SharedBinary> binary;
+    std::chrono::milliseconds readDuration{0};
+  };
+
+  /** The time spent on a preloaded nanoapp, for the boot-time report. */
+  struct LoadRecord {
+    uint64_t appId;
+    size_t appSize;
+    size_t numFragments;
+    std::chrono::milliseconds readDuration;
+    std::chrono::milliseconds loadDuration;
+    bool success;
+  };
+
+  /** The smallest fragment size the loader adapts down to. */
+  static constexpr size_t kMinFragmentSize = 4 * 1024;
+
+  /**
+   * The fragment size is halved when a fragment takes longer than this to be
+   * acknowledged, and doubled (up to CHRE_HOST_DEFAULT_FRAGMENT_SIZE) when it
+   * takes less than a quarter of it.
+   */
+  static constexpr auto kTargetFragmentLatency = std::chrono::milliseconds(250);
+
+  /**
+   * Reads and validates the header and binary of a preloaded nanoapp. Called
+   * on the prefetch thread, so it must not touch the loader's state.
+   */
+  static PreparedNanoapp prepareNanoapp(
+      const std::string &directory, const std::string &nanoappName,
+      const std::optional<const std::vector<uint64_t>> &skippedNanoappIds);
+
   /**
    * Loads a preloaded nanoapp.
    *
-   * @param appHeader The nanoapp header binary blob.
-   * @param nanoappFileName The nanoapp binary file name.
+   * @param appHeader The nanoapp header.
+   * @param nanoappBuffer The nanoapp binary.
    * @param transactionId The transaction ID identifying this load transaction.
+   * @param record The record to fill in with the number of fragments sent.
    * @return true if successful, false otherwise.
    */
-  bool loadNanoapp(const NanoAppBinaryHeader *appHeader,
-                   const std::string &nanoappFileName, uint32_t transactionId);
+  bool loadNanoapp(const NanoAppBinaryHeader &appHeader,
+                   const SharedBinary &nanoappBuffer, uint32_t transactionId,
+                   LoadRecord &record);
 
   /**
    * Chunks the nanoapp binary into fragments and load each fragment
-   * sequentially.
+   * sequentially, adapting the size of each fragment to the response latency
+   * of the previous ones.
    */
   bool sendFragmentedLoadAndWaitForEachResponse(
       uint64_t appId, uint32_t appVersion, uint32_t appFlags,
-      uint32_t appTargetApiVersion, const uint8_t *appBinary, size_t appSize,
-      uint32_t transactionId);
+      uint32_t appTargetApiVersion, const SharedBinary &appBinary,
+      uint32_t transactionId, size_t &numFragments);
+
+  /** Updates mFragmentSize from the response latency of a fragment. */
+  void adaptFragmentSize(std::chrono::steady_clock::duration latency);
+
+  /** Logs the time spent on each preloaded nanoapp. */
+  static void logLoadReport(const std::vector<LoadRecord> &records,
+                            std::chrono::milliseconds totalDuration);
 
   /** Sends the FragmentedLoadRequest to CHRE. */
   std::future<bool> sendFragmentedLoadRequest(
@@ -143,6 +204,9 @@ class PreloadedNanoappLoader {
 
   std::atomic_bool mIsPreloadingOngoing = false;
 
+  /** The size of the next fragment to send. Kept across nanoapps. */
+  size_t mFragmentSize = CHRE_HOST_DEFAULT_FRAGMENT_SIZE;
+
   ChreConnection *mConnection;
   EventLogger &mEventLogger;
   MetricsReporter *mMetricsReporter;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_HOST_SHARED_BINARY_H_
+#define CHRE_HOST_SHARED_BINARY_H_
+
+#include <algorithm>
+#include <cinttypes>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace android {
+namespace chre {
+
+/**
+ * A read-only view of a binary blob that shares the ownership of the memory it
+ * points to.
+ *
+ * Copies and sub-views are cheap and keep the underlying storage, e.g. a
+ * vector or a memory-mapped file, alive. This allows a nanoapp binary to be
+ * split into fragments and handed to several consumers without copying it.
+ */
+class SharedBinary {
+ public:
+  SharedBinary() = default;
+
+  /** Creates a view over a whole vector, sharing its ownership. */
+  explicit SharedBinary(std::shared_ptr<const std::vector<uint8_t>> vector)
+      : mSpan(vector != nullptr ? std::span<const uint8_t>(*vector)
+                                : std::span<const uint8_t>()),
+        mOwner(std::move(vector)) {}
+
+  /**
+   * Creates a view over memory owned by another object.
+   *
+   * @param owner The object keeping the memory alive.
+   * @param span The memory, which must stay valid as long as owner is alive.
+   */
+  SharedBinary(std::shared_ptr<const void> owner, std::span<const uint8_t> span)
+      : mSpan(span), mOwner(std::move(owner)) {}
+
+  /** Creates a view holding its own copy of a vector. */
+  static SharedBinary copyOf(const std::vector<uint8_t> &vector) {
+    return SharedBinary(std::make_shared<const std::vector<uint8_t>>(vector));
+  }
+
+  /**
+   * Returns a view over a part of this binary sharing the same owner. The
+   * range is truncated to the end of the binary.
+   */
+  [[nodiscard]] SharedBinary subspan(size_t offset, size_t size) const {
+    offset = std::min(offset, mSpan.size());
+    size = std::min(size, mSpan.size() - offset);
+    return SharedBinary(mOwner, mSpan.subspan(offset, size));
+  }
+
+  /** Releases the reference to the underlying storage. */
+  void reset() {
+    mSpan = {};
+    mOwner.reset();
+  }
+
+  [[nodiscard]] const uint8_t *data() const {
+    return mSpan.data();
+  }
+
+  [[nodiscard]] size_t size() const {
+    return mSpan.size();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return mSpan.empty();
+  }
+
+  [[nodiscard]] std::span<const uint8_t> span() const {
+    return mSpan;
+  }
+
+ private:
+  std::span<const uint8_t> mSpan;
+  std::shared_ptr<const void> mOwner;
+};
+
+}  // namespace chre
+}  // namespace android
+
+#endif  // CHRE_HOST_SHARED_BINARY_H_
@@ -19,6 +19,7 @@
 #include <endian.h>
 #include <string.h>
 #include <optional>
+#include <utility>
 
 #include "chre/util/macros.h"
 #include "chre/util/time.h"
@@ -317,15 +318,15 @@ void LogMessageParser::addNanoappDetokenizer(uint64_t appId,
     // Remove and free the nanoapp binary.
     mNanoappAppIdToBinary.erase(appId);
   } else if (checkTokenDatabaseOverflow(databaseOffset, databaseSize,
-                                        appBinaryIter->second->size())) {
+                                        appBinaryIter->second.size())) {
     LOGE(
         "Token database fails memory bounds check for nanoapp with app ID "
         "0x%016" PRIx64 ". Token database offset received: %" PRIu32
         "; size received: %zu; Size of the appBinary: %zu.",
-        appId, databaseOffset, databaseSize, appBinaryIter->second->size());
+        appId, databaseOffset, databaseSize, appBinaryIter->second.size());
   } else {
     const uint8_t *tokenDatabaseBinaryStart =
-        appBinaryIter->second->data() + kImageHeaderSize + databaseOffset;
+        appBinaryIter->second.data() + kImageHeaderSize + databaseOffset;
 
     pw::span<const uint8_t> tokenEntries(tokenDatabaseBinaryStart,
                                          databaseSize);
@@ -363,9 +364,9 @@ void LogMessageParser::resetNanoappDetokenizerState() {
   mNanoappAppIdToBinary.clear();
 }
 
-void LogMessageParser::onNanoappLoadStarted(
-    uint64_t appId, std::shared_ptr<const std::vector<uint8_t>> nanoappBinary) {
-  mNanoappAppIdToBinary[appId] = nanoappBinary;
+void LogMessageParser::onNanoappLoadStarted(uint64_t appId,
+                                            SharedBinary nanoappBinary) {
+  mNanoappAppIdToBinary[appId] = std::move(nanoappBinary);
 }
 
 void LogMessageParser::onNanoappLoadFailed(uint64_t appId) {
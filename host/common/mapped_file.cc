@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre_host/mapped_file.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+
+#include "chre_host/log.h"
+
+namespace android {
+namespace chre {
+
+std::shared_ptr<const MappedFile> MappedFile::open(const char *filename) {
+  int fd = ::open(filename, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    LOGE("Couldn't open file '%s': %d (%s)", filename, errno, strerror(errno));
+    return nullptr;
+  }
+
+  std::shared_ptr<const MappedFile> file;
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    LOGE("Couldn't stat file '%s': %d (%s)", filename, errno, strerror(errno));
+  } else if (fileStat.st_size == 0) {
+    // mmap() doesn't accept empty mappings.
+    file.reset(new MappedFile(/* address= */ nullptr, /* size= */ 0));
+  } else {
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    void *address = mmap(/* addr= */ nullptr, size, PROT_READ, MAP_PRIVATE, fd,
+                         /* offset= */ 0);
+    if (address == MAP_FAILED) {
+      LOGE("Couldn't map file '%s': %d (%s)", filename, errno,
+           strerror(errno));
+    } else {
+      // The file is read once from start to end, so start reading it ahead
+      // of the first access.
+      madvise(address, size, MADV_SEQUENTIAL);
+      madvise(address, size, MADV_WILLNEED);
+      file.reset(new MappedFile(address, size));
+    }
+  }
+
+  // The mapping stays valid after the file descriptor is closed.
+  close(fd);
+  return file;
+}
+
+bool MappedFile::openAsBinary(const char *filename, SharedBinary &binary) {
+  std::shared_ptr<const MappedFile> file = open(filename);
+  if (file == nullptr) {
+    return false;
+  }
+  std::span<const uint8_t> span(file->data(), file->size());
+  binary = SharedBinary(std::move(file), span);
+  return true;
+}
+
+MappedFile::~MappedFile() {
+  if (mAddress != nullptr) {
+    munmap(mAddress, mSize);
+  }
+}
+
+}  // namespace chre
+}  // namespace android
@@ -16,11 +16,14 @@
 
 #include "chre_host/preloaded_nanoapp_loader.h"
 #include <chre_host/host_protocol_host.h>
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include "chre_host/config_util.h"
 #include "chre_host/file_stream.h"
 #include "chre_host/fragmented_load_transaction.h"
 #include "chre_host/log.h"
+#include "chre_host/mapped_file.h"
 #include "chre_host/nanoapp_load_listener.h"
 #include "hal_client_id.h"
 
@@ -31,6 +34,10 @@ namespace {
 /** Timeout value of waiting for the response of a loading fragment. */
 constexpr auto kTimeoutInMs = std::chrono::milliseconds(2000);
 
+/** The expected magic number and version of a napp_header file. */
+constexpr uint32_t kNanoappHeaderMagic = 0x4f4e414e;  // "NANO"
+constexpr uint32_t kNanoappHeaderVersion = 1;
+
 using ::android::chre::readFileContents;
 using ::android::chre::Atoms::ChreHalNanoappLoadFailed;
 using ::android::hardware::contexthub::common::implementation::kHalId;
@@ -45,9 +52,24 @@ bool getNanoappHeaderFromFile(const char *headerFileName,
     LOGE("Nanoapp binary's header size is incorrect");
     return false;
   }
+  auto header =
+      reinterpret_cast<const NanoAppBinaryHeader *>(headerBuffer.data());
+  if (header->magic != kNanoappHeaderMagic ||
+      header->headerVersion != kNanoappHeaderVersion) {
+    LOGE("Nanoapp header %s has an invalid magic 0x%" PRIx32
+         " or version %" PRIu32,
+         headerFileName, header->magic, header->headerVersion);
+    return false;
+  }
   return true;
 }
 
+std::chrono::milliseconds millisecondsSince(
+    std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - start);
+}
+
 inline bool shouldSkipNanoapp(
     std::optional<const std::vector<uint64_t>> nanoappIds, uint64_t theAppId) {
   return nanoappIds.has_value() &&
@@ -92,81 +114,183 @@ int PreloadedNanoappLoader::loadPreloadedNanoapps(
     return numOfNanoappsLoaded;
   }
 
+  auto preloadStart = std::chrono::steady_clock::now();
+  std::vector<LoadRecord> records;
+  auto prefetch = [&](uint32_t index) {
+    return std::async(std::launch::async, prepareNanoapp, directory,
+                      nanoapps[index], skippedNanoappIds);
+  };
+
+  // Reads the next nanoapp while the current one is being loaded.
+  std::future<PreparedNanoapp> nextNanoapp;
+  if (!nanoapps.empty()) {
+    nextNanoapp = prefetch(0);
+  }
   for (uint32_t i = 0; i < nanoapps.size(); ++i) {
-    std::string headerFilename = directory + "/" + nanoapps[i] + ".napp_header";
-    std::string nanoappFilename = directory + "/" + nanoapps[i] + ".so";
-    // parse the header
-    std::vector<uint8_t> headerBuffer;
-    if (!getNanoappHeaderFromFile(headerFilename.c_str(), headerBuffer)) {
+    PreparedNanoapp nanoapp = nextNanoapp.get();
+    if (i + 1 < nanoapps.size()) {
+      nextNanoapp = prefetch(i + 1);
+    }
+
+    if (!nanoapp.header.has_value()) {
       LOGE("Failed to parse the nanoapp header for %s",
-           nanoappFilename.c_str());
+           nanoapp.nanoappFileName.c_str());
       continue;
     }
-    const auto header =
-        reinterpret_cast<const NanoAppBinaryHeader *>(headerBuffer.data());
+    const NanoAppBinaryHeader &header = *nanoapp.header;
     // check if the app should be skipped
-    if (shouldSkipNanoapp(skippedNanoappIds, header->appId)) {
-      LOGI("Loading of %s is skipped.", nanoappFilename.c_str());
+    if (nanoapp.isSkipped) {
+      LOGI("Loading of %s is skipped.", nanoapp.nanoappFileName.c_str());
       continue;
     }
+
+    LoadRecord record{
+        .appId = header.appId,
+        .appSize = nanoapp.binary.has_value() ? nanoapp.binary->size() : 0,
+        .numFragments = 0,
+        .readDuration = nanoapp.readDuration,
+        .loadDuration = std::chrono::milliseconds(0),
+        .success = false,
+    };
+    auto loadStart = std::chrono::steady_clock::now();
     // load the binary
-    if (loadNanoapp(header, nanoappFilename, /* transactionId= */ i)) {
+    if (!nanoapp.binary.has_value()) {
+      LOGE("Unable to read %s.", nanoapp.nanoappFileName.c_str());
+    } else {
+      record.success = loadNanoapp(header, *nanoapp.binary,
+                                   /* transactionId= */ i, record);
+    }
+    record.loadDuration = millisecondsSince(loadStart);
+    records.push_back(record);
+
+    if (record.success) {
       numOfNanoappsLoaded++;
     } else {
       LOGE("Failed to load nanoapp 0x%" PRIx64 " in preloaded nanoapp loader",
-           header->appId);
+           header.appId);
       if (mNanoappLoadListener != nullptr) {
-        mNanoappLoadListener->onNanoappLoadFailed(header->appId);
+        mNanoappLoadListener->onNanoappLoadFailed(header.appId);
       }
     }
   }
+  logLoadReport(records, millisecondsSince(preloadStart));
   mIsPreloadingOngoing.store(false);
   return numOfNanoappsLoaded;
 }
 
-bool PreloadedNanoappLoader::loadNanoapp(const NanoAppBinaryHeader *appHeader,
-                                         const std::string &nanoappFileName,
-                                         uint32_t transactionId) {
-  // parse the binary
-  auto nanoappBuffer = std::make_shared<std::vector<uint8_t>>();
-  if (!readFileContents(nanoappFileName.c_str(), *nanoappBuffer)) {
-    LOGE("Unable to read %s.", nanoappFileName.c_str());
-    return false;
+PreloadedNanoappLoader::PreparedNanoapp PreloadedNanoappLoader::prepareNanoapp(
+    const std::string &directory, const std::string &nanoappName,
+    const std::optional<const std::vector<uint64_t>> &skippedNanoappIds) {
+  auto readStart = std::chrono::steady_clock::now();
+  std::string headerFilename = directory + "/" + nanoappName + ".napp_header";
+  PreparedNanoapp nanoapp;
+  nanoapp.nanoappFileName = directory + "/" + nanoappName + ".so";
+
+  // parse the header
+  std::vector<uint8_t> headerBuffer;
+  if (!getNanoappHeaderFromFile(headerFilename.c_str(), headerBuffer)) {
+    return nanoapp;
+  }
+  NanoAppBinaryHeader header;
+  std::memcpy(&header, headerBuffer.data(), sizeof(header));
+  nanoapp.header = header;
+  if (shouldSkipNanoapp(skippedNanoappIds, header.appId)) {
+    nanoapp.isSkipped = true;
+    return nanoapp;
+  }
+
+  // map the binary
+  SharedBinary binary;
+  if (MappedFile::openAsBinary(nanoapp.nanoappFileName.c_str(), binary)) {
+    nanoapp.binary = std::move(binary);
   }
+  nanoapp.readDuration = millisecondsSince(readStart);
+  return nanoapp;
+}
+
+bool PreloadedNanoappLoader::loadNanoapp(
+    const NanoAppBinaryHeader &appHeader,
+    const SharedBinary &nanoappBuffer, uint32_t transactionId,
+    LoadRecord &record) {
   if (mNanoappLoadListener != nullptr) {
-    mNanoappLoadListener->onNanoappLoadStarted(appHeader->appId, nanoappBuffer);
+    mNanoappLoadListener->onNanoappLoadStarted(appHeader.appId, nanoappBuffer);
   }
   // Build the target API version from major and minor.
-  uint32_t targetApiVersion = (appHeader->targetChreApiMajorVersion << 24) |
-                              (appHeader->targetChreApiMinorVersion << 16);
+  uint32_t targetApiVersion = (appHeader.targetChreApiMajorVersion << 24) |
+                              (appHeader.targetChreApiMinorVersion << 16);
   bool success = sendFragmentedLoadAndWaitForEachResponse(
-      appHeader->appId, appHeader->appVersion, appHeader->flags,
-      targetApiVersion, nanoappBuffer->data(), nanoappBuffer->size(),
-      transactionId);
-  mEventLogger.logNanoappLoad(appHeader->appId, nanoappBuffer->size(),
-                              appHeader->appVersion, success);
+      appHeader.appId, appHeader.appVersion, appHeader.flags, targetApiVersion,
+      nanoappBuffer, transactionId, record.numFragments);
+  mEventLogger.logNanoappLoad(appHeader.appId, nanoappBuffer.size(),
+                              appHeader.appVersion, success);
   return success;
 }
 
 bool PreloadedNanoappLoader::sendFragmentedLoadAndWaitForEachResponse(
     uint64_t appId, uint32_t appVersion, uint32_t appFlags,
-    uint32_t appTargetApiVersion, const uint8_t *appBinary, size_t appSize,
-    uint32_t transactionId) {
-  std::vector<uint8_t> binary(appSize);
-  std::copy(appBinary, appBinary + appSize, binary.begin());
+    uint32_t appTargetApiVersion, const SharedBinary &appBinary,
+    uint32_t transactionId, size_t &numFragments) {
+  // Start with fragmentId at 1 since 0 is used to indicate legacy behavior at
+  // CHRE. Fragments are built one at a time as their size depends on the
+  // latency of the previous ones.
+  size_t fragmentId = 1;
+  size_t byteIndex = 0;
+  do {
+    SharedBinary fragment = appBinary.subspan(byteIndex, mFragmentSize);
+    FragmentedLoadRequest request =
+        fragmentId == 1
+            ? FragmentedLoadRequest(fragmentId, transactionId, appId,
+                                    appVersion, appFlags, appTargetApiVersion,
+                                    appBinary.size(), fragment)
+            : FragmentedLoadRequest(fragmentId, transactionId, appId,
+                                    fragment);
 
-  FragmentedLoadTransaction transaction(transactionId, appId, appVersion,
-                                        appFlags, appTargetApiVersion, binary);
-  while (!transaction.isComplete()) {
-    auto nextRequest = transaction.getNextRequest();
-    auto future = sendFragmentedLoadRequest(nextRequest);
-    if (!waitAndVerifyFuture(future, nextRequest)) {
+    auto sendTime = std::chrono::steady_clock::now();
+    auto future = sendFragmentedLoadRequest(request);
+    if (!waitAndVerifyFuture(future, request)) {
       return false;
     }
-  }
+    adaptFragmentSize(std::chrono::steady_clock::now() - sendTime);
+
+    ++fragmentId;
+    ++numFragments;
+    byteIndex += fragment.size();
+  } while (byteIndex < appBinary.size());
   return true;
 }
 
+void PreloadedNanoappLoader::adaptFragmentSize(
+    std::chrono::steady_clock::duration latency) {
+  size_t fragmentSize = mFragmentSize;
+  if (latency > kTargetFragmentLatency) {
+    fragmentSize = std::max(kMinFragmentSize, mFragmentSize / 2);
+  } else if (latency < kTargetFragmentLatency / 4) {
+    fragmentSize = std::min(static_cast<size_t>(CHRE_HOST_DEFAULT_FRAGMENT_SIZE),
+                            mFragmentSize * 2);
+  }
+  if (fragmentSize != mFragmentSize) {
+    LOGD("Fragment size changed from %zu to %zu bytes after a %lld ms response",
+         mFragmentSize, fragmentSize,
+         std::chrono::duration_cast<std::chrono::milliseconds>(latency)
+             .count());
+    mFragmentSize = fragmentSize;
+  }
+}
+
+void PreloadedNanoappLoader::logLoadReport(
+    const std::vector<LoadRecord> &records,
+    std::chrono::milliseconds totalDuration) {
+  LOGI("Preloaded %zu nanoapp(s) in %lld ms", records.size(),
+       totalDuration.count());
+  for (const LoadRecord &record : records) {
+    LOGI("  0x%016" PRIx64 ": %s, %zu bytes in %zu fragment(s), read %lld ms, "
+         "load %lld ms",
+         record.appId, record.success ? "loaded" : "failed", record.appSize,
+         record.numFragments, record.readDuration.count(),
+         record.loadDuration.count());
+  }
+}
+
 bool PreloadedNanoappLoader::waitAndVerifyFuture(
     std::future<bool> &future, const FragmentedLoadRequest &request) {
   bool success = false;
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "client_message_dispatcher.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <sstream>
+
+#include "chre_host/log.h"
+
+namespace android::hardware::contexthub::common::implementation {
+
+ClientMessageDispatcher::~ClientMessageDispatcher() {
+  std::unordered_map<HalClientId, std::shared_ptr<ClientWorker>> workers;
+  {
+    const std::lock_guard<std::mutex> lock(mLock);
+    workers.swap(mWorkers);
+  }
+  // Workers are stopped outside of the lock.
+  for (auto &[clientId, worker] : workers) {
+    worker->stop();
+  }
+}
+
+void ClientMessageDispatcher::addClient(HalClientId clientId) {
+  const std::lock_guard<std::mutex> lock(mLock);
+  if (mWorkers.find(clientId) == mWorkers.end()) {
+    mWorkers.emplace(clientId, std::make_shared<ClientWorker>(clientId));
+  }
+}
+
+bool ClientMessageDispatcher::dispatch(HalClientId clientId, Delivery delivery,
+                                       FullPolicy policy) {
+  std::shared_ptr<ClientWorker> worker;
+  {
+    const std::lock_guard<std::mutex> lock(mLock);
+    auto iter = mWorkers.find(clientId);
+    if (iter == mWorkers.end()) {
+      LOGW("Client %" PRIu16 " is not connected, delivery skipped", clientId);
+      return false;
+    }
+    worker = iter->second;
+  }
+  return worker->push(std::move(delivery), policy);
+}
+
+void ClientMessageDispatcher::removeClient(HalClientId clientId) {
+  std::shared_ptr<ClientWorker> worker;
+  {
+    const std::lock_guard<std::mutex> lock(mLock);
+    auto iter = mWorkers.find(clientId);
+    if (iter == mWorkers.end()) {
+      return;
+    }
+    worker = std::move(iter->second);
+    mWorkers.erase(iter);
+  }
+  worker->stop();
+}
+
+std::string ClientMessageDispatcher::debugDump() {
+  std::ostringstream result;
+  result << "\nMessage delivery threads {clientId, pending, dropped}:\n";
+  const std::lock_guard<std::mutex> lock(mLock);
+  for (const auto &[clientId, worker] : mWorkers) {
+    result << "  {" << clientId << ", " << worker->getNumPending() << ", "
+           << worker->getNumDropped() << "}\n";
+  }
+  return result.str();
+}
+
+ClientMessageDispatcher::ClientWorker::ClientWorker(HalClientId clientId)
+    : mClientId(clientId), mThread([this]() { run(); }) {}
+
+ClientMessageDispatcher::ClientWorker::~ClientWorker() {
+  stop();
+}
+
+bool ClientMessageDispatcher::ClientWorker::push(Delivery &&delivery,
+                                                 FullPolicy policy) {
+  {
+    const std::lock_guard<std::mutex> lock(mPushLock);
+    if (mIsStopped.load(std::memory_order_acquire)) {
+      return false;
+    }
+    bool isQueued = mOverflow.empty() && mDeliveries.push(std::move(delivery));
+    if (!isQueued && policy == FullPolicy::kOverflow) {
+      mOverflow.push_back(std::move(delivery));
+      isQueued = true;
+    }
+    if (!isQueued) {
+      uint64_t numDropped =
+          mNumDropped.fetch_add(1, std::memory_order_relaxed) + 1;
+      // Only log at powers of two to avoid flooding the log.
+      if ((numDropped & (numDropped - 1)) == 0) {
+        LOGE("Client %" PRIu16 " is not keeping up, dropped %" PRIu64
+             " message(s)",
+             mClientId, numDropped);
+      }
+      return false;
+    }
+  }
+  signal();
+  return true;
+}
+
+void ClientMessageDispatcher::ClientWorker::stop() {
+  if (!mThread.joinable()) {
+    return;
+  }
+  mIsStopped.store(true, std::memory_order_release);
+  signal();
+  mThread.join();
+}
+
+bool ClientMessageDispatcher::ClientWorker::runOverflow() {
+  std::deque<Delivery> overflow;
+  {
+    const std::lock_guard<std::mutex> lock(mPushLock);
+    overflow.swap(mOverflow);
+  }
+  // The ring was drained before, so the overflowed deliveries are the oldest
+  // ones, and the deliveries pushed from now on go to the ring after them.
+  for (Delivery &delivery : overflow) {
+    if (mIsStopped.load(std::memory_order_acquire)) {
+      break;
+    }
+    delivery();
+  }
+  return !overflow.empty();
+}
+
+void ClientMessageDispatcher::ClientWorker::run() {
+  std::string threadName = "chre_hal_cb_" + std::to_string(mClientId);
+  pthread_setname_np(pthread_self(), threadName.c_str());
+
+  Delivery delivery;
+  while (true) {
+    // Read the signal before checking the ring so that a push happening after
+    // the check makes wait() return immediately.
+    uint32_t pushSignal = mSignal.load(std::memory_order_acquire);
+    while (!mIsStopped.load(std::memory_order_acquire) &&
+           mDeliveries.pop(delivery)) {
+      delivery();
+      delivery = nullptr;
+    }
+    if (mIsStopped.load(std::memory_order_acquire)) {
+      break;
+    }
+    if (!runOverflow()) {
+      mSignal.wait(pushSignal, std::memory_order_acquire);
+    }
+  }
+}
+
+}  // namespace android::hardware::contexthub::common::implementation
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_HARDWARE_CONTEXTHUB_COMMON_CLIENT_MESSAGE_DISPATCHER_H_
+#define ANDROID_HARDWARE_CONTEXTHUB_COMMON_CLIENT_MESSAGE_DISPATCHER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <android-base/thread_annotations.h>
+
+#include "hal_client_id.h"
+#include "spsc_ring_buffer.h"
+
+namespace android::hardware::contexthub::common::implementation {
+
+/**
+ * Delivers messages from CHRE to HAL clients on one thread per client.
+ *
+ * <p>The thread receiving messages from CHRE hands each delivery to the
+ * client's delivery thread through a lock-free single-producer single-consumer
+ * ring, so a client that is slow to handle its callbacks only delays its own
+ * messages. The receiving thread never waits for a client: when a client's
+ * ring is full, what happens to a new delivery depends on its FullPolicy.
+ * Messages are dropped, while deliveries the client can't recover from missing,
+ * like message delivery statuses or transaction results, are kept in an
+ * unbounded overflow list.
+ *
+ * <p>Deliveries to a given client happen in the order they are dispatched.
+ */
+class ClientMessageDispatcher {
+ public:
+  /** A delivery to a client, run on the client's delivery thread. */
+  using Delivery = std::function<void()>;
+
+  /** What to do with a delivery when the client's ring is full. */
+  enum class FullPolicy {
+    /** Drop the delivery. */
+    kDrop,
+    /** Keep the delivery in the client's overflow list. */
+    kOverflow,
+  };
+
+  /** The number of deliveries that can be pending in a client's ring. */
+  static constexpr size_t kMaxPendingDeliveries = 64;
+
+  ClientMessageDispatcher() = default;
+  ~ClientMessageDispatcher();
+
+  /** Disable copy constructor and copy assignment. */
+  ClientMessageDispatcher(const ClientMessageDispatcher &) = delete;
+  void operator=(const ClientMessageDispatcher &) = delete;
+
+  /**
+   * Starts the delivery thread of a client. Does nothing if it is already
+   * running.
+   *
+   * @param clientId The id of the client.
+   */
+  void addClient(HalClientId clientId);
+
+  /**
+   * Queues a delivery to a client added by addClient().
+   *
+   * <p>May be called from any thread. Never waits for the client.
+   *
+   * @param clientId The id of the client.
+   * @param delivery The delivery to run on the client's delivery thread.
+   * @param policy What to do if the client has too many pending deliveries.
+   * @return true if the delivery is queued, false if the client is unknown or
+   *     removed, or if the delivery is dropped because the client has too many
+   *     pending deliveries.
+   */
+  bool dispatch(HalClientId clientId, Delivery delivery,
+                FullPolicy policy = FullPolicy::kDrop);
+
+  /**
+   * Stops the delivery thread of a client, dropping its pending deliveries.
+   * Waits for a delivery in progress to return.
+   *
+   * <p>Deliveries to the client are rejected until it is added again.
+   *
+   * <p>Must not be called from a delivery thread.
+   */
+  void removeClient(HalClientId clientId);
+
+  /** Dumps the state of the delivery threads for debugging purpose. */
+  std::string debugDump();
+
+ private:
+  class ClientWorker {
+   public:
+    explicit ClientWorker(HalClientId clientId);
+    ~ClientWorker();
+
+    /** Queues a delivery. @see ClientMessageDispatcher::dispatch */
+    bool push(Delivery &&delivery, FullPolicy policy);
+
+    /** Stops the thread after the current delivery. */
+    void stop();
+
+    size_t getNumPending() {
+      const std::lock_guard<std::mutex> lock(mPushLock);
+      return mDeliveries.size() + mOverflow.size();
+    }
+
+    uint64_t getNumDropped() const {
+      return mNumDropped;
+    }
+
+   private:
+    void run();
+
+    void signal() {
+      mSignal.fetch_add(1, std::memory_order_release);
+      mSignal.notify_one();
+    }
+
+    /** Runs the overflowed deliveries. @return false if there were none. */
+    bool runOverflow();
+
+    const HalClientId mClientId;
+    SpscRingBuffer<Delivery, kMaxPendingDeliveries> mDeliveries;
+
+    // Serializes the producers of mDeliveries and guards mOverflow.
+    std::mutex mPushLock;
+
+    // The deliveries that didn't fit in mDeliveries, in dispatch order. While
+    // it isn't empty, new deliveries go there too to stay in order.
+    std::deque<Delivery> mOverflow GUARDED_BY(mPushLock);
+
+    // Incremented after each push and on stop to wake up the thread.
+    std::atomic<uint32_t> mSignal{0};
+
+    std::atomic<bool> mIsStopped{false};
+
+    // Only written while holding mPushLock.
+    std::atomic<uint64_t> mNumDropped{0};
+
+    std::thread mThread;
+  };
+
+  // The lock guarding mWorkers. It is never held while running a delivery.
+  std::mutex mLock;
+
+  std::unordered_map<HalClientId, std::shared_ptr<ClientWorker>> mWorkers
+      GUARDED_BY(mLock);
+};
+
+}  // namespace android::hardware::contexthub::common::implementation
+
+#endif  // ANDROID_HARDWARE_CONTEXTHUB_COMMON_CLIENT_MESSAGE_DISPATCHER_H_
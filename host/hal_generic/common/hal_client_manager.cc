@@ -18,14 +18,12 @@
 #include <cstdio>
 #include <fstream>
 
-#include <aidl/android/hardware/contexthub/AsyncEventType.h>
 #include <android-base/strings.h>
 #include <json/json.h>
 #include <utils/SystemClock.h>
 
 namespace android::hardware::contexthub::common::implementation {
 
-using ::aidl::android::hardware::contexthub::AsyncEventType;
 using ::aidl::android::hardware::contexthub::ContextHubMessage;
 using ::aidl::android::hardware::contexthub::HostEndpointInfo;
 using ::aidl::android::hardware::contexthub::IContextHubCallback;
@@ -170,6 +168,7 @@ bool HalClientManager::registerCallback(
     pid_t pid, const std::shared_ptr<IContextHubCallback> &callback,
     void *deathRecipientCookie) {
   const std::lock_guard<std::mutex> lock(mLock);
+  mEndpointClientCache.clear();
   Client *client = getClientByProcessId(pid);
   if (client != nullptr) {
     LOGW("The pid %d has already registered. Overriding its callback.", pid);
@@ -213,6 +212,7 @@ bool HalClientManager::registerCallback(
 
 void HalClientManager::handleClientDeath(pid_t pid) {
   const std::lock_guard<std::mutex> lock(mLock);
+  mEndpointClientCache.clear();
   Client *client = getClientByProcessId(pid);
   if (client == nullptr) {
     LOGE("Failed to locate the dead pid %d", pid);
@@ -390,6 +390,7 @@ bool HalClientManager::removeEndpointId(pid_t pid,
     return false;
   }
   client->endpointIds.erase(endpointId);
+  mEndpointClientCache.clear();
   LOGI("Endpoint id %" PRIu16 " is removed from client %" PRIu16, endpointId,
        client->clientId);
   return true;
@@ -397,7 +398,20 @@ bool HalClientManager::removeEndpointId(pid_t pid,
 
 std::shared_ptr<IContextHubCallback> HalClientManager::getCallbackForEndpoint(
     const HostEndpointId mutatedEndpointId) {
+  std::optional<ClientCallback> clientCallback =
+      getClientCallbackForEndpoint(mutatedEndpointId);
+  return clientCallback.has_value() ? clientCallback->callback : nullptr;
+}
+
+std::optional<HalClientManager::ClientCallback>
+HalClientManager::getClientCallbackForEndpoint(
+    const HostEndpointId mutatedEndpointId) {
   const std::lock_guard<std::mutex> lock(mLock);
+  if (auto iter = mEndpointClientCache.find(mutatedEndpointId);
+      iter != mEndpointClientCache.end()) {
+    return iter->second;
+  }
+
   Client *client;
   if (mutatedEndpointId & kVendorEndpointIdBitMask) {
     HalClientId clientId =
@@ -412,16 +426,33 @@ std::shared_ptr<IContextHubCallback> HalClientManager::getCallbackForEndpoint(
   if (client == nullptr) {
     LOGE("Unknown endpoint id %" PRIu16 ". Please register the callback first.",
          originalEndpointId);
-    return nullptr;
+    return std::nullopt;
   }
+  ClientCallback clientCallback{client->clientId, client->callback};
   if (client->endpointIds.find(originalEndpointId) ==
       client->endpointIds.end()) {
     LOGW(
         "Received a message from CHRE for an unknown or disconnected endpoint "
         "id %" PRIu16,
         originalEndpointId);
+  } else {
+    // Only registered endpoints are cached so that unknown ones keep being
+    // reported.
+    mEndpointClientCache.emplace(mutatedEndpointId, clientCallback);
   }
-  return client->callback;
+  return clientCallback;
+}
+
+std::vector<HalClientManager::ClientCallback>
+HalClientManager::getAllClientCallbacks() {
+  const std::lock_guard<std::mutex> lock(mLock);
+  std::vector<ClientCallback> clientCallbacks;
+  for (const auto &client : mClients) {
+    if (client.callback != nullptr) {
+      clientCallbacks.push_back({client.clientId, client.callback});
+    }
+  }
+  return clientCallbacks;
 }
 
 void HalClientManager::sendMessageForAllCallbacks(
@@ -556,25 +587,22 @@ std::optional<int64_t> HalClientManager::resetPendingUnloadTransaction(
   return std::nullopt;
 }
 
-void HalClientManager::handleChreRestart() {
-  std::vector<std::shared_ptr<IContextHubCallback>> callbacks;
-  {
-    const std::lock_guard<std::mutex> lock(mLock);
-    mPendingLoadTransaction.reset();
-    mPendingUnloadTransaction.reset();
-    for (Client &client : mClients) {
-      client.endpointIds.clear();
-      if (client.callback != nullptr) {
-        // Create a copy of the callback and call it later without holding the
-        // lock to avoid deadlocks.
-        callbacks.push_back(client.callback);
-      }
+std::vector<HalClientManager::ClientCallback>
+HalClientManager::handleChreRestart() {
+  std::vector<ClientCallback> callbacks;
+  const std::lock_guard<std::mutex> lock(mLock);
+  mPendingLoadTransaction.reset();
+  mPendingUnloadTransaction.reset();
+  mEndpointClientCache.clear();
+  for (Client &client : mClients) {
+    client.endpointIds.clear();
+    if (client.callback != nullptr) {
+      // The callbacks are called by the caller without holding the lock to
+      // avoid deadlocks.
+      callbacks.push_back({client.clientId, client.callback});
     }
   }
-
-  for (const auto &callback : callbacks) {
-    callback->handleContextHubAsyncEvent(AsyncEventType::RESTARTED);
-  }
+  return callbacks;
 }
 
 void HalClientManager::updateClientIdMappingFile() {
@@ -24,9 +24,11 @@
 
 #include <sys/types.h>
 #include <cstddef>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <aidl/android/hardware/contexthub/ContextHubMessage.h>
 #include <aidl/android/hardware/contexthub/IContextHub.h>
@@ -128,6 +130,12 @@ class HalClientManager {
     std::unordered_set<HostEndpointId> endpointIds{};
   };
 
+  // The callback of a client, used to deliver messages outside of the lock.
+  struct ClientCallback {
+    HalClientId clientId;
+    std::shared_ptr<IContextHubCallback> callback;
+  };
+
   // A snapshot of the nanoapp being loaded, for logging purpose.
   struct PendingLoadNanoappInfo {
     PendingLoadNanoappInfo(uint64_t appId, size_t appSize,
@@ -320,6 +328,21 @@ class HalClientManager {
   std::shared_ptr<IContextHubCallback> getCallbackForEndpoint(
       HostEndpointId mutatedEndpointId);
 
+  /**
+   * Gets the client owning the endpoint @p mutatedEndpointId.
+   *
+   * <p>Lookups of registered endpoints are cached until the set of clients or
+   * endpoints changes.
+   *
+   * @return the id and callback of the client, or std::nullopt if the client
+   * is unknown.
+   */
+  std::optional<ClientCallback> getClientCallbackForEndpoint(
+      HostEndpointId mutatedEndpointId);
+
+  /** Gets the id and callback of every client having a callback. */
+  std::vector<ClientCallback> getAllClientCallbacks();
+
   /**
    * Handles the client death event.
    *
@@ -327,8 +350,13 @@ class HalClientManager {
    */
   void handleClientDeath(pid_t pid);
 
-  /** Handles CHRE restart event. */
-  void handleChreRestart();
+  /**
+   * Handles CHRE restart event.
+   *
+   * @return The id and callback of every connected client, to be notified of
+   *     the restart.
+   */
+  std::vector<ClientCallback> handleChreRestart();
 
   /** Dumps various states maintained for debugging purpose. */
   std::string debugDump();
@@ -497,6 +525,10 @@ class HalClientManager {
 
   std::vector<Client> mClients GUARDED_BY(mLock);
 
+  // Cache of getClientCallbackForEndpoint() keyed by mutated endpoint id.
+  std::unordered_map<HostEndpointId, ClientCallback> mEndpointClientCache
+      GUARDED_BY(mLock);
+
   // States tracking pending transactions
   std::optional<PendingLoadTransaction> mPendingLoadTransaction
       GUARDED_BY(mLock) = std::nullopt;
@@ -34,6 +34,7 @@ namespace android::hardware::contexthub::common::implementation {
 
 using ::android::base::WriteStringToFd;
 using ::android::chre::FragmentedLoadTransaction;
+using ::android::chre::SharedBinary;
 using ::android::chre::getStringFromByteVector;
 using ::android::chre::Atoms::ChreHalNanoappLoadFailed;
 using ::android::chre::flags::abort_if_no_context_hub_found;
@@ -203,12 +204,12 @@ ScopedAStatus MultiClientContextHubBase::loadNanoapp(
   LOGI("Loading nanoapp 0x%" PRIx64, appBinary.nanoappId);
   uint32_t targetApiVersion = (appBinary.targetChreApiMajorVersion << 24) |
                               (appBinary.targetChreApiMinorVersion << 16);
-  auto nanoappBuffer =
-      std::make_shared<std::vector<uint8_t>>(appBinary.customBinary);
+  // The logger and the load fragments share a single copy of the binary.
+  SharedBinary nanoappBuffer = SharedBinary::copyOf(appBinary.customBinary);
   mLogger.onNanoappLoadStarted(appBinary.nanoappId, nanoappBuffer);
   auto transaction = std::make_unique<FragmentedLoadTransaction>(
       transactionId, appBinary.nanoappId, appBinary.nanoappVersion,
-      appBinary.flags, targetApiVersion, appBinary.customBinary,
+      appBinary.flags, targetApiVersion, nanoappBuffer,
       mConnection->getLoadFragmentSizeBytes());
   pid_t pid = AIBinder_getCallingPid();
   if (!mHalClientManager->registerPendingLoadTransaction(
@@ -395,6 +396,7 @@ ScopedAStatus MultiClientContextHubBase::registerCallback(
     LOGE("Unable to register a client (pid=%d) callback", pid);
     return fromResult(false);
   }
+  mMessageDispatcher.addClient(mHalClientManager->getClientId(pid));
   return ScopedAStatus::ok();
 }
 
@@ -758,7 +760,12 @@ void MultiClientContextHubBase::onNanoappListResponse(
     appInfoList.push_back(appInfo);
   }
 
-  callback->handleNanoappInfo(appInfoList);
+  mMessageDispatcher.dispatch(
+      clientId,
+      [callback = std::move(callback), appInfoList = std::move(appInfoList)]() {
+        callback->handleNanoappInfo(appInfoList);
+      },
+      ClientMessageDispatcher::FullPolicy::kOverflow);
 }
 
 void MultiClientContextHubBase::onNanoappLoadResponse(
@@ -822,8 +829,14 @@ void MultiClientContextHubBase::onNanoappLoadResponse(
                               nanoappInfo->appVersion, success);
   if (auto callback = mHalClientManager->getCallback(clientId);
       callback != nullptr) {
-    callback->handleTransactionResult(response.transaction_id,
-                                      /* in_success= */ success);
+    mMessageDispatcher.dispatch(
+        clientId,
+        [callback = std::move(callback),
+         transactionId = response.transaction_id, success]() {
+          callback->handleTransactionResult(transactionId,
+                                            /* in_success= */ success);
+        },
+        ClientMessageDispatcher::FullPolicy::kOverflow);
   }
 }
 
@@ -843,8 +856,15 @@ void MultiClientContextHubBase::onNanoappUnloadResponse(
     mEventLogger.logNanoappUnload(*nanoappId, response.success);
     if (auto callback = mHalClientManager->getCallback(clientId);
         callback != nullptr) {
-      callback->handleTransactionResult(response.transaction_id,
-                                        /* in_success= */ response.success);
+      mMessageDispatcher.dispatch(
+          clientId,
+          [callback = std::move(callback),
+           transactionId = response.transaction_id,
+           success = response.success]() {
+            callback->handleTransactionResult(transactionId,
+                                              /* in_success= */ success);
+          },
+          ClientMessageDispatcher::FullPolicy::kOverflow);
     }
   }
   // TODO(b/242760291): Remove the nanoapp log detokenizer associated with this
@@ -873,14 +893,26 @@ void MultiClientContextHubBase::onNanoappMessage(
       chreToAndroidPermissions(message.message_permissions);
   // broadcast message is sent to every connected endpoint
   if (message.host_endpoint == CHRE_HOST_ENDPOINT_BROADCAST) {
-    mHalClientManager->sendMessageForAllCallbacks(outMessage,
-                                                  messageContentPerms);
-  } else if (auto callback = mHalClientManager->getCallbackForEndpoint(
-                 message.host_endpoint);
-             callback != nullptr) {
+    for (auto &[clientId, callback] :
+         mHalClientManager->getAllClientCallbacks()) {
+      mMessageDispatcher.dispatch(
+          clientId, [callback, outMessage, messageContentPerms]() {
+            callback->handleContextHubMessage(outMessage, messageContentPerms);
+          });
+    }
+  } else if (auto clientCallback =
+                 mHalClientManager->getClientCallbackForEndpoint(
+                     message.host_endpoint);
+             clientCallback.has_value() && clientCallback->callback != nullptr) {
     outMessage.hostEndPoint =
         HalClientManager::convertToOriginalEndpointId(message.host_endpoint);
-    callback->handleContextHubMessage(outMessage, messageContentPerms);
+    mMessageDispatcher.dispatch(
+        clientCallback->clientId,
+        [callback = std::move(clientCallback->callback),
+         outMessage = std::move(outMessage),
+         messageContentPerms = std::move(messageContentPerms)]() {
+          callback->handleContextHubMessage(outMessage, messageContentPerms);
+        });
   }
 
   if (mMetricsReporter != nullptr && message.woke_host) {
@@ -906,9 +938,9 @@ void MultiClientContextHubBase::onMessageDeliveryStatus(
 
   HostEndpointId hostEndpointId = hostEndpointIdIter->second;
   mReliableMessageMap.erase(hostEndpointIdIter);
-  std::shared_ptr<IContextHubCallback> callback =
-      mHalClientManager->getCallbackForEndpoint(hostEndpointId);
-  if (callback == nullptr) {
+  std::optional<HalClientManager::ClientCallback> clientCallback =
+      mHalClientManager->getClientCallbackForEndpoint(hostEndpointId);
+  if (!clientCallback.has_value() || clientCallback->callback == nullptr) {
     LOGE("Could not get callback for host endpoint: %" PRIu16, hostEndpointId);
     return;
   }
@@ -918,7 +950,13 @@ void MultiClientContextHubBase::onMessageDeliveryStatus(
   MessageDeliveryStatus outStatus;
   outStatus.messageSequenceNumber = status.message_sequence_number;
   outStatus.errorCode = toErrorCode(status.error_code);
-  callback->handleMessageDeliveryStatus(hostEndpointId, outStatus);
+  mMessageDispatcher.dispatch(
+      clientCallback->clientId,
+      [callback = std::move(clientCallback->callback), hostEndpointId,
+       outStatus]() {
+        callback->handleMessageDeliveryStatus(hostEndpointId, outStatus);
+      },
+      ClientMessageDispatcher::FullPolicy::kOverflow);
 }
 
 void MultiClientContextHubBase::onClientDied(void *cookie) {
@@ -940,13 +978,21 @@ void MultiClientContextHubBase::handleClientDeath(pid_t clientPid) {
       mConnection->sendMessage(builder);
     }
   }
+  mMessageDispatcher.removeClient(mHalClientManager->getClientId(clientPid));
   mHalClientManager->handleClientDeath(clientPid);
 }
 
 void MultiClientContextHubBase::onChreRestarted() {
   mIsWifiAvailable.reset();
   mEventLogger.logContextHubRestart();
-  mHalClientManager->handleChreRestart();
+  for (auto &[clientId, callback] : mHalClientManager->handleChreRestart()) {
+    mMessageDispatcher.dispatch(
+        clientId,
+        [callback = std::move(callback)]() {
+          callback->handleContextHubAsyncEvent(AsyncEventType::RESTARTED);
+        },
+        ClientMessageDispatcher::FullPolicy::kOverflow);
+  }
 }
 
 binder_status_t MultiClientContextHubBase::dump(int fd,
@@ -966,6 +1012,11 @@ binder_status_t MultiClientContextHubBase::dump(int fd,
          dumpOfHalClientManager.size());
   }
 
+  std::string dumpOfMessageDispatcher = mMessageDispatcher.debugDump();
+  if (!WriteStringToFd(dumpOfMessageDispatcher, fd)) {
+    LOGW("Failed to write debug dump of the message dispatcher");
+  }
+
   // Dump the status of test mode
   std::ostringstream testModeDump;
   {
@@ -23,6 +23,7 @@
 #include <chre_host/metrics_reporter.h>
 
 #include "chre_connection_callback.h"
+#include "client_message_dispatcher.h"
 #include "chre_host/napp_header.h"
 #include "chre_host/preloaded_nanoapp_loader.h"
 #include "chre_host/time_syncer.h"
@@ -208,6 +209,10 @@ class MultiClientContextHubBase
 
   // Used to map message sequence number to host endpoint ID
   std::unordered_map<int32_t, HostEndpointId> mReliableMessageMap;
+
+  // Delivers nanoapp messages and delivery statuses to each client on its own
+  // thread so that a slow client doesn't delay the others.
+  ClientMessageDispatcher mMessageDispatcher;
 };
 }  // namespace android::hardware::contexthub::common::implementation
 #endif  // ANDROID_HARDWARE_CONTEXTHUB_COMMON_MULTICLIENTS_HAL_BASE_H_
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ANDROID_HARDWARE_CONTEXTHUB_COMMON_SPSC_RING_BUFFER_H_
+#define ANDROID_HARDWARE_CONTEXTHUB_COMMON_SPSC_RING_BUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace android::hardware::contexthub::common::implementation {
+
+/**
+ * A fixed capacity, lock-free FIFO for exactly one producer thread and one
+ * consumer thread.
+ *
+ * <p>The producer only writes mTail and the consumer only writes mHead, so
+ * neither side ever waits for the other. The two indices are kept on separate
+ * cache lines to avoid false sharing between the threads.
+ *
+ * @tparam T The element type. Must be default constructible and movable.
+ * @tparam kCapacity The number of elements the buffer can hold. Must be a
+ *     power of two.
+ */
+template <typename T, size_t kCapacity>
+class SpscRingBuffer {
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "The capacity must be a power of two");
+
+ public:
+  SpscRingBuffer() = default;
+
+  /** Disable copy constructor and copy assignment. */
+  SpscRingBuffer(const SpscRingBuffer &) = delete;
+  void operator=(const SpscRingBuffer &) = delete;
+
+  /**
+   * Adds an element at the back of the buffer. Must only be called by the
+   * producer thread.
+   *
+   * @return true on success, false if the buffer is full, in which case
+   *     element is left untouched.
+   */
+  bool push(T &&element) {
+    size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHead.load(std::memory_order_acquire) == kCapacity) {
+      return false;
+    }
+    mElements[tail & (kCapacity - 1)] = std::move(element);
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Removes the element at the front of the buffer. Must only be called by the
+   * consumer thread.
+   *
+   * @return true on success, false if the buffer is empty.
+   */
+  bool pop(T &element) {
+    size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    element = std::move(mElements[head & (kCapacity - 1)]);
+    // Release the moved-from element's resources before handing the slot back.
+    mElements[head & (kCapacity - 1)] = T();
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Returns the number of elements in the buffer. The result is exact only
+   * when called by the producer or the consumer thread while the other one is
+   * idle.
+   */
+  size_t size() const {
+    return mTail.load(std::memory_order_acquire) -
+           mHead.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() {
+    return kCapacity;
+  }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  // The index of the next element to pop, written by the consumer.
+  alignas(kCacheLineSize) std::atomic<size_t> mHead{0};
+
+  // The index of the next element to push, written by the producer.
+  alignas(kCacheLineSize) std::atomic<size_t> mTail{0};
+
+  alignas(kCacheLineSize) std::array<T, kCapacity> mElements{};
+};
+
+}  // namespace android::hardware::contexthub::common::implementation
+
+#endif  // ANDROID_HARDWARE_CONTEXTHUB_COMMON_SPSC_RING_BUFFER_H_
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "chre_host/fragmented_load_transaction.h"
+#include "chre_host/mapped_file.h"
+#include "chre_host/shared_binary.h"
+#include "gtest/gtest.h"
+
+namespace android::chre {
+
+namespace {
+
+class MappedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char path[] = "/tmp/mapped_file_test_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    mPath = path;
+    mContents.resize(10 * 1024 + 7);
+    for (size_t i = 0; i < mContents.size(); i++) {
+      mContents[i] = static_cast<uint8_t>(i * 31);
+    }
+    ASSERT_EQ(write(fd, mContents.data(), mContents.size()),
+              static_cast<ssize_t>(mContents.size()));
+    close(fd);
+  }
+
+  void TearDown() override {
+    unlink(mPath.c_str());
+  }
+
+  std::string mPath;
+  std::vector<uint8_t> mContents;
+};
+
+TEST_F(MappedFileTest, MapsFileContents) {
+  std::shared_ptr<const MappedFile> file = MappedFile::open(mPath.c_str());
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(file->size(), mContents.size());
+  EXPECT_EQ(std::vector<uint8_t>(file->data(), file->data() + file->size()),
+            mContents);
+}
+
+TEST_F(MappedFileTest, MapsEmptyFile) {
+  ASSERT_EQ(truncate(mPath.c_str(), 0), 0);
+  SharedBinary binary;
+  ASSERT_TRUE(MappedFile::openAsBinary(mPath.c_str(), binary));
+  EXPECT_TRUE(binary.empty());
+}
+
+TEST_F(MappedFileTest, FailsOnMissingFile) {
+  SharedBinary binary;
+  EXPECT_EQ(MappedFile::open("/nonexistent/nanoapp.so"), nullptr);
+  EXPECT_FALSE(MappedFile::openAsBinary("/nonexistent/nanoapp.so", binary));
+}
+
+TEST_F(MappedFileTest, FragmentsAreViewsIntoTheMapping) {
+  constexpr size_t kFragmentSize = 4096;
+  std::vector<FragmentedLoadRequest> requests;
+  {
+    SharedBinary binary;
+    ASSERT_TRUE(MappedFile::openAsBinary(mPath.c_str(), binary));
+    FragmentedLoadTransaction transaction(
+        /* transactionId= */ 1, /* appId= */ 0x0123456789abcdef,
+        /* appVersion= */ 1, /* appFlags= */ 0, /* targetApiVersion= */ 0,
+        binary, kFragmentSize);
+    while (!transaction.isComplete()) {
+      const FragmentedLoadRequest &request = transaction.getNextRequest();
+      EXPECT_EQ(request.binary.data(),
+                binary.data() + (request.fragmentId - 1) * kFragmentSize);
+      requests.push_back(request);
+    }
+  }
+
+  // The requests keep the mapping alive once the file and transaction are gone.
+  ASSERT_EQ(requests.size(), 3);
+  EXPECT_EQ(requests[0].appTotalSizeBytes, mContents.size());
+  std::vector<uint8_t> reassembled;
+  for (const FragmentedLoadRequest &request : requests) {
+    reassembled.insert(reassembled.end(), request.binary.data(),
+                       request.binary.data() + request.binary.size());
+  }
+  EXPECT_EQ(reassembled, mContents);
+}
+
+TEST(SharedBinaryTest, SubspanIsTruncatedToTheEnd) {
+  SharedBinary binary = SharedBinary::copyOf({1, 2, 3, 4, 5});
+  EXPECT_EQ(binary.subspan(3, 10).size(), 2);
+  EXPECT_EQ(*binary.subspan(3, 10).data(), 4);
+  EXPECT_TRUE(binary.subspan(8, 2).empty());
+}
+
+}  // namespace
+
+}  // namespace android::chre
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "client_message_dispatcher.h"
+#include "gtest/gtest.h"
+#include "spsc_ring_buffer.h"
+
+namespace android::hardware::contexthub::common::implementation {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr HalClientId kSlowClientId = 10;
+constexpr std::array<HalClientId, 3> kFastClientIds{1, 2, 3};
+constexpr uint32_t kMessagesPerRound = 16;
+constexpr uint32_t kNumRounds = 64;
+
+// The frame sent by the stand-in of the CHRE daemon.
+struct Frame {
+  HalClientId clientId;
+  uint32_t sequenceNumber;
+};
+
+TEST(SpscRingBufferTest, PopsInPushOrderAcrossWrapAround) {
+  SpscRingBuffer<int, 4> buffer;
+  int value = 0;
+
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(buffer.push(int{i}));
+    EXPECT_TRUE(buffer.pop(value));
+    EXPECT_EQ(value, i);
+  }
+  EXPECT_FALSE(buffer.pop(value));
+}
+
+TEST(SpscRingBufferTest, PushFailsWhenFull) {
+  SpscRingBuffer<int, 4> buffer;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(buffer.push(int{i}));
+  }
+  EXPECT_FALSE(buffer.push(4));
+  EXPECT_EQ(buffer.size(), 4);
+
+  int value = 0;
+  EXPECT_TRUE(buffer.pop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(buffer.push(4));
+}
+
+TEST(ClientMessageDispatcherTest, SlowClientDoesNotBlockOtherClients) {
+  int sockets[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets), 0);
+  const int daemonSocket = sockets[0];
+  const int halSocket = sockets[1];
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::array<std::vector<uint32_t>, kFastClientIds.size()> received;
+  std::atomic<uint32_t> numSlowDelivered{0};
+  uint32_t numSlowDispatched = 0;
+  bool timedOut = false;
+
+  std::promise<void> releaseSlowClient;
+  std::shared_future<void> slowClientReleased =
+      releaseSlowClient.get_future().share();
+
+  // The stand-in for the CHRE daemon sends messages to all the clients in
+  // rounds, and only starts a round once the fast clients have received the
+  // previous one. It would stall if the blocked slow client delayed them.
+  std::thread daemon([&]() {
+    for (uint32_t round = 0; round < kNumRounds && !timedOut; round++) {
+      for (uint32_t i = 0; i < kMessagesPerRound; i++) {
+        uint32_t sequenceNumber = round * kMessagesPerRound + i;
+        for (HalClientId clientId : kFastClientIds) {
+          Frame frame{clientId, sequenceNumber};
+          send(daemonSocket, &frame, sizeof(frame), 0);
+        }
+        Frame frame{kSlowClientId, sequenceNumber};
+        send(daemonSocket, &frame, sizeof(frame), 0);
+      }
+
+      std::unique_lock<std::mutex> lock(mutex);
+      size_t expected = (round + 1) * kMessagesPerRound;
+      timedOut = !condition.wait_for(lock, 5s, [&]() {
+        for (const auto &messages : received) {
+          if (messages.size() < expected) {
+            return false;
+          }
+        }
+        return true;
+      });
+    }
+    close(daemonSocket);
+  });
+
+  {
+    ClientMessageDispatcher dispatcher;
+    for (HalClientId clientId : kFastClientIds) {
+      dispatcher.addClient(clientId);
+    }
+    dispatcher.addClient(kSlowClientId);
+    Frame frame;
+    while (recv(halSocket, &frame, sizeof(frame), 0) == sizeof(frame)) {
+      if (frame.clientId == kSlowClientId) {
+        if (dispatcher.dispatch(frame.clientId, [&, slowClientReleased]() {
+              slowClientReleased.wait();
+              numSlowDelivered++;
+            })) {
+          numSlowDispatched++;
+        }
+        continue;
+      }
+
+      size_t index = frame.clientId - kFastClientIds[0];
+      uint32_t sequenceNumber = frame.sequenceNumber;
+      EXPECT_TRUE(dispatcher.dispatch(frame.clientId, [&, index,
+                                                       sequenceNumber]() {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          received[index].push_back(sequenceNumber);
+        }
+        condition.notify_all();
+      }));
+    }
+    daemon.join();
+    EXPECT_FALSE(timedOut);
+
+    // The slow client got the delivery it is blocked on plus a full ring of
+    // pending ones, the others were dropped.
+    EXPECT_EQ(numSlowDispatched,
+              ClientMessageDispatcher::kMaxPendingDeliveries + 1);
+    EXPECT_EQ(numSlowDelivered.load(), 0);
+    releaseSlowClient.set_value();
+    dispatcher.removeClient(kSlowClientId);
+  }
+  close(halSocket);
+
+  // Deliveries that were not started when the slow client was removed are
+  // dropped.
+  EXPECT_LE(numSlowDelivered.load(), numSlowDispatched);
+  for (const auto &messages : received) {
+    ASSERT_EQ(messages.size(), kNumRounds * kMessagesPerRound);
+    for (uint32_t i = 0; i < messages.size(); i++) {
+      EXPECT_EQ(messages[i], i);
+    }
+  }
+}
+
+TEST(ClientMessageDispatcherTest, UnknownClientIsRejected) {
+  ClientMessageDispatcher dispatcher;
+  bool delivered = false;
+
+  EXPECT_FALSE(dispatcher.dispatch(/* clientId= */ 1,
+                                   [&]() { delivered = true; }));
+  dispatcher.removeClient(/* clientId= */ 1);
+  EXPECT_FALSE(dispatcher.dispatch(
+      /* clientId= */ 1, [&]() { delivered = true; },
+      ClientMessageDispatcher::FullPolicy::kOverflow));
+  EXPECT_FALSE(delivered);
+}
+
+TEST(ClientMessageDispatcherTest, RemovedClientCanReceiveAgain) {
+  ClientMessageDispatcher dispatcher;
+  std::promise<int> delivered;
+
+  dispatcher.addClient(/* clientId= */ 1);
+  EXPECT_TRUE(dispatcher.dispatch(/* clientId= */ 1, []() {}));
+  dispatcher.removeClient(/* clientId= */ 1);
+  EXPECT_FALSE(dispatcher.dispatch(/* clientId= */ 1, []() {}));
+
+  dispatcher.addClient(/* clientId= */ 1);
+  EXPECT_TRUE(dispatcher.dispatch(/* clientId= */ 1,
+                                  [&]() { delivered.set_value(42); }));
+
+  std::future<int> result = delivered.get_future();
+  ASSERT_EQ(result.wait_for(5s), std::future_status::ready);
+  EXPECT_EQ(result.get(), 42);
+}
+
+TEST(ClientMessageDispatcherTest, OverflowedDeliveriesAreNotDropped) {
+  constexpr HalClientId kBlockedClientId = 1;
+  constexpr HalClientId kOtherClientId = 2;
+  constexpr uint32_t kNumDeliveries =
+      ClientMessageDispatcher::kMaxPendingDeliveries * 4;
+  ClientMessageDispatcher dispatcher;
+  dispatcher.addClient(kBlockedClientId);
+  dispatcher.addClient(kOtherClientId);
+
+  std::promise<void> releaseClient;
+  std::shared_future<void> clientReleased = releaseClient.get_future().share();
+  std::vector<uint32_t> received;
+
+  // The deliveries block the client until released, and the dispatches
+  // overflowing its ring return right away.
+  for (uint32_t i = 0; i < kNumDeliveries; i++) {
+    EXPECT_TRUE(dispatcher.dispatch(
+        kBlockedClientId,
+        [&, clientReleased, i]() {
+          clientReleased.wait();
+          received.push_back(i);
+        },
+        ClientMessageDispatcher::FullPolicy::kOverflow));
+  }
+
+  // Droppable deliveries can't jump ahead of the overflowed ones.
+  EXPECT_FALSE(dispatcher.dispatch(kBlockedClientId, []() {}));
+
+  std::promise<void> otherDelivered;
+  ASSERT_TRUE(dispatcher.dispatch(kOtherClientId,
+                                  [&]() { otherDelivered.set_value(); }));
+  ASSERT_EQ(otherDelivered.get_future().wait_for(5s),
+            std::future_status::ready);
+
+  releaseClient.set_value();
+  std::promise<void> drained;
+  ASSERT_TRUE(dispatcher.dispatch(
+      kBlockedClientId, [&]() { drained.set_value(); },
+      ClientMessageDispatcher::FullPolicy::kOverflow));
+  ASSERT_EQ(drained.get_future().wait_for(5s), std::future_status::ready);
+
+  ASSERT_EQ(received.size(), kNumDeliveries);
+  for (uint32_t i = 0; i < kNumDeliveries; i++) {
+    EXPECT_EQ(received[i], i);
+  }
+
+  // Once the overflow is drained, the ring is used again.
+  std::promise<void> delivered;
+  ASSERT_TRUE(
+      dispatcher.dispatch(kBlockedClientId, [&]() { delivered.set_value(); }));
+  EXPECT_EQ(delivered.get_future().wait_for(5s), std::future_status::ready);
+}
+
+}  // namespace
+
+}  // namespace android::hardware::contexthub::common::implementation
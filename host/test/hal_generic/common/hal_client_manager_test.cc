@@ -536,16 +536,17 @@ TEST_F(HalClientManagerTest, handleChreRestartForConnectedClientsOnly) {
   EXPECT_TRUE(halClientManager->registerCallback(
       kVendorPid, vendorCallback, /* deathRecipientCookie= */ nullptr));
 
-  // Only connected clients' handleContextHubAsyncEvent should be called.
-  EXPECT_CALL(*systemCallback,
-              handleContextHubAsyncEvent(AsyncEventType::RESTARTED));
-  EXPECT_CALL(*vendorCallback,
-              handleContextHubAsyncEvent(AsyncEventType::RESTARTED))
-      .Times(0);
+  HalClientId systemClientId = halClientManager->getClientId(kSystemServerPid);
 
   // Disconnect the vendor client and handle CHRE restart for the system server
   halClientManager->handleClientDeath(kVendorPid);
-  halClientManager->handleChreRestart();
+  std::vector<HalClientManager::ClientCallback> callbacks =
+      halClientManager->handleChreRestart();
+
+  // Only connected clients should be notified of the restart.
+  ASSERT_THAT(callbacks, SizeIs(1));
+  EXPECT_EQ(callbacks.front().clientId, systemClientId);
+  EXPECT_EQ(callbacks.front().callback, systemCallback);
 }
 
 }  // namespace
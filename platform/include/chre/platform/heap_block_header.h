@@ -39,6 +39,14 @@ union HeapBlockHeader {
 
     //! The ID of nanoapp requesting memory allocation.
     uint16_t instanceId;
+
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+    //! The index of the allocation site in the HeapProfiler.
+    uint16_t profilerSiteIndex;
+
+    //! The time of the allocation in milliseconds, used to compute lifetimes.
+    uint32_t allocTimeMs;
+#endif  // CHRE_HEAP_PROFILER_ENABLED
   } data;
 
   //! Makes sure header is a multiple of the size of max_align_t
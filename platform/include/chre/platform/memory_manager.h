@@ -20,7 +20,10 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "chre/core/heap_profiler.h"
 #include "chre/core/nanoapp.h"
+#include "chre/platform/mutex.h"
+#include "chre/util/lock_guard.h"
 #include "chre/util/non_copyable.h"
 #include "chre/util/system/debug_dump.h"
 #include "heap_block_header.h"
@@ -35,6 +38,9 @@ namespace chre {
 /**
  * The MemoryManager keeps track of heap memory allocated/deallocated by all
  * nanoapps.
+ *
+ * Nanoapps pinned to worker event loops use the heap from their own thread, so
+ * the bookkeeping is guarded by a lock.
  */
 class MemoryManager : public NonCopyable {
  public:
@@ -43,9 +49,11 @@ class MemoryManager : public NonCopyable {
    *
    * @param app The pointer to the nanoapp requesting memory.
    * @param bytes The size in bytes to allocate.
+   * @param callSite The return address of the nanoapp's allocation call, used
+   *    to attribute the allocation when the heap profiler is enabled.
    * @return the allocated memory pointer. nullptr if the allocation fails.
    */
-  void *nanoappAlloc(Nanoapp *app, uint32_t bytes);
+  void *nanoappAlloc(Nanoapp *app, uint32_t bytes, uintptr_t callSite = 0);
 
   /**
    * Free heap memory in CHRE.
@@ -67,6 +75,7 @@ class MemoryManager : public NonCopyable {
    * @return current total allocated memory in bytes.
    */
   size_t getTotalAllocatedBytes() const {
+    LockGuard<Mutex> lock(mLock);
     return mTotalAllocatedBytes;
   }
 
@@ -74,6 +83,7 @@ class MemoryManager : public NonCopyable {
    * @return peak total allocated memory in bytes.
    */
   size_t getPeakAllocatedBytes() const {
+    LockGuard<Mutex> lock(mLock);
     return mPeakAllocatedBytes;
   }
 
@@ -81,6 +91,7 @@ class MemoryManager : public NonCopyable {
    * @return current count of allocated memory spaces.
    */
   size_t getAllocationCount() const {
+    LockGuard<Mutex> lock(mLock);
     return mAllocationCount;
   }
 
@@ -98,6 +109,16 @@ class MemoryManager : public NonCopyable {
     return kMaxAllocationCount;
   }
 
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+  /**
+   * @return the profile of the nanoapp heap allocations. Must only be read
+   *     while no nanoapp uses the heap.
+   */
+  const HeapProfiler &getHeapProfiler() const {
+    return mHeapProfiler;
+  }
+#endif  // CHRE_HEAP_PROFILER_ENABLED
+
   /**
    * Prints state in a string buffer. Must only be called from the context of
    * the main CHRE thread.
@@ -108,6 +129,10 @@ class MemoryManager : public NonCopyable {
   void logStateToBuffer(DebugDumpWrapper &debugDump) const;
 
  private:
+  //! Guards the members below, as nanoapps on worker event loops allocate
+  //! concurrently with the ones on the system event loop.
+  mutable Mutex mLock;
+
   //! The total allocated memory in bytes (not including header).
   size_t mTotalAllocatedBytes = 0;
 
@@ -117,6 +142,11 @@ class MemoryManager : public NonCopyable {
   //! Stores total number of allocated memory spaces.
   size_t mAllocationCount = 0;
 
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+  //! Attributes allocations to their call sites.
+  HeapProfiler mHeapProfiler;
+#endif  // CHRE_HEAP_PROFILER_ENABLED
+
   //! The maximum allowable total allocated memory in bytes for all nanoapps.
   static constexpr size_t kMaxAllocationBytes = CHRE_MAX_ALLOCATION_BYTES;
 
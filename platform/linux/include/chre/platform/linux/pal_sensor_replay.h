@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_PLATFORM_LINUX_PAL_SENSOR_REPLAY_H_
+#define CHRE_PLATFORM_LINUX_PAL_SENSOR_REPLAY_H_
+
+#include <cstdint>
+
+#include "chre/pal/sensor.h"
+
+/**
+ * @file
+ * A sensor PAL replaying recorded traces, used to exercise the sensor stack
+ * with realistic workloads on Linux.
+ *
+ * A trace is a text file where '#' starts a comment. It first declares its
+ * sensors, then lists their samples:
+ *
+ *   sensor <index> <type> <minIntervalNs> <name>
+ *   <timestampNs> <index> <value> [<value> <value>]
+ *
+ * Sensor indices must be declared in order starting from 0, and become the
+ * sensor handles. The supported types are accel, gyro, mag, uncal_accel,
+ * uncal_gyro and uncal_mag, which take three values per sample, as well as
+ * baro and light, which take one. The samples of a sensor must be sorted by
+ * timestamp.
+ *
+ * Playback starts when a sensor is first enabled. Samples are decimated to
+ * the requested interval and batched according to the requested latency. The
+ * timestamps delivered to CHRE keep the spacing of the trace, whatever the
+ * replay speed.
+ */
+
+//! Replays the trace by delivering a new sample event as soon as CHRE has
+//! released the previous one.
+constexpr float kPalSensorReplayAsFastAsPossible = 0.0f;
+
+/**
+ * Loads a trace, making the sensor PAL replay it instead of simulating its
+ * accelerometer. Must be called before CHRE is initialized, as the sensors are
+ * only queried then.
+ *
+ * @param path The path of the trace file.
+ * @param speed The replay speed as a multiple of the recorded rate, or
+ *     kPalSensorReplayAsFastAsPossible.
+ * @return false if the trace could not be read, in which case the PAL keeps
+ *     its previous behavior.
+ */
+bool chrePalSensorLoadReplayTrace(const char *path, float speed = 1.0f);
+
+/**
+ * Unloads the trace, going back to the simulated accelerometer. Must be called
+ * after CHRE is deinitialized.
+ */
+void chrePalSensorClearReplayTrace();
+
+/**
+ * @return true if a trace is loaded.
+ */
+bool chrePalSensorIsReplayTraceLoaded();
+
+/**
+ * @return The number of samples delivered to CHRE since the trace was loaded.
+ */
+uint64_t chrePalSensorGetReplayedSampleCount();
+
+/**
+ * @return The API of the replay PAL, or nullptr if the requested version is
+ *     not compatible.
+ */
+const struct chrePalSensorApi *chrePalSensorReplayGetApi(
+    uint32_t requestedApiVersion);
+
+#endif  // CHRE_PLATFORM_LINUX_PAL_SENSOR_REPLAY_H_
@@ -42,7 +42,7 @@ class Task {
    * Construct an empty Task object.
    */
   Task()
-      : mExecutionTimestamp(std::chrono::steady_clock::now()),
+      : mExecutionTimestamp(getCurrentTime()),
         mRepeatInterval(0),
         mId(0),
         mHasExecuted(false) {}
@@ -85,6 +85,12 @@ class Task {
    */
   void execute();
 
+  /**
+   * Gets the current time of the steady clock, or of the virtual clock when
+   * enabled, see platform_linux::enableVirtualTime().
+   */
+  static std::chrono::time_point<std::chrono::steady_clock> getCurrentTime();
+
   /**
    * Gets the next time the task should execute.
    */
@@ -118,7 +124,7 @@ class Task {
    * @return false            do not yet execute the task.
    */
   inline bool isReadyToExecute() const {
-    return mExecutionTimestamp <= std::chrono::steady_clock::now();
+    return mExecutionTimestamp <= getCurrentTime();
   }
 
   /**
@@ -131,9 +131,10 @@ class TaskManager : public NonCopyable {
 
   /**
    * The condition variable to signal to the execution thread to process more
-   * tasks (the queue is not empty).
+   * tasks (the queue is not empty). Waited on through the virtual clock, see
+   * platform_linux::enableVirtualTime().
    */
-  std::condition_variable mConditionVariable;
+  std::condition_variable_any mConditionVariable;
 };
 
 // Provide an alias to the TaskManager singleton.
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_PLATFORM_LINUX_VIRTUAL_CLOCK_H_
+#define CHRE_PLATFORM_LINUX_VIRTUAL_CLOCK_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "chre/util/non_copyable.h"
+#include "chre/util/time.h"
+
+/**
+ * @file
+ * Virtual time for the Linux simulation.
+ *
+ * When enabled, SystemTime::getMonotonicTime() returns a virtual clock that
+ * only advances when every thread taking part in the simulation is idle, i.e.
+ * blocked waiting on a condition variable or sleeping. Time then jumps to the
+ * earliest deadline among the waiting threads, which are woken up. Timers,
+ * TaskManager tasks and sleeps therefore complete instantly and in a
+ * deterministic order, regardless of the speed of the host.
+ *
+ * The threads taking part are the ones started with startVirtualTimeThread()
+ * or registered with a VirtualTimeThread. Other threads run in real time and
+ * must not produce work for the simulation on their own.
+ *
+ * Enabling virtual time requires the TaskManagerSingleton to be initialized
+ * before any SystemTimer is set, since timers then run as TaskManager tasks.
+ */
+
+namespace chre::platform_linux {
+
+/**
+ * Switches to virtual time, starting from the current monotonic time. Must be
+ * called before the threads of the simulation are started.
+ */
+void enableVirtualTime();
+
+/**
+ * Switches back to real time. Must be called once the threads of the
+ * simulation have stopped.
+ */
+void disableVirtualTime();
+
+/**
+ * @return true if virtual time is enabled.
+ */
+bool isVirtualTimeEnabled();
+
+/**
+ * @return The current virtual time. Only meaningful if virtual time is
+ *     enabled.
+ */
+Nanoseconds getVirtualTime();
+
+/**
+ * @return true if the calling thread takes part in virtual time.
+ */
+bool isVirtualTimeThread();
+
+namespace internal {
+
+/**
+ * Counts a new thread as running in the simulation.
+ *
+ * @return false if virtual time is disabled, in which case nothing is done.
+ */
+bool addVirtualTimeThread();
+
+//! Marks the calling thread as the one added by addVirtualTimeThread().
+void attachVirtualTimeThread();
+
+//! Removes the calling thread from the simulation.
+void removeVirtualTimeThread();
+
+}  // namespace internal
+
+/**
+ * Makes the calling thread take part in virtual time for the lifetime of the
+ * object, if virtual time is enabled.
+ */
+class VirtualTimeThread : public NonCopyable {
+ public:
+  VirtualTimeThread() : mIsRegistered(internal::addVirtualTimeThread()) {
+    if (mIsRegistered) {
+      internal::attachVirtualTimeThread();
+    }
+  }
+
+  ~VirtualTimeThread() {
+    if (mIsRegistered) {
+      internal::removeVirtualTimeThread();
+    }
+  }
+
+ private:
+  bool mIsRegistered;
+};
+
+/**
+ * Starts a thread taking part in virtual time, if enabled. The thread counts as
+ * running from this call, so that time can't advance before it gets scheduled.
+ *
+ * @param function The function run by the thread.
+ * @return The thread.
+ */
+template <typename Function>
+std::thread startVirtualTimeThread(Function &&function) {
+  bool isRegistered = internal::addVirtualTimeThread();
+  return std::thread(
+      [isRegistered, function = std::forward<Function>(function)]() mutable {
+        if (isRegistered) {
+          internal::attachVirtualTimeThread();
+        }
+        function();
+        if (isRegistered) {
+          internal::removeVirtualTimeThread();
+        }
+      });
+}
+
+namespace internal {
+
+//! A thread of the simulation waiting on a condition variable.
+struct VirtualTimeWaiter {
+  //! The condition variable waited on.
+  std::condition_variable_any *conditionVariable;
+
+  //! The virtual time at which the wait times out, UINT64_MAX for none.
+  uint64_t deadlineNs;
+
+  //! Whether the thread has been notified or timed out, and counts as running
+  //! again.
+  bool isAwake = false;
+
+  //! Whether the wait timed out.
+  bool isTimedOut = false;
+};
+
+//! How often waiting threads check whether they have been woken up, as a
+//! backstop for notifications racing with the start of the wait.
+constexpr std::chrono::milliseconds kVirtualTimePollInterval(1);
+
+//! Registers the calling thread as idle, possibly advancing time.
+void beginVirtualTimeWait(VirtualTimeWaiter &waiter);
+
+//! @return true if the waiter has been woken up.
+bool isVirtualTimeWaitOver(const VirtualTimeWaiter &waiter);
+
+//! Unregisters the waiter. @return false if the wait timed out.
+bool endVirtualTimeWait(VirtualTimeWaiter &waiter);
+
+template <typename Lock>
+bool waitInVirtualTime(std::condition_variable_any &conditionVariable,
+                       Lock &lock, uint64_t deadlineNs) {
+  VirtualTimeWaiter waiter{&conditionVariable, deadlineNs};
+  beginVirtualTimeWait(waiter);
+  while (!isVirtualTimeWaitOver(waiter)) {
+    conditionVariable.wait_for(lock, kVirtualTimePollInterval);
+  }
+  return endVirtualTimeWait(waiter);
+}
+
+}  // namespace internal
+
+/**
+ * Waits on a condition variable, in virtual time if the calling thread takes
+ * part in it. Like std::condition_variable_any::wait(), the lock must be held.
+ */
+template <typename Lock>
+void waitOnConditionVariable(std::condition_variable_any &conditionVariable,
+                             Lock &lock) {
+  if (isVirtualTimeThread()) {
+    internal::waitInVirtualTime(conditionVariable, lock, UINT64_MAX);
+  } else {
+    conditionVariable.wait(lock);
+  }
+}
+
+/**
+ * Waits on a condition variable with a timeout, in virtual time if the calling
+ * thread takes part in it.
+ *
+ * @return false if the wait timed out.
+ */
+template <typename Lock>
+bool waitOnConditionVariableFor(std::condition_variable_any &conditionVariable,
+                                Lock &lock, Nanoseconds timeout) {
+  if (isVirtualTimeThread()) {
+    return internal::waitInVirtualTime(
+        conditionVariable, lock,
+        (getVirtualTime() + timeout).toRawNanoseconds());
+  }
+  return conditionVariable.wait_for(
+             lock, std::chrono::nanoseconds(timeout.toRawNanoseconds())) !=
+         std::cv_status::timeout;
+}
+
+/**
+ * Notifies a condition variable. In virtual time, the notified threads count as
+ * running from this call, so that time can't advance before they get
+ * scheduled.
+ *
+ * @param conditionVariable The condition variable.
+ * @param notifyAll Whether to wake up all the waiting threads or only one.
+ */
+void notifyConditionVariable(std::condition_variable_any &conditionVariable,
+                             bool notifyAll);
+
+/**
+ * Sleeps for the given duration, in virtual time if the calling thread takes
+ * part in it. A virtual sleep returns once every other thread is idle and the
+ * duration has elapsed in virtual time.
+ *
+ * @param duration The duration to sleep for.
+ */
+void sleepFor(Nanoseconds duration);
+
+}  // namespace chre::platform_linux
+
+#endif  // CHRE_PLATFORM_LINUX_VIRTUAL_CLOCK_H_
@@ -18,6 +18,7 @@
 #define CHRE_PLATFORM_LINUX_CONDITION_VARIABLE_IMPL_H_
 
 #include "chre/platform/condition_variable.h"
+#include "chre/platform/linux/virtual_clock.h"
 
 namespace chre {
 
@@ -26,17 +27,17 @@ inline ConditionVariable::ConditionVariable() {}
 inline ConditionVariable::~ConditionVariable() {}
 
 inline void ConditionVariable::notify_one() {
-  mConditionVariable.notify_one();
+  platform_linux::notifyConditionVariable(mConditionVariable,
+                                          /* notifyAll= */ false);
 }
 
 inline void ConditionVariable::wait(Mutex &mutex) {
-  mConditionVariable.wait(mutex);
+  platform_linux::waitOnConditionVariable(mConditionVariable, mutex);
 }
 
 inline bool ConditionVariable::wait_for(Mutex &mutex, Nanoseconds timeout) {
-  std::cv_status result = mConditionVariable.wait_for(
-      mutex, std::chrono::nanoseconds(timeout.toRawNanoseconds()));
-  return (result != std::cv_status::timeout);
+  return platform_linux::waitOnConditionVariableFor(mConditionVariable, mutex,
+                                                    timeout);
 }
 
 }  // namespace chre
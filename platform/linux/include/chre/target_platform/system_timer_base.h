@@ -20,12 +20,14 @@
 #include <signal.h>
 #include <time.h>
 #include <cinttypes>
+#include <mutex>
+#include <optional>
 
 namespace chre {
 
 /**
  * The Linux base class for the SystemTimer. The Linux implementation uses a
- * POSIX timer.
+ * POSIX timer, or a TaskManager task when the simulation runs in virtual time.
  */
 class SystemTimerBase {
  protected:
@@ -40,6 +42,24 @@ class SystemTimerBase {
 
   //! A utility function to set a POSIX timer.
   bool setInternal(uint64_t delayNs);
+
+  //! Protects the virtual time state below, accessed from the TaskManager
+  //! thread when the timer fires.
+  std::mutex mVirtualTimeMutex;
+
+  //! The TaskManager task firing the timer in virtual time, if armed.
+  std::optional<uint32_t> mVirtualTimeTaskId;
+
+  //! Incremented whenever the timer is set or cancelled in virtual time, so
+  //! that a task which is already firing can tell it is stale.
+  uint32_t mVirtualTimeGeneration = 0;
+
+  //! The equivalent of setInternal() in virtual time. A delay of 0 disarms the
+  //! timer.
+  bool setVirtualTimeInternal(uint64_t delayNs);
+
+  //! Invoked by the TaskManager task of the given generation.
+  void onVirtualTimeTaskFired(uint32_t generation);
 };
 
 }  // namespace chre
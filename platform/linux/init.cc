@@ -33,7 +33,10 @@
 
 #include <tclap/CmdLine.h>
 #include <csignal>
+#include <functional>
+#include <string>
 #include <thread>
+#include <vector>
 
 using chre::EventLoopManagerSingleton;
 using chre::Milliseconds;
@@ -54,6 +57,26 @@ extern "C" void signalHandler(int sig) {
   EventLoopManagerSingleton::get()->getEventLoop().stop();
 }
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+/**
+ * Loads the given nanoapps in a worker event loop and runs it. Must be invoked
+ * from the thread dedicated to that event loop.
+ *
+ * @param eventLoop The worker event loop to run.
+ * @param nanoappPaths The nanoapp shared objects pinned to the event loop.
+ */
+void runWorkerEventLoop(chre::EventLoop &eventLoop,
+                        const std::vector<std::string> &nanoappPaths) {
+  for (const auto &nanoappPath : nanoappPaths) {
+    auto nanoapp = chre::MakeUnique<chre::Nanoapp>();
+    nanoapp->loadFromFile(nanoappPath);
+    eventLoop.startNanoapp(nanoapp);
+  }
+
+  eventLoop.run();
+}
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 }  // namespace
 
 int main(int argc, char **argv) {
@@ -66,6 +89,13 @@ int main(int argc, char **argv) {
     TCLAP::MultiArg<std::string> nanoappsArg(
         "", "nanoapp", "nanoapp shared object to load and execute", false,
         "path", cmd);
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+    TCLAP::MultiArg<std::string> workerNanoappsArg(
+        "", "worker_nanoapp",
+        "nanoapp shared object to load and execute in a worker event loop, "
+        "assigned to the worker event loops in a round-robin fashion",
+        false, "path", cmd);
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
 #ifdef CHRE_AUDIO_SUPPORT_ENABLED
     TCLAP::ValueArg<std::string> audioFileArg(
         "", "audio_file", "WAV file to open for audio simulation", false, "",
@@ -124,8 +154,34 @@ int main(int argc, char **argv) {
 
       EventLoopManagerSingleton::get()->getEventLoop().run();
     });
+
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+    // Pin the worker nanoapps to their event loop, each run by its own thread.
+    std::vector<std::string> workerNanoappPaths[CHRE_NUM_WORKER_EVENT_LOOPS];
+    for (size_t i = 0; i < workerNanoappsArg.getValue().size(); i++) {
+      workerNanoappPaths[i % CHRE_NUM_WORKER_EVENT_LOOPS].push_back(
+          workerNanoappsArg.getValue()[i]);
+    }
+
+    std::vector<std::thread> workerThreads;
+    for (size_t i = 0; i < CHRE_NUM_WORKER_EVENT_LOOPS; i++) {
+      chre::EventLoop &eventLoop =
+          EventLoopManagerSingleton::get()->getEventLoopByIndex(i + 1);
+      workerThreads.emplace_back(runWorkerEventLoop, std::ref(eventLoop),
+                                 std::cref(workerNanoappPaths[i]));
+    }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
     chreThread.join();
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+    // The worker event loops are stopped once the system event loop exits.
+    for (size_t i = 0; i < CHRE_NUM_WORKER_EVENT_LOOPS; i++) {
+      EventLoopManagerSingleton::get()->getEventLoopByIndex(i + 1).stop();
+      workerThreads[i].join();
+    }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
     chre::TaskManagerSingleton::deinit();
     chre::deinit();
     chre::PlatformLogSingleton::deinit();
@@ -16,6 +16,7 @@
 
 #include "chre/pal/sensor.h"
 
+#include "chre/platform/linux/pal_sensor_replay.h"
 #include "chre/platform/linux/task_util/task_manager.h"
 #include "chre/platform/memory.h"
 #include "chre/util/macros.h"
@@ -183,6 +184,10 @@ bool chrePalSensorIsSensor0Enabled() {
 }
 
 const chrePalSensorApi *chrePalSensorGetApi(uint32_t requestedApiVersion) {
+  if (chrePalSensorIsReplayTraceLoaded()) {
+    return chrePalSensorReplayGetApi(requestedApiVersion);
+  }
+
   static const struct chrePalSensorApi kApi = {
       .moduleVersion = CHRE_PAL_SENSOR_API_CURRENT_VERSION,
       .open = chrePalSensorApiOpen,
@@ -0,0 +1,694 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/platform/linux/pal_sensor_replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "chre/platform/linux/task_util/task_manager.h"
+#include "chre/platform/log.h"
+#include "chre/platform/memory.h"
+#include "chre/util/macros.h"
+#include "chre/util/memory.h"
+#include "chre/util/unique_ptr.h"
+
+/**
+ * An implementation of the Sensor PAL replaying a recorded trace.
+ */
+namespace {
+
+using ::chre::TaskManagerSingleton;
+
+//! The maximum number of samples in a data event, like a hardware FIFO.
+constexpr size_t kMaxSamplesPerEvent = 256;
+
+enum class SampleFormat {
+  THREE_AXIS,
+  FLOAT,
+};
+
+struct SensorTypeName {
+  const char *name;
+  uint8_t sensorType;
+  SampleFormat format;
+};
+
+constexpr SensorTypeName kSensorTypeNames[] = {
+    {"accel", CHRE_SENSOR_TYPE_ACCELEROMETER, SampleFormat::THREE_AXIS},
+    {"gyro", CHRE_SENSOR_TYPE_GYROSCOPE, SampleFormat::THREE_AXIS},
+    {"mag", CHRE_SENSOR_TYPE_GEOMAGNETIC_FIELD, SampleFormat::THREE_AXIS},
+    {"uncal_accel", CHRE_SENSOR_TYPE_UNCALIBRATED_ACCELEROMETER,
+     SampleFormat::THREE_AXIS},
+    {"uncal_gyro", CHRE_SENSOR_TYPE_UNCALIBRATED_GYROSCOPE,
+     SampleFormat::THREE_AXIS},
+    {"uncal_mag", CHRE_SENSOR_TYPE_UNCALIBRATED_GEOMAGNETIC_FIELD,
+     SampleFormat::THREE_AXIS},
+    {"baro", CHRE_SENSOR_TYPE_PRESSURE, SampleFormat::FLOAT},
+    {"light", CHRE_SENSOR_TYPE_LIGHT, SampleFormat::FLOAT},
+};
+
+struct Sample {
+  uint64_t timestampNs;
+  float values[3];
+};
+
+struct ReplaySensor {
+  std::string name;
+  uint8_t sensorType;
+  SampleFormat format;
+  uint64_t minIntervalNs;
+  std::vector<Sample> samples;
+
+  //! The playback state, only valid while enabled.
+  bool isEnabled = false;
+  uint64_t intervalNs = 0;
+  uint64_t latencyNs = 0;
+
+  //! The index of the next sample to consider for a batch.
+  size_t nextSample = 0;
+
+  //! The timestamp of the last sample put in a batch, to decimate the trace.
+  std::optional<uint64_t> lastBatchedTimestampNs;
+
+  //! The indices of the samples of the batch waiting to be delivered.
+  std::vector<size_t> batch;
+
+  //! Incremented to invalidate the scheduled playback task.
+  uint32_t generation = 0;
+
+  //! The event delivered to CHRE and not released yet, when replaying as fast
+  //! as possible.
+  void *inFlightEvent = nullptr;
+};
+
+const struct chrePalSystemApi *gSystemApi = nullptr;
+const struct chrePalSensorCallbacks *gCallbacks = nullptr;
+
+//! Protects the playback state, which is accessed from the CHRE thread and the
+//! TaskManager thread.
+std::mutex gMutex;
+
+std::vector<ReplaySensor> gSensors;
+std::vector<struct chreSensorInfo> gSensorInfos;
+float gSpeed = 1.0f;
+uint64_t gTraceStartNs = 0;
+
+//! The CHRE time at which playback started.
+std::optional<uint64_t> gPlaybackStartNs;
+
+uint32_t gNextFlushRequestId = 0;
+std::atomic<uint64_t> gReplayedSampleCount(0);
+
+bool isReplayingAsFastAsPossible() {
+  return gSpeed == kPalSensorReplayAsFastAsPossible;
+}
+
+//! @return the CHRE timestamp of a sample of the trace.
+uint64_t getEventTimestamp(uint64_t traceTimestampNs) {
+  return *gPlaybackStartNs + (traceTimestampNs - gTraceStartNs);
+}
+
+//! @return the CHRE time at which a sample of the trace is due.
+uint64_t getDueTime(uint64_t traceTimestampNs) {
+  return *gPlaybackStartNs +
+         static_cast<uint64_t>(
+             static_cast<double>(traceTimestampNs - gTraceStartNs) / gSpeed);
+}
+
+//! @return the timestamp of the trace matching the current time.
+uint64_t getTracePosition() {
+  uint64_t elapsedNs = gSystemApi->getCurrentTime() - *gPlaybackStartNs;
+  return gTraceStartNs +
+         static_cast<uint64_t>(static_cast<double>(elapsedNs) * gSpeed);
+}
+
+/**
+ * Puts the next samples in a batch, skipping the ones closer than the
+ * requested interval to the previous one.
+ *
+ * @param maxTimestampNs The maximum trace timestamp of the samples to batch.
+ * @param ignoreLatency Whether to batch all the samples up to maxTimestampNs
+ *     rather than the ones within the requested latency of the first one.
+ */
+void selectBatchLocked(ReplaySensor &sensor, uint64_t maxTimestampNs,
+                       bool ignoreLatency) {
+  sensor.batch.clear();
+  // Tolerate a 10% jitter in the trace when decimating.
+  uint64_t minSpacingNs = sensor.intervalNs - sensor.intervalNs / 10;
+  uint64_t batchEndNs = maxTimestampNs;
+
+  for (; sensor.nextSample < sensor.samples.size(); sensor.nextSample++) {
+    uint64_t timestampNs = sensor.samples[sensor.nextSample].timestampNs;
+    if (timestampNs > batchEndNs ||
+        sensor.batch.size() == kMaxSamplesPerEvent) {
+      break;
+    }
+
+    if (sensor.lastBatchedTimestampNs.has_value()) {
+      uint64_t spacingNs = timestampNs - *sensor.lastBatchedTimestampNs;
+      if (spacingNs < minSpacingNs) {
+        continue;
+      }
+      // Readings store their offset to the previous one on 32 bits.
+      if (!sensor.batch.empty() && spacingNs > UINT32_MAX) {
+        break;
+      }
+    }
+
+    if (sensor.batch.empty() && !ignoreLatency) {
+      // Saturate as the latency can be CHRE_SENSOR_LATENCY_DEFAULT.
+      uint64_t latencyEndNs = (sensor.latencyNs > UINT64_MAX - timestampNs)
+                                  ? UINT64_MAX
+                                  : timestampNs + sensor.latencyNs;
+      batchEndNs = std::min(maxTimestampNs, latencyEndNs);
+    }
+    sensor.batch.push_back(sensor.nextSample);
+    sensor.lastBatchedTimestampNs = timestampNs;
+  }
+}
+
+void onPlaybackTaskFired(uint32_t sensorIndex, uint32_t generation);
+
+//! Schedules the delivery of the next batch of samples.
+void scheduleNextBatchLocked(uint32_t sensorIndex) {
+  ReplaySensor &sensor = gSensors[sensorIndex];
+  selectBatchLocked(sensor, UINT64_MAX, /* ignoreLatency= */ false);
+  if (sensor.batch.empty()) {
+    LOGI("Finished replaying sensor %s", sensor.name.c_str());
+    return;
+  }
+
+  uint64_t delayNs = 0;
+  if (!isReplayingAsFastAsPossible()) {
+    uint64_t dueTimeNs =
+        getDueTime(sensor.samples[sensor.batch.back()].timestampNs);
+    uint64_t now = gSystemApi->getCurrentTime();
+    delayNs = (dueTimeNs > now) ? dueTimeNs - now : 0;
+  }
+
+  uint32_t generation = sensor.generation;
+  std::optional<uint32_t> taskId = TaskManagerSingleton::get()->addTask(
+      [sensorIndex, generation]() {
+        onPlaybackTaskFired(sensorIndex, generation);
+      },
+      std::chrono::nanoseconds(delayNs), /* isOneShot= */ true);
+  if (!taskId.has_value()) {
+    LOGE("Failed to schedule the replay of sensor %s", sensor.name.c_str());
+  }
+}
+
+/**
+ * Stops the playback of a sensor. The samples of the pending batch will be
+ * considered again when the playback resumes.
+ */
+void cancelPlaybackLocked(ReplaySensor &sensor) {
+  sensor.generation++;
+  sensor.inFlightEvent = nullptr;
+  if (!sensor.batch.empty()) {
+    sensor.nextSample = sensor.batch.front();
+    sensor.batch.clear();
+    sensor.lastBatchedTimestampNs.reset();
+  }
+}
+
+/**
+ * Builds the data event of the pending batch of a sensor.
+ *
+ * @return The event, or nullptr if out of memory.
+ */
+void *createBatchEventLocked(uint32_t sensorIndex) {
+  ReplaySensor &sensor = gSensors[sensorIndex];
+  size_t sampleSize =
+      (sensor.format == SampleFormat::THREE_AXIS)
+          ? sizeof(chreSensorThreeAxisData::chreSensorThreeAxisSampleData)
+          : sizeof(chreSensorFloatData::chreSensorFloatSampleData);
+  size_t size =
+      sizeof(struct chreSensorDataHeader) + sensor.batch.size() * sampleSize;
+  auto *header =
+      static_cast<struct chreSensorDataHeader *>(chre::memoryAlloc(size));
+  if (header == nullptr) {
+    LOG_OOM();
+    return nullptr;
+  }
+  memset(header, 0, size);
+
+  uint64_t previousTimestampNs =
+      getEventTimestamp(sensor.samples[sensor.batch.front()].timestampNs);
+  header->baseTimestamp = previousTimestampNs;
+  header->sensorHandle = sensorIndex;
+  header->readingCount = static_cast<uint16_t>(sensor.batch.size());
+  header->accuracy = CHRE_SENSOR_ACCURACY_HIGH;
+
+  for (size_t i = 0; i < sensor.batch.size(); i++) {
+    const Sample &sample = sensor.samples[sensor.batch[i]];
+    uint64_t timestampNs = getEventTimestamp(sample.timestampNs);
+    auto timestampDelta =
+        static_cast<uint32_t>(timestampNs - previousTimestampNs);
+    previousTimestampNs = timestampNs;
+
+    if (sensor.format == SampleFormat::THREE_AXIS) {
+      auto &reading =
+          reinterpret_cast<chreSensorThreeAxisData *>(header)->readings[i];
+      reading.timestampDelta = timestampDelta;
+      memcpy(reading.values, sample.values, sizeof(reading.values));
+    } else {
+      auto &reading =
+          reinterpret_cast<chreSensorFloatData *>(header)->readings[i];
+      reading.timestampDelta = timestampDelta;
+      reading.value = sample.values[0];
+    }
+  }
+
+  gReplayedSampleCount += sensor.batch.size();
+  sensor.batch.clear();
+  return header;
+}
+
+void onPlaybackTaskFired(uint32_t sensorIndex, uint32_t generation) {
+  void *event = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    // The trace may have been cleared since the task was scheduled.
+    if (sensorIndex >= gSensors.size() ||
+        !gSensors[sensorIndex].isEnabled ||
+        gSensors[sensorIndex].generation != generation) {
+      return;
+    }
+
+    event = createBatchEventLocked(sensorIndex);
+    if (isReplayingAsFastAsPossible() && event != nullptr) {
+      // The next batch is scheduled when CHRE releases this one.
+      gSensors[sensorIndex].inFlightEvent = event;
+    } else {
+      scheduleNextBatchLocked(sensorIndex);
+    }
+  }
+
+  // Called without holding the lock, as CHRE may release the event right away.
+  if (event != nullptr) {
+    gCallbacks->dataEventCallback(sensorIndex, event);
+  }
+}
+
+void sendStatusUpdate(uint32_t sensorIndex, uint64_t intervalNs,
+                      uint64_t latencyNs, bool enabled) {
+  auto status = chre::MakeUniqueZeroFill<struct chreSensorSamplingStatus>();
+  if (status.isNull()) {
+    LOG_OOM();
+    return;
+  }
+  status->interval = intervalNs;
+  status->latency = latencyNs;
+  status->enabled = enabled;
+  gCallbacks->samplingStatusUpdateCallback(sensorIndex, status.release());
+}
+
+void chrePalSensorReplayApiClose() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  for (ReplaySensor &sensor : gSensors) {
+    cancelPlaybackLocked(sensor);
+    sensor.isEnabled = false;
+  }
+}
+
+bool chrePalSensorReplayApiOpen(
+    const struct chrePalSystemApi *systemApi,
+    const struct chrePalSensorCallbacks *callbacks) {
+  chrePalSensorReplayApiClose();
+
+  bool success = false;
+  if (systemApi != nullptr && callbacks != nullptr) {
+    gSystemApi = systemApi;
+    gCallbacks = callbacks;
+    success = true;
+  }
+
+  return success;
+}
+
+bool chrePalSensorReplayApiGetSensors(const struct chreSensorInfo **sensors,
+                                      uint32_t *arraySize) {
+  if (sensors != nullptr) {
+    *sensors = gSensorInfos.data();
+  }
+  if (arraySize != nullptr) {
+    *arraySize = static_cast<uint32_t>(gSensorInfos.size());
+  }
+  return true;
+}
+
+bool chrePalSensorReplayApiConfigureSensor(uint32_t sensorInfoIndex,
+                                           enum chreSensorConfigureMode mode,
+                                           uint64_t intervalNs,
+                                           uint64_t latencyNs) {
+  if (sensorInfoIndex >= gSensors.size()) {
+    return false;
+  }
+
+  bool enable;
+  switch (mode) {
+    case CHRE_SENSOR_CONFIGURE_MODE_CONTINUOUS:
+    case CHRE_SENSOR_CONFIGURE_MODE_PASSIVE_CONTINUOUS:
+      enable = true;
+      break;
+    case CHRE_SENSOR_CONFIGURE_MODE_DONE:
+      enable = false;
+      break;
+    default:
+      return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    ReplaySensor &sensor = gSensors[sensorInfoIndex];
+    cancelPlaybackLocked(sensor);
+    sensor.isEnabled = enable;
+    if (enable) {
+      // Without a preference, sample at the fastest rate of the trace.
+      sensor.intervalNs = (intervalNs == CHRE_SENSOR_INTERVAL_DEFAULT)
+                              ? sensor.minIntervalNs
+                              : std::max(intervalNs, sensor.minIntervalNs);
+      sensor.latencyNs = latencyNs;
+
+      if (!gPlaybackStartNs.has_value()) {
+        gPlaybackStartNs = gSystemApi->getCurrentTime();
+      }
+      if (!isReplayingAsFastAsPossible()) {
+        // Like hardware, the samples recorded while disabled are lost.
+        uint64_t positionNs = getTracePosition();
+        auto next = std::lower_bound(
+            sensor.samples.begin() + sensor.nextSample, sensor.samples.end(),
+            positionNs, [](const Sample &sample, uint64_t timestampNs) {
+              return sample.timestampNs < timestampNs;
+            });
+        sensor.nextSample = next - sensor.samples.begin();
+      }
+      scheduleNextBatchLocked(sensorInfoIndex);
+    }
+  }
+
+  sendStatusUpdate(sensorInfoIndex, intervalNs, latencyNs, enable);
+  return true;
+}
+
+void onFlushTaskFired(uint32_t sensorIndex, uint32_t flushRequestId) {
+  void *event = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (sensorIndex >= gSensors.size()) {
+      return;
+    }
+
+    ReplaySensor &sensor = gSensors[sensorIndex];
+    if (sensor.isEnabled && !isReplayingAsFastAsPossible()) {
+      // Deliver the samples that are due now, ignoring the latency.
+      cancelPlaybackLocked(sensor);
+      selectBatchLocked(sensor, getTracePosition(), /* ignoreLatency= */ true);
+      if (!sensor.batch.empty()) {
+        event = createBatchEventLocked(sensorIndex);
+      }
+      scheduleNextBatchLocked(sensorIndex);
+    }
+  }
+
+  if (event != nullptr) {
+    gCallbacks->dataEventCallback(sensorIndex, event);
+  }
+  gCallbacks->flushCompleteCallback(sensorIndex, flushRequestId,
+                                    CHRE_ERROR_NONE);
+}
+
+bool chrePalSensorReplayApiFlush(uint32_t sensorInfoIndex,
+                                 uint32_t *flushRequestId) {
+  if (sensorInfoIndex >= gSensors.size() || flushRequestId == nullptr) {
+    return false;
+  }
+
+  uint32_t requestId;
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    requestId = gNextFlushRequestId++;
+  }
+  *flushRequestId = requestId;
+
+  // The flush completes asynchronously, as it would with hardware.
+  return TaskManagerSingleton::get()
+      ->addTask([sensorInfoIndex, requestId]() {
+        onFlushTaskFired(sensorInfoIndex, requestId);
+      })
+      .has_value();
+}
+
+bool chrePalSensorReplayApiConfigureBiasEvents(uint32_t sensorInfoIndex,
+                                               bool enable,
+                                               uint64_t latencyNs) {
+  UNUSED_VAR(enable);
+  UNUSED_VAR(latencyNs);
+  // Traces only hold calibrated samples, so no bias event is ever generated.
+  return sensorInfoIndex < gSensors.size();
+}
+
+bool chrePalSensorReplayApiGetThreeAxisBias(
+    uint32_t sensorInfoIndex, struct chreSensorThreeAxisData *bias) {
+  UNUSED_VAR(sensorInfoIndex);
+  UNUSED_VAR(bias);
+  return false;
+}
+
+void chrePalSensorReplayApiReleaseSensorDataEvent(void *data) {
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    uint32_t sensorIndex =
+        static_cast<struct chreSensorDataHeader *>(data)->sensorHandle;
+    if (sensorIndex < gSensors.size() &&
+        gSensors[sensorIndex].inFlightEvent == data) {
+      gSensors[sensorIndex].inFlightEvent = nullptr;
+      scheduleNextBatchLocked(sensorIndex);
+    }
+  }
+
+  chre::memoryFree(data);
+}
+
+void chrePalSensorReplayApiReleaseSamplingStatusEvent(
+    struct chreSensorSamplingStatus *status) {
+  chre::memoryFree(status);
+}
+
+void chrePalSensorReplayApiReleaseBiasEvent(void *bias) {
+  chre::memoryFree(bias);
+}
+
+const SensorTypeName *findSensorType(const std::string &name) {
+  for (const SensorTypeName &typeName : kSensorTypeNames) {
+    if (name == typeName.name) {
+      return &typeName;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * Parses a line declaring a sensor, after the "sensor" keyword.
+ */
+bool parseSensorLine(std::istringstream &stream,
+                     std::vector<ReplaySensor> &sensors) {
+  uint32_t index;
+  std::string typeName;
+  ReplaySensor sensor;
+  if (!(stream >> index >> typeName >> sensor.minIntervalNs)) {
+    return false;
+  }
+  if (index != sensors.size()) {
+    LOGE("Sensor %" PRIu32 " is not declared in order", index);
+    return false;
+  }
+
+  const SensorTypeName *type = findSensorType(typeName);
+  if (type == nullptr) {
+    LOGE("Unsupported sensor type %s", typeName.c_str());
+    return false;
+  }
+  sensor.sensorType = type->sensorType;
+  sensor.format = type->format;
+
+  std::getline(stream >> std::ws, sensor.name);
+  if (sensor.name.empty()) {
+    sensor.name = typeName;
+  }
+
+  sensors.push_back(std::move(sensor));
+  return true;
+}
+
+bool parseSampleLine(std::istringstream &stream,
+                     std::vector<ReplaySensor> &sensors) {
+  Sample sample = {};
+  uint32_t index;
+  if (!(stream >> sample.timestampNs >> index)) {
+    return false;
+  }
+  if (index >= sensors.size()) {
+    LOGE("Sample for undeclared sensor %" PRIu32, index);
+    return false;
+  }
+
+  ReplaySensor &sensor = sensors[index];
+  size_t valueCount = (sensor.format == SampleFormat::THREE_AXIS) ? 3 : 1;
+  for (size_t i = 0; i < valueCount; i++) {
+    if (!(stream >> sample.values[i])) {
+      return false;
+    }
+  }
+  std::string extra;
+  if (stream >> extra) {
+    return false;
+  }
+
+  if (!sensor.samples.empty() &&
+      sample.timestampNs < sensor.samples.back().timestampNs) {
+    LOGE("Samples of sensor %s are not sorted", sensor.name.c_str());
+    return false;
+  }
+  sensor.samples.push_back(sample);
+  return true;
+}
+
+bool parseTrace(std::ifstream &file, std::vector<ReplaySensor> &sensors) {
+  std::string line;
+  for (size_t lineNumber = 1; std::getline(file, line); lineNumber++) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream stream(line);
+    std::string first;
+    if (!(stream >> first)) {
+      continue;
+    }
+
+    bool success;
+    if (first == "sensor") {
+      success = parseSensorLine(stream, sensors);
+    } else {
+      stream.seekg(0);
+      success = parseSampleLine(stream, sensors);
+    }
+    if (!success) {
+      LOGE("Invalid sensor trace at line %zu", lineNumber);
+      return false;
+    }
+  }
+
+  if (sensors.empty()) {
+    LOGE("Sensor trace has no sensor");
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool chrePalSensorLoadReplayTrace(const char *path, float speed) {
+  if (speed < 0.0f) {
+    LOGE("Invalid replay speed %f", speed);
+    return false;
+  }
+
+  std::ifstream file(path);
+  if (!file) {
+    LOGE("Failed to open sensor trace %s", path);
+    return false;
+  }
+
+  std::vector<ReplaySensor> sensors;
+  if (!parseTrace(file, sensors)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(gMutex);
+  gSensors = std::move(sensors);
+  gSensorInfos.clear();
+  gTraceStartNs = UINT64_MAX;
+  for (const ReplaySensor &sensor : gSensors) {
+    struct chreSensorInfo info = {};
+    info.sensorName = sensor.name.c_str();
+    info.sensorType = sensor.sensorType;
+    info.minInterval = sensor.minIntervalNs;
+    info.sensorIndex = CHRE_SENSOR_INDEX_DEFAULT;
+    gSensorInfos.push_back(info);
+
+    if (!sensor.samples.empty()) {
+      gTraceStartNs =
+          std::min(gTraceStartNs, sensor.samples.front().timestampNs);
+    }
+  }
+  gSpeed = speed;
+  gPlaybackStartNs.reset();
+  gReplayedSampleCount = 0;
+
+  LOGI("Loaded sensor trace %s with %zu sensors", path, gSensors.size());
+  return true;
+}
+
+void chrePalSensorClearReplayTrace() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  gSensors.clear();
+  gSensorInfos.clear();
+  gPlaybackStartNs.reset();
+}
+
+bool chrePalSensorIsReplayTraceLoaded() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  return !gSensors.empty();
+}
+
+uint64_t chrePalSensorGetReplayedSampleCount() {
+  return gReplayedSampleCount;
+}
+
+const struct chrePalSensorApi *chrePalSensorReplayGetApi(
+    uint32_t requestedApiVersion) {
+  static const struct chrePalSensorApi kApi = {
+      .moduleVersion = CHRE_PAL_SENSOR_API_CURRENT_VERSION,
+      .open = chrePalSensorReplayApiOpen,
+      .close = chrePalSensorReplayApiClose,
+      .getSensors = chrePalSensorReplayApiGetSensors,
+      .configureSensor = chrePalSensorReplayApiConfigureSensor,
+      .flush = chrePalSensorReplayApiFlush,
+      .configureBiasEvents = chrePalSensorReplayApiConfigureBiasEvents,
+      .getThreeAxisBias = chrePalSensorReplayApiGetThreeAxisBias,
+      .releaseSensorDataEvent = chrePalSensorReplayApiReleaseSensorDataEvent,
+      .releaseSamplingStatusEvent =
+          chrePalSensorReplayApiReleaseSamplingStatusEvent,
+      .releaseBiasEvent = chrePalSensorReplayApiReleaseBiasEvent,
+  };
+
+  if (!CHRE_PAL_VERSIONS_ARE_COMPATIBLE(kApi.moduleVersion,
+                                        requestedApiVersion)) {
+    return nullptr;
+  } else {
+    return &kApi;
+  }
+}
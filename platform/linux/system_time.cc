@@ -21,6 +21,7 @@
 #include <ctime>
 
 #include "chre/platform/assert.h"
+#include "chre/platform/linux/virtual_clock.h"
 #include "chre/util/optional.h"
 
 namespace chre {
@@ -34,6 +35,9 @@ Nanoseconds SystemTime::getMonotonicTime() {
   if (gTimeOverride.has_value()) {
     return gTimeOverride.value();
   }
+  if (platform_linux::isVirtualTimeEnabled()) {
+    return platform_linux::getVirtualTime();
+  }
 
   struct timespec timeNow;
   if (clock_gettime(CLOCK_MONOTONIC, &timeNow)) {
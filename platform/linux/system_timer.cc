@@ -16,6 +16,8 @@
 
 #include "chre/platform/system_timer.h"
 
+#include "chre/platform/linux/task_util/task_manager.h"
+#include "chre/platform/linux/virtual_clock.h"
 #include "chre/platform/log.h"
 #include "chre/util/time.h"
 
@@ -45,6 +47,9 @@ void SystemTimerBase::systemTimerNotifyCallback(union sigval cookie) {
 SystemTimer::SystemTimer() {}
 
 SystemTimer::~SystemTimer() {
+  if (mVirtualTimeTaskId.has_value()) {
+    setVirtualTimeInternal(0);
+  }
   if (mInitialized) {
     int ret = timer_delete(mTimerId);
     if (ret != 0) {
@@ -86,7 +91,9 @@ bool SystemTimer::set(SystemTimerCallback *callback, void *data,
   if (mInitialized) {
     mCallback = callback;
     mData = data;
-    return setInternal(delay.toRawNanoseconds());
+    return platform_linux::isVirtualTimeEnabled()
+               ? setVirtualTimeInternal(delay.toRawNanoseconds())
+               : setInternal(delay.toRawNanoseconds());
   } else {
     return false;
   }
@@ -95,7 +102,8 @@ bool SystemTimer::set(SystemTimerCallback *callback, void *data,
 bool SystemTimer::cancel() {
   if (mInitialized) {
     // Setting delay to 0 disarms the timer.
-    return setInternal(0);
+    return platform_linux::isVirtualTimeEnabled() ? setVirtualTimeInternal(0)
+                                                  : setInternal(0);
   } else {
     return false;
   }
@@ -103,7 +111,10 @@ bool SystemTimer::cancel() {
 
 bool SystemTimer::isActive() {
   bool isActive = false;
-  if (mInitialized) {
+  if (platform_linux::isVirtualTimeEnabled()) {
+    std::lock_guard<std::mutex> lock(mVirtualTimeMutex);
+    isActive = mVirtualTimeTaskId.has_value();
+  } else if (mInitialized) {
     struct itimerspec spec = {};
     int ret = timer_gettime(mTimerId, &spec);
     if (ret != 0) {
@@ -134,4 +145,40 @@ bool SystemTimerBase::setInternal(uint64_t delayNs) {
   return success;
 }
 
+bool SystemTimerBase::setVirtualTimeInternal(uint64_t delayNs) {
+  std::lock_guard<std::mutex> lock(mVirtualTimeMutex);
+  uint32_t generation = ++mVirtualTimeGeneration;
+  if (mVirtualTimeTaskId.has_value()) {
+    TaskManagerSingleton::get()->cancelTask(mVirtualTimeTaskId.value());
+    mVirtualTimeTaskId.reset();
+  }
+
+  bool success = true;
+  if (delayNs > 0) {
+    mVirtualTimeTaskId = TaskManagerSingleton::get()->addTask(
+        [this, generation]() { onVirtualTimeTaskFired(generation); },
+        std::chrono::nanoseconds(delayNs), /* isOneShot= */ true);
+    success = mVirtualTimeTaskId.has_value();
+    if (!success) {
+      LOGE("Couldn't set virtual time timer");
+    }
+  }
+  return success;
+}
+
+void SystemTimerBase::onVirtualTimeTaskFired(uint32_t generation) {
+  {
+    std::lock_guard<std::mutex> lock(mVirtualTimeMutex);
+    if (generation != mVirtualTimeGeneration ||
+        !mVirtualTimeTaskId.has_value()) {
+      return;
+    }
+    mVirtualTimeTaskId.reset();
+  }
+
+  union sigval cookie;
+  cookie.sival_ptr = static_cast<SystemTimer *>(this);
+  systemTimerNotifyCallback(cookie);
+}
+
 }  // namespace chre
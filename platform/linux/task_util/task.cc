@@ -16,12 +16,14 @@
 
 #include "chre/platform/linux/task_util/task.h"
 
+#include "chre/platform/linux/virtual_clock.h"
+
 namespace chre {
 namespace task_manager_internal {
 
 Task::Task(const TaskFunction &func, std::chrono::nanoseconds intervalOrDelay,
            uint32_t id, bool isOneShot)
-    : mExecutionTimestamp(std::chrono::steady_clock::now() + intervalOrDelay),
+    : mExecutionTimestamp(getCurrentTime() + intervalOrDelay),
       mRepeatInterval(isOneShot ? std::chrono::nanoseconds(0)
                                 : intervalOrDelay),
       mFunc(func),
@@ -52,6 +54,15 @@ Task &Task::operator=(const Task &rhs) {
   return *this;
 }
 
+std::chrono::time_point<std::chrono::steady_clock> Task::getCurrentTime() {
+  if (platform_linux::isVirtualTimeEnabled()) {
+    return std::chrono::time_point<std::chrono::steady_clock>(
+        std::chrono::nanoseconds(
+            platform_linux::getVirtualTime().toRawNanoseconds()));
+  }
+  return std::chrono::steady_clock::now();
+}
+
 void Task::cancel() {
   std::lock_guard lock(mExecutionMutex);
   mRepeatInterval = std::chrono::nanoseconds(0);
@@ -71,7 +82,7 @@ void Task::execute() {
   func();
   mHasExecuted = true;
   if (isRepeating()) {
-    mExecutionTimestamp = std::chrono::steady_clock::now() + mRepeatInterval;
+    mExecutionTimestamp = getCurrentTime() + mRepeatInterval;
   }
 }
 
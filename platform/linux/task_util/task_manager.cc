@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "chre/platform/linux/task_util/task_manager.h"
+#include "chre/platform/linux/virtual_clock.h"
 
 namespace chre {
 
@@ -28,7 +29,7 @@ TaskManager::TaskManager()
       mCurrentTask(nullptr),
       mContinueRunningThread(true),
       mCurrentId(0) {
-  mThread = std::thread(&TaskManager::run, this);
+  mThread = platform_linux::startVirtualTimeThread([this]() { run(); });
 }
 
 TaskManager::~TaskManager() {
@@ -55,7 +56,8 @@ std::optional<uint32_t> TaskManager::addTask(
   }
 
   if (success) {
-    mConditionVariable.notify_all();
+    platform_linux::notifyConditionVariable(mConditionVariable,
+                                            /* notifyAll= */ true);
     return returnId;
   }
   return std::optional<uint32_t>();
@@ -105,7 +107,8 @@ void TaskManager::flushAndStop() {
     mContinueRunningThread = false;
   }
 
-  mConditionVariable.notify_all();
+  platform_linux::notifyConditionVariable(mConditionVariable,
+                                          /* notifyAll= */ true);
   if (mThread.joinable()) {
     mThread.join();
   }
@@ -116,19 +119,23 @@ void TaskManager::run() {
     Task task;
     {
       std::unique_lock<std::mutex> lock(mMutex);
-      mConditionVariable.wait(lock, [this]() {
-        return !mContinueRunningThread || !mQueue.empty();
-      });
+      while (mContinueRunningThread && mQueue.empty()) {
+        platform_linux::waitOnConditionVariable(mConditionVariable, lock);
+      }
       if (!mContinueRunningThread) {
         return;
       }
 
       task = mQueue.top();
       if (!task.isReadyToExecute()) {
-        auto waitTime =
-            task.getExecutionTimestamp() - std::chrono::steady_clock::now();
+        auto waitTime = task.getExecutionTimestamp() - Task::getCurrentTime();
         if (waitTime.count() > 0) {
-          mConditionVariable.wait_for(lock, waitTime);
+          platform_linux::waitOnConditionVariableFor(
+              mConditionVariable, lock,
+              Nanoseconds(static_cast<uint64_t>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      waitTime)
+                      .count())));
         }
 
         /**
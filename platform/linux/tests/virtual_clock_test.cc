@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+#include "gtest/gtest.h"
+
+#include "chre/platform/linux/task_util/task_manager.h"
+#include "chre/platform/linux/virtual_clock.h"
+#include "chre/platform/system_time.h"
+
+namespace chre::platform_linux {
+namespace {
+
+constexpr Seconds kOneHour(60 * 60);
+
+class VirtualClockTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    enableVirtualTime();
+    mThread.emplace();
+  }
+
+  void TearDown() override {
+    mThread.reset();
+    disableVirtualTime();
+  }
+
+  std::optional<VirtualTimeThread> mThread;
+};
+
+TEST_F(VirtualClockTest, SleepAdvancesTimeWithoutWaiting) {
+  auto realStart = std::chrono::steady_clock::now();
+  Nanoseconds start = SystemTime::getMonotonicTime();
+
+  sleepFor(kOneHour);
+
+  EXPECT_EQ(SystemTime::getMonotonicTime(), start + Nanoseconds(kOneHour));
+  EXPECT_LT(std::chrono::steady_clock::now() - realStart,
+            std::chrono::seconds(10));
+}
+
+TEST_F(VirtualClockTest, WaitTimesOutInVirtualTime) {
+  std::condition_variable_any conditionVariable;
+  std::mutex mutex;
+  std::unique_lock<std::mutex> lock(mutex);
+  Nanoseconds start = SystemTime::getMonotonicTime();
+
+  EXPECT_FALSE(waitOnConditionVariableFor(conditionVariable, lock, kOneHour));
+  EXPECT_EQ(SystemTime::getMonotonicTime(), start + Nanoseconds(kOneHour));
+}
+
+TEST_F(VirtualClockTest, DelayedTaskRunsAtItsDeadline) {
+  std::condition_variable_any conditionVariable;
+  std::mutex mutex;
+  std::optional<Nanoseconds> runTime;
+  TaskManager taskManager;
+
+  Nanoseconds start = SystemTime::getMonotonicTime();
+  taskManager.addTask(
+      [&]() {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          runTime = SystemTime::getMonotonicTime();
+        }
+        notifyConditionVariable(conditionVariable, /* notifyAll= */ true);
+      },
+      std::chrono::hours(1), /* isOneShot= */ true);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!runTime.has_value()) {
+    waitOnConditionVariable(conditionVariable, lock);
+  }
+  EXPECT_EQ(*runTime, start + Nanoseconds(kOneHour));
+}
+
+}  // anonymous namespace
+}  // namespace chre::platform_linux
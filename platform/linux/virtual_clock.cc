@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/platform/linux/virtual_clock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <mutex>
+#include <vector>
+
+#include "chre/platform/log.h"
+
+namespace chre::platform_linux {
+namespace {
+
+using internal::VirtualTimeWaiter;
+
+//! Protects the state below, except for the atomics which can be read without
+//! holding it.
+std::mutex gMutex;
+
+std::atomic<bool> gIsEnabled(false);
+
+std::atomic<uint64_t> gVirtualTimeNs(0);
+
+//! The number of threads of the simulation that are not waiting.
+size_t gNumRunningThreads = 0;
+
+//! The threads of the simulation that are waiting.
+std::vector<VirtualTimeWaiter *> gWaiters;
+
+thread_local bool tIsVirtualTimeThread = false;
+
+uint64_t getRealMonotonicTimeNs() {
+  struct timespec timeNow = {};
+  clock_gettime(CLOCK_MONOTONIC, &timeNow);
+  return static_cast<uint64_t>(timeNow.tv_sec) * kOneSecondInNanoseconds +
+         static_cast<uint64_t>(timeNow.tv_nsec);
+}
+
+void wakeUpLocked(VirtualTimeWaiter *waiter, bool isTimedOut) {
+  waiter->isAwake = true;
+  waiter->isTimedOut = isTimedOut;
+  gNumRunningThreads++;
+}
+
+/**
+ * Advances time to the earliest deadline if no thread is running, and wakes up
+ * the threads whose deadline is reached.
+ */
+void advanceIfIdleLocked() {
+  if (gNumRunningThreads > 0) {
+    return;
+  }
+
+  uint64_t deadlineNs = UINT64_MAX;
+  for (const VirtualTimeWaiter *waiter : gWaiters) {
+    if (!waiter->isAwake) {
+      deadlineNs = std::min(deadlineNs, waiter->deadlineNs);
+    }
+  }
+
+  // With no deadline, every thread waits for another one: the simulation is
+  // stuck, which is left to the test timeout to report.
+  if (deadlineNs == UINT64_MAX) {
+    return;
+  }
+
+  if (deadlineNs > gVirtualTimeNs) {
+    gVirtualTimeNs = deadlineNs;
+  }
+  for (VirtualTimeWaiter *waiter : gWaiters) {
+    if (!waiter->isAwake && waiter->deadlineNs <= deadlineNs) {
+      wakeUpLocked(waiter, /* isTimedOut= */ true);
+      waiter->conditionVariable->notify_all();
+    }
+  }
+}
+
+}  // anonymous namespace
+
+void enableVirtualTime() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  gVirtualTimeNs = getRealMonotonicTimeNs();
+  gNumRunningThreads = 0;
+  gIsEnabled = true;
+}
+
+void disableVirtualTime() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  if (gNumRunningThreads != 0 || !gWaiters.empty()) {
+    LOGE("Disabling virtual time with %zu threads still running, %zu waiting",
+         gNumRunningThreads, gWaiters.size());
+  }
+  gIsEnabled = false;
+}
+
+bool isVirtualTimeEnabled() {
+  return gIsEnabled;
+}
+
+Nanoseconds getVirtualTime() {
+  return Nanoseconds(gVirtualTimeNs.load());
+}
+
+bool isVirtualTimeThread() {
+  return tIsVirtualTimeThread;
+}
+
+namespace internal {
+
+bool addVirtualTimeThread() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  if (gIsEnabled) {
+    gNumRunningThreads++;
+  }
+  return gIsEnabled;
+}
+
+void attachVirtualTimeThread() {
+  tIsVirtualTimeThread = true;
+}
+
+void removeVirtualTimeThread() {
+  std::lock_guard<std::mutex> lock(gMutex);
+  tIsVirtualTimeThread = false;
+  gNumRunningThreads--;
+  advanceIfIdleLocked();
+}
+
+void beginVirtualTimeWait(VirtualTimeWaiter &waiter) {
+  std::lock_guard<std::mutex> lock(gMutex);
+  gWaiters.push_back(&waiter);
+  gNumRunningThreads--;
+  advanceIfIdleLocked();
+}
+
+bool isVirtualTimeWaitOver(const VirtualTimeWaiter &waiter) {
+  std::lock_guard<std::mutex> lock(gMutex);
+  return waiter.isAwake;
+}
+
+bool endVirtualTimeWait(VirtualTimeWaiter &waiter) {
+  std::lock_guard<std::mutex> lock(gMutex);
+  gWaiters.erase(std::find(gWaiters.begin(), gWaiters.end(), &waiter));
+  return !waiter.isTimedOut;
+}
+
+}  // namespace internal
+
+void notifyConditionVariable(std::condition_variable_any &conditionVariable,
+                             bool notifyAll) {
+  if (!gIsEnabled) {
+    if (notifyAll) {
+      conditionVariable.notify_all();
+    } else {
+      conditionVariable.notify_one();
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(gMutex);
+    for (VirtualTimeWaiter *waiter : gWaiters) {
+      if (waiter->conditionVariable == &conditionVariable &&
+          !waiter->isAwake) {
+        wakeUpLocked(waiter, /* isTimedOut= */ false);
+        if (!notifyAll) {
+          break;
+        }
+      }
+    }
+  }
+
+  // The waiters not picked above go back to waiting, so notifying all of them
+  // keeps the semantics of notify_one() while making sure the picked one runs.
+  conditionVariable.notify_all();
+}
+
+void sleepFor(Nanoseconds duration) {
+  if (isVirtualTimeThread()) {
+    std::condition_variable_any conditionVariable;
+    std::mutex mutex;
+    std::unique_lock<std::mutex> lock(mutex);
+    internal::waitInVirtualTime(
+        conditionVariable, lock,
+        (getVirtualTime() + duration).toRawNanoseconds());
+  } else {
+    std::this_thread::sleep_for(
+        std::chrono::nanoseconds(duration.toRawNanoseconds()));
+  }
+}
+
+}  // namespace chre::platform_linux
@@ -96,6 +96,7 @@ SLPI_SRCS += platform/shared/assert.cc
 SLPI_SRCS += platform/shared/chre_api_audio.cc
 SLPI_SRCS += platform/shared/chre_api_core.cc
 SLPI_SRCS += platform/shared/chre_api_gnss.cc
+SLPI_SRCS += platform/shared/chre_api_inference.cc
 SLPI_SRCS += platform/shared/chre_api_re.cc
 SLPI_SRCS += platform/shared/chre_api_user_settings.cc
 SLPI_SRCS += platform/shared/chre_api_version.cc
@@ -213,10 +214,12 @@ SIM_SRCS += platform/linux/system_timer.cc
 SIM_SRCS += platform/linux/platform_nanoapp.cc
 SIM_SRCS += platform/linux/task_util/task.cc
 SIM_SRCS += platform/linux/task_util/task_manager.cc
+SIM_SRCS += platform/linux/virtual_clock.cc
 SIM_SRCS += platform/shared/chre_api_audio.cc
 SIM_SRCS += platform/shared/chre_api_ble.cc
 SIM_SRCS += platform/shared/chre_api_core.cc
 SIM_SRCS += platform/shared/chre_api_gnss.cc
+SIM_SRCS += platform/shared/chre_api_inference.cc
 SIM_SRCS += platform/shared/chre_api_re.cc
 SIM_SRCS += platform/shared/chre_api_sensor.cc
 SIM_SRCS += platform/shared/chre_api_user_settings.cc
@@ -251,6 +254,7 @@ endif
 ifeq ($(CHRE_SENSORS_SUPPORT_ENABLED), true)
 SIM_CFLAGS += -I$(CHRE_PREFIX)/platform/shared/sensor_pal/include
 SIM_SRCS += platform/linux/pal_sensor.cc
+SIM_SRCS += platform/linux/pal_sensor_replay.cc
 SIM_SRCS += platform/shared/sensor_pal/platform_sensor.cc
 SIM_SRCS += platform/shared/sensor_pal/platform_sensor_manager.cc
 SIM_SRCS += platform/shared/sensor_pal/platform_sensor_type_helpers.cc
@@ -281,6 +285,7 @@ GOOGLE_X86_LINUX_SRCS += platform/linux/init.cc
 GOOGLE_X86_LINUX_SRCS += platform/linux/assert.cc
 GOOGLE_X86_LINUX_SRCS += platform/linux/task_util/task.cc
 GOOGLE_X86_LINUX_SRCS += platform/linux/task_util/task_manager.cc
+GOOGLE_X86_LINUX_SRCS += platform/linux/virtual_clock.cc
 GOOGLE_X86_LINUX_SRCS += platform/shared/nanoapp_abort.cc
 
 # Optional audio support.
@@ -354,6 +359,7 @@ GOOGLETEST_COMMON_SRCS += platform/linux/sim/audio_source.cc
 GOOGLETEST_COMMON_SRCS += platform/linux/sim/platform_audio.cc
 GOOGLETEST_COMMON_SRCS += platform/linux/tests/task_test.cc
 GOOGLETEST_COMMON_SRCS += platform/linux/tests/task_manager_test.cc
+GOOGLETEST_COMMON_SRCS += platform/linux/tests/virtual_clock_test.cc
 GOOGLETEST_COMMON_SRCS += platform/tests/log_buffer_test.cc
 GOOGLETEST_COMMON_SRCS += platform/tests/trace_test.cc
 GOOGLETEST_COMMON_SRCS += platform/shared/log_buffer.cc
@@ -384,6 +390,7 @@ EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_audio.cc
 EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_ble.cc
 EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_core.cc
 EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_gnss.cc
+EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_inference.cc
 EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_re.cc
 EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_user_settings.cc
 EMBOS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_version.cc
@@ -471,6 +478,7 @@ TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_audio.cc
 TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_ble.cc
 TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_core.cc
 TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_gnss.cc
+TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_inference.cc
 TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_re.cc
 TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_user_settings.cc
 TINYSYS_SRCS += $(CHRE_PREFIX)/platform/shared/chre_api_version.cc
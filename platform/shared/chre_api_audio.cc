@@ -51,8 +51,9 @@ DLL_EXPORT bool chreAudioConfigureSource(uint32_t handle, bool enable,
                                          uint64_t bufferDuration,
                                          uint64_t deliveryInterval) {
 #ifdef CHRE_AUDIO_SUPPORT_ENABLED
-  Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_AUDIO) &&
+  Nanoapp *nanoapp = EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_AUDIO) &&
          EventLoopManagerSingleton::get()
              ->getAudioRequestManager()
              .configureSource(nanoapp, handle, enable, bufferDuration,
@@ -46,8 +46,10 @@ DLL_EXPORT uint32_t chreBleGetFilterCapabilities() {
 
 DLL_EXPORT bool chreBleFlushAsync(const void *cookie) {
 #ifdef CHRE_BLE_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
          EventLoopManagerSingleton::get()->getBleRequestManager().flushAsync(
              nanoapp, cookie);
 #else
@@ -60,8 +62,10 @@ DLL_EXPORT bool chreBleStartScanAsyncV1_9(
     chreBleScanMode mode, uint32_t reportDelayMs,
     const struct chreBleScanFilterV1_9 *filter, const void *cookie) {
 #ifdef CHRE_BLE_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
          EventLoopManagerSingleton::get()
              ->getBleRequestManager()
              .startScanAsync(nanoapp, mode, reportDelayMs, filter, cookie);
@@ -91,8 +95,10 @@ DLL_EXPORT bool chreBleStartScanAsync(chreBleScanMode mode,
 
 DLL_EXPORT bool chreBleStopScanAsyncV1_9(const void *cookie) {
 #ifdef CHRE_BLE_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
          EventLoopManagerSingleton::get()->getBleRequestManager().stopScanAsync(
              nanoapp, cookie);
 #else
@@ -108,8 +114,10 @@ DLL_EXPORT bool chreBleStopScanAsync() {
 DLL_EXPORT bool chreBleReadRssiAsync(uint16_t connectionHandle,
                                      const void *cookie) {
 #ifdef CHRE_BLE_READ_RSSI_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
          EventLoopManagerSingleton::get()->getBleRequestManager().readRssiAsync(
              nanoapp, connectionHandle, cookie);
 #else
@@ -121,8 +129,10 @@ DLL_EXPORT bool chreBleReadRssiAsync(uint16_t connectionHandle,
 
 DLL_EXPORT bool chreBleGetScanStatus(struct chreBleScanStatus *status) {
 #ifdef CHRE_BLE_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_BLE) &&
          EventLoopManagerSingleton::get()->getBleRequestManager().getScanStatus(
              status);
 #else
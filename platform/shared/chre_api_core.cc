@@ -57,7 +57,8 @@ bool sendMessageToHost(Nanoapp *nanoapp, void *message, size_t messageSize,
                        uint32_t messagePermissions,
                        chreMessageFreeFunction *freeCallback, bool isReliable,
                        const void *cookie) {
-  const EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
+  const EventLoop &eventLoop =
+      EventLoopManagerSingleton::get()->getCurrentEventLoop();
   bool success = false;
   if (eventLoop.currentNanoappIsStopping()) {
     LOGW("Rejecting message to host from app instance %" PRIu16
@@ -101,7 +102,8 @@ DLL_EXPORT bool chreSendEvent(uint16_t eventType, void *eventData,
   // Prevent an app that is in the process of being unloaded from generating new
   // events
   bool success = false;
-  EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
+  EventLoop &eventLoop =
+      EventLoopManagerSingleton::get()->getCurrentEventLoop();
   CHRE_ASSERT_LOG(targetInstanceId <= UINT16_MAX,
                   "Invalid instance ID %" PRIu32 " provided", targetInstanceId);
   if (eventLoop.currentNanoappIsStopping()) {
@@ -165,19 +167,16 @@ DLL_EXPORT bool chreSendMessageToHostEndpoint(
 
 DLL_EXPORT bool chreGetNanoappInfoByAppId(uint64_t appId,
                                           struct chreNanoappInfo *info) {
-  return EventLoopManagerSingleton::get()
-      ->getEventLoop()
-      .populateNanoappInfoForAppId(appId, info);
+  return EventLoopManagerSingleton::get()->populateNanoappInfoForAppId(appId,
+                                                                      info);
 }
 
 DLL_EXPORT bool chreGetNanoappInfoByInstanceId(uint32_t instanceId,
                                                struct chreNanoappInfo *info) {
   CHRE_ASSERT(instanceId <= UINT16_MAX);
   if (instanceId <= UINT16_MAX) {
-    return EventLoopManagerSingleton::get()
-        ->getEventLoop()
-        .populateNanoappInfoForInstanceId(static_cast<uint16_t>(instanceId),
-                                          info);
+    return EventLoopManagerSingleton::get()->populateNanoappInfoForInstanceId(
+        static_cast<uint16_t>(instanceId), info);
   }
   return false;
 }
@@ -41,8 +41,10 @@ DLL_EXPORT bool chreGnssLocationSessionStartAsync(
     [[maybe_unused]] uint32_t minTimeToNextFixMs,
     [[maybe_unused]] const void *cookie) {
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
          chre::EventLoopManagerSingleton::get()
              ->getGnssManager()
              .getLocationSession()
@@ -56,8 +58,10 @@ DLL_EXPORT bool chreGnssLocationSessionStartAsync(
 DLL_EXPORT bool chreGnssLocationSessionStopAsync(
     [[maybe_unused]] const void *cookie) {
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
          chre::EventLoopManagerSingleton::get()
              ->getGnssManager()
              .getLocationSession()
@@ -70,8 +74,10 @@ DLL_EXPORT bool chreGnssLocationSessionStopAsync(
 DLL_EXPORT bool chreGnssMeasurementSessionStartAsync(
     [[maybe_unused]] uint32_t minIntervalMs, [[maybe_unused]] const void *cookie) {
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
          chre::EventLoopManagerSingleton::get()
              ->getGnssManager()
              .getMeasurementSession()
@@ -85,8 +91,10 @@ DLL_EXPORT bool chreGnssMeasurementSessionStartAsync(
 DLL_EXPORT bool chreGnssMeasurementSessionStopAsync(
     [[maybe_unused]] const void *cookie) {
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
          chre::EventLoopManagerSingleton::get()
              ->getGnssManager()
              .getMeasurementSession()
@@ -99,8 +107,10 @@ DLL_EXPORT bool chreGnssMeasurementSessionStopAsync(
 DLL_EXPORT bool chreGnssConfigurePassiveLocationListener(
     [[maybe_unused]] bool enable) {
 #ifdef CHRE_GNSS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_GNSS) &&
          chre::EventLoopManagerSingleton::get()
              ->getGnssManager()
              .configurePassiveLocationListener(nanoapp, enable);
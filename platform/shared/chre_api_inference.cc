@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/platform/shared/chre_inference.h"
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/util/macros.h"
+
+using chre::EventLoopManager;
+using chre::EventLoopManagerSingleton;
+using chre::Nanoapp;
+
+DLL_EXPORT bool chreInferenceRegisterModel(const void *model, size_t modelSize,
+                                           size_t arenaSize,
+                                           uint32_t *modelHandle) {
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+  Nanoapp *nanoapp = EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         EventLoopManagerSingleton::get()->getInferenceManager().registerModel(
+             nanoapp, model, modelSize, arenaSize, modelHandle);
+#else
+  UNUSED_VAR(model);
+  UNUSED_VAR(modelSize);
+  UNUSED_VAR(arenaSize);
+  UNUSED_VAR(modelHandle);
+  return false;
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+}
+
+DLL_EXPORT bool chreInferenceUnregisterModel(uint32_t modelHandle) {
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+  Nanoapp *nanoapp = EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr && EventLoopManagerSingleton::get()
+                                    ->getInferenceManager()
+                                    .unregisterModel(nanoapp, modelHandle);
+#else
+  UNUSED_VAR(modelHandle);
+  return false;
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+}
+
+DLL_EXPORT bool chreInferenceRequest(uint32_t modelHandle, const void *input,
+                                     size_t inputSize, void *output,
+                                     size_t outputSize, const void *cookie) {
+#ifdef CHRE_INFERENCE_SUPPORT_ENABLED
+  Nanoapp *nanoapp = EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         EventLoopManagerSingleton::get()
+             ->getInferenceManager()
+             .requestInference(nanoapp, modelHandle, input, inputSize, output,
+                               outputSize, cookie);
+#else
+  UNUSED_VAR(modelHandle);
+  UNUSED_VAR(input);
+  UNUSED_VAR(inputSize);
+  UNUSED_VAR(output);
+  UNUSED_VAR(outputSize);
+  UNUSED_VAR(cookie);
+  return false;
+#endif  // CHRE_INFERENCE_SUPPORT_ENABLED
+}
@@ -81,7 +81,7 @@ DLL_EXPORT uint32_t chreTimerSet(uint64_t duration, const void *cookie,
                                  bool oneShot) {
   chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
   return EventLoopManagerSingleton::get()
-      ->getEventLoop()
+      ->getCurrentEventLoop()
       .getTimerPool()
       .setNanoappTimer(nanoapp, chre::Nanoseconds(duration), cookie, oneShot);
 }
@@ -89,7 +89,7 @@ DLL_EXPORT uint32_t chreTimerSet(uint64_t duration, const void *cookie,
 DLL_EXPORT bool chreTimerCancel(uint32_t timerId) {
   chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
   return EventLoopManagerSingleton::get()
-      ->getEventLoop()
+      ->getCurrentEventLoop()
       .getTimerPool()
       .cancelNanoappTimer(nanoapp, timerId);
 }
@@ -98,7 +98,8 @@ DLL_EXPORT void *chreHeapAlloc(uint32_t bytes) {
   chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
   return chre::EventLoopManagerSingleton::get()
       ->getMemoryManager()
-      .nanoappAlloc(nanoapp, bytes);
+      .nanoappAlloc(nanoapp, bytes,
+                    reinterpret_cast<uintptr_t>(__builtin_return_address(0)));
 }
 
 DLL_EXPORT void chreHeapFree(void *ptr) {
@@ -109,10 +110,13 @@ DLL_EXPORT void chreHeapFree(void *ptr) {
 
 DLL_EXPORT void platform_chreDebugDumpVaLog(const char *formatStr,
                                             va_list args) {
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  chre::EventLoopManagerSingleton::get()
-      ->getDebugDumpManager()
-      .appendNanoappLog(*nanoapp, formatStr, args);
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  if (nanoapp != nullptr) {
+    chre::EventLoopManagerSingleton::get()
+        ->getDebugDumpManager()
+        .appendNanoappLog(*nanoapp, formatStr, args);
+  }
 }
 
 DLL_EXPORT void chreDebugDumpLog(const char *formatStr, ...) {
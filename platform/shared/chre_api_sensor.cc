@@ -36,10 +36,13 @@ DLL_EXPORT bool chreSensorFindDefault(uint8_t sensorType, uint32_t *handle) {
 DLL_EXPORT bool chreSensorFind(uint8_t sensorType, uint8_t sensorIndex,
                                uint32_t *handle) {
 #if CHRE_SENSORS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return EventLoopManagerSingleton::get()
-      ->getSensorRequestManager()
-      .getSensorHandleForNanoapp(sensorType, sensorIndex, *nanoapp, handle);
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         EventLoopManagerSingleton::get()
+             ->getSensorRequestManager()
+             .getSensorHandleForNanoapp(sensorType, sensorIndex, *nanoapp,
+                                        handle);
 #else  // CHRE_SENSORS_SUPPORT_ENABLED
   UNUSED_VAR(sensorType);
   UNUSED_VAR(sensorIndex);
@@ -53,10 +56,11 @@ DLL_EXPORT bool chreGetSensorInfo(uint32_t sensorHandle,
 #ifdef CHRE_SENSORS_SUPPORT_ENABLED
   CHRE_ASSERT(info);
 
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
 
   bool success = false;
-  if (info != nullptr) {
+  if (nanoapp != nullptr && info != nullptr) {
     success = EventLoopManagerSingleton::get()
                   ->getSensorRequestManager()
                   .getSensorInfo(sensorHandle, *nanoapp, info);
@@ -92,7 +96,12 @@ DLL_EXPORT bool chreSensorConfigure(uint32_t sensorHandle,
                                     enum chreSensorConfigureMode mode,
                                     uint64_t interval, uint64_t latency) {
 #ifdef CHRE_SENSORS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  if (nanoapp == nullptr) {
+    return false;
+  }
+
   SensorMode sensorMode = getSensorModeFromEnum(mode);
   SensorRequest sensorRequest(nanoapp->getInstanceId(), sensorMode,
                               Nanoseconds(interval), Nanoseconds(latency));
@@ -111,10 +120,12 @@ DLL_EXPORT bool chreSensorConfigure(uint32_t sensorHandle,
 DLL_EXPORT bool chreSensorConfigureBiasEvents(uint32_t sensorHandle,
                                               bool enable) {
 #ifdef CHRE_SENSORS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return EventLoopManagerSingleton::get()
-      ->getSensorRequestManager()
-      .configureBiasEvents(nanoapp, sensorHandle, enable);
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr && EventLoopManagerSingleton::get()
+                                    ->getSensorRequestManager()
+                                    .configureBiasEvents(nanoapp, sensorHandle,
+                                                         enable);
 #else   // CHRE_SENSORS_SUPPORT_ENABLED
   UNUSED_VAR(sensorHandle);
   UNUSED_VAR(enable);
@@ -138,9 +149,11 @@ DLL_EXPORT bool chreSensorGetThreeAxisBias(
 DLL_EXPORT bool chreSensorFlushAsync(uint32_t sensorHandle,
                                      const void *cookie) {
 #ifdef CHRE_SENSORS_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return EventLoopManagerSingleton::get()->getSensorRequestManager().flushAsync(
-      nanoapp, sensorHandle, cookie);
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         EventLoopManagerSingleton::get()->getSensorRequestManager().flushAsync(
+             nanoapp, sensorHandle, cookie);
 #else   // CHRE_SENSORS_SUPPORT_ENABLED
   UNUSED_VAR(sensorHandle);
   UNUSED_VAR(cookie);
@@ -37,8 +37,10 @@ DLL_EXPORT uint32_t chreWifiGetCapabilities() {
 DLL_EXPORT bool chreWifiConfigureScanMonitorAsync(
     [[maybe_unused]] bool enable, [[maybe_unused]] const void *cookie) {
 #ifdef CHRE_WIFI_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
          EventLoopManagerSingleton::get()
              ->getWifiRequestManager()
              .configureScanMonitor(nanoapp, enable, cookie);
@@ -51,8 +53,10 @@ DLL_EXPORT bool chreWifiRequestScanAsync(
     [[maybe_unused]] const struct chreWifiScanParams *params,
     [[maybe_unused]] const void *cookie) {
 #ifdef CHRE_WIFI_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
          EventLoopManagerSingleton::get()->getWifiRequestManager().requestScan(
              nanoapp, params, cookie);
 #else
@@ -64,8 +68,10 @@ DLL_EXPORT bool chreWifiRequestRangingAsync(
     [[maybe_unused]] const struct chreWifiRangingParams *params,
     [[maybe_unused]] const void *cookie) {
 #ifdef CHRE_WIFI_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
          EventLoopManagerSingleton::get()
              ->getWifiRequestManager()
              .requestRanging(chre::WifiRequestManager::RangingType::WIFI_AP,
@@ -79,8 +85,10 @@ DLL_EXPORT bool chreWifiNanSubscribe(
     [[maybe_unused]] struct chreWifiNanSubscribeConfig *config,
     [[maybe_unused]] const void *cookie) {
 #if defined(CHRE_WIFI_SUPPORT_ENABLED) && defined(CHRE_WIFI_NAN_SUPPORT_ENABLED)
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
          EventLoopManagerSingleton::get()->getWifiRequestManager().nanSubscribe(
              nanoapp, config, cookie);
 #else
@@ -91,8 +99,10 @@ DLL_EXPORT bool chreWifiNanSubscribe(
 DLL_EXPORT bool chreWifiNanSubscribeCancel(
     [[maybe_unused]] uint32_t subscriptionId) {
 #if defined(CHRE_WIFI_SUPPORT_ENABLED) && defined(CHRE_WIFI_NAN_SUPPORT_ENABLED)
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
          EventLoopManagerSingleton::get()
              ->getWifiRequestManager()
              .nanSubscribeCancel(nanoapp, subscriptionId);
@@ -105,8 +115,10 @@ DLL_EXPORT bool chreWifiNanRequestRangingAsync(
     [[maybe_unused]] const struct chreWifiNanRangingParams *params,
     [[maybe_unused]] const void *cookie) {
 #if defined(CHRE_WIFI_SUPPORT_ENABLED) && defined(CHRE_WIFI_NAN_SUPPORT_ENABLED)
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WIFI) &&
          EventLoopManagerSingleton::get()
              ->getWifiRequestManager()
              .requestRanging(chre::WifiRequestManager::RangingType::WIFI_AWARE,
@@ -36,8 +36,10 @@ DLL_EXPORT uint32_t chreWwanGetCapabilities() {
 
 DLL_EXPORT bool chreWwanGetCellInfoAsync([[maybe_unused]] const void *cookie) {
 #ifdef CHRE_WWAN_SUPPORT_ENABLED
-  chre::Nanoapp *nanoapp = EventLoopManager::validateChreApiCall(__func__);
-  return nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WWAN) &&
+  chre::Nanoapp *nanoapp =
+      EventLoopManager::validateSystemChreApiCall(__func__);
+  return nanoapp != nullptr &&
+         nanoapp->permitPermissionUse(NanoappPermissions::CHRE_PERMS_WWAN) &&
          chre::EventLoopManagerSingleton::get()
              ->getWwanRequestManager()
              .requestCellInfo(nanoapp, cookie);
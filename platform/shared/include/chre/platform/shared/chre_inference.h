@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_PLATFORM_SHARED_CHRE_INFERENCE_H_
+#define CHRE_PLATFORM_SHARED_CHRE_INFERENCE_H_
+
+/**
+ * @file
+ * An implementation-specific extension of the CHRE API letting nanoapps run
+ * machine learning models through a shared inference service, instead of
+ * embedding their own interpreter and tensor arena.
+ *
+ * The service keeps a registry of the models loaded by nanoapps and a single
+ * tensor arena, sized for the largest registered model, which the models take
+ * turns to use. Inference requests are queued and run one at a time in the
+ * context of the CHRE event loop, and their results are delivered to the
+ * requesting nanoapp as CHRE_EVENT_INFERENCE_RESULT events.
+ *
+ * These functions are only available when CHRE is built with
+ * CHRE_INFERENCE_SUPPORT_ENABLED; otherwise they always return false.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <chre/event.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * nanoappHandleEvent argument: struct chreInferenceResult
+ *
+ * Delivered to a nanoapp once an inference it requested completes.
+ */
+#define CHRE_EVENT_INFERENCE_RESULT CHRE_EVENT_INTERNAL_EXTENDED_FIRST_EVENT
+
+//! An invalid model handle.
+#define CHRE_INFERENCE_INVALID_MODEL_HANDLE UINT32_C(0)
+
+/**
+ * The result of an inference request.
+ */
+struct chreInferenceResult {
+  //! The model the inference was requested for.
+  uint32_t modelHandle;
+
+  //! CHRE_ERROR_NONE if the output buffer given with the request was
+  //! populated, otherwise a value from enum chreError.
+  uint8_t errorCode;
+
+  //! Reserved for future use, set to 0.
+  uint8_t reserved[3];
+
+  //! The output buffer given with the request.
+  void *output;
+
+  //! The cookie given with the request.
+  const void *cookie;
+
+  //! The time the request spent queued, in nanoseconds.
+  uint64_t queueTimeNs;
+
+  //! The time the inference took, including preparing the model if another
+  //! model used the arena last, in nanoseconds.
+  uint64_t inferenceTimeNs;
+};
+
+/**
+ * Registers a model with the inference service.
+ *
+ * @param model The serialized model, e.g. a TensorFlow Lite flatbuffer. Must
+ *     remain valid until the model is unregistered, so it is typically a
+ *     constant in the nanoapp binary.
+ * @param modelSize The size of the model, in bytes.
+ * @param arenaSize The size of the tensor arena the model needs, in bytes.
+ * @param modelHandle Populated with the handle of the model on success.
+ * @return true if the model was registered.
+ */
+bool chreInferenceRegisterModel(const void *model, size_t modelSize,
+                                size_t arenaSize, uint32_t *modelHandle);
+
+/**
+ * Unregisters a model. Pending requests for the model are dropped without
+ * delivering their result. Models are unregistered automatically when the
+ * nanoapp that registered them is unloaded.
+ *
+ * @param modelHandle A handle returned by chreInferenceRegisterModel().
+ * @return true if the model was registered by this nanoapp.
+ */
+bool chreInferenceUnregisterModel(uint32_t modelHandle);
+
+/**
+ * Requests an inference. The input and output buffers are used in place, and
+ * must remain valid until the CHRE_EVENT_INFERENCE_RESULT event is received.
+ *
+ * @param modelHandle A handle returned by chreInferenceRegisterModel().
+ * @param input The input tensor.
+ * @param inputSize The size of the input tensor, in bytes.
+ * @param output The buffer to populate with the output tensor.
+ * @param outputSize The size of the output buffer, in bytes.
+ * @param cookie An opaque value returned in the result.
+ * @return true if the request was queued, in which case a result event will
+ *     be delivered.
+ */
+bool chreInferenceRequest(uint32_t modelHandle, const void *input,
+                          size_t inputSize, void *output, size_t outputSize,
+                          const void *cookie);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // CHRE_PLATFORM_SHARED_CHRE_INFERENCE_H_
@@ -17,13 +17,31 @@
 #include "chre/platform/memory_manager.h"
 
 #include "chre/platform/assert.h"
+#include "chre/platform/system_time.h"
+#include "chre/util/macros.h"
 #include "chre/util/system/debug_dump.h"
+#include "chre/util/time.h"
 
 namespace chre {
 
-void *MemoryManager::nanoappAlloc(Nanoapp *app, uint32_t bytes) {
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+namespace {
+
+//! @return The current time in milliseconds, truncated to 32 bits. Lifetimes
+//!     are computed with unsigned arithmetic, so wrapping around is fine.
+uint32_t getHeapProfilerTimeMs() {
+  return static_cast<uint32_t>(
+      Milliseconds(SystemTime::getMonotonicTime()).getMilliseconds());
+}
+
+}  // anonymous namespace
+#endif  // CHRE_HEAP_PROFILER_ENABLED
+
+void *MemoryManager::nanoappAlloc(Nanoapp *app, uint32_t bytes,
+                                  uintptr_t callSite) {
   HeapBlockHeader *header = nullptr;
   if (bytes > 0) {
+    LockGuard<Mutex> lock(mLock);
     if (mAllocationCount >= kMaxAllocationCount) {
       LOGE("Failed to allocate memory from Nanoapp ID %" PRIu16
            ": allocation count exceeded limit.",
@@ -47,10 +65,22 @@ void *MemoryManager::nanoappAlloc(Nanoapp *app, uint32_t bytes) {
         app->linkHeapBlock(header);
         header->data.bytes = bytes;
         header->data.instanceId = app->getInstanceId();
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+        header->data.profilerSiteIndex =
+            mHeapProfiler.recordAlloc(app->getAppId(), callSite, bytes);
+        header->data.allocTimeMs = getHeapProfilerTimeMs();
+#endif  // CHRE_HEAP_PROFILER_ENABLED
         header++;
       }
     }
+
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+    if (header == nullptr) {
+      mHeapProfiler.recordFailedAlloc(app->getAppId(), callSite, bytes);
+    }
+#endif  // CHRE_HEAP_PROFILER_ENABLED
   }
+  UNUSED_VAR(callSite);
   return header;
 }
 
@@ -67,6 +97,7 @@ void MemoryManager::nanoappFree(Nanoapp *app, void *ptr) {
            app->getInstanceId(), header->data.instanceId);
     }
 
+    LockGuard<Mutex> lock(mLock);
     size_t nanoAppTotalAllocatedBytes = app->getTotalAllocatedBytes();
     if (nanoAppTotalAllocatedBytes >= header->data.bytes) {
       app->setTotalAllocatedBytes(nanoAppTotalAllocatedBytes -
@@ -84,6 +115,11 @@ void MemoryManager::nanoappFree(Nanoapp *app, void *ptr) {
       mAllocationCount--;
     }
 
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+    mHeapProfiler.recordFree(header->data.profilerSiteIndex, header->data.bytes,
+                             getHeapProfilerTimeMs() - header->data.allocTimeMs);
+#endif  // CHRE_HEAP_PROFILER_ENABLED
+
     app->unlinkHeapBlock(header);
     doFree(app, header);
   }
@@ -96,7 +132,7 @@ uint32_t MemoryManager::nanoappFreeAll(Nanoapp *app) {
   // some headers got corrupted. It represents the number of blocks currently
   // allocated for all the nanoapps and is used as an upper bound for the number
   // of blocks allocated by the current nanoapp.
-  size_t totalNumBlocks = mAllocationCount;
+  size_t totalNumBlocks = getAllocationCount();
   uint32_t numFreedBlocks = 0;
 
   while (current != nullptr && totalNumBlocks > 0) {
@@ -113,10 +149,15 @@ uint32_t MemoryManager::nanoappFreeAll(Nanoapp *app) {
 }
 
 void MemoryManager::logStateToBuffer(DebugDumpWrapper &debugDump) const {
+  LockGuard<Mutex> lock(mLock);
   debugDump.print(
       "\nNanoapp heap usage: %zu bytes allocated, %zu peak bytes"
       " allocated, count %zu\n",
-      getTotalAllocatedBytes(), getPeakAllocatedBytes(), getAllocationCount());
+      mTotalAllocatedBytes, mPeakAllocatedBytes, mAllocationCount);
+
+#ifdef CHRE_HEAP_PROFILER_ENABLED
+  mHeapProfiler.logStateToBuffer(debugDump);
+#endif  // CHRE_HEAP_PROFILER_ENABLED
 }
 
 }  // namespace chre
@@ -228,15 +228,8 @@ void handleUnloadNanoappCallback(SystemCallbackType /*type*/,
   auto msgBuilder = [](ChreFlatBufferBuilder &builder, void *cookie) {
     auto *cbData = static_cast<UnloadNanoappCallbackData *>(cookie);
 
-    bool success = false;
-    uint16_t instanceId;
-    EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
-    if (!eventLoop.findNanoappInstanceIdByAppId(cbData->appId, &instanceId)) {
-      LOGE("Couldn't unload app ID 0x%016" PRIx64 ": not found", cbData->appId);
-    } else {
-      success =
-          eventLoop.unloadNanoapp(instanceId, cbData->allowSystemNanoappUnload);
-    }
+    bool success = EventLoopManagerSingleton::get()->unloadNanoapp(
+        cbData->appId, cbData->allowSystemNanoappUnload);
 
     HostProtocolChre::encodeUnloadNanoappResponse(
         builder, cbData->hostClientId, cbData->transactionId, success);
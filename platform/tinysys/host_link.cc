@@ -352,15 +352,8 @@ DRAM_REGION_FUNCTION void handleUnloadNanoappCallback(uint16_t /*type*/,
                                                       void *data,
                                                       void * /*extraData*/) {
   auto *cbData = static_cast<UnloadNanoappCallbackData *>(data);
-  bool success = false;
-  uint16_t instanceId;
-  EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
-  if (!eventLoop.findNanoappInstanceIdByAppId(cbData->appId, &instanceId)) {
-    LOGE("Couldn't unload app ID 0x%016" PRIx64 ": not found", cbData->appId);
-  } else {
-    success =
-        eventLoop.unloadNanoapp(instanceId, cbData->allowSystemNanoappUnload);
-  }
+  bool success = EventLoopManagerSingleton::get()->unloadNanoapp(
+      cbData->appId, cbData->allowSystemNanoappUnload);
 
   constexpr size_t kInitialBufferSize = 52;
   auto builder = MakeUnique<ChreFlatBufferBuilder>(kInitialBufferSize);
@@ -25,6 +25,7 @@
 #include "chre/core/settings.h"
 #include "chre/platform/fatal_error.h"
 #include "chre/platform/linux/pal_ble.h"
+#include "chre/platform/linux/virtual_clock.h"
 #include "chre/util/dynamic_vector.h"
 #include "chre_api/chre/ble.h"
 #include "chre_api/chre/user_settings.h"
@@ -93,6 +94,10 @@ class BleTestNanoapp : public TestNanoapp {
       : TestNanoapp(
             TestNanoappInfo{.perms = NanoappPermissions::CHRE_PERMS_BLE}) {}
 
+  explicit BleTestNanoapp(uint64_t appId)
+      : TestNanoapp(TestNanoappInfo{
+            .id = appId, .perms = NanoappPermissions::CHRE_PERMS_BLE}) {}
+
   bool start() override {
     chreUserSettingConfigureEvents(CHRE_USER_SETTING_BLE_AVAILABLE,
                                    true /* enable */);
@@ -437,7 +442,7 @@ TEST_F(TestBase, BleSettingChangeTest) {
   EXPECT_FALSE(
       EventLoopManagerSingleton::get()->getSettingManager().getSettingEnabled(
           Setting::BLE_AVAILABLE));
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  platform_linux::sleepFor(Milliseconds(100));
   EXPECT_FALSE(chrePalIsBleEnabled());
 
   EventLoopManagerSingleton::get()->getSettingManager().postSettingChange(
@@ -829,7 +834,7 @@ TEST_F(TestBase, BleFlush) {
   // delay is extremely large.
   constexpr uint32_t kNumFlushCalls = 3;
   for (uint32_t i = 0; i < kNumFlushCalls; ++i) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    platform_linux::sleepFor(Milliseconds(250));
 
     sendEventToNanoapp(appId, CALL_FLUSH);
     waitForEvent(CALL_FLUSH, &success);
@@ -862,5 +867,101 @@ TEST_F(TestBase, BleFlush) {
   ASSERT_FALSE(success);
 }
 
+/**
+ * This test verifies that a nanoapp registered for advertisement events
+ * without a scan request of its own still receives the advertisements
+ * produced by another nanoapp's scan.
+ */
+TEST_F(TestBase, BleAdvertisementsReachRegisteredNanoappWithoutScanRequest) {
+  CREATE_CHRE_TEST_EVENT(START_SCAN, 0);
+  CREATE_CHRE_TEST_EVENT(SCAN_STARTED, 1);
+  CREATE_CHRE_TEST_EVENT(STOP_SCAN, 2);
+  CREATE_CHRE_TEST_EVENT(SCAN_STOPPED, 3);
+  CREATE_CHRE_TEST_EVENT(LISTENER_SAW_ADVERTISEMENT, 4);
+
+  constexpr uint64_t kListeningAppId = kDefaultTestNanoappId + 1;
+
+  class ScanningApp : public BleTestNanoapp {
+   public:
+    void handleEvent(uint32_t, uint16_t eventType,
+                     const void *eventData) override {
+      switch (eventType) {
+        case CHRE_EVENT_BLE_ASYNC_RESULT: {
+          auto *event = static_cast<const struct chreAsyncResult *>(eventData);
+          if (event->errorCode == CHRE_ERROR_NONE) {
+            uint16_t type =
+                (event->requestType == CHRE_BLE_REQUEST_TYPE_START_SCAN)
+                    ? SCAN_STARTED
+                    : SCAN_STOPPED;
+            TestEventQueueSingleton::get()->pushEvent(type);
+          }
+          break;
+        }
+
+        case CHRE_EVENT_TEST_EVENT: {
+          auto event = static_cast<const TestEvent *>(eventData);
+          switch (event->type) {
+            case START_SCAN: {
+              const bool success = chreBleStartScanAsync(
+                  CHRE_BLE_SCAN_MODE_AGGRESSIVE, 0, nullptr);
+              TestEventQueueSingleton::get()->pushEvent(START_SCAN, success);
+              break;
+            }
+
+            case STOP_SCAN: {
+              const bool success = chreBleStopScanAsync();
+              TestEventQueueSingleton::get()->pushEvent(STOP_SCAN, success);
+              break;
+            }
+          }
+          break;
+        }
+      }
+    }
+  };
+
+  class ListeningApp : public BleTestNanoapp {
+   public:
+    ListeningApp() : BleTestNanoapp(kListeningAppId) {}
+
+    bool start() override {
+      EventLoopManagerSingleton::get()
+          ->getEventLoop()
+          .findNanoappByInstanceId(chreGetInstanceId())
+          ->registerForBroadcastEvent(CHRE_EVENT_BLE_ADVERTISEMENT);
+      return BleTestNanoapp::start();
+    }
+
+    void handleEvent(uint32_t, uint16_t eventType,
+                     const void * /* eventData */) override {
+      if (eventType == CHRE_EVENT_BLE_ADVERTISEMENT &&
+          !mSawBleAdvertisementEvent) {
+        mSawBleAdvertisementEvent = true;
+        TestEventQueueSingleton::get()->pushEvent(LISTENER_SAW_ADVERTISEMENT);
+      }
+    }
+
+   private:
+    bool mSawBleAdvertisementEvent = false;
+  };
+
+  uint64_t scanningAppId = loadNanoapp(MakeUnique<ScanningApp>());
+  loadNanoapp(MakeUnique<ListeningApp>());
+
+  bool success;
+  sendEventToNanoapp(scanningAppId, START_SCAN);
+  waitForEvent(START_SCAN, &success);
+  ASSERT_TRUE(success);
+  waitForEvent(SCAN_STARTED);
+  ASSERT_TRUE(chrePalIsBleEnabled());
+  waitForEvent(LISTENER_SAW_ADVERTISEMENT);
+
+  sendEventToNanoapp(scanningAppId, STOP_SCAN);
+  waitForEvent(STOP_SCAN, &success);
+  ASSERT_TRUE(success);
+  waitForEvent(SCAN_STOPPED);
+  ASSERT_FALSE(chrePalIsBleEnabled());
+}
+
 }  // namespace
 }  // namespace chre
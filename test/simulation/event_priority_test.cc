@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+
+#include "chre/core/event_loop_manager.h"
+#include "chre_api/chre/event.h"
+
+#include "gtest/gtest.h"
+#include "inc/test_util.h"
+#include "test_base.h"
+#include "test_event.h"
+#include "test_event_queue.h"
+#include "test_util.h"
+
+namespace chre {
+namespace {
+
+class EventPriorityTest : public TestBase {};
+
+CREATE_CHRE_TEST_EVENT(POST_EVENTS, 0);
+CREATE_CHRE_TEST_EVENT(EVENTS_RECEIVED, 1);
+
+//! The order in which the events posted by the test nanoapp were dispatched.
+struct DispatchOrder {
+  static constexpr size_t kMaxEvents = 4;
+  uint16_t eventTypes[kMaxEvents];
+  size_t numEvents;
+};
+
+DispatchOrder gOrder;
+
+constexpr uint16_t kSystemCallbackEvent = CHRE_EVENT_FIRST_USER_VALUE;
+constexpr uint16_t kDataEvent = CHRE_EVENT_FIRST_USER_VALUE + 1;
+constexpr uint16_t kBulkEvent = CHRE_EVENT_FIRST_USER_VALUE + 2;
+
+void recordDispatch(uint16_t eventType) {
+  if (gOrder.numEvents < DispatchOrder::kMaxEvents) {
+    gOrder.eventTypes[gOrder.numEvents++] = eventType;
+  }
+}
+
+/**
+ * Posts a nanoapp event, a system event and a deferred callback in that order
+ * while the event loop is busy, then records the order they get dispatched in.
+ */
+class App : public TestNanoapp {
+ public:
+  void handleEvent(uint32_t, uint16_t eventType,
+                   const void *eventData) override {
+    switch (eventType) {
+      case CHRE_EVENT_TEST_EVENT: {
+        auto event = static_cast<const TestEvent *>(eventData);
+        if (event->type == POST_EVENTS) {
+          postEvents();
+        }
+        break;
+      }
+
+      case kDataEvent:
+        recordDispatch(kDataEvent);
+        break;
+
+      case kBulkEvent:
+        recordDispatch(kBulkEvent);
+        // The nanoapp event is posted first but dispatched last.
+        TestEventQueueSingleton::get()->pushEvent(EVENTS_RECEIVED, gOrder);
+        break;
+    }
+  }
+
+ private:
+  void postEvents() {
+    gOrder.numEvents = 0;
+    EXPECT_TRUE(chreSendEvent(kBulkEvent, /* eventData= */ nullptr,
+                              /* freeCallback= */ nullptr,
+                              chreGetInstanceId()));
+    EventLoopManagerSingleton::get()->getEventLoop().postEventOrDie(
+        kDataEvent, /* eventData= */ nullptr, /* freeCallback= */ nullptr,
+        static_cast<uint16_t>(chreGetInstanceId()));
+    auto callback = [](uint16_t /* type */, void * /* data */,
+                       void * /* extraData */) {
+      recordDispatch(kSystemCallbackEvent);
+    };
+    EventLoopManagerSingleton::get()->deferCallback(
+        SystemCallbackType::FirstCallbackType, /* data= */ nullptr, callback);
+  }
+};
+
+TEST_F(EventPriorityTest, EventsAreDispatchedByPriorityClass) {
+  uint64_t appId = loadNanoapp(MakeUnique<App>());
+
+  // A single FIFO queue would dispatch the events in the order they were
+  // posted: bulk, data and then system. The priority classes reverse it.
+  DispatchOrder order;
+  sendEventToNanoapp(appId, POST_EVENTS);
+  waitForEvent(EVENTS_RECEIVED, &order);
+  ASSERT_EQ(order.numEvents, 3);
+  EXPECT_EQ(order.eventTypes[0], kSystemCallbackEvent);
+  EXPECT_EQ(order.eventTypes[1], kDataEvent);
+  EXPECT_EQ(order.eventTypes[2], kBulkEvent);
+}
+
+TEST_F(EventPriorityTest, EventTypePriorityCanBeOverridden) {
+  ASSERT_TRUE(
+      EventLoopManagerSingleton::get()->getEventLoop().setEventTypePriority(
+          kDataEvent, EventPriority::System));
+  uint64_t appId = loadNanoapp(MakeUnique<App>());
+
+  // The system event now shares the priority class of the deferred callback,
+  // which it was posted before.
+  DispatchOrder order;
+  sendEventToNanoapp(appId, POST_EVENTS);
+  waitForEvent(EVENTS_RECEIVED, &order);
+  ASSERT_EQ(order.numEvents, 3);
+  EXPECT_EQ(order.eventTypes[0], kDataEvent);
+  EXPECT_EQ(order.eventTypes[1], kSystemCallbackEvent);
+  EXPECT_EQ(order.eventTypes[2], kBulkEvent);
+}
+
+TEST_F(EventPriorityTest, EventsOfTheSamePriorityClassAreDispatchedInOrder) {
+  CREATE_CHRE_TEST_EVENT(SEND_EVENTS, 2);
+
+  class FifoApp : public TestNanoapp {
+   public:
+    void handleEvent(uint32_t, uint16_t eventType,
+                     const void *eventData) override {
+      if (eventType == CHRE_EVENT_TEST_EVENT) {
+        auto event = static_cast<const TestEvent *>(eventData);
+        if (event->type == SEND_EVENTS) {
+          gOrder.numEvents = 0;
+          for (uint16_t i = 0; i < DispatchOrder::kMaxEvents; i++) {
+            EXPECT_TRUE(chreSendEvent(kBulkEvent + i, /* eventData= */ nullptr,
+                                      /* freeCallback= */ nullptr,
+                                      chreGetInstanceId()));
+          }
+        }
+      } else if (eventType >= kBulkEvent) {
+        recordDispatch(eventType);
+        if (gOrder.numEvents == DispatchOrder::kMaxEvents) {
+          TestEventQueueSingleton::get()->pushEvent(EVENTS_RECEIVED, gOrder);
+        }
+      }
+    }
+  };
+
+  uint64_t appId = loadNanoapp(MakeUnique<FifoApp>());
+
+  DispatchOrder order;
+  sendEventToNanoapp(appId, SEND_EVENTS);
+  waitForEvent(EVENTS_RECEIVED, &order);
+  ASSERT_EQ(order.numEvents, DispatchOrder::kMaxEvents);
+  for (uint16_t i = 0; i < DispatchOrder::kMaxEvents; i++) {
+    EXPECT_EQ(order.eventTypes[i], kBulkEvent + i);
+  }
+}
+
+}  // namespace
+}  // namespace chre
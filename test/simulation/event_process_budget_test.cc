@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "chre/core/event_loop.h"
+#include "chre/core/event_loop_manager.h"
+#include "chre/platform/linux/virtual_clock.h"
+#include "chre/util/lock_guard.h"
+#include "chre/util/system/debug_dump.h"
+#include "chre/util/time.h"
+
+#include "gtest/gtest.h"
+#include "inc/test_util.h"
+#include "test_base.h"
+#include "test_event.h"
+#include "test_event_queue.h"
+#include "test_util.h"
+
+namespace chre {
+
+// TestEventProcessBudget is required to access private members of the
+// EventLoop.
+class TestEventProcessBudget : public TestBase {
+ protected:
+  //! @return The total number of budget overruns of the nanoapp, or 0 if it
+  //!     isn't tracked as an offender.
+  uint32_t getTotalOverrunCount(uint16_t instanceId) {
+    EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
+    LockGuard<Mutex> lock(eventLoop.mBudgetOffendersLock);
+    for (const EventLoop::BudgetOffender &offender :
+         eventLoop.mBudgetOffenders) {
+      if (offender.instanceId == instanceId) {
+        return offender.totalOverrunCount;
+      }
+    }
+    return 0;
+  }
+
+  bool isRepeatOffender(uint16_t instanceId) {
+    EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
+    LockGuard<Mutex> lock(eventLoop.mBudgetOffendersLock);
+    for (const EventLoop::BudgetOffender &offender :
+         eventLoop.mBudgetOffenders) {
+      if (offender.instanceId == instanceId) {
+        return offender.isRepeatOffender(SystemTime::getMonotonicTime());
+      }
+    }
+    return false;
+  }
+
+  size_t getNumOffenders() {
+    EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
+    LockGuard<Mutex> lock(eventLoop.mBudgetOffendersLock);
+    return eventLoop.mBudgetOffenders.size();
+  }
+
+  static constexpr Nanoseconds kOverBudget =
+      EventLoop::kEventProcessBudget + Nanoseconds(Milliseconds(50));
+  static constexpr uint8_t kRepeatOffenderOverrunCount =
+      EventLoop::kRepeatOffenderOverrunCount;
+};
+
+namespace {
+
+CREATE_CHRE_TEST_EVENT(PROCESS_EVENT, 0);
+CREATE_CHRE_TEST_EVENT(EVENT_PROCESSED, 1);
+CREATE_CHRE_TEST_EVENT(DEBUG_DUMP, 2);
+CREATE_CHRE_TEST_EVENT(EVENT_LOOP_IDLE, 3);
+
+//! Spends the duration given with each PROCESS_EVENT test event processing it.
+class SlowApp : public TestNanoapp {
+ public:
+  explicit SlowApp(uint64_t appId = kDefaultTestNanoappId)
+      : TestNanoapp(TestNanoappInfo{.id = appId}) {}
+
+  void handleEvent(uint32_t, uint16_t eventType,
+                   const void *eventData) override {
+    if (eventType == CHRE_EVENT_TEST_EVENT) {
+      auto event = static_cast<const TestEvent *>(eventData);
+      if (event->type == PROCESS_EVENT) {
+        auto durationNs = static_cast<const uint64_t *>(event->data);
+        platform_linux::sleepFor(Nanoseconds(*durationNs));
+        TestEventQueueSingleton::get()->pushEvent(EVENT_PROCESSED);
+      }
+    }
+  }
+};
+
+void processEventFor(uint64_t appId, Nanoseconds duration) {
+  sendEventToNanoapp(appId, PROCESS_EVENT, duration.toRawNanoseconds());
+  TestEventQueueSingleton::get()->waitForEvent(EVENT_PROCESSED);
+
+  // The process time is recorded once the nanoapp returns, so wait for the
+  // event loop to get to the next event.
+  auto callback = [](uint16_t /* type */, void * /* data */,
+                     void * /* extraData */) {
+    TestEventQueueSingleton::get()->pushEvent(EVENT_LOOP_IDLE);
+  };
+  EventLoopManagerSingleton::get()->deferCallback(
+      SystemCallbackType::FirstCallbackType, /* data= */ nullptr, callback);
+  TestEventQueueSingleton::get()->waitForEvent(EVENT_LOOP_IDLE);
+}
+
+//! @return Whether the system event loop's debug dump contains the string.
+bool debugDumpContains(const char *str) {
+  auto callback = [](uint16_t /* type */, void *data, void * /* extraData */) {
+    DebugDumpWrapper debugDump(/* bufferSize= */ 512);
+    EventLoopManagerSingleton::get()->getEventLoop().logStateToBuffer(
+        debugDump);
+    bool found = false;
+    for (const UniquePtr<char> &buffer : debugDump.getBuffers()) {
+      found |= strstr(buffer.get(), static_cast<const char *>(data)) != nullptr;
+    }
+    TestEventQueueSingleton::get()->pushEvent(DEBUG_DUMP, found);
+  };
+  EventLoopManagerSingleton::get()->deferCallback(
+      SystemCallbackType::FirstCallbackType, const_cast<char *>(str),
+      callback);
+
+  bool found;
+  TestEventQueueSingleton::get()->waitForEvent(DEBUG_DUMP, &found);
+  return found;
+}
+
+TEST_F(TestEventProcessBudget, EventWithinBudgetIsNotTracked) {
+  uint64_t appId = loadNanoapp(MakeUnique<SlowApp>());
+  Nanoapp *nanoapp = getNanoappByAppId(appId);
+  ASSERT_NE(nanoapp, nullptr);
+
+  processEventFor(appId, Milliseconds(1));
+  EXPECT_EQ(getTotalOverrunCount(nanoapp->getInstanceId()), 0);
+  EXPECT_EQ(getNumOffenders(), 0);
+}
+
+TEST_F(TestEventProcessBudget, ExceedingBudgetTracksOffender) {
+  uint64_t appId = loadNanoapp(MakeUnique<SlowApp>());
+  Nanoapp *nanoapp = getNanoappByAppId(appId);
+  ASSERT_NE(nanoapp, nullptr);
+  uint16_t instanceId = nanoapp->getInstanceId();
+
+  processEventFor(appId, kOverBudget);
+  EXPECT_EQ(getTotalOverrunCount(instanceId), 1);
+  EXPECT_FALSE(isRepeatOffender(instanceId));
+
+  for (uint8_t i = 1; i < kRepeatOffenderOverrunCount; i++) {
+    processEventFor(appId, kOverBudget);
+  }
+  EXPECT_EQ(getTotalOverrunCount(instanceId), kRepeatOffenderOverrunCount);
+  EXPECT_TRUE(isRepeatOffender(instanceId));
+}
+
+TEST_F(TestEventProcessBudget, OverrunIsNotAHealthCheckFailure) {
+  // Overruns are only recorded, so they can't crash CHRE even if failed health
+  // checks do.
+  EventLoopManagerSingleton::get()
+      ->getSystemHealthMonitor()
+      .setFatalErrorOnCheckFailure(true);
+  EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
+  uint64_t appId = loadNanoapp(MakeUnique<SlowApp>());
+
+  processEventFor(appId, kOverBudget);
+  processEventFor(appId, kOverBudget);
+  EXPECT_EQ(eventLoop.getNumEventProcessBudgetOverruns(), 2);
+  EXPECT_TRUE(debugDumpContains("2 overruns"));
+}
+
+TEST_F(TestEventProcessBudget, DebugDumpListsOffenders) {
+  uint64_t appId = loadNanoapp(MakeUnique<SlowApp>());
+  EXPECT_FALSE(debugDumpContains("repeat offender"));
+
+  for (uint8_t i = 0; i < kRepeatOffenderOverrunCount; i++) {
+    processEventFor(appId, kOverBudget);
+  }
+
+  char expected[32];
+  snprintf(expected, sizeof(expected), "instanceId %" PRIu16 ": overruns",
+           getNanoappByAppId(appId)->getInstanceId());
+  EXPECT_TRUE(debugDumpContains(expected));
+  EXPECT_TRUE(debugDumpContains("(repeat offender)"));
+}
+
+TEST_F(TestEventProcessBudget, OffenderIsRemovedOnUnload) {
+  constexpr uint64_t kOffenderAppId = 0x1234;
+  constexpr uint64_t kOtherAppId = 0x5678;
+  loadNanoapp(MakeUnique<SlowApp>(kOffenderAppId));
+  loadNanoapp(MakeUnique<SlowApp>(kOtherAppId));
+  uint16_t offenderInstanceId =
+      getNanoappByAppId(kOffenderAppId)->getInstanceId();
+  uint16_t otherInstanceId = getNanoappByAppId(kOtherAppId)->getInstanceId();
+
+  processEventFor(kOffenderAppId, kOverBudget);
+  processEventFor(kOtherAppId, kOverBudget);
+  EXPECT_EQ(getNumOffenders(), 2);
+
+  unloadNanoapp(kOffenderAppId);
+  EXPECT_EQ(getNumOffenders(), 1);
+  EXPECT_EQ(getTotalOverrunCount(offenderInstanceId), 0);
+  EXPECT_EQ(getTotalOverrunCount(otherInstanceId), 1);
+}
+
+}  // namespace
+}  // namespace chre
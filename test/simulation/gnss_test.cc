@@ -22,6 +22,7 @@
 #include "chre/core/event_loop_manager.h"
 #include "chre/core/settings.h"
 #include "chre/platform/linux/pal_gnss.h"
+#include "chre/platform/linux/virtual_clock.h"
 #include "chre/platform/log.h"
 #include "chre/util/system/napp_permissions.h"
 #include "chre_api/chre/event.h"
@@ -44,9 +45,9 @@ bool waitForCondition(const std::function<bool()> &predicate,
                       std::chrono::milliseconds timeout) {
   constexpr std::chrono::milliseconds kSleepDuration(100);
   bool result;
-  std::chrono::milliseconds time;
+  std::chrono::milliseconds time(0);
   while (!(result = predicate()) && time < timeout) {
-    std::this_thread::sleep_for(kSleepDuration);
+    platform_linux::sleepFor(Milliseconds(kSleepDuration.count()));
     time += kSleepDuration;
   }
   return result;
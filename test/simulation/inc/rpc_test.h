@@ -40,6 +40,11 @@ class RpcTestService final
   // See generated IncrementService::Service for more details.
   pw::Status Increment(const chre_rpc_NumberMessage &request,
                        chre_rpc_NumberMessage &response);
+
+  // Stream RPC server streaming service definition.
+  // The messages are written one at a time, see writeNextStreamMessage().
+  void Stream(const chre_rpc_NumberMessage &request,
+              pw::rpc::NanopbServerWriter<chre_rpc_NumberMessage> &writer);
 };
 
 class Env {
@@ -50,6 +55,13 @@ class Env {
   pw::rpc::NanopbUnaryReceiver<chre_rpc_NumberMessage> mIncrementCall;
   uint32_t mNumber;
 
+  pw::rpc::NanopbServerWriter<chre_rpc_NumberMessage> mStreamWriter;
+  pw::rpc::NanopbClientReader<chre_rpc_NumberMessage> mStreamCall;
+  uint32_t mNumStreamMessages = 0;
+  uint32_t mNumSentStreamMessages = 0;
+  uint32_t mNumReceivedStreamMessages = 0;
+  bool mStreamInOrder = true;
+
   void closeServer() {
     mServer.close();
   }
@@ -19,10 +19,12 @@
 
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <optional>
 #include <thread>
 
 #include "chre/core/event_loop_manager.h"
 #include "chre/core/nanoapp.h"
+#include "chre/platform/linux/virtual_clock.h"
 #include "chre/platform/system_timer.h"
 #include "chre/util/time.h"
 #include "test_event_queue.h"
@@ -46,6 +48,15 @@ class TestBase : public testing::Test {
     return 5 * kOneSecondInNanoseconds;
   }
 
+  /**
+   * This method can be overridden in a derived class if desired.
+   * @return Whether the test runs in virtual time, see
+   * platform_linux::enableVirtualTime().
+   */
+  virtual bool useVirtualTime() const {
+    return true;
+  }
+
   /**
    * A convenience method to invoke waitForEvent() for the TestEventQueue
    * singleton.
@@ -84,18 +95,22 @@ class TestBase : public testing::Test {
    */
   Nanoapp *getNanoappByAppId(uint64_t id) {
     uint16_t instanceId;
-    EXPECT_TRUE(EventLoopManagerSingleton::get()
-                    ->getEventLoop()
-                    .findNanoappInstanceIdByAppId(id, &instanceId));
-    Nanoapp *nanoapp = EventLoopManagerSingleton::get()
-                           ->getEventLoop()
-                           .findNanoappByInstanceId(instanceId);
+    EXPECT_TRUE(EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+        id, &instanceId));
+    Nanoapp *nanoapp =
+        EventLoopManagerSingleton::get()->findNanoappByInstanceId(instanceId);
     EXPECT_NE(nanoapp, nullptr);
     return nanoapp;
   }
 
   std::thread mChreThread;
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  std::thread mWorkerThreads[CHRE_NUM_WORKER_EVENT_LOOPS];
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
   SystemTimer mSystemTimer;
+
+  //! Makes the test thread take part in virtual time, if enabled.
+  std::optional<platform_linux::VirtualTimeThread> mVirtualTimeThread;
 };
 
 }  // namespace chre
@@ -159,6 +159,17 @@ void loadNanoapp(const char *name, uint64_t appId, uint32_t appVersion,
  */
 uint64_t loadNanoapp(UniquePtr<TestNanoapp> app);
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+/**
+ * Create a static nanoapp and load it in the first worker event loop.
+ *
+ * This function returns after the nanoapp start has been executed.
+ *
+ * @return The id of the nanoapp.
+ */
+uint64_t loadNanoappInWorkerEventLoop(UniquePtr<TestNanoapp> app);
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 /**
  * Unload nanoapp corresponding to appId.
  *
@@ -223,9 +234,8 @@ void sendEventToNanoapp(uint64_t appId, uint16_t eventType,
                         const T &eventData) {
   static_assert(std::is_trivial<T>::value);
   uint16_t instanceId;
-  if (EventLoopManagerSingleton::get()
-          ->getEventLoop()
-          .findNanoappInstanceIdByAppId(appId, &instanceId)) {
+  if (EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+          appId, &instanceId)) {
     auto event = memoryAlloc<TestEvent>();
     ASSERT_NE(event, nullptr);
     event->type = eventType;
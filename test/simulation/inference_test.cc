@@ -0,0 +1,435 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/platform/shared/chre_inference.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/core/inference_manager.h"
+#include "chre_api/chre/event.h"
+
+#include "gtest/gtest.h"
+#include "test_base.h"
+#include "test_event.h"
+#include "test_event_queue.h"
+#include "test_util.h"
+
+namespace chre {
+namespace {
+
+constexpr size_t kNumElements = 16;
+
+/**
+ * The models run by the test backend: an element-wise affine function, with
+ * the arena used for the activations.
+ */
+struct TestModel {
+  float weight;
+  float bias;
+  //! The number of floats of the arena touched when the model is prepared,
+  //! standing in for the tensor allocation of a real interpreter.
+  size_t numPlannedFloats;
+};
+
+const TestModel *gPreparedModel = nullptr;
+float *gActivations = nullptr;
+
+bool testPrepare(const void *model, size_t modelSize, uint8_t *arena,
+                 size_t arenaSize) {
+  auto *testModel = static_cast<const TestModel *>(model);
+  if (modelSize != sizeof(TestModel) ||
+      arenaSize < testModel->numPlannedFloats * sizeof(float) ||
+      testModel->numPlannedFloats < kNumElements) {
+    return false;
+  }
+
+  gActivations = reinterpret_cast<float *>(arena);
+  for (size_t i = 0; i < testModel->numPlannedFloats; i++) {
+    gActivations[i] = 0.0f;
+  }
+  gPreparedModel = testModel;
+  return true;
+}
+
+bool testInvoke(const void *input, size_t inputSize, void *output,
+                size_t outputSize) {
+  constexpr size_t kTensorSize = kNumElements * sizeof(float);
+  if (inputSize != kTensorSize || outputSize < kTensorSize) {
+    return false;
+  }
+
+  memcpy(gActivations, input, kTensorSize);
+  auto *values = static_cast<float *>(output);
+  for (size_t i = 0; i < kNumElements; i++) {
+    values[i] = gPreparedModel->weight * gActivations[i] + gPreparedModel->bias;
+  }
+  return true;
+}
+
+void testRelease() {
+  gPreparedModel = nullptr;
+  gActivations = nullptr;
+}
+
+constexpr InferenceBackend kTestBackend = {testPrepare, testInvoke,
+                                           testRelease};
+
+CREATE_CHRE_TEST_EVENT(REGISTER, 0);
+CREATE_CHRE_TEST_EVENT(INFER, 1);
+CREATE_CHRE_TEST_EVENT(RESULT, 2);
+CREATE_CHRE_TEST_EVENT(UNREGISTER, 3);
+CREATE_CHRE_TEST_EVENT(GET_STATS, 4);
+
+struct RegisterParams {
+  const TestModel *model;
+  size_t arenaSize;
+};
+
+struct RegisterResult {
+  bool success;
+  uint32_t handle;
+};
+
+//! Requests numRequests inferences, the input and cookie of each being one
+//! more than the previous one.
+struct InferParams {
+  uint32_t handle;
+  float input;
+  uint32_t cookie;
+  uint32_t numRequests;
+};
+
+//! InferenceManager::Stats, with trivial types to go through the test queue.
+struct StatsResult {
+  uint32_t numInferences;
+  uint32_t numPrepares;
+  size_t arenaSize;
+  size_t totalModelArenaSize;
+  uint64_t totalLatencyNs;
+};
+
+struct InferResult {
+  uint32_t handle;
+  uint8_t errorCode;
+  float firstOutput;
+  uintptr_t cookie;
+};
+
+/**
+ * Registers models, requests inferences and forwards the results to the test
+ * thread.
+ */
+class InferenceNanoapp : public TestNanoapp {
+ public:
+  explicit InferenceNanoapp(uint64_t id = kDefaultTestNanoappId)
+      : TestNanoapp(TestNanoappInfo{.id = id}) {}
+
+  void handleEvent(uint32_t, uint16_t eventType,
+                   const void *eventData) override {
+    switch (eventType) {
+      case CHRE_EVENT_INFERENCE_RESULT: {
+        auto *result = static_cast<const chreInferenceResult *>(eventData);
+        InferResult forwarded = {
+            .handle = result->modelHandle,
+            .errorCode = result->errorCode,
+            .firstOutput = static_cast<const float *>(result->output)[0],
+            .cookie = reinterpret_cast<uintptr_t>(result->cookie),
+        };
+        TestEventQueueSingleton::get()->pushEvent(RESULT, forwarded);
+        break;
+      }
+
+      case CHRE_EVENT_TEST_EVENT: {
+        auto event = static_cast<const TestEvent *>(eventData);
+        handleTestEvent(*event);
+        break;
+      }
+    }
+  }
+
+ private:
+  void handleTestEvent(const TestEvent &event) {
+    switch (event.type) {
+      case REGISTER: {
+        auto *params = static_cast<const RegisterParams *>(event.data);
+        RegisterResult result;
+        result.success = chreInferenceRegisterModel(
+            params->model, sizeof(TestModel), params->arenaSize,
+            &result.handle);
+        TestEventQueueSingleton::get()->pushEvent(REGISTER, result);
+        break;
+      }
+
+      case INFER: {
+        auto *params = static_cast<const InferParams *>(event.data);
+        bool success = true;
+        for (uint32_t i = 0; i < params->numRequests && success; i++) {
+          // Each request uses its own buffers, as they are used in place.
+          float *input = mInputs[mNextBuffer];
+          float *output = mOutputs[mNextBuffer];
+          mNextBuffer = (mNextBuffer + 1) % kNumBuffers;
+          for (size_t j = 0; j < kNumElements; j++) {
+            input[j] = params->input + static_cast<float>(i);
+          }
+          success = chreInferenceRequest(
+              params->handle, input, sizeof(mInputs[0]), output,
+              sizeof(mOutputs[0]),
+              reinterpret_cast<const void *>(
+                  static_cast<uintptr_t>(params->cookie + i)));
+        }
+        TestEventQueueSingleton::get()->pushEvent(INFER, success);
+        break;
+      }
+
+      case UNREGISTER: {
+        auto *handle = static_cast<const uint32_t *>(event.data);
+        bool success = chreInferenceUnregisterModel(*handle);
+        TestEventQueueSingleton::get()->pushEvent(UNREGISTER, success);
+        break;
+      }
+
+      case GET_STATS: {
+        InferenceManager::Stats stats = EventLoopManagerSingleton::get()
+                                            ->getInferenceManager()
+                                            .getStats();
+        StatsResult result = {
+            .numInferences = stats.numInferences,
+            .numPrepares = stats.numPrepares,
+            .arenaSize = stats.arenaSize,
+            .totalModelArenaSize = stats.totalModelArenaSize,
+            .totalLatencyNs = stats.totalLatency.toRawNanoseconds(),
+        };
+        TestEventQueueSingleton::get()->pushEvent(GET_STATS, result);
+        break;
+      }
+    }
+  }
+
+  static constexpr size_t kNumBuffers = InferenceManager::kMaxPendingRequests;
+  float mInputs[kNumBuffers][kNumElements];
+  float mOutputs[kNumBuffers][kNumElements];
+  size_t mNextBuffer = 0;
+};
+
+class InferenceTest : public TestBase {
+ protected:
+  void SetUp() override {
+    TestBase::SetUp();
+    EventLoopManagerSingleton::get()->getInferenceManager().setBackend(
+        &kTestBackend);
+  }
+
+  uint32_t registerModel(uint64_t appId, const TestModel &model,
+                         size_t arenaSize) {
+    sendEventToNanoapp(appId, REGISTER, RegisterParams{&model, arenaSize});
+    RegisterResult result;
+    waitForEvent(REGISTER, &result);
+    EXPECT_TRUE(result.success);
+    return result.handle;
+  }
+
+  bool requestInference(uint64_t appId, uint32_t handle, float input,
+                        uint32_t cookie = 0, uint32_t numRequests = 1) {
+    sendEventToNanoapp(appId, INFER,
+                       InferParams{handle, input, cookie, numRequests});
+    bool success;
+    waitForEvent(INFER, &success);
+    return success;
+  }
+
+  InferResult waitForResult() {
+    InferResult result;
+    waitForEvent(RESULT, &result);
+    return result;
+  }
+
+  StatsResult getStats(uint64_t appId) {
+    sendEventToNanoapp(appId, GET_STATS);
+    StatsResult stats;
+    waitForEvent(GET_STATS, &stats);
+    return stats;
+  }
+};
+
+TEST_F(InferenceTest, DeliversResultsAsEvents) {
+  static const TestModel kModel = {2.0f, 1.0f, kNumElements};
+  uint64_t appId = loadNanoapp(MakeUnique<InferenceNanoapp>());
+  uint32_t handle = registerModel(appId, kModel, 1024);
+
+  ASSERT_TRUE(requestInference(appId, handle, 3.0f, /*cookie=*/42));
+  InferResult result = waitForResult();
+  EXPECT_EQ(result.handle, handle);
+  EXPECT_EQ(result.errorCode, CHRE_ERROR_NONE);
+  EXPECT_EQ(result.firstOutput, 7.0f);
+  EXPECT_EQ(result.cookie, 42u);
+
+  // Models that don't fit in their arena fail when they are prepared.
+  static const TestModel kTooLargeModel = {1.0f, 0.0f, 1024};
+  uint32_t tooLargeHandle = registerModel(appId, kTooLargeModel, 1024);
+  ASSERT_TRUE(requestInference(appId, tooLargeHandle, 1.0f));
+  EXPECT_EQ(waitForResult().errorCode, CHRE_ERROR);
+}
+
+TEST_F(InferenceTest, RejectsInvalidRequests) {
+  static const TestModel kModel = {1.0f, 0.0f, kNumElements};
+  constexpr uint64_t kOtherAppId = 0x1234;
+  uint64_t appId = loadNanoapp(MakeUnique<InferenceNanoapp>());
+  loadNanoapp(MakeUnique<InferenceNanoapp>(kOtherAppId));
+
+  sendEventToNanoapp(
+      appId, REGISTER,
+      RegisterParams{&kModel, InferenceManager::kMaxArenaSize + 1});
+  RegisterResult result;
+  waitForEvent(REGISTER, &result);
+  EXPECT_FALSE(result.success);
+
+  uint32_t handle = registerModel(appId, kModel, 1024);
+  EXPECT_FALSE(requestInference(appId, handle + 1, 1.0f));
+  // Models can only be used by the nanoapp that registered them.
+  EXPECT_FALSE(requestInference(kOtherAppId, handle, 1.0f));
+
+  sendEventToNanoapp(kOtherAppId, UNREGISTER, handle);
+  bool success;
+  waitForEvent(UNREGISTER, &success);
+  EXPECT_FALSE(success);
+  sendEventToNanoapp(appId, UNREGISTER, handle);
+  waitForEvent(UNREGISTER, &success);
+  EXPECT_TRUE(success);
+  EXPECT_FALSE(requestInference(appId, handle, 1.0f));
+}
+
+TEST_F(InferenceTest, SharesArenaAcrossNanoapps) {
+  static const TestModel kSmallModel = {1.0f, 0.0f, 256};
+  static const TestModel kLargeModel = {1.0f, 1.0f, 1024};
+  constexpr uint64_t kOtherAppId = 0x1234;
+  uint64_t appId = loadNanoapp(MakeUnique<InferenceNanoapp>());
+  loadNanoapp(MakeUnique<InferenceNanoapp>(kOtherAppId));
+  uint32_t smallHandle = registerModel(appId, kSmallModel, 1024);
+  uint32_t largeHandle = registerModel(kOtherAppId, kLargeModel, 4096);
+
+  // The models take turns, each being prepared again after the other ran.
+  ASSERT_TRUE(requestInference(appId, smallHandle, 1.0f));
+  EXPECT_EQ(waitForResult().firstOutput, 1.0f);
+  ASSERT_TRUE(requestInference(kOtherAppId, largeHandle, 1.0f));
+  EXPECT_EQ(waitForResult().firstOutput, 2.0f);
+  ASSERT_TRUE(requestInference(appId, smallHandle, 1.0f));
+  EXPECT_EQ(waitForResult().errorCode, CHRE_ERROR_NONE);
+  ASSERT_TRUE(requestInference(appId, smallHandle, 1.0f));
+  EXPECT_EQ(waitForResult().errorCode, CHRE_ERROR_NONE);
+
+  StatsResult stats = getStats(appId);
+  EXPECT_EQ(stats.numInferences, 4u);
+  EXPECT_EQ(stats.numPrepares, 3u);
+  EXPECT_EQ(stats.arenaSize, 4096u);
+  EXPECT_EQ(stats.totalModelArenaSize, 4096u + 1024u);
+
+  // The arena shrinks with the largest model, and is freed with the last one.
+  unloadNanoapp(kOtherAppId);
+  ASSERT_TRUE(requestInference(appId, smallHandle, 1.0f));
+  EXPECT_EQ(waitForResult().errorCode, CHRE_ERROR_NONE);
+  stats = getStats(appId);
+  EXPECT_EQ(stats.arenaSize, 1024u);
+  EXPECT_EQ(stats.totalModelArenaSize, 1024u);
+
+  sendEventToNanoapp(appId, UNREGISTER, smallHandle);
+  bool success;
+  waitForEvent(UNREGISTER, &success);
+  EXPECT_TRUE(success);
+  stats = getStats(appId);
+  EXPECT_EQ(stats.arenaSize, 0u);
+  EXPECT_EQ(stats.totalModelArenaSize, 0u);
+}
+
+TEST_F(InferenceTest, QueuesRequests) {
+  static const TestModel kModel = {1.0f, 0.0f, kNumElements};
+  uint64_t appId = loadNanoapp(MakeUnique<InferenceNanoapp>());
+  uint32_t handle = registerModel(appId, kModel, 1024);
+
+  // The results are only delivered once all the requests are queued.
+  ASSERT_TRUE(requestInference(appId, handle, /*input=*/0.0f, /*cookie=*/0,
+                               InferenceManager::kMaxPendingRequests));
+  for (uint32_t i = 0; i < InferenceManager::kMaxPendingRequests; i++) {
+    InferResult result = waitForResult();
+    EXPECT_EQ(result.cookie, i);
+    EXPECT_EQ(result.firstOutput, static_cast<float>(i));
+  }
+  EXPECT_EQ(getStats(appId).numPrepares, 1u);
+}
+
+/**
+ * Compares the shared arena with per-nanoapp arenas for three nanoapps running
+ * models of different sizes. Per-nanoapp arenas keep each model prepared, which
+ * is emulated by running the requests of each nanoapp back to back, while the
+ * shared arena is exercised with interleaved requests. Runs in real time. Run
+ * with --gtest_also_run_disabled_tests.
+ */
+class InferenceBenchmark : public InferenceTest {
+ protected:
+  bool useVirtualTime() const override {
+    return false;
+  }
+
+  uint64_t getTimeoutNs() const override {
+    return 60 * kOneSecondInNanoseconds;
+  }
+};
+
+TEST_F(InferenceBenchmark, DISABLED_SharedVersusPerAppArenas) {
+  constexpr size_t kNumApps = 3;
+  constexpr uint32_t kNumRounds = 200;
+  static const TestModel kModels[kNumApps] = {
+      {1.0f, 0.0f, 2048}, {1.0f, 0.0f, 4096}, {1.0f, 0.0f, 8192}};
+  uint64_t appIds[kNumApps];
+  uint32_t handles[kNumApps];
+  for (size_t i = 0; i < kNumApps; i++) {
+    appIds[i] = loadNanoapp(MakeUnique<InferenceNanoapp>(0x100 + i));
+    handles[i] = registerModel(appIds[i], kModels[i],
+                               kModels[i].numPlannedFloats * sizeof(float));
+  }
+
+  auto run = [&](bool interleaved) {
+    StatsResult before = getStats(appIds[0]);
+    for (uint32_t round = 0; round < kNumRounds; round++) {
+      for (size_t i = 0; i < kNumApps; i++) {
+        size_t app = interleaved ? i : (round * kNumApps + i) / kNumRounds;
+        ASSERT_TRUE(requestInference(appIds[app], handles[app], 1.0f));
+        waitForResult();
+      }
+    }
+    StatsResult after = getStats(appIds[0]);
+    uint32_t numInferences = after.numInferences - before.numInferences;
+    uint64_t meanLatencyUs =
+        Microseconds(Nanoseconds(after.totalLatencyNs - before.totalLatencyNs))
+            .getMicroseconds() /
+        numInferences;
+    size_t arenaSize =
+        interleaved ? after.arenaSize : after.totalModelArenaSize;
+    printf("%s: %zu bytes, %" PRIu32 " prepares, mean latency %" PRIu64
+           " us\n",
+           interleaved ? "Shared arena" : "Per-app arenas", arenaSize,
+           after.numPrepares - before.numPrepares, meanLatencyUs);
+  };
+
+  run(/*interleaved=*/false);
+  run(/*interleaved=*/true);
+}
+
+}  // namespace
+}  // namespace chre
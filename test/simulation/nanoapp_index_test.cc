@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/core/nanoapp_index.h"
+
+#include "gtest/gtest.h"
+#include "inc/test_util.h"
+#include "test_base.h"
+#include "test_util.h"
+
+namespace chre {
+namespace {
+
+class NanoappIndexTest : public TestBase {
+ protected:
+  bool isLoaded(uint64_t appId) {
+    uint16_t instanceId;
+    return EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+               appId, &instanceId) &&
+           getNanoappByAppId(appId) != nullptr &&
+           EventLoopManagerSingleton::get()->findNanoappByInstanceId(
+               instanceId) == getNanoappByAppId(appId);
+  }
+};
+
+constexpr uint64_t kFirstAppId = 0x476f6f676c000000;
+constexpr size_t kNumNanoapps = NanoappIndex::kMaxNumNanoapps + 2;
+
+TEST_F(NanoappIndexTest, NanoappsBeyondIndexCapacityCanBeLoaded) {
+  for (uint64_t i = 0; i < kNumNanoapps; i++) {
+    loadNanoapp(
+        MakeUnique<TestNanoapp>(TestNanoappInfo{.id = kFirstAppId + i}));
+  }
+
+  for (uint64_t i = 0; i < kNumNanoapps; i++) {
+    EXPECT_TRUE(isLoaded(kFirstAppId + i));
+  }
+}
+
+TEST_F(NanoappIndexTest, UnindexedNanoappsAreFoundAfterUnload) {
+  for (uint64_t i = 0; i < kNumNanoapps; i++) {
+    loadNanoapp(
+        MakeUnique<TestNanoapp>(TestNanoappInfo{.id = kFirstAppId + i}));
+  }
+
+  unloadNanoapp(kFirstAppId);
+  EXPECT_FALSE(isLoaded(kFirstAppId));
+  for (uint64_t i = 1; i < kNumNanoapps; i++) {
+    EXPECT_TRUE(isLoaded(kFirstAppId + i));
+  }
+}
+
+}  // namespace
+}  // namespace chre
@@ -16,11 +16,14 @@
 
 #include "rpc_test.h"
 
+#include <cinttypes>
 #include <cstdint>
+#include <cstdio>
 
 #include "chre/core/event_loop.h"
 #include "chre/core/event_loop_manager.h"
 #include "chre/core/settings.h"
+#include "chre/platform/system_time.h"
 #include "chre/util/nanoapp/log.h"
 #include "chre/util/time.h"
 #include "chre_api/chre/event.h"
@@ -45,6 +48,53 @@ pw::Status RpcTestService::Increment(const chre_rpc_NumberMessage &request,
 
 namespace {
 
+//! Event sent by the server to itself to write the next stream message.
+constexpr uint16_t kNextStreamMessageEventType = CHRE_EVENT_FIRST_USER_VALUE;
+
+/**
+ * Writes the next message of the stream, then finishes the stream or schedules
+ * the next message.
+ *
+ * Messages are written from successive events so that each packet is delivered
+ * to the client before the next one is sent, as for a stream of samples.
+ */
+void writeNextStreamMessage() {
+  Env *env = EnvSingleton::get();
+
+  chre_rpc_NumberMessage message;
+  message.number = env->mNumSentStreamMessages++;
+  env->mServer.setPermissionForNextMessage(CHRE_MESSAGE_PERMISSION_NONE);
+  env->mStreamWriter.Write(message);
+
+  if (env->mNumSentStreamMessages < env->mNumStreamMessages) {
+    chreSendEvent(kNextStreamMessageEventType, /* eventData= */ nullptr,
+                  /* freeCallback= */ nullptr, chreGetInstanceId());
+  } else {
+    env->mServer.setPermissionForNextMessage(CHRE_MESSAGE_PERMISSION_NONE);
+    env->mStreamWriter.Finish(pw::OkStatus());
+  }
+}
+
+}  // namespace
+
+void RpcTestService::Stream(
+    const chre_rpc_NumberMessage &request,
+    pw::rpc::NanopbServerWriter<chre_rpc_NumberMessage> &writer) {
+  Env *env = EnvSingleton::get();
+  env->mStreamWriter = std::move(writer);
+  env->mNumStreamMessages = request.number;
+  env->mNumSentStreamMessages = 0;
+
+  if (request.number == 0) {
+    env->mServer.setPermissionForNextMessage(CHRE_MESSAGE_PERMISSION_NONE);
+    env->mStreamWriter.Finish(pw::OkStatus());
+  } else {
+    writeNextStreamMessage();
+  }
+}
+
+namespace {
+
 TEST_F(TestBase, PwRpcCanPublishServicesInNanoappStart) {
   class App : public TestNanoapp {
    public:
@@ -353,6 +403,112 @@ TEST_F(TestBase, PwRpcClientNanoappCanRequestServerNanoapp) {
   EnvSingleton::deinit();
 }
 
+TEST_F(TestBase, PwRpcStreamingThroughputBenchmark) {
+  CREATE_CHRE_TEST_EVENT(STREAM_REQUEST, 0);
+
+  class ClientApp : public TestNanoapp {
+   public:
+    ClientApp() : TestNanoapp(TestNanoappInfo{.id = kPwRcpClientAppId}) {}
+
+    void handleEvent(uint32_t senderInstanceId, uint16_t eventType,
+                     const void *eventData) override {
+      Env *env = EnvSingleton::get();
+
+      env->mClient.handleEvent(senderInstanceId, eventType, eventData);
+      switch (eventType) {
+        case CHRE_EVENT_TEST_EVENT: {
+          auto event = static_cast<const TestEvent *>(eventData);
+          switch (event->type) {
+            case STREAM_REQUEST: {
+              auto client =
+                  env->mClient
+                      .get<rpc::pw_rpc::nanopb::RpcTestService::Client>();
+              if (client.has_value()) {
+                chre_rpc_NumberMessage streamRequest;
+                streamRequest.number = *static_cast<uint32_t *>(event->data);
+                env->mStreamCall = client->Stream(
+                    streamRequest,
+                    [](const chre_rpc_NumberMessage &response) {
+                      Env *env = EnvSingleton::get();
+                      if (response.number != env->mNumReceivedStreamMessages) {
+                        env->mStreamInOrder = false;
+                      }
+                      env->mNumReceivedStreamMessages++;
+                    },
+                    [](pw::Status status) {
+                      TestEventQueueSingleton::get()->pushEvent(STREAM_REQUEST,
+                                                                status.ok());
+                    },
+                    [](pw::Status /* status */) {
+                      TestEventQueueSingleton::get()->pushEvent(STREAM_REQUEST,
+                                                                false);
+                    });
+              } else {
+                TestEventQueueSingleton::get()->pushEvent(STREAM_REQUEST,
+                                                          false);
+              }
+            }
+          }
+        }
+      }
+    }
+
+    void end() {
+      EnvSingleton::get()->closeClient();
+    }
+  };
+
+  class ServerApp : public TestNanoapp {
+   public:
+    ServerApp() : TestNanoapp(TestNanoappInfo{.id = kPwRcpServerAppId}) {}
+
+    bool start() override {
+      chre::RpcServer::Service service = {
+          .service = EnvSingleton::get()->mRpcTestService,
+          .id = 0xca8f7150a3f05847,
+          .version = 0x01020034};
+      return EnvSingleton::get()->mServer.registerServices(1, &service);
+    }
+
+    void handleEvent(uint32_t senderInstanceId, uint16_t eventType,
+                     const void *eventData) override {
+      EnvSingleton::get()->mServer.handleEvent(senderInstanceId, eventType,
+                                               eventData);
+      if (eventType == kNextStreamMessageEventType) {
+        writeNextStreamMessage();
+      }
+    }
+
+    void end() {
+      EnvSingleton::get()->closeServer();
+    }
+  };
+
+  EnvSingleton::init();
+  uint64_t serverId = loadNanoapp(MakeUnique<ServerApp>());
+  uint64_t clientId = loadNanoapp(MakeUnique<ClientApp>());
+  bool status;
+  constexpr uint32_t kNumMessages = 1000;
+
+  Nanoseconds start = SystemTime::getMonotonicTime();
+  sendEventToNanoapp(clientId, STREAM_REQUEST, kNumMessages);
+  waitForEvent(STREAM_REQUEST, &status);
+  Nanoseconds duration = SystemTime::getMonotonicTime() - start;
+
+  EXPECT_TRUE(status);
+  EXPECT_EQ(EnvSingleton::get()->mNumReceivedStreamMessages, kNumMessages);
+  EXPECT_TRUE(EnvSingleton::get()->mStreamInOrder);
+
+  uint64_t durationUs = Microseconds(duration).getMicroseconds();
+  printf("Streamed %" PRIu32 " messages in %" PRIu64 " us, %" PRIu64
+         " us per message\n",
+         kNumMessages, durationUs, durationUs / kNumMessages);
+
+  unloadNanoapp(serverId);
+  unloadNanoapp(clientId);
+  EnvSingleton::deinit();
+}
+
 TEST_F(TestBase, PwRpcRpcClientHasServiceCheckForAMatchingService) {
   CREATE_CHRE_TEST_EVENT(QUERY_HAS_SERVICE, 0);
 
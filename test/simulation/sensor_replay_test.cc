@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre_api/chre/sensor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "chre/platform/linux/pal_sensor_replay.h"
+#include "chre_api/chre/event.h"
+
+#include "gtest/gtest.h"
+#include "test_base.h"
+#include "test_event.h"
+#include "test_event_queue.h"
+#include "test_util.h"
+
+namespace chre {
+namespace {
+
+constexpr uint32_t kNumAccelSamples = 100;
+constexpr uint64_t kAccelSamplePeriodNs = 10 * kOneMillisecondInNanoseconds;
+constexpr uint64_t kRequestedIntervalNs = 20 * kOneMillisecondInNanoseconds;
+constexpr uint64_t kRequestedLatencyNs = 100 * kOneMillisecondInNanoseconds;
+
+//! The trace is decimated from 100 Hz to the requested 50 Hz.
+constexpr uint32_t kNumExpectedReadings = kNumAccelSamples / 2;
+
+/**
+ * Replays a 1 second trace with a 100 Hz accelerometer and a 10 Hz barometer,
+ * at the speed given by the test parameter.
+ */
+class SensorReplayTest : public TestBase,
+                         public testing::WithParamInterface<float> {
+ protected:
+  void SetUp() override {
+    std::string path = testing::TempDir() + "sensor_replay_trace.txt";
+    {
+      std::ofstream trace(path);
+      trace << "# Test trace\n"
+            << "sensor 0 accel 5000000 Replay Accelerometer\n"
+            << "sensor 1 baro 40000000 Replay Barometer\n";
+      for (uint32_t i = 0; i < kNumAccelSamples; i++) {
+        uint64_t timestampNs =
+            kOneSecondInNanoseconds + i * kAccelSamplePeriodNs;
+        trace << timestampNs << " 0 " << i << " 0 9.81\n";
+        if (i % 10 == 0) {
+          trace << timestampNs << " 1 1013.25\n";
+        }
+      }
+    }
+
+    ASSERT_TRUE(chrePalSensorLoadReplayTrace(path.c_str(), GetParam()));
+    TestBase::SetUp();
+  }
+
+  void TearDown() override {
+    TestBase::TearDown();
+    chrePalSensorClearReplayTrace();
+  }
+};
+
+struct ReplayStats {
+  uint32_t eventCount;
+  uint32_t readingCount;
+  float lastX;
+  uint32_t minDeltaNs;
+  uint32_t maxDeltaNs;
+};
+
+CREATE_CHRE_TEST_EVENT(CONFIGURE, 0);
+CREATE_CHRE_TEST_EVENT(REPLAY_DONE, 1);
+
+/**
+ * Enables the accelerometer on CONFIGURE and reports the readings it received
+ * once it got the expected number of them.
+ */
+class ReplayApp : public TestNanoapp {
+ public:
+  /**
+   * @param modeOnly Whether to enable the sensor with
+   *     chreSensorConfigureModeOnly(), leaving the interval and the latency to
+   *     their default.
+   * @param numExpectedReadings The number of readings to wait for.
+   */
+  ReplayApp(bool modeOnly, uint32_t numExpectedReadings)
+      : mModeOnly(modeOnly), mNumExpectedReadings(numExpectedReadings) {}
+
+  void handleEvent(uint32_t, uint16_t eventType,
+                   const void *eventData) override {
+    switch (eventType) {
+      case CHRE_EVENT_SENSOR_ACCELEROMETER_DATA: {
+        auto *event =
+            static_cast<const struct chreSensorThreeAxisData *>(eventData);
+        mStats.eventCount++;
+        uint64_t timestampNs = event->header.baseTimestamp;
+        for (uint16_t i = 0; i < event->header.readingCount; i++) {
+          timestampNs += event->readings[i].timestampDelta;
+          if (mStats.readingCount > 0) {
+            auto deltaNs =
+                static_cast<uint32_t>(timestampNs - mLastTimestampNs);
+            mStats.minDeltaNs = std::min(mStats.minDeltaNs, deltaNs);
+            mStats.maxDeltaNs = std::max(mStats.maxDeltaNs, deltaNs);
+          }
+          mLastTimestampNs = timestampNs;
+          mStats.lastX = event->readings[i].x;
+          mStats.readingCount++;
+        }
+        if (mStats.readingCount == mNumExpectedReadings) {
+          TestEventQueueSingleton::get()->pushEvent(REPLAY_DONE, mStats);
+        }
+        break;
+      }
+
+      case CHRE_EVENT_TEST_EVENT: {
+        auto event = static_cast<const TestEvent *>(eventData);
+        if (event->type == CONFIGURE) {
+          uint32_t handle;
+          bool success =
+              chreSensorFindDefault(CHRE_SENSOR_TYPE_ACCELEROMETER, &handle) &&
+              (mModeOnly ? chreSensorConfigureModeOnly(
+                               handle, CHRE_SENSOR_CONFIGURE_MODE_CONTINUOUS)
+                         : chreSensorConfigure(
+                               handle, CHRE_SENSOR_CONFIGURE_MODE_CONTINUOUS,
+                               kRequestedIntervalNs, kRequestedLatencyNs));
+          TestEventQueueSingleton::get()->pushEvent(CONFIGURE, success);
+        }
+        break;
+      }
+    }
+  }
+
+ private:
+  const bool mModeOnly;
+  const uint32_t mNumExpectedReadings;
+  ReplayStats mStats = {.minDeltaNs = UINT32_MAX};
+  uint64_t mLastTimestampNs = 0;
+};
+
+TEST_P(SensorReplayTest, ReplaysDecimatedAndBatchedSamples) {
+  uint64_t appId = loadNanoapp(MakeUnique<ReplayApp>(
+      /* modeOnly= */ false, kNumExpectedReadings));
+
+  sendEventToNanoapp(appId, CONFIGURE);
+  bool success;
+  waitForEvent(CONFIGURE, &success);
+  EXPECT_TRUE(success);
+
+  ReplayStats stats;
+  waitForEvent(REPLAY_DONE, &stats);
+  EXPECT_EQ(stats.readingCount, kNumExpectedReadings);
+  EXPECT_EQ(stats.lastX, kNumAccelSamples - 2);
+  EXPECT_EQ(stats.minDeltaNs, kRequestedIntervalNs);
+  EXPECT_EQ(stats.maxDeltaNs, kRequestedIntervalNs);
+  EXPECT_EQ(chrePalSensorGetReplayedSampleCount(), kNumExpectedReadings);
+  if (GetParam() != kPalSensorReplayAsFastAsPossible) {
+    // Samples are batched according to the requested latency.
+    EXPECT_LT(stats.eventCount, stats.readingCount);
+  }
+}
+
+TEST_P(SensorReplayTest, ModeOnlyReplaysEverySample) {
+  uint64_t appId = loadNanoapp(MakeUnique<ReplayApp>(
+      /* modeOnly= */ true, kNumAccelSamples));
+
+  sendEventToNanoapp(appId, CONFIGURE);
+  bool success;
+  waitForEvent(CONFIGURE, &success);
+  EXPECT_TRUE(success);
+
+  // The default interval is the fastest the trace supports, so nothing is
+  // decimated, and the default latency doesn't overflow the batch end.
+  ReplayStats stats;
+  waitForEvent(REPLAY_DONE, &stats);
+  EXPECT_EQ(stats.readingCount, kNumAccelSamples);
+  EXPECT_EQ(stats.lastX, kNumAccelSamples - 1);
+  EXPECT_EQ(stats.minDeltaNs, kAccelSamplePeriodNs);
+  EXPECT_EQ(stats.maxDeltaNs, kAccelSamplePeriodNs);
+  EXPECT_EQ(chrePalSensorGetReplayedSampleCount(), kNumAccelSamples);
+}
+
+INSTANTIATE_TEST_SUITE_P(SensorReplaySpeeds, SensorReplayTest,
+                         testing::Values(1.0f, 10.0f,
+                                         kPalSensorReplayAsFastAsPossible));
+
+TEST(SensorReplayTrace, RejectsInvalidTraces) {
+  std::string path = testing::TempDir() + "sensor_replay_invalid_trace.txt";
+  auto writeAndLoad = [&path](const char *contents) {
+    {
+      std::ofstream trace(path);
+      trace << contents;
+    }
+    return chrePalSensorLoadReplayTrace(path.c_str());
+  };
+
+  EXPECT_FALSE(writeAndLoad(""));
+  EXPECT_FALSE(writeAndLoad("sensor 1 accel 0\n"));
+  EXPECT_FALSE(writeAndLoad("sensor 0 thermometer 0\n"));
+  EXPECT_FALSE(writeAndLoad("sensor 0 accel 0\n100 1 0 0 0\n"));
+  EXPECT_FALSE(writeAndLoad("sensor 0 accel 0\n100 0 0 0\n"));
+  EXPECT_FALSE(writeAndLoad("sensor 0 baro 0\n200 0 1\n100 0 1\n"));
+  EXPECT_FALSE(chrePalSensorIsReplayTraceLoaded());
+
+  EXPECT_TRUE(writeAndLoad("sensor 0 baro 0 # No name\n100 0 1\n"));
+  EXPECT_TRUE(chrePalSensorIsReplayTraceLoaded());
+  chrePalSensorClearReplayTrace();
+  EXPECT_FALSE(chrePalSensorIsReplayTraceLoaded());
+}
+
+}  // namespace
+}  // namespace chre
@@ -23,6 +23,7 @@
 #include "chre/core/event_loop_manager.h"
 #include "chre/core/settings.h"
 #include "chre/platform/linux/pal_gnss.h"
+#include "chre/platform/linux/virtual_clock.h"
 #include "chre/platform/log.h"
 #include "chre/util/system/napp_permissions.h"
 #include "chre_api/chre/gnss.h"
@@ -156,14 +157,14 @@ TEST_F(TestBase, LocationSettingsTest) {
       EventLoopManagerSingleton::get()->getSettingManager().getSettingEnabled(
           Setting::LOCATION),
       false);
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  platform_linux::sleepFor(Milliseconds(100));
   ASSERT_FALSE(chrePalGnssIsLocationEnabled());
 
   gExpectedLocationSettingState = CHRE_USER_SETTING_STATE_ENABLED;
   EventLoopManagerSingleton::get()->getSettingManager().postSettingChange(
       Setting::LOCATION, true /* enabled */);
   waitForEvent(CHRE_EVENT_SETTING_CHANGED_LOCATION);
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  platform_linux::sleepFor(Milliseconds(100));
   ASSERT_TRUE(
       EventLoopManagerSingleton::get()->getSettingManager().getSettingEnabled(
           Setting::LOCATION));
@@ -196,7 +197,7 @@ TEST_F(TestBase, WifiSettingsTest) {
   EventLoopManagerSingleton::get()->getSettingManager().postSettingChange(
       Setting::WIFI_AVAILABLE, true /* enabled */);
   waitForEvent(CHRE_EVENT_SETTING_CHANGED_WIFI_AVAILABLE);
-  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  platform_linux::sleepFor(Milliseconds(100));
   ASSERT_TRUE(
       EventLoopManagerSingleton::get()->getSettingManager().getSettingEnabled(
           Setting::WIFI_AVAILABLE));
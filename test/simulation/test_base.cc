@@ -22,6 +22,7 @@
 #include "chre/core/init.h"
 #include "chre/platform/linux/platform_log.h"
 #include "chre/platform/linux/task_util/task_manager.h"
+#include "chre/platform/linux/virtual_clock.h"
 #include "chre/util/time.h"
 #include "chre_api/chre/version.h"
 #include "inc/test_util.h"
@@ -42,8 +43,19 @@ namespace chre {
  * To avoid the test from potentially stalling, we also push a timeout event
  * to the TestEventQueue once a fixed timeout has elapsed since the start of
  * this test.
+ *
+ * Unless useVirtualTime() is overridden, the test runs in virtual time: the
+ * clock only advances when the test thread, the CHRE thread and the
+ * TaskManager thread are all idle, so timers fire instantly and in a
+ * deterministic order. The timeout is then in virtual time as well, and fires
+ * right away if the test gets stuck.
  */
 void TestBase::SetUp() {
+  if (useVirtualTime()) {
+    platform_linux::enableVirtualTime();
+    mVirtualTimeThread.emplace();
+  }
+
   // TODO(b/346903946): remove these extra prints once init failure is resolved
   printf("SetUp(): log\n");
   chre::PlatformLogSingleton::init();
@@ -55,8 +67,15 @@ void TestBase::SetUp() {
   chre::init();
   EventLoopManagerSingleton::get()->lateInit();
 
-  mChreThread = std::thread(
+  mChreThread = platform_linux::startVirtualTimeThread(
       []() { EventLoopManagerSingleton::get()->getEventLoop().run(); });
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  for (size_t i = 0; i < CHRE_NUM_WORKER_EVENT_LOOPS; i++) {
+    mWorkerThreads[i] = platform_linux::startVirtualTimeThread([i]() {
+      EventLoopManagerSingleton::get()->getEventLoopByIndex(i + 1).run();
+    });
+  }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
 
   auto callback = [](void *) {
     LOGE("Test timed out ...");
@@ -74,6 +93,14 @@ void TestBase::TearDown() {
   mSystemTimer.cancel();
   // Free memory allocated for event on the test queue.
   TestEventQueueSingleton::get()->flush();
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+  // Stop the worker event loops first, so that the events they forwarded are
+  // still handed back to a running system event loop.
+  for (size_t i = 0; i < CHRE_NUM_WORKER_EVENT_LOOPS; i++) {
+    EventLoopManagerSingleton::get()->getEventLoopByIndex(i + 1).stop();
+    mWorkerThreads[i].join();
+  }
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
   EventLoopManagerSingleton::get()->getEventLoop().stop();
   mChreThread.join();
 
@@ -83,6 +110,11 @@ void TestBase::TearDown() {
   deleteNanoappInfos();
   unregisterAllTestNanoapps();
   chre::PlatformLogSingleton::deinit();
+
+  if (mVirtualTimeThread.has_value()) {
+    mVirtualTimeThread.reset();
+    platform_linux::disableVirtualTime();
+  }
 }
 
 TEST_F(TestBase, CanLoadAndStartSingleNanoapp) {
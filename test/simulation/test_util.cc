@@ -205,9 +205,8 @@ uint64_t loadNanoapp(UniquePtr<TestNanoapp> app) {
 
 void sendEventToNanoapp(uint64_t appId, uint16_t eventType) {
   uint16_t instanceId;
-  if (EventLoopManagerSingleton::get()
-          ->getEventLoop()
-          .findNanoappInstanceIdByAppId(appId, &instanceId)) {
+  if (EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+          appId, &instanceId)) {
     auto event = memoryAlloc<TestEvent>();
     ASSERT_NE(event, nullptr);
     event->type = eventType;
@@ -220,6 +219,33 @@ void sendEventToNanoapp(uint64_t appId, uint16_t eventType) {
   }
 }
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+uint64_t loadNanoappInWorkerEventLoop(UniquePtr<TestNanoapp> app) {
+  TestNanoapp *pApp = app.get();
+  registerNanoapp(std::move(app));
+  UniquePtr<Nanoapp> nanoapp =
+      createStaticNanoapp(pApp->name(), pApp->id(), pApp->version(),
+                          pApp->perms(), &start, &handleEvent, &end);
+
+  auto callback = [](uint16_t /* type */, void *data, void * /* extraData */) {
+    UniquePtr<Nanoapp> nanoapp(static_cast<Nanoapp *>(data));
+    EventLoopManagerSingleton::get()->getCurrentEventLoop().startNanoapp(
+        nanoapp);
+    TestEventQueueSingleton::get()->pushEvent(
+        CHRE_EVENT_SIMULATION_TEST_NANOAPP_LOADED);
+  };
+  EXPECT_TRUE(
+      EventLoopManagerSingleton::get()->getEventLoopByIndex(1).postSystemEvent(
+          static_cast<uint16_t>(SystemCallbackType::FinishLoadingNanoapp),
+          nanoapp.release(), callback, /* extraData= */ nullptr));
+
+  TestEventQueueSingleton::get()->waitForEvent(
+      CHRE_EVENT_SIMULATION_TEST_NANOAPP_LOADED);
+
+  return pApp->id();
+}
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 void unloadNanoapp(uint64_t appId) {
   uint64_t *ptr = memoryAlloc<uint64_t>();
   ASSERT_NE(ptr, nullptr);
@@ -243,14 +269,15 @@ void testFinishLoadingNanoappCallback(SystemCallbackType /* type */,
 
 void testFinishUnloadingNanoappCallback(uint16_t /* type */, void *data,
                                         void * /* extraData */) {
-  EventLoop &eventLoop = EventLoopManagerSingleton::get()->getEventLoop();
-  uint16_t instanceId = 0;
   uint64_t *appId = static_cast<uint64_t *>(data);
-  eventLoop.findNanoappInstanceIdByAppId(*appId, &instanceId);
-  eventLoop.unloadNanoapp(instanceId, true);
+  EventLoopManagerSingleton::get()->unloadNanoapp(
+      *appId, /* allowSystemNanoappUnload= */ true,
+      [](bool /* success */, void * /* cookie */) {
+        TestEventQueueSingleton::get()->pushEvent(
+            CHRE_EVENT_SIMULATION_TEST_NANOAPP_UNLOADED);
+      },
+      /* cookie= */ nullptr);
   memoryFree(data);
-  TestEventQueueSingleton::get()->pushEvent(
-      CHRE_EVENT_SIMULATION_TEST_NANOAPP_UNLOADED);
 }
 
 void freeTestEventDataCallback(uint16_t /*eventType*/, void *eventData) {
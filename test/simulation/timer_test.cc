@@ -178,5 +178,93 @@ TEST_F(TestTimer, CancelPeriodicTimerOnUnload) {
   EXPECT_FALSE(hasNanoappTimers(timerPool, instanceId));
 }
 
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+TEST_F(TestTimer, WorkerNanoappTimersUseWorkerTimerPool) {
+  CREATE_CHRE_TEST_EVENT(START_TIMER, 0);
+  CREATE_CHRE_TEST_EVENT(STOP_TIMER, 1);
+
+  class App : public TestNanoapp {
+   public:
+    void handleEvent(uint32_t, uint16_t eventType,
+                     const void *eventData) override {
+      switch (eventType) {
+        case CHRE_EVENT_TIMER: {
+          auto data = static_cast<const uint32_t *>(eventData);
+          if (*data == mCookie) {
+            mCount++;
+            if (mCount == 3) {
+              TestEventQueueSingleton::get()->pushEvent(
+                  CHRE_EVENT_TIMER, EventLoopManagerSingleton::get()
+                                        ->getEventLoopByIndex(1)
+                                        .isCurrentThread());
+            }
+          }
+          break;
+        }
+
+        case CHRE_EVENT_TEST_EVENT: {
+          auto event = static_cast<const TestEvent *>(eventData);
+          switch (event->type) {
+            case START_TIMER: {
+              mCount = 0;
+              uint32_t handle = chreTimerSet(10 * kOneMillisecondInNanoseconds,
+                                             &mCookie, false /*oneShot*/);
+              TestEventQueueSingleton::get()->pushEvent(START_TIMER, handle);
+              break;
+            }
+            case STOP_TIMER: {
+              auto handle = static_cast<const uint32_t *>(event->data);
+              bool success = chreTimerCancel(*handle);
+              TestEventQueueSingleton::get()->pushEvent(STOP_TIMER, success);
+              break;
+            }
+          }
+        }
+      }
+    }
+
+   protected:
+    const uint32_t mCookie = 123;
+    int mCount = 0;
+  };
+
+  uint64_t appId = loadNanoappInWorkerEventLoop(MakeUnique<App>());
+
+  TimerPool &systemTimerPool =
+      EventLoopManagerSingleton::get()->getEventLoop().getTimerPool();
+  TimerPool &workerTimerPool =
+      EventLoopManagerSingleton::get()->getEventLoopByIndex(1).getTimerPool();
+
+  uint16_t instanceId;
+  EXPECT_TRUE(EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+      appId, &instanceId));
+
+  uint32_t handle;
+  sendEventToNanoapp(appId, START_TIMER);
+  waitForEvent(START_TIMER, &handle);
+  EXPECT_NE(handle, CHRE_TIMER_INVALID);
+  EXPECT_TRUE(hasNanoappTimers(workerTimerPool, instanceId));
+  EXPECT_FALSE(hasNanoappTimers(systemTimerPool, instanceId));
+
+  bool firedInWorkerEventLoop;
+  waitForEvent(CHRE_EVENT_TIMER, &firedInWorkerEventLoop);
+  EXPECT_TRUE(firedInWorkerEventLoop);
+
+  bool success;
+  sendEventToNanoapp(appId, STOP_TIMER, handle);
+  waitForEvent(STOP_TIMER, &success);
+  EXPECT_TRUE(success);
+  EXPECT_FALSE(hasNanoappTimers(workerTimerPool, instanceId));
+
+  // Timers left behind are cancelled when the nanoapp is unloaded.
+  sendEventToNanoapp(appId, START_TIMER);
+  waitForEvent(START_TIMER, &handle);
+  EXPECT_TRUE(hasNanoappTimers(workerTimerPool, instanceId));
+
+  unloadNanoapp(appId);
+  EXPECT_FALSE(hasNanoappTimers(workerTimerPool, instanceId));
+}
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
 }  // namespace
 }  // namespace chre
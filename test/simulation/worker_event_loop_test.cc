@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#include "chre/core/event_loop_manager.h"
+#include "chre/platform/linux/virtual_clock.h"
+#include "chre/platform/log.h"
+#include "chre_api/chre/event.h"
+#include "chre_api/chre/re.h"
+#include "chre_api/chre/sensor.h"
+#include "chre_api/chre/wifi.h"
+
+#include "gtest/gtest.h"
+#include "inc/test_util.h"
+#include "test_base.h"
+#include "test_event.h"
+#include "test_event_queue.h"
+#include "test_util.h"
+
+#if CHRE_NUM_WORKER_EVENT_LOOPS > 0
+
+namespace chre {
+namespace {
+
+class WorkerEventLoopTest : public TestBase {
+ protected:
+  uint16_t getInstanceId(uint64_t appId) {
+    uint16_t instanceId = 0;
+    EXPECT_TRUE(EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+        appId, &instanceId));
+    return instanceId;
+  }
+
+  bool isInWorkerEventLoop(uint64_t appId) {
+    return EventLoopManagerSingleton::get()->findEventLoopByAppId(appId) ==
+           &EventLoopManagerSingleton::get()->getEventLoopByIndex(1);
+  }
+};
+
+constexpr uint64_t kSystemAppId = 0x1234;
+constexpr uint64_t kWorkerAppId = 0x5678;
+
+TEST_F(WorkerEventLoopTest, NanoappInfoIsFoundAcrossEventLoops) {
+  CREATE_CHRE_TEST_EVENT(GET_INFO, 0);
+
+  struct InfoResult {
+    bool foundByAppId;
+    bool foundByInstanceId;
+    uint32_t instanceId;
+  };
+
+  class App : public TestNanoapp {
+   public:
+    explicit App(uint64_t appId) : TestNanoapp(TestNanoappInfo{.id = appId}) {}
+
+    void handleEvent(uint32_t, uint16_t eventType,
+                     const void *eventData) override {
+      if (eventType == CHRE_EVENT_TEST_EVENT) {
+        auto event = static_cast<const TestEvent *>(eventData);
+        if (event->type == GET_INFO) {
+          auto peerAppId = static_cast<const uint64_t *>(event->data);
+          InfoResult result{};
+          chreNanoappInfo info;
+          result.foundByAppId = chreGetNanoappInfoByAppId(*peerAppId, &info);
+          result.instanceId = info.instanceId;
+          result.foundByInstanceId =
+              result.foundByAppId &&
+              chreGetNanoappInfoByInstanceId(info.instanceId, &info) &&
+              info.appId == *peerAppId;
+          TestEventQueueSingleton::get()->pushEvent(GET_INFO, result);
+        }
+      }
+    }
+  };
+
+  loadNanoapp(MakeUnique<App>(kSystemAppId));
+  loadNanoappInWorkerEventLoop(MakeUnique<App>(kWorkerAppId));
+  ASSERT_TRUE(isInWorkerEventLoop(kWorkerAppId));
+
+  InfoResult result;
+  sendEventToNanoapp(kSystemAppId, GET_INFO, kWorkerAppId);
+  waitForEvent(GET_INFO, &result);
+  EXPECT_TRUE(result.foundByAppId);
+  EXPECT_TRUE(result.foundByInstanceId);
+  EXPECT_EQ(result.instanceId, getInstanceId(kWorkerAppId));
+
+  sendEventToNanoapp(kWorkerAppId, GET_INFO, kSystemAppId);
+  waitForEvent(GET_INFO, &result);
+  EXPECT_TRUE(result.foundByAppId);
+  EXPECT_TRUE(result.foundByInstanceId);
+  EXPECT_EQ(result.instanceId, getInstanceId(kSystemAppId));
+}
+
+TEST_F(WorkerEventLoopTest, EventsAreForwardedBetweenEventLoops) {
+  CREATE_CHRE_TEST_EVENT(SEND_EVENT, 0);
+  CREATE_CHRE_TEST_EVENT(EVENT_RECEIVED, 1);
+  constexpr uint16_t kPeerEventType = CHRE_EVENT_FIRST_USER_VALUE;
+
+  class App : public TestNanoapp {
+   public:
+    explicit App(uint64_t appId) : TestNanoapp(TestNanoappInfo{.id = appId}) {}
+
+    void handleEvent(uint32_t senderInstanceId, uint16_t eventType,
+                     const void *eventData) override {
+      if (eventType == kPeerEventType) {
+        TestEventQueueSingleton::get()->pushEvent(EVENT_RECEIVED,
+                                                  senderInstanceId);
+      } else if (eventType == CHRE_EVENT_TEST_EVENT) {
+        auto event = static_cast<const TestEvent *>(eventData);
+        if (event->type == SEND_EVENT) {
+          auto targetInstanceId = static_cast<const uint16_t *>(event->data);
+          EXPECT_TRUE(chreSendEvent(kPeerEventType, /* eventData= */ nullptr,
+                                    /* freeCallback= */ nullptr,
+                                    *targetInstanceId));
+        }
+      }
+    }
+  };
+
+  loadNanoapp(MakeUnique<App>(kSystemAppId));
+  loadNanoappInWorkerEventLoop(MakeUnique<App>(kWorkerAppId));
+  uint16_t systemInstanceId = getInstanceId(kSystemAppId);
+  uint16_t workerInstanceId = getInstanceId(kWorkerAppId);
+
+  uint32_t senderInstanceId;
+  sendEventToNanoapp(kSystemAppId, SEND_EVENT, workerInstanceId);
+  waitForEvent(EVENT_RECEIVED, &senderInstanceId);
+  EXPECT_EQ(senderInstanceId, systemInstanceId);
+
+  sendEventToNanoapp(kWorkerAppId, SEND_EVENT, systemInstanceId);
+  waitForEvent(EVENT_RECEIVED, &senderInstanceId);
+  EXPECT_EQ(senderInstanceId, workerInstanceId);
+}
+
+TEST_F(WorkerEventLoopTest, MessageToHostIsFreedInWorkerEventLoop) {
+  CREATE_CHRE_TEST_EVENT(SEND_MESSAGE, 0);
+  CREATE_CHRE_TEST_EVENT(MESSAGE_FREED, 1);
+
+  class App : public TestNanoapp {
+   public:
+    App() : TestNanoapp(TestNanoappInfo{.id = kWorkerAppId}) {}
+
+    void handleEvent(uint32_t, uint16_t eventType,
+                     const void *eventData) override {
+      if (eventType == CHRE_EVENT_TEST_EVENT) {
+        auto event = static_cast<const TestEvent *>(eventData);
+        if (event->type == SEND_MESSAGE) {
+          void *message = chreHeapAlloc(4);
+          ASSERT_NE(message, nullptr);
+          EXPECT_TRUE(chreSendMessageToHostEndpoint(
+              message, 4, /* messageType= */ 0, CHRE_HOST_ENDPOINT_BROADCAST,
+              freeMessage));
+        }
+      }
+    }
+
+    static void freeMessage(void *message, size_t /* messageSize */) {
+      bool inWorkerEventLoop = EventLoopManagerSingleton::get()
+                                   ->getEventLoopByIndex(1)
+                                   .isCurrentThread() &&
+                               chreGetAppId() == kWorkerAppId;
+      chreHeapFree(message);
+      TestEventQueueSingleton::get()->pushEvent(MESSAGE_FREED,
+                                                inWorkerEventLoop);
+    }
+  };
+
+  loadNanoappInWorkerEventLoop(MakeUnique<App>());
+
+  bool inWorkerEventLoop;
+  sendEventToNanoapp(kWorkerAppId, SEND_MESSAGE);
+  waitForEvent(MESSAGE_FREED, &inWorkerEventLoop);
+  EXPECT_TRUE(inWorkerEventLoop);
+}
+
+TEST_F(WorkerEventLoopTest, HostCanUnloadWorkerNanoapp) {
+  // Written by nanoappEnd(), which completes before unloadNanoapp() returns.
+  static bool sEndedInWorkerEventLoop;
+  sEndedInWorkerEventLoop = false;
+
+  class App : public TestNanoapp {
+   public:
+    App() : TestNanoapp(TestNanoappInfo{.id = kWorkerAppId}) {}
+
+    void end() override {
+      sEndedInWorkerEventLoop = EventLoopManagerSingleton::get()
+                                    ->getEventLoopByIndex(1)
+                                    .isCurrentThread();
+    }
+  };
+
+  loadNanoappInWorkerEventLoop(MakeUnique<App>());
+  ASSERT_TRUE(isInWorkerEventLoop(kWorkerAppId));
+
+  unloadNanoapp(kWorkerAppId);
+  EXPECT_TRUE(sEndedInWorkerEventLoop);
+
+  uint16_t instanceId;
+  EXPECT_FALSE(EventLoopManagerSingleton::get()->findNanoappInstanceIdByAppId(
+      kWorkerAppId, &instanceId));
+}
+
+TEST_F(WorkerEventLoopTest, UnloadingWorkerNanoappDoesNotBlockSystemLoop) {
+  // Set by a callback the nanoapp defers to the system event loop while it is
+  // being unloaded.
+  static std::atomic<bool> sSystemEventLoopRan;
+  static bool sSystemEventLoopRanDuringUnload;
+  sSystemEventLoopRan = false;
+  sSystemEventLoopRanDuringUnload = false;
+
+  class App : public TestNanoapp {
+   public:
+    App() : TestNanoapp(TestNanoappInfo{.id = kWorkerAppId}) {}
+
+    void end() override {
+      auto callback = [](uint16_t /* type */, void * /* data */,
+                         void * /* extraData */) {
+        sSystemEventLoopRan = true;
+      };
+      ASSERT_TRUE(EventLoopManagerSingleton::get()->deferCallback(
+          SystemCallbackType::HandleUnloadNanoapp, /* data= */ nullptr,
+          callback));
+      for (int i = 0; i < 100 && !sSystemEventLoopRan; i++) {
+        platform_linux::sleepFor(Milliseconds(10));
+      }
+      sSystemEventLoopRanDuringUnload = sSystemEventLoopRan;
+    }
+  };
+
+  loadNanoappInWorkerEventLoop(MakeUnique<App>());
+
+  unloadNanoapp(kWorkerAppId);
+  EXPECT_TRUE(sSystemEventLoopRanDuringUnload);
+}
+
+TEST_F(WorkerEventLoopTest, SystemApisAreRejectedInWorkerEventLoop) {
+  CREATE_CHRE_TEST_EVENT(CALL_SYSTEM_APIS, 0);
+
+  struct ApiResult {
+    bool sensorFound;
+    bool wifiScanRequested;
+  };
+
+  class App : public TestNanoapp {
+   public:
+    explicit App(uint64_t appId)
+        : TestNanoapp(TestNanoappInfo{
+              .id = appId, .perms = NanoappPermissions::CHRE_PERMS_WIFI}) {}
+
+    void handleEvent(uint32_t, uint16_t eventType,
+                     const void *eventData) override {
+      if (eventType == CHRE_EVENT_TEST_EVENT) {
+        auto event = static_cast<const TestEvent *>(eventData);
+        if (event->type == CALL_SYSTEM_APIS) {
+          ApiResult result;
+          uint32_t handle;
+          result.sensorFound =
+              chreSensorFindDefault(CHRE_SENSOR_TYPE_UNCALIBRATED_ACCELEROMETER,
+                                    &handle);
+          result.wifiScanRequested =
+              chreWifiRequestScanAsyncDefault(/* cookie= */ nullptr);
+          TestEventQueueSingleton::get()->pushEvent(CALL_SYSTEM_APIS, result);
+        }
+      }
+    }
+  };
+
+  loadNanoapp(MakeUnique<App>(kSystemAppId));
+  loadNanoappInWorkerEventLoop(MakeUnique<App>(kWorkerAppId));
+
+  ApiResult result;
+  sendEventToNanoapp(kSystemAppId, CALL_SYSTEM_APIS);
+  waitForEvent(CALL_SYSTEM_APIS, &result);
+  EXPECT_TRUE(result.sensorFound);
+  EXPECT_TRUE(result.wifiScanRequested);
+
+  sendEventToNanoapp(kWorkerAppId, CALL_SYSTEM_APIS);
+  waitForEvent(CALL_SYSTEM_APIS, &result);
+  EXPECT_FALSE(result.sensorFound);
+  EXPECT_FALSE(result.wifiScanRequested);
+}
+
+}  // namespace
+}  // namespace chre
+
+#endif  // CHRE_NUM_WORKER_EVENT_LOOPS > 0
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_FLAT_HASH_MAP_H_
+#define CHRE_UTIL_FLAT_HASH_MAP_H_
+
+#include <cstddef>
+#include <utility>
+
+#include "chre/util/flat_hash_table.h"
+#include "chre/util/hash.h"
+
+/**
+ * @file
+ * FlatHashMap is an unordered map implemented as an open-addressing hash
+ * table, for lookups by key in constant time without the per-element
+ * allocations of node-based maps. It doesn't throw: operations that may need
+ * memory report failures through their return value. Two variations are
+ * provided:
+ *
+ *  1) FlatHashMap<Key, Value> allocates its slots on the heap, and grows as
+ *  needed.
+ *  2) FixedSizeFlatHashMap<Key, Value, kCapacity> allocates its slots inside
+ *  the object and holds up to kCapacity elements.
+ *
+ * Integer, enum and pointer keys are hashed by default; other key types must
+ * supply a hasher. Inserting or erasing elements invalidates iterators and
+ * pointers to the elements.
+ */
+
+namespace chre {
+
+/**
+ * An element of a FlatHashMap. The key can't be modified in place as that
+ * would break the hash table.
+ */
+template <typename Key, typename Value>
+struct FlatHashMapEntry {
+  template <typename... Args>
+  FlatHashMapEntry(const Key &key_, Args &&...args)
+      : key(key_), value(std::forward<Args>(args)...) {}
+
+  const Key key;
+  Value value;
+};
+
+namespace internal {
+
+template <typename Key, typename Value>
+struct FlatHashMapKeyOf {
+  const Key &operator()(const FlatHashMapEntry<Key, Value> &entry) const {
+    return entry.key;
+  }
+};
+
+/**
+ * The map operations, on top of the hash table of FlatHashTableCore.
+ */
+template <typename Key, typename Value, typename Hasher, class StorageType>
+class FlatHashMapCore
+    : public FlatHashTableCore<Key, FlatHashMapEntry<Key, Value>,
+                               FlatHashMapKeyOf<Key, Value>, Hasher,
+                               StorageType> {
+ public:
+  typedef FlatHashMapEntry<Key, Value> value_type;
+
+  /**
+   * @param key The key to look up.
+   * @return The value associated with the key, or nullptr if not found.
+   */
+  Value *find(const Key &key) {
+    value_type *entry = this->findEntry(key);
+    return (entry == nullptr) ? nullptr : &entry->value;
+  }
+  const Value *find(const Key &key) const {
+    const value_type *entry = this->findEntry(key);
+    return (entry == nullptr) ? nullptr : &entry->value;
+  }
+
+  /**
+   * Inserts a value constructed from args if the key isn't in the map yet.
+   * Otherwise, the map is left unchanged.
+   *
+   * @param key The key of the value.
+   * @param args The arguments to construct the value with.
+   * @return The value associated with the key, or nullptr if it had to be
+   *     inserted and the map is full or the allocation failed.
+   */
+  template <typename... Args>
+  Value *try_emplace(const Key &key, Args &&...args) {
+    value_type *entry =
+        this->tryEmplaceEntry(key, std::forward<Args>(args)...);
+    return (entry == nullptr) ? nullptr : &entry->value;
+  }
+
+  /**
+   * Associates a value with the key, replacing the existing value if any.
+   *
+   * @param key The key of the value.
+   * @param value The value.
+   * @return false if the map is full or the allocation failed.
+   */
+  template <typename ValueType>
+  bool insert_or_assign(const Key &key, ValueType &&value) {
+    value_type *entry = this->findEntry(key);
+    if (entry != nullptr) {
+      entry->value = std::forward<ValueType>(value);
+      return true;
+    }
+    return this->tryEmplaceEntry(key, std::forward<ValueType>(value)) !=
+           nullptr;
+  }
+};
+
+}  // namespace internal
+
+/**
+ * A hash map with its slots allocated on the heap.
+ */
+template <typename Key, typename Value, typename Hasher = Hash<Key>>
+class FlatHashMap
+    : public internal::FlatHashMapCore<
+          Key, Value, Hasher,
+          internal::FlatHashTableDynamicStorage<FlatHashMapEntry<Key, Value>>> {
+};
+
+/**
+ * A hash map with its slots allocated inside the object, holding up to
+ * kCapacity elements.
+ */
+template <typename Key, typename Value, size_t kCapacity,
+          typename Hasher = Hash<Key>>
+class FixedSizeFlatHashMap
+    : public internal::FlatHashMapCore<
+          Key, Value, Hasher,
+          internal::FlatHashTableFixedStorage<FlatHashMapEntry<Key, Value>,
+                                              kCapacity>> {
+  static_assert(kCapacity > 0, "Capacity must be greater than 0");
+};
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_FLAT_HASH_MAP_H_
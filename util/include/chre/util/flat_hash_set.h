@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_FLAT_HASH_SET_H_
+#define CHRE_UTIL_FLAT_HASH_SET_H_
+
+#include <cstddef>
+
+#include "chre/util/flat_hash_table.h"
+#include "chre/util/hash.h"
+
+/**
+ * @file
+ * FlatHashSet is an unordered set implemented as an open-addressing hash
+ * table, the set counterpart of FlatHashMap. Two variations are provided:
+ *
+ *  1) FlatHashSet<Key> allocates its slots on the heap, and grows as needed.
+ *  2) FixedSizeFlatHashSet<Key, kCapacity> allocates its slots inside the
+ *  object and holds up to kCapacity elements.
+ *
+ * Inserting or erasing elements invalidates iterators.
+ */
+
+namespace chre {
+namespace internal {
+
+template <typename Key>
+struct FlatHashSetKeyOf {
+  const Key &operator()(const Key &key) const {
+    return key;
+  }
+};
+
+/**
+ * The set operations, on top of the hash table of FlatHashTableCore. Keys are
+ * stored as const so that they can't be modified through iterators.
+ */
+template <typename Key, typename Hasher, class StorageType>
+class FlatHashSetCore
+    : public FlatHashTableCore<Key, const Key, FlatHashSetKeyOf<Key>, Hasher,
+                               StorageType> {
+ public:
+  typedef Key value_type;
+
+  /**
+   * Adds a key to the set, if not already in it.
+   *
+   * @param key The key to add.
+   * @return true if the key is in the set after the call, false if the set is
+   *     full or the allocation failed.
+   */
+  bool insert(const Key &key) {
+    return this->tryEmplaceEntry(key) != nullptr;
+  }
+};
+
+}  // namespace internal
+
+/**
+ * A hash set with its slots allocated on the heap.
+ */
+template <typename Key, typename Hasher = Hash<Key>>
+class FlatHashSet
+    : public internal::FlatHashSetCore<
+          Key, Hasher, internal::FlatHashTableDynamicStorage<const Key>> {};
+
+/**
+ * A hash set with its slots allocated inside the object, holding up to
+ * kCapacity elements.
+ */
+template <typename Key, size_t kCapacity, typename Hasher = Hash<Key>>
+class FixedSizeFlatHashSet
+    : public internal::FlatHashSetCore<
+          Key, Hasher,
+          internal::FlatHashTableFixedStorage<const Key, kCapacity>> {
+  static_assert(kCapacity > 0, "Capacity must be greater than 0");
+};
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_FLAT_HASH_SET_H_
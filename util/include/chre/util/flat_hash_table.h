@@ -0,0 +1,393 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_FLAT_HASH_TABLE_H_
+#define CHRE_UTIL_FLAT_HASH_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "chre/util/non_copyable.h"
+#include "chre/util/raw_storage.h"
+
+/**
+ * @file
+ * The open-addressing hash table shared by FlatHashMap, FlatHashSet and their
+ * fixed-size variants. Elements are stored in a flat array of slots, probed
+ * linearly from the slot given by the hash of the key, and deletion shifts the
+ * following elements back instead of leaving tombstones, so lookups stay
+ * short regardless of the history of the table.
+ *
+ * Like ArrayQueue, the storage is supplied through a template parameter: either
+ * inline in the object with a fixed capacity, or on the heap, growing as
+ * needed. Users of these containers are not expected to reference the classes
+ * in this file directly, but developers should refer to FlatHashTableCore for
+ * API documentation.
+ */
+
+namespace chre {
+namespace internal {
+
+/**
+ * @return The number of slots of a fixed-size table holding up to kCapacity
+ *     elements, which keeps its load factor at or below 3/4.
+ */
+constexpr size_t getFlatHashTableNumSlots(size_t capacity) {
+  size_t minNumSlots = capacity + (capacity + 2) / 3;
+  size_t numSlots = 2;
+  while (numSlots < minNumSlots) {
+    numSlots *= 2;
+  }
+  return numSlots;
+}
+
+/**
+ * Slots allocated inside the object, holding up to kCapacity elements.
+ */
+template <typename Entry, size_t kCapacity>
+class FlatHashTableFixedStorage : public NonCopyable {
+ public:
+  static constexpr bool kIsGrowable = false;
+  static constexpr size_t kNumSlots = getFlatHashTableNumSlots(kCapacity);
+
+  size_t getNumSlots() const {
+    return kNumSlots;
+  }
+
+  size_t getMaxSize() const {
+    return kCapacity;
+  }
+
+  Entry *getSlots() {
+    return mSlots.data();
+  }
+  const Entry *getSlots() const {
+    return mSlots.data();
+  }
+
+  bool *getOccupancy() {
+    return mIsOccupied;
+  }
+  const bool *getOccupancy() const {
+    return mIsOccupied;
+  }
+
+ private:
+  RawStorage<Entry, kNumSlots> mSlots;
+
+  //! Whether each slot holds an element.
+  bool mIsOccupied[kNumSlots] = {};
+};
+
+/**
+ * Slots allocated on the heap. The number of slots is a power of two, doubled
+ * when the load factor would exceed 3/4.
+ */
+template <typename Entry>
+class FlatHashTableDynamicStorage : public NonCopyable {
+ public:
+  static constexpr bool kIsGrowable = true;
+
+  ~FlatHashTableDynamicStorage();
+
+  size_t getNumSlots() const {
+    return mNumSlots;
+  }
+
+  size_t getMaxSize() const {
+    return mNumSlots - mNumSlots / 4;
+  }
+
+  Entry *getSlots() {
+    return mSlots;
+  }
+  const Entry *getSlots() const {
+    return mSlots;
+  }
+
+  bool *getOccupancy() {
+    return mIsOccupied;
+  }
+  const bool *getOccupancy() const {
+    return mIsOccupied;
+  }
+
+  /**
+   * Replaces the slots with a new, empty array. The caller is responsible for
+   * moving the elements from the previous array, which is returned through
+   * oldSlots and oldOccupancy and must be released with release().
+   *
+   * @param numSlots The new number of slots, a power of two.
+   * @return false if the allocation failed, in which case nothing changes.
+   */
+  bool reallocate(size_t numSlots, Entry *&oldSlots, bool *&oldOccupancy,
+                  size_t &oldNumSlots);
+
+  /**
+   * Releases an array returned by reallocate().
+   */
+  static void release(Entry *slots, bool *occupancy);
+
+ private:
+  Entry *mSlots = nullptr;
+  bool *mIsOccupied = nullptr;
+  size_t mNumSlots = 0;
+};
+
+/**
+ * A forward iterator over the occupied slots of a hash table.
+ */
+template <typename ValueType>
+class FlatHashTableIterator {
+ public:
+  typedef ValueType value_type;
+  typedef ValueType &reference;
+  typedef ValueType *pointer;
+  typedef std::ptrdiff_t difference_type;
+  typedef std::forward_iterator_tag iterator_category;
+
+  FlatHashTableIterator(ValueType *slots, const bool *occupancy, size_t index,
+                        size_t numSlots)
+      : mSlots(slots),
+        mOccupancy(occupancy),
+        mIndex(index),
+        mNumSlots(numSlots) {
+    skipEmptySlots();
+  }
+
+  bool operator==(const FlatHashTableIterator &right) const {
+    return mIndex == right.mIndex;
+  }
+
+  bool operator!=(const FlatHashTableIterator &right) const {
+    return mIndex != right.mIndex;
+  }
+
+  ValueType &operator*() const {
+    return mSlots[mIndex];
+  }
+
+  ValueType *operator->() const {
+    return &mSlots[mIndex];
+  }
+
+  FlatHashTableIterator &operator++() {
+    mIndex++;
+    skipEmptySlots();
+    return *this;
+  }
+
+  FlatHashTableIterator operator++(int) {
+    FlatHashTableIterator it(*this);
+    operator++();
+    return it;
+  }
+
+ private:
+  void skipEmptySlots() {
+    while (mIndex < mNumSlots && !mOccupancy[mIndex]) {
+      mIndex++;
+    }
+  }
+
+  ValueType *mSlots;
+  const bool *mOccupancy;
+  size_t mIndex;
+  size_t mNumSlots;
+};
+
+/**
+ * The core implementation of the hash containers.
+ *
+ * @tparam Key The type of the keys, compared with operator==.
+ * @tparam Entry The type of the elements, constructible from a key followed by
+ *     the arguments passed to tryEmplaceEntry().
+ * @tparam KeyOf A functor returning the key of an element.
+ * @tparam Hasher A functor returning the uint32_t hash of a key.
+ * @tparam StorageType One of the storage classes above.
+ */
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+class FlatHashTableCore : public NonCopyable {
+ public:
+  typedef FlatHashTableIterator<Entry> iterator;
+  typedef FlatHashTableIterator<const Entry> const_iterator;
+
+  /**
+   * Destroys all the elements.
+   */
+  ~FlatHashTableCore();
+
+  /**
+   * @return The number of elements in the container.
+   */
+  size_t size() const {
+    return mSize;
+  }
+
+  /**
+   * @return true if the container has no elements.
+   */
+  bool empty() const {
+    return mSize == 0;
+  }
+
+  /**
+   * @return The number of elements the container can hold without growing,
+   *     or at all for the fixed-size variants.
+   */
+  size_t capacity() const {
+    return mStorage.getNumSlots() == 0 ? 0 : mStorage.getMaxSize();
+  }
+
+  /**
+   * @param key The key to look up.
+   * @return true if an element with the given key is in the container.
+   */
+  bool contains(const Key &key) const {
+    return findSlot(key) != kNotFound;
+  }
+
+  /**
+   * Removes the element with the given key, if any. Invalidates iterators and
+   * pointers to the elements.
+   *
+   * @param key The key of the element to remove.
+   * @return true if an element was removed.
+   */
+  bool erase(const Key &key);
+
+  /**
+   * Removes all the elements, without releasing the memory.
+   */
+  void clear();
+
+  /**
+   * Makes room for at least the given number of elements, so that inserting
+   * up to that many elements doesn't allocate. Only supported by the growable
+   * variants.
+   *
+   * @param numElements The number of elements to make room for.
+   * @return false if the allocation failed.
+   */
+  bool reserve(size_t numElements);
+
+  /**
+   * @return An iterator to the first element. The iteration order is
+   *     unspecified.
+   */
+  iterator begin() {
+    return iterator(mStorage.getSlots(), mStorage.getOccupancy(), 0,
+                    mStorage.getNumSlots());
+  }
+  iterator end() {
+    return iterator(mStorage.getSlots(), mStorage.getOccupancy(),
+                    mStorage.getNumSlots(), mStorage.getNumSlots());
+  }
+  const_iterator begin() const {
+    return cbegin();
+  }
+  const_iterator end() const {
+    return cend();
+  }
+  const_iterator cbegin() const {
+    return const_iterator(mStorage.getSlots(), mStorage.getOccupancy(), 0,
+                          mStorage.getNumSlots());
+  }
+  const_iterator cend() const {
+    return const_iterator(mStorage.getSlots(), mStorage.getOccupancy(),
+                          mStorage.getNumSlots(), mStorage.getNumSlots());
+  }
+
+ protected:
+  /**
+   * @param key The key to look up.
+   * @return The element with the given key, or nullptr if not found.
+   */
+  Entry *findEntry(const Key &key);
+  const Entry *findEntry(const Key &key) const;
+
+  /**
+   * Returns the element with the given key, constructing it from the key and
+   * args if it isn't in the container yet. Invalidates iterators and pointers
+   * to the elements if an element is inserted.
+   *
+   * @param key The key of the element.
+   * @param args The arguments to construct the element with, after the key.
+   * @return The element, or nullptr if it had to be inserted and the container
+   *     is full or the allocation failed.
+   */
+  template <typename... Args>
+  Entry *tryEmplaceEntry(const Key &key, Args &&...args);
+
+ private:
+  //! Returned by findSlot() when the key isn't in the table.
+  static constexpr size_t kNotFound = SIZE_MAX;
+
+  StorageType mStorage;
+
+  //! The number of elements in the table.
+  size_t mSize = 0;
+
+  /**
+   * @return The slot that probing for the key starts from. Only valid when
+   *     the table has slots.
+   */
+  size_t getHomeSlot(const Key &key) const {
+    return Hasher()(key) & (mStorage.getNumSlots() - 1);
+  }
+
+  /**
+   * @return The slot holding the element with the key, or kNotFound.
+   */
+  size_t findSlot(const Key &key) const;
+
+  /**
+   * Makes sure another element can be inserted, growing the table if
+   * supported.
+   *
+   * @return false if the table is full.
+   */
+  bool prepareForInsert();
+
+  /**
+   * Moves all the elements to a new array of slots.
+   *
+   * @return false if the allocation failed.
+   */
+  bool rehash(size_t numSlots);
+
+  /**
+   * Constructs an element in an empty slot. Entry may be const qualified, as
+   * for sets.
+   */
+  template <typename... Args>
+  static Entry *constructAt(Entry *slot, Args &&...args) {
+    return new (const_cast<std::remove_const_t<Entry> *>(slot))
+        Entry(std::forward<Args>(args)...);
+  }
+};
+
+}  // namespace internal
+}  // namespace chre
+
+#include "chre/util/flat_hash_table_impl.h"
+
+#endif  // CHRE_UTIL_FLAT_HASH_TABLE_H_
@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_FLAT_HASH_TABLE_IMPL_H_
+#define CHRE_UTIL_FLAT_HASH_TABLE_IMPL_H_
+
+// IWYU pragma: private
+#include "chre/util/flat_hash_table.h"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "chre/util/container_support.h"
+
+namespace chre {
+namespace internal {
+
+//! The number of slots allocated by a growable table on its first insertion.
+constexpr size_t kFlatHashTableMinNumSlots = 4;
+
+template <typename Entry>
+FlatHashTableDynamicStorage<Entry>::~FlatHashTableDynamicStorage() {
+  release(mSlots, mIsOccupied);
+}
+
+template <typename Entry>
+bool FlatHashTableDynamicStorage<Entry>::reallocate(size_t numSlots,
+                                                    Entry *&oldSlots,
+                                                    bool *&oldOccupancy,
+                                                    size_t &oldNumSlots) {
+  auto *slots = static_cast<Entry *>(memoryAlloc(numSlots * sizeof(Entry)));
+  auto *occupancy = static_cast<bool *>(memoryAlloc(numSlots * sizeof(bool)));
+  if (slots == nullptr || occupancy == nullptr) {
+    release(slots, occupancy);
+    return false;
+  }
+
+  for (size_t i = 0; i < numSlots; i++) {
+    occupancy[i] = false;
+  }
+  oldSlots = mSlots;
+  oldOccupancy = mIsOccupied;
+  oldNumSlots = mNumSlots;
+  mSlots = slots;
+  mIsOccupied = occupancy;
+  mNumSlots = numSlots;
+  return true;
+}
+
+template <typename Entry>
+void FlatHashTableDynamicStorage<Entry>::release(Entry *slots,
+                                                 bool *occupancy) {
+  if (slots != nullptr) {
+    memoryFree(const_cast<std::remove_const_t<Entry> *>(slots));
+  }
+  if (occupancy != nullptr) {
+    memoryFree(occupancy);
+  }
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+FlatHashTableCore<Key, Entry, KeyOf, Hasher,
+                  StorageType>::~FlatHashTableCore() {
+  clear();
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+bool FlatHashTableCore<Key, Entry, KeyOf, Hasher, StorageType>::erase(
+    const Key &key) {
+  size_t hole = findSlot(key);
+  if (hole == kNotFound) {
+    return false;
+  }
+
+  Entry *slots = mStorage.getSlots();
+  bool *occupancy = mStorage.getOccupancy();
+  size_t mask = mStorage.getNumSlots() - 1;
+  slots[hole].~Entry();
+  occupancy[hole] = false;
+  mSize--;
+
+  // Shift back the elements following the hole in the same cluster, unless
+  // that would move them before the slot they hash to.
+  for (size_t i = (hole + 1) & mask; occupancy[i]; i = (i + 1) & mask) {
+    size_t home = getHomeSlot(KeyOf()(slots[i]));
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      constructAt(&slots[hole], std::move(slots[i]));
+      occupancy[hole] = true;
+      slots[i].~Entry();
+      occupancy[i] = false;
+      hole = i;
+    }
+  }
+  return true;
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+void FlatHashTableCore<Key, Entry, KeyOf, Hasher, StorageType>::clear() {
+  Entry *slots = mStorage.getSlots();
+  bool *occupancy = mStorage.getOccupancy();
+  for (size_t i = 0; i < mStorage.getNumSlots() && mSize > 0; i++) {
+    if (occupancy[i]) {
+      slots[i].~Entry();
+      occupancy[i] = false;
+      mSize--;
+    }
+  }
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+bool FlatHashTableCore<Key, Entry, KeyOf, Hasher, StorageType>::reserve(
+    size_t numElements) {
+  static_assert(StorageType::kIsGrowable,
+                "Fixed-size hash containers can't be reserved");
+  size_t numSlots = (mStorage.getNumSlots() == 0) ? kFlatHashTableMinNumSlots
+                                                  : mStorage.getNumSlots();
+  while (numSlots - numSlots / 4 < numElements) {
+    numSlots *= 2;
+  }
+  return numSlots == mStorage.getNumSlots() || rehash(numSlots);
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+Entry *FlatHashTableCore<Key, Entry, KeyOf, Hasher, StorageType>::findEntry(
+    const Key &key) {
+  size_t slot = findSlot(key);
+  return (slot == kNotFound) ? nullptr : &mStorage.getSlots()[slot];
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+const Entry *
+FlatHashTableCore<Key, Entry, KeyOf, Hasher, StorageType>::findEntry(
+    const Key &key) const {
+  size_t slot = findSlot(key);
+  return (slot == kNotFound) ? nullptr : &mStorage.getSlots()[slot];
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+template <typename... Args>
+Entry *FlatHashTableCore<Key, Entry, KeyOf, Hasher,
+                         StorageType>::tryEmplaceEntry(const Key &key,
+                                                       Args &&...args) {
+  Entry *entry = findEntry(key);
+  if (entry == nullptr && prepareForInsert()) {
+    Entry *slots = mStorage.getSlots();
+    bool *occupancy = mStorage.getOccupancy();
+    size_t mask = mStorage.getNumSlots() - 1;
+    size_t slot = getHomeSlot(key);
+    while (occupancy[slot]) {
+      slot = (slot + 1) & mask;
+    }
+    entry = constructAt(&slots[slot], key, std::forward<Args>(args)...);
+    occupancy[slot] = true;
+    mSize++;
+  }
+  return entry;
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+size_t FlatHashTableCore<Key, Entry, KeyOf, Hasher, StorageType>::findSlot(
+    const Key &key) const {
+  if (mSize == 0) {
+    return kNotFound;
+  }
+
+  // The table always has an empty slot, which ends the probing.
+  const Entry *slots = mStorage.getSlots();
+  const bool *occupancy = mStorage.getOccupancy();
+  size_t mask = mStorage.getNumSlots() - 1;
+  for (size_t i = getHomeSlot(key); occupancy[i]; i = (i + 1) & mask) {
+    if (KeyOf()(slots[i]) == key) {
+      return i;
+    }
+  }
+  return kNotFound;
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+bool FlatHashTableCore<Key, Entry, KeyOf, Hasher,
+                       StorageType>::prepareForInsert() {
+  if (mStorage.getNumSlots() != 0 && mSize < mStorage.getMaxSize()) {
+    return true;
+  }
+
+  if constexpr (StorageType::kIsGrowable) {
+    return rehash((mStorage.getNumSlots() == 0) ? kFlatHashTableMinNumSlots
+                                                : mStorage.getNumSlots() * 2);
+  } else {
+    return false;
+  }
+}
+
+template <typename Key, typename Entry, typename KeyOf, typename Hasher,
+          class StorageType>
+bool FlatHashTableCore<Key, Entry, KeyOf, Hasher, StorageType>::rehash(
+    size_t numSlots) {
+  Entry *oldSlots;
+  bool *oldOccupancy;
+  size_t oldNumSlots;
+  if (!mStorage.reallocate(numSlots, oldSlots, oldOccupancy, oldNumSlots)) {
+    return false;
+  }
+
+  Entry *slots = mStorage.getSlots();
+  bool *occupancy = mStorage.getOccupancy();
+  size_t mask = numSlots - 1;
+  for (size_t i = 0; i < oldNumSlots; i++) {
+    if (oldOccupancy[i]) {
+      size_t slot = getHomeSlot(KeyOf()(oldSlots[i]));
+      while (occupancy[slot]) {
+        slot = (slot + 1) & mask;
+      }
+      constructAt(&slots[slot], std::move(oldSlots[i]));
+      occupancy[slot] = true;
+      oldSlots[i].~Entry();
+    }
+  }
+  StorageType::release(oldSlots, oldOccupancy);
+  return true;
+}
+
+}  // namespace internal
+}  // namespace chre
+
+#endif  // CHRE_UTIL_FLAT_HASH_TABLE_IMPL_H_
@@ -19,6 +19,9 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
+
+#include "chre/util/always_false.h"
 
 namespace chre {
 
@@ -30,6 +33,68 @@ namespace chre {
  */
 uint32_t fnv1a32Hash(const uint8_t* data, size_t size);
 
+/**
+ * Mixes the bits of a 32-bit integer so that every input bit affects the low
+ * bits of the result, as needed to index a hash table with a power of two
+ * size. This is the finalizer of MurmurHash3.
+ *
+ * @param value The integer to hash.
+ * @return The hash.
+ */
+constexpr uint32_t hashInteger32(uint32_t value) {
+  value ^= value >> 16;
+  value *= UINT32_C(0x85ebca6b);
+  value ^= value >> 13;
+  value *= UINT32_C(0xc2b2ae35);
+  value ^= value >> 16;
+  return value;
+}
+
+/**
+ * The 64-bit variant of hashInteger32().
+ *
+ * @param value The integer to hash.
+ * @return The hash, folded to 32 bits.
+ */
+constexpr uint32_t hashInteger64(uint64_t value) {
+  value ^= value >> 33;
+  value *= UINT64_C(0xff51afd7ed558ccd);
+  value ^= value >> 33;
+  value *= UINT64_C(0xc4ceb9fe1a85ec53);
+  value ^= value >> 33;
+  return static_cast<uint32_t>(value);
+}
+
+/**
+ * The default hasher of the hash containers, defined for integers, enums and
+ * pointers. Other key types must supply their own hasher, for example based on
+ * fnv1a32Hash().
+ */
+template <typename Key, typename Enable = void>
+struct Hash {
+  static_assert(AlwaysFalse<Key>::value,
+                "No default hash for this key type, supply a hasher");
+};
+
+template <typename Key>
+struct Hash<Key, std::enable_if_t<std::is_integral_v<Key> ||
+                                  std::is_enum_v<Key>>> {
+  constexpr uint32_t operator()(Key key) const {
+    if constexpr (sizeof(Key) <= sizeof(uint32_t)) {
+      return hashInteger32(static_cast<uint32_t>(key));
+    } else {
+      return hashInteger64(static_cast<uint64_t>(key));
+    }
+  }
+};
+
+template <typename Pointee>
+struct Hash<Pointee*> {
+  uint32_t operator()(Pointee* pointer) const {
+    return Hash<uintptr_t>()(reinterpret_cast<uintptr_t>(pointer));
+  }
+};
+
 }  // namespace chre
 
 #endif  // CHRE_UTIL_HASH_H_
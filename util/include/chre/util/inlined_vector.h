@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_INLINED_VECTOR_H_
+#define CHRE_UTIL_INLINED_VECTOR_H_
+
+#include <cstddef>
+
+#include "chre/util/non_copyable.h"
+#include "chre/util/raw_storage.h"
+
+namespace chre {
+
+/**
+ * A container for storing a sequential array of elements, with the same API as
+ * DynamicVector. The first kInlineCapacity elements are stored inside the
+ * object, and the container only moves its elements to the heap when it needs
+ * to grow beyond that. This avoids heap allocations for the many vectors that
+ * usually hold a handful of elements.
+ *
+ * Iterators and references are invalidated as for DynamicVector. In addition,
+ * moving the vector invalidates them while the elements are stored inline.
+ *
+ * @tparam ElementType The type of the elements.
+ * @tparam kInlineCapacity The number of elements stored inside the object.
+ */
+template <typename ElementType, size_t kInlineCapacity>
+class InlinedVector : public NonCopyable {
+ public:
+  static_assert(kInlineCapacity > 0, "Inline capacity must be greater than 0");
+
+  typedef ElementType *iterator;
+  typedef const ElementType *const_iterator;
+  typedef ElementType value_type;
+  typedef size_t size_type;
+
+  /**
+   * Default-constructs an empty vector, using the inline storage.
+   */
+  InlinedVector();
+
+  /**
+   * Move-constructs a vector from another. The other vector is left in an
+   * empty state.
+   *
+   * @param other The other vector to move from.
+   */
+  InlinedVector(InlinedVector &&other);
+
+  /**
+   * Move assigns a vector from another. The other vector is left in an empty
+   * state.
+   */
+  InlinedVector &operator=(InlinedVector &&other);
+
+  /**
+   * Destructs the objects and releases the memory owned by the vector.
+   */
+  ~InlinedVector();
+
+  /**
+   * Removes all elements from the vector, but does not change the capacity.
+   * All iterators and references are invalidated.
+   */
+  void clear();
+
+  /**
+   * Returns a pointer to the underlying buffer, which may be the inline
+   * storage. Not persistent, see DynamicVector::data().
+   *
+   * @return The pointer to the underlying buffer.
+   */
+  ElementType *data() {
+    return mData;
+  }
+  const ElementType *data() const {
+    return mData;
+  }
+
+  /**
+   * @return The number of elements in the vector.
+   */
+  size_type size() const {
+    return mSize;
+  }
+
+  /**
+   * @return The maximum number of elements that can be stored in this vector
+   *     without a resize operation, at least kInlineCapacity.
+   */
+  size_type capacity() const {
+    return mCapacity;
+  }
+
+  /**
+   * @return true if the vector is empty.
+   */
+  bool empty() const {
+    return mSize == 0;
+  }
+
+  /**
+   * @return true if the elements are stored inside the object rather than on
+   *     the heap.
+   */
+  bool isInline() const {
+    return mData == mInlineStorage.data();
+  }
+
+  /**
+   * Erases the last element in the vector. Invalid to call on an empty vector.
+   */
+  void pop_back();
+
+  /**
+   * Copy- or move-constructs an element onto the back of the vector. See
+   * DynamicVector::push_back().
+   *
+   * @param The element to push onto the vector.
+   * @return true if the element was pushed successfully.
+   */
+  bool push_back(const ElementType &element);
+  bool push_back(ElementType &&element);
+
+  /**
+   * Constructs an element onto the back of the vector. See
+   * DynamicVector::emplace_back().
+   *
+   * @param The arguments to the constructor
+   * @return true if the element is constructed successfully.
+   */
+  template <typename... Args>
+  bool emplace_back(Args &&...args);
+
+  /**
+   * Obtains an element of the vector given an index, which must be less than
+   * size().
+   *
+   * @param The index of the element.
+   * @return The element.
+   */
+  ElementType &operator[](size_type index);
+  const ElementType &operator[](size_type index) const;
+
+  /**
+   * Compares two vectors for equality, element by element.
+   *
+   * @param Right-hand side vector to compared with.
+   * @return true if two vectors are equal, false otherwise.
+   */
+  bool operator==(const InlinedVector &other) const;
+
+  /**
+   * Makes room for the given number of elements, moving the elements to the
+   * heap if this exceeds the current capacity. See DynamicVector::reserve().
+   *
+   * @param newCapacity The new capacity of the vector.
+   * @return true if the resize operation was successful.
+   */
+  bool reserve(size_type newCapacity);
+
+  /**
+   * Resizes the vector to a new size, destructing the extraneous objects or
+   * default-constructing the new ones. See DynamicVector::resize().
+   *
+   * @param newSize The new size of the vector.
+   * @return true if the resize operation was successful.
+   */
+  bool resize(size_type newSize);
+
+  /**
+   * Inserts an element into the vector at a given index, which must be <=
+   * size(). See DynamicVector::insert().
+   *
+   * @param index The index to insert an element at.
+   * @param element The element to insert.
+   * @return Whether or not the insert operation was successful.
+   */
+  bool insert(size_type index, const ElementType &element);
+  bool insert(size_type index, ElementType &&element);
+
+  /**
+   * Removes an element from the vector given an index, which must be less than
+   * size(). All elements after the indexed one are moved forward one position.
+   *
+   * @param index The index to remove an element at.
+   */
+  void erase(size_type index);
+
+  /**
+   * Searches the vector for an element.
+   *
+   * @param element The element to comare against.
+   * @return The index of the element found. If the return is equal to size()
+   *         then the element was not found.
+   */
+  size_type find(const ElementType &element) const;
+
+  /**
+   * Swaps the location of two elements stored in the vector. The indices
+   * passed in must be less than the size() of the vector.
+   *
+   * @param index0 The index of the first element
+   * @param index1 The index of the second element
+   */
+  void swap(size_type index0, size_type index1);
+
+  /**
+   * @return The first or last element in the vector. It is illegal to call
+   *     these on an empty vector.
+   */
+  ElementType &front();
+  const ElementType &front() const;
+  ElementType &back();
+  const ElementType &back() const;
+
+  /**
+   * Prepares a vector to push a minimum of one element onto the back, doubling
+   * its capacity if it is full.
+   *
+   * @return Whether or not the resize was successful.
+   */
+  bool prepareForPush();
+
+  /**
+   * @return A random-access iterator to the beginning.
+   */
+  iterator begin() {
+    return mData;
+  }
+  const_iterator begin() const {
+    return mData;
+  }
+  const_iterator cbegin() const {
+    return mData;
+  }
+
+  /**
+   * @return A random-access iterator to the end.
+   */
+  iterator end() {
+    return mData + mSize;
+  }
+  const_iterator end() const {
+    return mData + mSize;
+  }
+  const_iterator cend() const {
+    return mData + mSize;
+  }
+
+ private:
+  //! The storage for the first kInlineCapacity elements.
+  RawStorage<ElementType, kInlineCapacity> mInlineStorage;
+
+  //! Either the inline storage or a heap allocation of mCapacity elements.
+  ElementType *mData = mInlineStorage.data();
+
+  //! The number of elements stored.
+  size_t mSize = 0;
+
+  //! The number of elements that mData can hold.
+  size_t mCapacity = kInlineCapacity;
+
+  /**
+   * Takes the elements of another vector, leaving it empty and inline.
+   */
+  void moveFrom(InlinedVector &other);
+
+  /**
+   * Destroys the elements and releases the heap allocation if any, going back
+   * to the inline storage.
+   */
+  void reset();
+
+  /**
+   * Prepares the vector for insertion - upon successful return, the memory at
+   * the given index is uninitialized and counted in the size.
+   */
+  bool prepareInsert(size_type index);
+};
+
+}  // namespace chre
+
+#include "chre/util/inlined_vector_impl.h"
+
+#endif  // CHRE_UTIL_INLINED_VECTOR_H_
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_INLINED_VECTOR_IMPL_H_
+#define CHRE_UTIL_INLINED_VECTOR_IMPL_H_
+
+// IWYU pragma: private
+#include "chre/util/inlined_vector.h"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "chre/util/container_support.h"
+#include "chre/util/memory.h"
+
+namespace chre {
+
+template <typename ElementType, size_t kInlineCapacity>
+InlinedVector<ElementType, kInlineCapacity>::InlinedVector() {}
+
+template <typename ElementType, size_t kInlineCapacity>
+InlinedVector<ElementType, kInlineCapacity>::InlinedVector(
+    InlinedVector &&other) {
+  moveFrom(other);
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+InlinedVector<ElementType, kInlineCapacity> &
+InlinedVector<ElementType, kInlineCapacity>::operator=(InlinedVector &&other) {
+  if (this != &other) {
+    reset();
+    moveFrom(other);
+  }
+
+  return *this;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+InlinedVector<ElementType, kInlineCapacity>::~InlinedVector() {
+  reset();
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+void InlinedVector<ElementType, kInlineCapacity>::clear() {
+  destroy(mData, mSize);
+  mSize = 0;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+void InlinedVector<ElementType, kInlineCapacity>::pop_back() {
+  CHRE_ASSERT(!empty());
+  erase(mSize - 1);
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::push_back(
+    const ElementType &element) {
+  bool spaceAvailable = prepareForPush();
+  if (spaceAvailable) {
+    new (&mData[mSize++]) ElementType(element);
+  }
+
+  return spaceAvailable;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::push_back(
+    ElementType &&element) {
+  bool spaceAvailable = prepareForPush();
+  if (spaceAvailable) {
+    new (&mData[mSize++]) ElementType(std::move(element));
+  }
+
+  return spaceAvailable;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+template <typename... Args>
+bool InlinedVector<ElementType, kInlineCapacity>::emplace_back(
+    Args &&...args) {
+  bool spaceAvailable = prepareForPush();
+  if (spaceAvailable) {
+    new (&mData[mSize++]) ElementType(std::forward<Args>(args)...);
+  }
+
+  return spaceAvailable;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+ElementType &InlinedVector<ElementType, kInlineCapacity>::operator[](
+    size_type index) {
+  CHRE_ASSERT(index < mSize);
+  return mData[index];
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+const ElementType &InlinedVector<ElementType, kInlineCapacity>::operator[](
+    size_type index) const {
+  CHRE_ASSERT(index < mSize);
+  return mData[index];
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::operator==(
+    const InlinedVector &other) const {
+  bool vectorsAreEqual = (mSize == other.mSize);
+  if (vectorsAreEqual) {
+    for (size_type i = 0; i < mSize; i++) {
+      if (!(mData[i] == other.mData[i])) {
+        vectorsAreEqual = false;
+        break;
+      }
+    }
+  }
+
+  return vectorsAreEqual;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::reserve(
+    size_type newCapacity) {
+  bool success = (newCapacity <= mCapacity);
+  if (!success) {
+    auto *newData = static_cast<ElementType *>(
+        memoryAlloc(newCapacity * sizeof(ElementType)));
+    if (newData != nullptr) {
+      uninitializedMoveOrCopy(mData, mSize, newData);
+      destroy(mData, mSize);
+      if (!isInline()) {
+        memoryFree(mData);
+      }
+      mData = newData;
+      mCapacity = newCapacity;
+      success = true;
+    }
+  }
+
+  return success;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::resize(size_type newSize) {
+  // Remove elements from the back to minimize move operations.
+  while (mSize > newSize) {
+    pop_back();
+  }
+
+  bool success = reserve(newSize);
+  if (success) {
+    while (mSize < newSize) {
+      new (&mData[mSize++]) ElementType();
+    }
+  }
+
+  return success;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::insert(
+    size_type index, const ElementType &element) {
+  bool inserted = prepareInsert(index);
+  if (inserted) {
+    new (&mData[index]) ElementType(element);
+  }
+  return inserted;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::insert(
+    size_type index, ElementType &&element) {
+  bool inserted = prepareInsert(index);
+  if (inserted) {
+    new (&mData[index]) ElementType(std::move(element));
+  }
+  return inserted;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+void InlinedVector<ElementType, kInlineCapacity>::erase(size_type index) {
+  CHRE_ASSERT(index < mSize);
+  mSize--;
+  for (size_type i = index; i < mSize; i++) {
+    moveOrCopyAssign(mData[i], mData[i + 1]);
+  }
+
+  mData[mSize].~ElementType();
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+typename InlinedVector<ElementType, kInlineCapacity>::size_type
+InlinedVector<ElementType, kInlineCapacity>::find(
+    const ElementType &element) const {
+  size_type i;
+  for (i = 0; i < mSize; i++) {
+    if (mData[i] == element) {
+      break;
+    }
+  }
+
+  return i;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+void InlinedVector<ElementType, kInlineCapacity>::swap(size_type index0,
+                                                       size_type index1) {
+  CHRE_ASSERT(index0 < mSize && index1 < mSize);
+  if (index0 != index1) {
+    typename std::aligned_storage<sizeof(ElementType),
+                                  alignof(ElementType)>::type tempStorage;
+    ElementType &temp = *reinterpret_cast<ElementType *>(&tempStorage);
+    uninitializedMoveOrCopy(&mData[index0], 1, &temp);
+    moveOrCopyAssign(mData[index0], mData[index1]);
+    moveOrCopyAssign(mData[index1], temp);
+    temp.~ElementType();
+  }
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+ElementType &InlinedVector<ElementType, kInlineCapacity>::front() {
+  CHRE_ASSERT(mSize > 0);
+  return mData[0];
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+const ElementType &InlinedVector<ElementType, kInlineCapacity>::front() const {
+  CHRE_ASSERT(mSize > 0);
+  return mData[0];
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+ElementType &InlinedVector<ElementType, kInlineCapacity>::back() {
+  CHRE_ASSERT(mSize > 0);
+  return mData[mSize - 1];
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+const ElementType &InlinedVector<ElementType, kInlineCapacity>::back() const {
+  CHRE_ASSERT(mSize > 0);
+  return mData[mSize - 1];
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::prepareForPush() {
+  return (mSize < mCapacity) || reserve(mCapacity * 2);
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+void InlinedVector<ElementType, kInlineCapacity>::moveFrom(
+    InlinedVector &other) {
+  if (other.isInline()) {
+    uninitializedMoveOrCopy(other.mData, other.mSize, mInlineStorage.data());
+    destroy(other.mData, other.mSize);
+    mData = mInlineStorage.data();
+    mCapacity = kInlineCapacity;
+  } else {
+    mData = other.mData;
+    mCapacity = other.mCapacity;
+    other.mData = other.mInlineStorage.data();
+    other.mCapacity = kInlineCapacity;
+  }
+  mSize = other.mSize;
+  other.mSize = 0;
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+void InlinedVector<ElementType, kInlineCapacity>::reset() {
+  clear();
+  if (!isInline()) {
+    memoryFree(mData);
+    mData = mInlineStorage.data();
+    mCapacity = kInlineCapacity;
+  }
+}
+
+template <typename ElementType, size_t kInlineCapacity>
+bool InlinedVector<ElementType, kInlineCapacity>::prepareInsert(
+    size_type index) {
+  // Insertions are not allowed to create a sparse array.
+  CHRE_ASSERT(index <= mSize);
+
+  bool readyForInsert = (index <= mSize && prepareForPush());
+  if (readyForInsert) {
+    // If we aren't simply appending the new object, create an opening where
+    // we'll insert it
+    if (index < mSize) {
+      // Make a duplicate of the last item in the slot where we're growing
+      uninitializedMoveOrCopy(&mData[mSize - 1], 1, &mData[mSize]);
+      // Shift all elements starting at index towards the end
+      for (size_type i = mSize - 1; i > index; i--) {
+        moveOrCopyAssign(mData[i], mData[i - 1]);
+      }
+
+      mData[index].~ElementType();
+    }
+
+    mSize++;
+  }
+
+  return readyForInsert;
+}
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_INLINED_VECTOR_IMPL_H_
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_MULTI_LEVEL_BLOCKING_QUEUE_H_
+#define CHRE_UTIL_MULTI_LEVEL_BLOCKING_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/platform/condition_variable.h"
+#include "chre/platform/mutex.h"
+#include "chre/util/non_copyable.h"
+#include "chre/util/raw_storage.h"
+
+namespace chre {
+
+/**
+ * A thread-safe blocking queue made of several FIFO queues, one per priority
+ * level. pop() returns the oldest element of the highest priority non-empty
+ * level (level 0 being the highest priority), except that a non-empty level
+ * that has been bypassed starvationLimit times in a row by higher priority
+ * levels is served next, so that no level is starved.
+ *
+ * @tparam ElementType The type of element stored in the queue.
+ * @tparam QueueStorageType The FIFO container used for each level, e.g.
+ *     ArrayQueue or SegmentedQueue. Must provide push(), front(), pop(),
+ *     empty() and size().
+ * @tparam kNumLevels The number of priority levels.
+ */
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+class MultiLevelBlockingQueue : public NonCopyable {
+  static_assert(kNumLevels > 0, "At least one level is required");
+
+ public:
+  /**
+   * @param starvationLimit The number of consecutive times a non-empty level
+   *     can be bypassed before it is served. 0 disables starvation protection.
+   * @param args Arguments forwarded to the constructor of the storage of each
+   *     level.
+   */
+  template <typename... Args>
+  explicit MultiLevelBlockingQueue(uint8_t starvationLimit, Args &&...args);
+
+  ~MultiLevelBlockingQueue();
+
+  /**
+   * @return true if all the levels are empty.
+   */
+  bool empty();
+
+  /**
+   * @return The number of elements across all the levels.
+   */
+  size_t size();
+
+  /**
+   * @param level The priority level, must be less than kNumLevels.
+   * @return The number of elements in the given level.
+   */
+  size_t size(size_t level);
+
+  /**
+   * Pushes an element at the back of a level and notifies any waiting thread
+   * that an element is available.
+   *
+   * @param element The element to be pushed.
+   * @param level The priority level, must be less than kNumLevels.
+   * @return true if the element is pushed successfully.
+   */
+  bool push(const ElementType &element, size_t level);
+
+  /**
+   * Pops the next element to be processed, blocking until an element has
+   * been pushed if the queue is empty.
+   *
+   * @return The element that was popped.
+   */
+  ElementType pop();
+
+  /**
+   * Removes matching elements from the back of the levels, starting with the
+   * lowest priority level, until maxNumOfElementsRemoved elements have been
+   * removed. Only available if QueueStorageType supports it.
+   *
+   * @see SegmentedQueue::removeMatchedFromBack
+   *
+   * @return The number of elements removed.
+   */
+  template <typename MatchingFunction, typename FreeFunction>
+  size_t removeMatchedFromBack(MatchingFunction *matchFunction, void *data,
+                               void *extraData, size_t maxNumOfElementsRemoved,
+                               FreeFunction *freeFunction,
+                               void *extraDataForFreeFunction);
+
+  /**
+   * @return The number of priority levels.
+   */
+  static constexpr size_t getNumLevels() {
+    return kNumLevels;
+  }
+
+ private:
+  //! The FIFO queues of each level.
+  RawStorage<QueueStorageType, kNumLevels> mLevels;
+
+  //! The number of consecutive pops that bypassed each level while it was not
+  //! empty.
+  uint8_t mBypassCounts[kNumLevels] = {};
+
+  //! @see MultiLevelBlockingQueue().
+  const uint8_t mStarvationLimit;
+
+  //! Protects all the levels.
+  Mutex mMutex;
+
+  //! Signaled when an element is pushed.
+  ConditionVariable mConditionVariable;
+
+  /**
+   * Selects the level to pop the next element from, and updates the bypass
+   * counts accordingly. mMutex must be held and at least one level must be
+   * non-empty.
+   *
+   * @return The level to pop from.
+   */
+  size_t selectLevelLocked();
+};
+
+}  // namespace chre
+
+#include "chre/util/multi_level_blocking_queue_impl.h"
+
+#endif  // CHRE_UTIL_MULTI_LEVEL_BLOCKING_QUEUE_H_
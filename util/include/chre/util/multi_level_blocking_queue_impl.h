@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_MULTI_LEVEL_BLOCKING_QUEUE_IMPL_H_
+#define CHRE_UTIL_MULTI_LEVEL_BLOCKING_QUEUE_IMPL_H_
+
+// IWYU pragma: private
+#include "chre/util/multi_level_blocking_queue.h"
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include "chre/util/container_support.h"
+#include "chre/util/lock_guard.h"
+
+namespace chre {
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+template <typename... Args>
+MultiLevelBlockingQueue<ElementType, QueueStorageType, kNumLevels>::
+    MultiLevelBlockingQueue(uint8_t starvationLimit, Args &&...args)
+    : mStarvationLimit(starvationLimit) {
+  for (size_t i = 0; i < kNumLevels; i++) {
+    new (&mLevels[i]) QueueStorageType(args...);
+  }
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+MultiLevelBlockingQueue<ElementType, QueueStorageType,
+                        kNumLevels>::~MultiLevelBlockingQueue() {
+  for (size_t i = 0; i < kNumLevels; i++) {
+    mLevels[i].~QueueStorageType();
+  }
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+bool MultiLevelBlockingQueue<ElementType, QueueStorageType,
+                             kNumLevels>::empty() {
+  LockGuard<Mutex> lock(mMutex);
+  for (size_t i = 0; i < kNumLevels; i++) {
+    if (!mLevels[i].empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+size_t MultiLevelBlockingQueue<ElementType, QueueStorageType,
+                               kNumLevels>::size() {
+  LockGuard<Mutex> lock(mMutex);
+  size_t size = 0;
+  for (size_t i = 0; i < kNumLevels; i++) {
+    size += mLevels[i].size();
+  }
+  return size;
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+size_t MultiLevelBlockingQueue<ElementType, QueueStorageType,
+                               kNumLevels>::size(size_t level) {
+  CHRE_ASSERT(level < kNumLevels);
+  LockGuard<Mutex> lock(mMutex);
+  return (level < kNumLevels) ? mLevels[level].size() : 0;
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+bool MultiLevelBlockingQueue<ElementType, QueueStorageType, kNumLevels>::push(
+    const ElementType &element, size_t level) {
+  CHRE_ASSERT(level < kNumLevels);
+  bool success = false;
+  if (level < kNumLevels) {
+    LockGuard<Mutex> lock(mMutex);
+    success = mLevels[level].push(element);
+  }
+  if (success) {
+    mConditionVariable.notify_one();
+  }
+  return success;
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+ElementType
+MultiLevelBlockingQueue<ElementType, QueueStorageType, kNumLevels>::pop() {
+  LockGuard<Mutex> lock(mMutex);
+  size_t level;
+  while ((level = selectLevelLocked()) == kNumLevels) {
+    mConditionVariable.wait(mMutex);
+  }
+
+  ElementType element(std::move(mLevels[level].front()));
+  mLevels[level].pop();
+  return element;
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+template <typename MatchingFunction, typename FreeFunction>
+size_t MultiLevelBlockingQueue<ElementType, QueueStorageType, kNumLevels>::
+    removeMatchedFromBack(MatchingFunction *matchFunction, void *data,
+                          void *extraData, size_t maxNumOfElementsRemoved,
+                          FreeFunction *freeFunction,
+                          void *extraDataForFreeFunction) {
+  LockGuard<Mutex> lock(mMutex);
+  size_t numRemoved = 0;
+  for (size_t i = kNumLevels; i > 0 && numRemoved < maxNumOfElementsRemoved;
+       i--) {
+    size_t numRemovedFromLevel = mLevels[i - 1].removeMatchedFromBack(
+        matchFunction, data, extraData, maxNumOfElementsRemoved - numRemoved,
+        freeFunction, extraDataForFreeFunction);
+    if (numRemovedFromLevel != SIZE_MAX) {
+      numRemoved += numRemovedFromLevel;
+    }
+  }
+  return numRemoved;
+}
+
+template <typename ElementType, class QueueStorageType, size_t kNumLevels>
+size_t MultiLevelBlockingQueue<ElementType, QueueStorageType,
+                               kNumLevels>::selectLevelLocked() {
+  size_t selected = kNumLevels;
+  for (size_t i = 0; i < kNumLevels; i++) {
+    if (mLevels[i].empty()) {
+      continue;
+    }
+    if (selected == kNumLevels) {
+      selected = i;
+    } else if (mStarvationLimit > 0 && mBypassCounts[i] >= mStarvationLimit &&
+               (mBypassCounts[selected] < mStarvationLimit ||
+                mBypassCounts[i] > mBypassCounts[selected])) {
+      // Serve the most bypassed starving level
+      selected = i;
+    }
+  }
+
+  if (selected != kNumLevels) {
+    mBypassCounts[selected] = 0;
+    for (size_t i = 0; i < kNumLevels; i++) {
+      if (i != selected && !mLevels[i].empty() && mBypassCounts[i] < UINT8_MAX) {
+        mBypassCounts[i]++;
+      }
+    }
+  }
+  return selected;
+}
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_MULTI_LEVEL_BLOCKING_QUEUE_IMPL_H_
@@ -85,6 +85,7 @@ constexpr uint64_t kPowerTestAppId        = makeExampleNanoappId(15);
 constexpr uint64_t kDebugDumpWorldAppId   = makeExampleNanoappId(17);
 constexpr uint64_t kBleWorldAppId         = makeExampleNanoappId(18);
 constexpr uint64_t kRpcWorldAppId         = makeExampleNanoappId(19);
+constexpr uint64_t kTflmDemoAppId         = makeExampleNanoappId(20);
 // clang-format on
 
 }  // namespace chre
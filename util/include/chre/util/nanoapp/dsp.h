@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_NANOAPP_DSP_H_
+#define CHRE_UTIL_NANOAPP_DSP_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file
+ * Signal-processing building blocks shared by nanoapps: common types,
+ * fixed-point helpers, window functions and spectrum magnitudes. See also
+ * fft.h, filter.h and mel_filterbank.h.
+ *
+ * Nothing here allocates memory. The inner loops are written to be
+ * auto-vectorized by the compiler on targets with SIMD support, and are plain
+ * scalar loops elsewhere.
+ */
+
+//! Tells the compiler that the iterations of the following loop are
+//! independent, so that it can be vectorized.
+#if defined(__clang__)
+#define CHRE_DSP_VECTORIZE_LOOP \
+  _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define CHRE_DSP_VECTORIZE_LOOP _Pragma("GCC ivdep")
+#else
+#define CHRE_DSP_VECTORIZE_LOOP
+#endif
+
+//! Tells the compiler that a pointer doesn't alias any other.
+#if defined(__GNUC__) || defined(__clang__)
+#define CHRE_DSP_RESTRICT __restrict__
+#else
+#define CHRE_DSP_RESTRICT
+#endif
+
+namespace chre {
+
+//! A complex number in single-precision floating point.
+struct ComplexF {
+  float re;
+  float im;
+};
+
+//! A complex number in Q15 fixed point.
+struct ComplexQ15 {
+  int16_t re;
+  int16_t im;
+};
+
+/**
+ * Converts a value in [-1, 1) to Q15, saturating out of range values.
+ */
+int16_t floatToQ15(float value);
+
+/**
+ * Converts a Q15 value to floating point.
+ */
+inline float q15ToFloat(int16_t value) {
+  return static_cast<float>(value) * (1.0f / 32768.0f);
+}
+
+/**
+ * Saturates a 32-bit value to the range of Q15.
+ */
+inline int16_t saturateQ15(int32_t value) {
+  if (value > INT16_MAX) {
+    return INT16_MAX;
+  } else if (value < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return static_cast<int16_t>(value);
+}
+
+/**
+ * Multiplies two Q15 values, rounding to nearest.
+ */
+inline int16_t multiplyQ15(int16_t a, int16_t b) {
+  return saturateQ15((static_cast<int32_t>(a) * b + (1 << 14)) >> 15);
+}
+
+enum class WindowType : uint8_t {
+  RECTANGULAR,
+  HANN,
+  HAMMING,
+  BLACKMAN,
+};
+
+/**
+ * Generates the coefficients of a periodic window, as used for spectral
+ * analysis where consecutive frames overlap.
+ *
+ * @param type The window function.
+ * @param window Populated with size coefficients.
+ * @param size The size of the window.
+ */
+void generateWindow(WindowType type, float *window, size_t size);
+
+/**
+ * Same as generateWindow(), in Q15. A coefficient of 1 saturates to
+ * INT16_MAX.
+ */
+void generateWindowQ15(WindowType type, int16_t *window, size_t size);
+
+/**
+ * Multiplies a frame by a window. The output can be the input.
+ *
+ * @param input The frame of size samples.
+ * @param window The window of size coefficients.
+ * @param output Populated with size windowed samples.
+ * @param size The size of the frame.
+ */
+void applyWindow(const float *input, const float *window, float *output,
+                 size_t size);
+
+/**
+ * Same as applyWindow(), in Q15.
+ */
+void applyWindowQ15(const int16_t *input, const int16_t *window,
+                    int16_t *output, size_t size);
+
+/**
+ * Computes the dot product of two vectors, with several accumulators so that
+ * it can be vectorized without reordering floating point additions.
+ */
+float dotProduct(const float *a, const float *b, size_t size);
+
+/**
+ * Computes the squared magnitudes of a spectrum.
+ *
+ * @param spectrum The size bins of the spectrum.
+ * @param power Populated with size squared magnitudes.
+ * @param size The number of bins.
+ */
+void computePowerSpectrum(const ComplexF *spectrum, float *power, size_t size);
+
+/**
+ * Computes the magnitudes of a spectrum.
+ *
+ * @see computePowerSpectrum
+ */
+void computeMagnitudes(const ComplexF *spectrum, float *magnitudes,
+                       size_t size);
+
+/**
+ * Computes the magnitudes of a Q15 spectrum, with an integer square root so
+ * that no floating point operation is needed.
+ *
+ * @see computePowerSpectrum
+ */
+void computeMagnitudesQ15(const ComplexQ15 *spectrum, uint16_t *magnitudes,
+                          size_t size);
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_NANOAPP_DSP_H_
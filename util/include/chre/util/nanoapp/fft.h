@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_NANOAPP_FFT_H_
+#define CHRE_UTIL_NANOAPP_FFT_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/util/nanoapp/dsp.h"
+
+namespace chre {
+
+namespace internal {
+
+void initRealFftTwiddles(ComplexF *twiddles, size_t size);
+void initRealFftTwiddlesQ15(ComplexQ15 *twiddles, size_t size);
+void computeRealFft(const float *input, ComplexF *output, ComplexF *work,
+                    const ComplexF *twiddles, size_t size);
+void computeRealFftQ15(const int16_t *input, ComplexQ15 *output,
+                       ComplexQ15 *work, const ComplexQ15 *twiddles,
+                       size_t size);
+
+}  // namespace internal
+
+/**
+ * The forward FFT of a real signal, in floating point. The signal is
+ * transformed with a complex FFT of half its size, followed by a split step,
+ * which is about twice as fast as a complex FFT of the full size.
+ *
+ * Like kiss_fftr, the output is not normalized.
+ *
+ * @tparam kSize The number of samples, a power of 2 of at least 4.
+ */
+template <size_t kSize>
+class RealFft {
+ public:
+  static_assert(kSize >= 4 && (kSize & (kSize - 1)) == 0,
+                "FFT size must be a power of 2 of at least 4");
+
+  //! The number of bins of the output, from DC to the Nyquist frequency.
+  static constexpr size_t kNumBins = kSize / 2 + 1;
+
+  RealFft() {
+    internal::initRealFftTwiddles(mTwiddles, kSize);
+  }
+
+  /**
+   * @param input The kSize samples to transform.
+   * @param output Populated with the kNumBins bins of the spectrum.
+   */
+  void forward(const float *input, ComplexF *output) {
+    internal::computeRealFft(input, output, mWork, mTwiddles, kSize);
+  }
+
+ private:
+  //! exp(-2 * pi * i * k / kSize) for k in [0, kSize / 2).
+  ComplexF mTwiddles[kSize / 2];
+
+  //! The intermediate complex FFT.
+  ComplexF mWork[kSize / 2];
+};
+
+/**
+ * The forward FFT of a real signal, in Q15 fixed point for processors without
+ * a floating point unit.
+ *
+ * Every butterfly stage halves its output to prevent overflows, so the output
+ * is the spectrum divided by kSize, like kiss_fftr built with FIXED_POINT.
+ *
+ * @see RealFft
+ */
+template <size_t kSize>
+class RealFftQ15 {
+ public:
+  static_assert(kSize >= 4 && (kSize & (kSize - 1)) == 0,
+                "FFT size must be a power of 2 of at least 4");
+
+  static constexpr size_t kNumBins = kSize / 2 + 1;
+
+  RealFftQ15() {
+    internal::initRealFftTwiddlesQ15(mTwiddles, kSize);
+  }
+
+  /**
+   * @param input The kSize samples to transform.
+   * @param output Populated with the kNumBins bins of the spectrum, divided
+   *     by kSize.
+   */
+  void forward(const int16_t *input, ComplexQ15 *output) {
+    internal::computeRealFftQ15(input, output, mWork, mTwiddles, kSize);
+  }
+
+ private:
+  ComplexQ15 mTwiddles[kSize / 2];
+  ComplexQ15 mWork[kSize / 2];
+};
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_NANOAPP_FFT_H_
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_NANOAPP_FILTER_H_
+#define CHRE_UTIL_NANOAPP_FILTER_H_
+
+#include <cstddef>
+#include <cstring>
+
+#include "chre/util/nanoapp/dsp.h"
+
+namespace chre {
+
+/**
+ * The coefficients of a second-order IIR filter, normalized so that a0 is 1:
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2].
+ */
+struct BiquadCoefficients {
+  float b0;
+  float b1;
+  float b2;
+  float a1;
+  float a2;
+};
+
+/**
+ * Designs biquads from the Audio EQ Cookbook formulas.
+ *
+ * @param frequencyHz The cutoff or center frequency.
+ * @param sampleRateHz The sample rate of the signal.
+ * @param q The quality factor, 0.7071 for a Butterworth response.
+ * @return The coefficients of the filter.
+ */
+BiquadCoefficients designLowPassBiquad(float frequencyHz, float sampleRateHz,
+                                       float q);
+BiquadCoefficients designHighPassBiquad(float frequencyHz, float sampleRateHz,
+                                        float q);
+BiquadCoefficients designBandPassBiquad(float frequencyHz, float sampleRateHz,
+                                        float q);
+
+namespace internal {
+
+void processBiquad(const BiquadCoefficients &coefficients, float *state,
+                   const float *input, float *output, size_t size);
+void processBiquadBank(const float *b0, const float *b1, const float *b2,
+                       const float *a1, const float *a2, float *state1,
+                       float *state2, float *energies, const float *input,
+                       size_t size, size_t numFilters);
+void processFir(const float *taps, float *history, size_t numTaps,
+                size_t *position, const float *input, float *output,
+                size_t size);
+
+}  // namespace internal
+
+/**
+ * A cascade of biquads, in transposed direct form II, to build higher order
+ * IIR filters.
+ *
+ * @tparam kNumStages The number of biquads.
+ */
+template <size_t kNumStages>
+class BiquadCascade {
+ public:
+  static_assert(kNumStages > 0, "A cascade needs at least one stage");
+
+  /**
+   * Constructs a cascade where all the stages pass the signal through.
+   */
+  BiquadCascade() {
+    for (size_t i = 0; i < kNumStages; i++) {
+      mCoefficients[i] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    }
+  }
+
+  /**
+   * Sets the coefficients of a stage.
+   */
+  void setStage(size_t stage, const BiquadCoefficients &coefficients) {
+    mCoefficients[stage] = coefficients;
+  }
+
+  /**
+   * Clears the state of the filter, as if it only had zeros as input.
+   */
+  void reset() {
+    memset(mState, 0, sizeof(mState));
+  }
+
+  /**
+   * Filters a block of samples. The output can be the input.
+   */
+  void process(const float *input, float *output, size_t size) {
+    // Run each stage on the whole block to keep its state in registers.
+    for (size_t i = 0; i < kNumStages; i++) {
+      internal::processBiquad(mCoefficients[i], mState[i],
+                              (i == 0) ? input : output, output, size);
+    }
+  }
+
+ private:
+  BiquadCoefficients mCoefficients[kNumStages];
+  float mState[kNumStages][2] = {};
+};
+
+/**
+ * A bank of biquads filtering the same signal in parallel and accumulating the
+ * energy of their outputs, e.g. to compute the energies of frequency bands.
+ *
+ * The coefficients are stored per type rather than per filter so that each
+ * sample is processed by all the filters in a vectorizable loop.
+ *
+ * @tparam kNumFilters The number of filters.
+ */
+template <size_t kNumFilters>
+class BiquadFilterBank {
+ public:
+  static_assert(kNumFilters > 0, "A bank needs at least one filter");
+
+  void setFilter(size_t index, const BiquadCoefficients &coefficients) {
+    mB0[index] = coefficients.b0;
+    mB1[index] = coefficients.b1;
+    mB2[index] = coefficients.b2;
+    mA1[index] = coefficients.a1;
+    mA2[index] = coefficients.a2;
+  }
+
+  void reset() {
+    memset(mState1, 0, sizeof(mState1));
+    memset(mState2, 0, sizeof(mState2));
+  }
+
+  /**
+   * Filters a block of samples, adding the sum of the squared outputs of each
+   * filter to energies.
+   *
+   * @param input The samples to filter.
+   * @param size The number of samples.
+   * @param energies The kNumFilters energies to accumulate into.
+   */
+  void process(const float *input, size_t size, float *energies) {
+    internal::processBiquadBank(mB0, mB1, mB2, mA1, mA2, mState1, mState2,
+                                energies, input, size, kNumFilters);
+  }
+
+ private:
+  float mB0[kNumFilters] = {};
+  float mB1[kNumFilters] = {};
+  float mB2[kNumFilters] = {};
+  float mA1[kNumFilters] = {};
+  float mA2[kNumFilters] = {};
+  float mState1[kNumFilters] = {};
+  float mState2[kNumFilters] = {};
+};
+
+/**
+ * A finite impulse response filter.
+ *
+ * The history of the input is stored twice in a row, so that the most recent
+ * kNumTaps samples are always contiguous and the convolution is a plain dot
+ * product, without any wrap around.
+ *
+ * @tparam kNumTaps The number of coefficients.
+ */
+template <size_t kNumTaps>
+class FirFilter {
+ public:
+  static_assert(kNumTaps > 0, "A filter needs at least one tap");
+
+  /**
+   * @param taps The kNumTaps coefficients, h[0] first.
+   */
+  void setTaps(const float *taps) {
+    // Stored in reverse order to be multiplied with the history in order.
+    for (size_t i = 0; i < kNumTaps; i++) {
+      mTaps[i] = taps[kNumTaps - 1 - i];
+    }
+  }
+
+  void reset() {
+    memset(mHistory, 0, sizeof(mHistory));
+    mPosition = 0;
+  }
+
+  /**
+   * Filters a block of samples. The output can be the input.
+   */
+  void process(const float *input, float *output, size_t size) {
+    internal::processFir(mTaps, mHistory, kNumTaps, &mPosition, input, output,
+                         size);
+  }
+
+ private:
+  float mTaps[kNumTaps] = {};
+  float mHistory[2 * kNumTaps] = {};
+  size_t mPosition = 0;
+};
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_NANOAPP_FILTER_H_
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_NANOAPP_MEL_FILTERBANK_H_
+#define CHRE_UTIL_NANOAPP_MEL_FILTERBANK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "chre/util/nanoapp/dsp.h"
+
+namespace chre {
+
+/**
+ * Converts a frequency to the mel scale, with the HTK formula.
+ */
+float hzToMel(float frequencyHz);
+
+/**
+ * Converts a frequency from the mel scale, with the HTK formula.
+ */
+float melToHz(float mel);
+
+namespace internal {
+
+bool initMelFilterbank(float sampleRateHz, float minFrequencyHz,
+                       float maxFrequencyHz, size_t numBins, size_t numBands,
+                       uint16_t *bandStart, uint16_t *bandSize, float *weights,
+                       size_t maxNumWeights);
+void applyMelFilterbank(const uint16_t *bandStart, const uint16_t *bandSize,
+                        const float *weights, size_t numBands,
+                        const float *powerSpectrum, float *bandEnergies);
+
+}  // namespace internal
+
+/**
+ * Triangular filters evenly spaced on the mel scale, summing the bins of a
+ * power spectrum into perceptual frequency bands.
+ *
+ * Only the non-zero weights are stored: as each bin is covered by at most two
+ * overlapping triangles, this takes at most twice the number of bins.
+ *
+ * @tparam kNumBins The number of bins of the spectrum, e.g.
+ *     RealFft<kSize>::kNumBins.
+ * @tparam kNumBands The number of mel bands.
+ */
+template <size_t kNumBins, size_t kNumBands>
+class MelFilterbank {
+ public:
+  static_assert(kNumBins >= 2 && kNumBins <= UINT16_MAX,
+                "Unsupported number of bins");
+  static_assert(kNumBands > 0, "A filterbank needs at least one band");
+
+  /**
+   * Computes the filters. Must be called before apply().
+   *
+   * @param sampleRateHz The sample rate of the signal the spectrum comes from.
+   * @param minFrequencyHz The lower edge of the first band.
+   * @param maxFrequencyHz The upper edge of the last band, at most the Nyquist
+   *     frequency.
+   * @return false if the parameters are invalid.
+   */
+  bool init(float sampleRateHz, float minFrequencyHz, float maxFrequencyHz) {
+    return internal::initMelFilterbank(
+        sampleRateHz, minFrequencyHz, maxFrequencyHz, kNumBins, kNumBands,
+        mBandStart, mBandSize, mWeights, 2 * kNumBins);
+  }
+
+  /**
+   * @param powerSpectrum The kNumBins squared magnitudes of the spectrum.
+   * @param bandEnergies Populated with the kNumBands energies.
+   */
+  void apply(const float *powerSpectrum, float *bandEnergies) const {
+    internal::applyMelFilterbank(mBandStart, mBandSize, mWeights, kNumBands,
+                                 powerSpectrum, bandEnergies);
+  }
+
+ private:
+  //! The first bin of each band.
+  uint16_t mBandStart[kNumBands] = {};
+
+  //! The number of bins of each band.
+  uint16_t mBandSize[kNumBands] = {};
+
+  //! The weights of the bins of each band, one band after the other.
+  float mWeights[2 * kNumBins] = {};
+};
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_NANOAPP_MEL_FILTERBANK_H_
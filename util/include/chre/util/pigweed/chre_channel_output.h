@@ -17,15 +17,83 @@
 #ifndef CHRE_CHANNEL_OUTPUT_H_
 #define CHRE_CHANNEL_OUTPUT_H_
 
+#include <cstddef>
 #include <cstdint>
 
+#include "chre/util/memory_pool.h"
+#include "chre/util/non_copyable.h"
 #include "chre/util/pigweed/permission.h"
 #include "chre_api/chre.h"
 #include "pw_rpc/channel.h"
 #include "pw_span/span.h"
 
+#ifndef CHRE_PW_RPC_NUM_POOLED_BUFFERS
+//! The number of buffers pooled for the packets sent by a RPC server or client.
+#define CHRE_PW_RPC_NUM_POOLED_BUFFERS 4
+#endif  // CHRE_PW_RPC_NUM_POOLED_BUFFERS
+
+#ifndef CHRE_PW_RPC_POOLED_BUFFER_SIZE
+//! The size of the pooled buffers, in bytes.
+#define CHRE_PW_RPC_POOLED_BUFFER_SIZE 256
+#endif  // CHRE_PW_RPC_POOLED_BUFFER_SIZE
+
 namespace chre {
 
+/**
+ * Buffers holding the packets sent over the channel outputs until CHRE
+ * releases them.
+ *
+ * Pigweed encodes the packets in a shared buffer, so each packet must be
+ * copied to a buffer owned by CHRE while the message is in flight. Streaming
+ * RPCs send many small packets: these are copied to a fixed pool of buffers,
+ * and only the packets which do not fit a pooled buffer, or which are sent
+ * while all the pooled buffers are in use, are allocated from the heap.
+ */
+class ChreChannelOutputBufferPool : public NonCopyable {
+ public:
+  /**
+   * Allocates a buffer, from the pool when size fits.
+   *
+   * @param size The size of the buffer in bytes.
+   * @return The buffer, nullptr when the allocation fails. It must be released
+   *         with release().
+   */
+  void *allocate(size_t size);
+
+  /**
+   * Releases a buffer returned by allocate().
+   *
+   * This method is static so that it can be used from CHRE free callbacks.
+   *
+   * @param buffer The buffer to release.
+   */
+  static void release(void *buffer);
+
+  /**
+   * @return The number of pooled buffers currently available.
+   */
+  size_t getFreeBufferCount() const {
+    return mPool.getFreeBlockCount();
+  }
+
+ private:
+  /**
+   * Header preceding each buffer, aligned so that the buffer can hold any
+   * type.
+   */
+  struct alignas(alignof(std::max_align_t)) BufferHeader {
+    //! The pool the buffer belongs to, nullptr for heap buffers.
+    ChreChannelOutputBufferPool *pool;
+  };
+
+  struct PooledBuffer {
+    BufferHeader header;
+    uint8_t data[CHRE_PW_RPC_POOLED_BUFFER_SIZE];
+  };
+
+  MemoryPool<PooledBuffer, CHRE_PW_RPC_NUM_POOLED_BUFFERS> mPool;
+};
+
 /**
  * Message format used for communicating between nanoapps since CHRE doesn't
  * have a standard format for this as part of the API definition.
@@ -41,8 +109,11 @@ struct ChrePigweedNanoappMessage {
  */
 class ChreServerNanoappChannelOutput : public pw::rpc::ChannelOutput {
  public:
-  explicit ChreServerNanoappChannelOutput(RpcPermission &permission)
-      : ChannelOutput("CHRE"), mPermission(permission) {}
+  ChreServerNanoappChannelOutput(RpcPermission &permission,
+                                 ChreChannelOutputBufferPool &bufferPool)
+      : ChannelOutput("CHRE"),
+        mPermission(permission),
+        mBufferPool(bufferPool) {}
 
   /**
    * Sets the nanoapp instance ID that is being communicated with over this
@@ -57,6 +128,7 @@ class ChreServerNanoappChannelOutput : public pw::rpc::ChannelOutput {
  private:
   uint16_t mClientInstanceId = 0;
   RpcPermission &mPermission;
+  ChreChannelOutputBufferPool &mBufferPool;
 };
 
 /**
@@ -65,7 +137,9 @@ class ChreServerNanoappChannelOutput : public pw::rpc::ChannelOutput {
  */
 class ChreClientNanoappChannelOutput : public pw::rpc::ChannelOutput {
  public:
-  ChreClientNanoappChannelOutput() : ChannelOutput("CHRE") {}
+  explicit ChreClientNanoappChannelOutput(
+      ChreChannelOutputBufferPool &bufferPool)
+      : ChannelOutput("CHRE"), mBufferPool(bufferPool) {}
 
   /**
    * Sets the server instance ID.
@@ -76,12 +150,20 @@ class ChreClientNanoappChannelOutput : public pw::rpc::ChannelOutput {
    */
   void setServer(uint32_t instanceId);
 
+  /**
+   * @return The instance ID of the server, 0 when not set.
+   */
+  uint16_t getServer() const {
+    return mServerInstanceId;
+  }
+
   size_t MaximumTransmissionUnit() override;
 
   pw::Status Send(pw::span<const std::byte> buffer) override;
 
  private:
   uint16_t mServerInstanceId = 0;
+  ChreChannelOutputBufferPool &mBufferPool;
 };
 
 /**
@@ -90,8 +172,11 @@ class ChreClientNanoappChannelOutput : public pw::rpc::ChannelOutput {
  */
 class ChreServerHostChannelOutput : public pw::rpc::ChannelOutput {
  public:
-  explicit ChreServerHostChannelOutput(RpcPermission &permission)
-      : ChannelOutput("CHRE"), mPermission(permission) {}
+  ChreServerHostChannelOutput(RpcPermission &permission,
+                              ChreChannelOutputBufferPool &bufferPool)
+      : ChannelOutput("CHRE"),
+        mPermission(permission),
+        mBufferPool(bufferPool) {}
 
   /**
    * Sets the host endpoint being communicated with.
@@ -105,6 +190,7 @@ class ChreServerHostChannelOutput : public pw::rpc::ChannelOutput {
  private:
   uint16_t mEndpointId = CHRE_HOST_ENDPOINT_UNSPECIFIED;
   RpcPermission &mPermission;
+  ChreChannelOutputBufferPool &mBufferPool;
 };
 
 }  // namespace chre
@@ -44,7 +44,7 @@ class RpcClient : public NonCopyable {
    * @param serverNanoappId Nanoapp ID of the server.
    */
   explicit RpcClient(uint64_t serverNanoappId)
-      : mServerNanoappId((serverNanoappId)) {}
+      : mChannelOutput(mBufferPool), mServerNanoappId((serverNanoappId)) {}
 
   /**
    * Handles events related to RPC services.
@@ -110,6 +110,8 @@ class RpcClient : public NonCopyable {
    */
   void handleNanoappStopped(const void *eventData);
 
+  // Buffers for the packets sent to the server.
+  ChreChannelOutputBufferPool mBufferPool;
   ChreClientNanoappChannelOutput mChannelOutput;
   pw::rpc::Client mRpcClient;
   uint64_t mServerNanoappId;
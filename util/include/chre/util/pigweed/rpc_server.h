@@ -57,7 +57,9 @@ class RpcServer : public NonCopyable {
     uint32_t version;
   };
 
-  RpcServer() : mHostOutput(mPermission), mNanoappOutput(mPermission) {}
+  RpcServer()
+      : mHostOutput(mPermission, mBufferPool),
+        mNanoappOutput(mPermission, mBufferPool) {}
 
   /**
    * Registers services to the server and to CHRE.
@@ -174,11 +176,17 @@ class RpcServer : public NonCopyable {
 
   pw::rpc::Server mServer;
 
+  // Buffers for the packets sent to the clients.
+  ChreChannelOutputBufferPool mBufferPool;
+
   ChreServerHostChannelOutput mHostOutput;
   ChreServerNanoappChannelOutput mNanoappOutput;
 
   // Host endpoints for the connected clients.
   DynamicVector<uint16_t> mConnectedHosts;
+
+  // Whether the server is registered for nanoapp info events.
+  bool mNanoappInfoEventsEnabled = false;
 };
 
 }  // namespace chre
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHRE_UTIL_SYSTEM_LOG_SCALE_HISTOGRAM_H_
+#define CHRE_UTIL_SYSTEM_LOG_SCALE_HISTOGRAM_H_
+
+#include <cinttypes>
+#include <cstddef>
+
+namespace chre {
+
+/**
+ * A fixed-memory histogram with power-of-two bucket boundaries, used to track
+ * the distribution of latency-like values without storing samples.
+ *
+ * Bucket 0 counts the value 0, and bucket i (i > 0) counts values in the range
+ * [2^(i-1), 2^i). The last bucket also collects every value beyond its range.
+ * Counts saturate at UINT32_MAX.
+ *
+ * @tparam kNumBuckets The number of buckets, must be in the range [2, 64].
+ */
+template <size_t kNumBuckets>
+class LogScaleHistogram {
+  static_assert(kNumBuckets >= 2 && kNumBuckets <= 64,
+                "Bucket count must be in the range [2, 64]");
+
+ public:
+  /**
+   * Records a new value into the bucket covering it.
+   *
+   * @param value The value to record.
+   */
+  void addValue(uint64_t value) {
+    size_t bucket = getBucketIndex(value);
+    if (mCounts[bucket] < UINT32_MAX) {
+      mCounts[bucket]++;
+    }
+    if (mTotalCount < UINT32_MAX) {
+      mTotalCount++;
+    }
+  }
+
+  /**
+   * @param bucket The index of the bucket, must be less than kNumBuckets.
+   * @return The number of values recorded in the bucket.
+   */
+  uint32_t getCount(size_t bucket) const {
+    return (bucket < kNumBuckets) ? mCounts[bucket] : 0;
+  }
+
+  /**
+   * @return The total number of values recorded.
+   */
+  uint32_t getTotalCount() const {
+    return mTotalCount;
+  }
+
+  /**
+   * Returns an upper bound for the given percentile of the recorded values,
+   * i.e. the exclusive upper bound of the bucket that contains it. If the
+   * percentile falls in the last bucket, which is open-ended, the lower bound
+   * of that bucket is returned instead.
+   *
+   * @param percent The percentile to compute, in the range [0, 100].
+   * @return The estimated percentile, or 0 if no values have been recorded.
+   */
+  uint64_t getPercentile(uint8_t percent) const {
+    if (mTotalCount == 0) {
+      return 0;
+    }
+
+    // Rank of the target value, rounded up so that p100 maps to the last
+    // recorded value.
+    uint64_t rank =
+        (static_cast<uint64_t>(mTotalCount) * percent + 99) / 100;
+    if (rank == 0) {
+      rank = 1;
+    }
+
+    uint64_t cumulative = 0;
+    size_t bucket = 0;
+    for (; bucket < kNumBuckets - 1; ++bucket) {
+      cumulative += mCounts[bucket];
+      if (cumulative >= rank) {
+        break;
+      }
+    }
+
+    return (bucket == kNumBuckets - 1) ? getBucketLowerBound(bucket)
+                                       : getBucketUpperBound(bucket);
+  }
+
+  /**
+   * @return The inclusive lower bound of the values counted in the bucket.
+   */
+  static constexpr uint64_t getBucketLowerBound(size_t bucket) {
+    return (bucket == 0) ? 0 : (UINT64_C(1) << (bucket - 1));
+  }
+
+  /**
+   * @return The exclusive upper bound of the values counted in the bucket. Not
+   *     meaningful for the last bucket, which is open-ended.
+   */
+  static constexpr uint64_t getBucketUpperBound(size_t bucket) {
+    return UINT64_C(1) << bucket;
+  }
+
+  /**
+   * @return The index of the bucket that a value is recorded in.
+   */
+  static size_t getBucketIndex(uint64_t value) {
+    size_t bucket = 0;
+    while (value != 0 && bucket < kNumBuckets - 1) {
+      value >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  /**
+   * @return The number of buckets in the histogram.
+   */
+  static constexpr size_t getNumBuckets() {
+    return kNumBuckets;
+  }
+
+ private:
+  //! The number of values recorded in each bucket.
+  uint32_t mCounts[kNumBuckets] = {};
+
+  //! The number of values recorded in all buckets.
+  uint32_t mTotalCount = 0;
+};
+
+}  // namespace chre
+
+#endif  // CHRE_UTIL_SYSTEM_LOG_SCALE_HISTOGRAM_H_
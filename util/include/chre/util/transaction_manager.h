@@ -22,8 +22,10 @@
 
 #include "chre/platform/mutex.h"
 #include "chre/util/array_queue.h"
+#include "chre/util/fixed_size_vector.h"
 #include "chre/util/non_copyable.h"
 #include "chre/util/optional.h"
+#include "chre/util/raw_storage.h"
 #include "chre/util/time.h"
 
 namespace chre {
@@ -50,6 +52,13 @@ namespace chre {
  * If completeTransaction is not called before the timeout, the transaction
  * will be completed with a CHRE_ERROR_TIMEOUT.
  *
+ * Transactions with the same cookie are queued in start order and only the
+ * oldest of them can be started. The oldest transaction of each cookie is kept
+ * in a min-heap ordered by its next retry or timeout time, so processing only
+ * touches the transactions that are completed or due. Calls that need
+ * processing while a processing pass is already deferred are coalesced into
+ * that pass.
+ *
  * Ensure the thread processing the deferred callbacks is completed before the
  * destruction of the TransactionManager.
  *
@@ -172,6 +181,8 @@ class TransactionManager : public NonCopyable {
         kRetryWaitTime(retryWaitTime),
         kTimeout(timeout),
         kMaxNumRetries(maxNumRetries) {
+    static_assert(kMaxTransactions < kInvalidIndex,
+                  "kMaxTransactions must fit in an index");
     CHRE_ASSERT(startCallback != nullptr);
     CHRE_ASSERT(completeCallback != nullptr);
     CHRE_ASSERT(deferCallback != nullptr);
@@ -181,6 +192,8 @@ class TransactionManager : public NonCopyable {
                 timeout.toRawNanoseconds() > retryWaitTime.toRawNanoseconds());
   }
 
+  ~TransactionManager();
+
   /**
    * Completes a transaction.
    *
@@ -238,6 +251,10 @@ class TransactionManager : public NonCopyable {
                         uint32_t *id);
 
  private:
+  //! Marks the end of a list of transactions or a transaction that isn't in
+  //! the deadline heap.
+  static constexpr uint16_t kInvalidIndex = UINT16_MAX;
+
   //! Stores transaction-related data.
   struct Transaction {
     uint32_t id;
@@ -247,10 +264,28 @@ class TransactionManager : public NonCopyable {
     uint16_t cookie;
     uint16_t numCompletedStartCalls;
     Optional<uint8_t> errorCode;
+
+    //! The slot of the next transaction with the same cookie, in start order.
+    uint16_t nextSameCookie;
+
+    //! The position of the transaction in mDeadlineHeap, or kInvalidIndex if
+    //! it isn't the oldest transaction of its cookie.
+    uint16_t heapIndex;
+
+    //! Whether the transaction is in mCompletedTransactions.
+    bool isCompletionPending;
+  };
+
+  //! The oldest and newest transactions started with a cookie.
+  struct CookieQueue {
+    uint16_t cookie;
+    uint16_t head;
+    uint16_t tail;
   };
 
   /**
-   * Defers processing transactions in the defer callback thread.
+   * Defers processing transactions in the defer callback thread, unless a
+   * processing pass is already deferred.
    */
   void deferProcessTransactions();
 
@@ -264,14 +299,65 @@ class TransactionManager : public NonCopyable {
 
   /**
    * Calls the start callback for a transaction if needed. Also updates the
-   * transaction state. Assumes the caller holds the mutex.
+   * transaction state. Assumes the caller holds the mutex and that the
+   * transaction is the oldest transaction of its cookie.
    *
    * @param transaction The transaction.
-   * @param i The index of the transaction in mTransactions.
    * @param now The current time.
    */
-  void doStartTransactionLocked(Transaction &transaction, size_t i,
-                                Nanoseconds now);
+  void doStartTransactionLocked(Transaction &transaction, Nanoseconds now);
+
+  /**
+   * @param cookie The cookie of the queue.
+   * @return The index of the queue of the cookie in mCookieQueues, or
+   *     mCookieQueues.size() if no transaction has this cookie.
+   */
+  size_t findCookieQueueLocked(uint16_t cookie) const;
+
+  /**
+   * @return The slot of the transaction with the given ID, or kInvalidIndex if
+   *     not found.
+   */
+  uint16_t findSlotLocked(uint32_t transactionId) const;
+
+  /**
+   * Removes a transaction and makes the next transaction with the same cookie,
+   * if any, eligible to start. Assumes the caller holds the mutex.
+   *
+   * @param slot The slot of the transaction.
+   */
+  void removeTransactionLocked(uint16_t slot);
+
+  /**
+   * @return The time at which a transaction in the deadline heap must next be
+   *     processed.
+   */
+  Nanoseconds getDeadline(const Transaction &transaction) const {
+    Nanoseconds deadline = transaction.nextRetryTime;
+    if (transaction.timeoutTime.toRawNanoseconds() != 0 &&
+        transaction.timeoutTime < deadline) {
+      deadline = transaction.timeoutTime;
+    }
+    return deadline;
+  }
+
+  //! Adds a transaction to the deadline heap.
+  void heapPushLocked(uint16_t slot);
+
+  //! Removes a transaction from the deadline heap.
+  void heapRemoveLocked(uint16_t slot);
+
+  //! Restores the heap order after the deadline of a transaction changed.
+  void heapUpdateLocked(uint16_t slot);
+
+  //! Moves the element at the given heap position up or down to its place.
+  void heapSiftLocked(uint16_t position);
+
+  //! Places a transaction at the given heap position.
+  void heapSetLocked(uint16_t position, uint16_t slot) {
+    mDeadlineHeap[position] = slot;
+    mSlots[slot].heapIndex = position;
+  }
 
   /**
    * Generates a pseudo random ID for a transaction in the range of
@@ -310,7 +396,7 @@ class TransactionManager : public NonCopyable {
   //! The maximum number of retries for a transaction.
   const uint16_t kMaxNumRetries;
 
-  //! The mutex protecting mTransactions and mTimerHandle.
+  //! The mutex protecting the transactions and mIsProcessingDeferred.
   Mutex mMutex;
 
   //! The next ID for use when creating a transaction.
@@ -320,8 +406,33 @@ class TransactionManager : public NonCopyable {
   //! Can only be modified in the defer callback thread.
   uint32_t mTimerHandle = CHRE_TIMER_INVALID;
 
-  //! The list of transactions.
-  ArrayQueue<Transaction, kMaxTransactions> mTransactions;
+  //! Whether a call to processTransactions() is deferred and hasn't started
+  //! yet.
+  bool mIsProcessingDeferred = false;
+
+  //! The storage of the transactions, in use if mIsSlotInUse is set.
+  RawStorage<Transaction, kMaxTransactions> mSlots;
+
+  //! Whether each slot of mSlots holds a transaction.
+  bool mIsSlotInUse[kMaxTransactions] = {};
+
+  //! The number of transactions.
+  size_t mNumTransactions = 0;
+
+  //! The queues of transactions for each cookie with at least one
+  //! transaction.
+  FixedSizeVector<CookieQueue, kMaxTransactions> mCookieQueues;
+
+  //! A min-heap of the slots of the oldest transaction of each cookie, ordered
+  //! by deadline.
+  uint16_t mDeadlineHeap[kMaxTransactions];
+
+  //! The number of transactions in mDeadlineHeap.
+  uint16_t mDeadlineHeapSize = 0;
+
+  //! The slots of the transactions completed with completeTransaction() that
+  //! haven't been processed yet.
+  ArrayQueue<uint16_t, kMaxTransactions> mCompletedTransactions;
 };
 
 }  // namespace chre
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <inttypes.h>
+#include <new>
 
 #include "chre/platform/system_time.h"
 #include "chre/util/hash.h"
@@ -31,6 +32,15 @@ namespace chre {
 using ::chre::Nanoseconds;
 using ::chre::Seconds;
 
+template <typename TransactionData, size_t kMaxTransactions>
+TransactionManager<TransactionData, kMaxTransactions>::~TransactionManager() {
+  for (size_t i = 0; i < kMaxTransactions; ++i) {
+    if (mIsSlotInUse[i]) {
+      mSlots[i].~Transaction();
+    }
+  }
+}
+
 template <typename TransactionData, size_t kMaxTransactions>
 bool TransactionManager<TransactionData, kMaxTransactions>::completeTransaction(
     uint32_t transactionId, uint8_t errorCode) {
@@ -38,17 +48,22 @@ bool TransactionManager<TransactionData, kMaxTransactions>::completeTransaction(
 
   {
     LockGuard<Mutex> lock(mMutex);
-    for (size_t i = 0; i < mTransactions.size(); ++i) {
-      Transaction &transaction = mTransactions[i];
-      if (transaction.id == transactionId) {
-        if (errorCode == CHRE_ERROR_TRANSIENT) {
-          transaction.nextRetryTime = Nanoseconds(0);
-        } else {
-          transaction.errorCode = errorCode;
+    uint16_t slot = findSlotLocked(transactionId);
+    if (slot != kInvalidIndex) {
+      Transaction &transaction = mSlots[slot];
+      if (errorCode == CHRE_ERROR_TRANSIENT) {
+        transaction.nextRetryTime = Nanoseconds(0);
+        if (transaction.heapIndex != kInvalidIndex) {
+          heapUpdateLocked(slot);
+        }
+      } else {
+        transaction.errorCode = errorCode;
+        if (!transaction.isCompletionPending) {
+          transaction.isCompletionPending = true;
+          mCompletedTransactions.push(slot);
         }
-        success = true;
-        break;
       }
+      success = true;
     }
   }
 
@@ -67,18 +82,21 @@ size_t TransactionManager<TransactionData, kMaxTransactions>::flushTransactions(
     return 0;
   }
 
-  deferProcessTransactions();
-
-  LockGuard<Mutex> lock(mMutex);
   size_t numFlushed = 0;
-  for (size_t i = 0; i < mTransactions.size();) {
-    if (callback(mTransactions[i].data, data)) {
-      mTransactions.remove(i);
-      ++numFlushed;
-    } else {
-      ++i;
+  {
+    LockGuard<Mutex> lock(mMutex);
+    for (uint16_t slot = 0; slot < kMaxTransactions; ++slot) {
+      if (mIsSlotInUse[slot] && callback(mSlots[slot].data, data)) {
+        removeTransactionLocked(slot);
+        ++numFlushed;
+      }
     }
   }
+
+  // Flushing the oldest transaction of a cookie allows the next one to start.
+  if (numFlushed > 0) {
+    deferProcessTransactions();
+  }
   return numFlushed;
 }
 
@@ -89,7 +107,7 @@ bool TransactionManager<TransactionData, kMaxTransactions>::startTransaction(
 
   {
     LockGuard<Mutex> lock(mMutex);
-    if (mTransactions.full()) {
+    if (mNumTransactions == kMaxTransactions) {
       LOGE("The transaction queue is full");
       return false;
     }
@@ -100,7 +118,13 @@ bool TransactionManager<TransactionData, kMaxTransactions>::startTransaction(
     uint32_t transactionId = (mNextTransactionId.value())++;
     *id = transactionId;
 
-    Transaction transaction{
+    uint16_t slot = 0;
+    while (mIsSlotInUse[slot]) {
+      ++slot;
+    }
+    mIsSlotInUse[slot] = true;
+    ++mNumTransactions;
+    new (&mSlots[slot]) Transaction{
         .id = transactionId,
         .data = data,
         .nextRetryTime = Nanoseconds(0),
@@ -108,9 +132,21 @@ bool TransactionManager<TransactionData, kMaxTransactions>::startTransaction(
         .cookie = cookie,
         .numCompletedStartCalls = 0,
         .errorCode = Optional<uint8_t>(),
+        .nextSameCookie = kInvalidIndex,
+        .heapIndex = kInvalidIndex,
+        .isCompletionPending = false,
     };
 
-    mTransactions.push(transaction);
+    size_t queueIndex = findCookieQueueLocked(cookie);
+    if (queueIndex == mCookieQueues.size()) {
+      mCookieQueues.push_back(
+          CookieQueue{.cookie = cookie, .head = slot, .tail = slot});
+      heapPushLocked(slot);
+    } else {
+      CookieQueue &queue = mCookieQueues[queueIndex];
+      mSlots[queue.tail].nextSameCookie = slot;
+      queue.tail = slot;
+    }
   }
 
   deferProcessTransactions();
@@ -120,6 +156,14 @@ bool TransactionManager<TransactionData, kMaxTransactions>::startTransaction(
 template <typename TransactionData, size_t kMaxTransactions>
 void TransactionManager<TransactionData,
                         kMaxTransactions>::deferProcessTransactions() {
+  {
+    LockGuard<Mutex> lock(mMutex);
+    if (mIsProcessingDeferred) {
+      return;
+    }
+    mIsProcessingDeferred = true;
+  }
+
   bool success = kDeferCallback(
       [](uint16_t /* type */, void *data, void * /* extraData */) {
         auto transactionManagerPtr = static_cast<TransactionManager *>(data);
@@ -137,6 +181,8 @@ void TransactionManager<TransactionData,
 
   if (!success) {
     LOGE("Could not defer callback to process transactions");
+    LockGuard<Mutex> lock(mMutex);
+    mIsProcessingDeferred = false;
   }
 }
 
@@ -159,21 +205,7 @@ void TransactionManager<TransactionData, kMaxTransactions>::
 
 template <typename TransactionData, size_t kMaxTransactions>
 void TransactionManager<TransactionData, kMaxTransactions>::
-    doStartTransactionLocked(Transaction &transaction, size_t i,
-                             Nanoseconds now) {
-  // Ensure only one pending transaction per unique cookie.
-  bool canStart = true;
-  for (size_t j = 0; j < mTransactions.size(); ++j) {
-    if (i != j && mTransactions[j].cookie == transaction.cookie &&
-        mTransactions[j].numCompletedStartCalls > 0) {
-      canStart = false;
-      break;
-    }
-  }
-  if (!canStart) {
-    return;
-  }
-
+    doStartTransactionLocked(Transaction &transaction, Nanoseconds now) {
   if (transaction.timeoutTime.toRawNanoseconds() != 0) {
     transaction.timeoutTime = now + kTimeout;
   }
@@ -189,6 +221,127 @@ void TransactionManager<TransactionData, kMaxTransactions>::
   transaction.nextRetryTime = now + kRetryWaitTime;
 }
 
+template <typename TransactionData, size_t kMaxTransactions>
+size_t TransactionManager<TransactionData, kMaxTransactions>::
+    findCookieQueueLocked(uint16_t cookie) const {
+  size_t i = 0;
+  while (i < mCookieQueues.size() && mCookieQueues[i].cookie != cookie) {
+    ++i;
+  }
+  return i;
+}
+
+template <typename TransactionData, size_t kMaxTransactions>
+uint16_t TransactionManager<TransactionData, kMaxTransactions>::findSlotLocked(
+    uint32_t transactionId) const {
+  for (uint16_t slot = 0; slot < kMaxTransactions; ++slot) {
+    if (mIsSlotInUse[slot] && mSlots[slot].id == transactionId) {
+      return slot;
+    }
+  }
+  return kInvalidIndex;
+}
+
+template <typename TransactionData, size_t kMaxTransactions>
+void TransactionManager<TransactionData, kMaxTransactions>::
+    removeTransactionLocked(uint16_t slot) {
+  Transaction &transaction = mSlots[slot];
+  size_t queueIndex = findCookieQueueLocked(transaction.cookie);
+  CookieQueue &queue = mCookieQueues[queueIndex];
+
+  if (queue.head == slot) {
+    heapRemoveLocked(slot);
+    queue.head = transaction.nextSameCookie;
+    if (queue.head == kInvalidIndex) {
+      mCookieQueues.erase(queueIndex);
+    } else {
+      heapPushLocked(queue.head);
+    }
+  } else {
+    uint16_t previous = queue.head;
+    while (mSlots[previous].nextSameCookie != slot) {
+      previous = mSlots[previous].nextSameCookie;
+    }
+    mSlots[previous].nextSameCookie = transaction.nextSameCookie;
+    if (queue.tail == slot) {
+      queue.tail = previous;
+    }
+  }
+
+  if (transaction.isCompletionPending) {
+    for (size_t i = 0; i < mCompletedTransactions.size(); ++i) {
+      if (mCompletedTransactions[i] == slot) {
+        mCompletedTransactions.remove(i);
+        break;
+      }
+    }
+  }
+
+  transaction.~Transaction();
+  mIsSlotInUse[slot] = false;
+  --mNumTransactions;
+}
+
+template <typename TransactionData, size_t kMaxTransactions>
+void TransactionManager<TransactionData, kMaxTransactions>::heapPushLocked(
+    uint16_t slot) {
+  uint16_t position = mDeadlineHeapSize++;
+  heapSetLocked(position, slot);
+  heapSiftLocked(position);
+}
+
+template <typename TransactionData, size_t kMaxTransactions>
+void TransactionManager<TransactionData, kMaxTransactions>::heapRemoveLocked(
+    uint16_t slot) {
+  uint16_t position = mSlots[slot].heapIndex;
+  mSlots[slot].heapIndex = kInvalidIndex;
+  --mDeadlineHeapSize;
+  if (position != mDeadlineHeapSize) {
+    heapSetLocked(position, mDeadlineHeap[mDeadlineHeapSize]);
+    heapSiftLocked(position);
+  }
+}
+
+template <typename TransactionData, size_t kMaxTransactions>
+void TransactionManager<TransactionData, kMaxTransactions>::heapUpdateLocked(
+    uint16_t slot) {
+  heapSiftLocked(mSlots[slot].heapIndex);
+}
+
+template <typename TransactionData, size_t kMaxTransactions>
+void TransactionManager<TransactionData, kMaxTransactions>::heapSiftLocked(
+    uint16_t position) {
+  uint16_t slot = mDeadlineHeap[position];
+  Nanoseconds deadline = getDeadline(mSlots[slot]);
+
+  while (position > 0) {
+    uint16_t parent = (position - 1) / 2;
+    if (!(deadline < getDeadline(mSlots[mDeadlineHeap[parent]]))) {
+      break;
+    }
+    heapSetLocked(position, mDeadlineHeap[parent]);
+    position = parent;
+  }
+
+  while (true) {
+    uint16_t child = 2 * position + 1;
+    if (child >= mDeadlineHeapSize) {
+      break;
+    }
+    if (child + 1 < mDeadlineHeapSize &&
+        getDeadline(mSlots[mDeadlineHeap[child + 1]]) <
+            getDeadline(mSlots[mDeadlineHeap[child]])) {
+      ++child;
+    }
+    if (!(getDeadline(mSlots[mDeadlineHeap[child]]) < deadline)) {
+      break;
+    }
+    heapSetLocked(position, mDeadlineHeap[child]);
+    position = child;
+  }
+  heapSetLocked(position, slot);
+}
+
 template <typename TransactionData, size_t kMaxTransactions>
 uint32_t TransactionManager<TransactionData,
                         kMaxTransactions>::generatePseudoRandomId() {
@@ -217,54 +370,59 @@ void TransactionManager<TransactionData,
   }
 
   Nanoseconds now = SystemTime::getMonotonicTime();
-  Nanoseconds nextExecutionTime(UINT64_MAX);
+  Optional<Nanoseconds> nextExecutionTime;
 
   {
     LockGuard<Mutex> lock(mMutex);
-    if (mTransactions.empty()) {
-      return;
-    }
+    mIsProcessingDeferred = false;
+
+    // Completing a transaction makes the next transaction with the same cookie
+    // the oldest one, which is due immediately, so keep going until neither a
+    // completed nor a due transaction is left.
+    while (true) {
+      if (!mCompletedTransactions.empty()) {
+        uint16_t slot = mCompletedTransactions.front();
+        mCompletedTransactions.pop();
+        mSlots[slot].isCompletionPending = false;
+        doCompleteTransactionLocked(mSlots[slot]);
+        removeTransactionLocked(slot);
+        continue;
+      }
 
-    // If a transaction is completed, it will be removed from the queue.
-    // The loop continues processing in this case as there may be another
-    // transaction that is ready to start with the same cookie that was
-    // blocked from starting by the completed transaction.
-    bool continueProcessing;
-    do {
-      continueProcessing = false;
-      for (size_t i = 0; i < mTransactions.size();) {
-        Transaction &transaction = mTransactions[i];
-        if ((transaction.timeoutTime.toRawNanoseconds() != 0 &&
-             transaction.timeoutTime <= now) ||
-            (transaction.nextRetryTime <= now &&
-             transaction.numCompletedStartCalls > kMaxNumRetries) ||
-            transaction.errorCode.has_value()) {
-          doCompleteTransactionLocked(transaction);
-          mTransactions.remove(i);
-          continueProcessing = true;
-        } else {
-          if (transaction.nextRetryTime <= now) {
-            doStartTransactionLocked(transaction, i, now);
-          }
-
-          nextExecutionTime =
-              std::min(nextExecutionTime, transaction.nextRetryTime);
-          if (transaction.timeoutTime.toRawNanoseconds() != 0) {
-            nextExecutionTime =
-                std::min(nextExecutionTime, transaction.timeoutTime);
-          }
-          ++i;
-        }
+      if (mDeadlineHeapSize == 0 ||
+          now < getDeadline(mSlots[mDeadlineHeap[0]])) {
+        break;
+      }
+
+      uint16_t slot = mDeadlineHeap[0];
+      Transaction &transaction = mSlots[slot];
+      if ((transaction.timeoutTime.toRawNanoseconds() != 0 &&
+           transaction.timeoutTime <= now) ||
+          transaction.numCompletedStartCalls > kMaxNumRetries) {
+        doCompleteTransactionLocked(transaction);
+        removeTransactionLocked(slot);
+      } else {
+        doStartTransactionLocked(transaction, now);
+        heapUpdateLocked(slot);
       }
-    } while (continueProcessing);
+    }
+
+    if (mDeadlineHeapSize > 0) {
+      nextExecutionTime = getDeadline(mSlots[mDeadlineHeap[0]]);
+    }
   }
 
-  Nanoseconds waitTime = nextExecutionTime - SystemTime::getMonotonicTime();
-  if (waitTime.toRawNanoseconds() > 0) {
-    kDeferCallback(
-        TransactionManager<TransactionData, kMaxTransactions>::onTimerFired,
-        /* data= */ this, /* extraData= */ nullptr, waitTime, &mTimerHandle);
-    CHRE_ASSERT(mTimerHandle != CHRE_TIMER_INVALID);
+  if (nextExecutionTime.has_value()) {
+    now = SystemTime::getMonotonicTime();
+    if (now < *nextExecutionTime) {
+      kDeferCallback(
+          TransactionManager<TransactionData, kMaxTransactions>::onTimerFired,
+          /* data= */ this, /* extraData= */ nullptr, *nextExecutionTime - now,
+          &mTimerHandle);
+      CHRE_ASSERT(mTimerHandle != CHRE_TIMER_INVALID);
+    } else {
+      deferProcessTransactions();
+    }
   }
 }
 
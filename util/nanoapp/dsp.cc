@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/nanoapp/dsp.h"
+
+#include <cmath>
+
+#include "chre/util/nanoapp/math.h"
+
+namespace chre {
+namespace {
+
+float getWindowCoefficient(WindowType type, size_t index, size_t size) {
+  float phase = 2.0f * CHRE_PI_F * static_cast<float>(index) /
+                static_cast<float>(size);
+  switch (type) {
+    case WindowType::HANN:
+      return 0.5f - 0.5f * cosf(phase);
+    case WindowType::HAMMING:
+      return 0.54f - 0.46f * cosf(phase);
+    case WindowType::BLACKMAN:
+      return 0.42f - 0.5f * cosf(phase) + 0.08f * cosf(2.0f * phase);
+    case WindowType::RECTANGULAR:
+    default:
+      return 1.0f;
+  }
+}
+
+//! @return floor(sqrt(value)), computed one bit at a time.
+uint32_t integerSqrt(uint32_t value) {
+  uint32_t result = 0;
+  uint32_t bit = UINT32_C(1) << 30;
+  while (bit > value) {
+    bit >>= 2;
+  }
+
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return result;
+}
+
+}  // anonymous namespace
+
+int16_t floatToQ15(float value) {
+  return saturateQ15(static_cast<int32_t>(lrintf(value * 32768.0f)));
+}
+
+void generateWindow(WindowType type, float *window, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    window[i] = getWindowCoefficient(type, i, size);
+  }
+}
+
+void generateWindowQ15(WindowType type, int16_t *window, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    window[i] = floatToQ15(getWindowCoefficient(type, i, size));
+  }
+}
+
+void applyWindow(const float *input, const float *window, float *output,
+                 size_t size) {
+  CHRE_DSP_VECTORIZE_LOOP
+  for (size_t i = 0; i < size; i++) {
+    output[i] = input[i] * window[i];
+  }
+}
+
+void applyWindowQ15(const int16_t *input, const int16_t *window,
+                    int16_t *output, size_t size) {
+  CHRE_DSP_VECTORIZE_LOOP
+  for (size_t i = 0; i < size; i++) {
+    // The product of two Q15 values can only overflow for -1 * -1, which
+    // can't happen since the window is positive.
+    output[i] = static_cast<int16_t>(
+        (static_cast<int32_t>(input[i]) * window[i] + (1 << 14)) >> 15);
+  }
+}
+
+float dotProduct(const float *CHRE_DSP_RESTRICT a,
+                 const float *CHRE_DSP_RESTRICT b, size_t size) {
+  // Independent accumulators map to the lanes of a vector register.
+  constexpr size_t kNumLanes = 4;
+  float sums[kNumLanes] = {};
+  size_t i = 0;
+  for (; i + kNumLanes <= size; i += kNumLanes) {
+    CHRE_DSP_VECTORIZE_LOOP
+    for (size_t lane = 0; lane < kNumLanes; lane++) {
+      sums[lane] += a[i + lane] * b[i + lane];
+    }
+  }
+
+  float sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+  for (; i < size; i++) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+void computePowerSpectrum(const ComplexF *CHRE_DSP_RESTRICT spectrum,
+                          float *CHRE_DSP_RESTRICT power, size_t size) {
+  CHRE_DSP_VECTORIZE_LOOP
+  for (size_t i = 0; i < size; i++) {
+    power[i] =
+        spectrum[i].re * spectrum[i].re + spectrum[i].im * spectrum[i].im;
+  }
+}
+
+void computeMagnitudes(const ComplexF *CHRE_DSP_RESTRICT spectrum,
+                       float *CHRE_DSP_RESTRICT magnitudes, size_t size) {
+  computePowerSpectrum(spectrum, magnitudes, size);
+  for (size_t i = 0; i < size; i++) {
+    magnitudes[i] = sqrtf(magnitudes[i]);
+  }
+}
+
+void computeMagnitudesQ15(const ComplexQ15 *spectrum, uint16_t *magnitudes,
+                          size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    int32_t re = spectrum[i].re;
+    int32_t im = spectrum[i].im;
+    // At most 2 * 2^30, which fits in 32 bits unsigned.
+    uint32_t power = static_cast<uint32_t>(re * re) +
+                     static_cast<uint32_t>(im * im);
+    magnitudes[i] = static_cast<uint16_t>(integerSqrt(power));
+  }
+}
+
+}  // namespace chre
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/nanoapp/fft.h"
+
+#include <cmath>
+#include <utility>
+
+#include "chre/util/nanoapp/math.h"
+
+namespace chre {
+namespace internal {
+namespace {
+
+/**
+ * Reorders the elements in bit-reversed index order, as needed by the
+ * in-place iterative FFT.
+ */
+template <typename T>
+void bitReversePermute(T *data, size_t size) {
+  for (size_t i = 1, j = 0; i < size; i++) {
+    size_t bit = size >> 1;
+    for (; (j & bit) != 0; bit >>= 1) {
+      j ^= bit;
+    }
+    j ^= bit;
+
+    if (i < j) {
+      std::swap(data[i], data[j]);
+    }
+  }
+}
+
+int32_t roundingShiftRight(int32_t value, int shift) {
+  return (value + (1 << (shift - 1))) >> shift;
+}
+
+}  // anonymous namespace
+
+void initRealFftTwiddles(ComplexF *twiddles, size_t size) {
+  for (size_t k = 0; k < size / 2; k++) {
+    float phase = -2.0f * CHRE_PI_F * static_cast<float>(k) /
+                  static_cast<float>(size);
+    twiddles[k] = {cosf(phase), sinf(phase)};
+  }
+}
+
+void initRealFftTwiddlesQ15(ComplexQ15 *twiddles, size_t size) {
+  for (size_t k = 0; k < size / 2; k++) {
+    float phase = -2.0f * CHRE_PI_F * static_cast<float>(k) /
+                  static_cast<float>(size);
+    twiddles[k] = {floatToQ15(cosf(phase)), floatToQ15(sinf(phase))};
+  }
+}
+
+void computeRealFft(const float *CHRE_DSP_RESTRICT input,
+                    ComplexF *CHRE_DSP_RESTRICT output,
+                    ComplexF *CHRE_DSP_RESTRICT work,
+                    const ComplexF *CHRE_DSP_RESTRICT twiddles, size_t size) {
+  // Pack the even and odd samples as the real and imaginary parts of a complex
+  // signal of half the size.
+  const size_t halfSize = size / 2;
+  for (size_t i = 0; i < halfSize; i++) {
+    work[i] = {input[2 * i], input[2 * i + 1]};
+  }
+  bitReversePermute(work, halfSize);
+
+  // Radix-2 decimation in time. The twiddles of a stage of length len are
+  // every (size / len)-th twiddle of the full size.
+  for (size_t len = 2; len <= halfSize; len <<= 1) {
+    const size_t half = len / 2;
+    const size_t twiddleStride = size / len;
+    for (size_t start = 0; start < halfSize; start += len) {
+      ComplexF *CHRE_DSP_RESTRICT top = &work[start];
+      ComplexF *CHRE_DSP_RESTRICT bottom = &work[start + half];
+      CHRE_DSP_VECTORIZE_LOOP
+      for (size_t j = 0; j < half; j++) {
+        const ComplexF w = twiddles[j * twiddleStride];
+        const ComplexF a = top[j];
+        const ComplexF b = bottom[j];
+        const float tRe = b.re * w.re - b.im * w.im;
+        const float tIm = b.re * w.im + b.im * w.re;
+        top[j] = {a.re + tRe, a.im + tIm};
+        bottom[j] = {a.re - tRe, a.im - tIm};
+      }
+    }
+  }
+
+  // Split the spectra of the even and odd samples, and recombine them:
+  // X[k] = E[k] + W^k * O[k], with E[k] = (Z[k] + conj(Z[M - k])) / 2 and
+  // O[k] = -i * (Z[k] - conj(Z[M - k])) / 2.
+  for (size_t k = 0; k <= halfSize; k++) {
+    const ComplexF z = work[k % halfSize];
+    const ComplexF zc = work[(halfSize - k) % halfSize];
+    const float evenRe = 0.5f * (z.re + zc.re);
+    const float evenIm = 0.5f * (z.im - zc.im);
+    const float oddRe = 0.5f * (z.im + zc.im);
+    const float oddIm = -0.5f * (z.re - zc.re);
+    const ComplexF w = (k < halfSize) ? twiddles[k] : ComplexF{-1.0f, 0.0f};
+    output[k] = {evenRe + oddRe * w.re - oddIm * w.im,
+                 evenIm + oddRe * w.im + oddIm * w.re};
+  }
+}
+
+void computeRealFftQ15(const int16_t *CHRE_DSP_RESTRICT input,
+                       ComplexQ15 *CHRE_DSP_RESTRICT output,
+                       ComplexQ15 *CHRE_DSP_RESTRICT work,
+                       const ComplexQ15 *CHRE_DSP_RESTRICT twiddles,
+                       size_t size) {
+  const size_t halfSize = size / 2;
+  for (size_t i = 0; i < halfSize; i++) {
+    work[i] = {input[2 * i], input[2 * i + 1]};
+  }
+  bitReversePermute(work, halfSize);
+
+  for (size_t len = 2; len <= halfSize; len <<= 1) {
+    const size_t half = len / 2;
+    const size_t twiddleStride = size / len;
+    for (size_t start = 0; start < halfSize; start += len) {
+      ComplexQ15 *CHRE_DSP_RESTRICT top = &work[start];
+      ComplexQ15 *CHRE_DSP_RESTRICT bottom = &work[start + half];
+      CHRE_DSP_VECTORIZE_LOOP
+      for (size_t j = 0; j < half; j++) {
+        const ComplexQ15 w = twiddles[j * twiddleStride];
+        const int32_t aRe = top[j].re;
+        const int32_t aIm = top[j].im;
+        const int32_t bRe = bottom[j].re;
+        const int32_t bIm = bottom[j].im;
+        const int32_t tRe = roundingShiftRight(bRe * w.re - bIm * w.im, 15);
+        const int32_t tIm = roundingShiftRight(bRe * w.im + bIm * w.re, 15);
+        // Halve the outputs so that the stage can't overflow.
+        top[j] = {saturateQ15(roundingShiftRight(aRe + tRe, 1)),
+                  saturateQ15(roundingShiftRight(aIm + tIm, 1))};
+        bottom[j] = {saturateQ15(roundingShiftRight(aRe - tRe, 1)),
+                     saturateQ15(roundingShiftRight(aIm - tIm, 1))};
+      }
+    }
+  }
+
+  // Same as the floating point split, also dividing by 2 to get a spectrum
+  // divided by size.
+  for (size_t k = 0; k <= halfSize; k++) {
+    const ComplexQ15 z = work[k % halfSize];
+    const ComplexQ15 zc = work[(halfSize - k) % halfSize];
+    const int32_t evenRe = z.re + zc.re;
+    const int32_t evenIm = z.im - zc.im;
+    const int32_t oddRe = z.im + zc.im;
+    const int32_t oddIm = zc.re - z.re;
+    const int32_t wRe = (k < halfSize) ? twiddles[k].re : -32768;
+    const int32_t wIm = (k < halfSize) ? twiddles[k].im : 0;
+    // Needs 64 bits, as the sums of two Q15 values are multiplied again.
+    const int64_t re = (static_cast<int64_t>(evenRe) << 15) +
+                       static_cast<int64_t>(oddRe) * wRe -
+                       static_cast<int64_t>(oddIm) * wIm;
+    const int64_t im = (static_cast<int64_t>(evenIm) << 15) +
+                       static_cast<int64_t>(oddRe) * wIm +
+                       static_cast<int64_t>(oddIm) * wRe;
+    output[k] = {saturateQ15(static_cast<int32_t>((re + (1 << 16)) >> 17)),
+                 saturateQ15(static_cast<int32_t>((im + (1 << 16)) >> 17))};
+  }
+}
+
+}  // namespace internal
+}  // namespace chre
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/nanoapp/filter.h"
+
+#include <cmath>
+
+#include "chre/util/nanoapp/math.h"
+
+namespace chre {
+namespace {
+
+struct BiquadParameters {
+  float cosW0;
+  float alpha;
+};
+
+BiquadParameters getBiquadParameters(float frequencyHz, float sampleRateHz,
+                                     float q) {
+  float w0 = 2.0f * CHRE_PI_F * frequencyHz / sampleRateHz;
+  return {cosf(w0), sinf(w0) / (2.0f * q)};
+}
+
+BiquadCoefficients normalizeBiquad(float b0, float b1, float b2, float a0,
+                                   float a1, float a2) {
+  return {b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+}
+
+}  // anonymous namespace
+
+BiquadCoefficients designLowPassBiquad(float frequencyHz, float sampleRateHz,
+                                       float q) {
+  BiquadParameters p = getBiquadParameters(frequencyHz, sampleRateHz, q);
+  return normalizeBiquad((1.0f - p.cosW0) / 2.0f, 1.0f - p.cosW0,
+                         (1.0f - p.cosW0) / 2.0f, 1.0f + p.alpha,
+                         -2.0f * p.cosW0, 1.0f - p.alpha);
+}
+
+BiquadCoefficients designHighPassBiquad(float frequencyHz, float sampleRateHz,
+                                        float q) {
+  BiquadParameters p = getBiquadParameters(frequencyHz, sampleRateHz, q);
+  return normalizeBiquad((1.0f + p.cosW0) / 2.0f, -(1.0f + p.cosW0),
+                         (1.0f + p.cosW0) / 2.0f, 1.0f + p.alpha,
+                         -2.0f * p.cosW0, 1.0f - p.alpha);
+}
+
+BiquadCoefficients designBandPassBiquad(float frequencyHz, float sampleRateHz,
+                                        float q) {
+  // Constant 0 dB peak gain.
+  BiquadParameters p = getBiquadParameters(frequencyHz, sampleRateHz, q);
+  return normalizeBiquad(p.alpha, 0.0f, -p.alpha, 1.0f + p.alpha,
+                         -2.0f * p.cosW0, 1.0f - p.alpha);
+}
+
+namespace internal {
+
+void processBiquad(const BiquadCoefficients &coefficients, float *state,
+                   const float *input, float *output, size_t size) {
+  const BiquadCoefficients c = coefficients;
+  float s1 = state[0];
+  float s2 = state[1];
+  for (size_t i = 0; i < size; i++) {
+    const float x = input[i];
+    const float y = c.b0 * x + s1;
+    s1 = c.b1 * x - c.a1 * y + s2;
+    s2 = c.b2 * x - c.a2 * y;
+    output[i] = y;
+  }
+  state[0] = s1;
+  state[1] = s2;
+}
+
+void processBiquadBank(const float *CHRE_DSP_RESTRICT b0,
+                       const float *CHRE_DSP_RESTRICT b1,
+                       const float *CHRE_DSP_RESTRICT b2,
+                       const float *CHRE_DSP_RESTRICT a1,
+                       const float *CHRE_DSP_RESTRICT a2,
+                       float *CHRE_DSP_RESTRICT state1,
+                       float *CHRE_DSP_RESTRICT state2,
+                       float *CHRE_DSP_RESTRICT energies,
+                       const float *CHRE_DSP_RESTRICT input, size_t size,
+                       size_t numFilters) {
+  // Each filter is recursive over time, so vectorize across the filters.
+  for (size_t i = 0; i < size; i++) {
+    const float x = input[i];
+    CHRE_DSP_VECTORIZE_LOOP
+    for (size_t f = 0; f < numFilters; f++) {
+      const float y = b0[f] * x + state1[f];
+      state1[f] = b1[f] * x - a1[f] * y + state2[f];
+      state2[f] = b2[f] * x - a2[f] * y;
+      energies[f] += y * y;
+    }
+  }
+}
+
+void processFir(const float *taps, float *history, size_t numTaps,
+                size_t *position, const float *input, float *output,
+                size_t size) {
+  size_t p = *position;
+  for (size_t i = 0; i < size; i++) {
+    history[p] = input[i];
+    history[p + numTaps] = input[i];
+    p = (p + 1 == numTaps) ? 0 : p + 1;
+    // The last numTaps samples, oldest first, start at the next position.
+    output[i] = dotProduct(taps, &history[p], numTaps);
+  }
+  *position = p;
+}
+
+}  // namespace internal
+}  // namespace chre
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/nanoapp/mel_filterbank.h"
+
+#include <cmath>
+
+namespace chre {
+
+float hzToMel(float frequencyHz) {
+  return 2595.0f * log10f(1.0f + frequencyHz / 700.0f);
+}
+
+float melToHz(float mel) {
+  return 700.0f * (powf(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+namespace internal {
+
+bool initMelFilterbank(float sampleRateHz, float minFrequencyHz,
+                       float maxFrequencyHz, size_t numBins, size_t numBands,
+                       uint16_t *bandStart, uint16_t *bandSize, float *weights,
+                       size_t maxNumWeights) {
+  if (sampleRateHz <= 0.0f || minFrequencyHz < 0.0f ||
+      maxFrequencyHz <= minFrequencyHz ||
+      maxFrequencyHz > sampleRateHz / 2.0f) {
+    return false;
+  }
+
+  const float minMel = hzToMel(minFrequencyHz);
+  const float melStep = (hzToMel(maxFrequencyHz) - minMel) / (numBands + 1);
+  const float binWidthHz = sampleRateHz / (2.0f * (numBins - 1));
+
+  size_t numWeights = 0;
+  for (size_t band = 0; band < numBands; band++) {
+    const float lowHz = melToHz(minMel + band * melStep);
+    const float centerHz = melToHz(minMel + (band + 1) * melStep);
+    const float highHz = melToHz(minMel + (band + 2) * melStep);
+
+    bandStart[band] = 0;
+    bandSize[band] = 0;
+    for (size_t bin = 0; bin < numBins; bin++) {
+      const float frequencyHz = bin * binWidthHz;
+      float weight = 0.0f;
+      if (frequencyHz > lowHz && frequencyHz <= centerHz) {
+        weight = (frequencyHz - lowHz) / (centerHz - lowHz);
+      } else if (frequencyHz > centerHz && frequencyHz < highHz) {
+        weight = (highHz - frequencyHz) / (highHz - centerHz);
+      }
+
+      if (weight > 0.0f) {
+        if (numWeights == maxNumWeights) {
+          return false;
+        }
+        if (bandSize[band] == 0) {
+          bandStart[band] = static_cast<uint16_t>(bin);
+        }
+        bandSize[band]++;
+        weights[numWeights++] = weight;
+      }
+    }
+  }
+
+  return true;
+}
+
+void applyMelFilterbank(const uint16_t *bandStart, const uint16_t *bandSize,
+                        const float *weights, size_t numBands,
+                        const float *powerSpectrum, float *bandEnergies) {
+  for (size_t band = 0; band < numBands; band++) {
+    bandEnergies[band] =
+        dotProduct(weights, &powerSpectrum[bandStart[band]], bandSize[band]);
+    weights += bandSize[band];
+  }
+}
+
+}  // namespace internal
+}  // namespace chre
@@ -18,14 +18,17 @@
 
 #include <cstdint>
 
-#include "chre/util/nanoapp/callbacks.h"
 #include "chre/util/pigweed/rpc_helper.h"
 
 namespace chre {
 namespace {
 
 void nappMessageFreeCb(uint16_t /* eventType */, void *eventData) {
-  chreHeapFree(eventData);
+  ChreChannelOutputBufferPool::release(eventData);
+}
+
+void hostMessageFreeCb(void *message, size_t /* messageSize */) {
+  ChreChannelOutputBufferPool::release(message);
 }
 
 /**
@@ -33,19 +36,20 @@ void nappMessageFreeCb(uint16_t /* eventType */, void *eventData) {
  *
  * The buffer is first wrapped into a ChrePigweedNanoappMessage struct.
  *
+ * @param bufferPool The pool to allocate the message from
  * @param targetInstanceId The nanoapp to send the message to
  * @param eventType The event to send to the nanoapp
  * @param buffer The buffer to send
  * @return The status of the operation
  */
-pw::Status sendToNanoapp(uint32_t targetInstanceId, uint16_t eventType,
+pw::Status sendToNanoapp(ChreChannelOutputBufferPool &bufferPool,
+                         uint32_t targetInstanceId, uint16_t eventType,
                          pw::span<const std::byte> buffer) {
   CHRE_ASSERT(targetInstanceId != 0);
 
   if (buffer.size() > 0) {
-    auto *data = static_cast<ChrePigweedNanoappMessage *>(
-        chreHeapAlloc(static_cast<uint32_t>(
-            buffer.size() + sizeof(ChrePigweedNanoappMessage))));
+    auto *data = static_cast<ChrePigweedNanoappMessage *>(bufferPool.allocate(
+        buffer.size() + sizeof(ChrePigweedNanoappMessage)));
     if (data == nullptr) {
       return PW_STATUS_RESOURCE_EXHAUSTED;
     }
@@ -63,6 +67,39 @@ pw::Status sendToNanoapp(uint32_t targetInstanceId, uint16_t eventType,
 
 }  // namespace
 
+void *ChreChannelOutputBufferPool::allocate(size_t size) {
+  BufferHeader *header = nullptr;
+
+  if (size <= CHRE_PW_RPC_POOLED_BUFFER_SIZE) {
+    PooledBuffer *pooledBuffer = mPool.allocate();
+    if (pooledBuffer != nullptr) {
+      header = &pooledBuffer->header;
+      header->pool = this;
+    }
+  }
+
+  if (header == nullptr) {
+    header = static_cast<BufferHeader *>(
+        chreHeapAlloc(static_cast<uint32_t>(sizeof(BufferHeader) + size)));
+    if (header == nullptr) {
+      return nullptr;
+    }
+    header->pool = nullptr;
+  }
+
+  return header + 1;
+}
+
+void ChreChannelOutputBufferPool::release(void *buffer) {
+  BufferHeader *header = static_cast<BufferHeader *>(buffer) - 1;
+
+  if (header->pool == nullptr) {
+    chreHeapFree(header);
+  } else {
+    header->pool->mPool.deallocate(reinterpret_cast<PooledBuffer *>(header));
+  }
+}
+
 void ChreServerNanoappChannelOutput::setClient(uint32_t nanoappInstanceId) {
   CHRE_ASSERT(nanoappInstanceId <= kRpcNanoappMaxId);
   if (nanoappInstanceId <= kRpcNanoappMaxId) {
@@ -82,7 +119,8 @@ pw::Status ChreServerNanoappChannelOutput::Send(
   // reset the value as it is only applicable to the next message.
   mPermission.getAndReset();
 
-  return sendToNanoapp(mClientInstanceId, CHRE_EVENT_RPC_RESPONSE, buffer);
+  return sendToNanoapp(mBufferPool, mClientInstanceId, CHRE_EVENT_RPC_RESPONSE,
+                       buffer);
 }
 
 void ChreClientNanoappChannelOutput::setServer(uint32_t instanceId) {
@@ -100,7 +138,8 @@ size_t ChreClientNanoappChannelOutput::MaximumTransmissionUnit() {
 
 pw::Status ChreClientNanoappChannelOutput::Send(
     pw::span<const std::byte> buffer) {
-  return sendToNanoapp(mServerInstanceId, CHRE_EVENT_RPC_REQUEST, buffer);
+  return sendToNanoapp(mBufferPool, mServerInstanceId, CHRE_EVENT_RPC_REQUEST,
+                       buffer);
 }
 
 void ChreServerHostChannelOutput::setHostEndpoint(uint16_t hostEndpoint) {
@@ -117,15 +156,14 @@ pw::Status ChreServerHostChannelOutput::Send(pw::span<const std::byte> buffer) {
 
   if (buffer.size() > 0) {
     uint32_t permission = mPermission.getAndReset();
-    uint8_t *data = static_cast<uint8_t *>(
-        chreHeapAlloc(static_cast<uint32_t>(buffer.size())));
+    void *data = mBufferPool.allocate(buffer.size());
     if (data == nullptr) {
       returnCode = PW_STATUS_RESOURCE_EXHAUSTED;
     } else {
       memcpy(data, buffer.data(), buffer.size());
       if (!chreSendMessageWithPermissions(
               data, buffer.size(), CHRE_MESSAGE_TYPE_RPC, mEndpointId,
-              permission, heapFreeMessageCallback)) {
+              permission, hostMessageFreeCb)) {
         returnCode = PW_STATUS_INVALID_ARGUMENT;
       }
     }
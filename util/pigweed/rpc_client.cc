@@ -67,14 +67,11 @@ bool RpcClient::handleMessageFromServer(uint32_t senderInstanceId,
   auto data = static_cast<const chre::ChrePigweedNanoappMessage *>(eventData);
   pw::span packet(reinterpret_cast<const std::byte *>(data->msg),
                   data->msgSize);
-  struct chreNanoappInfo info;
-
-  if (!chreGetNanoappInfoByAppId(mServerNanoappId, &info) ||
-      info.instanceId > kRpcNanoappMaxId) {
-    return false;
-  }
 
-  if (!validateNanoappChannelId(senderInstanceId, info.instanceId)) {
+  // The server instance ID is resolved when the channel is opened, there is no
+  // need to look it up for each packet.
+  if (mChannelId == 0 ||
+      !validateNanoappChannelId(senderInstanceId, mChannelOutput.getServer())) {
     return false;
   }
 
@@ -96,7 +93,7 @@ void RpcClient::handleNanoappStopped(const void *eventData) {
     return;
   }
 
-  if (info->instanceId == mChannelId) {
+  if (mChannelId != 0 && info->instanceId == mChannelOutput.getServer()) {
     mRpcClient.CloseChannel(mChannelId);
     mChannelId = 0;
   }
@@ -83,6 +83,7 @@ bool RpcServer::handleEvent(uint32_t senderInstanceId, uint16_t eventType,
 
 void RpcServer::close() {
   chreConfigureNanoappInfoEvents(false);
+  mNanoappInfoEventsEnabled = false;
   // TODO(b/251257328): Disable all notifications at once.
   while (!mConnectedHosts.empty()) {
     chreConfigureHostEndpointNotifications(mConnectedHosts[0], false);
@@ -110,13 +111,14 @@ bool RpcServer::handleMessageFromHost(const void *eventData) {
     return false;
   }
 
-  if (!chreConfigureHostEndpointNotifications(hostMessage->hostEndpoint,
-                                              true)) {
-    LOGW("Fail to register for host client updates");
-  }
-
+  // Only register for the updates of new clients so that streams of packets
+  // from a connected client skip the registration.
   size_t hostIndex = mConnectedHosts.find(hostMessage->hostEndpoint);
   if (hostIndex == mConnectedHosts.size()) {
+    if (!chreConfigureHostEndpointNotifications(hostMessage->hostEndpoint,
+                                                true)) {
+      LOGW("Fail to register for host client updates");
+    }
     mConnectedHosts.push_back(hostMessage->hostEndpoint);
   }
 
@@ -150,7 +152,10 @@ bool RpcServer::handleMessageFromNanoapp(uint32_t senderInstanceId,
     return false;
   }
 
-  chreConfigureNanoappInfoEvents(true);
+  if (!mNanoappInfoEventsEnabled) {
+    chreConfigureNanoappInfoEvents(true);
+    mNanoappInfoEventsEnabled = true;
+  }
 
   mNanoappOutput.setClient(senderInstanceId);
   mServer.OpenChannel(result.value(), mNanoappOutput);
@@ -0,0 +1,361 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/nanoapp/dsp.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "chre/util/nanoapp/fft.h"
+#include "chre/util/nanoapp/filter.h"
+#include "chre/util/nanoapp/math.h"
+#include "chre/util/nanoapp/mel_filterbank.h"
+
+using chre::BiquadCascade;
+using chre::BiquadFilterBank;
+using chre::ComplexF;
+using chre::ComplexQ15;
+using chre::FirFilter;
+using chre::MelFilterbank;
+using chre::RealFft;
+using chre::RealFftQ15;
+using chre::WindowType;
+
+namespace {
+
+constexpr float kSampleRateHz = 16000.0f;
+
+void generateSine(float frequencyHz, float amplitude, float *samples,
+                  size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    samples[i] = amplitude * sinf(2.0f * CHRE_PI_F * frequencyHz * i /
+                                  kSampleRateHz);
+  }
+}
+
+void computeNaiveDft(const float *input, ComplexF *output, size_t size) {
+  for (size_t k = 0; k <= size / 2; k++) {
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t n = 0; n < size; n++) {
+      double phase = -2.0 * M_PI * k * n / size;
+      re += input[n] * cos(phase);
+      im += input[n] * sin(phase);
+    }
+    output[k] = {static_cast<float>(re), static_cast<float>(im)};
+  }
+}
+
+float computeEnergy(const float *samples, size_t size) {
+  float energy = 0.0f;
+  for (size_t i = 0; i < size; i++) {
+    energy += samples[i] * samples[i];
+  }
+  return energy;
+}
+
+}  // namespace
+
+TEST(Dsp, Q15Conversions) {
+  EXPECT_EQ(chre::floatToQ15(0.5f), 16384);
+  EXPECT_EQ(chre::floatToQ15(-1.0f), INT16_MIN);
+  EXPECT_EQ(chre::floatToQ15(1.0f), INT16_MAX);
+  EXPECT_EQ(chre::floatToQ15(-3.0f), INT16_MIN);
+  EXPECT_FLOAT_EQ(chre::q15ToFloat(-16384), -0.5f);
+  EXPECT_EQ(chre::multiplyQ15(16384, 16384), 8192);
+  EXPECT_EQ(chre::multiplyQ15(INT16_MIN, INT16_MIN), INT16_MAX);
+}
+
+TEST(Dsp, Windows) {
+  constexpr size_t kSize = 16;
+  float window[kSize];
+
+  chre::generateWindow(WindowType::HANN, window, kSize);
+  EXPECT_NEAR(window[0], 0.0f, 1e-6f);
+  EXPECT_NEAR(window[kSize / 2], 1.0f, 1e-6f);
+  // Periodic, so symmetric around the center without the first sample.
+  for (size_t i = 1; i < kSize / 2; i++) {
+    EXPECT_NEAR(window[i], window[kSize - i], 1e-6f);
+  }
+
+  chre::generateWindow(WindowType::HAMMING, window, kSize);
+  EXPECT_NEAR(window[0], 0.08f, 1e-6f);
+
+  chre::generateWindow(WindowType::BLACKMAN, window, kSize);
+  EXPECT_NEAR(window[0], 0.0f, 1e-6f);
+  EXPECT_NEAR(window[kSize / 2], 1.0f, 1e-6f);
+
+  int16_t windowQ15[kSize];
+  chre::generateWindowQ15(WindowType::HANN, windowQ15, kSize);
+  EXPECT_EQ(windowQ15[0], 0);
+  EXPECT_EQ(windowQ15[kSize / 2], INT16_MAX);
+
+  int16_t input[kSize];
+  for (size_t i = 0; i < kSize; i++) {
+    input[i] = 16384;
+  }
+  chre::applyWindowQ15(input, windowQ15, input, kSize);
+  EXPECT_EQ(input[0], 0);
+  EXPECT_EQ(input[kSize / 2], 16384);
+}
+
+TEST(Dsp, DotProduct) {
+  float a[7] = {1, 2, 3, 4, 5, 6, 7};
+  float b[7] = {7, 6, 5, 4, 3, 2, 1};
+  EXPECT_FLOAT_EQ(chre::dotProduct(a, b, 7), 84.0f);
+  EXPECT_FLOAT_EQ(chre::dotProduct(a, b, 0), 0.0f);
+}
+
+TEST(Dsp, Magnitudes) {
+  ComplexF spectrum[2] = {{3.0f, 4.0f}, {0.0f, -2.0f}};
+  float magnitudes[2];
+  chre::computeMagnitudes(spectrum, magnitudes, 2);
+  EXPECT_FLOAT_EQ(magnitudes[0], 5.0f);
+  EXPECT_FLOAT_EQ(magnitudes[1], 2.0f);
+
+  ComplexQ15 spectrumQ15[3] = {{300, -400}, {INT16_MIN, INT16_MIN}, {0, 0}};
+  uint16_t magnitudesQ15[3];
+  chre::computeMagnitudesQ15(spectrumQ15, magnitudesQ15, 3);
+  EXPECT_EQ(magnitudesQ15[0], 500);
+  EXPECT_EQ(magnitudesQ15[1], 46340);
+  EXPECT_EQ(magnitudesQ15[2], 0);
+}
+
+TEST(Dsp, RealFftMatchesDft) {
+  constexpr size_t kSize = 64;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  float input[kSize];
+  for (size_t i = 0; i < kSize; i++) {
+    input[i] = distribution(generator);
+  }
+
+  RealFft<kSize> fft;
+  ComplexF output[RealFft<kSize>::kNumBins];
+  ComplexF expected[RealFft<kSize>::kNumBins];
+  fft.forward(input, output);
+  computeNaiveDft(input, expected, kSize);
+
+  for (size_t k = 0; k < RealFft<kSize>::kNumBins; k++) {
+    EXPECT_NEAR(output[k].re, expected[k].re, 1e-4f) << "bin " << k;
+    EXPECT_NEAR(output[k].im, expected[k].im, 1e-4f) << "bin " << k;
+  }
+}
+
+TEST(Dsp, RealFftQ15MatchesFloat) {
+  constexpr size_t kSize = 128;
+  float input[kSize];
+  int16_t inputQ15[kSize];
+  generateSine(1000.0f, 0.5f, input, kSize);
+  for (size_t i = 0; i < kSize; i++) {
+    input[i] += 0.25f * cosf(2.0f * CHRE_PI_F * 5000.0f * i / kSampleRateHz);
+    inputQ15[i] = chre::floatToQ15(input[i]);
+  }
+
+  RealFft<kSize> fft;
+  RealFftQ15<kSize> fftQ15;
+  ComplexF output[RealFft<kSize>::kNumBins];
+  ComplexQ15 outputQ15[RealFftQ15<kSize>::kNumBins];
+  fft.forward(input, output);
+  fftQ15.forward(inputQ15, outputQ15);
+
+  // The fixed point spectrum is divided by the size.
+  for (size_t k = 0; k < RealFftQ15<kSize>::kNumBins; k++) {
+    EXPECT_NEAR(chre::q15ToFloat(outputQ15[k].re), output[k].re / kSize, 2e-4f)
+        << "bin " << k;
+    EXPECT_NEAR(chre::q15ToFloat(outputQ15[k].im), output[k].im / kSize, 2e-4f)
+        << "bin " << k;
+  }
+
+  // 1 kHz is bin 8 and 5 kHz bin 40, with amplitudes of A / 2.
+  uint16_t magnitudes[RealFftQ15<kSize>::kNumBins];
+  chre::computeMagnitudesQ15(outputQ15, magnitudes, RealFftQ15<kSize>::kNumBins);
+  EXPECT_NEAR(magnitudes[8], 8192, 16);
+  EXPECT_NEAR(magnitudes[40], 4096, 16);
+  EXPECT_LT(magnitudes[20], 16);
+}
+
+TEST(Dsp, BiquadLowPassAttenuatesHighFrequencies) {
+  constexpr size_t kSize = 1024;
+  BiquadCascade<2> filter;
+  chre::BiquadCoefficients coefficients =
+      chre::designLowPassBiquad(1000.0f, kSampleRateHz, 0.7071f);
+  filter.setStage(0, coefficients);
+  filter.setStage(1, coefficients);
+
+  float low[kSize];
+  float high[kSize];
+  generateSine(200.0f, 1.0f, low, kSize);
+  generateSine(6000.0f, 1.0f, high, kSize);
+  float inputEnergy = computeEnergy(low, kSize);
+
+  filter.process(low, low, kSize);
+  filter.reset();
+  filter.process(high, high, kSize);
+
+  EXPECT_GT(computeEnergy(low, kSize), 0.9f * inputEnergy);
+  EXPECT_LT(computeEnergy(high, kSize), 1e-3f * inputEnergy);
+}
+
+TEST(Dsp, BiquadCascadeDefaultsToPassThrough) {
+  BiquadCascade<3> filter;
+  float input[4] = {1.0f, -2.0f, 3.0f, 0.5f};
+  float output[4];
+  filter.process(input, output, 4);
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_FLOAT_EQ(output[i], input[i]);
+  }
+}
+
+TEST(Dsp, FirImpulseResponse) {
+  constexpr size_t kNumTaps = 5;
+  const float taps[kNumTaps] = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f};
+  FirFilter<kNumTaps> filter;
+  filter.setTaps(taps);
+
+  // Processed in two blocks to check the history carries over.
+  float signal[8] = {1.0f, 0, 0, 0, 0, 0, 0, 0};
+  filter.process(signal, signal, 3);
+  filter.process(&signal[3], &signal[3], 5);
+  for (size_t i = 0; i < 8; i++) {
+    EXPECT_FLOAT_EQ(signal[i], (i < kNumTaps) ? taps[i] : 0.0f) << i;
+  }
+
+  filter.reset();
+  float step[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+  filter.process(step, step, 8);
+  EXPECT_FLOAT_EQ(step[7], 1.5f);
+}
+
+TEST(Dsp, BiquadFilterBankSeparatesBands) {
+  constexpr size_t kSize = 2048;
+  constexpr float kCenters[] = {250.0f, 1000.0f, 4000.0f};
+  BiquadFilterBank<3> bank;
+  for (size_t i = 0; i < 3; i++) {
+    bank.setFilter(i,
+                   chre::designBandPassBiquad(kCenters[i], kSampleRateHz, 4.0f));
+  }
+
+  float signal[kSize];
+  generateSine(1000.0f, 1.0f, signal, kSize);
+  float energies[3] = {};
+  bank.process(signal, kSize, energies);
+
+  EXPECT_GT(energies[1], 0.8f * computeEnergy(signal, kSize));
+  EXPECT_LT(energies[0], 0.05f * energies[1]);
+  EXPECT_LT(energies[2], 0.05f * energies[1]);
+}
+
+TEST(Dsp, MelScale) {
+  EXPECT_NEAR(chre::hzToMel(1000.0f), 1000.0f, 1.0f);
+  EXPECT_NEAR(chre::melToHz(chre::hzToMel(3456.0f)), 3456.0f, 0.1f);
+}
+
+TEST(Dsp, MelFilterbank) {
+  constexpr size_t kNumBins = RealFft<256>::kNumBins;
+  constexpr size_t kNumBands = 20;
+  MelFilterbank<kNumBins, kNumBands> filterbank;
+  EXPECT_FALSE(filterbank.init(kSampleRateHz, 100.0f, 9000.0f));
+  EXPECT_FALSE(filterbank.init(kSampleRateHz, 2000.0f, 1000.0f));
+  ASSERT_TRUE(filterbank.init(kSampleRateHz, 100.0f, 8000.0f));
+
+  // A flat spectrum gives energies growing with the width of the bands.
+  float spectrum[kNumBins];
+  float energies[kNumBands];
+  for (size_t i = 0; i < kNumBins; i++) {
+    spectrum[i] = 1.0f;
+  }
+  filterbank.apply(spectrum, energies);
+  for (size_t i = 1; i < kNumBands; i++) {
+    EXPECT_GE(energies[i], energies[i - 1]) << i;
+  }
+
+  // A single tone only excites the bands around it.
+  for (size_t i = 0; i < kNumBins; i++) {
+    spectrum[i] = 0.0f;
+  }
+  spectrum[64] = 1.0f;  // 4 kHz
+  filterbank.apply(spectrum, energies);
+  size_t numExcited = 0;
+  float total = 0.0f;
+  for (size_t i = 0; i < kNumBands; i++) {
+    numExcited += (energies[i] > 0.0f) ? 1 : 0;
+    total += energies[i];
+  }
+  EXPECT_GE(numExcited, 1);
+  EXPECT_LE(numExcited, 2);
+  // Adjacent triangles sum to one.
+  EXPECT_NEAR(total, 1.0f, 1e-5f);
+}
+
+// Times the building blocks of a typical audio front end, to compare them
+// across compilers and flags. Run with --gtest_also_run_disabled_tests.
+TEST(Dsp, DISABLED_Benchmark) {
+  constexpr size_t kSize = 256;
+  constexpr size_t kNumIterations = 20000;
+  float input[kSize];
+  int16_t inputQ15[kSize];
+  generateSine(440.0f, 0.5f, input, kSize);
+  for (size_t i = 0; i < kSize; i++) {
+    inputQ15[i] = chre::floatToQ15(input[i]);
+  }
+
+  RealFft<kSize> fft;
+  RealFftQ15<kSize> fftQ15;
+  FirFilter<32> fir;
+  BiquadFilterBank<16> bank;
+  MelFilterbank<RealFft<kSize>::kNumBins, 32> mel;
+  float taps[32];
+  chre::generateWindow(WindowType::HANN, taps, 32);
+  fir.setTaps(taps);
+  for (size_t i = 0; i < 16; i++) {
+    bank.setFilter(i, chre::designBandPassBiquad(200.0f * (i + 1),
+                                                 kSampleRateHz, 4.0f));
+  }
+  ASSERT_TRUE(mel.init(kSampleRateHz, 20.0f, kSampleRateHz / 2));
+
+  ComplexF spectrum[RealFft<kSize>::kNumBins];
+  ComplexQ15 spectrumQ15[RealFftQ15<kSize>::kNumBins];
+  float power[RealFft<kSize>::kNumBins];
+  float output[kSize];
+  float energies[32] = {};
+
+  auto time = [](const char *name, auto &&function) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < kNumIterations; i++) {
+      function();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    printf("%-24s %8.1f ns per frame of %zu samples\n", name,
+           static_cast<double>(
+               std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                   .count()) /
+               kNumIterations,
+           kSize);
+  };
+
+  time("RealFft", [&] { fft.forward(input, spectrum); });
+  time("RealFftQ15", [&] { fftQ15.forward(inputQ15, spectrumQ15); });
+  time("computePowerSpectrum", [&] {
+    chre::computePowerSpectrum(spectrum, power, RealFft<kSize>::kNumBins);
+  });
+  time("MelFilterbank (32)", [&] { mel.apply(power, energies); });
+  time("FirFilter (32 taps)", [&] { fir.process(input, output, kSize); });
+  time("BiquadFilterBank (16)", [&] { bank.process(input, kSize, energies); });
+}
@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/flat_hash_map.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+
+#include "chre/util/dynamic_vector.h"
+#include "chre/util/unique_ptr.h"
+
+using chre::DynamicVector;
+using chre::FixedSizeFlatHashMap;
+using chre::FlatHashMap;
+using chre::MakeUnique;
+using chre::UniquePtr;
+
+namespace {
+
+//! Sends every key to the same slot, to exercise collisions.
+struct ConstantHash {
+  uint32_t operator()(int /* key */) const {
+    return 7;
+  }
+};
+
+//! Sends keys to the slot given by their low bits, to control clusters.
+struct IdentityHash {
+  uint32_t operator()(int key) const {
+    return static_cast<uint32_t>(key);
+  }
+};
+
+int gNumLiveElements;
+
+class CountedElement {
+ public:
+  explicit CountedElement(int value) : mValue(value) {
+    gNumLiveElements++;
+  }
+  CountedElement(CountedElement &&other) : mValue(other.mValue) {
+    gNumLiveElements++;
+  }
+  CountedElement &operator=(CountedElement &&other) {
+    mValue = other.mValue;
+    return *this;
+  }
+  ~CountedElement() {
+    gNumLiveElements--;
+  }
+
+  int getValue() const {
+    return mValue;
+  }
+
+ private:
+  int mValue;
+};
+
+}  // namespace
+
+TEST(FlatHashMap, IsEmptyInitially) {
+  FlatHashMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.capacity(), 0);
+  EXPECT_EQ(map.find(1), nullptr);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_FALSE(map.erase(1));
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatHashMap, InsertFindErase) {
+  FlatHashMap<uint16_t, int> map;
+  EXPECT_TRUE(map.insert_or_assign(1, 10));
+  EXPECT_TRUE(map.insert_or_assign(2, 20));
+  EXPECT_EQ(map.size(), 2);
+
+  ASSERT_NE(map.find(1), nullptr);
+  EXPECT_EQ(*map.find(1), 10);
+  ASSERT_NE(map.find(2), nullptr);
+  EXPECT_EQ(*map.find(2), 20);
+  EXPECT_EQ(map.find(3), nullptr);
+
+  EXPECT_TRUE(map.insert_or_assign(1, 11));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(*map.find(1), 11);
+
+  EXPECT_TRUE(map.erase(1));
+  EXPECT_FALSE(map.erase(1));
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_TRUE(map.contains(2));
+}
+
+TEST(FlatHashMap, TryEmplaceKeepsExistingValue) {
+  FlatHashMap<int, int> map;
+  int *value = map.try_emplace(5, 50);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 50);
+
+  value = map.try_emplace(5, 51);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 50);
+  EXPECT_EQ(map.size(), 1);
+
+  // Default constructed values can be updated in place.
+  *map.try_emplace(6) += 3;
+  EXPECT_EQ(*map.find(6), 3);
+}
+
+TEST(FlatHashMap, GrowsAndKeepsElements) {
+  FlatHashMap<uint32_t, uint32_t> map;
+  constexpr uint32_t kNumElements = 1000;
+  for (uint32_t i = 0; i < kNumElements; i++) {
+    ASSERT_TRUE(map.insert_or_assign(i, i * 3));
+    EXPECT_GE(map.capacity(), map.size());
+  }
+  EXPECT_EQ(map.size(), kNumElements);
+  for (uint32_t i = 0; i < kNumElements; i++) {
+    ASSERT_NE(map.find(i), nullptr);
+    EXPECT_EQ(*map.find(i), i * 3);
+  }
+}
+
+TEST(FlatHashMap, ReserveAvoidsRehashing) {
+  FlatHashMap<int, int> map;
+  ASSERT_TRUE(map.reserve(100));
+  size_t capacity = map.capacity();
+  EXPECT_GE(capacity, 100);
+
+  map.insert_or_assign(0, 0);
+  const int *first = map.find(0);
+  for (int i = 1; i < 100; i++) {
+    ASSERT_TRUE(map.insert_or_assign(i, i));
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(map.find(0), first);
+}
+
+TEST(FlatHashMap, EraseInCollidingCluster) {
+  FlatHashMap<int, int, ConstantHash> map;
+  for (int i = 0; i < 20; i++) {
+    ASSERT_TRUE(map.insert_or_assign(i, -i));
+  }
+
+  // Remove every other element, then check that the rest are still found.
+  for (int i = 0; i < 20; i += 2) {
+    EXPECT_TRUE(map.erase(i));
+  }
+  for (int i = 0; i < 20; i++) {
+    if (i % 2 == 0) {
+      EXPECT_EQ(map.find(i), nullptr);
+    } else {
+      ASSERT_NE(map.find(i), nullptr);
+      EXPECT_EQ(*map.find(i), -i);
+    }
+  }
+}
+
+TEST(FlatHashMap, EraseDoesNotMoveElementsBeforeTheirHomeSlot) {
+  // With 8 slots, keys 6, 14 and 22 share home slot 6 and wrap around, while
+  // key 1 lives in its own home slot right after the wrapped elements.
+  FixedSizeFlatHashMap<int, int, 5, IdentityHash> map;
+  for (int key : {6, 14, 22, 1}) {
+    ASSERT_TRUE(map.insert_or_assign(key, key));
+  }
+  EXPECT_TRUE(map.erase(6));
+  for (int key : {14, 22, 1}) {
+    ASSERT_NE(map.find(key), nullptr);
+    EXPECT_EQ(*map.find(key), key);
+  }
+  EXPECT_TRUE(map.erase(14));
+  EXPECT_TRUE(map.erase(22));
+  ASSERT_NE(map.find(1), nullptr);
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(FlatHashMap, FixedSizeRejectsInsertionsWhenFull) {
+  FixedSizeFlatHashMap<int, int, 4> map;
+  EXPECT_EQ(map.capacity(), 4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(map.insert_or_assign(i, i));
+  }
+  EXPECT_FALSE(map.insert_or_assign(4, 4));
+  EXPECT_EQ(map.try_emplace(4, 4), nullptr);
+
+  // Existing keys can still be updated.
+  EXPECT_TRUE(map.insert_or_assign(3, 30));
+  EXPECT_EQ(*map.find(3), 30);
+
+  EXPECT_TRUE(map.erase(0));
+  EXPECT_TRUE(map.insert_or_assign(4, 4));
+  EXPECT_EQ(map.size(), 4);
+}
+
+TEST(FlatHashMap, DestroysElements) {
+  gNumLiveElements = 0;
+  {
+    FlatHashMap<int, CountedElement> map;
+    for (int i = 0; i < 50; i++) {
+      map.try_emplace(i, i);
+    }
+    EXPECT_EQ(gNumLiveElements, 50);
+
+    map.erase(10);
+    EXPECT_EQ(gNumLiveElements, 49);
+
+    map.clear();
+    EXPECT_EQ(gNumLiveElements, 0);
+    EXPECT_TRUE(map.empty());
+
+    map.try_emplace(1, 1);
+    map.try_emplace(2, 2);
+    EXPECT_EQ(map.find(2)->getValue(), 2);
+  }
+  EXPECT_EQ(gNumLiveElements, 0);
+}
+
+TEST(FlatHashMap, HoldsMoveOnlyValues) {
+  FlatHashMap<int, UniquePtr<int>> map;
+  EXPECT_TRUE(map.insert_or_assign(1, MakeUnique<int>(10)));
+  EXPECT_TRUE(map.insert_or_assign(1, MakeUnique<int>(11)));
+  for (int i = 2; i < 20; i++) {
+    map.try_emplace(i, MakeUnique<int>(i));
+  }
+  ASSERT_NE(map.find(1), nullptr);
+  EXPECT_EQ(**map.find(1), 11);
+  EXPECT_EQ(**map.find(19), 19);
+}
+
+TEST(FlatHashMap, IteratesOverAllElements) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 30; i++) {
+    map.insert_or_assign(i, i);
+  }
+
+  int sum = 0;
+  size_t count = 0;
+  for (auto &entry : map) {
+    EXPECT_EQ(entry.key, entry.value);
+    entry.value *= 2;
+    sum += entry.key;
+    count++;
+  }
+  EXPECT_EQ(count, 30);
+  EXPECT_EQ(sum, 29 * 30 / 2);
+
+  const FlatHashMap<int, int> &constMap = map;
+  for (const auto &entry : constMap) {
+    EXPECT_EQ(entry.value, entry.key * 2);
+  }
+}
+
+TEST(FlatHashMap, MatchesStdUnorderedMap) {
+  std::mt19937 generator(1234);
+  std::uniform_int_distribution<int> keyDistribution(0, 200);
+  std::uniform_int_distribution<int> opDistribution(0, 2);
+
+  FlatHashMap<int, int> map;
+  std::unordered_map<int, int> reference;
+  for (int i = 0; i < 10000; i++) {
+    int key = keyDistribution(generator);
+    switch (opDistribution(generator)) {
+      case 0:
+        EXPECT_TRUE(map.insert_or_assign(key, i));
+        reference[key] = i;
+        break;
+      case 1:
+        EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+        break;
+      default: {
+        const int *value = map.find(key);
+        auto it = reference.find(key);
+        ASSERT_EQ(value != nullptr, it != reference.end());
+        if (value != nullptr) {
+          EXPECT_EQ(*value, it->second);
+        }
+      }
+    }
+    ASSERT_EQ(map.size(), reference.size());
+  }
+}
+
+// Compares lookups with the linear search over a DynamicVector used before
+// the hash containers were available. Run with
+// --gtest_also_run_disabled_tests.
+TEST(FlatHashMap, DISABLED_LookupBenchmark) {
+  struct Pair {
+    uint32_t key;
+    uint32_t value;
+  };
+  constexpr uint32_t kNumLookups = 200000;
+
+  for (uint32_t numElements : {4, 16, 64, 256}) {
+    FlatHashMap<uint32_t, uint32_t> map;
+    DynamicVector<Pair> vector;
+    for (uint32_t i = 0; i < numElements; i++) {
+      map.insert_or_assign(i * 7, i);
+      vector.push_back(Pair{i * 7, i});
+    }
+
+    uint32_t mapSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < kNumLookups; i++) {
+      const uint32_t *value = map.find((i % numElements) * 7);
+      mapSum += (value == nullptr) ? 0 : *value;
+    }
+    auto mapTime = std::chrono::steady_clock::now() - start;
+
+    uint32_t vectorSum = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < kNumLookups; i++) {
+      uint32_t key = (i % numElements) * 7;
+      for (const Pair &pair : vector) {
+        if (pair.key == key) {
+          vectorSum += pair.value;
+          break;
+        }
+      }
+    }
+    auto vectorTime = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(mapSum, vectorSum);
+    printf("%3u elements: FlatHashMap %6lld us, DynamicVector %6lld us\n",
+           numElements,
+           static_cast<long long>(
+               std::chrono::duration_cast<std::chrono::microseconds>(mapTime)
+                   .count()),
+           static_cast<long long>(
+               std::chrono::duration_cast<std::chrono::microseconds>(
+                   vectorTime)
+                   .count()));
+  }
+}
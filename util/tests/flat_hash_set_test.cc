@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/flat_hash_set.h"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+
+using chre::FixedSizeFlatHashSet;
+using chre::FlatHashSet;
+
+namespace {
+enum class Color : uint8_t { kRed, kGreen, kBlue };
+}  // namespace
+
+TEST(FlatHashSet, InsertContainsErase) {
+  FlatHashSet<uint64_t> set;
+  EXPECT_TRUE(set.insert(0x0123456789abcdef));
+  EXPECT_TRUE(set.insert(0x0123456789abcdef));
+  EXPECT_TRUE(set.insert(2));
+  EXPECT_EQ(set.size(), 2);
+
+  EXPECT_TRUE(set.contains(0x0123456789abcdef));
+  EXPECT_TRUE(set.contains(2));
+  EXPECT_FALSE(set.contains(3));
+
+  EXPECT_TRUE(set.erase(2));
+  EXPECT_FALSE(set.erase(2));
+  EXPECT_EQ(set.size(), 1);
+}
+
+TEST(FlatHashSet, HashesEnumsAndPointers) {
+  FlatHashSet<Color> colors;
+  colors.insert(Color::kRed);
+  colors.insert(Color::kBlue);
+  EXPECT_TRUE(colors.contains(Color::kRed));
+  EXPECT_FALSE(colors.contains(Color::kGreen));
+
+  int values[3];
+  FixedSizeFlatHashSet<int *, 3> pointers;
+  for (int &value : values) {
+    EXPECT_TRUE(pointers.insert(&value));
+  }
+  EXPECT_TRUE(pointers.contains(&values[1]));
+  EXPECT_FALSE(pointers.insert(nullptr));
+}
+
+TEST(FlatHashSet, IteratesOverAllKeys) {
+  FixedSizeFlatHashSet<int, 10> set;
+  for (int i = 0; i < 10; i++) {
+    EXPECT_TRUE(set.insert(i * i));
+  }
+
+  int sum = 0;
+  for (int key : set) {
+    sum += key;
+  }
+  EXPECT_EQ(sum, 285);
+}
+
+TEST(FlatHashSet, MatchesStdUnorderedSet) {
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<uint32_t> keyDistribution(0, 500);
+
+  FlatHashSet<uint32_t> set;
+  std::unordered_set<uint32_t> reference;
+  for (int i = 0; i < 10000; i++) {
+    uint32_t key = keyDistribution(generator);
+    if (i % 3 == 0) {
+      EXPECT_EQ(set.erase(key), reference.erase(key) == 1);
+    } else {
+      EXPECT_TRUE(set.insert(key));
+      reference.insert(key);
+    }
+    ASSERT_EQ(set.size(), reference.size());
+  }
+  for (uint32_t key = 0; key <= 500; key++) {
+    EXPECT_EQ(set.contains(key), reference.count(key) == 1);
+  }
+}
@@ -44,3 +44,13 @@ TEST(Hash, HashCalculatesKnownValues) {
                       strlen(dataStr)),
             0x8c9705a8);
 }
+
+TEST(Hash, IntegerHashesSpreadLowBits) {
+  // Consecutive keys must not map to consecutive buckets of a power of two
+  // table, so every low bit of the hash depends on all the input bits.
+  EXPECT_NE(chre::hashInteger32(1) & 0xff, chre::hashInteger32(257) & 0xff);
+  EXPECT_NE(chre::hashInteger64(1) & 0xff,
+            chre::hashInteger64(UINT64_C(1) | (UINT64_C(1) << 40)) & 0xff);
+  EXPECT_EQ(chre::Hash<uint16_t>()(5), chre::hashInteger32(5));
+  EXPECT_EQ(chre::Hash<int64_t>()(5), chre::hashInteger64(5));
+}
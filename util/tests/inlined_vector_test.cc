@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "chre/util/inlined_vector.h"
+#include "chre/util/unique_ptr.h"
+
+#include <stdint.h>
+#include <utility>
+
+using chre::InlinedVector;
+using chre::MakeUnique;
+using chre::UniquePtr;
+
+namespace {
+
+int gNumLiveElements;
+
+class CountedElement {
+ public:
+  explicit CountedElement(int value = 0) : mValue(value) {
+    gNumLiveElements++;
+  }
+  CountedElement(const CountedElement &other) : mValue(other.mValue) {
+    gNumLiveElements++;
+  }
+  CountedElement &operator=(const CountedElement &other) = default;
+  ~CountedElement() {
+    gNumLiveElements--;
+  }
+
+  int getValue() const {
+    return mValue;
+  }
+
+ private:
+  int mValue;
+};
+
+}  // namespace
+
+TEST(InlinedVector, IsEmptyAndInlineInitially) {
+  InlinedVector<int, 3> vector;
+  EXPECT_TRUE(vector.empty());
+  EXPECT_EQ(vector.size(), 0);
+  EXPECT_EQ(vector.capacity(), 3);
+  EXPECT_TRUE(vector.isInline());
+  EXPECT_EQ(vector.begin(), vector.end());
+}
+
+TEST(InlinedVector, StaysInlineUpToInlineCapacity) {
+  InlinedVector<int, 3> vector;
+  for (int i = 0; i < 3; i++) {
+    EXPECT_TRUE(vector.push_back(i));
+  }
+  EXPECT_TRUE(vector.isInline());
+  EXPECT_EQ(vector.capacity(), 3);
+
+  EXPECT_TRUE(vector.push_back(3));
+  EXPECT_FALSE(vector.isInline());
+  EXPECT_EQ(vector.capacity(), 6);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(vector[i], i);
+  }
+}
+
+TEST(InlinedVector, InsertEraseAndFind) {
+  InlinedVector<int, 2> vector;
+  EXPECT_TRUE(vector.insert(0, 2));
+  EXPECT_TRUE(vector.insert(0, 0));
+  EXPECT_TRUE(vector.insert(1, 1));
+  EXPECT_TRUE(vector.emplace_back(3));
+  ASSERT_EQ(vector.size(), 4);
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(vector[i], i);
+  }
+
+  EXPECT_EQ(vector.find(2), 2);
+  EXPECT_EQ(vector.find(5), vector.size());
+
+  vector.erase(1);
+  EXPECT_EQ(vector.size(), 3);
+  EXPECT_EQ(vector.front(), 0);
+  EXPECT_EQ(vector[1], 2);
+  EXPECT_EQ(vector.back(), 3);
+
+  vector.swap(0, 2);
+  EXPECT_EQ(vector.front(), 3);
+  EXPECT_EQ(vector.back(), 0);
+
+  vector.pop_back();
+  EXPECT_EQ(vector.size(), 2);
+}
+
+TEST(InlinedVector, ResizeAndReserve) {
+  InlinedVector<int, 4> vector;
+  EXPECT_TRUE(vector.reserve(2));
+  EXPECT_TRUE(vector.isInline());
+
+  EXPECT_TRUE(vector.resize(3));
+  EXPECT_EQ(vector.size(), 3);
+  EXPECT_EQ(vector[2], 0);
+
+  EXPECT_TRUE(vector.reserve(10));
+  EXPECT_FALSE(vector.isInline());
+  EXPECT_EQ(vector.capacity(), 10);
+  EXPECT_EQ(vector.size(), 3);
+
+  EXPECT_TRUE(vector.resize(1));
+  EXPECT_EQ(vector.size(), 1);
+}
+
+TEST(InlinedVector, DestroysElements) {
+  gNumLiveElements = 0;
+  {
+    InlinedVector<CountedElement, 2> vector;
+    vector.emplace_back(1);
+    vector.emplace_back(2);
+    EXPECT_EQ(gNumLiveElements, 2);
+
+    // Spilling to the heap moves the elements.
+    vector.emplace_back(3);
+    EXPECT_EQ(gNumLiveElements, 3);
+    EXPECT_EQ(vector[2].getValue(), 3);
+
+    vector.erase(0);
+    EXPECT_EQ(gNumLiveElements, 2);
+    EXPECT_EQ(vector[0].getValue(), 2);
+
+    vector.clear();
+    EXPECT_EQ(gNumLiveElements, 0);
+    vector.emplace_back(4);
+  }
+  EXPECT_EQ(gNumLiveElements, 0);
+}
+
+TEST(InlinedVector, MoveConstructInline) {
+  InlinedVector<UniquePtr<int>, 2> vector;
+  vector.push_back(MakeUnique<int>(1));
+
+  InlinedVector<UniquePtr<int>, 2> movedVector(std::move(vector));
+  EXPECT_TRUE(vector.empty());
+  EXPECT_TRUE(movedVector.isInline());
+  ASSERT_EQ(movedVector.size(), 1);
+  EXPECT_EQ(*movedVector[0], 1);
+}
+
+TEST(InlinedVector, MoveConstructFromHeap) {
+  InlinedVector<int, 1> vector;
+  vector.push_back(1);
+  vector.push_back(2);
+  const int *data = vector.data();
+
+  InlinedVector<int, 1> movedVector(std::move(vector));
+  EXPECT_EQ(movedVector.data(), data);
+  EXPECT_EQ(movedVector.size(), 2);
+  EXPECT_TRUE(vector.empty());
+  EXPECT_TRUE(vector.isInline());
+
+  // The moved-from vector is still usable.
+  EXPECT_TRUE(vector.push_back(3));
+  EXPECT_EQ(vector[0], 3);
+}
+
+TEST(InlinedVector, MoveAssign) {
+  gNumLiveElements = 0;
+  {
+    InlinedVector<CountedElement, 2> vector;
+    vector.emplace_back(1);
+    InlinedVector<CountedElement, 2> other;
+    for (int i = 0; i < 5; i++) {
+      other.emplace_back(i);
+    }
+
+    vector = std::move(other);
+    EXPECT_EQ(gNumLiveElements, 5);
+    EXPECT_EQ(vector.size(), 5);
+    EXPECT_EQ(vector[4].getValue(), 4);
+
+    other.emplace_back(7);
+    vector = std::move(other);
+    EXPECT_EQ(gNumLiveElements, 1);
+    EXPECT_TRUE(vector.isInline());
+    EXPECT_EQ(vector[0].getValue(), 7);
+  }
+  EXPECT_EQ(gNumLiveElements, 0);
+}
+
+TEST(InlinedVector, Equality) {
+  InlinedVector<int, 2> vector1;
+  InlinedVector<int, 2> vector2;
+  for (int i = 0; i < 3; i++) {
+    vector1.push_back(i);
+    vector2.push_back(i);
+  }
+  EXPECT_TRUE(vector1 == vector2);
+  vector2.pop_back();
+  EXPECT_FALSE(vector1 == vector2);
+}
+
+TEST(InlinedVector, Iterate) {
+  InlinedVector<int, 3> vector;
+  for (int i = 1; i <= 5; i++) {
+    vector.push_back(i);
+  }
+  int sum = 0;
+  for (int value : vector) {
+    sum += value;
+  }
+  EXPECT_EQ(sum, 15);
+}
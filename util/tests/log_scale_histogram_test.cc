@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chre/util/system/log_scale_histogram.h"
+#include "gtest/gtest.h"
+
+using chre::LogScaleHistogram;
+
+TEST(LogScaleHistogram, EmptyHistogram) {
+  LogScaleHistogram<8> histogram;
+
+  EXPECT_EQ(histogram.getTotalCount(), 0);
+  EXPECT_EQ(histogram.getPercentile(50), 0);
+  for (size_t i = 0; i < histogram.getNumBuckets(); i++) {
+    EXPECT_EQ(histogram.getCount(i), 0);
+  }
+}
+
+TEST(LogScaleHistogram, BucketIndex) {
+  using Histogram = LogScaleHistogram<8>;
+
+  EXPECT_EQ(Histogram::getBucketIndex(0), 0);
+  EXPECT_EQ(Histogram::getBucketIndex(1), 1);
+  EXPECT_EQ(Histogram::getBucketIndex(2), 2);
+  EXPECT_EQ(Histogram::getBucketIndex(3), 2);
+  EXPECT_EQ(Histogram::getBucketIndex(4), 3);
+  EXPECT_EQ(Histogram::getBucketIndex(63), 6);
+  EXPECT_EQ(Histogram::getBucketIndex(64), 7);
+  EXPECT_EQ(Histogram::getBucketIndex(UINT64_MAX), 7);
+}
+
+TEST(LogScaleHistogram, BucketBounds) {
+  using Histogram = LogScaleHistogram<8>;
+
+  EXPECT_EQ(Histogram::getBucketLowerBound(0), 0);
+  EXPECT_EQ(Histogram::getBucketUpperBound(0), 1);
+  EXPECT_EQ(Histogram::getBucketLowerBound(1), 1);
+  EXPECT_EQ(Histogram::getBucketUpperBound(1), 2);
+  EXPECT_EQ(Histogram::getBucketLowerBound(5), 16);
+  EXPECT_EQ(Histogram::getBucketUpperBound(5), 32);
+}
+
+TEST(LogScaleHistogram, AddValues) {
+  LogScaleHistogram<8> histogram;
+
+  histogram.addValue(0);
+  histogram.addValue(5);
+  histogram.addValue(6);
+  histogram.addValue(1000);
+
+  EXPECT_EQ(histogram.getTotalCount(), 4);
+  EXPECT_EQ(histogram.getCount(0), 1);
+  EXPECT_EQ(histogram.getCount(3), 2);
+  EXPECT_EQ(histogram.getCount(7), 1);
+  EXPECT_EQ(histogram.getCount(8), 0);
+}
+
+TEST(LogScaleHistogram, Percentiles) {
+  LogScaleHistogram<12> histogram;
+
+  // 90 values in [2, 4), 9 values in [16, 32), 1 value in [512, 1024).
+  for (int i = 0; i < 90; i++) {
+    histogram.addValue(3);
+  }
+  for (int i = 0; i < 9; i++) {
+    histogram.addValue(20);
+  }
+  histogram.addValue(600);
+
+  EXPECT_EQ(histogram.getPercentile(0), 4);
+  EXPECT_EQ(histogram.getPercentile(50), 4);
+  EXPECT_EQ(histogram.getPercentile(90), 4);
+  EXPECT_EQ(histogram.getPercentile(91), 32);
+  EXPECT_EQ(histogram.getPercentile(99), 32);
+  EXPECT_EQ(histogram.getPercentile(100), 1024);
+}
+
+TEST(LogScaleHistogram, PercentileInLastBucketReturnsLowerBound) {
+  LogScaleHistogram<4> histogram;
+
+  histogram.addValue(1000);
+
+  EXPECT_EQ(histogram.getPercentile(50), 4);
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2024 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+#include "chre/util/array_queue.h"
+#include "chre/util/multi_level_blocking_queue.h"
+#include "chre/util/segmented_queue.h"
+
+using chre::ArrayQueue;
+using chre::MultiLevelBlockingQueue;
+using chre::SegmentedQueue;
+
+namespace {
+
+using ArrayLevelQueue = MultiLevelBlockingQueue<int, ArrayQueue<int, 16>, 3>;
+using SegmentedLevelQueue =
+    MultiLevelBlockingQueue<int, SegmentedQueue<int, 4>, 3>;
+
+bool isOdd(int element, void * /* data */, void * /* extraData */) {
+  return element % 2 != 0;
+}
+
+void countRemoved(int /* element */, void *removedCount) {
+  (*static_cast<size_t *>(removedCount))++;
+}
+
+}  // namespace
+
+TEST(MultiLevelBlockingQueue, IsEmptyByDefault) {
+  ArrayLevelQueue queue(/* starvationLimit= */ 0);
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.size(), 0);
+  EXPECT_EQ(queue.getNumLevels(), 3);
+}
+
+TEST(MultiLevelBlockingQueue, PopsHighestPriorityFirst) {
+  ArrayLevelQueue queue(/* starvationLimit= */ 0);
+
+  EXPECT_TRUE(queue.push(20, /* level= */ 2));
+  EXPECT_TRUE(queue.push(10, /* level= */ 1));
+  EXPECT_TRUE(queue.push(21, /* level= */ 2));
+  EXPECT_TRUE(queue.push(0, /* level= */ 0));
+  EXPECT_TRUE(queue.push(11, /* level= */ 1));
+  EXPECT_EQ(queue.size(), 5);
+  EXPECT_EQ(queue.size(2), 2);
+
+  EXPECT_EQ(queue.pop(), 0);
+  EXPECT_EQ(queue.pop(), 10);
+  EXPECT_EQ(queue.pop(), 11);
+  EXPECT_EQ(queue.pop(), 20);
+  EXPECT_EQ(queue.pop(), 21);
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(MultiLevelBlockingQueue, PushFailsWhenLevelIsFull) {
+  MultiLevelBlockingQueue<int, ArrayQueue<int, 2>, 2> queue(
+      /* starvationLimit= */ 0);
+
+  EXPECT_TRUE(queue.push(1, /* level= */ 1));
+  EXPECT_TRUE(queue.push(2, /* level= */ 1));
+  EXPECT_FALSE(queue.push(3, /* level= */ 1));
+  EXPECT_TRUE(queue.push(4, /* level= */ 0));
+}
+
+TEST(MultiLevelBlockingQueue, StarvingLevelIsServed) {
+  ArrayLevelQueue queue(/* starvationLimit= */ 2);
+
+  for (int i = 0; i < 6; i++) {
+    EXPECT_TRUE(queue.push(i, /* level= */ 0));
+  }
+  EXPECT_TRUE(queue.push(20, /* level= */ 2));
+
+  EXPECT_EQ(queue.pop(), 0);
+  EXPECT_EQ(queue.pop(), 1);
+  // Level 2 was bypassed twice
+  EXPECT_EQ(queue.pop(), 20);
+  EXPECT_EQ(queue.pop(), 2);
+}
+
+TEST(MultiLevelBlockingQueue, MostBypassedStarvingLevelIsServedFirst) {
+  ArrayLevelQueue queue(/* starvationLimit= */ 1);
+
+  EXPECT_TRUE(queue.push(0, /* level= */ 0));
+  EXPECT_TRUE(queue.push(1, /* level= */ 0));
+  EXPECT_TRUE(queue.push(20, /* level= */ 2));
+  EXPECT_TRUE(queue.push(21, /* level= */ 2));
+
+  EXPECT_EQ(queue.pop(), 0);
+  EXPECT_TRUE(queue.push(10, /* level= */ 1));
+  // Level 2 was bypassed once and level 1 never, so level 2 is served
+  EXPECT_EQ(queue.pop(), 20);
+  // Level 0 and 1 were bypassed once
+  EXPECT_EQ(queue.pop(), 1);
+  EXPECT_EQ(queue.pop(), 10);
+  EXPECT_EQ(queue.pop(), 21);
+}
+
+TEST(MultiLevelBlockingQueue, RemoveMatchedFromBackStartsWithLowestLevel) {
+  SegmentedLevelQueue queue(/* starvationLimit= */ 0,
+                            /* maxBlockCount= */ 4);
+
+  for (int i = 0; i < 5; i++) {
+    EXPECT_TRUE(queue.push(i, /* level= */ 0));
+    EXPECT_TRUE(queue.push(10 + i, /* level= */ 2));
+  }
+
+  size_t removedCount = 0;
+  EXPECT_EQ(queue.removeMatchedFromBack(isOdd, /* data= */ nullptr,
+                                        /* extraData= */ nullptr,
+                                        /* maxNumOfElementsRemoved= */ 3,
+                                        countRemoved, &removedCount),
+            3);
+  EXPECT_EQ(removedCount, 3);
+
+  // 13 and 11 are removed from level 2, then 3 from level 0
+  EXPECT_EQ(queue.size(0), 4);
+  EXPECT_EQ(queue.size(2), 3);
+  EXPECT_EQ(queue.pop(), 0);
+  EXPECT_EQ(queue.pop(), 1);
+  EXPECT_EQ(queue.pop(), 2);
+  EXPECT_EQ(queue.pop(), 4);
+  EXPECT_EQ(queue.pop(), 10);
+  EXPECT_EQ(queue.pop(), 12);
+  EXPECT_EQ(queue.pop(), 14);
+}
+
+TEST(MultiLevelBlockingQueue, PopBlocksUntilPush) {
+  ArrayLevelQueue queue(/* starvationLimit= */ 0);
+
+  std::thread producer([&queue]() { queue.push(42, /* level= */ 1); });
+  EXPECT_EQ(queue.pop(), 42);
+  producer.join();
+}
@@ -499,5 +499,100 @@ TEST_F(TransactionManagerTest, TransactionShouldWaitSameCookie) {
   EXPECT_EQ(mTransactionCompleted.errorCode, CHRE_ERROR_NONE);
 }
 
+TEST_F(TransactionManagerTest, QueuedTransactionShouldCompleteWithoutStarting) {
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  bool transactionStarted1 = false;
+  bool transactionStarted2 = false;
+  uint32_t transactionId1;
+  uint32_t transactionId2;
+  EXPECT_TRUE(mTransactionManager->startTransaction(
+      {
+          .test = this,
+          .transactionStarted = &transactionStarted1,
+          .numTimesTransactionStarted = nullptr,
+          .data = 1,
+      },
+      /* cookie= */ 0xCAFE, &transactionId1));
+  EXPECT_TRUE(mTransactionManager->startTransaction(
+      {
+          .test = this,
+          .transactionStarted = &transactionStarted2,
+          .numTimesTransactionStarted = nullptr,
+          .data = 2,
+      },
+      /* cookie= */ 0xCAFE, &transactionId2));
+  mCondVar.wait_for(lock, kWaitTimeout,
+                    [&transactionStarted1]() { return transactionStarted1; });
+  EXPECT_TRUE(transactionStarted1);
+
+  mTransactionCallbackCalled = false;
+  EXPECT_TRUE(mTransactionManager->completeTransaction(
+      transactionId2, CHRE_ERROR_INVALID_ARGUMENT));
+  mCondVar.wait_for(lock, kWaitTimeout,
+                    [this]() { return mTransactionCallbackCalled; });
+  EXPECT_TRUE(mTransactionCallbackCalled);
+  EXPECT_EQ(mTransactionCompleted.data.data, 2);
+  EXPECT_FALSE(transactionStarted2);
+
+  mTransactionCallbackCalled = false;
+  EXPECT_TRUE(mTransactionManager->completeTransaction(transactionId1,
+                                                       CHRE_ERROR_NONE));
+  mCondVar.wait_for(lock, kWaitTimeout,
+                    [this]() { return mTransactionCallbackCalled; });
+  EXPECT_TRUE(mTransactionCallbackCalled);
+  EXPECT_EQ(mTransactionCompleted.data.data, 1);
+  EXPECT_FALSE(transactionStarted2);
+}
+
+TEST_F(TransactionManagerTest, FlushingOldestTransactionShouldStartNext) {
+  std::unique_lock<std::mutex> lock(mMutex);
+
+  bool transactionStarted1 = false;
+  bool transactionStarted2 = false;
+  uint32_t transactionId1;
+  uint32_t transactionId2;
+  EXPECT_TRUE(mTransactionManager->startTransaction(
+      {
+          .test = this,
+          .transactionStarted = &transactionStarted1,
+          .numTimesTransactionStarted = nullptr,
+          .data = 1,
+      },
+      /* cookie= */ 0xCAFE, &transactionId1));
+  EXPECT_TRUE(mTransactionManager->startTransaction(
+      {
+          .test = this,
+          .transactionStarted = &transactionStarted2,
+          .numTimesTransactionStarted = nullptr,
+          .data = 2,
+      },
+      /* cookie= */ 0xCAFE, &transactionId2));
+  mCondVar.wait_for(lock, kWaitTimeout,
+                    [&transactionStarted1]() { return transactionStarted1; });
+  EXPECT_TRUE(transactionStarted1);
+  EXPECT_FALSE(transactionStarted2);
+
+  EXPECT_EQ(mTransactionManager->flushTransactions(
+                [](const TransactionData &data, void * /* callbackData */) {
+                  return data.data == 1;
+                },
+                /* data= */ nullptr),
+            1);
+  mCondVar.wait_for(lock, kWaitTimeout,
+                    [&transactionStarted2]() { return transactionStarted2; });
+  EXPECT_TRUE(transactionStarted2);
+
+  mTransactionCallbackCalled = false;
+  EXPECT_TRUE(mTransactionManager->completeTransaction(transactionId2,
+                                                       CHRE_ERROR_NONE));
+  mCondVar.wait_for(lock, kWaitTimeout,
+                    [this]() { return mTransactionCallbackCalled; });
+  EXPECT_TRUE(mTransactionCallbackCalled);
+  EXPECT_EQ(mTransactionCompleted.data.data, 2);
+  EXPECT_FALSE(mTransactionManager->completeTransaction(transactionId1,
+                                                        CHRE_ERROR_NONE));
+}
+
 }  // namespace
 }  // namespace chre
@@ -17,6 +17,10 @@ COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/audio.cc
 COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/ble.cc
 COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/callbacks.cc
 COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/debug.cc
+COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/dsp.cc
+COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/fft.cc
+COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/filter.cc
+COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/mel_filterbank.cc
 COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/string.cc
 COMMON_SRCS += $(CHRE_PREFIX)/util/nanoapp/wifi.cc
 COMMON_SRCS += $(CHRE_PREFIX)/util/system/ble_util.cc
@@ -31,12 +35,18 @@ GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/blocking_queue_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/buffer_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/copyable_fixed_size_vector_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/debug_dump_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/dsp_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/dynamic_vector_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/fixed_size_vector_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/flat_hash_map_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/flat_hash_set_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/heap_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/inlined_vector_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/intrusive_list_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/lock_guard_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/log_scale_histogram_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/memory_pool_test.cc
+GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/multi_level_blocking_queue_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/optional_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/priority_queue_test.cc
 GOOGLETEST_SRCS += $(CHRE_PREFIX)/util/tests/raw_storage_test.cc
@@ -31,6 +31,9 @@ const StaticNanoappInitFunction kStaticNanoappList[] = {
     initializeStaticNanoappMessageWorld,
     initializeStaticNanoappSensorWorld,
     initializeStaticNanoappSpammer,
+#ifdef CHRE_TFLM_DEMO_ENABLED
+    initializeStaticNanoappTflmDemo,
+#endif  // CHRE_TFLM_DEMO_ENABLED
     initializeStaticNanoappTimerWorld,
     initializeStaticNanoappUnloadTester,
     initializeStaticNanoappWifiWorld,
@@ -16,6 +16,12 @@ COMMON_CFLAGS += -DCHRE_VERSION_STRING='"$(VERSION_STRING)"'
 # nanoapp list.
 COMMON_CFLAGS += -DCHRE_VARIANT_SUPPLIES_STATIC_NANOAPP_LIST
 
+# Worker event loops are opt-in: set CHRE_WORKER_EVENT_LOOP_ENABLED=true to run
+# one next to the system event loop, see --worker_nanoapp.
+ifeq ($(CHRE_WORKER_EVENT_LOOP_ENABLED), true)
+COMMON_CFLAGS += -DCHRE_NUM_WORKER_EVENT_LOOPS=1
+endif
+
 # Enable exceptions for TCLAP.
 GOOGLE_X86_LINUX_CFLAGS += -fexceptions
 
@@ -24,6 +30,7 @@ GOOGLE_X86_LINUX_CFLAGS += -fexceptions
 CHRE_AUDIO_SUPPORT_ENABLED = true
 CHRE_BLE_SUPPORT_ENABLED = true
 CHRE_GNSS_SUPPORT_ENABLED = true
+CHRE_INFERENCE_SUPPORT_ENABLED = true
 CHRE_SENSORS_SUPPORT_ENABLED = true
 CHRE_WIFI_SUPPORT_ENABLED = true
 CHRE_WIFI_NAN_SUPPORT_ENABLED = true